@@ -21,7 +21,9 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-
+#include "boot_trace.h"
+#include "boot_handoff.h"
+#include "mpu_cache.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -31,6 +33,10 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+/* ӵĲۣ0: Astm32h7rsxx_ROMxspi1.sct1: BKeilĿATK_H7R7_Appli_SlotB壬stm32h7rsxx_ROMxspi1_slotB.sct */
+#ifndef APPLI_SLOT
+#define APPLI_SLOT		(0)
+#endif
 
 /* USER CODE END PD */
 
@@ -48,7 +54,7 @@
 /* Private function prototypes -----------------------------------------------*/
 static void MPU_Config(void);
 /* USER CODE BEGIN PFP */
-
+void SystemClock_Config(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -64,13 +70,19 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
-
+	const boot_handoff_t *handoff;
+	
+	/* BootloaderʱߣCYCCNTBootloader mainʼ */
+	BOOT_TRACE_ATTACH();
+	BOOT_TRACE_BEGIN(BOOT_TRACE_ID_APP_MPU_CONFIG);
   /* USER CODE END 1 */
 
   /* MPU Configuration--------------------------------------------------------*/
   MPU_Config();
 
   /* MCU Configuration--------------------------------------------------------*/
+  BOOT_TRACE_END(BOOT_TRACE_ID_APP_MPU_CONFIG);
+  BOOT_TRACE_BEGIN(BOOT_TRACE_ID_APP_HAL_INIT);
 
   /* Update SystemCoreClock variable according to RCC registers values. */
   SystemCoreClockUpdate();
@@ -79,16 +91,30 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-
+	BOOT_TRACE_END(BOOT_TRACE_ID_APP_HAL_INIT);
   /* USER CODE END Init */
 
   /* USER CODE BEGIN SysInit */
-
+	/* BootloaderĲ뱾ӵĲһ£AľBʱַԣ */
+	handoff = boot_handoff_get();
+	if ((handoff != NULL) && (handoff->slot != APPLI_SLOT))
+	{
+		Error_Handler();
+	}
+	
+	/* Bootloaderʱӿ뵱ǰĴһ£ʱֱã */
+	if (boot_handoff_check(BOOT_HANDOFF_FLAG_CLOCK) != 0)
+	{
+		SystemClock_Config();
+	}
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
   /* USER CODE BEGIN 2 */
-
+	BOOT_TRACE_BEGIN(BOOT_TRACE_ID_APP_PERIPH_INIT);
+	/* ڴ˳ʼ裨LCDȣ׶οBOOT_TRACE_ID_USERID¼ */
+	BOOT_TRACE_END(BOOT_TRACE_ID_APP_PERIPH_INIT);
+	BOOT_TRACE_MARK(BOOT_TRACE_ID_APP_READY);
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -103,36 +129,81 @@ int main(void)
 }
 
 /* USER CODE BEGIN 4 */
+/**
+  * @brief System Clock Configuration
+  * @note  BootloaderͬPLL1 600MHzCPUPLL3 600MHzڽӿЧʱ
+  * @retval None
+  */
+void SystemClock_Config(void)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+  /** Configure the main internal regulator output voltage
+  */
+  if (HAL_PWREx_ControlVoltageScaling(PWR_REGULATOR_VOLTAGE_SCALE0) != HAL_OK)
+  {
+    Error_Handler();
+  }
 
+  /** Initializes the RCC Oscillators according to the specified parameters
+  * in the RCC_OscInitTypeDef structure.
+  */
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+  RCC_OscInitStruct.HSEState = RCC_HSE_ON;
+  RCC_OscInitStruct.PLL1.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL1.PLLSource = RCC_PLLSOURCE_HSE;
+  RCC_OscInitStruct.PLL1.PLLM = 6;
+  RCC_OscInitStruct.PLL1.PLLN = 300;
+  RCC_OscInitStruct.PLL1.PLLP = 2;
+  RCC_OscInitStruct.PLL1.PLLQ = 2;
+  RCC_OscInitStruct.PLL1.PLLR = 2;
+  RCC_OscInitStruct.PLL1.PLLS = 2;
+  RCC_OscInitStruct.PLL1.PLLT = 2;
+  RCC_OscInitStruct.PLL1.PLLFractional = 0;
+  RCC_OscInitStruct.PLL2.PLLState = RCC_PLL_NONE;
+  RCC_OscInitStruct.PLL3.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL3.PLLSource = RCC_PLLSOURCE_HSE;
+  RCC_OscInitStruct.PLL3.PLLM = 6;
+  RCC_OscInitStruct.PLL3.PLLN = 300;
+  RCC_OscInitStruct.PLL3.PLLP = 2;
+  RCC_OscInitStruct.PLL3.PLLQ = 2;
+  RCC_OscInitStruct.PLL3.PLLR = 2;
+  RCC_OscInitStruct.PLL3.PLLS = 2;
+  RCC_OscInitStruct.PLL3.PLLT = 2;
+  RCC_OscInitStruct.PLL3.PLLFractional = 0;
+
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  /** Initializes the CPU, AHB and APB buses clocks
+  */
+  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+                              |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2
+                              |RCC_CLOCKTYPE_PCLK4|RCC_CLOCKTYPE_PCLK5;
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.SYSCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_HCLK_DIV2;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_APB1_DIV2;
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_APB2_DIV2;
+  RCC_ClkInitStruct.APB4CLKDivider = RCC_APB4_DIV2;
+  RCC_ClkInitStruct.APB5CLKDivider = RCC_APB5_DIV2;
+
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_7) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
 /* USER CODE END 4 */
 
  /* MPU Configuration */
 
 static void MPU_Config(void)
 {
-  MPU_Region_InitTypeDef MPU_InitStruct = {0};
-
-  /* Disables the MPU */
-  HAL_MPU_Disable();
-
-  /** Initializes and configures the Region and the memory to be protected
-  */
-  MPU_InitStruct.Enable = MPU_REGION_ENABLE;
-  MPU_InitStruct.Number = MPU_REGION_NUMBER0;
-  MPU_InitStruct.BaseAddress = 0x0;
-  MPU_InitStruct.Size = MPU_REGION_SIZE_4GB;
-  MPU_InitStruct.SubRegionDisable = 0x87;
-  MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL0;
-  MPU_InitStruct.AccessPermission = MPU_REGION_NO_ACCESS;
-  MPU_InitStruct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
-  MPU_InitStruct.IsShareable = MPU_ACCESS_SHAREABLE;
-  MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
-  MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
-
-  HAL_MPU_ConfigRegion(&MPU_InitStruct);
-  /* Enables the MPU */
-  HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
-
+  /* XSPI1AXI SRAMAHB SRAMnoncacheable_bufferԣʹI-CacheD-CacheBSP/mpu_cache.h */
+  mpu_cache_init();
 }
 
 /**
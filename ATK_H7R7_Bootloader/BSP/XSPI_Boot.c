@@ -1,21 +1,35 @@
 #include "XSPI_Boot.h"
 #include "usart.h"
+#include "boot_trace.h"
+#include "boot_handoff.h"
 /* ȫжϵĺ */
 #define ENABLE_INT()	__set_PRIMASK(0)	/* ʹȫж */
 #define DISABLE_INT()	__set_PRIMASK(1)	/* ֹȫж */
 
-void Boot_JumpToApp(void)
+/* app_addr: Ӧóַͷеload_address
+ * תǰboot_handoff_save()ӿ¼˱ֵʱʱָλʱ */
+void Boot_JumpToApp(uint32_t app_addr)
 {
 	uint32_t i=0;
 	void (*AppJump)(void);         /* һָ */
-	__IO uint32_t AppAddr = FLASH_MEM_ADDR;  /* APP ַ */
+	__IO uint32_t AppAddr = app_addr;  /* APP ַ */
 	printf_tx1("Boot Start Jump To App....");
     /* رȫж */
 	DISABLE_INT(); 
     
-    /* ʱӵĬ״̬ʹHSIʱ */
-	HAL_RCC_DeInit();
+    /* PLLXSPI1ڴӳ䣬ӦóУ齻ӿãʱӵĬ״̬ʹHSIʱ */
+	if (boot_handoff_check(BOOT_HANDOFF_FLAG_CLOCK) != 0)
+	{
+		HAL_RCC_DeInit();
+	}
+	/* ¼תʱ㣨SystemCoreClockΪתʱCPUƵʣ */
+	BOOT_TRACE_MARK(BOOT_TRACE_ID_JUMP);
     
+	/* CacheMPU򱣳ʹܣӦóXIPдͨУ
+	 * дD-CacheеĽӿ顢ټ¼ݣӦómpu_cache_init() */
+	SCB_CleanDCache();
+	SCB_InvalidateICache();
+
 	/* رյδʱλĬֵ */
 	SysTick->CTRL = 0;
   SysTick->LOAD = 0;
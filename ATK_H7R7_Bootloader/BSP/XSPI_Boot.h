@@ -18,6 +18,6 @@ typedef enum
 }BQB_Cmd_E;
 
 
-void Boot_JumpToApp(void);
+void Boot_JumpToApp(uint32_t app_addr);
 
 #endif /**/
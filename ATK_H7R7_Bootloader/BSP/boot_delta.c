@@ -0,0 +1,647 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_delta.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       Ӧó£ʽӦã
+ ****************************************************************************************************
+ * @attention
+ *
+ * ɾͨڴӳ䴰ڶȡ¾һСRAMɣ˳ڴӳ䣬
+ * norflash_write()дĿֻдб仯ҳٻָڴӳ䣻
+ * ɰⳤȷֶ룬ÿдBOOT_DELTA_RECORD_SECTORSڼֵ洢бһνȣ
+ * жϣ硢λʧܣͬһͷٴοʼӽȼ¼
+ * ɾֻȽϾͷCRCʱľУ鱣֤¾ϺУ
+ * ǰѹؼֵ洢ڴӳеĳboot_slot.hеITCMҪ
+ * ддȼ¼У¾ʱNOR Flash˳ڴӳ䣬ڼִбģ顢ֵ洢У顢
+ * NOR FlashHALmemcpy/memsetER_ITCMУnorflash_memory_mapped_suspend()ж
+ *
+ ****************************************************************************************************
+ */
+
+#include "boot_delta.h"
+#include "boot_image.h"
+#include "norflash_kv.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ȼ¼ */
+#define BOOT_DELTA_RECORD_KEY       "boot.delta"
+
+/* Ӧ״̬ */
+#define BOOT_DELTA_STATE_IDLE       (0)     /* δʼ */
+#define BOOT_DELTA_STATE_OP         (1)     /* ȴ */
+#define BOOT_DELTA_STATE_LENGTH     (2)     /*  */
+#define BOOT_DELTA_STATE_OFFSET     (3)     /* ɾƫ */
+#define BOOT_DELTA_STATE_COPY       (4)     /* Ӿɾ */
+#define BOOT_DELTA_STATE_DATA       (5)     /*  */
+#define BOOT_DELTA_STATE_ADD_SKIP   (6)     /*  */
+#define BOOT_DELTA_STATE_ADD_ZERO   (7)     /* ӾɾƣֵΪ0 */
+#define BOOT_DELTA_STATE_ADD_COUNT  (8)     /* ֵ */
+#define BOOT_DELTA_STATE_ADD_DIFF   (9)     /* ݼӲֵ */
+#define BOOT_DELTA_STATE_DONE       (10)    /* ¾ȫ */
+#define BOOT_DELTA_STATE_ERROR      (11)    /* ֹ */
+
+/* ȼ¼壨ֻݵ״̬±棬ʱδLEB128 */
+typedef struct {
+    uint32_t header_crc;    /* ͷCRC32 */
+    uint32_t old_address;   /* ɾַ */
+    uint32_t new_address;   /* ¾ַ */
+    uint32_t patch_offset;  /* ѴĲ */
+    uint32_t output;        /* д¾񳤶ȣ룩 */
+    uint32_t remaining;     /* ǰʣ೤ */
+    uint32_t run;           /* ǰʣ೤ */
+    uint32_t old_offset;    /* ɾα */
+    uint8_t state;          /* Ӧ״̬ */
+    uint8_t op;             /* ǰ */
+    uint8_t reserved[2];    /* д0 */
+} boot_delta_record_t;
+
+/* Ӧ */
+static struct {
+    boot_delta_header_t header;     /* ͷ */
+    uint32_t old_address;           /* ɾַ */
+    uint32_t new_address;           /* ¾ַ */
+    uint32_t sector_size;           /* ڴС */
+    uint32_t patch_offset;          /* ѴĲ */
+    uint32_t output;                /* д¾񳤶 */
+    uint32_t fill;                  /* 䳤 */
+    uint32_t remaining;             /* ǰʣ೤ */
+    uint32_t run;                   /* ǰʣ೤ */
+    uint32_t old_offset;            /* ɾα */
+    uint32_t value;                 /* ڽLEB128 */
+    uint8_t shift;                  /* ڽLEB128ѽλ */
+    uint8_t state;                  /* Ӧ״̬ */
+    uint8_t op;                     /* ǰ */
+    uint8_t resumed;                /* ӽȼ¼ */
+    uint32_t sectors;               /* д */
+    uint32_t records;               /* ѱȼ¼ */
+} boot_delta = {0};
+
+/* ¾ */
+static uint8_t boot_delta_window[NORFLASH_SECTOR_BUFFER_SIZE];
+
+/**
+ * @brief   ȼ¼
+ * @param   
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t boot_delta_record_save(void)
+{
+    boot_delta_record_t record;
+    
+    memset(&record, 0, sizeof(record));
+    record.header_crc = boot_delta.header.header_crc;
+    record.old_address = boot_delta.old_address;
+    record.new_address = boot_delta.new_address;
+    record.patch_offset = boot_delta.patch_offset;
+    record.output = boot_delta.output;
+    record.remaining = boot_delta.remaining;
+    record.run = boot_delta.run;
+    record.old_offset = boot_delta.old_offset;
+    record.state = boot_delta.state;
+    record.op = boot_delta.op;
+    
+    boot_delta.records++;
+    
+    return norflash_kv_set(BOOT_DELTA_RECORD_KEY, (uint8_t *)&record, sizeof(record));
+}
+
+/**
+ * @brief   ȡ뵱ǰƥĽȼ¼
+ * @param   
+ * @retval  ȡ
+ * @arg     0: ѻָ
+ * @arg     1: ƥĽȼ¼
+ */
+static uint8_t boot_delta_record_load(void)
+{
+    boot_delta_record_t record;
+    uint16_t length;
+    
+    if ((norflash_kv_get(BOOT_DELTA_RECORD_KEY, (uint8_t *)&record, sizeof(record), &length) != 0) || (length != sizeof(record)))
+    {
+        return 1;
+    }
+    
+    if ((record.header_crc != boot_delta.header.header_crc) || (record.old_address != boot_delta.old_address) ||
+        (record.new_address != boot_delta.new_address) || (record.patch_offset > boot_delta.header.patch_size) ||
+        (record.output >= boot_delta.header.new_size) || ((record.output % boot_delta.sector_size) != 0) ||
+        (record.old_offset > boot_delta.header.old_size) || (record.run > record.remaining) ||
+        (record.remaining > (boot_delta.header.new_size - record.output)))
+    {
+        return 1;
+    }
+    
+    if ((record.state != BOOT_DELTA_STATE_COPY) && (record.state != BOOT_DELTA_STATE_DATA) &&
+        (record.state != BOOT_DELTA_STATE_ADD_ZERO) && (record.state != BOOT_DELTA_STATE_ADD_DIFF))
+    {
+        return 1;
+    }
+    
+    boot_delta.patch_offset = record.patch_offset;
+    boot_delta.output = record.output;
+    boot_delta.remaining = record.remaining;
+    boot_delta.run = record.run;
+    boot_delta.old_offset = record.old_offset;
+    boot_delta.state = record.state;
+    boot_delta.op = record.op;
+    
+    return 0;
+}
+
+/**
+ * @brief   Ѵд¾
+ * @note    ˳ڴӳ䣨жϣд룬ȼ¼ǰָڴӳж
+ * @param   
+ * @retval  д
+ * @arg     0: дɹ
+ * @arg     1: дʧ
+ */
+static uint8_t boot_delta_flush(void)
+{
+    uint32_t length = boot_delta.fill;
+    uint32_t mapped;
+    uint8_t res;
+    
+    if (length == 0)
+    {
+        return 0;
+    }
+    
+    /* ˫ģʽ밴żд룬һֽڲ0xFF */
+    if ((length & 1) != 0)
+    {
+        boot_delta_window[length++] = 0xFF;
+    }
+    
+    if (norflash_memory_mapped_suspend(&mapped) != 0)
+    {
+        return 1;
+    }
+    
+    res = norflash_write(boot_delta.new_address + boot_delta.output, boot_delta_window, length);
+    if (res == 0)
+    {
+        boot_delta.output += boot_delta.fill;
+        boot_delta.fill = 0;
+        boot_delta.sectors++;
+        
+        if ((boot_delta.output < boot_delta.header.new_size) && ((boot_delta.sectors % BOOT_DELTA_RECORD_SECTORS) == 0))
+        {
+            res = boot_delta_record_save();
+        }
+    }
+    
+    res |= norflash_memory_mapped_resume(mapped);
+    
+    return res;
+}
+
+/**
+ * @brief   ɵLEB128ֶ
+ * @param   value: ֵֶ
+ * @retval  
+ * @arg     0: ֶЧ
+ * @arg     1: ֶЧ
+ */
+static uint8_t boot_delta_field(uint32_t value)
+{
+    uint32_t produced = boot_delta.output + boot_delta.fill;
+    uint32_t offset;
+    
+    switch (boot_delta.state)
+    {
+        case BOOT_DELTA_STATE_LENGTH:
+        {
+            if ((value == 0) || (value > (boot_delta.header.new_size - produced)))
+            {
+                return 1;
+            }
+            
+            boot_delta.remaining = value;
+            if (boot_delta.op == BOOT_DELTA_OP_DATA)
+            {
+                boot_delta.run = value;
+                boot_delta.state = BOOT_DELTA_STATE_DATA;
+            }
+            else
+            {
+                boot_delta.state = BOOT_DELTA_STATE_OFFSET;
+            }
+            break;
+        }
+        case BOOT_DELTA_STATE_OFFSET:
+        {
+            /* zigzagӵɾα꣬öȫλھɾ */
+            offset = boot_delta.old_offset + ((value >> 1) ^ (0UL - (value & 1)));
+            if ((offset > boot_delta.header.old_size) || (boot_delta.remaining > (boot_delta.header.old_size - offset)))
+            {
+                return 1;
+            }
+            
+            boot_delta.old_offset = offset;
+            if (boot_delta.op == BOOT_DELTA_OP_COPY)
+            {
+                boot_delta.run = boot_delta.remaining;
+                boot_delta.state = BOOT_DELTA_STATE_COPY;
+            }
+            else
+            {
+                boot_delta.state = BOOT_DELTA_STATE_ADD_SKIP;
+            }
+            break;
+        }
+        case BOOT_DELTA_STATE_ADD_SKIP:
+        case BOOT_DELTA_STATE_ADD_COUNT:
+        {
+            if (value > boot_delta.remaining)
+            {
+                return 1;
+            }
+            
+            boot_delta.run = value;
+            boot_delta.state = (boot_delta.state == BOOT_DELTA_STATE_ADD_SKIP) ? BOOT_DELTA_STATE_ADD_ZERO : BOOT_DELTA_STATE_ADD_DIFF;
+            break;
+        }
+        default:
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   
+ * @note    봦ڴӳģʽCOPYADDвֵΪ0Ĳֲ룬Լ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: Чдʧ
+ */
+static uint8_t boot_delta_process(const uint8_t *data, uint32_t length)
+{
+    const uint8_t *old;
+    uint32_t chunk;
+    uint32_t index;
+    uint8_t byte;
+    
+    while (1)
+    {
+        switch (boot_delta.state)
+        {
+            case BOOT_DELTA_STATE_OP:
+            {
+                if ((boot_delta.output + boot_delta.fill) == boot_delta.header.new_size)
+                {
+                    boot_delta.state = BOOT_DELTA_STATE_DONE;
+                    if (boot_delta_flush() != 0)
+                    {
+                        return 1;
+                    }
+                    break;
+                }
+                
+                if (length == 0)
+                {
+                    return 0;
+                }
+                
+                boot_delta.op = *data++;
+                length--;
+                boot_delta.patch_offset++;
+                if ((boot_delta.op != BOOT_DELTA_OP_COPY) && (boot_delta.op != BOOT_DELTA_OP_DATA) && (boot_delta.op != BOOT_DELTA_OP_ADD))
+                {
+                    return 1;
+                }
+                
+                boot_delta.value = 0;
+                boot_delta.shift = 0;
+                boot_delta.state = BOOT_DELTA_STATE_LENGTH;
+                break;
+            }
+            case BOOT_DELTA_STATE_LENGTH:
+            case BOOT_DELTA_STATE_OFFSET:
+            case BOOT_DELTA_STATE_ADD_SKIP:
+            case BOOT_DELTA_STATE_ADD_COUNT:
+            {
+                if (length == 0)
+                {
+                    return 0;
+                }
+                
+                byte = *data++;
+                length--;
+                boot_delta.patch_offset++;
+                
+                if ((boot_delta.shift > 28) || ((boot_delta.shift == 28) && ((byte & 0x70) != 0)))
+                {
+                    return 1;
+                }
+                boot_delta.value |= (uint32_t)(byte & 0x7F) << boot_delta.shift;
+                boot_delta.shift += 7;
+                if ((byte & 0x80) != 0)
+                {
+                    break;
+                }
+                
+                if (boot_delta_field(boot_delta.value) != 0)
+                {
+                    return 1;
+                }
+                boot_delta.value = 0;
+                boot_delta.shift = 0;
+                break;
+            }
+            case BOOT_DELTA_STATE_COPY:
+            case BOOT_DELTA_STATE_ADD_ZERO:
+            {
+                if (boot_delta.run == 0)
+                {
+                    boot_delta.state = (boot_delta.state == BOOT_DELTA_STATE_COPY) ? BOOT_DELTA_STATE_OP : BOOT_DELTA_STATE_ADD_COUNT;
+                    break;
+                }
+                
+                chunk = boot_delta.sector_size - boot_delta.fill;
+                chunk = (boot_delta.run < chunk) ? boot_delta.run : chunk;
+                old = (const uint8_t *)(NORFLASH_MEMORY_MAPPED_BASE + boot_delta.old_address + boot_delta.old_offset);
+                memcpy(&boot_delta_window[boot_delta.fill], old, chunk);
+                
+                boot_delta.fill += chunk;
+                boot_delta.old_offset += chunk;
+                boot_delta.run -= chunk;
+                boot_delta.remaining -= chunk;
+                if ((boot_delta.fill == boot_delta.sector_size) && (boot_delta_flush() != 0))
+                {
+                    return 1;
+                }
+                break;
+            }
+            case BOOT_DELTA_STATE_DATA:
+            case BOOT_DELTA_STATE_ADD_DIFF:
+            {
+                if (boot_delta.run == 0)
+                {
+                    if ((boot_delta.state == BOOT_DELTA_STATE_DATA) || (boot_delta.remaining == 0))
+                    {
+                        boot_delta.state = BOOT_DELTA_STATE_OP;
+                    }
+                    else
+                    {
+                        boot_delta.state = BOOT_DELTA_STATE_ADD_SKIP;
+                    }
+                    break;
+                }
+                
+                if (length == 0)
+                {
+                    return 0;
+                }
+                
+                chunk = boot_delta.sector_size - boot_delta.fill;
+                chunk = (boot_delta.run < chunk) ? boot_delta.run : chunk;
+                chunk = (length < chunk) ? length : chunk;
+                if (boot_delta.state == BOOT_DELTA_STATE_DATA)
+                {
+                    memcpy(&boot_delta_window[boot_delta.fill], data, chunk);
+                }
+                else
+                {
+                    old = (const uint8_t *)(NORFLASH_MEMORY_MAPPED_BASE + boot_delta.old_address + boot_delta.old_offset);
+                    for (index = 0; index < chunk; index++)
+                    {
+                        boot_delta_window[boot_delta.fill + index] = (uint8_t)(old[index] + data[index]);
+                    }
+                    boot_delta.old_offset += chunk;
+                }
+                
+                data += chunk;
+                length -= chunk;
+                boot_delta.patch_offset += chunk;
+                boot_delta.fill += chunk;
+                boot_delta.run -= chunk;
+                boot_delta.remaining -= chunk;
+                if ((boot_delta.fill == boot_delta.sector_size) && (boot_delta_flush() != 0))
+                {
+                    return 1;
+                }
+                break;
+            }
+            case BOOT_DELTA_STATE_DONE:
+            {
+                return (length == 0) ? 0 : 1;
+            }
+            default:
+            {
+                return 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief   ʼӦò
+ * @note    鲹ͷɾͷֵ洢ͬһĽȼ¼ʱӼ¼
+ *          ɵĽȼ¼ͷʼߴ*offsetͷ
+ * @param   old_address: ɾַNOR Flashƫƣ
+ * @param   new_address: ¾ַNOR Flashƫƣɾص
+ * @param   header: ͷ
+ * @param   offset: ӦӲĸƫƴʼ
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: ͷЧɾƥʧ
+ */
+uint8_t boot_delta_begin(uint32_t old_address, uint32_t new_address, const boot_delta_header_t *header, uint32_t *offset)
+{
+    boot_image_header_t image;
+    uint32_t chip_size;
+    uint32_t crc;
+    uint32_t mapped;
+    uint8_t res;
+    
+    memset(&boot_delta, 0, sizeof(boot_delta));
+    
+    if ((header->magic != BOOT_DELTA_MAGIC) || (header->version != BOOT_DELTA_VERSION) || (header->header_size != sizeof(boot_delta_header_t)))
+    {
+        return 1;
+    }
+    
+    /* λNOR Flashһص */
+    chip_size = norflash_get_chip_size();
+    if ((header->old_size <= BOOT_IMAGE_HEADER_SIZE) || (header->new_size <= BOOT_IMAGE_HEADER_SIZE) || (((old_address | new_address) & 1) != 0) ||
+        (old_address >= chip_size) || (header->old_size > (chip_size - old_address)) ||
+        (new_address >= chip_size) || (header->new_size > (chip_size - new_address)) ||
+        ((old_address < (new_address + header->new_size)) && (new_address < (old_address + header->old_size))))
+    {
+        return 1;
+    }
+    
+    boot_delta.sector_size = norflash_get_sector_size();
+    if ((boot_delta.sector_size == 0) || (boot_delta.sector_size > sizeof(boot_delta_window)) || ((new_address % boot_delta.sector_size) != 0))
+    {
+        return 1;
+    }
+    
+    if (norflash_memory_mapped_suspend(&mapped) != 0)
+    {
+        return 1;
+    }
+    
+    res = boot_image_crc32_calculate((const uint8_t *)header, offsetof(boot_delta_header_t, header_crc), &crc);
+    if ((res == 0) && (crc != header->header_crc))
+    {
+        res = 1;
+    }
+    
+    /* ɾΪɲʱľ */
+    if (res == 0)
+    {
+        res = norflash_read(old_address, (uint8_t *)&image, sizeof(image));
+    }
+    if ((res == 0) && ((image.header_crc != header->old_header_crc) || ((image.image_size + BOOT_IMAGE_HEADER_SIZE) != header->old_size)))
+    {
+        res = 1;
+    }
+    
+    if (res == 0)
+    {
+        boot_delta.header = *header;
+        boot_delta.old_address = old_address;
+        boot_delta.new_address = new_address;
+        
+        if (boot_delta_record_load() == 0)
+        {
+            boot_delta.resumed = 1;
+        }
+        else
+        {
+            boot_delta.state = BOOT_DELTA_STATE_OP;
+            res = norflash_kv_delete(BOOT_DELTA_RECORD_KEY);
+        }
+    }
+    
+    res |= norflash_memory_mapped_resume(mapped);
+    
+    if (res != 0)
+    {
+        boot_delta.state = BOOT_DELTA_STATE_IDLE;
+        return 1;
+    }
+    
+    *offset = boot_delta.patch_offset;
+    
+    return 0;
+}
+
+/**
+ * @brief   
+ * @note    ɰⳤȷֶ룻ڼڴӳȡɾ񣬷ǰָʱģʽ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧܣЧдʧܣȼ¼¿ʼ
+ */
+uint8_t boot_delta_write(const uint8_t *data, uint32_t length)
+{
+    uint8_t mapped;
+    uint8_t res;
+    
+    if ((boot_delta.state == BOOT_DELTA_STATE_IDLE) || (boot_delta.state == BOOT_DELTA_STATE_ERROR))
+    {
+        return 1;
+    }
+    
+    if (length > (boot_delta.header.patch_size - boot_delta.patch_offset))
+    {
+        boot_delta.state = BOOT_DELTA_STATE_ERROR;
+        return 1;
+    }
+    
+    mapped = norflash_memory_mapped_state();
+    if (norflash_memory_mapped() != 0)
+    {
+        return 1;
+    }
+    
+    res = boot_delta_process(data, length);
+    if (res != 0)
+    {
+        boot_delta.state = BOOT_DELTA_STATE_ERROR;
+    }
+    
+    if (mapped == 0)
+    {
+        res |= norflash_memory_mapped_exit();
+    }
+    
+    return res;
+}
+
+/**
+ * @brief   У¾
+ * @note    ¾ͷ벹ͷһ£УCRC32/SHA-256ȼ¼
+ * @param   
+ * @retval  
+ * @arg     0: ¾Ч
+ * @arg     1: δӦ¾Ч
+ */
+uint8_t boot_delta_finish(void)
+{
+    boot_image_header_t image;
+    uint32_t mapped;
+    uint8_t res;
+    
+    if ((boot_delta.state != BOOT_DELTA_STATE_DONE) || (boot_delta.patch_offset != boot_delta.header.patch_size))
+    {
+        return 1;
+    }
+    
+    boot_delta.state = BOOT_DELTA_STATE_IDLE;
+    
+    if (norflash_memory_mapped_suspend(&mapped) != 0)
+    {
+        return 1;
+    }
+    
+    /* ¾ǰܾӳ䴰ڶCacheеľݺУ */
+    SCB_InvalidateDCache_by_Addr((volatile void *)(NORFLASH_MEMORY_MAPPED_BASE + boot_delta.new_address), (int32_t)boot_delta.header.new_size);
+    
+    res = norflash_read(boot_delta.new_address, (uint8_t *)&image, sizeof(image));
+    if ((res == 0) && (image.header_crc != boot_delta.header.new_header_crc))
+    {
+        res = 1;
+    }
+    if (res == 0)
+    {
+        res = boot_image_check(boot_delta.new_address, &image);
+    }
+    
+    res |= norflash_kv_delete(BOOT_DELTA_RECORD_KEY);
+    
+    res |= norflash_memory_mapped_resume(mapped);
+    
+    return res;
+}
+
+/**
+ * @brief   ȡ½
+ * @param   progress: ½
+ * @retval  
+ */
+void boot_delta_get_progress(boot_delta_progress_t *progress)
+{
+    progress->patch_offset = boot_delta.patch_offset;
+    progress->patch_size = boot_delta.header.patch_size;
+    progress->output = boot_delta.output + boot_delta.fill;
+    progress->new_size = boot_delta.header.new_size;
+    progress->sectors = boot_delta.sectors;
+    progress->records = boot_delta.records;
+    progress->resumed = boot_delta.resumed;
+    progress->done = (boot_delta.state == BOOT_DELTA_STATE_DONE) ? 1 : 0;
+}
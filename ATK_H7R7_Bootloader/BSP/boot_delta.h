@@ -0,0 +1,70 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_delta.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       Ӧó£ʽӦã
+ ****************************************************************************************************
+ * @attention
+ *
+ * Tools/image_deltaݾɡľ񣨺ͷɣɲͷɣ
+ * ¾˳ÿһݣ
+ *   COPY: ȡɾƫӾɾ
+ *   ADD:  ȡɾƫ飨ȡֵֵ=+ֵ
+ *         ֲֵΪ0ʺӵһۺֻеַͬĴ
+ *   DATA: ȣΪ
+ * ȡֵΪ޷LEB128ƫΪzigzagLEB128һξɾλã
+ * ļֻʹ<stdint.h>߿ֱӰ޸ĲʽʱͬʱЧ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __BOOT_DELTA_H
+#define __BOOT_DELTA_H
+
+#include <stdint.h>
+
+/* ͷʶ汾 */
+#define BOOT_DELTA_MAGIC            (0x544C4441UL)  /* "ADLT" */
+#define BOOT_DELTA_VERSION          (1)
+
+/*  */
+#define BOOT_DELTA_OP_COPY          (0x01)
+#define BOOT_DELTA_OP_DATA          (0x02)
+#define BOOT_DELTA_OP_ADD           (0x03)
+
+/* ȼ¼壨ÿдһνȣ */
+#define BOOT_DELTA_RECORD_SECTORS   (16)
+
+/* ͷ壨СˣͷCRCheader_crc֮ǰȫԱ */
+typedef struct {
+    uint32_t magic;             /* ʶ */
+    uint16_t version;           /* ʽ汾 */
+    uint16_t header_size;       /* ͷ */
+    uint32_t old_size;          /* ɾ񳤶ȣͷ */
+    uint32_t old_header_crc;    /* ɾͷCRC32 */
+    uint32_t new_size;          /* ¾񳤶ȣͷ */
+    uint32_t new_header_crc;    /* ¾ͷCRC32 */
+    uint32_t patch_size;        /*  */
+    uint32_t header_crc;        /* ͷCRC32 */
+} boot_delta_header_t;
+
+/* ½ȶ */
+typedef struct {
+    uint32_t patch_offset;      /* ѴĲ */
+    uint32_t patch_size;        /*  */
+    uint32_t output;            /* ¾񳤶 */
+    uint32_t new_size;          /* ¾񳤶 */
+    uint32_t sectors;           /* д */
+    uint32_t records;           /* ѱȼ¼ */
+    uint8_t resumed;            /* ӽȼ¼ */
+    uint8_t done;               /* ¾ȫ */
+} boot_delta_progress_t;
+
+/*  */
+uint8_t boot_delta_begin(uint32_t old_address, uint32_t new_address, const boot_delta_header_t *header, uint32_t *offset);    /* ʼӦò */
+uint8_t boot_delta_write(const uint8_t *data, uint32_t length);                     /*  */
+uint8_t boot_delta_finish(void);                                                    /* У¾ */
+void boot_delta_get_progress(boot_delta_progress_t *progress);                      /* ȡ½ */
+
+#endif /* __BOOT_DELTA_H */
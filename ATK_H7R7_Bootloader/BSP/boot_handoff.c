@@ -0,0 +1,199 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_handoff.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       BootloaderӦóĽӿ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ӿλڱSRAMĹ̶ַɢأBootloaderӦóԴ򿪱SRAM
+ * Уʱѽӿ뵱ǰĴȽϣֻBootloaderȷʵ˶Ӧʱͨ
+ *
+ ****************************************************************************************************
+ */
+
+#include "boot_handoff.h"
+#include "main.h"
+#include <stddef.h>
+#include <string.h>
+
+#define BOOT_HANDOFF                ((boot_handoff_t *)BOOT_HANDOFF_BASE)
+
+/* RCC->CRвУľλ */
+#define BOOT_HANDOFF_RCC_CR_READY   (RCC_CR_HSERDY | RCC_CR_PLL1RDY | RCC_CR_PLL2RDY | RCC_CR_PLL3RDY)
+
+/**
+ * @brief   򿪱SRAM
+ * @param   
+ * @retval  
+ */
+static void boot_handoff_enable(void)
+{
+    SET_BIT(PWR->CR1, PWR_CR1_DBP);
+    __HAL_RCC_BKPRAM_CLK_ENABLE();
+}
+
+/**
+ * @brief   㽻ӿУ
+ * @param   handoff: ӿ
+ * @retval  У
+ */
+static uint32_t boot_handoff_checksum(const boot_handoff_t *handoff)
+{
+    const uint32_t *word = (const uint32_t *)handoff;
+    uint32_t sum = 0;
+    uint32_t index;
+    
+    for (index = 0; index < (offsetof(boot_handoff_t, checksum) / sizeof(uint32_t)); index++)
+    {
+        sum += word[index];
+    }
+    
+    return ~sum;
+}
+
+/**
+ * @brief   ȡǰʱXSPI1
+ * @param   handoff: ӿ
+ * @retval  
+ */
+static void boot_handoff_capture(boot_handoff_t *handoff)
+{
+    handoff->sysclk = SystemCoreClock;
+    handoff->hclk = HAL_RCC_GetHCLKFreq();
+    handoff->rcc_cr = RCC->CR & BOOT_HANDOFF_RCC_CR_READY;
+    handoff->rcc_cfgr = RCC->CFGR;
+    handoff->rcc_cdcfgr = RCC->CDCFGR;
+    handoff->rcc_bmcfgr = RCC->BMCFGR;
+    handoff->rcc_apbcfgr = RCC->APBCFGR;
+    handoff->rcc_pllckselr = RCC->PLLCKSELR;
+    handoff->rcc_pllcfgr = RCC->PLLCFGR;
+    handoff->rcc_plldivr1[0] = RCC->PLL1DIVR1;
+    handoff->rcc_plldivr1[1] = RCC->PLL2DIVR1;
+    handoff->rcc_plldivr1[2] = RCC->PLL3DIVR1;
+    handoff->rcc_plldivr2[0] = RCC->PLL1DIVR2;
+    handoff->rcc_plldivr2[1] = RCC->PLL2DIVR2;
+    handoff->rcc_plldivr2[2] = RCC->PLL3DIVR2;
+    handoff->rcc_pllfracr[0] = RCC->PLL1FRACR;
+    handoff->rcc_pllfracr[1] = RCC->PLL2FRACR;
+    handoff->rcc_pllfracr[2] = RCC->PLL3FRACR;
+    handoff->rcc_ccipr1 = RCC->CCIPR1;
+    handoff->flash_acr = FLASH->ACR;
+    handoff->pwr_csr4 = PWR->CSR4;
+    
+    handoff->xspi_cr = XSPI1->CR;
+    handoff->xspi_dcr[0] = XSPI1->DCR1;
+    handoff->xspi_dcr[1] = XSPI1->DCR2;
+    handoff->xspi_dcr[2] = XSPI1->DCR3;
+    handoff->xspi_dcr[3] = XSPI1->DCR4;
+    handoff->xspi_ccr = XSPI1->CCR;
+    handoff->xspi_tcr = XSPI1->TCR;
+    handoff->xspi_ir = XSPI1->IR;
+}
+
+/**
+ * @brief   潻ӿ
+ * @note    BootloaderXSPI1ڴӳתǰã
+ *          BOOT_HANDOFF_KEEP_CLOCKΪ1ϵͳʱPLL1ʱBOOT_HANDOFF_FLAG_CLOCKBoot_JumpToApp()ݴ˱ʱ
+ * @param   slot: Ĳۺ
+ * @param   image_version: 汾
+ * @param   load_address: ַ
+ * @param   norflash_type: NOR Flash
+ * @param   read_profile: ڴӳ
+ * @retval  
+ */
+void boot_handoff_save(uint8_t slot, uint32_t image_version, uint32_t load_address, uint8_t norflash_type, uint8_t read_profile)
+{
+    boot_handoff_t *handoff = BOOT_HANDOFF;
+    
+    boot_handoff_enable();
+    
+    memset(handoff, 0, sizeof(boot_handoff_t));
+    handoff->magic = BOOT_HANDOFF_MAGIC;
+    handoff->version = BOOT_HANDOFF_VERSION;
+    handoff->size = sizeof(boot_handoff_t);
+    handoff->slot = slot;
+    handoff->image_version = image_version;
+    handoff->load_address = load_address;
+    handoff->norflash_type = norflash_type;
+    handoff->read_profile = read_profile;
+    boot_handoff_capture(handoff);
+    
+    if ((BOOT_HANDOFF_KEEP_CLOCK != 0) && ((RCC->CFGR & RCC_CFGR_SWS) == RCC_SYSCLKSOURCE_STATUS_PLLCLK))
+    {
+        handoff->flags |= BOOT_HANDOFF_FLAG_CLOCK;
+    }
+    if (((XSPI1->CR & XSPI_CR_EN) != 0) && ((XSPI1->CR & XSPI_CR_FMODE) == XSPI_CR_FMODE))
+    {
+        handoff->flags |= BOOT_HANDOFF_FLAG_XSPI_MAPPED;
+    }
+    
+    handoff->checksum = boot_handoff_checksum(handoff);
+}
+
+/**
+ * @brief   ȡӿ
+ * @param   
+ * @retval  ӿ飬ħ汾СУͲʱNULL
+ */
+const boot_handoff_t *boot_handoff_get(void)
+{
+    const boot_handoff_t *handoff = BOOT_HANDOFF;
+    
+    boot_handoff_enable();
+    
+    if ((handoff->magic != BOOT_HANDOFF_MAGIC) || (handoff->version != BOOT_HANDOFF_VERSION) || (handoff->size != sizeof(boot_handoff_t)))
+    {
+        return NULL;
+    }
+    if (handoff->checksum != boot_handoff_checksum(handoff))
+    {
+        return NULL;
+    }
+    
+    return handoff;
+}
+
+/**
+ * @brief   У齻ӿ뵱ǰӲǷһ
+ * @param   flags: ҪõãBOOT_HANDOFF_FLAG_xxx
+ * @retval  У
+ * @arg     0: ӿЧflagsеþBootloader뵱ǰĴһ
+ * @arg     1: ӿЧѸı䣬
+ */
+uint8_t boot_handoff_check(uint32_t flags)
+{
+    const boot_handoff_t *handoff;
+    boot_handoff_t live;
+    
+    handoff = boot_handoff_get();
+    if ((handoff == NULL) || ((handoff->flags & flags) != flags))
+    {
+        return 1;
+    }
+    
+    boot_handoff_capture(&live);
+    
+    /* ʱrcc_crpwr_csr4ֱȽϣSystemCoreClockδ£Ƚϣ */
+    if ((flags & BOOT_HANDOFF_FLAG_CLOCK) != 0)
+    {
+        if (((live.rcc_cfgr & RCC_CFGR_SWS) != RCC_SYSCLKSOURCE_STATUS_PLLCLK) ||
+            (memcmp(&live.rcc_cr, &handoff->rcc_cr, offsetof(boot_handoff_t, norflash_type) - offsetof(boot_handoff_t, rcc_cr)) != 0))
+        {
+            return 1;
+        }
+    }
+    
+    /* XSPI1ںʱԴڴӳ */
+    if ((flags & BOOT_HANDOFF_FLAG_XSPI_MAPPED) != 0)
+    {
+        if ((live.rcc_ccipr1 != handoff->rcc_ccipr1) ||
+            (memcmp(&live.xspi_cr, &handoff->xspi_cr, offsetof(boot_handoff_t, checksum) - offsetof(boot_handoff_t, xspi_cr)) != 0))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
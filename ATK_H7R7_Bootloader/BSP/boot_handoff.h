@@ -0,0 +1,83 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_handoff.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       BootloaderӦóĽӿ
+ ****************************************************************************************************
+ * @attention
+ *
+ * BootloaderתǰʱXSPI1ڴӳúľд뱸SRAMײĽӿ飬
+ * PLLXSPI1ֱתӦóboot_handoff_check()У齻ӿ뵱ǰӲһº
+ * ֱãִSystemClock_Config()XSPIʼ
+ * УʧܣBootloaderδʱӡӿ𻵻汾ʱӦó
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __BOOT_HANDOFF_H
+#define __BOOT_HANDOFF_H
+
+#include <stdint.h>
+
+/* תʱʱXSPI1Ϊ0ʱBootloaderԭʽHAL_RCC_DeInit()ָλʱӣ */
+#ifndef BOOT_HANDOFF_KEEP_CLOCK
+#define BOOT_HANDOFF_KEEP_CLOCK     (1)
+#endif
+
+/* ӿ鶨壨SRAMǰ2KB2KBΪʱ߸ٻ */
+#define BOOT_HANDOFF_BASE           (0x38800000UL)
+#define BOOT_HANDOFF_MAGIC          (0x46464F48UL)  /* "HOFF" */
+#define BOOT_HANDOFF_VERSION        (1)
+
+/* ӿ־ */
+#define BOOT_HANDOFF_FLAG_CLOCK         (1UL << 0)  /* PLL߷ƵBootloader */
+#define BOOT_HANDOFF_FLAG_XSPI_MAPPED   (1UL << 1)  /* XSPI1ڴӳ */
+
+/* ӿṹ */
+typedef struct {
+    uint32_t magic;                 /* BOOT_HANDOFF_MAGIC */
+    uint16_t version;               /* BOOT_HANDOFF_VERSION */
+    uint16_t size;                  /* sizeof(boot_handoff_t) */
+    uint32_t flags;                 /* BOOT_HANDOFF_FLAG_xxx */
+    
+    /* ľ */
+    uint32_t slot;                  /* ۺţBOOT_SLOT_A/BOOT_SLOT_B */
+    uint32_t image_version;         /* 汾 */
+    uint32_t load_address;          /* ַ */
+    
+    /* ʱ */
+    uint32_t sysclk;                /* CPUʱӣHz */
+    uint32_t hclk;                  /* AHBʱӣHz */
+    uint32_t rcc_cr;                /* RCC->CRPLLʹ/λ */
+    uint32_t rcc_cfgr;              /* RCC->CFGRϵͳʱԴ */
+    uint32_t rcc_cdcfgr;            /* RCC->CDCFGRCPUƵ */
+    uint32_t rcc_bmcfgr;            /* RCC->BMCFGRAHBƵ */
+    uint32_t rcc_apbcfgr;           /* RCC->APBCFGRAPBƵ */
+    uint32_t rcc_pllckselr;         /* RCC->PLLCKSELRPLLʱԴMƵ */
+    uint32_t rcc_pllcfgr;           /* RCC->PLLCFGRPLLʹܣ */
+    uint32_t rcc_plldivr1[3];       /* RCC->PLL1/2/3DIVR1 */
+    uint32_t rcc_plldivr2[3];       /* RCC->PLL1/2/3DIVR2 */
+    uint32_t rcc_pllfracr[3];       /* RCC->PLL1/2/3FRACR */
+    uint32_t rcc_ccipr1;            /* RCC->CCIPR1XSPIںʱԴ */
+    uint32_t flash_acr;             /* FLASH->ACRȴڣ */
+    uint32_t pwr_csr4;              /* PWR->CSR4ѹڵȼ */
+    
+    /* XSPI1 */
+    uint32_t norflash_type;         /* NOR Flashͣnorflash_type_t */
+    uint32_t read_profile;          /* ڴӳãnorflash_read_profile_t */
+    uint32_t xspi_cr;               /* XSPI1->CR */
+    uint32_t xspi_dcr[4];           /* XSPI1->DCR1~DCR4 */
+    uint32_t xspi_ccr;              /* XSPI1->CCRڴӳʽ */
+    uint32_t xspi_tcr;              /* XSPI1->TCRڣ */
+    uint32_t xspi_ir;               /* XSPI1->IRڴӳָ */
+    
+    uint32_t checksum;              /* ϸ֮ȡ */
+} boot_handoff_t;
+
+/*  */
+void boot_handoff_save(uint8_t slot, uint32_t image_version, uint32_t load_address, uint8_t norflash_type, uint8_t read_profile);  /* 潻ӿ飨Bootloaderתǰ */
+uint8_t boot_handoff_check(uint32_t flags);                                         /* У齻ӿ뵱ǰӲǷһ */
+const boot_handoff_t *boot_handoff_get(void);                                       /* ȡӿ */
+
+#endif /* __BOOT_HANDOFF_H */
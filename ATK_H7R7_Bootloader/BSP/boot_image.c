@@ -0,0 +1,446 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_image.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       BootloaderӦóУ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ÿֻӶȡͷ븴λ飨ʶͷCRCַȡڣ
+ * CRC32CRC裩SHA-256HASH裩ͨڴӳ䴰ڼ㣬
+ * ͨڼֵ洢м¼Уǣͷʱֱʹøñǣֻиº¼
+ * ǰѹؼֵ洢norflash_kv_mount()NOR Flashڴӳģʽ
+ * ѹʱתǰڴӳģʽµboot_image_load_sections()ѸνѹITCM/AXI SRAM
+ *
+ ****************************************************************************************************
+ */
+
+#include "boot_image.h"
+#include "norflash_kv.h"
+#include "boot_lz4.h"
+#include <stddef.h>
+#include <string.h>
+
+/* HASH㳬ʱ壨ms */
+#define BOOT_IMAGE_HASH_TIMEOUT     (10000UL)
+
+/* ĿĵַתΪָ루main.hضΪRAM */
+#ifndef BOOT_IMAGE_SECTION_POINTER
+#define BOOT_IMAGE_SECTION_POINTER(address)     ((uint8_t *)(address))
+#endif
+
+/* УǶ壨ڼֵ洢УΪ"boot.image@"Ӿַ */
+typedef struct {
+    uint32_t address;       /* ַ */
+    uint32_t header_crc;    /* ͷCRC32 */
+    uint32_t crc32;         /* ӦóCRC32 */
+} boot_image_verified_t;
+
+/* У */
+static CRC_HandleTypeDef boot_image_crc;
+static HASH_HandleTypeDef boot_image_hash;
+static uint8_t boot_image_ready = 0;
+
+/* һξУ鱨 */
+static boot_image_report_t boot_image_report;
+
+/**
+ * @brief   ʼCRCHASH
+ * @note    CRCΪ밴ֽڷתתȡzlib crc32()һ
+ * @param   
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: ʼʧ
+ */
+static uint8_t boot_image_hw_init(void)
+{
+    if (boot_image_ready != 0)
+    {
+        return 0;
+    }
+    
+    __HAL_RCC_CRC_CLK_ENABLE();
+    __HAL_RCC_HASH_CLK_ENABLE();
+    
+    boot_image_crc.Instance = CRC;
+    boot_image_crc.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_ENABLE;
+    boot_image_crc.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_ENABLE;
+    boot_image_crc.Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_BYTE;
+    boot_image_crc.Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_ENABLE;
+    boot_image_crc.InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
+    if (HAL_CRC_Init(&boot_image_crc) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    boot_image_hash.Instance = HASH;
+    boot_image_hash.Init.DataType = HASH_BYTE_SWAP;
+    boot_image_hash.Init.Algorithm = HASH_ALGOSELECTION_SHA256;
+    if (HAL_HASH_Init(&boot_image_hash) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    boot_image_ready = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief   CRCCRC32
+ * @param   data: ָ
+ * @param   length: ݳ
+ * @retval  CRC32
+ */
+static uint32_t boot_image_crc32(const uint8_t *data, uint32_t length)
+{
+    return HAL_CRC_Calculate(&boot_image_crc, (uint32_t *)data, length) ^ 0xFFFFFFFFUL;
+}
+
+/**
+ * @brief   Уǵļ
+ * @param   address: ַ
+ * @param   key: 20ֽ
+ * @retval  
+ */
+static void boot_image_key(uint32_t address, char *key)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    uint8_t index;
+    
+    memcpy(key, "boot.image@", 11);
+    for (index = 0; index < 8; index++)
+    {
+        key[11 + index] = hex[(address >> (28 - 4 * index)) & 0x0F];
+    }
+    key[19] = '\0';
+}
+
+/**
+ * @brief   龵ͷ
+ * @param   address: ַ
+ * @param   header: ͷ
+ * @retval  
+ * @arg     0: ͷЧ
+ * @arg     1: ͷЧ
+ */
+static uint8_t boot_image_header_check(uint32_t address, const boot_image_header_t *header)
+{
+    uint32_t chip_size;
+    uint32_t load_address;
+    
+    if ((header->magic != BOOT_IMAGE_MAGIC) || (header->header_version != BOOT_IMAGE_HEADER_VERSION) || (header->header_size != BOOT_IMAGE_HEADER_SIZE))
+    {
+        return 1;
+    }
+    
+    if (header->header_crc != boot_image_crc32((const uint8_t *)header, offsetof(boot_image_header_t, header_crc)))
+    {
+        return 1;
+    }
+    
+    /* Ӧóھͷ֮ҲNOR Flash */
+    load_address = BOOT_IMAGE_XSPI_BASE + address + BOOT_IMAGE_HEADER_SIZE;
+    if (header->load_address != load_address)
+    {
+        return 1;
+    }
+    
+    chip_size = norflash_get_chip_size();
+    if ((address >= chip_size) || ((chip_size - address) < BOOT_IMAGE_HEADER_SIZE))
+    {
+        return 1;
+    }
+    if ((header->image_size < 8) || (header->image_size > (chip_size - address - BOOT_IMAGE_HEADER_SIZE)))
+    {
+        return 1;
+    }
+    
+    /* ΪThumbַλӦó */
+    if (((header->entry_address & 1) == 0) || (header->entry_address < load_address) || ((header->entry_address - load_address) >= header->image_size))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   УNOR FlashеӦó
+ * @note    ͷЧλڵַһʱֱʧܣУ뾵ͷһʱ
+ *          Уڼʱڴӳģʽǰ˳
+ * @param   address: ַNOR FlashƫƣΪż
+ * @param   header: ľͷ
+ * @retval  У
+ * @arg     0: Ч
+ * @arg     1: ЧУʧ
+ */
+uint8_t boot_image_check(uint32_t address, boot_image_header_t *header)
+{
+    boot_image_verified_t verified;
+    uint32_t vector[2];
+    uint32_t tick;
+    uint16_t length;
+    uint8_t sha256[32];
+    char key[20];
+    const uint8_t *image;
+    uint8_t res;
+    
+    memset(&boot_image_report, 0, sizeof(boot_image_report));
+    tick = HAL_GetTick();
+    
+    if ((address & 1) != 0)
+    {
+        return 1;
+    }
+    
+    if (boot_image_hw_init() != 0)
+    {
+        return 1;
+    }
+    
+    if (norflash_read(address, (uint8_t *)header, sizeof(boot_image_header_t)) != 0)
+    {
+        return 1;
+    }
+    if (boot_image_header_check(address, header) != 0)
+    {
+        return 1;
+    }
+    
+    if (norflash_read(address + BOOT_IMAGE_HEADER_SIZE, (uint8_t *)vector, sizeof(vector)) != 0)
+    {
+        return 1;
+    }
+    if (vector[1] != header->entry_address)
+    {
+        return 1;
+    }
+    
+    boot_image_report.header_ok = 1;
+    boot_image_report.image_size = header->image_size;
+    
+    /* ͷδ仯У */
+    boot_image_key(address, key);
+    if ((norflash_kv_get(key, (uint8_t *)&verified, sizeof(verified), &length) == 0) && (length == sizeof(verified)) &&
+        (verified.address == address) && (verified.header_crc == header->header_crc) && (verified.crc32 == header->crc32))
+    {
+        boot_image_report.cached = 1;
+        boot_image_report.crc_ok = 1;
+        boot_image_report.sha256_ok = 1;
+        boot_image_report.elapsed = HAL_GetTick() - tick;
+        return 0;
+    }
+    
+    /* ͨڴӳ䴰ڼ */
+    if (norflash_memory_mapped() != 0)
+    {
+        return 1;
+    }
+    
+    image = (const uint8_t *)(NORFLASH_MEMORY_MAPPED_BASE + address + BOOT_IMAGE_HEADER_SIZE);
+    boot_image_report.crc_ok = (boot_image_crc32(image, header->image_size) == header->crc32) ? 1 : 0;
+    boot_image_report.sha256_ok = 1;
+    if ((boot_image_report.crc_ok != 0) && ((header->flags & BOOT_IMAGE_FLAG_SHA256) != 0))
+    {
+        if ((HAL_HASH_Start(&boot_image_hash, image, header->image_size, sha256, BOOT_IMAGE_HASH_TIMEOUT) != HAL_OK) ||
+            (memcmp(sha256, header->sha256, sizeof(sha256)) != 0))
+        {
+            boot_image_report.sha256_ok = 0;
+        }
+    }
+    
+    res = norflash_memory_mapped_exit();
+    boot_image_report.elapsed = HAL_GetTick() - tick;
+    
+    if ((res != 0) || (boot_image_report.crc_ok == 0) || (boot_image_report.sha256_ok == 0))
+    {
+        norflash_kv_delete(key);
+        return 1;
+    }
+    
+    /* ¼ʧܲӰ챾´У */
+    verified.address = address;
+    verified.header_crc = header->header_crc;
+    verified.crc32 = header->crc32;
+    norflash_kv_set(key, (uint8_t *)&verified, sizeof(verified));
+    
+    return 0;
+}
+
+/**
+ * @brief   ĿĵַΧ
+ * @param   address: Ŀĵַ
+ * @param   size: 
+ * @retval  
+ * @arg     0: λITCMAXI SRAM÷Χ
+ * @arg     1: Χ
+ */
+static uint8_t boot_image_section_range(uint32_t address, uint32_t size)
+{
+    if (((address - BOOT_IMAGE_ITCM_BASE) < BOOT_IMAGE_ITCM_SIZE) && (size <= (BOOT_IMAGE_ITCM_SIZE - (address - BOOT_IMAGE_ITCM_BASE))))
+    {
+        return 0;
+    }
+    
+    if (((address - BOOT_IMAGE_AXI_BASE) < BOOT_IMAGE_AXI_SIZE) && (size <= (BOOT_IMAGE_AXI_SIZE - (address - BOOT_IMAGE_AXI_BASE))))
+    {
+        return 0;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   ѹеĶεRAM
+ * @note    boot_image_check()ͨNOR Flashڴӳģʽʱãתǰ
+ *          ֱӴڴӳ䴰ڽѹĿĵַѹCRCУÿΣD-CacheЧI-Cache
+ *          񲻴BOOT_IMAGE_FLAG_SECTIONSʱֱӷسɹ
+ * @param   address: ַNOR Flashƫƣ
+ * @param   header: Уľͷ
+ * @retval  ѹ
+ * @arg     0: ѹɹ
+ * @arg     1: αЧγΧѹʧܣRAMݲת
+ */
+uint8_t boot_image_load_sections(uint32_t address, const boot_image_header_t *header)
+{
+    boot_image_section_table_t table;
+    boot_image_section_t section;
+    const uint8_t *image;
+    uint8_t *dst;
+    uint32_t tick;
+    uint32_t length;
+    uint32_t index;
+    
+    boot_image_report.section_count = 0;
+    boot_image_report.section_size = 0;
+    boot_image_report.section_packed = 0;
+    boot_image_report.section_elapsed = 0;
+    
+    if ((header->flags & BOOT_IMAGE_FLAG_SECTIONS) == 0)
+    {
+        return 0;
+    }
+    
+    tick = HAL_GetTick();
+    
+    if ((boot_image_hw_init() != 0) || (norflash_memory_mapped_state() == 0))
+    {
+        return 1;
+    }
+    
+    /* αλӦóΧ */
+    image = (const uint8_t *)(NORFLASH_MEMORY_MAPPED_BASE + address + BOOT_IMAGE_HEADER_SIZE);
+    if (((header->section_table & 3) != 0) || (header->section_table > header->image_size) ||
+        ((header->image_size - header->section_table) < sizeof(table)))
+    {
+        return 1;
+    }
+    
+    memcpy(&table, image + header->section_table, sizeof(table));
+    if ((table.magic != BOOT_IMAGE_SECTION_MAGIC) || (table.count > BOOT_IMAGE_SECTION_MAX) ||
+        ((header->image_size - header->section_table - sizeof(table)) < (table.count * sizeof(section))))
+    {
+        return 1;
+    }
+    
+    for (index = 0; index < table.count; index++)
+    {
+        memcpy(&section, image + header->section_table + sizeof(table) + index * sizeof(section), sizeof(section));
+        
+        if ((section.offset > header->image_size) || (section.packed_size > (header->image_size - section.offset)))
+        {
+            return 1;
+        }
+        if (boot_image_section_range(section.address, section.size) != 0)
+        {
+            return 1;
+        }
+        
+        dst = BOOT_IMAGE_SECTION_POINTER(section.address);
+        if (section.method == BOOT_IMAGE_METHOD_STORED)
+        {
+            if (section.packed_size != section.size)
+            {
+                return 1;
+            }
+            memcpy(dst, image + section.offset, section.size);
+        }
+        else if (section.method == BOOT_IMAGE_METHOD_LZ4)
+        {
+            if ((boot_lz4_decompress(image + section.offset, section.packed_size, dst, section.size, &length) != 0) || (length != section.size))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            return 1;
+        }
+        
+        if (boot_image_crc32(dst, section.size) != section.crc32)
+        {
+            return 1;
+        }
+        SCB_CleanDCache_by_Addr(dst, (int32_t)section.size);
+        
+        boot_image_report.section_count++;
+        boot_image_report.section_size += section.size;
+        boot_image_report.section_packed += section.packed_size;
+    }
+    
+    SCB_InvalidateICache();
+    boot_image_report.section_elapsed = HAL_GetTick() - tick;
+    
+    return 0;
+}
+
+/**
+ * @brief   У
+ * @note    д¾ǰãͷͬݱдʱҲ´У
+ * @param   address: ַ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t boot_image_invalidate(uint32_t address)
+{
+    char key[20];
+    
+    boot_image_key(address, key);
+    
+    return norflash_kv_delete(key);
+}
+
+/**
+ * @brief   ȡһξУ鱨
+ * @param   report: 
+ * @retval  
+ */
+void boot_image_get_report(boot_image_report_t *report)
+{
+    *report = boot_image_report;
+}
+
+/**
+ * @brief   CRCCRC32
+ * @note    zlib crc32()һ£ģУС
+ * @param   data: ָ
+ * @param   length: ݳ
+ * @param   crc: CRC32
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʼʧ
+ */
+uint8_t boot_image_crc32_calculate(const uint8_t *data, uint32_t length, uint32_t *crc)
+{
+    if (boot_image_hw_init() != 0)
+    {
+        return 1;
+    }
+    
+    *crc = boot_image_crc32(data, length);
+    
+    return 0;
+}
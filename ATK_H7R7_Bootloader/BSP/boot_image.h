@@ -0,0 +1,106 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_image.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ӦóͷBootloaderУ
+ ****************************************************************************************************
+ * @attention
+ *
+ * Tools/image_packerӦóbinļǰBOOT_IMAGE_HEADER_SIZEֽڵľͷɣ
+ * Ӧóӵͷ֮0x90000400stm32h7rsxx_ROMxspi1.sct
+ * BOOT_IMAGE_FLAG_SECTIONSľӦó֮󸽼Ӷα루LZ4ѹģݣimage_size
+ * BootloaderתǰѸνѹITCM/AXI SRAMboot_image_load_sections()
+ * ļֻʹ<stdint.h>ֱӰ޸ľͷʽʱͬʱЧ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __BOOT_IMAGE_H
+#define __BOOT_IMAGE_H
+
+#include <stdint.h>
+
+/* ͷʶ汾 */
+#define BOOT_IMAGE_MAGIC            (0x474D4941UL)  /* "AIMG" */
+#define BOOT_IMAGE_HEADER_VERSION   (1)
+
+/* ͷռÿռ䶨壨Ӧó밴1KB룩 */
+#define BOOT_IMAGE_HEADER_SIZE      (0x00000400UL)
+
+/* NOR Flashڴӳַ壨ͷеĵַΪCPUַ */
+#define BOOT_IMAGE_XSPI_BASE        (0x90000000UL)
+
+/* ־ */
+#define BOOT_IMAGE_FLAG_SHA256      (0x00000001UL)  /* sha256ЧУʱͬʱȽSHA-256 */
+#define BOOT_IMAGE_FLAG_SECTIONS    (0x00000002UL)  /* section_tableЧתǰѹ */
+
+/* α */
+#define BOOT_IMAGE_SECTION_MAGIC    (0x54434553UL)  /* "SECT" */
+#define BOOT_IMAGE_SECTION_MAX      (8)
+
+/* δ洢ʽ */
+#define BOOT_IMAGE_METHOD_STORED    (0)             /* ѹֱӸ */
+#define BOOT_IMAGE_METHOD_LZ4       (1)             /* LZ4ʽboot_lz4.h */
+
+/* ĿĵַΧ壨ITCMAXI SRAMBootloaderӦóRW_RAMʹõĲ֣stm32h7rsxx_ROMxspi1.sct */
+#define BOOT_IMAGE_ITCM_BASE        (0x00000000UL)
+#define BOOT_IMAGE_ITCM_SIZE        (0x00010000UL)
+#define BOOT_IMAGE_AXI_BASE         (0x24050000UL)
+#define BOOT_IMAGE_AXI_SIZE         (0x00021C00UL)
+
+/* Ӧóͷ壨СˣͷCRCheader_crc֮ǰȫԱ */
+typedef struct {
+    uint32_t magic;             /* ʶ */
+    uint16_t header_version;    /* ͷ汾 */
+    uint16_t header_size;       /* ͷռÿռ */
+    uint32_t image_version;     /* Ӧó汾 */
+    uint32_t image_size;        /* Ӧó򳤶ȣͷ */
+    uint32_t load_address;      /* Ӧóַ */
+    uint32_t entry_address;     /* ڵַλ */
+    uint32_t flags;             /* ־ */
+    uint32_t crc32;             /* ӦóCRC32zlibͬ */
+    uint8_t sha256[32];         /* ӦóSHA-256 */
+    uint32_t section_table;     /* αƫƣӦóʼ4ֽڶ룬BOOT_IMAGE_FLAG_SECTIONSʱЧ */
+    uint32_t reserved[6];       /* 0 */
+    uint32_t header_crc;        /* ͷCRC32 */
+} boot_image_header_t;
+
+/* αͷ壨count */
+typedef struct {
+    uint32_t magic;             /* BOOT_IMAGE_SECTION_MAGIC */
+    uint32_t count;             /* BOOT_IMAGE_SECTION_MAX */
+} boot_image_section_table_t;
+
+/*  */
+typedef struct {
+    uint32_t address;           /* ĿĵַCPUַ */
+    uint32_t size;              /* ѹ󳤶 */
+    uint32_t offset;            /* ƫƣӦóʼ */
+    uint32_t packed_size;       /* ݳ */
+    uint32_t method;            /* 洢ʽ */
+    uint32_t crc32;             /* ѹCRC32 */
+} boot_image_section_t;
+
+/* һξУ鱨涨 */
+typedef struct {
+    uint8_t header_ok;          /* ͷЧ */
+    uint8_t cached;             /* У黺棬δ */
+    uint8_t crc_ok;             /* CRC32һ */
+    uint8_t sha256_ok;          /* SHA-256һ£δҪʱΪ1 */
+    uint32_t image_size;        /* Ӧó򳤶 */
+    uint32_t elapsed;           /* Уʱms */
+    uint32_t section_count;     /* ѽѹ */
+    uint32_t section_size;      /* ѽѹܳ */
+    uint32_t section_packed;    /* ѶȡĶܳ */
+    uint32_t section_elapsed;   /* ѹʱms */
+} boot_image_report_t;
+
+/*  */
+uint8_t boot_image_check(uint32_t address, boot_image_header_t *header);           /* УNOR FlashеӦó */
+uint8_t boot_image_invalidate(uint32_t address);                                    /* Уǣд¾ǰã */
+uint8_t boot_image_load_sections(uint32_t address, const boot_image_header_t *header);     /* ѹеĶεRAMתǰã */
+void boot_image_get_report(boot_image_report_t *report);                            /* ȡһξУ鱨 */
+uint8_t boot_image_crc32_calculate(const uint8_t *data, uint32_t length, uint32_t *crc);   /* CRCCRC32 */
+
+#endif /* __BOOT_IMAGE_H */
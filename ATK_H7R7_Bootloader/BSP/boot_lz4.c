@@ -0,0 +1,143 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_lz4.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       LZ4ʽѹ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ÿΪƣ4λȣ4λƥ䳤-4ֵ15ʱֽڼۼ255
+ * 2ֽСƥ롢ƥ䳤չһֻ
+ * гʹǰ飬𻵵벻Խдֻʧ
+ *
+ ****************************************************************************************************
+ */
+
+#include "boot_lz4.h"
+#include <string.h>
+
+/**
+ * @brief   ȡչ
+ * @param   ip: ָ룬ʱָչ֮
+ * @param   iend: 
+ * @param   length: ȣۼӣ
+ * @retval  ȡ
+ * @arg     0: ȡɹ
+ * @arg     1: ǰ
+ */
+static uint8_t boot_lz4_length(const uint8_t **ip, const uint8_t *iend, uint32_t *length)
+{
+    const uint8_t *p = *ip;
+    uint8_t byte;
+    
+    do
+    {
+        if (p >= iend)
+        {
+            return 1;
+        }
+        byte = *p++;
+        *length += byte;
+    } while (byte == 255);
+    
+    *ip = p;
+    
+    return 0;
+}
+
+/**
+ * @brief   ѹLZ4
+ * @note    ƥmemcpyƣƥСڳȣظģʽʱȷִθ
+ * @param   src: ѹݣΪڴӳNOR Flash
+ * @param   src_size: ѹݳ
+ * @param   dst: 
+ * @param   dst_size: 
+ * @param   out_size: ѹ󳤶
+ * @retval  ѹ
+ * @arg     0: ѹɹ
+ * @arg     1: 𻵻
+ */
+uint8_t boot_lz4_decompress(const uint8_t *src, uint32_t src_size, uint8_t *dst, uint32_t dst_size, uint32_t *out_size)
+{
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + src_size;
+    const uint8_t *match;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dst_size;
+    uint32_t length;
+    uint32_t offset;
+    uint8_t token;
+    
+    while (ip < iend)
+    {
+        token = *ip++;
+        
+        /*  */
+        length = token >> 4;
+        if ((length == 15) && (boot_lz4_length(&ip, iend, &length) != 0))
+        {
+            return 1;
+        }
+        if ((length > (uint32_t)(iend - ip)) || (length > (uint32_t)(oend - op)))
+        {
+            return 1;
+        }
+        memcpy(op, ip, length);
+        ip += length;
+        op += length;
+        
+        /* һûƥ */
+        if (ip == iend)
+        {
+            break;
+        }
+        
+        /* ƥ */
+        if ((iend - ip) < 2)
+        {
+            return 1;
+        }
+        offset = (uint32_t)ip[0] | ((uint32_t)ip[1] << 8);
+        ip += 2;
+        if ((offset == 0) || (offset > (uint32_t)(op - dst)))
+        {
+            return 1;
+        }
+        
+        length = token & 0x0F;
+        if ((length == 15) && (boot_lz4_length(&ip, iend, &length) != 0))
+        {
+            return 1;
+        }
+        length += BOOT_LZ4_MIN_MATCH;
+        if (length > (uint32_t)(oend - op))
+        {
+            return 1;
+        }
+        
+        match = op - offset;
+        if (offset >= length)
+        {
+            memcpy(op, match, length);
+            op += length;
+        }
+        else
+        {
+            /* ظģʽչĲƥΪڣÿθȫչȣɱ */
+            while (length > offset)
+            {
+                memcpy(op, match, offset);
+                op += offset;
+                length -= offset;
+                offset += offset;
+            }
+            memcpy(op, match, length);
+            op += length;
+        }
+    }
+    
+    *out_size = (uint32_t)(op - dst);
+    
+    return 0;
+}
@@ -0,0 +1,34 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_lz4.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       LZ4ʽѹ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ѹLZ4ʽlz4LZ4_compress_default()/LZ4_compress_HC()ͬ֡ͷ
+ * BootloaderתǰѾеѹνѹRAMboot_image.h
+ * ļֻʹ<stdint.h>Tools/image_packerֱӱ룬ʹͬһѹ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __BOOT_LZ4_H
+#define __BOOT_LZ4_H
+
+#include <stdint.h>
+
+/* LZ4ʽ壨ѹأѹ˲ */
+#define BOOT_LZ4_MIN_MATCH          (4)     /* ƥ䳤 */
+#define BOOT_LZ4_LAST_LITERALS      (5)     /* ĩβ5ֽΪ */
+#define BOOT_LZ4_MF_LIMIT           (12)    /* һƥڿĩβ12ֽ֮ǰʼ */
+#define BOOT_LZ4_MAX_OFFSET         (65535) /* ƥ */
+
+/* ѹ󳤶ȣѹݣ */
+#define BOOT_LZ4_BOUND(size)        ((size) + ((size) / 255) + 16)
+
+/*  */
+uint8_t boot_lz4_decompress(const uint8_t *src, uint32_t src_size, uint8_t *dst, uint32_t dst_size, uint32_t *out_size);  /* ѹLZ4 */
+
+#endif /* __BOOT_LZ4_H */
@@ -0,0 +1,594 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_slot.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       A/B˫Ӧóѡ´
+ ****************************************************************************************************
+ * @attention
+ *
+ * Ƽ¼ֻ״̬仯ʱдֵ洢װ¾ÿСȷϡع
+ * ȷϲʱдNOR Flashֵ¼׷д룬ʱһ¼
+ * ǰȿۼת¾ȷǰλͬĴ
+ * ڼĿ۰̨/ָд밴ҳ̣ÿεֻ˳ڴӳ
+ *
+ ****************************************************************************************************
+ */
+
+#include "boot_slot.h"
+#include "norflash_kv.h"
+#include <string.h>
+
+/* Ƽ¼ʶ */
+#define BOOT_SLOT_CTRL_MAGIC        (0x4C544342UL)  /* "BCTL" */
+#define BOOT_SLOT_CTRL_KEY          "boot.ctrl"
+
+/* Ӧó۸״̬ */
+#define BOOT_SLOT_UPDATE_IDLE       (0)
+#define BOOT_SLOT_UPDATE_ERASE      (1)
+#define BOOT_SLOT_UPDATE_WRITE      (2)
+
+/* Ӧó۸״̬ */
+static struct {
+    uint8_t state;          /* ״̬ */
+    uint8_t slot;           /* Ŀ */
+    uint32_t length;        /* ܳ */
+    uint32_t written;       /* д볤 */
+} boot_slot_update = {BOOT_SLOT_UPDATE_IDLE, BOOT_SLOT_NONE, 0, 0};
+
+/**
+ * @brief   ȡƼ¼
+ * @note    ¼ڻЧʱֻװ˲A
+ * @param   ctrl: Ƽ¼
+ * @retval  
+ */
+static void boot_slot_ctrl_load(boot_slot_ctrl_t *ctrl)
+{
+    uint16_t length;
+    
+    if ((norflash_kv_get(BOOT_SLOT_CTRL_KEY, (uint8_t *)ctrl, sizeof(boot_slot_ctrl_t), &length) == 0) && (length == sizeof(boot_slot_ctrl_t)) &&
+        (ctrl->magic == BOOT_SLOT_CTRL_MAGIC) && (ctrl->active < BOOT_SLOT_NUM) && (ctrl->booted < BOOT_SLOT_NUM) &&
+        ((ctrl->pending < BOOT_SLOT_NUM) || (ctrl->pending == BOOT_SLOT_NONE)))
+    {
+        return;
+    }
+    
+    memset(ctrl, 0, sizeof(boot_slot_ctrl_t));
+    ctrl->magic = BOOT_SLOT_CTRL_MAGIC;
+    ctrl->active = BOOT_SLOT_A;
+    ctrl->pending = BOOT_SLOT_NONE;
+    ctrl->booted = BOOT_SLOT_A;
+    ctrl->confirmed = 1;
+}
+
+/**
+ * @brief   Ƽ¼
+ * @param   ctrl: Ƽ¼
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t boot_slot_ctrl_save(boot_slot_ctrl_t *ctrl)
+{
+    return norflash_kv_set(BOOT_SLOT_CTRL_KEY, (uint8_t *)ctrl, sizeof(boot_slot_ctrl_t));
+}
+
+/**
+ * @brief   УӦóеľ
+ * @param   slot: Ӧó
+ * @param   header: ľͷ
+ * @retval  У
+ * @arg     0: Ч
+ * @arg     1: Ч
+ */
+static uint8_t boot_slot_check(uint8_t slot, boot_image_header_t *header)
+{
+    if (boot_image_check(BOOT_SLOT_ADDRESS(slot), header) != 0)
+    {
+        return 1;
+    }
+    
+    /* Խ۱߽ */
+    if (header->image_size > (BOOT_SLOT_SIZE - BOOT_IMAGE_HEADER_SIZE))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ˳ڴӳ䲢¼ԭ״̬
+ * @note    ԭڴӳģʽʱͬʱжϣжϷӳ䴰Уboot_slot_remap()ָ
+ * @param   mapped: ԭڴӳж״̬
+ * @retval  ˳
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t boot_slot_unmap(uint32_t *mapped)
+{
+    return norflash_memory_mapped_suspend(mapped);
+}
+
+/**
+ * @brief   ָڴӳ
+ * @param   mapped: boot_slot_unmap()¼״̬
+ * @retval  ָ
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t boot_slot_remap(uint32_t mapped)
+{
+    return norflash_memory_mapped_resume(mapped);
+}
+
+/**
+ * @brief   ȡÿɸµķв
+ * @note    ò۵Ĵ״̬УǣǰδȷʱʧܣдعĿ
+ *          ǰ˳ڴӳ
+ * @param   slot: Ŀ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t boot_slot_prepare(uint8_t *slot)
+{
+    boot_slot_ctrl_t ctrl;
+    
+    boot_slot_ctrl_load(&ctrl);
+    if (ctrl.confirmed == 0)
+    {
+        return 1;
+    }
+    
+    *slot = ctrl.booted ^ 1;
+    if (ctrl.pending == *slot)
+    {
+        ctrl.pending = BOOT_SLOT_NONE;
+        ctrl.trials = 0;
+        if (boot_slot_ctrl_save(&ctrl) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return boot_image_invalidate(BOOT_SLOT_ADDRESS(*slot));
+}
+
+/**
+ * @brief   Уе¾Ϊв
+ * @note    УCRC32/SHA-256¼Уǣ´ֱʹã
+ *          ӵַĿ۲ʱУʧܣǰ˳ڴӳ
+ * @param   slot: Ŀ
+ * @param   length: д볤ȣЧCache
+ * @param   trials: д0: ʹBOOT_SLOT_TRIALS
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t boot_slot_install(uint8_t slot, uint32_t length, uint8_t trials)
+{
+    boot_image_header_t header;
+    boot_slot_ctrl_t ctrl;
+    
+    /* Ŀ۴ǰܾӳ䴰ڶCacheеľݺУ */
+    SCB_InvalidateDCache_by_Addr((volatile void *)(NORFLASH_MEMORY_MAPPED_BASE + BOOT_SLOT_ADDRESS(slot)), (int32_t)length);
+    
+    if (boot_slot_check(slot, &header) != 0)
+    {
+        return 1;
+    }
+    
+    boot_slot_ctrl_load(&ctrl);
+    if ((ctrl.confirmed == 0) || (ctrl.booted == slot))
+    {
+        return 1;
+    }
+    
+    ctrl.pending = slot;
+    ctrl.trials = (trials != 0) ? trials : BOOT_SLOT_TRIALS;
+    
+    return boot_slot_ctrl_save(&ctrl);
+}
+
+/**
+ * @brief   ѡ۲У龵
+ * @note    двҴδʱۼòۣȷϲۣ
+ *          ȷϲҲЧʱһЧ۲Ϊȷϲ
+ *          ǰѹؼֵ洢NOR Flashڴӳģʽ
+ * @param   slot: ѡеĲ
+ * @param   header: ѡв۵ľͷ
+ * @retval  ѡ
+ * @arg     0: ѡЧ
+ * @arg     1: ۾Ч
+ */
+uint8_t boot_slot_select(uint8_t *slot, boot_image_header_t *header)
+{
+    boot_slot_ctrl_t ctrl;
+    uint8_t changed = 0;
+    uint8_t index;
+    uint8_t select;
+    
+    boot_slot_ctrl_load(&ctrl);
+    
+    if (ctrl.pending != BOOT_SLOT_NONE)
+    {
+        if (ctrl.trials != 0)
+        {
+            ctrl.trials--;
+            ctrl.booted = ctrl.pending;
+            ctrl.confirmed = 0;
+            if ((boot_slot_ctrl_save(&ctrl) == 0) && (boot_slot_check(ctrl.pending, header) == 0))
+            {
+                *slot = ctrl.pending;
+                return 0;
+            }
+        }
+        
+        /* д¾Чعȷϲ */
+        ctrl.pending = BOOT_SLOT_NONE;
+        ctrl.trials = 0;
+        ctrl.rollbacks++;
+        changed = 1;
+    }
+    
+    for (index = 0; index < BOOT_SLOT_NUM; index++)
+    {
+        select = (index == 0) ? ctrl.active : (ctrl.active ^ 1);
+        if (boot_slot_check(select, header) != 0)
+        {
+            continue;
+        }
+        
+        if ((ctrl.active != select) || (ctrl.booted != select) || (ctrl.confirmed == 0))
+        {
+            ctrl.active = select;
+            ctrl.booted = select;
+            ctrl.confirmed = 1;
+            changed = 1;
+        }
+        
+        /* ¼ʧܲӰ챾 */
+        if (changed != 0)
+        {
+            boot_slot_ctrl_save(&ctrl);
+        }
+        
+        *slot = select;
+        return 0;
+    }
+    
+    if (changed != 0)
+    {
+        boot_slot_ctrl_save(&ctrl);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   ȡƼ¼
+ * @param   ctrl: Ƽ¼
+ * @retval  ȡ
+ * @arg     0: ȡɹ
+ * @arg     1: ȡʧ
+ */
+uint8_t boot_slot_get_ctrl(boot_slot_ctrl_t *ctrl)
+{
+    uint32_t mapped;
+    
+    if (boot_slot_unmap(&mapped) != 0)
+    {
+        return 1;
+    }
+    
+    boot_slot_ctrl_load(ctrl);
+    
+    return boot_slot_remap(mapped);
+}
+
+/**
+ * @brief   ȷϵǰв
+ * @note    ӦóԼͨã֮ò۳Ϊȷϲۣǰȷʱֱӷسɹ
+ * @param   
+ * @retval  ȷϽ
+ * @arg     0: ȷϳɹ
+ * @arg     1: ȷʧ
+ */
+uint8_t boot_slot_confirm(void)
+{
+    boot_slot_ctrl_t ctrl;
+    uint32_t mapped;
+    uint8_t res = 0;
+    
+    if (boot_slot_unmap(&mapped) != 0)
+    {
+        return 1;
+    }
+    
+    boot_slot_ctrl_load(&ctrl);
+    if (ctrl.confirmed == 0)
+    {
+        if (ctrl.pending == ctrl.booted)
+        {
+            ctrl.active = ctrl.booted;
+            ctrl.pending = BOOT_SLOT_NONE;
+            ctrl.trials = 0;
+            ctrl.confirmed = 1;
+            res = boot_slot_ctrl_save(&ctrl);
+        }
+        else
+        {
+            res = 1;
+        }
+    }
+    
+    res |= boot_slot_remap(mapped);
+    
+    return res;
+}
+
+/**
+ * @brief   ʼ·в
+ * @note    Ŀ۵Ĵ״̬УǣԾռ̨
+ *          ǰδȷʱܾ£дعĿ
+ * @param   length: ܳȣͷ
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: ʼʧ
+ */
+uint8_t boot_slot_update_begin(uint32_t length)
+{
+    uint32_t mapped;
+    uint8_t slot;
+    uint8_t res;
+    
+    if ((length <= BOOT_IMAGE_HEADER_SIZE) || (length > BOOT_SLOT_SIZE))
+    {
+        return 1;
+    }
+    
+    if (norflash_erase_background_busy() != 0)
+    {
+        return 1;
+    }
+    
+    boot_slot_update.state = BOOT_SLOT_UPDATE_IDLE;
+    
+    if (boot_slot_unmap(&mapped) != 0)
+    {
+        return 1;
+    }
+    
+    res = boot_slot_prepare(&slot);
+    if (res == 0)
+    {
+        res = norflash_erase_background(BOOT_SLOT_ADDRESS(slot), length);
+    }
+    
+    res |= boot_slot_remap(mapped);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    boot_slot_update.slot = slot;
+    boot_slot_update.length = length;
+    boot_slot_update.written = 0;
+    boot_slot_update.state = BOOT_SLOT_UPDATE_ERASE;
+    
+    return 0;
+}
+
+/**
+ * @brief   ִһ²ʱƬ
+ * @note    ɺд룻ʱƬڼ˳ڴӳ䲢жϣǰָ
+ *          ʱƬNORFLASH_ERASE_BG_MAX_SLICEڴӳеĳITCMڲRAM
+ * @param   budget: ʱƬȣλms
+ * @retval  ִн
+ * @arg     0: ִгɹ
+ * @arg     1: ִʧܣֹ
+ */
+uint8_t boot_slot_update_run(uint32_t budget)
+{
+    if (boot_slot_update.state != BOOT_SLOT_UPDATE_ERASE)
+    {
+        return 0;
+    }
+    
+    if (norflash_erase_background_run(budget) != 0)
+    {
+        boot_slot_update.state = BOOT_SLOT_UPDATE_IDLE;
+        return 1;
+    }
+    
+    if (norflash_erase_background_busy() == 0)
+    {
+        boot_slot_update.state = BOOT_SLOT_UPDATE_WRITE;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ˳д뾵
+ * @note    ҳ̣ڼ˳ڴӳ䣬ǰָÿдĳȾӳ䴰ڲõʱ䣬
+ *          ΪһҳҳһⳤΪż
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  д
+ * @arg     0: дɹ
+ * @arg     1: дʧܣֹ
+ */
+uint8_t boot_slot_update_write(const uint8_t *data, uint32_t length)
+{
+    uint32_t address;
+    uint32_t page_size;
+    uint32_t chunk;
+    uint8_t tail[2];
+    uint32_t mapped;
+    uint8_t res = 0;
+    
+    if (boot_slot_update.state != BOOT_SLOT_UPDATE_WRITE)
+    {
+        return 1;
+    }
+    
+    if ((length == 0) || (length > (boot_slot_update.length - boot_slot_update.written)))
+    {
+        return 1;
+    }
+    
+    if (((length & 1) != 0) && ((boot_slot_update.written + length) != boot_slot_update.length))
+    {
+        return 1;
+    }
+    
+    if (boot_slot_unmap(&mapped) != 0)
+    {
+        return 1;
+    }
+    
+    page_size = norflash_get_page_size();
+    address = BOOT_SLOT_ADDRESS(boot_slot_update.slot) + boot_slot_update.written;
+    boot_slot_update.written += length;
+    
+    /* ҳ̣һֽڲ0xFF */
+    while ((length > 1) && (res == 0))
+    {
+        chunk = page_size - (address % page_size);
+        if (chunk > (length & ~1UL))
+        {
+            chunk = length & ~1UL;
+        }
+        
+        res = norflash_program_page(address, (uint8_t *)data, chunk);
+        address += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+    if ((length != 0) && (res == 0))
+    {
+        tail[0] = data[0];
+        tail[1] = 0xFF;
+        res = norflash_program_page(address, tail, sizeof(tail));
+    }
+    
+    res |= boot_slot_remap(mapped);
+    if (res != 0)
+    {
+        boot_slot_update.state = BOOT_SLOT_UPDATE_IDLE;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief   У¾Ϊв
+ * @note    УCRC32/SHA-256¼Уǣ´ֱʹã
+ *          ӵַĿ۲ʱУʧ
+ * @param   trials: д0: ʹBOOT_SLOT_TRIALS
+ * @retval  
+ * @arg     0: ɹλ¾
+ * @arg     1: ʧ
+ */
+uint8_t boot_slot_update_finish(uint8_t trials)
+{
+    uint32_t mapped;
+    uint8_t res;
+    
+    if ((boot_slot_update.state != BOOT_SLOT_UPDATE_WRITE) || (boot_slot_update.written != boot_slot_update.length))
+    {
+        return 1;
+    }
+    
+    boot_slot_update.state = BOOT_SLOT_UPDATE_IDLE;
+    
+    if (boot_slot_unmap(&mapped) != 0)
+    {
+        return 1;
+    }
+    
+    res = boot_slot_install(boot_slot_update.slot, boot_slot_update.length, trials);
+    res |= boot_slot_remap(mapped);
+    
+    return res;
+}
+
+/**
+ * @brief   ȡ½
+ * @param   progress: ½
+ * @retval  
+ */
+void boot_slot_update_get_progress(boot_slot_progress_t *progress)
+{
+    norflash_erase_progress_t erase;
+    
+    norflash_erase_background_get_progress(&erase);
+    
+    progress->slot = boot_slot_update.slot;
+    progress->erasing = (boot_slot_update.state == BOOT_SLOT_UPDATE_ERASE) ? 1 : 0;
+    progress->writing = (boot_slot_update.state == BOOT_SLOT_UPDATE_WRITE) ? 1 : 0;
+    progress->length = boot_slot_update.length;
+    progress->erased = (boot_slot_update.state == BOOT_SLOT_UPDATE_ERASE) ? erase.done : boot_slot_update.length;
+    progress->written = boot_slot_update.written;
+}
+
+/**
+ * @brief   ȡÿɸµķв
+ * @note    ò۵Ĵ״̬Уǣ֮ɵд루£
+ *          дboot_slot_update_install()ǰδȷʱʧ
+ * @param   slot: Ŀ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t boot_slot_update_target(uint8_t *slot)
+{
+    uint32_t mapped;
+    uint8_t res;
+    
+    if (boot_slot_update.state != BOOT_SLOT_UPDATE_IDLE)
+    {
+        return 1;
+    }
+    
+    if (boot_slot_unmap(&mapped) != 0)
+    {
+        return 1;
+    }
+    
+    res = boot_slot_prepare(slot);
+    res |= boot_slot_remap(mapped);
+    
+    return res;
+}
+
+/**
+ * @brief   Уе¾Ϊв
+ * @param   slot: boot_slot_update_target()ȡõĿ
+ * @param   trials: д0: ʹBOOT_SLOT_TRIALS
+ * @retval  
+ * @arg     0: ɹλ¾
+ * @arg     1: ʧ
+ */
+uint8_t boot_slot_update_install(uint8_t slot, uint8_t trials)
+{
+    uint32_t mapped;
+    uint8_t res;
+    
+    if (slot >= BOOT_SLOT_NUM)
+    {
+        return 1;
+    }
+    
+    if (boot_slot_unmap(&mapped) != 0)
+    {
+        return 1;
+    }
+    
+    res = boot_slot_install(slot, BOOT_SLOT_SIZE, trials);
+    res |= boot_slot_remap(mapped);
+    
+    return res;
+}
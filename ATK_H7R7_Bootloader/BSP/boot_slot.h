@@ -0,0 +1,81 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_slot.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       A/B˫Ӧóѡ´
+ ****************************************************************************************************
+ * @attention
+ *
+ * NOR Flash: 0~8MBΪA8~16MBΪļϵͳnorflash_fs.h16~24MBΪB24MB
+ * ĩβΪֵ洢Уͼ
+ * Ƽ¼ȷϲۡвʣдȷϱ־ڼֵ洢У
+ * Bootloaderboot_slot_select()ѡۣдδȷعȷϲۣ
+ * Ӧóboot_slot_update_xxx()¾ʽдвۣboot_slot_confirm()
+ * ʽдĿʱboot_delta.h£ȵboot_slot_update_target()дboot_slot_update_install()
+ * ÿ۵ľ밴۵ַӣTools/image_packer -bMDK-ARM/Appli¶Ӧ.sctļ
+ * ڴӳеӦóøºʱģ顢У顢ֵ洢NOR Flash
+ * HAL XSPI/CRC/HASHõĿ⺯memcpy/memset/memcmp/strlenλITCMڲRAM.sctļER_ITCM
+ * ˳ӳڼжϣnorflash_memory_mapped_suspend()ǰָڴӳжϣ
+ * жӳΪһεõʱд밴óȣװʱУ飩
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __BOOT_SLOT_H
+#define __BOOT_SLOT_H
+
+#include "boot_image.h"
+
+/* Ӧó۶ */
+#define BOOT_SLOT_A                 (0)
+#define BOOT_SLOT_B                 (1)
+#define BOOT_SLOT_NUM               (2)
+#define BOOT_SLOT_NONE              (0xFF)
+
+/* Ӧó۵ַС壨NOR Flashƫƣ */
+#define BOOT_SLOT_A_ADDRESS         (0x00000000UL)
+#define BOOT_SLOT_B_ADDRESS         (0x01000000UL)
+#define BOOT_SLOT_SIZE              (0x00800000UL)
+#define BOOT_SLOT_ADDRESS(slot)     (((slot) == BOOT_SLOT_B) ? BOOT_SLOT_B_ADDRESS : BOOT_SLOT_A_ADDRESS)
+
+/* Ĭд */
+#define BOOT_SLOT_TRIALS            (3)
+
+/* Ƽ¼壨ڼֵ洢УΪ"boot.ctrl" */
+typedef struct {
+    uint32_t magic;         /* ʶ */
+    uint8_t active;         /* ȷϲ */
+    uint8_t pending;        /* вۣBOOT_SLOT_NONE: ޣ */
+    uint8_t trials;         /* вʣд */
+    uint8_t booted;         /* һĲ */
+    uint8_t confirmed;      /* һĲȷ */
+    uint8_t reserved[3];    /* д0 */
+    uint32_t rollbacks;     /* ع */
+} boot_slot_ctrl_t;
+
+/* Ӧó۸½ȶ */
+typedef struct {
+    uint8_t slot;           /* Ŀ */
+    uint8_t erasing;        /*  */
+    uint8_t writing;        /* д */
+    uint32_t length;        /* ܳȣͷ */
+    uint32_t erased;        /* Ѳ */
+    uint32_t written;       /* д볤 */
+} boot_slot_progress_t;
+
+/* Bootloaderʹã */
+uint8_t boot_slot_select(uint8_t *slot, boot_image_header_t *header);                /* ѡ۲У龵 */
+
+/* Ӧóʹã */
+uint8_t boot_slot_get_ctrl(boot_slot_ctrl_t *ctrl);                                 /* ȡƼ¼ */
+uint8_t boot_slot_confirm(void);                                                    /* ȷϵǰв */
+uint8_t boot_slot_update_begin(uint32_t length);                                    /* ʼ·в̨ۣ */
+uint8_t boot_slot_update_run(uint32_t budget);                                      /* ִһ²ʱƬ */
+uint8_t boot_slot_update_write(const uint8_t *data, uint32_t length);               /* ˳д뾵 */
+uint8_t boot_slot_update_finish(uint8_t trials);                                    /* У¾Ϊв */
+void boot_slot_update_get_progress(boot_slot_progress_t *progress);                 /* ȡ½ */
+uint8_t boot_slot_update_target(uint8_t *slot);                                     /* ȡÿɸµķвۣɵд룩 */
+uint8_t boot_slot_update_install(uint8_t slot, uint8_t trials);                     /* Уе¾Ϊв */
+
+#endif /* __BOOT_SLOT_H */
@@ -0,0 +1,142 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_trace.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ʱ߸ٴ
+ ****************************************************************************************************
+ * @attention
+ *
+ * λڱSRAMĹ̶ַɢأBootloaderӦó붼㣻
+ * ǰ򿪱дBKPSRAMʱӣ̸start/attachд
+ * дһ¼Լʮڣжд8ֽڣD-CacheʱһCacheУ
+ *
+ ****************************************************************************************************
+ */
+
+#include "boot_trace.h"
+#include "main.h"
+
+#if BOOT_TRACE_ENABLE
+
+#define BOOT_TRACE_BUFFER           ((boot_trace_buffer_t *)BOOT_TRACE_BASE)
+
+static uint8_t g_boot_trace_ready = 0;     /* Ѵ򿪻 */
+
+/**
+ * @brief   򿪱SRAMDWTڼ
+ * @param   
+ * @retval  
+ */
+static void boot_trace_enable(void)
+{
+    SET_BIT(PWR->CR1, PWR_CR1_DBP);
+    __HAL_RCC_BKPRAM_CLK_ENABLE();
+    
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief   D-CacheʱѻдرSRAMֱӶSRAM
+ * @param   addr: ַ
+ * @param   size: С
+ * @retval  
+ */
+static void boot_trace_clean(volatile void *addr, int32_t size)
+{
+    if ((SCB->CCR & SCB_CCR_DC_Msk) != 0)
+    {
+        SCB_CleanDCache_by_Addr(addr, size);
+    }
+}
+
+/**
+ * @brief   ½ٻ
+ * @note    Bootloader mainڵãCYCCNT㣬ջ¼BOOT_TRACE_ID_MAIN
+ * @param   
+ * @retval  
+ */
+void boot_trace_start(void)
+{
+    boot_trace_buffer_t *buffer = BOOT_TRACE_BUFFER;
+    uint32_t boots;
+    
+    boot_trace_enable();
+    DWT->CYCCNT = 0;
+    
+    /* SRAMڸλ󱣳֣ϵ */
+    boots = ((buffer->magic == BOOT_TRACE_MAGIC) && (buffer->version == BOOT_TRACE_VERSION)) ? (buffer->boots + 1) : 1;
+    
+    buffer->magic = BOOT_TRACE_MAGIC;
+    buffer->version = BOOT_TRACE_VERSION;
+    buffer->capacity = BOOT_TRACE_CAPACITY;
+    buffer->count = 0;
+    buffer->boots = boots;
+    boot_trace_clean(buffer, BOOT_TRACE_HEADER_SIZE);
+    g_boot_trace_ready = 1;
+    
+    boot_trace_record(BOOT_TRACE_ID_MAIN | BOOT_TRACE_FLAG_MARK);
+}
+
+/**
+ * @brief   ٻ
+ * @note    ӦómainڵãCYCCNT㣬Bootloaderļ¼֮󣬼¼BOOT_TRACE_ID_APP_MAIN
+ *          ЧδBootloaderʱ½
+ * @param   
+ * @retval  
+ */
+void boot_trace_attach(void)
+{
+    boot_trace_buffer_t *buffer = BOOT_TRACE_BUFFER;
+    
+    boot_trace_enable();
+    
+    if ((buffer->magic != BOOT_TRACE_MAGIC) || (buffer->version != BOOT_TRACE_VERSION) || (buffer->capacity != BOOT_TRACE_CAPACITY))
+    {
+        buffer->magic = BOOT_TRACE_MAGIC;
+        buffer->version = BOOT_TRACE_VERSION;
+        buffer->capacity = BOOT_TRACE_CAPACITY;
+        buffer->count = 0;
+        buffer->boots = 1;
+        boot_trace_clean(buffer, BOOT_TRACE_HEADER_SIZE);
+    }
+    g_boot_trace_ready = 1;
+    
+    boot_trace_record(BOOT_TRACE_ID_APP_MAIN | BOOT_TRACE_FLAG_MARK);
+}
+
+/**
+ * @brief   дһټ¼
+ * @note    жеãδboot_trace_start()/boot_trace_attach()ʱ
+ * @param   id: ¼|׶ID
+ * @retval  
+ */
+void boot_trace_record(uint16_t id)
+{
+    boot_trace_buffer_t *buffer = BOOT_TRACE_BUFFER;
+    boot_trace_record_t *record;
+    uint32_t primask;
+    
+    if (g_boot_trace_ready == 0)
+    {
+        return;
+    }
+    
+    primask = __get_PRIMASK();
+    __disable_irq();
+    
+    record = &buffer->record[buffer->count % BOOT_TRACE_CAPACITY];
+    record->cycles = DWT->CYCCNT;
+    record->id = id;
+    record->mhz = (uint16_t)(SystemCoreClock / 1000000UL);
+    buffer->count++;
+    
+    __set_PRIMASK(primask);
+    
+    boot_trace_clean(record, sizeof(boot_trace_record_t));
+    boot_trace_clean(&buffer->count, sizeof(buffer->count));
+}
+
+#endif /* BOOT_TRACE_ENABLE */
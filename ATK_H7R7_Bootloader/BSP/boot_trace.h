@@ -0,0 +1,111 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_trace.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ʱ߸ٴ
+ ****************************************************************************************************
+ * @attention
+ *
+ * DWT->CYCCNTCPUʱڣΪʱѸ׶εĿʼ/¼SRAMеĻλ
+ * BootloadermainCYCCNT½תӦó¼
+ * һǴBootloader mainӦó
+ * ÿ¼ͬʱ浱ʱSystemCoreClockMHzTools/boot_trace/boot_trace_decodeΪʱ
+ * BOOT_TRACE_ENABLEΪ0ʱȫBOOT_TRACE_xxxչΪգռҲռʱ
+ *
+ * ȡKeilʱCommandִ SAVE trace.hex 0x38800800,0x38800FFF
+ *       ִ boot_trace_decode trace.hex
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __BOOT_TRACE_H
+#define __BOOT_TRACE_H
+
+#include <stdint.h>
+
+/* ٿأڹԤmain.hиΪ0 */
+#ifndef BOOT_TRACE_ENABLE
+#define BOOT_TRACE_ENABLE           (1)
+#endif
+
+/* λ壨SRAM2KBǰ2KBΪBootloaderӿ飬οboot_handoff.h */
+#define BOOT_TRACE_BASE             (0x38800800UL)
+#define BOOT_TRACE_SIZE             (0x00000800UL)
+#define BOOT_TRACE_MAGIC            (0x45435254UL)  /* "TRCE" */
+#define BOOT_TRACE_VERSION          (1)
+#define BOOT_TRACE_HEADER_SIZE      (16)
+#define BOOT_TRACE_CAPACITY         ((BOOT_TRACE_SIZE - BOOT_TRACE_HEADER_SIZE) / 8)
+
+/* ¼Ͷ壨IDĸ2λ */
+#define BOOT_TRACE_FLAG_BEGIN       (0x0000)    /* ׶οʼ */
+#define BOOT_TRACE_FLAG_MARK        (0x4000)    /* ʱ */
+#define BOOT_TRACE_FLAG_END         (0x8000)    /* ׶ν */
+#define BOOT_TRACE_FLAG_MASK        (0xC000)
+#define BOOT_TRACE_ID_MASK          (0x3FFF)
+
+/* Bootloader׶ID */
+#define BOOT_TRACE_ID_MAIN                  (0x0001)    /* mainڣCYCCNT㣩 */
+#define BOOT_TRACE_ID_MPU_CONFIG            (0x0002)    /* MPU_Config() */
+#define BOOT_TRACE_ID_HAL_INIT              (0x0003)    /* HAL_Init() */
+#define BOOT_TRACE_ID_CLOCK_CONFIG          (0x0004)    /* SystemClock_Config() */
+#define BOOT_TRACE_ID_PERIPH_INIT           (0x0005)    /* GPIOUSARTʼ */
+#define BOOT_TRACE_ID_NORFLASH_INIT         (0x0006)    /* norflash_init() */
+#define BOOT_TRACE_ID_NORFLASH_XSPI_INIT    (0x0007)    /* XSPI1ʼ */
+#define BOOT_TRACE_ID_NORFLASH_DEVICE_INIT  (0x0008)    /* NOR Flash豸ʼ */
+#define BOOT_TRACE_ID_NORFLASH_RESET        (0x0009)    /* NOR Flashλ1msȴ */
+#define BOOT_TRACE_ID_NORFLASH_TEST         (0x000A)    /* NOR Flashд */
+#define BOOT_TRACE_ID_KV_MOUNT              (0x000B)    /* norflash_kv_mount() */
+#define BOOT_TRACE_ID_SLOT_SELECT           (0x000C)    /* boot_slot_select()У飩 */
+#define BOOT_TRACE_ID_MEMORY_MAPPED         (0x000D)    /* norflash_memory_mapped() */
+#define BOOT_TRACE_ID_JUMP                  (0x000E)    /* תӦó */
+#define BOOT_TRACE_ID_LOAD_SECTIONS         (0x000F)    /* boot_image_load_sections()ѹεRAM */
+
+/* Ӧó׶ID */
+#define BOOT_TRACE_ID_APP_MAIN              (0x0100)    /* Ӧómain */
+#define BOOT_TRACE_ID_APP_MPU_CONFIG        (0x0101)    /* MPU_Config() */
+#define BOOT_TRACE_ID_APP_HAL_INIT          (0x0102)    /* HAL_Init() */
+#define BOOT_TRACE_ID_APP_PERIPH_INIT       (0x0103)    /* ʼ */
+#define BOOT_TRACE_ID_APP_READY             (0x0104)    /* ѭ */
+
+/* Զ׶IDʼֵ0x0200~0x3FFF */
+#define BOOT_TRACE_ID_USER                  (0x0200)
+
+/* ټ¼ */
+typedef struct {
+    uint32_t cycles;            /* DWT->CYCCNT */
+    uint16_t id;                /* ¼|׶ID */
+    uint16_t mhz;               /* ¼ʱSystemCoreClockMHz */
+} boot_trace_record_t;
+
+/* λ */
+typedef struct {
+    uint32_t magic;             /* BOOT_TRACE_MAGIC */
+    uint16_t version;           /* BOOT_TRACE_VERSION */
+    uint16_t capacity;          /* ¼BOOT_TRACE_CAPACITY */
+    uint32_t count;             /* дļ¼capacityʱļ¼ǣ */
+    uint32_t boots;             /* ϵ */
+    boot_trace_record_t record[BOOT_TRACE_CAPACITY];
+} boot_trace_buffer_t;
+
+/* ٺ궨 */
+#if BOOT_TRACE_ENABLE
+#define BOOT_TRACE_START()          boot_trace_start()
+#define BOOT_TRACE_ATTACH()         boot_trace_attach()
+#define BOOT_TRACE_BEGIN(id)        boot_trace_record((uint16_t)((id) | BOOT_TRACE_FLAG_BEGIN))
+#define BOOT_TRACE_END(id)          boot_trace_record((uint16_t)((id) | BOOT_TRACE_FLAG_END))
+#define BOOT_TRACE_MARK(id)         boot_trace_record((uint16_t)((id) | BOOT_TRACE_FLAG_MARK))
+#else
+#define BOOT_TRACE_START()          do {} while (0)
+#define BOOT_TRACE_ATTACH()         do {} while (0)
+#define BOOT_TRACE_BEGIN(id)        do {} while (0)
+#define BOOT_TRACE_END(id)          do {} while (0)
+#define BOOT_TRACE_MARK(id)         do {} while (0)
+#endif
+
+/* ͨBOOT_TRACE_xxxã */
+void boot_trace_start(void);                                                        /* ½ٻBootloader mainڣ */
+void boot_trace_attach(void);                                                       /* ٻӦómainڣ */
+void boot_trace_record(uint16_t id);                                                /* дһټ¼ */
+
+#endif /* __BOOT_TRACE_H */
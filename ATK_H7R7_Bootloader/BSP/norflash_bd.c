@@ -0,0 +1,385 @@
+/**
+ ****************************************************************************************************
+ * @file        norflash_bd.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       NOR Flash 豸
+ ****************************************************************************************************
+ * @attention
+ *
+ * ҳֻһҳһδݣ̲ҳʱȰݱ̵NOR Flash
+ * NOR Flashϵı˳˳һ£뵽żַ볤ȵֽʹNOR Flashеԭݣ
+ * ±ԭݲıѱ̵ֽ
+ *
+ ****************************************************************************************************
+ */
+
+#include "norflash_bd.h"
+#include <string.h>
+
+/* ҳбǶ */
+#define NORFLASH_BD_PAGE_NONE       (0xFFFFFFFFUL)
+
+/* NOR Flash豸 */
+static uint8_t norflash_bd_page[NORFLASH_BD_PAGE_BUFFER_SIZE];
+static uint32_t norflash_bd_page_address = NORFLASH_BD_PAGE_NONE;   /* ҳӦҳַ */
+static uint32_t norflash_bd_dirty_start = 0;                        /* ҳʼƫ */
+static uint32_t norflash_bd_dirty_end = 0;                          /* ҳڽƫ */
+static uint32_t norflash_bd_address = 0;
+static uint32_t norflash_bd_block_size = 0;
+static uint32_t norflash_bd_block_count = 0;
+static uint32_t norflash_bd_page_size = 0;
+static norflash_bd_stats_t norflash_bd_stats = {0};
+
+/**
+ * @brief   ʷΧ
+ * @param   block: 
+ * @param   offset: ƫ
+ * @param   length: 
+ * @retval  
+ * @arg     0: ΧЧ
+ * @arg     1: ΧЧ
+ */
+static uint8_t norflash_bd_range_check(uint32_t block, uint32_t offset, uint32_t length)
+{
+    uint32_t size = norflash_bd_block_count * norflash_bd_block_size;
+    
+    if ((norflash_bd_block_size == 0) || (block >= norflash_bd_block_count) || (offset > size) || (length > size))
+    {
+        return 1;
+    }
+    
+    /* ɿԽڿ */
+    if ((block * norflash_bd_block_size + offset + length) > size)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ҳеݱ̵NOR Flash
+ * @param   
+ * @retval  ̽
+ * @arg     0: ̳ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_bd_flush(void)
+{
+    uint32_t page_address = norflash_bd_page_address;
+    uint32_t start;
+    uint32_t end;
+    uint8_t edge[2];
+    
+    if (page_address == NORFLASH_BD_PAGE_NONE)
+    {
+        return 0;
+    }
+    norflash_bd_page_address = NORFLASH_BD_PAGE_NONE;
+    
+    /* 뵽żַ볤ȣֽʹԭ */
+    start = norflash_bd_dirty_start & ~1UL;
+    end = (norflash_bd_dirty_end + 1) & ~1UL;
+    if (start != norflash_bd_dirty_start)
+    {
+        if (norflash_read(page_address + start, edge, sizeof(edge)) != 0)
+        {
+            return 1;
+        }
+        norflash_bd_page[start] = edge[0];
+    }
+    if (end != norflash_bd_dirty_end)
+    {
+        if (norflash_read(page_address + end - sizeof(edge), edge, sizeof(edge)) != 0)
+        {
+            return 1;
+        }
+        norflash_bd_page[end - 1] = edge[1];
+    }
+    
+    if (norflash_program_page(page_address + start, &norflash_bd_page[start], end - start) != 0)
+    {
+        return 1;
+    }
+    norflash_bd_stats.progs++;
+    
+    return 0;
+}
+
+/**
+ * @brief   ʼ豸
+ * @note    밴룬ܰУͼڵһҳδͬݱ
+ * @param   address: NOR Flashеĵַ
+ * @param   size: С
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: ʼʧ
+ */
+uint8_t norflash_bd_init(uint32_t address, uint32_t size)
+{
+    uint32_t sector_size;
+    uint32_t page_size;
+    
+    norflash_bd_page_address = NORFLASH_BD_PAGE_NONE;
+    norflash_bd_block_size = 0;
+    norflash_bd_block_count = 0;
+    
+    sector_size = norflash_get_sector_size();
+    page_size = norflash_get_page_size();
+    if ((sector_size == 0) || (page_size == 0) || (page_size > NORFLASH_BD_PAGE_BUFFER_SIZE))
+    {
+        return 1;
+    }
+    
+    if ((size == 0) || ((address % sector_size) != 0) || ((size % sector_size) != 0) || (address >= norflash_get_chip_size()) ||
+        (size > (norflash_get_chip_size() - sector_size - address)))
+    {
+        return 1;
+    }
+    
+    norflash_bd_address = address;
+    norflash_bd_block_size = sector_size;
+    norflash_bd_block_count = size / sector_size;
+    norflash_bd_page_size = page_size;
+    norflash_bd_reset_stats();
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡ豸β
+ * @param   geometry: βṹָ
+ * @retval  
+ */
+void norflash_bd_get_geometry(norflash_bd_geometry_t *geometry)
+{
+    geometry->read_size = 2;
+    geometry->prog_size = 2;
+    geometry->page_size = norflash_bd_page_size;
+    geometry->block_size = norflash_bd_block_size;
+    geometry->block_count = norflash_bd_block_count;
+}
+
+/**
+ * @brief   豸
+ * @note    ɿԽڿҳеʱͬ
+ * @param   block: 
+ * @param   offset: ƫ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_bd_read(uint32_t block, uint32_t offset, uint8_t *data, uint32_t length)
+{
+    uint32_t address;
+    uint32_t read_length;
+    uint8_t edge[2];
+    
+    if (norflash_bd_range_check(block, offset, length) != 0)
+    {
+        return 1;
+    }
+    if (length == 0)
+    {
+        return 0;
+    }
+    
+    norflash_bd_stats.read_bytes += length;
+    
+    address = norflash_bd_address + block * norflash_bd_block_size + offset;
+    if ((norflash_bd_page_address != NORFLASH_BD_PAGE_NONE) && (address < (norflash_bd_page_address + norflash_bd_page_size)) &&
+        ((address + length) > norflash_bd_page_address))
+    {
+        if (norflash_bd_flush() != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* ׵ַ */
+    if ((address & 1UL) != 0)
+    {
+        if (norflash_read(address - 1, edge, sizeof(edge)) != 0)
+        {
+            return 1;
+        }
+        *data++ = edge[1];
+        address++;
+        length--;
+        norflash_bd_stats.reads++;
+    }
+    
+    while (length > 1)
+    {
+        read_length = length & ~1UL;
+        if (read_length > NORFLASH_BD_READ_MAX)
+        {
+            read_length = NORFLASH_BD_READ_MAX;
+        }
+        
+        if (norflash_read(address, data, read_length) != 0)
+        {
+            return 1;
+        }
+        
+        address += read_length;
+        data += read_length;
+        length -= read_length;
+        norflash_bd_stats.reads++;
+    }
+    
+    /* β */
+    if (length != 0)
+    {
+        if (norflash_read(address, edge, sizeof(edge)) != 0)
+        {
+            return 1;
+        }
+        *data = edge[0];
+        norflash_bd_stats.reads++;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ̿豸
+ * @note    дҳҳ̲ͬҳʱ̵NOR Flash
+ * @param   block: 
+ * @param   offset: ƫ
+ * @param   data: ݻָ
+ * @param   length: ݳȣܿ飩
+ * @retval  ̽
+ * @arg     0: ̳ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_bd_prog(uint32_t block, uint32_t offset, const uint8_t *data, uint32_t length)
+{
+    uint32_t address;
+    uint32_t page_address;
+    uint32_t page_offset;
+    uint32_t page_length;
+    
+    if ((norflash_bd_range_check(block, offset, length) != 0) || ((offset + length) > norflash_bd_block_size))
+    {
+        return 1;
+    }
+    
+    address = norflash_bd_address + block * norflash_bd_block_size + offset;
+    while (length != 0)
+    {
+        page_address = address & ~(norflash_bd_page_size - 1);
+        page_offset = address - page_address;
+        page_length = norflash_bd_page_size - page_offset;
+        if (page_length > length)
+        {
+            page_length = length;
+        }
+        
+        /* ҳʱȱ */
+        if ((page_address != norflash_bd_page_address) || (page_offset != norflash_bd_dirty_end))
+        {
+            if (norflash_bd_flush() != 0)
+            {
+                return 1;
+            }
+            memset(norflash_bd_page, 0xFF, norflash_bd_page_size);
+            norflash_bd_page_address = page_address;
+            norflash_bd_dirty_start = page_offset;
+            norflash_bd_dirty_end = page_offset;
+        }
+        
+        memcpy(&norflash_bd_page[page_offset], data, page_length);
+        norflash_bd_dirty_end += page_length;
+        norflash_bd_stats.prog_bytes += page_length;
+        
+        /* ҳдʱ */
+        if (norflash_bd_dirty_end == norflash_bd_page_size)
+        {
+            if (norflash_bd_flush() != 0)
+            {
+                return 1;
+            }
+        }
+        
+        address += page_length;
+        data += page_length;
+        length -= page_length;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   
+ * @note    ҳڸÿֱӶȱ
+ * @param   block: 
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_bd_erase(uint32_t block)
+{
+    uint32_t address;
+    
+    if (norflash_bd_range_check(block, 0, norflash_bd_block_size) != 0)
+    {
+        return 1;
+    }
+    
+    address = norflash_bd_address + block * norflash_bd_block_size;
+    if ((norflash_bd_page_address - address) < norflash_bd_block_size)
+    {
+        norflash_bd_page_address = NORFLASH_BD_PAGE_NONE;
+    }
+    else if (norflash_bd_flush() != 0)
+    {
+        return 1;
+    }
+    
+    if (norflash_erase_sector(address) != 0)
+    {
+        return 1;
+    }
+    norflash_bd_stats.erases++;
+    
+    return 0;
+}
+
+/**
+ * @brief   ͬҳ
+ * @note    غ֮ǰ̵ݾдNOR Flash
+ * @param   
+ * @retval  ͬ
+ * @arg     0: ͬɹ
+ * @arg     1: ͬʧ
+ */
+uint8_t norflash_bd_sync(void)
+{
+    norflash_bd_stats.syncs++;
+    
+    return norflash_bd_flush();
+}
+
+/**
+ * @brief   ȡ豸ͳ
+ * @param   stats: ͳƽṹָ
+ * @retval  
+ */
+void norflash_bd_get_stats(norflash_bd_stats_t *stats)
+{
+    *stats = norflash_bd_stats;
+}
+
+/**
+ * @brief   豸ͳ
+ * @param   
+ * @retval  
+ */
+void norflash_bd_reset_stats(void)
+{
+    memset(&norflash_bd_stats, 0, sizeof(norflash_bd_stats));
+}
@@ -0,0 +1,60 @@
+/**
+ ****************************************************************************************************
+ * @file        norflash_bd.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       NOR Flash 豸
+ ****************************************************************************************************
+ * @attention
+ *
+ * NOR Flashеһ򰴲˫W25Q128Ϊ8KBÿƬ4KBΪ飬ṩ̡ͬӿڣ
+ * ƫ볤ȿΪֽڣ˫洢ģʽҪżַ볤ɱģ鴦
+ * дҳҳͬҳʱű̵NOR Flash
+ * ҪԱֵڵnorflash_bd_sync()д
+ * ǰĿѲѱ̵ֽڲٴα
+ * ʱNOR Flashܴڴӳģʽڴӳеĳ밴norflash_fs.h˵Χ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __NORFLASH_BD_H
+#define __NORFLASH_BD_H
+
+#include "norflash_w25q128.h"
+
+/* NOR Flash豸ζ󳤶ȶ */
+#define NORFLASH_BD_READ_MAX            (0x00010000UL)
+
+/* NOR Flash豸ҳС壨СNOR FlashҳС */
+#define NORFLASH_BD_PAGE_BUFFER_SIZE    (0x00000200UL)
+
+/* NOR Flash豸β */
+typedef struct {
+    uint32_t read_size;     /* СλNOR Flashԭ */
+    uint32_t prog_size;     /* С̵λNOR Flashԭ */
+    uint32_t page_size;     /* ҳС */
+    uint32_t block_size;    /* 飨С */
+    uint32_t block_count;   /*  */
+} norflash_bd_geometry_t;
+
+/* NOR Flash豸ͳƶ */
+typedef struct {
+    uint32_t reads;         /*  */
+    uint32_t read_bytes;    /* ֽ */
+    uint32_t progs;         /* ҳ̴ */
+    uint32_t prog_bytes;    /* ֽ룩 */
+    uint32_t erases;        /*  */
+    uint32_t syncs;         /* ͬ */
+} norflash_bd_stats_t;
+
+/*  */
+uint8_t norflash_bd_init(uint32_t address, uint32_t size);                          /* ʼ豸 */
+void norflash_bd_get_geometry(norflash_bd_geometry_t *geometry);                    /* ȡ豸β */
+uint8_t norflash_bd_read(uint32_t block, uint32_t offset, uint8_t *data, uint32_t length);          /* 豸 */
+uint8_t norflash_bd_prog(uint32_t block, uint32_t offset, const uint8_t *data, uint32_t length);    /* ̿豸 */
+uint8_t norflash_bd_erase(uint32_t block);                                          /*  */
+uint8_t norflash_bd_sync(void);                                                     /* ͬҳ */
+void norflash_bd_get_stats(norflash_bd_stats_t *stats);                             /* ȡ豸ͳ */
+void norflash_bd_reset_stats(void);                                                 /* 豸ͳ */
+
+#endif /* __NORFLASH_BD_H */
@@ -0,0 +1,375 @@
+/**
+ ****************************************************************************************************
+ * @file        norflash_cache.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       NOR Flash дػ
+ ****************************************************************************************************
+ * @attention
+ *
+ * дȺϲУڻ滻norflash_sync()гʱʱд
+ * дֻύб޸ĵ䣬norflash_write()ǷҪ
+ *
+ ****************************************************************************************************
+ */
+
+#include "norflash_cache.h"
+#include <string.h>
+
+/* NOR Flash */
+typedef struct {
+    uint8_t valid;          /* Ч */
+    uint8_t dirty;          /* ޸ */
+    uint32_t address;       /* ַ */
+    uint32_t dirty_start;   /* ޸ʼƫ */
+    uint32_t dirty_end;     /* ޸ƫ */
+    uint32_t stamp;         /* ţLRU */
+    uint32_t tick;          /* ʼ޸ĵʱ */
+} norflash_cache_entry_t;
+
+/* NOR Flash */
+static norflash_cache_entry_t norflash_cache_entry[NORFLASH_CACHE_SECTOR_NUM];
+static uint8_t norflash_cache_buffer[NORFLASH_CACHE_SECTOR_NUM][NORFLASH_SECTOR_BUFFER_SIZE];
+static uint32_t norflash_cache_stamp = 0;
+
+/**
+ * @brief   ȡС
+ * @param   
+ * @retval  С0ʾ޷
+ */
+static uint32_t norflash_cache_sector_size(void)
+{
+    uint32_t sector_size;
+    
+    sector_size = norflash_get_sector_size();
+    if (sector_size > NORFLASH_SECTOR_BUFFER_SIZE)
+    {
+        return 0;
+    }
+    
+    return sector_size;
+}
+
+/**
+ * @brief   ѻ
+ * @param   address: ַ
+ * @retval  NORFLASH_CACHE_SECTOR_NUMʾδ
+ */
+static uint8_t norflash_cache_find(uint32_t address)
+{
+    uint8_t index;
+    
+    for (index = 0; index < NORFLASH_CACHE_SECTOR_NUM; index++)
+    {
+        if ((norflash_cache_entry[index].valid != 0) && (norflash_cache_entry[index].address == address))
+        {
+            norflash_cache_entry[index].stamp = ++norflash_cache_stamp;
+            return index;
+        }
+    }
+    
+    return NORFLASH_CACHE_SECTOR_NUM;
+}
+
+/**
+ * @brief   д
+ * @param   index: 
+ * @retval  д
+ * @arg     0: дɹ
+ * @arg     1: дʧ
+ */
+static uint8_t norflash_cache_flush(uint8_t index)
+{
+    norflash_cache_entry_t *entry = &norflash_cache_entry[index];
+    
+    if ((entry->valid == 0) || (entry->dirty == 0))
+    {
+        return 0;
+    }
+    
+    if (norflash_write(entry->address + entry->dirty_start, &norflash_cache_buffer[index][entry->dirty_start], entry->dirty_end - entry->dirty_start) != 0)
+    {
+        return 1;
+    }
+    
+    entry->dirty = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief   仺
+ * @note    ʹÿ滻δʵ滻ǰд
+ * @param   address: ַ
+ * @param   sector_size: С
+ * @param   fill: ǷNOR Flash
+ * @retval  NORFLASH_CACHE_SECTOR_NUMʾʧ
+ */
+static uint8_t norflash_cache_alloc(uint32_t address, uint32_t sector_size, uint8_t fill)
+{
+    uint8_t index;
+    uint8_t victim = 0;
+    
+    for (index = 0; index < NORFLASH_CACHE_SECTOR_NUM; index++)
+    {
+        if (norflash_cache_entry[index].valid == 0)
+        {
+            victim = index;
+            break;
+        }
+        
+        if (norflash_cache_entry[index].stamp < norflash_cache_entry[victim].stamp)
+        {
+            victim = index;
+        }
+    }
+    
+    if (norflash_cache_flush(victim) != 0)
+    {
+        return NORFLASH_CACHE_SECTOR_NUM;
+    }
+    norflash_cache_entry[victim].valid = 0;
+    
+    if (fill != 0)
+    {
+        if (norflash_read(address, norflash_cache_buffer[victim], sector_size) != 0)
+        {
+            return NORFLASH_CACHE_SECTOR_NUM;
+        }
+    }
+    
+    norflash_cache_entry[victim].valid = 1;
+    norflash_cache_entry[victim].dirty = 0;
+    norflash_cache_entry[victim].address = address;
+    norflash_cache_entry[victim].stamp = ++norflash_cache_stamp;
+    
+    return victim;
+}
+
+/**
+ * @brief   дNOR Flash
+ * @note    д󼴷أnorflash_sync()norflash_cache_idle()дNOR Flash
+ * @param   address: ַ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  д
+ * @arg     0: дɹ
+ * @arg     1: дʧ
+ */
+uint8_t norflash_cache_write(uint32_t address, uint8_t *data, uint32_t length)
+{
+    uint32_t sector_size;
+    uint32_t sector_address;
+    uint32_t sector_offset;
+    uint32_t sector_write_length;
+    uint8_t index;
+    norflash_cache_entry_t *entry;
+    
+    sector_size = norflash_cache_sector_size();
+    if (sector_size == 0)
+    {
+        return 1;
+    }
+    
+    while (length != 0)
+    {
+        sector_address = address & ~(sector_size - 1);
+        sector_offset = address - sector_address;
+        sector_write_length = sector_size - sector_offset;
+        if (sector_write_length > length)
+        {
+            sector_write_length = length;
+        }
+        
+        /* дʱԭ */
+        index = norflash_cache_find(sector_address);
+        if (index == NORFLASH_CACHE_SECTOR_NUM)
+        {
+            index = norflash_cache_alloc(sector_address, sector_size, (sector_write_length == sector_size) ? 0 : 1);
+            if (index == NORFLASH_CACHE_SECTOR_NUM)
+            {
+                return 1;
+            }
+            
+            if (sector_write_length == sector_size)
+            {
+                norflash_cache_entry[index].dirty = 1;
+                norflash_cache_entry[index].dirty_start = 0;
+                norflash_cache_entry[index].dirty_end = sector_size;
+                norflash_cache_entry[index].tick = HAL_GetTick();
+            }
+        }
+        entry = &norflash_cache_entry[index];
+        
+        /* б仯ʱű޸ */
+        if (memcmp(&norflash_cache_buffer[index][sector_offset], data, sector_write_length) != 0)
+        {
+            memcpy(&norflash_cache_buffer[index][sector_offset], data, sector_write_length);
+            
+            if (entry->dirty == 0)
+            {
+                entry->dirty = 1;
+                entry->dirty_start = sector_offset;
+                entry->dirty_end = sector_offset + sector_write_length;
+                entry->tick = HAL_GetTick();
+            }
+            else
+            {
+                if (sector_offset < entry->dirty_start)
+                {
+                    entry->dirty_start = sector_offset;
+                }
+                if ((sector_offset + sector_write_length) > entry->dirty_end)
+                {
+                    entry->dirty_end = sector_offset + sector_write_length;
+                }
+            }
+        }
+        
+        address += sector_write_length;
+        data += sector_write_length;
+        length -= sector_write_length;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   NOR Flash
+ * @note    ѻӻȡδֱӶNOR FlashҲ仺
+ * @param   address: ַ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_cache_read(uint32_t address, uint8_t *data, uint32_t length)
+{
+    uint32_t sector_size;
+    uint32_t sector_address;
+    uint32_t sector_offset;
+    uint32_t sector_read_length;
+    uint8_t index;
+    
+    sector_size = norflash_cache_sector_size();
+    if (sector_size == 0)
+    {
+        return 1;
+    }
+    
+    while (length != 0)
+    {
+        sector_address = address & ~(sector_size - 1);
+        sector_offset = address - sector_address;
+        sector_read_length = sector_size - sector_offset;
+        if (sector_read_length > length)
+        {
+            sector_read_length = length;
+        }
+        
+        index = norflash_cache_find(sector_address);
+        if (index != NORFLASH_CACHE_SECTOR_NUM)
+        {
+            memcpy(data, &norflash_cache_buffer[index][sector_offset], sector_read_length);
+        }
+        else
+        {
+            if (norflash_read(address, data, sector_read_length) != 0)
+            {
+                return 1;
+            }
+        }
+        
+        address += sector_read_length;
+        data += sector_read_length;
+        length -= sector_read_length;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   дȫ
+ * @param   
+ * @retval  д
+ * @arg     0: дɹ
+ * @arg     1: дʧ
+ */
+uint8_t norflash_sync(void)
+{
+    uint8_t index;
+    uint8_t res = 0;
+    
+    for (index = 0; index < NORFLASH_CACHE_SECTOR_NUM; index++)
+    {
+        if (norflash_cache_flush(index) != 0)
+        {
+            res = 1;
+        }
+    }
+    
+    return res;
+}
+
+/**
+ * @brief   ʱдʱ
+ * @note    ѭڵã޸ʱ䳬NORFLASH_CACHE_IDLE_TIMEд
+ *          첽̨ʱд
+ * @param   
+ * @retval  д
+ * @arg     0: дɹ
+ * @arg     1: дʧ
+ */
+uint8_t norflash_cache_idle(void)
+{
+    uint8_t index;
+    uint8_t res = 0;
+    uint32_t tick;
+    
+    if ((norflash_async_busy() != 0) || (norflash_erase_background_busy() != 0))
+    {
+        return 0;
+    }
+    
+    tick = HAL_GetTick();
+    for (index = 0; index < NORFLASH_CACHE_SECTOR_NUM; index++)
+    {
+        if ((norflash_cache_entry[index].valid != 0) && (norflash_cache_entry[index].dirty != 0))
+        {
+            if ((tick - norflash_cache_entry[index].tick) >= NORFLASH_CACHE_IDLE_TIME)
+            {
+                if (norflash_cache_flush(index) != 0)
+                {
+                    res = 1;
+                }
+            }
+        }
+    }
+    
+    return res;
+}
+
+/**
+ * @brief   дջ
+ * @param   
+ * @retval  ս
+ * @arg     0: ճɹ
+ * @arg     1: дʧܣ汣
+ */
+uint8_t norflash_cache_invalidate(void)
+{
+    uint8_t index;
+    
+    if (norflash_sync() != 0)
+    {
+        return 1;
+    }
+    
+    for (index = 0; index < NORFLASH_CACHE_SECTOR_NUM; index++)
+    {
+        norflash_cache_entry[index].valid = 0;
+    }
+    
+    return 0;
+}
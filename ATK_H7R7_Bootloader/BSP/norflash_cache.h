@@ -0,0 +1,35 @@
+/**
+ ****************************************************************************************************
+ * @file        norflash_cache.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       NOR Flash дػ
+ ****************************************************************************************************
+ * @attention
+ *
+ * norflash_write()/norflash_read()֮ϻLRU滻
+ * СдϲΪÿһβ/̣ѻ
+ * ڼ䲻ƹģֱдѻȵnorflash_cache_invalidate()
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __NORFLASH_CACHE_H
+#define __NORFLASH_CACHE_H
+
+#include "norflash_w25q128.h"
+
+/* NOR Flash */
+#define NORFLASH_CACHE_SECTOR_NUM   (4)
+
+/* NOR Flashлдʱ䶨壨λ룩 */
+#define NORFLASH_CACHE_IDLE_TIME    (100)
+
+/*  */
+uint8_t norflash_cache_write(uint32_t address, uint8_t *data, uint32_t length);     /* дNOR Flash */
+uint8_t norflash_cache_read(uint32_t address, uint8_t *data, uint32_t length);      /* NOR Flash */
+uint8_t norflash_sync(void);                                                        /* дȫ */
+uint8_t norflash_cache_idle(void);                                                  /* ʱдʱ */
+uint8_t norflash_cache_invalidate(void);                                            /* дջ */
+
+#endif /* __NORFLASH_CACHE_H */
@@ -0,0 +1,1906 @@
+/**
+ ****************************************************************************************************
+ * @file        norflash_fs.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       NOR Flash 簲ȫļϵͳ
+ ****************************************************************************************************
+ * @attention
+ *
+ * Ԫݿnorflash_kv.cṹͬͷʶšCRC״̬֮׷Ӽ¼
+ * ÿ¼һļ¼ͷαļ4ֽڶ룩ͬļ¼¼Ϊ׼
+ * ɾʱ׷ɾǣʱŴӾɵطŽļɸļĿαݿλͼ
+ * ύ˳Ϊ: ͬļ -> ׷Ӳͬ¼¼ -> ͷԭ¼вʹõݿ飬
+ * ¼¼д֮ǰʱԭ¼ȻЧджϵļ¼CRC󲻻ᱻطţ
+ * ݿֻڷʱղͷŵδ·Ŀݱֲ
+ * ׷дʱһļĩβ֮Ϊֱд루ԭ¼ø򣩣һ鸴Ƶ¿д
+ * Ԫݻ水¼ַʹõļ¼򿪡ļʱضNOR Flash
+ * ԤַļݣС˳ÿNORFLASH_FS_READ_AHEADֻֽһ
+ * ֱӶûͬһֻһ
+ *
+ ****************************************************************************************************
+ */
+
+#include "norflash_fs.h"
+#include <string.h>
+
+#if (NORFLASH_FS_META_BLOCKS < 3)
+#error "NORFLASH_FS_META_BLOCKS must be at least 3"
+#endif
+
+#if ((NORFLASH_FS_FILE_MAX & (NORFLASH_FS_FILE_MAX - 1)) != 0)
+#error "NORFLASH_FS_FILE_MAX must be a power of 2"
+#endif
+
+#if (NORFLASH_FS_NAME_MAX > 255)
+#error "NORFLASH_FS_NAME_MAX must not exceed 255"
+#endif
+
+/* Ԫݿͷ¼ͷʶ */
+#define NORFLASH_FS_BLOCK_MAGIC     (0x5346464EUL)
+#define NORFLASH_FS_RECORD_MAGIC    (0x4652U)
+
+/* Ԫݿ״̬壨Ϊȫ1ǰΪ0 */
+#define NORFLASH_FS_BLOCK_VALID     (0xFFFFFFFFUL)
+#define NORFLASH_FS_BLOCK_OBSOLETE  (0x00000000UL)
+
+/* ¼Ͷ */
+#define NORFLASH_FS_TYPE_FILE       (0xFFU)
+#define NORFLASH_FS_TYPE_DELETE     (0x00U)
+
+/* ʱʹõıԪݿ */
+#define NORFLASH_FS_RESERVE_BLOCKS  (1)
+
+/* յַ壨ջԤݣ */
+#define NORFLASH_FS_NONE            (0xFFFFFFFFUL)
+
+/* ¼루˫洢ģʽ¶дĵַ볤Ϊż */
+#define NORFLASH_FS_ALIGN(x)        (((x) + 3UL) & ~3UL)
+
+/* NOR FlashļϵͳԪݿͷ */
+typedef struct {
+    uint32_t magic;         /* ʶ */
+    uint32_t sequence;      /* ţ1 */
+    uint32_t block_count;   /* ļϵͳ豸仯¸ʽ */
+    uint32_t crc;           /* ʶCRC32 */
+    uint32_t state;         /* ״̬ */
+} norflash_fs_block_header_t;
+
+/* NOR Flashļϵͳ¼ͷ */
+typedef struct {
+    uint16_t magic;         /* ʶ */
+    uint8_t name_length;    /* ļ */
+    uint8_t type;           /* ¼ */
+    uint32_t size;          /* ļ */
+    uint16_t extent_count;  /*  */
+    uint16_t reserved;      /*  */
+    uint32_t crc;           /* ¼ͷcrcαļCRC32 */
+} norflash_fs_record_header_t;
+
+/* ¼󳤶ȶ */
+#define NORFLASH_FS_RECORD_MAX      NORFLASH_FS_ALIGN(sizeof(norflash_fs_record_header_t) + NORFLASH_FS_EXTENT_MAX * sizeof(norflash_fs_extent_t) + NORFLASH_FS_NAME_MAX)
+
+/* NOR Flashļϵͳ */
+typedef struct {
+    uint32_t hash;          /* ļĹϣֵ */
+    uint32_t address;       /* ¼¼ַ豸ƫƣ */
+} norflash_fs_index_t;
+
+/* NOR FlashļϵͳԪݻ */
+typedef struct {
+    uint32_t address;       /* ¼ַ */
+    uint32_t age;           /* ʹʱ */
+    uint8_t record[NORFLASH_FS_RECORD_MAX];
+} norflash_fs_cache_t;
+
+/* NOR Flashļϵͳ */
+static norflash_fs_index_t norflash_fs_index[NORFLASH_FS_FILE_MAX];
+static norflash_fs_cache_t norflash_fs_cache[NORFLASH_FS_CACHE_NUM];
+static uint8_t norflash_fs_record[NORFLASH_FS_RECORD_MAX];              /* ¼ */
+static uint8_t norflash_fs_buffer[NORFLASH_FS_READ_AHEAD];              /* Ԥ븴ʱã */
+static uint32_t norflash_fs_buffer_address = NORFLASH_FS_NONE;          /* Ԥݵַ */
+static uint32_t norflash_fs_buffer_length = 0;                          /* Ԥݳ */
+static uint32_t norflash_fs_bitmap[(NORFLASH_FS_BLOCK_MAX + 31) / 32];  /* ݿλͼλʾʹ */
+static uint32_t norflash_fs_sequence[NORFLASH_FS_META_BLOCKS];          /* Ԫݿţ0ʾ */
+static uint8_t norflash_fs_erased[NORFLASH_FS_META_BLOCKS];             /* ԪݿȷΪ */
+static uint8_t norflash_fs_mounted = 0;
+static uint8_t norflash_fs_head = NORFLASH_FS_META_BLOCKS;              /* ǰдԪݿ */
+static uint32_t norflash_fs_head_offset = 0;                            /* ǰдԪݿдƫ */
+static uint32_t norflash_fs_sequence_max = 0;
+static uint32_t norflash_fs_block_size = 0;
+static uint32_t norflash_fs_block_count = 0;
+static uint32_t norflash_fs_files = 0;
+static uint32_t norflash_fs_free_blocks = 0;
+static uint32_t norflash_fs_cursor = 0;                                 /* ݿ */
+static uint32_t norflash_fs_cache_clock = 0;
+static norflash_fs_stats_t norflash_fs_stats = {0};
+
+/**
+ * @brief   CRC32
+ * @param   crc: CRCֵ״μ㴫0
+ * @param   data: ָ
+ * @param   length: ݳ
+ * @retval  CRC32
+ */
+static uint32_t norflash_fs_crc32(uint32_t crc, const uint8_t *data, uint32_t length)
+{
+    uint8_t bit;
+    
+    crc = ~crc;
+    while (length != 0)
+    {
+        crc ^= *data++;
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+        }
+        length--;
+    }
+    
+    return ~crc;
+}
+
+/**
+ * @brief   ļĹϣֵFNV-1a
+ * @param   name: ļ
+ * @param   name_length: ļ
+ * @retval  ϣֵ
+ */
+static uint32_t norflash_fs_hash(const uint8_t *name, uint8_t name_length)
+{
+    uint32_t hash = 0x811C9DC5UL;
+    
+    while (name_length != 0)
+    {
+        hash ^= *name++;
+        hash *= 0x01000193UL;
+        name_length--;
+    }
+    
+    return hash;
+}
+
+/**
+ * @brief   ļ
+ * @param   name: ļ
+ * @retval  ļȣ0ʾļЧ
+ */
+static uint8_t norflash_fs_name_length(const char *name)
+{
+    uint32_t length;
+    
+    if (name == NULL)
+    {
+        return 0;
+    }
+    
+    length = strlen(name);
+    if (length > NORFLASH_FS_NAME_MAX)
+    {
+        return 0;
+    }
+    
+    return (uint8_t)length;
+}
+
+/**
+ * @brief   ȡ¼ռó
+ * @param   header: ¼ͷָ
+ * @retval  ¼ռó
+ */
+static uint32_t norflash_fs_record_size(const norflash_fs_record_header_t *header)
+{
+    return NORFLASH_FS_ALIGN(sizeof(norflash_fs_record_header_t) + header->extent_count * sizeof(norflash_fs_extent_t) + header->name_length);
+}
+
+/**
+ * @brief   ȡ¼еĿα
+ * @param   record: ¼ָ
+ * @retval  αָ
+ */
+static norflash_fs_extent_t *norflash_fs_record_extent(uint8_t *record)
+{
+    return (norflash_fs_extent_t *)&record[sizeof(norflash_fs_record_header_t)];
+}
+
+/**
+ * @brief   ȡ¼еļ
+ * @param   record: ¼ָ
+ * @retval  ļָ루0β
+ */
+static uint8_t *norflash_fs_record_name(uint8_t *record)
+{
+    return &record[sizeof(norflash_fs_record_header_t) + ((norflash_fs_record_header_t *)record)->extent_count * sizeof(norflash_fs_extent_t)];
+}
+
+/**
+ * @brief   豸豸ƫƣ
+ * @param   address: 豸ƫ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_fs_bd_read(uint32_t address, uint8_t *data, uint32_t length)
+{
+    return norflash_bd_read(address / norflash_fs_block_size, address % norflash_fs_block_size, data, length);
+}
+
+/**
+ * @brief   ̿豸豸ƫƣ
+ * @note    Ԥ֮ʧЧ
+ * @param   address: 豸ƫ
+ * @param   data: ݻָ
+ * @param   length: ݳȣܿ飩
+ * @retval  ̽
+ * @arg     0: ̳ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_fs_prog(uint32_t address, const uint8_t *data, uint32_t length)
+{
+    norflash_fs_buffer_address = NORFLASH_FS_NONE;
+    
+    return norflash_bd_prog(address / norflash_fs_block_size, address % norflash_fs_block_size, data, length);
+}
+
+/**
+ * @brief   
+ * @note    Ԥÿм¼Ԫݻ֮ʧЧ
+ * @param   block: 
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_fs_erase(uint32_t block)
+{
+    uint8_t index;
+    
+    norflash_fs_buffer_address = NORFLASH_FS_NONE;
+    for (index = 0; index < NORFLASH_FS_CACHE_NUM; index++)
+    {
+        if ((norflash_fs_cache[index].address != NORFLASH_FS_NONE) && ((norflash_fs_cache[index].address / norflash_fs_block_size) == block))
+        {
+            norflash_fs_cache[index].address = NORFLASH_FS_NONE;
+        }
+    }
+    
+    return norflash_bd_erase(block);
+}
+
+/**
+ * @brief   
+ * @note    ʹԤ
+ * @param   address: 豸ƫ
+ * @param   length: 
+ * @param   blank: ս1: Ϊ; 0: ǿգ
+ * @retval  ս
+ * @arg     0: ճɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_fs_blank_check(uint32_t address, uint32_t length, uint8_t *blank)
+{
+    uint32_t read_length;
+    uint32_t index;
+    uint8_t empty_value;
+    
+    empty_value = norflash_get_empty_value();
+    norflash_fs_buffer_address = NORFLASH_FS_NONE;
+    while (length != 0)
+    {
+        read_length = (length > sizeof(norflash_fs_buffer)) ? sizeof(norflash_fs_buffer) : length;
+        if (norflash_fs_bd_read(address, norflash_fs_buffer, read_length) != 0)
+        {
+            return 1;
+        }
+        
+        for (index = 0; index < read_length; index++)
+        {
+            if (norflash_fs_buffer[index] != empty_value)
+            {
+                *blank = 0;
+                return 0;
+            }
+        }
+        
+        address += read_length;
+        length -= read_length;
+    }
+    
+    *blank = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief   ѯݿǷʹ
+ * @param   block: 
+ * @retval  0: ; 1: ʹ
+ */
+static uint8_t norflash_fs_block_used(uint32_t block)
+{
+    return ((norflash_fs_bitmap[block / 32] & (1UL << (block % 32))) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief   ݿʹ״̬
+ * @param   block: 
+ * @param   used: 0: ; 1: ʹ
+ * @retval  
+ */
+static void norflash_fs_block_mark(uint32_t block, uint8_t used)
+{
+    if (norflash_fs_block_used(block) == used)
+    {
+        return;
+    }
+    
+    if (used != 0)
+    {
+        norflash_fs_bitmap[block / 32] |= 1UL << (block % 32);
+        norflash_fs_free_blocks--;
+    }
+    else
+    {
+        norflash_fs_bitmap[block / 32] &= ~(1UL << (block % 32));
+        norflash_fs_free_blocks++;
+    }
+}
+
+/**
+ * @brief   ѯαǷݿ
+ * @param   extent: α
+ * @param   extent_count: 
+ * @param   block: 
+ * @retval  0: ; 1: 
+ */
+static uint8_t norflash_fs_extent_contains(const norflash_fs_extent_t *extent, uint16_t extent_count, uint32_t block)
+{
+    uint16_t index;
+    
+    for (index = 0; index < extent_count; index++)
+    {
+        if ((block - extent[index].start) < extent[index].count)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡԪݻδʹõĻ
+ * @param   
+ * @retval  ָ
+ */
+static norflash_fs_cache_t *norflash_fs_cache_victim(void)
+{
+    norflash_fs_cache_t *victim = &norflash_fs_cache[0];
+    uint8_t index;
+    
+    for (index = 0; index < NORFLASH_FS_CACHE_NUM; index++)
+    {
+        if (norflash_fs_cache[index].address == NORFLASH_FS_NONE)
+        {
+            return &norflash_fs_cache[index];
+        }
+        if (norflash_fs_cache[index].age < victim->age)
+        {
+            victim = &norflash_fs_cache[index];
+        }
+    }
+    
+    return victim;
+}
+
+/**
+ * @brief   ȡ¼
+ * @note    ԪݻȡδʱNOR FlashȡУCRCصļ¼´ζȡ¼ǰЧ
+ * @param   address: ¼ַ
+ * @param   record: ¼ָ
+ * @retval  ȡ
+ * @arg     0: ȡɹ
+ * @arg     1: ȡʧܣʧܻ¼𻵣
+ */
+static uint8_t norflash_fs_record_load(uint32_t address, uint8_t **record)
+{
+    norflash_fs_cache_t *cache;
+    norflash_fs_record_header_t *header;
+    uint32_t size;
+    uint32_t crc;
+    uint8_t index;
+    
+    for (index = 0; index < NORFLASH_FS_CACHE_NUM; index++)
+    {
+        if (norflash_fs_cache[index].address == address)
+        {
+            norflash_fs_cache[index].age = ++norflash_fs_cache_clock;
+            norflash_fs_stats.cache_hits++;
+            *record = norflash_fs_cache[index].record;
+            return 0;
+        }
+    }
+    
+    cache = norflash_fs_cache_victim();
+    cache->address = NORFLASH_FS_NONE;
+    header = (norflash_fs_record_header_t *)cache->record;
+    if (norflash_fs_bd_read(address, cache->record, sizeof(norflash_fs_record_header_t)) != 0)
+    {
+        return 1;
+    }
+    
+    size = norflash_fs_record_size(header);
+    if ((header->magic != NORFLASH_FS_RECORD_MAGIC) || (header->name_length == 0) || (header->name_length > NORFLASH_FS_NAME_MAX) ||
+        (header->extent_count > NORFLASH_FS_EXTENT_MAX) || (((address % norflash_fs_block_size) + size) > norflash_fs_block_size))
+    {
+        return 1;
+    }
+    
+    if (norflash_fs_bd_read(address, cache->record, size) != 0)
+    {
+        return 1;
+    }
+    crc = norflash_fs_crc32(0, cache->record, sizeof(norflash_fs_record_header_t) - sizeof(uint32_t));
+    crc = norflash_fs_crc32(crc, &cache->record[sizeof(norflash_fs_record_header_t)], size - sizeof(norflash_fs_record_header_t));
+    if (crc != header->crc)
+    {
+        return 1;
+    }
+    
+    cache->address = address;
+    cache->age = ++norflash_fs_cache_clock;
+    norflash_fs_stats.cache_misses++;
+    *record = cache->record;
+    
+    return 0;
+}
+
+/**
+ * @brief   вļ
+ * @note    ̽⣬ϣֵͬʱ¼Ƚļ
+ * @param   name: ļ
+ * @param   name_length: ļ
+ * @param   slot: ҵʱΪļδҵʱΪɲĿ
+ * @param   found: ҽ1: ҵ; 0: δҵ
+ * @retval  ҽ
+ * @arg     0: ҳɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_fs_index_find(const uint8_t *name, uint8_t name_length, uint32_t *slot, uint8_t *found)
+{
+    norflash_fs_record_header_t *header;
+    uint32_t hash;
+    uint32_t probe;
+    uint32_t index;
+    uint8_t *record;
+    
+    hash = norflash_fs_hash(name, name_length);
+    for (probe = 0; probe < NORFLASH_FS_FILE_MAX; probe++)
+    {
+        index = (hash + probe) & (NORFLASH_FS_FILE_MAX - 1);
+        if (norflash_fs_index[index].address == NORFLASH_FS_NONE)
+        {
+            *slot = index;
+            *found = 0;
+            return 0;
+        }
+        
+        if (norflash_fs_index[index].hash == hash)
+        {
+            if (norflash_fs_record_load(norflash_fs_index[index].address, &record) != 0)
+            {
+                return 1;
+            }
+            header = (norflash_fs_record_header_t *)record;
+            if ((header->name_length == name_length) && (memcmp(norflash_fs_record_name(record), name, name_length) == 0))
+            {
+                *slot = index;
+                *found = 1;
+                return 0;
+            }
+        }
+    }
+    
+    *slot = NORFLASH_FS_FILE_MAX;
+    *found = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief   ɾ
+ * @note    ɾ̽
+ * @param   slot: 
+ * @retval  
+ */
+static void norflash_fs_index_remove(uint32_t slot)
+{
+    uint32_t next = slot;
+    uint32_t home;
+    
+    norflash_fs_index[slot].address = NORFLASH_FS_NONE;
+    while (1)
+    {
+        next = (next + 1) & (NORFLASH_FS_FILE_MAX - 1);
+        if (norflash_fs_index[next].address == NORFLASH_FS_NONE)
+        {
+            break;
+        }
+        
+        /* λλڸ̽ʱǰƸ */
+        home = norflash_fs_index[next].hash & (NORFLASH_FS_FILE_MAX - 1);
+        if (((next - home) & (NORFLASH_FS_FILE_MAX - 1)) >= ((next - slot) & (NORFLASH_FS_FILE_MAX - 1)))
+        {
+            norflash_fs_index[slot] = norflash_fs_index[next];
+            norflash_fs_index[next].address = NORFLASH_FS_NONE;
+            slot = next;
+        }
+    }
+    
+    norflash_fs_files--;
+}
+
+/**
+ * @brief   д
+ * @param   slot: norflash_fs_index_find()ص
+ * @param   found: norflash_fs_index_find()Ĳҽ
+ * @param   name: ļ
+ * @param   name_length: ļ
+ * @param   address: ¼ַ
+ * @retval  д
+ * @arg     0: дɹ
+ * @arg     1: дʧܣ
+ */
+static uint8_t norflash_fs_index_set(uint32_t slot, uint8_t found, const uint8_t *name, uint8_t name_length, uint32_t address)
+{
+    if (found != 0)
+    {
+        norflash_fs_index[slot].address = address;
+        return 0;
+    }
+    
+    /* һʹ̽ܽ */
+    if ((slot == NORFLASH_FS_FILE_MAX) || (norflash_fs_files >= (NORFLASH_FS_FILE_MAX - 1)))
+    {
+        return 1;
+    }
+    
+    norflash_fs_index[slot].hash = norflash_fs_hash(name, name_length);
+    norflash_fs_index[slot].address = address;
+    norflash_fs_files++;
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡԪݿ
+ * @param   
+ * @retval  Ԫݿ
+ */
+static uint8_t norflash_fs_meta_free(void)
+{
+    uint8_t block;
+    uint8_t count = 0;
+    
+    for (block = 0; block < NORFLASH_FS_META_BLOCKS; block++)
+    {
+        if (norflash_fs_sequence[block] == 0)
+        {
+            count++;
+        }
+    }
+    
+    return count;
+}
+
+/**
+ * @brief   ÿԪݿΪǰдԪݿ
+ * @note    ԪݿǿʱȲдŵĿͷ
+ * @param   
+ * @retval  ý
+ * @arg     0: óɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_fs_meta_open(void)
+{
+    norflash_fs_block_header_t header;
+    uint8_t block;
+    uint8_t blank;
+    
+    for (block = 0; block < NORFLASH_FS_META_BLOCKS; block++)
+    {
+        if (norflash_fs_sequence[block] == 0)
+        {
+            break;
+        }
+    }
+    if (block == NORFLASH_FS_META_BLOCKS)
+    {
+        return 1;
+    }
+    
+    if (norflash_fs_erased[block] == 0)
+    {
+        if (norflash_fs_blank_check(block * norflash_fs_block_size, norflash_fs_block_size, &blank) != 0)
+        {
+            return 1;
+        }
+        if (blank == 0)
+        {
+            if (norflash_fs_erase(block) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+    norflash_fs_erased[block] = 0;
+    
+    /* ״ֱֲֵ̬ */
+    header.magic = NORFLASH_FS_BLOCK_MAGIC;
+    header.sequence = norflash_fs_sequence_max + 1;
+    header.block_count = norflash_fs_block_count;
+    header.crc = norflash_fs_crc32(0, (uint8_t *)&header, 3 * sizeof(uint32_t));
+    if (norflash_fs_prog(block * norflash_fs_block_size, (uint8_t *)&header, 4 * sizeof(uint32_t)) != 0)
+    {
+        return 1;
+    }
+    
+    norflash_fs_sequence_max = header.sequence;
+    norflash_fs_sequence[block] = header.sequence;
+    norflash_fs_head = block;
+    norflash_fs_head_offset = sizeof(norflash_fs_block_header_t);
+    
+    return 0;
+}
+
+/**
+ * @brief   ȷǰдԪݿ㹻ռ
+ * @note    ռ䲻ʱԪݿ飨ʹñ飩
+ * @param   size: ¼ռó
+ * @retval  ׼
+ * @arg     0: ׼ɹ
+ * @arg     1: ׼ʧ
+ */
+static uint8_t norflash_fs_head_prepare(uint32_t size)
+{
+    if ((norflash_fs_head == NORFLASH_FS_META_BLOCKS) || ((norflash_fs_head_offset + size) > norflash_fs_block_size))
+    {
+        return norflash_fs_meta_open();
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ׷Ӽ¼еļ¼
+ * @note    ȵnorflash_fs_head_prepare()¼ͬ豸дNOR Flash
+ * @param   size: ¼ռó
+ * @param   address: ¼ַ
+ * @retval  ׷ӽ
+ * @arg     0: ׷ӳɹ
+ * @arg     1: ׷ʧ
+ */
+static uint8_t norflash_fs_append(uint32_t size, uint32_t *address)
+{
+    if ((norflash_fs_head == NORFLASH_FS_META_BLOCKS) || ((norflash_fs_head_offset + size) > norflash_fs_block_size))
+    {
+        return 1;
+    }
+    
+    *address = norflash_fs_head * norflash_fs_block_size + norflash_fs_head_offset;
+    if (norflash_fs_prog(*address, norflash_fs_record, size) != 0)
+    {
+        /* дʧܵʹ */
+        norflash_fs_head_offset = norflash_fs_block_size;
+        return 1;
+    }
+    
+    norflash_fs_head_offset += size;
+    
+    return 0;
+}
+
+/**
+ * @brief   Ԫݿ
+ * @note    ָļ¼ƵǰдԪݿ飬ϲÿ
+ * @param   
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧܣ޿Ԫݿռ䲻㣩
+ */
+static uint8_t norflash_fs_compact_block(void)
+{
+    uint32_t block_address;
+    uint32_t slot;
+    uint32_t size;
+    uint32_t address;
+    uint32_t state = NORFLASH_FS_BLOCK_OBSOLETE;
+    uint8_t *record;
+    uint8_t block;
+    uint8_t victim = NORFLASH_FS_META_BLOCKS;
+    
+    for (block = 0; block < NORFLASH_FS_META_BLOCKS; block++)
+    {
+        if ((norflash_fs_sequence[block] == 0) || (block == norflash_fs_head))
+        {
+            continue;
+        }
+        if ((victim == NORFLASH_FS_META_BLOCKS) || (norflash_fs_sequence[block] < norflash_fs_sequence[victim]))
+        {
+            victim = block;
+        }
+    }
+    if (victim == NORFLASH_FS_META_BLOCKS)
+    {
+        return 1;
+    }
+    
+    block_address = victim * norflash_fs_block_size;
+    for (slot = 0; slot < NORFLASH_FS_FILE_MAX; slot++)
+    {
+        address = norflash_fs_index[slot].address;
+        if ((address == NORFLASH_FS_NONE) || ((address - block_address) >= norflash_fs_block_size))
+        {
+            continue;
+        }
+        
+        if (norflash_fs_record_load(address, &record) != 0)
+        {
+            return 1;
+        }
+        size = norflash_fs_record_size((norflash_fs_record_header_t *)record);
+        memcpy(norflash_fs_record, record, size);
+        if (norflash_fs_head_prepare(size) != 0)
+        {
+            return 1;
+        }
+        
+        if (norflash_fs_append(size, &address) != 0)
+        {
+            return 1;
+        }
+        norflash_fs_index[slot].address = address;
+    }
+    
+    /* Ƶļ¼дϣϺٲжʱÿ鲻ᱻط */
+    if (norflash_bd_sync() != 0)
+    {
+        return 1;
+    }
+    if (norflash_fs_prog(block_address + 4 * sizeof(uint32_t), (uint8_t *)&state, sizeof(state)) != 0)
+    {
+        return 1;
+    }
+    if (norflash_bd_sync() != 0)
+    {
+        return 1;
+    }
+    norflash_fs_sequence[victim] = 0;
+    
+    if (norflash_fs_erase(victim) != 0)
+    {
+        return 1;
+    }
+    norflash_fs_erased[victim] = 1;
+    norflash_fs_stats.compactions++;
+    
+    return 0;
+}
+
+/**
+ * @brief   Ϊ׷Ӽ¼׼ռ
+ * @note    ǰдԪݿռ䲻ҿԪݿ鲻ڱʱԪݿ飬
+ *          ȷǰдԪݿ㹻ռ䣻ḲǼ¼װ¼ǰ
+ * @param   size: ¼ռó
+ * @retval  ׼
+ * @arg     0: ׼ɹ
+ * @arg     1: ռ䲻
+ */
+static uint8_t norflash_fs_make_room(uint32_t size)
+{
+    uint8_t count = 0;
+    
+    while (((norflash_fs_head == NORFLASH_FS_META_BLOCKS) || ((norflash_fs_head_offset + size) > norflash_fs_block_size)) && (norflash_fs_meta_free() <= NORFLASH_FS_RESERVE_BLOCKS))
+    {
+        /* Ч¼ռȫԪݿʱ޷ڳռ */
+        if (count++ >= NORFLASH_FS_META_BLOCKS)
+        {
+            return 1;
+        }
+        
+        if (norflash_fs_compact_block() != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return norflash_fs_head_prepare(size);
+}
+
+/**
+ * @brief   ڼ¼װ¼
+ * @param   name: ļ
+ * @param   name_length: ļ
+ * @param   file: ļָ룬NULLʾɾ
+ * @retval  ¼ռó
+ */
+static uint32_t norflash_fs_record_build(const char *name, uint8_t name_length, const norflash_fs_file_t *file)
+{
+    norflash_fs_record_header_t *header = (norflash_fs_record_header_t *)norflash_fs_record;
+    uint8_t *record_name;
+    uint32_t size;
+    
+    header->magic = NORFLASH_FS_RECORD_MAGIC;
+    header->name_length = name_length;
+    header->type = (file != NULL) ? NORFLASH_FS_TYPE_FILE : NORFLASH_FS_TYPE_DELETE;
+    header->size = (file != NULL) ? file->size : 0;
+    header->extent_count = (file != NULL) ? file->extent_count : 0;
+    header->reserved = 0xFFFF;
+    size = norflash_fs_record_size(header);
+    
+    if (header->extent_count != 0)
+    {
+        memcpy(norflash_fs_record_extent(norflash_fs_record), file->extent, header->extent_count * sizeof(norflash_fs_extent_t));
+    }
+    record_name = norflash_fs_record_name(norflash_fs_record);
+    memcpy(record_name, name, name_length);
+    memset(record_name + name_length, 0xFF, (uint32_t)(&norflash_fs_record[size] - (record_name + name_length)));
+    
+    header->crc = norflash_fs_crc32(0, norflash_fs_record, sizeof(norflash_fs_record_header_t) - sizeof(uint32_t));
+    header->crc = norflash_fs_crc32(header->crc, &norflash_fs_record[sizeof(norflash_fs_record_header_t)], size - sizeof(norflash_fs_record_header_t));
+    
+    return size;
+}
+
+/**
+ * @brief   طԪݿеļ¼
+ * @param   block: Ԫݿ
+ * @param   end: Ч¼ƫƣ𻵼¼ʱΪС
+ * @retval  طŽ
+ * @arg     0: طųɹ
+ * @arg     1: طʧܣʧܻ
+ */
+static uint8_t norflash_fs_block_replay(uint8_t block, uint32_t *end)
+{
+    norflash_fs_record_header_t *header = (norflash_fs_record_header_t *)norflash_fs_record;
+    uint32_t block_address;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t crc;
+    uint32_t index;
+    uint32_t slot;
+    uint8_t found;
+    uint8_t empty_value;
+    
+    empty_value = norflash_get_empty_value();
+    block_address = block * norflash_fs_block_size;
+    offset = sizeof(norflash_fs_block_header_t);
+    while ((offset + sizeof(norflash_fs_record_header_t)) <= norflash_fs_block_size)
+    {
+        if (norflash_fs_bd_read(block_address + offset, norflash_fs_record, sizeof(norflash_fs_record_header_t)) != 0)
+        {
+            return 1;
+        }
+        
+        /* ¼ͷΪձʾ־ */
+        for (index = 0; index < sizeof(norflash_fs_record_header_t); index++)
+        {
+            if (norflash_fs_record[index] != empty_value)
+            {
+                break;
+            }
+        }
+        if (index == sizeof(norflash_fs_record_header_t))
+        {
+            break;
+        }
+        
+        size = norflash_fs_record_size(header);
+        if ((header->magic != NORFLASH_FS_RECORD_MAGIC) || (header->name_length == 0) || (header->name_length > NORFLASH_FS_NAME_MAX) ||
+            (header->extent_count > NORFLASH_FS_EXTENT_MAX) || ((header->type != NORFLASH_FS_TYPE_FILE) && (header->type != NORFLASH_FS_TYPE_DELETE)) ||
+            ((offset + size) > norflash_fs_block_size))
+        {
+            offset = norflash_fs_block_size;
+            break;
+        }
+        
+        if (norflash_fs_bd_read(block_address + offset, norflash_fs_record, size) != 0)
+        {
+            return 1;
+        }
+        crc = norflash_fs_crc32(0, norflash_fs_record, sizeof(norflash_fs_record_header_t) - sizeof(uint32_t));
+        crc = norflash_fs_crc32(crc, &norflash_fs_record[sizeof(norflash_fs_record_header_t)], size - sizeof(norflash_fs_record_header_t));
+        if (crc != header->crc)
+        {
+            offset = norflash_fs_block_size;
+            break;
+        }
+        
+        if (norflash_fs_index_find(norflash_fs_record_name(norflash_fs_record), header->name_length, &slot, &found) != 0)
+        {
+            return 1;
+        }
+        if (header->type == NORFLASH_FS_TYPE_DELETE)
+        {
+            if (found != 0)
+            {
+                norflash_fs_index_remove(slot);
+            }
+        }
+        else if (norflash_fs_index_set(slot, found, norflash_fs_record_name(norflash_fs_record), header->name_length, block_address + offset) != 0)
+        {
+            return 1;
+        }
+        
+        offset += size;
+    }
+    
+    *end = offset;
+    
+    return 0;
+}
+
+/**
+ * @brief   ɸļĿαݿλͼ
+ * @param   
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧܣʧܡԽص
+ */
+static uint8_t norflash_fs_bitmap_build(void)
+{
+    norflash_fs_extent_t *extent;
+    uint32_t slot;
+    uint32_t block;
+    uint16_t index;
+    uint8_t *record;
+    
+    memset(norflash_fs_bitmap, 0, sizeof(norflash_fs_bitmap));
+    norflash_fs_free_blocks = norflash_fs_block_count - NORFLASH_FS_META_BLOCKS;
+    
+    for (slot = 0; slot < NORFLASH_FS_FILE_MAX; slot++)
+    {
+        if (norflash_fs_index[slot].address == NORFLASH_FS_NONE)
+        {
+            continue;
+        }
+        
+        if (norflash_fs_record_load(norflash_fs_index[slot].address, &record) != 0)
+        {
+            return 1;
+        }
+        
+        extent = norflash_fs_record_extent(record);
+        for (index = 0; index < ((norflash_fs_record_header_t *)record)->extent_count; index++)
+        {
+            if ((extent[index].start < NORFLASH_FS_META_BLOCKS) || ((extent[index].start + extent[index].count) > norflash_fs_block_count))
+            {
+                return 1;
+            }
+            
+            for (block = extent[index].start; block < (uint32_t)(extent[index].start + extent[index].count); block++)
+            {
+                if (norflash_fs_block_used(block) != 0)
+                {
+                    return 1;
+                }
+                norflash_fs_block_mark(block, 1);
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ͷż¼õݿ
+ * @param   address: ¼ַ
+ * @param   keep: ʹõĿļָ룬NULLʾȫͷ
+ * @retval  ͷŽ
+ * @arg     0: ͷųɹ
+ * @arg     1: ͷʧ
+ */
+static uint8_t norflash_fs_release(uint32_t address, const norflash_fs_file_t *keep)
+{
+    norflash_fs_extent_t *extent;
+    uint32_t block;
+    uint16_t index;
+    uint8_t *record;
+    
+    if (norflash_fs_record_load(address, &record) != 0)
+    {
+        return 1;
+    }
+    
+    extent = norflash_fs_record_extent(record);
+    for (index = 0; index < ((norflash_fs_record_header_t *)record)->extent_count; index++)
+    {
+        for (block = extent[index].start; block < (uint32_t)(extent[index].start + extent[index].count); block++)
+        {
+            if ((keep == NULL) || (norflash_fs_extent_contains(keep->extent, keep->extent_count, block) == 0))
+            {
+                norflash_fs_block_mark(block, 0);
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ݿ
+ * @note    ʹhintָĿ飨ʹļӷ㿪ʼҿп飻ǿʱȲ
+ * @param   hint: ʹõĿ
+ * @param   block: Ŀ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧܣ޿пʧܣ
+ */
+static uint8_t norflash_fs_block_alloc(uint32_t hint, uint32_t *block)
+{
+    uint32_t data_blocks = norflash_fs_block_count - NORFLASH_FS_META_BLOCKS;
+    uint32_t candidate;
+    uint32_t probe;
+    uint8_t blank;
+    
+    if ((hint < NORFLASH_FS_META_BLOCKS) || (hint >= norflash_fs_block_count) || (norflash_fs_block_used(hint) != 0))
+    {
+        for (probe = 0; probe < data_blocks; probe++)
+        {
+            candidate = NORFLASH_FS_META_BLOCKS + (norflash_fs_cursor - NORFLASH_FS_META_BLOCKS + probe) % data_blocks;
+            if (norflash_fs_block_used(candidate) == 0)
+            {
+                break;
+            }
+        }
+        if (probe == data_blocks)
+        {
+            return 1;
+        }
+        hint = candidate;
+    }
+    
+    /* ´δʼңʹɢ */
+    norflash_fs_cursor = (hint + 1 < norflash_fs_block_count) ? (hint + 1) : NORFLASH_FS_META_BLOCKS;
+    
+    if (norflash_fs_blank_check(hint * norflash_fs_block_size, norflash_fs_block_size, &blank) != 0)
+    {
+        return 1;
+    }
+    if (blank == 0)
+    {
+        if (norflash_fs_erase(hint) != 0)
+        {
+            return 1;
+        }
+        norflash_fs_stats.block_erases++;
+    }
+    
+    norflash_fs_block_mark(hint, 1);
+    *block = hint;
+    
+    return 0;
+}
+
+/**
+ * @brief   ļĩβݿ
+ * @param   file: ļָ
+ * @param   block: 
+ * @retval  ӽ
+ * @arg     0: ӳɹ
+ * @arg     1: ʧܣ
+ */
+static uint8_t norflash_fs_extent_add(norflash_fs_file_t *file, uint32_t block)
+{
+    norflash_fs_extent_t *last = (file->extent_count != 0) ? &file->extent[file->extent_count - 1] : NULL;
+    
+    if ((last != NULL) && ((last->start + last->count) == block) && (last->count != 0xFFFF))
+    {
+        last->count++;
+    }
+    else if (file->extent_count < NORFLASH_FS_EXTENT_MAX)
+    {
+        file->extent[file->extent_count].start = (uint16_t)block;
+        file->extent[file->extent_count].count = 1;
+        file->extent_count++;
+    }
+    else
+    {
+        return 1;
+    }
+    
+    file->blocks++;
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡļһݿ
+ * @param   file: ļָ
+ * @retval  
+ */
+static uint32_t norflash_fs_last_block(const norflash_fs_file_t *file)
+{
+    return file->extent[file->extent_count - 1].start + file->extent[file->extent_count - 1].count - 1;
+}
+
+/**
+ * @brief   ȡļλöӦĿ豸ƫ
+ * @param   file: ļָ
+ * @param   position: ļλãСѷܳȣ
+ * @param   address: 豸ƫ
+ * @param   run: Ӹλĳ
+ * @retval  
+ */
+static void norflash_fs_locate(const norflash_fs_file_t *file, uint32_t position, uint32_t *address, uint32_t *run)
+{
+    uint32_t length;
+    uint16_t index;
+    
+    for (index = 0; index < file->extent_count; index++)
+    {
+        length = file->extent[index].count * norflash_fs_block_size;
+        if (position < length)
+        {
+            *address = file->extent[index].start * norflash_fs_block_size + position;
+            *run = length - position;
+            return;
+        }
+        position -= length;
+    }
+    
+    *address = NORFLASH_FS_NONE;
+    *run = 0;
+}
+
+/**
+ * @brief   ļһݿ
+ * @note    ׷дʱһļĩβ֮ǿգϴ׷дδύ磩ЧݸƵ¿飬
+ *          ԭύͷ
+ * @param   file: ļָ
+ * @retval  ƽ
+ * @arg     0: Ƴɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_fs_tail_copy(norflash_fs_file_t *file)
+{
+    uint32_t source;
+    uint32_t block;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t tail = file->size % norflash_fs_block_size;
+    
+    source = norflash_fs_last_block(file);
+    if (norflash_fs_block_alloc(NORFLASH_FS_NONE, &block) != 0)
+    {
+        return 1;
+    }
+    
+    for (offset = 0; offset < tail; offset += length)
+    {
+        length = tail - offset;
+        if (length > sizeof(norflash_fs_buffer))
+        {
+            length = sizeof(norflash_fs_buffer);
+        }
+        
+        if (norflash_fs_bd_read(source * norflash_fs_block_size + offset, norflash_fs_buffer, length) != 0)
+        {
+            return 1;
+        }
+        if (norflash_fs_prog(block * norflash_fs_block_size + offset, norflash_fs_buffer, length) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* ¿滻һ */
+    file->extent[file->extent_count - 1].count--;
+    if (file->extent[file->extent_count - 1].count == 0)
+    {
+        file->extent_count--;
+    }
+    file->blocks--;
+    
+    return norflash_fs_extent_add(file, block);
+}
+
+/**
+ * @brief   ύļ
+ * @note    ͬļݣ׷Ӳͬ¼¼ͷԭ¼ļʹõݿ
+ * @param   file: ļָ
+ * @retval  ύ
+ * @arg     0: ύɹ
+ * @arg     1: ύʧ
+ */
+static uint8_t norflash_fs_commit(norflash_fs_file_t *file)
+{
+    norflash_fs_record_header_t header;
+    uint32_t slot;
+    uint32_t size;
+    uint32_t address;
+    uint8_t found;
+    
+    if (norflash_fs_index_find((const uint8_t *)file->name, file->name_length, &slot, &found) != 0)
+    {
+        return 1;
+    }
+    if ((found == 0) && ((slot == NORFLASH_FS_FILE_MAX) || (norflash_fs_files >= (NORFLASH_FS_FILE_MAX - 1))))
+    {
+        return 1;
+    }
+    
+    /* ļڼ¼д */
+    if (norflash_bd_sync() != 0)
+    {
+        return 1;
+    }
+    
+    header.name_length = file->name_length;
+    header.extent_count = file->extent_count;
+    size = norflash_fs_record_size(&header);
+    if (norflash_fs_make_room(size) != 0)
+    {
+        return 1;
+    }
+    
+    norflash_fs_record_build(file->name, file->name_length, file);
+    if (norflash_fs_append(size, &address) != 0)
+    {
+        return 1;
+    }
+    if (norflash_bd_sync() != 0)
+    {
+        return 1;
+    }
+    
+    /* Ԫݿֻдеĵַλò */
+    if (found != 0)
+    {
+        if (norflash_fs_release(norflash_fs_index[slot].address, file) != 0)
+        {
+            return 1;
+        }
+    }
+    if (norflash_fs_index_set(slot, found, (const uint8_t *)file->name, file->name_length, address) != 0)
+    {
+        return 1;
+    }
+    
+    file->dirty = 0;
+    norflash_fs_stats.commits++;
+    
+    return 0;
+}
+
+/**
+ * @brief   ڼ¼жȡļϢ
+ * @param   record: ¼ָ
+ * @param   stat: ļϢṹָ
+ * @retval  
+ */
+static void norflash_fs_stat_fill(uint8_t *record, norflash_fs_stat_t *stat)
+{
+    norflash_fs_record_header_t *header = (norflash_fs_record_header_t *)record;
+    norflash_fs_extent_t *extent = norflash_fs_record_extent(record);
+    uint16_t index;
+    
+    memcpy(stat->name, norflash_fs_record_name(record), header->name_length);
+    stat->name[header->name_length] = '\0';
+    stat->size = header->size;
+    stat->extent_count = header->extent_count;
+    stat->blocks = 0;
+    for (index = 0; index < header->extent_count; index++)
+    {
+        stat->blocks += extent[index].count;
+    }
+}
+
+/**
+ * @brief   ʽļϵͳ
+ * @note    ȫԪݿأݿڷʱʽжʱܱԭļ
+ * @param   
+ * @retval  ʽ
+ * @arg     0: ʽɹ
+ * @arg     1: ʽʧ
+ */
+uint8_t norflash_fs_format(void)
+{
+    norflash_bd_geometry_t geometry;
+    uint8_t block;
+    
+    norflash_fs_mounted = 0;
+    
+    norflash_bd_get_geometry(&geometry);
+    if (geometry.block_count <= NORFLASH_FS_META_BLOCKS)
+    {
+        return 1;
+    }
+    norflash_fs_block_size = geometry.block_size;
+    
+    for (block = 0; block < NORFLASH_FS_META_BLOCKS; block++)
+    {
+        if (norflash_fs_erase(block) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return norflash_fs_mount();
+}
+
+/**
+ * @brief   ļϵͳ
+ * @note    УԪݿͷŴӾɵطż¼ļٽݿλͼ
+ *          ǰдԪݿһЧ¼֮ǿʱʱджϣÿ׷
+ * @param   
+ * @retval  ؽ
+ * @arg     0: سɹ
+ * @arg     1: ʧܣ豸δʼβԪ𻵣
+ */
+uint8_t norflash_fs_mount(void)
+{
+    norflash_bd_geometry_t geometry;
+    norflash_fs_block_header_t header;
+    uint32_t sequence_last = 0;
+    uint32_t end;
+    uint8_t block;
+    uint8_t next;
+    uint8_t blank;
+    
+    norflash_fs_mounted = 0;
+    
+    norflash_bd_get_geometry(&geometry);
+    if ((geometry.block_count <= NORFLASH_FS_META_BLOCKS) || (geometry.block_count > NORFLASH_FS_BLOCK_MAX) ||
+        (geometry.block_count > 0x10000UL) || (geometry.block_size < (sizeof(norflash_fs_block_header_t) + NORFLASH_FS_RECORD_MAX)))
+    {
+        return 1;
+    }
+    norflash_fs_block_size = geometry.block_size;
+    norflash_fs_block_count = geometry.block_count;
+    
+    for (end = 0; end < NORFLASH_FS_FILE_MAX; end++)
+    {
+        norflash_fs_index[end].address = NORFLASH_FS_NONE;
+    }
+    for (end = 0; end < NORFLASH_FS_CACHE_NUM; end++)
+    {
+        norflash_fs_cache[end].address = NORFLASH_FS_NONE;
+    }
+    norflash_fs_buffer_address = NORFLASH_FS_NONE;
+    norflash_fs_files = 0;
+    norflash_fs_head = NORFLASH_FS_META_BLOCKS;
+    norflash_fs_head_offset = 0;
+    norflash_fs_sequence_max = 0;
+    memset(&norflash_fs_stats, 0, sizeof(norflash_fs_stats));
+    
+    for (block = 0; block < NORFLASH_FS_META_BLOCKS; block++)
+    {
+        norflash_fs_sequence[block] = 0;
+        norflash_fs_erased[block] = 0;
+        
+        if (norflash_fs_bd_read(block * norflash_fs_block_size, (uint8_t *)&header, sizeof(header)) != 0)
+        {
+            return 1;
+        }
+        
+        if ((header.magic == NORFLASH_FS_BLOCK_MAGIC) && (header.sequence != 0) && (header.state == NORFLASH_FS_BLOCK_VALID) &&
+            (header.crc == norflash_fs_crc32(0, (uint8_t *)&header, 3 * sizeof(uint32_t))))
+        {
+            if (header.block_count != norflash_fs_block_count)
+            {
+                return 1;
+            }
+            
+            norflash_fs_sequence[block] = header.sequence;
+            if (header.sequence > norflash_fs_sequence_max)
+            {
+                norflash_fs_sequence_max = header.sequence;
+            }
+        }
+    }
+    
+    /* ŴӾɵط */
+    while (1)
+    {
+        next = NORFLASH_FS_META_BLOCKS;
+        for (block = 0; block < NORFLASH_FS_META_BLOCKS; block++)
+        {
+            if ((norflash_fs_sequence[block] > sequence_last) && ((next == NORFLASH_FS_META_BLOCKS) || (norflash_fs_sequence[block] < norflash_fs_sequence[next])))
+            {
+                next = block;
+            }
+        }
+        if (next == NORFLASH_FS_META_BLOCKS)
+        {
+            break;
+        }
+        
+        if (norflash_fs_block_replay(next, &end) != 0)
+        {
+            return 1;
+        }
+        sequence_last = norflash_fs_sequence[next];
+        norflash_fs_head = next;
+        norflash_fs_head_offset = end;
+    }
+    
+    if ((norflash_fs_head != NORFLASH_FS_META_BLOCKS) && (norflash_fs_head_offset < norflash_fs_block_size))
+    {
+        if (norflash_fs_blank_check(norflash_fs_head * norflash_fs_block_size + norflash_fs_head_offset, norflash_fs_block_size - norflash_fs_head_offset, &blank) != 0)
+        {
+            return 1;
+        }
+        if (blank == 0)
+        {
+            norflash_fs_head_offset = norflash_fs_block_size;
+        }
+    }
+    
+    if (norflash_fs_bitmap_build() != 0)
+    {
+        return 1;
+    }
+    norflash_fs_cursor = NORFLASH_FS_META_BLOCKS + norflash_fs_sequence_max % (norflash_fs_block_count - NORFLASH_FS_META_BLOCKS);
+    
+    norflash_fs_mounted = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief   ļ
+ * @param   file: ļָ
+ * @param   name: ļַ1~NORFLASH_FS_NAME_MAX
+ * @param   flags: 򿪷ʽ
+ * @arg     NORFLASH_FS_O_READ: ļ
+ * @arg     NORFLASH_FS_O_WRITE: ½ضϺд룬رǰԭļֲ
+ * @arg     NORFLASH_FS_O_APPEND: ļĩβ׷ӣļʱ½
+ * @retval  򿪽
+ * @arg     0: 򿪳ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_fs_open(norflash_fs_file_t *file, const char *name, uint8_t flags)
+{
+    norflash_fs_record_header_t *header;
+    uint32_t slot;
+    uint32_t address;
+    uint32_t run;
+    uint32_t tail;
+    uint16_t index;
+    uint8_t *record;
+    uint8_t name_length;
+    uint8_t found;
+    uint8_t blank;
+    
+    file->flags = 0;
+    
+    name_length = norflash_fs_name_length(name);
+    if ((norflash_fs_mounted == 0) || (name_length == 0) ||
+        ((flags != NORFLASH_FS_O_READ) && (flags != NORFLASH_FS_O_WRITE) && (flags != NORFLASH_FS_O_APPEND)))
+    {
+        return 1;
+    }
+    
+    if (norflash_fs_index_find((const uint8_t *)name, name_length, &slot, &found) != 0)
+    {
+        return 1;
+    }
+    if ((found == 0) && (flags == NORFLASH_FS_O_READ))
+    {
+        return 1;
+    }
+    
+    memset(file, 0, sizeof(norflash_fs_file_t));
+    memcpy(file->name, name, name_length);
+    file->name_length = name_length;
+    file->dirty = (found == 0) ? 1 : 0;
+    
+    if (flags == NORFLASH_FS_O_WRITE)
+    {
+        file->dirty = 1;
+    }
+    else if (found != 0)
+    {
+        if (norflash_fs_record_load(norflash_fs_index[slot].address, &record) != 0)
+        {
+            return 1;
+        }
+        header = (norflash_fs_record_header_t *)record;
+        file->size = header->size;
+        file->extent_count = header->extent_count;
+        memcpy(file->extent, norflash_fs_record_extent(record), header->extent_count * sizeof(norflash_fs_extent_t));
+        for (index = 0; index < file->extent_count; index++)
+        {
+            file->blocks += file->extent[index].count;
+        }
+        if (file->size > (file->blocks * norflash_fs_block_size))
+        {
+            return 1;
+        }
+        
+        /* ׷дʱһļĩβ֮Ϊ */
+        tail = file->size % norflash_fs_block_size;
+        if ((flags == NORFLASH_FS_O_APPEND) && (tail != 0))
+        {
+            norflash_fs_locate(file, file->size, &address, &run);
+            if (norflash_fs_blank_check(address, norflash_fs_block_size - tail, &blank) != 0)
+            {
+                return 1;
+            }
+            if (blank == 0)
+            {
+                if (norflash_fs_tail_copy(file) != 0)
+                {
+                    return 1;
+                }
+                file->dirty = 1;
+            }
+        }
+        file->position = (flags == NORFLASH_FS_O_APPEND) ? file->size : 0;
+    }
+    
+    file->flags = flags;
+    
+    return 0;
+}
+
+/**
+ * @brief   ļ
+ * @note    СNORFLASH_FS_READ_AHEADĶԤֱӶû
+ * @param   file: ļָ루NORFLASH_FS_O_READ򿪣
+ * @param   data: ݻָ
+ * @param   length: 
+ * @param   count: ʵʶȣļĩβʱСlengthΪNULL
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_fs_read(norflash_fs_file_t *file, uint8_t *data, uint32_t length, uint32_t *count)
+{
+    uint32_t address;
+    uint32_t run;
+    uint32_t read_length;
+    uint32_t total;
+    
+    if (count != NULL)
+    {
+        *count = 0;
+    }
+    
+    if ((norflash_fs_mounted == 0) || (file->flags != NORFLASH_FS_O_READ))
+    {
+        return 1;
+    }
+    
+    if (length > (file->size - file->position))
+    {
+        length = file->size - file->position;
+    }
+    total = length;
+    
+    while (length != 0)
+    {
+        norflash_fs_locate(file, file->position, &address, &run);
+        if (run == 0)
+        {
+            return 1;
+        }
+        read_length = (length > run) ? run : length;
+        
+        if (read_length >= NORFLASH_FS_READ_AHEAD)
+        {
+            /* һζ */
+            if (norflash_fs_bd_read(address, data, read_length) != 0)
+            {
+                return 1;
+            }
+            norflash_fs_stats.direct_reads++;
+        }
+        else
+        {
+            if ((norflash_fs_buffer_address == NORFLASH_FS_NONE) || (address < norflash_fs_buffer_address) ||
+                (address >= (norflash_fs_buffer_address + norflash_fs_buffer_length)))
+            {
+                /* ӵǰλڵżַԤĩβַ볤Ȳֶ */
+                norflash_fs_buffer_length = run + (address & 1UL);
+                if (norflash_fs_buffer_length > sizeof(norflash_fs_buffer))
+                {
+                    norflash_fs_buffer_length = sizeof(norflash_fs_buffer);
+                }
+                norflash_fs_buffer_address = NORFLASH_FS_NONE;
+                if (norflash_fs_bd_read(address & ~1UL, norflash_fs_buffer, norflash_fs_buffer_length) != 0)
+                {
+                    return 1;
+                }
+                norflash_fs_buffer_address = address & ~1UL;
+                norflash_fs_stats.read_ahead_fills++;
+            }
+            else
+            {
+                norflash_fs_stats.read_ahead_hits++;
+            }
+            
+            if (read_length > (norflash_fs_buffer_address + norflash_fs_buffer_length - address))
+            {
+                read_length = norflash_fs_buffer_address + norflash_fs_buffer_length - address;
+            }
+            memcpy(data, &norflash_fs_buffer[address - norflash_fs_buffer_address], read_length);
+        }
+        
+        file->position += read_length;
+        data += read_length;
+        length -= read_length;
+    }
+    
+    if (count != NULL)
+    {
+        *count = total;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   дļ
+ * @note    ļĩβ˳д룬ݿ鲻ʱ¿飻ύǰʱļԭ
+ * @param   file: ļָ루NORFLASH_FS_O_WRITENORFLASH_FS_O_APPEND򿪣
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  д
+ * @arg     0: дɹ
+ * @arg     1: дʧܣ޿пʱļдĳȣ
+ */
+uint8_t norflash_fs_write(norflash_fs_file_t *file, const uint8_t *data, uint32_t length)
+{
+    uint32_t block;
+    uint32_t offset;
+    uint32_t write_length;
+    
+    if ((norflash_fs_mounted == 0) || ((file->flags != NORFLASH_FS_O_WRITE) && (file->flags != NORFLASH_FS_O_APPEND)))
+    {
+        return 1;
+    }
+    
+    while (length != 0)
+    {
+        if (file->size == (file->blocks * norflash_fs_block_size))
+        {
+            if (norflash_fs_block_alloc((file->extent_count != 0) ? (norflash_fs_last_block(file) + 1) : NORFLASH_FS_NONE, &block) != 0)
+            {
+                return 1;
+            }
+            if (norflash_fs_extent_add(file, block) != 0)
+            {
+                norflash_fs_block_mark(block, 0);
+                return 1;
+            }
+        }
+        
+        block = norflash_fs_last_block(file);
+        offset = file->size % norflash_fs_block_size;
+        write_length = norflash_fs_block_size - offset;
+        if (write_length > length)
+        {
+            write_length = length;
+        }
+        
+        if (norflash_fs_prog(block * norflash_fs_block_size + offset, data, write_length) != 0)
+        {
+            return 1;
+        }
+        
+        file->size += write_length;
+        file->position = file->size;
+        file->dirty = 1;
+        data += write_length;
+        length -= write_length;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   öλ
+ * @param   file: ļָ루NORFLASH_FS_O_READ򿪣
+ * @param   position: λãļȣ
+ * @retval  ý
+ * @arg     0: óɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_fs_seek(norflash_fs_file_t *file, uint32_t position)
+{
+    if ((file->flags != NORFLASH_FS_O_READ) || (position > file->size))
+    {
+        return 1;
+    }
+    
+    file->position = position;
+    
+    return 0;
+}
+
+/**
+ * @brief   ύд
+ * @note    ύļִ򿪣ɼд
+ * @param   file: ļָ
+ * @retval  ύ
+ * @arg     0: ύɹ
+ * @arg     1: ύʧ
+ */
+uint8_t norflash_fs_sync(norflash_fs_file_t *file)
+{
+    if ((norflash_fs_mounted == 0) || (file->flags == 0))
+    {
+        return 1;
+    }
+    
+    if ((file->flags == NORFLASH_FS_O_READ) || (file->dirty == 0))
+    {
+        return 0;
+    }
+    
+    return norflash_fs_commit(file);
+}
+
+/**
+ * @brief   رļ
+ * @note    δύдʱύύʧʱļԭݣηݿ¹غ
+ * @param   file: ļָ
+ * @retval  رս
+ * @arg     0: رճɹ
+ * @arg     1: ύʧ
+ */
+uint8_t norflash_fs_close(norflash_fs_file_t *file)
+{
+    uint8_t res;
+    
+    res = norflash_fs_sync(file);
+    file->flags = 0;
+    
+    return res;
+}
+
+/**
+ * @brief   ɾļ
+ * @param   name: ļ
+ * @retval  ɾ
+ * @arg     0: ɾɹ
+ * @arg     1: ɾʧܣļڣ
+ */
+uint8_t norflash_fs_remove(const char *name)
+{
+    norflash_fs_record_header_t header;
+    uint32_t slot;
+    uint32_t size;
+    uint32_t address;
+    uint8_t name_length;
+    uint8_t found;
+    
+    name_length = norflash_fs_name_length(name);
+    if ((norflash_fs_mounted == 0) || (name_length == 0))
+    {
+        return 1;
+    }
+    
+    if ((norflash_fs_index_find((const uint8_t *)name, name_length, &slot, &found) != 0) || (found == 0))
+    {
+        return 1;
+    }
+    
+    header.name_length = name_length;
+    header.extent_count = 0;
+    size = norflash_fs_record_size(&header);
+    if (norflash_fs_make_room(size) != 0)
+    {
+        return 1;
+    }
+    
+    norflash_fs_record_build(name, name_length, NULL);
+    if (norflash_fs_append(size, &address) != 0)
+    {
+        return 1;
+    }
+    if (norflash_bd_sync() != 0)
+    {
+        return 1;
+    }
+    
+    if (norflash_fs_release(norflash_fs_index[slot].address, NULL) != 0)
+    {
+        return 1;
+    }
+    norflash_fs_index_remove(slot);
+    norflash_fs_stats.commits++;
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡļϢ
+ * @param   name: ļ
+ * @param   stat: ļϢṹָ
+ * @retval  ȡ
+ * @arg     0: ȡɹ
+ * @arg     1: ȡʧܣļڣ
+ */
+uint8_t norflash_fs_stat(const char *name, norflash_fs_stat_t *stat)
+{
+    uint32_t slot;
+    uint8_t *record;
+    uint8_t name_length;
+    uint8_t found;
+    
+    name_length = norflash_fs_name_length(name);
+    if ((norflash_fs_mounted == 0) || (name_length == 0))
+    {
+        return 1;
+    }
+    
+    if ((norflash_fs_index_find((const uint8_t *)name, name_length, &slot, &found) != 0) || (found == 0))
+    {
+        return 1;
+    }
+    
+    if (norflash_fs_record_load(norflash_fs_index[slot].address, &record) != 0)
+    {
+        return 1;
+    }
+    norflash_fs_stat_fill(record, stat);
+    
+    return 0;
+}
+
+/**
+ * @brief   ļ
+ * @note    ˳Ϊ˳򣻱ڼ½ɾļʱ©ظ
+ * @param   cursor: λã״εǰ0
+ * @param   stat: ļϢṹָ
+ * @param   found: 1: ȡһļ; 0: 
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_fs_dir_read(uint32_t *cursor, norflash_fs_stat_t *stat, uint8_t *found)
+{
+    uint8_t *record;
+    
+    *found = 0;
+    if (norflash_fs_mounted == 0)
+    {
+        return 1;
+    }
+    
+    while (*cursor < NORFLASH_FS_FILE_MAX)
+    {
+        if (norflash_fs_index[*cursor].address != NORFLASH_FS_NONE)
+        {
+            if (norflash_fs_record_load(norflash_fs_index[*cursor].address, &record) != 0)
+            {
+                return 1;
+            }
+            norflash_fs_stat_fill(record, stat);
+            (*cursor)++;
+            *found = 1;
+            return 0;
+        }
+        (*cursor)++;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡļϵͳͳ
+ * @param   stats: ͳƽṹָ
+ * @retval  
+ */
+void norflash_fs_get_stats(norflash_fs_stats_t *stats)
+{
+    *stats = norflash_fs_stats;
+    stats->files = norflash_fs_files;
+    stats->free_blocks = norflash_fs_free_blocks;
+    stats->meta_free = norflash_fs_meta_free();
+    stats->sequence = norflash_fs_sequence_max;
+}
@@ -0,0 +1,115 @@
+/**
+ ****************************************************************************************************
+ * @file        norflash_fs.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       NOR Flash 簲ȫļϵͳ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ļϵͳλNORFLASH_FS_ADDRESSNORFLASH_FS_SIZEֽڣ豸norflash_bd.hʣ
+ * ڱֿ⡢ͼƬ־ԴԴɵдӦó
+ * ǰNORFLASH_FS_META_BLOCKSΪԪ־ļڵΣΪݿ
+ * дļnorflash_fs_close()norflash_fs_sync()ύʱЧύǰ籣ԭ
+ * ļֻ˳д루½/ضϻ׷ӣⶨλͬһļͬʱֻһд
+ * ļдɾ֮ǰ򿪵ĶЧ
+ * ǰȵnorflash_bd_init()norflash_fs_mount()ʱNOR Flashܴڴӳģʽ
+ * ڴӳеӦónorflash_memory_mapped_suspend()/norflash_memory_mapped_resume()Χʣڼжϣ
+ * ģ顢豸õmemcpy/memset/memcmp/strlenλ.sctļER_ITCM
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __NORFLASH_FS_H
+#define __NORFLASH_FS_H
+
+#include "norflash_bd.h"
+
+/* NOR Flashļϵͳ壨λӦó۵ǰ벿֮󣬼boot_slot.h */
+#define NORFLASH_FS_ADDRESS         (0x00800000UL)
+#define NORFLASH_FS_SIZE            (0x00800000UL)
+
+/* NOR FlashļϵͳԪݿ */
+#define NORFLASH_FS_META_BLOCKS     (8)
+
+/* NOR Flashļϵͳļ壨Ϊ2ݣɱNORFLASH_FS_FILE_MAX - 1ļ */
+#define NORFLASH_FS_FILE_MAX        (128)
+
+/* NOR Flashļϵͳļ󳤶ȶ */
+#define NORFLASH_FS_NAME_MAX        (48)
+
+/* NOR Flashļϵͳÿļ */
+#define NORFLASH_FS_EXTENT_MAX      (16)
+
+/* NOR FlashļϵͳԪݻ¼ */
+#define NORFLASH_FS_CACHE_NUM       (4)
+
+/* NOR FlashļϵͳԤС壨Сڴ˳ȵĶֱӶû */
+#define NORFLASH_FS_READ_AHEAD      (0x00000800UL)
+
+/* NOR Flashļϵͳ */
+#define NORFLASH_FS_BLOCK_MAX       (NORFLASH_FS_SIZE / NORFLASH_SECTOR_BUFFER_SIZE)
+
+/* NOR Flashļ򿪷ʽ */
+#define NORFLASH_FS_O_READ          (1U << 0)   /*  */
+#define NORFLASH_FS_O_WRITE         (1U << 1)   /* ½ضϺд룬رʱ滻ԭļ */
+#define NORFLASH_FS_O_APPEND        (1U << 2)   /* ļĩβ׷ӣļʱ½ */
+
+/* NOR Flashļݿζ */
+typedef struct {
+    uint16_t start;         /* ʼ */
+    uint16_t count;         /*  */
+} norflash_fs_extent_t;
+
+/* NOR Flashļ */
+typedef struct {
+    uint32_t size;          /* ļ */
+    uint32_t position;      /* дλ */
+    uint32_t blocks;        /* ѷ */
+    uint16_t extent_count;  /*  */
+    uint8_t flags;          /* 򿪷ʽ0ʾδ */
+    uint8_t name_length;    /* ļ */
+    uint8_t dirty;          /* δύд */
+    norflash_fs_extent_t extent[NORFLASH_FS_EXTENT_MAX];
+    char name[NORFLASH_FS_NAME_MAX + 1];
+} norflash_fs_file_t;
+
+/* NOR FlashļϢ */
+typedef struct {
+    char name[NORFLASH_FS_NAME_MAX + 1];    /* ļ */
+    uint32_t size;          /* ļ */
+    uint32_t blocks;        /* ռÿ */
+    uint16_t extent_count;  /*  */
+} norflash_fs_stat_t;
+
+/* NOR Flashļϵͳͳƶ */
+typedef struct {
+    uint32_t files;             /* ļ */
+    uint32_t free_blocks;       /* ݿ */
+    uint32_t meta_free;         /* Ԫݿ */
+    uint32_t sequence;          /* ǰԪݿ */
+    uint32_t commits;           /* ύ */
+    uint32_t compactions;       /* Ԫݿ */
+    uint32_t block_erases;      /* ݿʱĲ */
+    uint32_t cache_hits;        /* Ԫݻд */
+    uint32_t cache_misses;      /* Ԫݻδд */
+    uint32_t read_ahead_hits;   /* Ԥд */
+    uint32_t read_ahead_fills;  /* Ԥ */
+    uint32_t direct_reads;      /* ֱӶû */
+} norflash_fs_stats_t;
+
+/*  */
+uint8_t norflash_fs_format(void);                                                   /* ʽļϵͳ */
+uint8_t norflash_fs_mount(void);                                                    /* ļϵͳ */
+uint8_t norflash_fs_open(norflash_fs_file_t *file, const char *name, uint8_t flags);            /* ļ */
+uint8_t norflash_fs_read(norflash_fs_file_t *file, uint8_t *data, uint32_t length, uint32_t *count);    /* ļ */
+uint8_t norflash_fs_write(norflash_fs_file_t *file, const uint8_t *data, uint32_t length);     /* дļ */
+uint8_t norflash_fs_seek(norflash_fs_file_t *file, uint32_t position);              /* öλ */
+uint8_t norflash_fs_sync(norflash_fs_file_t *file);                                 /* ύд */
+uint8_t norflash_fs_close(norflash_fs_file_t *file);                                /* رļ */
+uint8_t norflash_fs_remove(const char *name);                                       /* ɾļ */
+uint8_t norflash_fs_stat(const char *name, norflash_fs_stat_t *stat);               /* ȡļϢ */
+uint8_t norflash_fs_dir_read(uint32_t *cursor, norflash_fs_stat_t *stat, uint8_t *found);      /* ļ */
+void norflash_fs_get_stats(norflash_fs_stats_t *stats);                             /* ȡļϵͳͳ */
+
+#endif /* __NORFLASH_FS_H */
@@ -0,0 +1,1104 @@
+/**
+ ****************************************************************************************************
+ * @file        norflash_kv.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       NOR Flash ־ṹֵ洢
+ ****************************************************************************************************
+ * @attention
+ *
+ * ÿͷʶšCRC״̬ʼ׷Ӽ¼¼ͷֵ4ֽڶ룩
+ * ¼ͷеCRCǼ¼ͷֵͬһŸƫƸļ¼Ϊ׼
+ * ʱŴӾɵطŸCRCļ¼ʱджϣĿռ䲻ʹ
+ * ʱЧļ¼ƵǰдȽ״̬Ϊ0ٲ
+ * жϵ´ιʱطţɾֻڱθеļ¼
+ * ʱֱӶ
+ *
+ ****************************************************************************************************
+ */
+
+#include "norflash_kv.h"
+#include <string.h>
+
+#if (NORFLASH_KV_SECTOR_NUM < 3)
+#error "NORFLASH_KV_SECTOR_NUM must be at least 3"
+#endif
+
+#if ((NORFLASH_KV_INDEX_SIZE & (NORFLASH_KV_INDEX_SIZE - 1)) != 0)
+#error "NORFLASH_KV_INDEX_SIZE must be a power of 2"
+#endif
+
+/* ͷ¼ͷʶ */
+#define NORFLASH_KV_SECTOR_MAGIC    (0x53564B4EUL)
+#define NORFLASH_KV_RECORD_MAGIC    (0x564BU)
+
+/* ״̬壨Ϊȫ1ǰΪ0 */
+#define NORFLASH_KV_SECTOR_VALID    (0xFFFFFFFFUL)
+#define NORFLASH_KV_SECTOR_OBSOLETE (0x00000000UL)
+
+/* ¼־ */
+#define NORFLASH_KV_FLAG_VALUE      (0xFFU)
+#define NORFLASH_KV_FLAG_DELETE     (0x00U)
+
+/* ʱʹõı */
+#define NORFLASH_KV_RESERVE_SECTORS (1)
+
+/* ַ */
+#define NORFLASH_KV_INDEX_EMPTY     (0xFFFFFFFFUL)
+
+/* ¼루˫洢ģʽ¶дĵַ볤Ϊż */
+#define NORFLASH_KV_ALIGN(x)        (((x) + 3UL) & ~3UL)
+
+/* NOR Flashֵ洢ͷ */
+typedef struct {
+    uint32_t magic;         /* ʶ */
+    uint32_t sequence;      /* ţ1 */
+    uint32_t crc;           /* ʶŵCRC32 */
+    uint32_t state;         /* ״̬ */
+} norflash_kv_sector_header_t;
+
+/* NOR Flashֵ洢¼ͷ */
+typedef struct {
+    uint16_t magic;         /* ʶ */
+    uint8_t key_length;     /*  */
+    uint8_t flags;          /* ־ */
+    uint16_t value_length;  /* ֵ */
+    uint16_t reserved;      /*  */
+    uint32_t crc;           /* ¼ͷcrcֵCRC32 */
+} norflash_kv_record_header_t;
+
+/* NOR Flashֵ洢 */
+typedef struct {
+    uint32_t hash;          /* Ĺϣֵ */
+    uint32_t address;       /* ¼¼ַ */
+} norflash_kv_index_t;
+
+/* NOR Flashֵ洢 */
+static norflash_kv_index_t norflash_kv_index[NORFLASH_KV_INDEX_SIZE];
+static uint32_t norflash_kv_sequence[NORFLASH_KV_SECTOR_NUM];   /* ţ0ʾ */
+static uint8_t norflash_kv_erased[NORFLASH_KV_SECTOR_NUM];      /* ȷΪ */
+static uint8_t norflash_kv_record[NORFLASH_KV_ALIGN(sizeof(norflash_kv_record_header_t) + NORFLASH_KV_KEY_MAX + NORFLASH_KV_VALUE_MAX)];
+static uint8_t norflash_kv_mounted = 0;
+static uint8_t norflash_kv_head = NORFLASH_KV_SECTOR_NUM;       /* ǰд */
+static uint32_t norflash_kv_head_offset = 0;                    /* ǰддƫ */
+static uint32_t norflash_kv_sequence_max = 0;
+static uint32_t norflash_kv_sector_size = 0;
+static uint32_t norflash_kv_keys = 0;
+static uint32_t norflash_kv_appends = 0;
+static uint32_t norflash_kv_compactions = 0;
+
+/**
+ * @brief   CRC32
+ * @param   crc: CRCֵ״μ㴫0
+ * @param   data: ָ
+ * @param   length: ݳ
+ * @retval  CRC32
+ */
+static uint32_t norflash_kv_crc32(uint32_t crc, const uint8_t *data, uint32_t length)
+{
+    uint8_t bit;
+    
+    crc = ~crc;
+    while (length != 0)
+    {
+        crc ^= *data++;
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+        }
+        length--;
+    }
+    
+    return ~crc;
+}
+
+/**
+ * @brief   ĹϣֵFNV-1a
+ * @param   key: 
+ * @param   key_length: 
+ * @retval  ϣֵ
+ */
+static uint32_t norflash_kv_hash(const uint8_t *key, uint8_t key_length)
+{
+    uint32_t hash = 0x811C9DC5UL;
+    
+    while (key_length != 0)
+    {
+        hash ^= *key++;
+        hash *= 0x01000193UL;
+        key_length--;
+    }
+    
+    return hash;
+}
+
+/**
+ * @brief   ȡַ
+ * @param   sector: 
+ * @retval  ַ
+ */
+static uint32_t norflash_kv_sector_address(uint8_t sector)
+{
+    return NORFLASH_KV_ADDRESS + sector * norflash_kv_sector_size;
+}
+
+/**
+ * @brief   ȡ¼ռó
+ * @param   header: ¼ͷָ
+ * @retval  ¼ռó
+ */
+static uint32_t norflash_kv_record_size(norflash_kv_record_header_t *header)
+{
+    return NORFLASH_KV_ALIGN(sizeof(norflash_kv_record_header_t) + header->key_length + header->value_length);
+}
+
+/**
+ * @brief   ҳ
+ * @param   address: ַ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  ̽
+ * @arg     0: ̳ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_kv_program(uint32_t address, uint8_t *data, uint32_t length)
+{
+    uint32_t page_size;
+    uint32_t page_length;
+    
+    page_size = norflash_get_page_size();
+    while (length != 0)
+    {
+        page_length = page_size - (address & (page_size - 1));
+        if (page_length > length)
+        {
+            page_length = length;
+        }
+        
+        if (norflash_program_page(address, data, page_length) != 0)
+        {
+            return 1;
+        }
+        
+        address += page_length;
+        data += page_length;
+        length -= page_length;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   
+ * @param   address: ַ
+ * @param   length: 
+ * @param   blank: ս1: Ϊ; 0: ǿգ
+ * @retval  ս
+ * @arg     0: ճɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_kv_blank_check(uint32_t address, uint32_t length, uint8_t *blank)
+{
+    uint32_t read_length;
+    uint32_t index;
+    uint8_t empty_value;
+    
+    empty_value = norflash_get_empty_value();
+    while (length != 0)
+    {
+        read_length = (length > sizeof(norflash_kv_record)) ? sizeof(norflash_kv_record) : length;
+        if (norflash_read(address, norflash_kv_record, read_length) != 0)
+        {
+            return 1;
+        }
+        
+        for (index = 0; index < read_length; index++)
+        {
+            if (norflash_kv_record[index] != empty_value)
+            {
+                *blank = 0;
+                return 0;
+            }
+        }
+        
+        address += read_length;
+        length -= read_length;
+    }
+    
+    *blank = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief   Ƚϼ¼ļ
+ * @param   address: ¼ַ
+ * @param   key: 
+ * @param   key_length: 
+ * @param   match: ȽϽ1: ͬ; 0: ͬ
+ * @retval  ȽϽ
+ * @arg     0: Ƚϳɹ
+ * @arg     1: Ƚʧ
+ */
+static uint8_t norflash_kv_key_match(uint32_t address, const uint8_t *key, uint8_t key_length, uint8_t *match)
+{
+    uint8_t buffer[NORFLASH_KV_ALIGN(sizeof(norflash_kv_record_header_t) + NORFLASH_KV_KEY_MAX)];
+    norflash_kv_record_header_t *header = (norflash_kv_record_header_t *)buffer;
+    
+    if (norflash_read(address, buffer, NORFLASH_KV_ALIGN(sizeof(norflash_kv_record_header_t) + key_length)) != 0)
+    {
+        return 1;
+    }
+    
+    *match = ((header->key_length == key_length) && (memcmp(&buffer[sizeof(norflash_kv_record_header_t)], key, key_length) == 0)) ? 1 : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief   вҼ
+ * @note    ̽⣬ϣֵͬʱ¼Ƚϼ
+ * @param   key: 
+ * @param   key_length: 
+ * @param   hash: Ĺϣֵ
+ * @param   slot: ҵʱΪδҵʱΪɲĿ
+ * @param   found: ҽ1: ҵ; 0: δҵ
+ * @retval  ҽ
+ * @arg     0: ҳɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_kv_index_find(const uint8_t *key, uint8_t key_length, uint32_t hash, uint32_t *slot, uint8_t *found)
+{
+    uint32_t probe;
+    uint32_t index;
+    uint8_t match;
+    
+    for (probe = 0; probe < NORFLASH_KV_INDEX_SIZE; probe++)
+    {
+        index = (hash + probe) & (NORFLASH_KV_INDEX_SIZE - 1);
+        if (norflash_kv_index[index].address == NORFLASH_KV_INDEX_EMPTY)
+        {
+            *slot = index;
+            *found = 0;
+            return 0;
+        }
+        
+        if (norflash_kv_index[index].hash == hash)
+        {
+            if (norflash_kv_key_match(norflash_kv_index[index].address, key, key_length, &match) != 0)
+            {
+                return 1;
+            }
+            if (match != 0)
+            {
+                *slot = index;
+                *found = 1;
+                return 0;
+            }
+        }
+    }
+    
+    *slot = NORFLASH_KV_INDEX_SIZE;
+    *found = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief   ɾ
+ * @note    ɾ̽
+ * @param   slot: 
+ * @retval  
+ */
+static void norflash_kv_index_remove(uint32_t slot)
+{
+    uint32_t next = slot;
+    uint32_t home;
+    
+    norflash_kv_index[slot].address = NORFLASH_KV_INDEX_EMPTY;
+    while (1)
+    {
+        next = (next + 1) & (NORFLASH_KV_INDEX_SIZE - 1);
+        if (norflash_kv_index[next].address == NORFLASH_KV_INDEX_EMPTY)
+        {
+            break;
+        }
+        
+        /* λλڸ̽ʱǰƸ */
+        home = norflash_kv_index[next].hash & (NORFLASH_KV_INDEX_SIZE - 1);
+        if (((next - home) & (NORFLASH_KV_INDEX_SIZE - 1)) >= ((next - slot) & (NORFLASH_KV_INDEX_SIZE - 1)))
+        {
+            norflash_kv_index[slot] = norflash_kv_index[next];
+            norflash_kv_index[next].address = NORFLASH_KV_INDEX_EMPTY;
+            slot = next;
+        }
+    }
+    
+    norflash_kv_keys--;
+}
+
+/**
+ * @brief   ¼
+ * @param   key: 
+ * @param   key_length: 
+ * @param   address: ¼ַ
+ * @param   remove: ǷΪɾ
+ * @retval  ½
+ * @arg     0: ³ɹ
+ * @arg     1: ʧܣʧܻ
+ */
+static uint8_t norflash_kv_index_update(const uint8_t *key, uint8_t key_length, uint32_t address, uint8_t remove)
+{
+    uint32_t hash;
+    uint32_t slot;
+    uint8_t found;
+    
+    hash = norflash_kv_hash(key, key_length);
+    if (norflash_kv_index_find(key, key_length, hash, &slot, &found) != 0)
+    {
+        return 1;
+    }
+    
+    if (remove != 0)
+    {
+        if (found != 0)
+        {
+            norflash_kv_index_remove(slot);
+        }
+        return 0;
+    }
+    
+    if (found != 0)
+    {
+        norflash_kv_index[slot].address = address;
+        return 0;
+    }
+    
+    /* һʹ̽ܽ */
+    if ((slot == NORFLASH_KV_INDEX_SIZE) || (norflash_kv_keys >= (NORFLASH_KV_INDEX_SIZE - 1)))
+    {
+        return 1;
+    }
+    
+    norflash_kv_index[slot].hash = hash;
+    norflash_kv_index[slot].address = address;
+    norflash_kv_keys++;
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡ
+ * @param   
+ * @retval  
+ */
+static uint8_t norflash_kv_free_sectors(void)
+{
+    uint8_t sector;
+    uint8_t count = 0;
+    
+    for (sector = 0; sector < NORFLASH_KV_SECTOR_NUM; sector++)
+    {
+        if (norflash_kv_sequence[sector] == 0)
+        {
+            count++;
+        }
+    }
+    
+    return count;
+}
+
+/**
+ * @brief   ÿΪǰд
+ * @note    ǿʱȲдŵͷ
+ * @param   
+ * @retval  ý
+ * @arg     0: óɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_kv_sector_open(void)
+{
+    norflash_kv_sector_header_t header;
+    uint8_t sector;
+    uint8_t blank;
+    
+    for (sector = 0; sector < NORFLASH_KV_SECTOR_NUM; sector++)
+    {
+        if (norflash_kv_sequence[sector] == 0)
+        {
+            break;
+        }
+    }
+    if (sector == NORFLASH_KV_SECTOR_NUM)
+    {
+        return 1;
+    }
+    
+    if (norflash_kv_erased[sector] == 0)
+    {
+        if (norflash_kv_blank_check(norflash_kv_sector_address(sector), norflash_kv_sector_size, &blank) != 0)
+        {
+            return 1;
+        }
+        if (blank == 0)
+        {
+            if (norflash_erase_sector(norflash_kv_sector_address(sector)) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+    norflash_kv_erased[sector] = 0;
+    
+    /* ״ֱֲֵ̬ */
+    header.magic = NORFLASH_KV_SECTOR_MAGIC;
+    header.sequence = norflash_kv_sequence_max + 1;
+    header.crc = norflash_kv_crc32(0, (uint8_t *)&header, 2 * sizeof(uint32_t));
+    if (norflash_kv_program(norflash_kv_sector_address(sector), (uint8_t *)&header, 3 * sizeof(uint32_t)) != 0)
+    {
+        return 1;
+    }
+    
+    norflash_kv_sequence_max = header.sequence;
+    norflash_kv_sequence[sector] = header.sequence;
+    norflash_kv_head = sector;
+    norflash_kv_head_offset = sizeof(norflash_kv_sector_header_t);
+    
+    return 0;
+}
+
+/**
+ * @brief   ȷǰд㹻ռ
+ * @note    ռ䲻ʱʹñջḲǼ¼װ¼ǰ
+ * @param   size: ¼ռó
+ * @retval  ׼
+ * @arg     0: ׼ɹ
+ * @arg     1: ׼ʧ
+ */
+static uint8_t norflash_kv_head_prepare(uint32_t size)
+{
+    if ((norflash_kv_head == NORFLASH_KV_SECTOR_NUM) || ((norflash_kv_head_offset + size) > norflash_kv_sector_size))
+    {
+        return norflash_kv_sector_open();
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ׷Ӽ¼еļ¼
+ * @note    ȵnorflash_kv_head_prepare()
+ * @param   size: ¼ռó
+ * @param   address: ¼ַ
+ * @retval  ׷ӽ
+ * @arg     0: ׷ӳɹ
+ * @arg     1: ׷ʧ
+ */
+static uint8_t norflash_kv_append(uint32_t size, uint32_t *address)
+{
+    if ((norflash_kv_head == NORFLASH_KV_SECTOR_NUM) || ((norflash_kv_head_offset + size) > norflash_kv_sector_size))
+    {
+        return 1;
+    }
+    
+    *address = norflash_kv_sector_address(norflash_kv_head) + norflash_kv_head_offset;
+    if (norflash_kv_program(*address, norflash_kv_record, size) != 0)
+    {
+        /* дʧܵʹ */
+        norflash_kv_head_offset = norflash_kv_sector_size;
+        return 1;
+    }
+    
+    norflash_kv_head_offset += size;
+    norflash_kv_appends++;
+    
+    return 0;
+}
+
+/**
+ * @brief   
+ * @note    ָļ¼Ƶǰдϲ
+ * @param   
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧܣ޿ռ䲻㣩
+ */
+static uint8_t norflash_kv_compact_sector(void)
+{
+    norflash_kv_record_header_t *header = (norflash_kv_record_header_t *)norflash_kv_record;
+    uint32_t sector_address;
+    uint32_t slot;
+    uint32_t size;
+    uint32_t address;
+    uint32_t state = NORFLASH_KV_SECTOR_OBSOLETE;
+    uint8_t sector;
+    uint8_t victim = NORFLASH_KV_SECTOR_NUM;
+    
+    for (sector = 0; sector < NORFLASH_KV_SECTOR_NUM; sector++)
+    {
+        if ((norflash_kv_sequence[sector] == 0) || (sector == norflash_kv_head))
+        {
+            continue;
+        }
+        if ((victim == NORFLASH_KV_SECTOR_NUM) || (norflash_kv_sequence[sector] < norflash_kv_sequence[victim]))
+        {
+            victim = sector;
+        }
+    }
+    if (victim == NORFLASH_KV_SECTOR_NUM)
+    {
+        return 1;
+    }
+    
+    sector_address = norflash_kv_sector_address(victim);
+    for (slot = 0; slot < NORFLASH_KV_INDEX_SIZE; slot++)
+    {
+        address = norflash_kv_index[slot].address;
+        if ((address == NORFLASH_KV_INDEX_EMPTY) || (address < sector_address) || (address >= (sector_address + norflash_kv_sector_size)))
+        {
+            continue;
+        }
+        
+        if (norflash_read(address, norflash_kv_record, sizeof(norflash_kv_record_header_t)) != 0)
+        {
+            return 1;
+        }
+        size = norflash_kv_record_size(header);
+        if (norflash_kv_head_prepare(size) != 0)
+        {
+            return 1;
+        }
+        if (norflash_read(address, norflash_kv_record, size) != 0)
+        {
+            return 1;
+        }
+        
+        if (norflash_kv_append(size, &address) != 0)
+        {
+            return 1;
+        }
+        norflash_kv_index[slot].address = address;
+    }
+    
+    /* ٲжʱᱻط */
+    if (norflash_kv_program(sector_address + 3 * sizeof(uint32_t), (uint8_t *)&state, sizeof(state)) != 0)
+    {
+        return 1;
+    }
+    norflash_kv_sequence[victim] = 0;
+    
+    if (norflash_erase_sector(sector_address) != 0)
+    {
+        return 1;
+    }
+    norflash_kv_erased[victim] = 1;
+    norflash_kv_compactions++;
+    
+    return 0;
+}
+
+/**
+ * @brief   Ϊ׷Ӽ¼׼ռ
+ * @note    ǰдռ䲻ҿڱʱȷǰд㹻ռ
+ * @param   size: ¼ռó
+ * @retval  ׼
+ * @arg     0: ׼ɹ
+ * @arg     1: ռ䲻
+ */
+static uint8_t norflash_kv_make_room(uint32_t size)
+{
+    uint8_t count = 0;
+    
+    while (((norflash_kv_head == NORFLASH_KV_SECTOR_NUM) || ((norflash_kv_head_offset + size) > norflash_kv_sector_size)) && (norflash_kv_free_sectors() <= NORFLASH_KV_RESERVE_SECTORS))
+    {
+        /* Чռȫʱ޷ڳռ */
+        if (count++ >= NORFLASH_KV_SECTOR_NUM)
+        {
+            return 1;
+        }
+        
+        if (norflash_kv_compact_sector() != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return norflash_kv_head_prepare(size);
+}
+
+/**
+ * @brief   ڼ¼װ¼
+ * @param   key: 
+ * @param   key_length: 
+ * @param   value: ֵ
+ * @param   value_length: ֵ
+ * @param   flags: ¼־
+ * @retval  ¼ռó
+ */
+static uint32_t norflash_kv_record_build(const char *key, uint8_t key_length, uint8_t *value, uint16_t value_length, uint8_t flags)
+{
+    norflash_kv_record_header_t *header = (norflash_kv_record_header_t *)norflash_kv_record;
+    uint32_t size;
+    
+    header->magic = NORFLASH_KV_RECORD_MAGIC;
+    header->key_length = key_length;
+    header->flags = flags;
+    header->value_length = value_length;
+    header->reserved = 0xFFFF;
+    size = norflash_kv_record_size(header);
+    
+    memcpy(&norflash_kv_record[sizeof(norflash_kv_record_header_t)], key, key_length);
+    if (value_length != 0)
+    {
+        memcpy(&norflash_kv_record[sizeof(norflash_kv_record_header_t) + key_length], value, value_length);
+    }
+    memset(&norflash_kv_record[sizeof(norflash_kv_record_header_t) + key_length + value_length], 0xFF, size - (sizeof(norflash_kv_record_header_t) + key_length + value_length));
+    
+    header->crc = norflash_kv_crc32(0, norflash_kv_record, sizeof(norflash_kv_record_header_t) - sizeof(uint32_t));
+    header->crc = norflash_kv_crc32(header->crc, &norflash_kv_record[sizeof(norflash_kv_record_header_t)], key_length + value_length);
+    
+    return size;
+}
+
+/**
+ * @brief   طеļ¼
+ * @param   sector: 
+ * @param   end: Ч¼ƫƣ𻵼¼ʱΪС
+ * @retval  طŽ
+ * @arg     0: طųɹ
+ * @arg     1: طʧܣʧܻ
+ */
+static uint8_t norflash_kv_sector_replay(uint8_t sector, uint32_t *end)
+{
+    norflash_kv_record_header_t *header = (norflash_kv_record_header_t *)norflash_kv_record;
+    uint32_t sector_address;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t crc;
+    uint32_t index;
+    uint8_t empty_value;
+    
+    empty_value = norflash_get_empty_value();
+    sector_address = norflash_kv_sector_address(sector);
+    offset = sizeof(norflash_kv_sector_header_t);
+    while ((offset + sizeof(norflash_kv_record_header_t)) <= norflash_kv_sector_size)
+    {
+        if (norflash_read(sector_address + offset, norflash_kv_record, sizeof(norflash_kv_record_header_t)) != 0)
+        {
+            return 1;
+        }
+        
+        /* ¼ͷΪձʾ־ */
+        for (index = 0; index < sizeof(norflash_kv_record_header_t); index++)
+        {
+            if (norflash_kv_record[index] != empty_value)
+            {
+                break;
+            }
+        }
+        if (index == sizeof(norflash_kv_record_header_t))
+        {
+            break;
+        }
+        
+        size = norflash_kv_record_size(header);
+        if ((header->magic != NORFLASH_KV_RECORD_MAGIC) || (header->key_length == 0) || (header->key_length > NORFLASH_KV_KEY_MAX) ||
+            (header->value_length > NORFLASH_KV_VALUE_MAX) || ((offset + size) > norflash_kv_sector_size))
+        {
+            offset = norflash_kv_sector_size;
+            break;
+        }
+        
+        if (norflash_read(sector_address + offset, norflash_kv_record, size) != 0)
+        {
+            return 1;
+        }
+        crc = norflash_kv_crc32(0, norflash_kv_record, sizeof(norflash_kv_record_header_t) - sizeof(uint32_t));
+        crc = norflash_kv_crc32(crc, &norflash_kv_record[sizeof(norflash_kv_record_header_t)], header->key_length + header->value_length);
+        if (crc != header->crc)
+        {
+            offset = norflash_kv_sector_size;
+            break;
+        }
+        
+        if (norflash_kv_index_update(&norflash_kv_record[sizeof(norflash_kv_record_header_t)], header->key_length, sector_address + offset, (header->flags == NORFLASH_KV_FLAG_DELETE) ? 1 : 0) != 0)
+        {
+            return 1;
+        }
+        
+        offset += size;
+    }
+    
+    *end = offset;
+    
+    return 0;
+}
+
+/**
+ * @brief   
+ * @param   key: 
+ * @retval  ȣ0ʾЧ
+ */
+static uint8_t norflash_kv_key_length(const char *key)
+{
+    uint32_t length;
+    
+    if (key == NULL)
+    {
+        return 0;
+    }
+    
+    length = strlen(key);
+    if (length > NORFLASH_KV_KEY_MAX)
+    {
+        return 0;
+    }
+    
+    return (uint8_t)length;
+}
+
+/**
+ * @brief   Ҽ¼¼
+ * @param   key: 
+ * @param   key_length: 
+ * @param   address: ¼ַ
+ * @param   found: ҽ1: ҵ; 0: δҵ
+ * @retval  ҽ
+ * @arg     0: ҳɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_kv_lookup(const char *key, uint8_t key_length, uint32_t *address, uint8_t *found)
+{
+    uint32_t slot;
+    
+    if (norflash_kv_index_find((const uint8_t *)key, key_length, norflash_kv_hash((const uint8_t *)key, key_length), &slot, found) != 0)
+    {
+        return 1;
+    }
+    
+    if (*found != 0)
+    {
+        *address = norflash_kv_index[slot].address;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ؼֵ洢
+ * @note    УͷŴӾɵطż¼Ϊǰд
+ *          ǰдһЧ¼֮ǿʱʱджϣ׷
+ * @param   
+ * @retval  ؽ
+ * @arg     0: سɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_kv_mount(void)
+{
+    norflash_kv_sector_header_t header;
+    uint32_t sequence_last = 0;
+    uint32_t end;
+    uint8_t sector;
+    uint8_t next;
+    uint8_t blank;
+    
+    norflash_kv_mounted = 0;
+    
+    norflash_kv_sector_size = norflash_get_sector_size();
+    if ((norflash_kv_sector_size == 0) || ((NORFLASH_KV_ADDRESS + NORFLASH_KV_SECTOR_NUM * norflash_kv_sector_size) > (norflash_get_chip_size() - norflash_kv_sector_size)))
+    {
+        return 1;
+    }
+    
+    for (end = 0; end < NORFLASH_KV_INDEX_SIZE; end++)
+    {
+        norflash_kv_index[end].address = NORFLASH_KV_INDEX_EMPTY;
+    }
+    norflash_kv_keys = 0;
+    norflash_kv_head = NORFLASH_KV_SECTOR_NUM;
+    norflash_kv_head_offset = 0;
+    norflash_kv_sequence_max = 0;
+    norflash_kv_appends = 0;
+    norflash_kv_compactions = 0;
+    
+    for (sector = 0; sector < NORFLASH_KV_SECTOR_NUM; sector++)
+    {
+        norflash_kv_sequence[sector] = 0;
+        norflash_kv_erased[sector] = 0;
+        
+        if (norflash_read(norflash_kv_sector_address(sector), (uint8_t *)&header, sizeof(header)) != 0)
+        {
+            return 1;
+        }
+        
+        if ((header.magic == NORFLASH_KV_SECTOR_MAGIC) && (header.sequence != 0) && (header.state == NORFLASH_KV_SECTOR_VALID) &&
+            (header.crc == norflash_kv_crc32(0, (uint8_t *)&header, 2 * sizeof(uint32_t))))
+        {
+            norflash_kv_sequence[sector] = header.sequence;
+            if (header.sequence > norflash_kv_sequence_max)
+            {
+                norflash_kv_sequence_max = header.sequence;
+            }
+        }
+    }
+    
+    /* ŴӾɵط */
+    while (1)
+    {
+        next = NORFLASH_KV_SECTOR_NUM;
+        for (sector = 0; sector < NORFLASH_KV_SECTOR_NUM; sector++)
+        {
+            if ((norflash_kv_sequence[sector] > sequence_last) && ((next == NORFLASH_KV_SECTOR_NUM) || (norflash_kv_sequence[sector] < norflash_kv_sequence[next])))
+            {
+                next = sector;
+            }
+        }
+        if (next == NORFLASH_KV_SECTOR_NUM)
+        {
+            break;
+        }
+        
+        if (norflash_kv_sector_replay(next, &end) != 0)
+        {
+            return 1;
+        }
+        sequence_last = norflash_kv_sequence[next];
+        norflash_kv_head = next;
+        norflash_kv_head_offset = end;
+    }
+    
+    if ((norflash_kv_head != NORFLASH_KV_SECTOR_NUM) && (norflash_kv_head_offset < norflash_kv_sector_size))
+    {
+        if (norflash_kv_blank_check(norflash_kv_sector_address(norflash_kv_head) + norflash_kv_head_offset, norflash_kv_sector_size - norflash_kv_head_offset, &blank) != 0)
+        {
+            return 1;
+        }
+        if (blank == 0)
+        {
+            norflash_kv_head_offset = norflash_kv_sector_size;
+        }
+    }
+    
+    norflash_kv_mounted = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief   дֵ
+ * @note    ֵ¼¼ͬʱд
+ * @param   key: ַ1~NORFLASH_KV_KEY_MAX
+ * @param   value: ֵ
+ * @param   length: ֵȣNORFLASH_KV_VALUE_MAX
+ * @retval  д
+ * @arg     0: дɹ
+ * @arg     1: дʧ
+ */
+uint8_t norflash_kv_set(const char *key, uint8_t *value, uint16_t length)
+{
+    norflash_kv_record_header_t *header = (norflash_kv_record_header_t *)norflash_kv_record;
+    uint32_t address;
+    uint32_t size;
+    uint8_t key_length;
+    uint8_t found;
+    
+    if (norflash_kv_mounted == 0)
+    {
+        return 1;
+    }
+    
+    key_length = norflash_kv_key_length(key);
+    if ((key_length == 0) || (length > NORFLASH_KV_VALUE_MAX) || ((value == NULL) && (length != 0)))
+    {
+        return 1;
+    }
+    
+    if (norflash_kv_lookup(key, key_length, &address, &found) != 0)
+    {
+        return 1;
+    }
+    
+    if (found != 0)
+    {
+        if (norflash_read(address, norflash_kv_record, NORFLASH_KV_ALIGN(sizeof(norflash_kv_record_header_t) + key_length + length)) != 0)
+        {
+            return 1;
+        }
+        if ((header->value_length == length) && (header->flags == NORFLASH_KV_FLAG_VALUE) &&
+            ((length == 0) || (memcmp(&norflash_kv_record[sizeof(norflash_kv_record_header_t) + key_length], value, length) == 0)))
+        {
+            return 0;
+        }
+    }
+    
+    size = NORFLASH_KV_ALIGN(sizeof(norflash_kv_record_header_t) + key_length + length);
+    if (norflash_kv_make_room(size) != 0)
+    {
+        return 1;
+    }
+    
+    norflash_kv_record_build(key, key_length, value, length, NORFLASH_KV_FLAG_VALUE);
+    if (norflash_kv_append(size, &address) != 0)
+    {
+        return 1;
+    }
+    
+    return norflash_kv_index_update((const uint8_t *)key, key_length, address, 0);
+}
+
+/**
+ * @brief   ȡֵ
+ * @param   key: 
+ * @param   value: ֵ
+ * @param   size: ֵСֵϳʱֻȡsizeֽڣ
+ * @param   length: ֵȣΪNULL
+ * @retval  ȡ
+ * @arg     0: ȡɹ
+ * @arg     1: ȡʧܻ
+ */
+uint8_t norflash_kv_get(const char *key, uint8_t *value, uint16_t size, uint16_t *length)
+{
+    norflash_kv_record_header_t *header = (norflash_kv_record_header_t *)norflash_kv_record;
+    uint32_t address;
+    uint8_t key_length;
+    uint8_t found;
+    
+    if (norflash_kv_mounted == 0)
+    {
+        return 1;
+    }
+    
+    key_length = norflash_kv_key_length(key);
+    if ((key_length == 0) || ((value == NULL) && (size != 0)))
+    {
+        return 1;
+    }
+    
+    if (norflash_kv_lookup(key, key_length, &address, &found) != 0)
+    {
+        return 1;
+    }
+    if (found == 0)
+    {
+        return 1;
+    }
+    
+    /* ֵĵַΪ¼ */
+    if (norflash_read(address, norflash_kv_record, sizeof(norflash_kv_record_header_t)) != 0)
+    {
+        return 1;
+    }
+    if (norflash_read(address, norflash_kv_record, norflash_kv_record_size(header)) != 0)
+    {
+        return 1;
+    }
+    if (size > header->value_length)
+    {
+        size = header->value_length;
+    }
+    if (size != 0)
+    {
+        memcpy(value, &norflash_kv_record[sizeof(norflash_kv_record_header_t) + key_length], size);
+    }
+    
+    if (length != NULL)
+    {
+        *length = header->value_length;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ɾֵ
+ * @note    ׷ɾǣʱֱӷسɹ
+ * @param   key: 
+ * @retval  ɾ
+ * @arg     0: ɾɹ
+ * @arg     1: ɾʧ
+ */
+uint8_t norflash_kv_delete(const char *key)
+{
+    uint32_t address;
+    uint32_t size;
+    uint8_t key_length;
+    uint8_t found;
+    
+    if (norflash_kv_mounted == 0)
+    {
+        return 1;
+    }
+    
+    key_length = norflash_kv_key_length(key);
+    if (key_length == 0)
+    {
+        return 1;
+    }
+    
+    if (norflash_kv_lookup(key, key_length, &address, &found) != 0)
+    {
+        return 1;
+    }
+    if (found == 0)
+    {
+        return 0;
+    }
+    
+    size = NORFLASH_KV_ALIGN(sizeof(norflash_kv_record_header_t) + key_length);
+    if (norflash_kv_make_room(size) != 0)
+    {
+        return 1;
+    }
+    
+    norflash_kv_record_build(key, key_length, NULL, 0, NORFLASH_KV_FLAG_DELETE);
+    if (norflash_kv_append(size, &address) != 0)
+    {
+        return 1;
+    }
+    
+    return norflash_kv_index_update((const uint8_t *)key, key_length, address, 1);
+}
+
+/**
+ * @brief   
+ * @note    ʱãɱдʱ
+ * @param   
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_kv_compact(void)
+{
+    if (norflash_kv_mounted == 0)
+    {
+        return 1;
+    }
+    
+    if ((norflash_kv_free_sectors() + 1) >= NORFLASH_KV_SECTOR_NUM)
+    {
+        return 0;
+    }
+    
+    return norflash_kv_compact_sector();
+}
+
+/**
+ * @brief   ȡֵ洢ͳ
+ * @param   stats: ͳƽṹָ
+ * @retval  
+ */
+void norflash_kv_get_stats(norflash_kv_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+    
+    stats->keys = norflash_kv_keys;
+    stats->free_sectors = norflash_kv_free_sectors();
+    stats->used_sectors = NORFLASH_KV_SECTOR_NUM - stats->free_sectors;
+    stats->head_free = (norflash_kv_head == NORFLASH_KV_SECTOR_NUM) ? 0 : (norflash_kv_sector_size - norflash_kv_head_offset);
+    stats->sequence = (norflash_kv_head == NORFLASH_KV_SECTOR_NUM) ? 0 : norflash_kv_sequence[norflash_kv_head];
+    stats->appends = norflash_kv_appends;
+    stats->compactions = norflash_kv_compactions;
+}
@@ -0,0 +1,52 @@
+/**
+ ****************************************************************************************************
+ * @file        norflash_kv.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       NOR Flash ־ṹֵ洢
+ ****************************************************************************************************
+ * @attention
+ *
+ * ֵ¼׷дNORFLASH_KV_ADDRESSNORFLASH_KV_SECTOR_NUMֻҳ̣
+ * дRAMеĹϣ¼ÿ¼¼ĵַ
+ * ǰȵnorflash_kv_mount()ʱNOR Flashܴڴӳģʽ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __NORFLASH_KV_H
+#define __NORFLASH_KV_H
+
+#include "norflash_w25q128.h"
+
+/* NOR Flashֵ洢壨λڶУͼ֮ǰ */
+#define NORFLASH_KV_ADDRESS         (0x01FE0000UL)
+#define NORFLASH_KV_SECTOR_NUM      (8)
+
+/* NOR Flashֵ洢壨Ϊ2ݣ */
+#define NORFLASH_KV_INDEX_SIZE      (256)
+
+/* NOR Flashֵ洢ֵ󳤶ȶ壨Ϊ4ı */
+#define NORFLASH_KV_KEY_MAX         (32)
+#define NORFLASH_KV_VALUE_MAX       (256)
+
+/* NOR Flashֵ洢ͳƶ */
+typedef struct {
+    uint32_t keys;          /*  */
+    uint32_t used_sectors;  /* ʹ */
+    uint32_t free_sectors;  /*  */
+    uint32_t head_free;     /* ǰдʣռ */
+    uint32_t sequence;      /* ǰд */
+    uint32_t appends;       /* ׷Ӽ¼ */
+    uint32_t compactions;   /*  */
+} norflash_kv_stats_t;
+
+/*  */
+uint8_t norflash_kv_mount(void);                                                    /* ؼֵ洢 */
+uint8_t norflash_kv_set(const char *key, uint8_t *value, uint16_t length);          /* дֵ */
+uint8_t norflash_kv_get(const char *key, uint8_t *value, uint16_t size, uint16_t *length);  /* ȡֵ */
+uint8_t norflash_kv_delete(const char *key);                                        /* ɾֵ */
+uint8_t norflash_kv_compact(void);                                                  /*  */
+void norflash_kv_get_stats(norflash_kv_stats_t *stats);                             /* ȡֵ洢ͳ */
+
+#endif /* __NORFLASH_KV_H */
@@ -19,6 +19,8 @@
  */
 
 #include "norflash_w25q128.h"
+#include "boot_trace.h"
+#include <string.h>
 //#include "./SYSTEM/delay/delay.h"
 
 /* W25Q128 */
@@ -31,9 +33,14 @@
 #define W25Q128_COMMAND_WRITE_STATUS_REGISTER_2 (0x31UL)
 #define W25Q128_COMMAND_CHIP_ERASE              (0xC7UL)
 #define W25Q128_COMMAND_BLOCK_ERASE             (0xD8UL)
+#define W25Q128_COMMAND_HALF_BLOCK_ERASE        (0x52UL)
 #define W25Q128_COMMAND_SECTOR_ERASE            (0x20UL)
 #define W25Q128_COMMAND_QUAD_INPUT_PAGE_PROGRAM (0x32UL)
 #define W25Q128_COMMAND_FAST_READ_QUAD_IO       (0xEBUL)
+#define W25Q128_COMMAND_DTR_FAST_READ_QUAD_IO   (0xEDUL)
+#define W25Q128_COMMAND_CONTINUOUS_READ_RESET   (0xFFFFFFFFUL)
+#define W25Q128_COMMAND_ERASE_SUSPEND           (0x75UL)
+#define W25Q128_COMMAND_ERASE_RESUME            (0x7AUL)
 
 /* W25Q128 ID */
 #define W25Q128_MANUFACTURER_DEVICE_ID          (0x17EFUL)
@@ -42,12 +49,113 @@
 /* W25Q128С */
 #define W25Q128_CHIP_SIZE                       (0x01000000UL)
 #define W25Q128_BLOCK_SIZE                      (0x00010000UL)
+#define W25Q128_HALF_BLOCK_SIZE                 (0x00008000UL)
 #define W25Q128_SECTOR_SIZE                     (0x00001000UL)
 #define W25Q128_PAGE_SIZE                       (0x00000100UL)
 
+/* W25Q128Ͳʱ䶨壨λ룩 */
+#define W25Q128_CHIP_ERASE_TIME                 (40000UL)
+#define W25Q128_BLOCK_ERASE_TIME                (150UL)
+#define W25Q128_HALF_BLOCK_ERASE_TIME           (120UL)
+#define W25Q128_SECTOR_ERASE_TIME               (45UL)
+
 /* W25Q128ֵ */
 #define W25Q128_EMPTY_VALUE                     ((uint8_t)0xFF)
 
+/* W25Q128ȴʱ䶨壨tSUS20usλms */
+#define W25Q128_SUSPEND_TIMEOUT                 (1UL)
+
+/* W25Q128״̬Ĵ1æλ */
+#define W25Q128_STATUS_REGISTER_1_WIP           (1UL << 0)
+
+/* W25Q128״̬Ĵ2λ */
+#define W25Q128_STATUS_REGISTER_2_SUS           (1UL << 7)
+
+/* W25Q128ģʽλ壨M5-4Ϊ10bʱģʽ */
+#define W25Q128_CONTINUOUS_READ_ENABLE          (0xA0UL)
+#define W25Q128_CONTINUOUS_READ_DISABLE         (0xFFUL)
+
+/* ˫W25Q128ǰ */
+static norflash_read_profile_t w25q128_dual_read_profile = NORFlash_Read_Normal;
+
+/**
+ * @brief   ģʽλ
+ * @note    4߷321֤ģʽյM7-M0Ϊ0xFF˳δģʽʱ
+ * @param   hxspi: XSPIָ
+ * @retval  λ
+ * @arg     0: λɹ
+ * @arg     1: λʧ
+ */
+static uint8_t w25q128_dual_continuous_read_reset(XSPI_HandleTypeDef *hxspi)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_CONTINUOUS_READ_RESET;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_4_LINES;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_32_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_NONE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ǰٶ
+ * @param   xspi_regular_cmd_struct: ṹָ
+ * @param   operation_type: ͣģʽڴӳã
+ * @param   address: ַ
+ * @param   length: ݳ
+ * @param   mode: M7-M0ģʽλ
+ * @retval  
+ */
+static void w25q128_dual_read_command(XSPI_RegularCmdTypeDef *xspi_regular_cmd_struct, uint32_t operation_type, uint32_t address, uint32_t length, uint32_t mode)
+{
+    xspi_regular_cmd_struct->OperationType = operation_type;
+    xspi_regular_cmd_struct->IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct->Instruction = W25Q128_COMMAND_FAST_READ_QUAD_IO;
+    xspi_regular_cmd_struct->InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct->InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct->InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct->Address = address;
+    xspi_regular_cmd_struct->AddressMode = HAL_XSPI_ADDRESS_4_LINES;
+    xspi_regular_cmd_struct->AddressWidth = HAL_XSPI_ADDRESS_24_BITS;
+    xspi_regular_cmd_struct->AddressDTRMode = HAL_XSPI_ADDRESS_DTR_DISABLE;
+    xspi_regular_cmd_struct->AlternateBytes = mode;
+    xspi_regular_cmd_struct->AlternateBytesMode = HAL_XSPI_ALT_BYTES_4_LINES;
+    xspi_regular_cmd_struct->AlternateBytesWidth = HAL_XSPI_ALT_BYTES_8_BITS;
+    xspi_regular_cmd_struct->AlternateBytesDTRMode = HAL_XSPI_ALT_BYTES_DTR_DISABLE;
+    xspi_regular_cmd_struct->DataMode = HAL_XSPI_DATA_4_LINES;
+    xspi_regular_cmd_struct->DataLength = length;
+    xspi_regular_cmd_struct->DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
+    xspi_regular_cmd_struct->DummyCycles = 4;
+    xspi_regular_cmd_struct->DQSMode = HAL_XSPI_DQS_DISABLE;
+    
+    /* DTRٶַM7-M0ݾΪ˫أM7-M07dummyʱ */
+    if (w25q128_dual_read_profile == NORFlash_Read_XIP_DTR)
+    {
+        xspi_regular_cmd_struct->Instruction = W25Q128_COMMAND_DTR_FAST_READ_QUAD_IO;
+        xspi_regular_cmd_struct->AddressDTRMode = HAL_XSPI_ADDRESS_DTR_ENABLE;
+        xspi_regular_cmd_struct->AlternateBytesDTRMode = HAL_XSPI_ALT_BYTES_DTR_ENABLE;
+        xspi_regular_cmd_struct->DataDTRMode = HAL_XSPI_DATA_DTR_ENABLE;
+        xspi_regular_cmd_struct->DummyCycles = 7;
+    }
+}
+
 /**
  * @brief   λ
  * @param   hxspi: XSPIָ
@@ -328,13 +436,25 @@ static uint8_t w25q128_dual_configure_quad(XSPI_HandleTypeDef *hxspi)
  */
 static uint8_t w25q128_dual_init(XSPI_HandleTypeDef *hxspi)
 {
+    uint8_t res;
+    
     if (hxspi == NULL)
     {
         return 1;
     }
     
+    /* ˳ģʽϴʱģʽڴӳ䣩 */
+    w25q128_dual_read_profile = NORFlash_Read_Normal;
+    if (w25q128_dual_continuous_read_reset(hxspi) != 0)
+    {
+        return 1;
+    }
+    
     /* λ */
-    if (w25q128_dual_software_reset(hxspi) != 0)
+    BOOT_TRACE_BEGIN(BOOT_TRACE_ID_NORFLASH_RESET);
+    res = w25q128_dual_software_reset(hxspi);
+    BOOT_TRACE_END(BOOT_TRACE_ID_NORFLASH_RESET);
+    if (res != 0)
     {
         return 1;
     }
@@ -562,7 +682,117 @@ static uint8_t w25q128_dual_erase_block(XSPI_HandleTypeDef *hxspi, uint32_t addr
     xspi_auto_polling_struct.MatchMode = HAL_XSPI_MATCH_MODE_AND;
     xspi_auto_polling_struct.AutomaticStop = HAL_XSPI_AUTOMATIC_STOP_ENABLE;
     xspi_auto_polling_struct.IntervalTime = 0x10;
-    if (HAL_XSPI_AutoPolling(hxspi, &xspi_auto_polling_struct, 400UL) != HAL_OK)
+    if (HAL_XSPI_AutoPolling(hxspi, &xspi_auto_polling_struct, 2000UL) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   
+ * @param   hxspi: XSPIָ
+ * @param   address: ַ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t w25q128_dual_erase_half_block(XSPI_HandleTypeDef *hxspi, uint32_t address)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    XSPI_AutoPollingTypeDef xspi_auto_polling_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_WRITE_ENABLE;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_NONE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_READ_STATUS_REGISTER_1;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_1_LINE;
+    xspi_regular_cmd_struct.DataLength = 1 * 2;
+    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    xspi_auto_polling_struct.MatchValue = (1UL << 1) | ((1UL << 1) << 8);
+    xspi_auto_polling_struct.MatchMask = (1UL << 1) | ((1UL << 1) << 8);
+    xspi_auto_polling_struct.MatchMode = HAL_XSPI_MATCH_MODE_AND;
+    xspi_auto_polling_struct.AutomaticStop = HAL_XSPI_AUTOMATIC_STOP_ENABLE;
+    xspi_auto_polling_struct.IntervalTime = 0x10;
+    if (HAL_XSPI_AutoPolling(hxspi, &xspi_auto_polling_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_HALF_BLOCK_ERASE;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.Address = address;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_1_LINE;
+    xspi_regular_cmd_struct.AddressWidth = HAL_XSPI_ADDRESS_24_BITS;
+    xspi_regular_cmd_struct.AddressDTRMode = HAL_XSPI_ADDRESS_DTR_DISABLE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_NONE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_READ_STATUS_REGISTER_1;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_1_LINE;
+    xspi_regular_cmd_struct.DataLength = 1 * 2;
+    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    xspi_auto_polling_struct.MatchValue = (0UL << 0) | ((0UL << 0) << 8);
+    xspi_auto_polling_struct.MatchMask = (1UL << 0) | ((1UL << 0) << 8);
+    xspi_auto_polling_struct.MatchMode = HAL_XSPI_MATCH_MODE_AND;
+    xspi_auto_polling_struct.AutomaticStop = HAL_XSPI_AUTOMATIC_STOP_ENABLE;
+    xspi_auto_polling_struct.IntervalTime = 0x10;
+    if (HAL_XSPI_AutoPolling(hxspi, &xspi_auto_polling_struct, 1600UL) != HAL_OK)
     {
         return 1;
     }
@@ -822,22 +1052,8 @@ static uint8_t w25q128_dual_read(XSPI_HandleTypeDef *hxspi, uint32_t address, ui
         return 1;
     }
     
-    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
-    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
-    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_FAST_READ_QUAD_IO;
-    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
-    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
-    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
-    xspi_regular_cmd_struct.Address = address;
-    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_4_LINES;
-    xspi_regular_cmd_struct.AddressWidth = HAL_XSPI_ADDRESS_24_BITS;
-    xspi_regular_cmd_struct.AddressDTRMode = HAL_XSPI_ADDRESS_DTR_DISABLE;
-    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
-    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_4_LINES;
-    xspi_regular_cmd_struct.DataLength = length;
-    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
-    xspi_regular_cmd_struct.DummyCycles = 6;
-    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    /* Ӷģʽ */
+    w25q128_dual_read_command(&xspi_regular_cmd_struct, HAL_XSPI_OPTYPE_COMMON_CFG, address, length, W25Q128_CONTINUOUS_READ_DISABLE);
     if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
     {
         return 1;
@@ -863,6 +1079,7 @@ static uint8_t w25q128_dual_memory_mapped(XSPI_HandleTypeDef *hxspi)
     XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
     XSPI_AutoPollingTypeDef xspi_auto_polling_struct = {0};
     XSPI_MemoryMappedTypeDef xspi_memory_mapped_struct = {0};
+    uint8_t continuous_read_data[2];
     
     if (hxspi == NULL)
     {
@@ -912,20 +1129,28 @@ static uint8_t w25q128_dual_memory_mapped(XSPI_HandleTypeDef *hxspi)
         return 1;
     }
     
-    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_READ_CFG;
-    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
-    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_FAST_READ_QUAD_IO;
-    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
-    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
-    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
-    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_4_LINES;
-    xspi_regular_cmd_struct.AddressWidth = HAL_XSPI_ADDRESS_24_BITS;
-    xspi_regular_cmd_struct.AddressDTRMode = HAL_XSPI_ADDRESS_DTR_DISABLE;
-    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
-    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_4_LINES;
-    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
-    xspi_regular_cmd_struct.DummyCycles = 6;
-    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (w25q128_dual_read_profile == NORFlash_Read_Normal)
+    {
+        /* M7-0ʽΪ0xFFģʽAbort˳ڴӳ */
+        w25q128_dual_read_command(&xspi_regular_cmd_struct, HAL_XSPI_OPTYPE_READ_CFG, 0, 0, W25Q128_CONTINUOUS_READ_DISABLE);
+    }
+    else
+    {
+        /* XSPISIOOԼӶM7-0Ϊ0xA0ʹģʽʡָ׶Σ
+         * ģʽָʹڴӳд */
+        w25q128_dual_read_command(&xspi_regular_cmd_struct, HAL_XSPI_OPTYPE_COMMON_CFG, 0, sizeof(continuous_read_data), W25Q128_CONTINUOUS_READ_ENABLE);
+        if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+        {
+            return 1;
+        }
+        if (HAL_XSPI_Receive(hxspi, continuous_read_data, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+        {
+            return 1;
+        }
+        
+        w25q128_dual_read_command(&xspi_regular_cmd_struct, HAL_XSPI_OPTYPE_READ_CFG, 0, 0, W25Q128_CONTINUOUS_READ_ENABLE);
+        xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_NONE;
+    }
     if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
     {
         return 1;
@@ -960,128 +1185,250 @@ static uint8_t w25q128_dual_memory_mapped(XSPI_HandleTypeDef *hxspi)
     return 0;
 }
 
-/* ˫W25Q128豸豸 */
-const norflash_t norflash_w25q128_dual = {
-    .type = NORFlash_W25Q128_Dual,
-    .parameter = {
-        .empty_value = W25Q128_EMPTY_VALUE,
-        .chip_size = 2 * W25Q128_CHIP_SIZE,
-        .block_size = 2 * W25Q128_BLOCK_SIZE,
-        .sector_size = 2 * W25Q128_SECTOR_SIZE,
-        .page_size = 2 * W25Q128_PAGE_SIZE,
-    },
-    .ops = {
-        .init = w25q128_dual_init,
-        .deinit = NULL,
-        .erase_chip = w25q128_dual_erase_chip,
-        .erase_block = w25q128_dual_erase_block,
-        .erase_sector = w25q128_dual_erase_sector,
-        .program_page = w25q128_dual_program_page,
-        .read = w25q128_dual_read,
-        .memory_mapped = w25q128_dual_memory_mapped,
-    },
-};
-
-/* ʹõNOR Flash豸ָ붨 */
-static const norflash_t *norflash = NULL;
-
-/* ֵ֧NOR Flash豸ָб */
-static const norflash_t *norflashs[] = {
-#ifdef NORFLASH_SUPPORT_MX25UM25645G
-    &norflash_mx25um25645g,
-#endif /* NORFLASH_SUPPORT_MX25UM25645G */
-#ifdef NORFLASH_SUPPORT_W25Q128_DUAL
-    &norflash_w25q128_dual,
-#endif /* NORFLASH_SUPPORT_W25Q128_DUAL */
-};
-
-/* XSPI */
-static XSPI_HandleTypeDef xspi1_handle = {0};
-
-/* NOR Flash */
-static uint8_t norflash_sector_buffer[NORFLASH_SECTOR_BUFFER_SIZE / sizeof(uint8_t)];
-
 /**
- * @brief   ʼXSPI1
+ * @brief   ˳ڴӳ
+ * @note    ģʽֹ븴λģʽָܽ
  * @param   hxspi: XSPIָ
- * @param   type: NOR Flash豸ͣοnorflash.hļеnorflash_type_t壩
- * @retval  ʼ
- * @arg     0: ʼɹ
- * @arg     1: ʼʧ
+ * @retval  ˳ڴӳ
+ * @arg     0: ˳ڴӳɹ
+ * @arg     1: ˳ڴӳʧ
  */
-static uint8_t norflash_xspi1_init(XSPI_HandleTypeDef *hxspi, norflash_type_t type)
+static uint8_t w25q128_dual_memory_mapped_exit(XSPI_HandleTypeDef *hxspi)
 {
-    __IO uint8_t *ptr;
-    uint32_t i;
-    XSPIM_CfgTypeDef xspim_cfg_struct = {0};
-    
     if (hxspi == NULL)
     {
         return 1;
     }
     
-    if ((type == NORFlash_Unknow) || (type >= NORFlash_Dummy))
+    if (HAL_XSPI_Abort(hxspi) != HAL_OK)
     {
         return 1;
     }
     
-    ptr = (__IO uint8_t *)hxspi;
-    for (i = 0; i < sizeof(XSPI_HandleTypeDef); i++)
+    if (w25q128_dual_read_profile != NORFlash_Read_Normal)
     {
-        *ptr++ = 0x00;
+        if (w25q128_dual_continuous_read_reset(hxspi) != 0)
+        {
+            return 1;
+        }
     }
     
-    /* ʼXSPI */
-    hxspi->Instance = XSPI1;
-    if (HAL_XSPI_DeInit(hxspi) != HAL_OK)
-    {
-        return 1;
+    return 0;
+}
+
+/**
+ * @brief   ö
+ * @note    ڼģʽģʽʱãлУ׼ʱӳ
+ * @param   hxspi: XSPIָ
+ * @param   profile: ãοnorflash_w25q128.hļеnorflash_read_profile_t壩
+ * @retval  ý
+ * @arg     0: óɹ
+ * @arg     1: ʧ
+ */
+static uint8_t w25q128_dual_set_read_profile(XSPI_HandleTypeDef *hxspi, norflash_read_profile_t profile)
+{
+    uint32_t prescaler;
+    uint32_t sample_shifting;
+    uint32_t delay_hold_quarter_cycle;
+    
+    if (hxspi == NULL)
+    {
+        return 1;
     }
     
-    /* ʼXSPI */
-    hxspi->Instance = XSPI1;
-    hxspi->Init.FifoThresholdByte = 4;
-    if (0)
+    switch (profile)
     {
-        
+        case NORFlash_Read_Normal:
+        {
+            /* 50MHz */
+            prescaler = 4 - 1;
+            sample_shifting = HAL_XSPI_SAMPLE_SHIFT_NONE;
+            delay_hold_quarter_cycle = HAL_XSPI_DHQC_DISABLE;
+            break;
+        }
+        case NORFlash_Read_XIP:
+        {
+            /* 100MHzЧڲ㣬λ */
+            prescaler = 2 - 1;
+            sample_shifting = HAL_XSPI_SAMPLE_SHIFT_HALFCYCLE;
+            delay_hold_quarter_cycle = HAL_XSPI_DHQC_DISABLE;
+            break;
+        }
+        case NORFlash_Read_XIP_DTR:
+        {
+            /* 66MHzDTR80MHzDTRλ˫ӳ1/4ڱ */
+            prescaler = 3 - 1;
+            sample_shifting = HAL_XSPI_SAMPLE_SHIFT_NONE;
+            delay_hold_quarter_cycle = HAL_XSPI_DHQC_ENABLE;
+            break;
+        }
+        default:
+        {
+            return 1;
+        }
     }
-#ifdef NORFLASH_SUPPORT_MX25UM25645G
-    else if (type == NORFlash_MX25UM25645G)
+    
+    /* ԭʱӸλģʽֹϴνģʽδ˳ */
+    if (w25q128_dual_continuous_read_reset(hxspi) != 0)
+    {
+        return 1;
+    }
+    
+    if (HAL_XSPI_SetClockPrescaler(hxspi, prescaler) != HAL_OK)
     {
+        return 1;
+    }
+    
+    /* HAL_XSPI_Init()ڸλ״̬üĴֱ޸TCR */
+    hxspi->Init.SampleShifting = sample_shifting;
+    hxspi->Init.DelayHoldQuarterCycle = delay_hold_quarter_cycle;
+    MODIFY_REG(hxspi->Instance->TCR, (XSPI_TCR_SSHIFT | XSPI_TCR_DHQC), (sample_shifting | delay_hold_quarter_cycle));
+    
+    w25q128_dual_read_profile = profile;
+    
+    return 0;
+}
 
-        hxspi->Init.MemoryMode = HAL_XSPI_SINGLE_MEM;
-        hxspi->Init.MemoryType = HAL_XSPI_MEMTYPE_MACRONIX;
+/**
+ * @brief   дʹܲжϷʽѯWEL
+ * @note    WELλHAL_XSPI_StatusMatchCallback()ص
+ * @param   hxspi: XSPIָ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t w25q128_dual_write_enable_it(XSPI_HandleTypeDef *hxspi)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    XSPI_AutoPollingTypeDef xspi_auto_polling_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
     }
-#endif /* NORFLASH_SUPPORT_MX25UM25645G */
-#ifdef NORFLASH_SUPPORT_W25Q128_DUAL
-    else if (type == NORFlash_W25Q128_Dual)
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_WRITE_ENABLE;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_NONE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_READ_STATUS_REGISTER_1;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_1_LINE;
+    xspi_regular_cmd_struct.DataLength = 1 * 2;
+    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    xspi_auto_polling_struct.MatchValue = (1UL << 1) | ((1UL << 1) << 8);
+    xspi_auto_polling_struct.MatchMask = (1UL << 1) | ((1UL << 1) << 8);
+    xspi_auto_polling_struct.MatchMode = HAL_XSPI_MATCH_MODE_AND;
+    xspi_auto_polling_struct.AutomaticStop = HAL_XSPI_AUTOMATIC_STOP_ENABLE;
+    xspi_auto_polling_struct.IntervalTime = 0x10;
+    if (HAL_XSPI_AutoPolling_IT(hxspi, &xspi_auto_polling_struct) != HAL_OK)
     {
+        return 1;
+    }
+    
+    return 0;
+}
 
-        hxspi->Init.MemoryMode = HAL_XSPI_DUAL_MEM;
-        hxspi->Init.MemoryType = HAL_XSPI_MEMTYPE_APMEM;
+/**
+ * @brief   жϷʽѯWIP
+ * @note    WIPHAL_XSPI_StatusMatchCallback()ص
+ * @param   hxspi: XSPIָ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t w25q128_dual_wait_ready_it(XSPI_HandleTypeDef *hxspi)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    XSPI_AutoPollingTypeDef xspi_auto_polling_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
     }
-#endif /* NORFLASH_SUPPORT_W25Q128_DUAL */
-    hxspi->Init.MemorySize = HAL_XSPI_SIZE_256MB;
-    hxspi->Init.ChipSelectHighTimeCycle = 1;
-    hxspi->Init.FreeRunningClock = HAL_XSPI_FREERUNCLK_DISABLE;
-    hxspi->Init.ClockMode = HAL_XSPI_CLOCK_MODE_0;
-    hxspi->Init.WrapSize = HAL_XSPI_WRAP_NOT_SUPPORTED;
-    hxspi->Init.ClockPrescaler = 4 - 1;
-    hxspi->Init.SampleShifting = HAL_XSPI_SAMPLE_SHIFT_NONE;
-    hxspi->Init.DelayHoldQuarterCycle = HAL_XSPI_DHQC_DISABLE;
-    hxspi->Init.ChipSelectBoundary = HAL_XSPI_BONDARYOF_NONE;
-    hxspi->Init.MaxTran = 0;
-    hxspi->Init.Refresh = 0;
-    hxspi->Init.MemorySelect = HAL_XSPI_CSSEL_NCS1;
-    if (HAL_XSPI_Init(hxspi) != HAL_OK)
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_READ_STATUS_REGISTER_1;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_1_LINE;
+    xspi_regular_cmd_struct.DataLength = 1 * 2;
+    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    xspi_auto_polling_struct.MatchValue = (0UL << 0) | ((0UL << 0) << 8);
+    xspi_auto_polling_struct.MatchMask = (1UL << 0) | ((1UL << 0) << 8);
+    xspi_auto_polling_struct.MatchMode = HAL_XSPI_MATCH_MODE_AND;
+    xspi_auto_polling_struct.AutomaticStop = HAL_XSPI_AUTOMATIC_STOP_ENABLE;
+    xspi_auto_polling_struct.IntervalTime = 0x10;
+    if (HAL_XSPI_AutoPolling_IT(hxspi, &xspi_auto_polling_struct) != HAL_OK)
     {
         return 1;
     }
     
-    /* XSPIM */
-    xspim_cfg_struct.nCSOverride = HAL_XSPI_CSSEL_OVR_NCS1;
-    xspim_cfg_struct.IOPort = HAL_XSPIM_IOPORT_1;
-    if (HAL_XSPIM_Config(hxspi, &xspim_cfg_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    return 0;
+}
+
+/**
+ * @brief   ȫƬдʹܣ
+ * @param   hxspi: XSPIָ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t w25q128_dual_erase_chip_start(XSPI_HandleTypeDef *hxspi)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_CHIP_ERASE;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_NONE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
     {
         return 1;
     }
@@ -1090,265 +1437,2610 @@ static uint8_t norflash_xspi1_init(XSPI_HandleTypeDef *hxspi, norflash_type_t ty
 }
 
 /**
- * @brief   ʼXSPI1
+ * @brief   дʹܣ
  * @param   hxspi: XSPIָ
- * @retval  ʼ
- * @arg     0: ʼɹ
- * @arg     1: ʼʧ
+ * @param   address: ַ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
  */
-static uint8_t norflash_xspi1_deinit(XSPI_HandleTypeDef *hxspi)
+static uint8_t w25q128_dual_erase_block_start(XSPI_HandleTypeDef *hxspi, uint32_t address)
 {
-    if (HAL_XSPI_DeInit(hxspi) != HAL_OK)
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_BLOCK_ERASE;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.Address = address;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_1_LINE;
+    xspi_regular_cmd_struct.AddressWidth = HAL_XSPI_ADDRESS_24_BITS;
+    xspi_regular_cmd_struct.AddressDTRMode = HAL_XSPI_ADDRESS_DTR_DISABLE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_NONE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   дʹܣ
+ * @param   hxspi: XSPIָ
+ * @param   address: ַ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t w25q128_dual_erase_sector_start(XSPI_HandleTypeDef *hxspi, uint32_t address)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_SECTOR_ERASE;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.Address = address;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_1_LINE;
+    xspi_regular_cmd_struct.AddressWidth = HAL_XSPI_ADDRESS_24_BITS;
+    xspi_regular_cmd_struct.AddressDTRMode = HAL_XSPI_ADDRESS_DTR_DISABLE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_NONE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   DMAʽҳ̣дʹܣ
+ * @note    ݷɺHAL_XSPI_TxCpltCallback()ص
+ *          ݻλDMAɷʵĴ洢λDTCM
+ * @param   hxspi: XSPIָ
+ * @param   address: ҳַ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t w25q128_dual_program_page_dma(XSPI_HandleTypeDef *hxspi, uint32_t address, uint8_t *data, uint32_t length)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
+    }
+    
+    if (length > (2 * W25Q128_PAGE_SIZE))
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_QUAD_INPUT_PAGE_PROGRAM;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.Address = address;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_1_LINE;
+    xspi_regular_cmd_struct.AddressWidth = HAL_XSPI_ADDRESS_24_BITS;
+    xspi_regular_cmd_struct.AddressDTRMode = HAL_XSPI_ADDRESS_DTR_DISABLE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_4_LINES;
+    xspi_regular_cmd_struct.DataLength = length;
+    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* DMAǰдڴ */
+    SCB_CleanDCache_by_Addr((uint32_t *)((uintptr_t)data & ~31UL), (int32_t)(length + ((uintptr_t)data & 31UL)));
+    if (HAL_XSPI_Transmit_DMA(hxspi, data) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   дʹ
+ * @param   hxspi: XSPIָ
+ * @retval  дʹܽ
+ * @arg     0: дʹܳɹ
+ * @arg     1: дʹʧ
+ */
+static uint8_t w25q128_dual_write_enable(XSPI_HandleTypeDef *hxspi)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    XSPI_AutoPollingTypeDef xspi_auto_polling_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_WRITE_ENABLE;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_NONE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_READ_STATUS_REGISTER_1;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_1_LINE;
+    xspi_regular_cmd_struct.DataLength = 1 * 2;
+    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    xspi_auto_polling_struct.MatchValue = (1UL << 1) | ((1UL << 1) << 8);
+    xspi_auto_polling_struct.MatchMask = (1UL << 1) | ((1UL << 1) << 8);
+    xspi_auto_polling_struct.MatchMode = HAL_XSPI_MATCH_MODE_AND;
+    xspi_auto_polling_struct.AutomaticStop = HAL_XSPI_AUTOMATIC_STOP_ENABLE;
+    xspi_auto_polling_struct.IntervalTime = 0x10;
+    if (HAL_XSPI_AutoPolling(hxspi, &xspi_auto_polling_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ѯWIPֱʱ
+ * @note    ʱֹԶѯص״̬æ
+ * @param   hxspi: XSPIָ
+ * @param   timeout: ʱʱ䣨λms
+ * @retval  ѯ
+ * @arg     0: WIP
+ * @arg     1: ʱʧ
+ */
+static uint8_t w25q128_dual_wait_ready(XSPI_HandleTypeDef *hxspi, uint32_t timeout)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    XSPI_AutoPollingTypeDef xspi_auto_polling_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_READ_STATUS_REGISTER_1;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_1_LINE;
+    xspi_regular_cmd_struct.DataLength = 1 * 2;
+    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    xspi_auto_polling_struct.MatchValue = (0UL << 0) | ((0UL << 0) << 8);
+    xspi_auto_polling_struct.MatchMask = (1UL << 0) | ((1UL << 0) << 8);
+    xspi_auto_polling_struct.MatchMode = HAL_XSPI_MATCH_MODE_AND;
+    xspi_auto_polling_struct.AutomaticStop = HAL_XSPI_AUTOMATIC_STOP_ENABLE;
+    xspi_auto_polling_struct.IntervalTime = 0x10;
+    if (HAL_XSPI_AutoPolling(hxspi, &xspi_auto_polling_struct, timeout) != HAL_OK)
+    {
+        HAL_XSPI_Abort(hxspi);
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡWIPȴ
+ * @note    ֻһζ״̬Ĵ1ָʹԶѯHAL_GetTick()жʱɵ߼ʱѯ
+ * @param   hxspi: XSPIָ
+ * @param   busy: ȡ1: һƬæ; 0: ƬУ
+ * @retval  ȡ
+ * @arg     0: ȡɹ
+ * @arg     1: ȡʧ
+ */
+static uint8_t w25q128_dual_read_busy(XSPI_HandleTypeDef *hxspi, uint8_t *busy)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    uint8_t data[2];
+    
+    if ((hxspi == NULL) || (busy == NULL))
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_READ_STATUS_REGISTER_1;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_1_LINE;
+    xspi_regular_cmd_struct.DataLength = sizeof(data);
+    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    if (HAL_XSPI_Receive(hxspi, data, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    *busy = (((data[0] | data[1]) & W25Q128_STATUS_REGISTER_1_WIP) != 0) ? 1 : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief   
+ * @note    δڲʱԹָ˫ƬһƬڹ״̬Ϊѹ
+ * @param   hxspi: XSPIָ
+ * @param   suspended: 1: ѹ; 0: ǰɣ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t w25q128_dual_erase_suspend(XSPI_HandleTypeDef *hxspi, uint8_t *suspended)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    uint8_t data[2];
+    
+    if ((hxspi == NULL) || (suspended == NULL))
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_ERASE_SUSPEND;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_NONE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* ȴ */
+    if (w25q128_dual_wait_ready(hxspi, W25Q128_SUSPEND_TIMEOUT) != 0)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_READ_STATUS_REGISTER_2;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_1_LINE;
+    xspi_regular_cmd_struct.DataLength = sizeof(data);
+    xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    if (HAL_XSPI_Receive(hxspi, data, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    *suspended = (((data[0] | data[1]) & W25Q128_STATUS_REGISTER_2_SUS) != 0) ? 1 : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief   ָ
+ * @note    δڹ״̬Իָָ
+ * @param   hxspi: XSPIָ
+ * @retval  ָ
+ * @arg     0: ָɹ
+ * @arg     1: ָʧ
+ */
+static uint8_t w25q128_dual_erase_resume(XSPI_HandleTypeDef *hxspi)
+{
+    XSPI_RegularCmdTypeDef xspi_regular_cmd_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
+    }
+    
+    xspi_regular_cmd_struct.OperationType = HAL_XSPI_OPTYPE_COMMON_CFG;
+    xspi_regular_cmd_struct.IOSelect = HAL_XSPI_SELECT_IO_7_0;
+    xspi_regular_cmd_struct.Instruction = W25Q128_COMMAND_ERASE_RESUME;
+    xspi_regular_cmd_struct.InstructionMode = HAL_XSPI_INSTRUCTION_1_LINE;
+    xspi_regular_cmd_struct.InstructionWidth = HAL_XSPI_INSTRUCTION_8_BITS;
+    xspi_regular_cmd_struct.InstructionDTRMode = HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_NONE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_NONE;
+    xspi_regular_cmd_struct.DummyCycles = 0;
+    xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
+    if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/* ˫W25Q128豸豸 */
+const norflash_t norflash_w25q128_dual = {
+    .type = NORFlash_W25Q128_Dual,
+    .parameter = {
+        .empty_value = W25Q128_EMPTY_VALUE,
+        .chip_size = 2 * W25Q128_CHIP_SIZE,
+        .block_size = 2 * W25Q128_BLOCK_SIZE,
+        .half_block_size = 2 * W25Q128_HALF_BLOCK_SIZE,
+        .sector_size = 2 * W25Q128_SECTOR_SIZE,
+        .page_size = 2 * W25Q128_PAGE_SIZE,
+        .chip_erase_time = W25Q128_CHIP_ERASE_TIME,
+        .block_erase_time = W25Q128_BLOCK_ERASE_TIME,
+        .half_block_erase_time = W25Q128_HALF_BLOCK_ERASE_TIME,
+        .sector_erase_time = W25Q128_SECTOR_ERASE_TIME,
+    },
+    .ops = {
+        .init = w25q128_dual_init,
+        .deinit = NULL,
+        .erase_chip = w25q128_dual_erase_chip,
+        .erase_block = w25q128_dual_erase_block,
+        .erase_half_block = w25q128_dual_erase_half_block,
+        .erase_sector = w25q128_dual_erase_sector,
+        .program_page = w25q128_dual_program_page,
+        .read = w25q128_dual_read,
+        .memory_mapped = w25q128_dual_memory_mapped,
+        .memory_mapped_exit = w25q128_dual_memory_mapped_exit,
+        .set_read_profile = w25q128_dual_set_read_profile,
+        .write_enable_it = w25q128_dual_write_enable_it,
+        .wait_ready_it = w25q128_dual_wait_ready_it,
+        .erase_chip_start = w25q128_dual_erase_chip_start,
+        .erase_block_start = w25q128_dual_erase_block_start,
+        .erase_sector_start = w25q128_dual_erase_sector_start,
+        .program_page_dma = w25q128_dual_program_page_dma,
+        .write_enable = w25q128_dual_write_enable,
+        .wait_ready = w25q128_dual_wait_ready,
+        .read_busy = w25q128_dual_read_busy,
+        .erase_suspend = w25q128_dual_erase_suspend,
+        .erase_resume = w25q128_dual_erase_resume,
+    },
+};
+
+/* ʹõNOR Flash豸ָ붨 */
+static const norflash_t *norflash = NULL;
+
+/* ֵ֧NOR Flash豸ָб */
+static const norflash_t *norflashs[] = {
+#ifdef NORFLASH_SUPPORT_MX25UM25645G
+    &norflash_mx25um25645g,
+#endif /* NORFLASH_SUPPORT_MX25UM25645G */
+#ifdef NORFLASH_SUPPORT_W25Q128_DUAL
+    &norflash_w25q128_dual,
+#endif /* NORFLASH_SUPPORT_W25Q128_DUAL */
+};
+
+/* XSPI */
+static XSPI_HandleTypeDef xspi1_handle = {0};
+
+/* NOR Flash */
+static uint8_t norflash_sector_buffer[NORFLASH_SECTOR_BUFFER_SIZE / sizeof(uint8_t)];
+
+/* NOR FlashһηΧ */
+static norflash_erase_report_t norflash_erase_report = {0};
+
+/* NOR Flashǰ */
+static norflash_read_profile_t norflash_read_profile = NORFlash_Read_Normal;
+
+/* NOR FlashУ黺 */
+static uint8_t norflash_read_pattern_buffer[NORFLASH_READ_PATTERN_SIZE];
+
+/* NOR Flash첽״̬ */
+#define NORFLASH_ASYNC_STATE_IDLE           (0)     /*  */
+#define NORFLASH_ASYNC_STATE_WEL            (1)     /* ȴдʹ */
+#define NORFLASH_ASYNC_STATE_TX             (2)     /* ȴҳݷ */
+#define NORFLASH_ASYNC_STATE_WIP            (3)     /* ȴ/ */
+
+/* NOR Flash첽Ͷ */
+#define NORFLASH_ASYNC_TYPE_WRITE           (0)     /* д */
+#define NORFLASH_ASYNC_TYPE_ERASE           (1)     /*  */
+
+/* NOR Flash첽ʱʱ䶨壨λms */
+#define NORFLASH_ASYNC_STEP_TIMEOUT         (3000UL)
+#define NORFLASH_ASYNC_CHIP_ERASE_TIMEOUT   (200000UL)
+
+/* NOR Flash첽 */
+typedef struct {
+    uint8_t type;                           /*  */
+    uint32_t address;                       /* ʣʼַ */
+    uint8_t *data;                          /* ʣд */
+    uint32_t length;                        /* ʣ */
+    norflash_async_callback_t callback;     /* ɻص */
+    void *arg;                              /* ɻص */
+} norflash_async_request_t;
+
+/* NOR Flash첽ж */
+static struct {
+    norflash_async_request_t queue[NORFLASH_ASYNC_QUEUE_SIZE];
+    volatile uint8_t head;                  /* ףǰ */
+    volatile uint8_t count;                 /*  */
+    volatile uint8_t state;                 /* ǰ״̬ */
+    uint32_t step_length;                   /* ǰ */
+    uint32_t step_tick;                     /* ǰʼʱ */
+    uint32_t step_timeout;                  /* ǰʱʱ */
+} norflash_async = {0};
+
+/* NOR Flash̨״̬ */
+#define NORFLASH_ERASE_BG_STATE_IDLE        (0)     /*  */
+#define NORFLASH_ERASE_BG_STATE_PENDING     (1)     /* ȴһԪ */
+#define NORFLASH_ERASE_BG_STATE_RUNNING     (2)     /* ԪУʱƬڣ */
+#define NORFLASH_ERASE_BG_STATE_SUSPENDED   (3)     /* Ԫѹ */
+
+/* NOR Flash̨Ԫʱʱ䶨壨ۼƲʱ䣬λms */
+#define NORFLASH_ERASE_BG_UNIT_TIMEOUT      (3000UL)
+
+/* NOR Flash̨ */
+static struct {
+    uint8_t state;                          /* ̨״̬ */
+    uint32_t address;                       /* ǰһԪַ */
+    uint32_t end;                           /* ַ */
+    uint32_t unit_size;                     /* ǰԪС */
+    uint32_t unit_time;                     /* ǰԪۼƲʱ䣨λus */
+    norflash_erase_progress_t progress;     /*  */
+} norflash_erase_bg = {0};
+
+#ifndef __SYS_H
+/* NOR Flash DMA */
+static DMA_HandleTypeDef norflash_dma_handle = {0};
+#endif /* __SYS_H */
+
+/**
+ * @brief   ʼXSPI1
+ * @param   hxspi: XSPIָ
+ * @param   type: NOR Flash豸ͣοnorflash.hļеnorflash_type_t壩
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: ʼʧ
+ */
+static uint8_t norflash_xspi1_init(XSPI_HandleTypeDef *hxspi, norflash_type_t type)
+{
+    __IO uint8_t *ptr;
+    uint32_t i;
+    XSPIM_CfgTypeDef xspim_cfg_struct = {0};
+    
+    if (hxspi == NULL)
+    {
+        return 1;
+    }
+    
+    if ((type == NORFlash_Unknow) || (type >= NORFlash_Dummy))
+    {
+        return 1;
+    }
+    
+    ptr = (__IO uint8_t *)hxspi;
+    for (i = 0; i < sizeof(XSPI_HandleTypeDef); i++)
+    {
+        *ptr++ = 0x00;
+    }
+    
+    /* ʼXSPI */
+    hxspi->Instance = XSPI1;
+    if (HAL_XSPI_DeInit(hxspi) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* ʼXSPI */
+    hxspi->Instance = XSPI1;
+    hxspi->Init.FifoThresholdByte = 4;
+    if (0)
+    {
+        
+    }
+#ifdef NORFLASH_SUPPORT_MX25UM25645G
+    else if (type == NORFlash_MX25UM25645G)
+    {
+
+        hxspi->Init.MemoryMode = HAL_XSPI_SINGLE_MEM;
+        hxspi->Init.MemoryType = HAL_XSPI_MEMTYPE_MACRONIX;
+    }
+#endif /* NORFLASH_SUPPORT_MX25UM25645G */
+#ifdef NORFLASH_SUPPORT_W25Q128_DUAL
+    else if (type == NORFlash_W25Q128_Dual)
+    {
+
+        hxspi->Init.MemoryMode = HAL_XSPI_DUAL_MEM;
+        hxspi->Init.MemoryType = HAL_XSPI_MEMTYPE_APMEM;
+    }
+#endif /* NORFLASH_SUPPORT_W25Q128_DUAL */
+    hxspi->Init.MemorySize = HAL_XSPI_SIZE_256MB;
+    hxspi->Init.ChipSelectHighTimeCycle = 1;
+    hxspi->Init.FreeRunningClock = HAL_XSPI_FREERUNCLK_DISABLE;
+    hxspi->Init.ClockMode = HAL_XSPI_CLOCK_MODE_0;
+    hxspi->Init.WrapSize = HAL_XSPI_WRAP_NOT_SUPPORTED;
+    hxspi->Init.ClockPrescaler = 4 - 1;
+    hxspi->Init.SampleShifting = HAL_XSPI_SAMPLE_SHIFT_NONE;
+    hxspi->Init.DelayHoldQuarterCycle = HAL_XSPI_DHQC_DISABLE;
+    hxspi->Init.ChipSelectBoundary = HAL_XSPI_BONDARYOF_NONE;
+    hxspi->Init.MaxTran = 0;
+    hxspi->Init.Refresh = 0;
+    hxspi->Init.MemorySelect = HAL_XSPI_CSSEL_NCS1;
+    if (HAL_XSPI_Init(hxspi) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* XSPIM */
+    xspim_cfg_struct.nCSOverride = HAL_XSPI_CSSEL_OVR_NCS1;
+    xspim_cfg_struct.IOPort = HAL_XSPIM_IOPORT_1;
+    if (HAL_XSPIM_Config(hxspi, &xspim_cfg_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ʼXSPI1
+ * @param   hxspi: XSPIָ
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: ʼʧ
+ */
+static uint8_t norflash_xspi1_deinit(XSPI_HandleTypeDef *hxspi)
+{
+    if (HAL_XSPI_DeInit(hxspi) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+#ifndef __SYS_H
+/**
+ * @brief   HALXSPIʼص
+ * @param   hxspi: XSPIָ
+ * @retval  
+ */
+void HAL_XSPI_MspInit(XSPI_HandleTypeDef* hxspi)
+{
+    RCC_PeriphCLKInitTypeDef rcc_periph_clk_init_struct = {0};
+    GPIO_InitTypeDef gpio_init_struct = {0};
+    
+    if (hxspi->Instance == XSPI1)
+    {
+        /* ʱԴ */
+        rcc_periph_clk_init_struct.PeriphClockSelection = RCC_PERIPHCLK_XSPI1;
+        rcc_periph_clk_init_struct.Xspi1ClockSelection = RCC_XSPI1CLKSOURCE_PLL2S;
+        HAL_RCCEx_PeriphCLKConfig(&rcc_periph_clk_init_struct);
+        
+        /* ʹʱ */
+        __HAL_RCC_XSPIM_CLK_ENABLE();
+        __HAL_RCC_XSPI1_CLK_ENABLE();
+        __HAL_RCC_GPIOP_CLK_ENABLE();
+        __HAL_RCC_GPIOO_CLK_ENABLE();
+        
+        /* ʼͨѶ */
+        gpio_init_struct.Pin = GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7;
+        gpio_init_struct.Mode = GPIO_MODE_AF_PP;
+        gpio_init_struct.Pull = GPIO_NOPULL;
+        gpio_init_struct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+        gpio_init_struct.Alternate = GPIO_AF9_XSPIM_P1;
+        HAL_GPIO_Init(GPIOP, &gpio_init_struct);
+        gpio_init_struct.Pin = GPIO_PIN_0 | GPIO_PIN_2 | GPIO_PIN_4;
+        gpio_init_struct.Mode = GPIO_MODE_AF_PP;
+        gpio_init_struct.Pull = GPIO_NOPULL;
+        gpio_init_struct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+        gpio_init_struct.Alternate = GPIO_AF9_XSPIM_P1;
+        HAL_GPIO_Init(GPIOO, &gpio_init_struct);
+        
+        /* ʼҳDMAHPDMA1ͨ0 */
+        __HAL_RCC_HPDMA1_CLK_ENABLE();
+        norflash_dma_handle.Instance = HPDMA1_Channel0;
+        norflash_dma_handle.Init.Request = HPDMA1_REQUEST_XSPI1;
+        norflash_dma_handle.Init.BlkHWRequest = DMA_BREQ_SINGLE_BURST;
+        norflash_dma_handle.Init.Direction = DMA_MEMORY_TO_PERIPH;
+        norflash_dma_handle.Init.SrcInc = DMA_SINC_INCREMENTED;
+        norflash_dma_handle.Init.DestInc = DMA_DINC_FIXED;
+        norflash_dma_handle.Init.SrcDataWidth = DMA_SRC_DATAWIDTH_BYTE;
+        norflash_dma_handle.Init.DestDataWidth = DMA_DEST_DATAWIDTH_BYTE;
+        norflash_dma_handle.Init.Priority = DMA_LOW_PRIORITY_HIGH_WEIGHT;
+        norflash_dma_handle.Init.SrcBurstLength = 1;
+        norflash_dma_handle.Init.DestBurstLength = 1;
+        norflash_dma_handle.Init.TransferAllocatedPort = DMA_SRC_ALLOCATED_PORT0 | DMA_DEST_ALLOCATED_PORT1;
+        norflash_dma_handle.Init.TransferEventMode = DMA_TCEM_BLOCK_TRANSFER;
+        norflash_dma_handle.Init.Mode = DMA_NORMAL;
+        if (HAL_DMA_Init(&norflash_dma_handle) == HAL_OK)
+        {
+            __HAL_LINKDMA(hxspi, hdmatx, norflash_dma_handle);
+        }
+        
+        /* ж */
+        HAL_NVIC_SetPriority(HPDMA1_Channel0_IRQn, 5, 0);
+        HAL_NVIC_EnableIRQ(HPDMA1_Channel0_IRQn);
+        HAL_NVIC_SetPriority(XSPI1_IRQn, 5, 0);
+        HAL_NVIC_EnableIRQ(XSPI1_IRQn);
+    }
+}
+
+/**
+ * @brief   HALXSPIʼص
+ * @param   hxspi: XSPIָ
+ * @retval  
+ */
+void HAL_XSPI_MspDeInit(XSPI_HandleTypeDef* hxspi)
+{
+    if (hxspi->Instance == XSPI1)
+    {
+        /* ʱ */
+        __HAL_RCC_XSPIM_CLK_DISABLE();
+        __HAL_RCC_XSPI1_CLK_DISABLE();
+        
+        /* жϲʼDMA */
+        HAL_NVIC_DisableIRQ(XSPI1_IRQn);
+        HAL_NVIC_DisableIRQ(HPDMA1_Channel0_IRQn);
+        if (hxspi->hdmatx != NULL)
+        {
+            HAL_DMA_DeInit(hxspi->hdmatx);
+            hxspi->hdmatx = NULL;
+        }
+        
+        /* ʼͨѶ */
+        HAL_GPIO_DeInit(GPIOP, GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7);
+        HAL_GPIO_DeInit(GPIOO, GPIO_PIN_0 | GPIO_PIN_2 | GPIO_PIN_4);
+    }
+}
+#endif /* __SYS_H */
+
+/**
+ * @brief   ʼNOR Flash
+ * @param   
+ * @retval  NOR Flash豸ͣοnorflash.hļеnorflash_type_t壩
+ */
+norflash_type_t norflash_init(void)
+{
+    uint8_t norflash_index;
+    uint8_t res;
+    
+    if (norflash != NULL)
+    {
+        if (norflash_deinit() != 0)
+        {
+            return 1;
+        }
+    }
+    
+    for (norflash_index = 0; norflash_index < (sizeof(norflashs) / sizeof(norflashs[0])); norflash_index++)
+    {
+        /* ʼXSPI1 */
+        BOOT_TRACE_BEGIN(BOOT_TRACE_ID_NORFLASH_XSPI_INIT);
+        res = norflash_xspi1_init(&xspi1_handle, norflashs[norflash_index]->type);
+        BOOT_TRACE_END(BOOT_TRACE_ID_NORFLASH_XSPI_INIT);
+        if (res != 0)
+        {
+            break;
+        }
+        
+        if (norflashs[norflash_index]->ops.init == NULL)
+        {
+            continue;
+        }
+        
+        /* ʼNOR Flash豸 */
+        BOOT_TRACE_BEGIN(BOOT_TRACE_ID_NORFLASH_DEVICE_INIT);
+        res = norflashs[norflash_index]->ops.init(&xspi1_handle);
+        BOOT_TRACE_END(BOOT_TRACE_ID_NORFLASH_DEVICE_INIT);
+        if (res == 0)
+        {
+//            if (norflashs[norflash_index]->type == NORFlash_MX25UM25645G)
+//            {
+//                /* MX25UM25645G֧200MHzʱ */
+//                HAL_XSPI_SetClockPrescaler(&xspi1_handle, 2 - 1);
+//            }
+            norflash = norflashs[norflash_index];
+            norflash_read_profile = NORFlash_Read_Normal;
+            return norflash->type;
+        }
+    }
+    
+    return NORFlash_Unknow;
+}
+
+/**
+ * @brief   ʼNOR Flash
+ * @param   
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: ʼʧ
+ */
+uint8_t norflash_deinit(void)
+{
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if ((norflash_async.count != 0) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
+    {
+        return 1;
+    }
+    
+    /* ʼNOR Flash豸 */
+    if (norflash->ops.deinit != NULL)
+    {
+        if (norflash->ops.deinit(&xspi1_handle) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* ʼXSPI1 */
+    if (norflash_xspi1_deinit(&xspi1_handle) != 0)
+    {
+        return 1;
+    }
+    
+    norflash = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief   ȫƬNOR Flash
+ * @param   
+ * @retval  ȫƬ
+ * @arg     0: ȫƬɹ
+ * @arg     1: ȫƬʧ
+ */
+uint8_t norflash_erase_chip(void)
+{
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return 1;
+    }
+    
+    if ((norflash_async.count != 0) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
+    {
+        return 1;
+    }
+    
+    /* ȫƬNOR Flash豸 */
+    if (norflash->ops.erase_chip != NULL)
+    {
+        if (norflash->ops.erase_chip(&xspi1_handle) == 0)
+        {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   NOR Flash
+ * @param   address: ַ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_erase_block(uint32_t address)
+{
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return 1;
+    }
+    
+    if ((norflash_async.count != 0) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
+    {
+        return 1;
+    }
+    
+    /* NOR Flash豸 */
+    if (norflash->ops.erase_block != NULL)
+    {
+        if (norflash->ops.erase_block(&xspi1_handle, address) == 0)
+        {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   NOR Flash
+ * @param   address: ַ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_erase_half_block(uint32_t address)
+{
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return 1;
+    }
+    
+    if ((norflash_async.count != 0) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
+    {
+        return 1;
+    }
+    
+    /* NOR Flash豸 */
+    if (norflash->ops.erase_half_block != NULL)
+    {
+        if (norflash->ops.erase_half_block(&xspi1_handle, address) == 0)
+        {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   NOR Flash
+ * @param   address: ַ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_erase_sector(uint32_t address)
+{
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return 1;
+    }
+    
+    if ((norflash_async.count != 0) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
+    {
+        return 1;
+    }
+    
+    /* NOR Flash豸 */
+    if (norflash->ops.erase_sector != NULL)
+    {
+        if (norflash->ops.erase_sector(&xspi1_handle, address) == 0)
+        {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   ҳNOR Flash
+ * @param   address: ҳַ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  ҳ̽
+ * @arg     0: ҳ̳ɹ
+ * @arg     1: ҳʧ
+ */
+uint8_t norflash_program_page(uint32_t address, uint8_t *data, uint32_t length)
+{
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return 1;
+    }
+    
+    if ((norflash_async.count != 0) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
+    {
+        return 1;
+    }
+    
+    if (length > norflash->parameter.page_size)
+    {
+        return 1;
+    }
+    
+    /* ҳNOR Flash豸 */
+    if (norflash->ops.program_page != NULL)
+    {
+        if (norflash->ops.program_page(&xspi1_handle, address, data, length) == 0)
+        {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   NOR Flash
+ * @param   address: ַ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_read(uint32_t address, uint8_t *data, uint32_t length)
+{
+    uint32_t index;
+    uint32_t length_16b;
+    
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    /* ڴӳ״ֱ̬Ӵӳַȡ */
+    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        length_16b = length >> 1;
+        for (index = 0; index < length_16b; index++)
+        {
+            ((uint16_t *)data)[index] = ((volatile uint16_t *)(NORFLASH_MEMORY_MAPPED_BASE + address))[index];
+        }
+        
+        if (length & 1UL)
+        {
+            data[length - 1] = *(volatile uint8_t *)(NORFLASH_MEMORY_MAPPED_BASE + address + length - 1);
+        }
+        
+        return 0;
+    }
+    
+    if (norflash_async.count != 0)
+    {
+        return 1;
+    }
+    
+    /* NOR Flash豸 */
+    if (norflash->ops.read != NULL)
+    {
+        if (norflash->ops.read(&xspi1_handle, address, data, length) == 0)
+        {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   NOR Flashڴӳ
+ * @param   
+ * @retval  ڴӳ
+ * @arg     0: ڴӳɹ
+ * @arg     1: ڴӳʧ
+ */
+uint8_t norflash_memory_mapped(void)
+{
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return 0;
+    }
+    
+    if (norflash_async.count != 0)
+    {
+        return 1;
+    }
+    
+    /* NOR Flash豸ڴӳ */
+    if (norflash->ops.memory_mapped != NULL)
+    {
+        if (norflash->ops.memory_mapped(&xspi1_handle) == 0)
+        {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   ˳NOR Flashڴӳ
+ * @note    ֹXSPIڴӳ䣬ãֱ֮ӽмģʽ
+ * @param   
+ * @retval  ˳ڴӳ
+ * @arg     0: ˳ڴӳɹ
+ * @arg     1: ˳ڴӳʧ
+ */
+uint8_t norflash_memory_mapped_exit(void)
+{
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if (xspi1_handle.State != HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return 0;
+    }
+    
+    /* ˳NOR Flash豸ڴӳ䣨ģʽͬʱλģʽ */
+    if (norflash->ops.memory_mapped_exit != NULL)
+    {
+        return norflash->ops.memory_mapped_exit(&xspi1_handle);
+    }
+    
+    if (HAL_XSPI_Abort(&xspi1_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ѯNOR FlashǷڴӳģʽ
+ * @param   
+ * @retval  ѯ
+ * @arg     0: ģʽ
+ * @arg     1: ڴӳģʽ
+ */
+uint8_t norflash_memory_mapped_state(void)
+{
+    return (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED) ? 1 : 0;
+}
+
+/**
+ * @brief   жϲ˳NOR Flashڴӳ
+ * @note    ڴӳеĳдNOR FlashʱʹãжжϷλӳ䴰У
+ *          ˳ӳڼӦжϻȡָʧܽHardFaultԭڴӳģʽʱж˳
+ *          norflash_memory_mapped_resume()ɶԵãִеĴ루⺯λITCMڲRAM
+ *          ҲжϣHAL_GetTick()첽ƽ
+ * @param   context: ڴӳж״̬
+ * @retval  ˳
+ * @arg     0: ˳ɹ
+ * @arg     1: ˳ʧܣѻָж״̬
+ */
+uint8_t norflash_memory_mapped_suspend(uint32_t *context)
+{
+    uint32_t primask = __get_PRIMASK();
+    
+    *context = 0;
+    if (norflash_memory_mapped_state() == 0)
+    {
+        return norflash_memory_mapped_exit();
+    }
+    
+    __disable_irq();
+    *context = NORFLASH_MAPPED_CONTEXT_MAPPED | ((primask != 0) ? NORFLASH_MAPPED_CONTEXT_PRIMASK : 0);
+    if (norflash_memory_mapped_exit() != 0)
+    {
+        __set_PRIMASK(primask);
+        *context = 0;
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ָNOR Flashڴӳж״̬
+ * @note    ԭڴӳģʽʱκβָӳʧʱж
+ * @param   context: norflash_memory_mapped_suspend()״̬
+ * @retval  ָ
+ * @arg     0: ָɹ
+ * @arg     1: ָʧ
+ */
+uint8_t norflash_memory_mapped_resume(uint32_t context)
+{
+    if ((context & NORFLASH_MAPPED_CONTEXT_MAPPED) == 0)
+    {
+        return 0;
+    }
+    
+    if (norflash_memory_mapped() != 0)
+    {
+        return 1;
+    }
+    
+    if ((context & NORFLASH_MAPPED_CONTEXT_PRIMASK) == 0)
+    {
+        __enable_irq();
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡУͼ
+ * @note    Ϊ0x55/0xAA桢10αݸ128ֽ
+ * @param   index: ͼƫ
+ * @retval  ͼ
+ */
+static uint8_t norflash_read_pattern_byte(uint32_t index)
+{
+    switch ((index >> 7) & 0x3UL)
+    {
+        case 0:
+        {
+            return ((index & 1UL) == 0) ? 0x55 : 0xAA;
+        }
+        case 1:
+        {
+            return (uint8_t)(1UL << (index & 0x7UL));
+        }
+        case 2:
+        {
+            return (uint8_t)~(1UL << (index & 0x7UL));
+        }
+        default:
+        {
+            return (uint8_t)((index * 0x9E3779B1UL) >> 24);
+        }
+    }
+}
+
+/**
+ * @brief   Ƚ϶Уͼ
+ * @note    ڴӳ״̬´ӳַȡȡǰD-Cacheеľ
+ * @param   
+ * @retval  ȽϽ
+ * @arg     0: ͼһ
+ * @arg     1: ͼһ»ʧ
+ */
+static uint8_t norflash_read_pattern_check(void)
+{
+    uint32_t address;
+    uint32_t index;
+    
+    address = norflash->parameter.chip_size - norflash->parameter.sector_size;
+    
+    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        SCB_InvalidateDCache_by_Addr((volatile void *)(NORFLASH_MEMORY_MAPPED_BASE + address), NORFLASH_READ_PATTERN_SIZE);
+    }
+    
+    if (norflash_read(address, norflash_read_pattern_buffer, NORFLASH_READ_PATTERN_SIZE) != 0)
+    {
+        return 1;
+    }
+    
+    for (index = 0; index < NORFLASH_READ_PATTERN_SIZE; index++)
+    {
+        if (norflash_read_pattern_buffer[index] != norflash_read_pattern_byte(index))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ׼Уͼ
+ * @note    һͷУͼʱд
+ * @param   
+ * @retval  ׼
+ * @arg     0: ׼ɹ
+ * @arg     1: ׼ʧ
+ */
+static uint8_t norflash_read_pattern_prepare(void)
+{
+    uint32_t index;
+    
+    if (norflash_read_pattern_check() == 0)
+    {
+        return 0;
+    }
+    
+    for (index = 0; index < NORFLASH_READ_PATTERN_SIZE; index++)
+    {
+        norflash_read_pattern_buffer[index] = norflash_read_pattern_byte(index);
+    }
+    
+    if (norflash_write(norflash->parameter.chip_size - norflash->parameter.sector_size, norflash_read_pattern_buffer, NORFLASH_READ_PATTERN_SIZE) != 0)
+    {
+        return 1;
+    }
+    
+    return norflash_read_pattern_check();
+}
+
+/**
+ * @brief   лòУ׼
+ * @note    ɨ跴ʱӳٲԼӶУͼȡͨе㣬
+ *          ڴӳУһΣڼģʽµ
+ * @param   profile: 
+ * @retval  У׼
+ * @arg     0: У׼ɹ
+ * @arg     1: У׼ʧ
+ */
+static uint8_t norflash_read_profile_calibrate(norflash_read_profile_t profile)
+{
+    XSPI_HSCalTypeDef xspi_hs_cal_struct = {0};
+    uint32_t delay;
+    uint32_t pass_start = 0;
+    uint32_t pass_count = 0;
+    uint32_t best_start = 0;
+    uint32_t best_count = 0;
+    uint8_t res;
+    
+    /* Ĭ϶׼Уͼ */
+    if (norflash->ops.set_read_profile(&xspi1_handle, NORFlash_Read_Normal) != 0)
+    {
+        return 1;
+    }
+    
+    xspi_hs_cal_struct.DelayValueType = HAL_XSPI_CAL_FEEDBACK_CLK_DELAY;
+    xspi_hs_cal_struct.FineCalibrationUnit = 0;
+    xspi_hs_cal_struct.CoarseCalibrationUnit = 0;
+    if (HAL_XSPI_SetDelayValue(&xspi1_handle, &xspi_hs_cal_struct) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    if (profile == NORFlash_Read_Normal)
+    {
+        return 0;
+    }
+    
+    if (norflash_read_pattern_prepare() != 0)
+    {
+        return 1;
+    }
+    
+    if (norflash->ops.set_read_profile(&xspi1_handle, profile) != 0)
+    {
+        return 1;
+    }
+    
+    /* ɨ跴ʱӳ */
+    for (delay = 0; delay <= NORFLASH_READ_DELAY_MAX; delay += NORFLASH_READ_DELAY_STEP)
+    {
+        xspi_hs_cal_struct.FineCalibrationUnit = delay;
+        if (HAL_XSPI_SetDelayValue(&xspi1_handle, &xspi_hs_cal_struct) != HAL_OK)
+        {
+            return 1;
+        }
+        
+        if (norflash_read_pattern_check() == 0)
+        {
+            if (pass_count == 0)
+            {
+                pass_start = delay;
+            }
+            pass_count++;
+            if (pass_count > best_count)
+            {
+                best_start = pass_start;
+                best_count = pass_count;
+            }
+        }
+        else
+        {
+            pass_count = 0;
+        }
+    }
+    
+    if (best_count == 0)
+    {
+        return 1;
+    }
+    
+    xspi_hs_cal_struct.FineCalibrationUnit = best_start + ((best_count - 1) * NORFLASH_READ_DELAY_STEP) / 2;
+    if (HAL_XSPI_SetDelayValue(&xspi1_handle, &xspi_hs_cal_struct) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    if (norflash_read_pattern_check() != 0)
+    {
+        return 1;
+    }
+    
+    /* ڴӳ䣨ģʽУ */
+    if (norflash_memory_mapped() != 0)
+    {
+        return 1;
+    }
+    res = norflash_read_pattern_check();
+    if (norflash_memory_mapped_exit() != 0)
+    {
+        return 1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief   NOR Flash
+ * @note    лʱúУ׼ʱӳ٣УͼһºЧ˵Ĭ϶ã
+ *          ڴӳ״̬µʱ˳ɺ¿һڴУͼ
+ * @param   profile: ãοnorflash_w25q128.hļеnorflash_read_profile_t壩
+ * @retval  ý
+ * @arg     0: óɹ
+ * @arg     1: ʧܣѻ˵Ĭ϶ã
+ */
+uint8_t norflash_set_read_profile(norflash_read_profile_t profile)
+{
+    uint8_t mapped;
+    uint8_t res = 0;
+    
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if ((profile >= NORFlash_Read_Dummy) || (norflash->ops.set_read_profile == NULL))
+    {
+        return 1;
+    }
+    
+    if ((norflash_async.count != 0) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
+    {
+        return 1;
+    }
+    
+    mapped = (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED) ? 1 : 0;
+    if (norflash_memory_mapped_exit() != 0)
+    {
+        return 1;
+    }
+    
+    if (norflash_read_profile_calibrate(profile) == 0)
+    {
+        norflash_read_profile = profile;
+    }
+    else
+    {
+        norflash_read_profile = NORFlash_Read_Normal;
+        norflash_read_profile_calibrate(NORFlash_Read_Normal);
+        res = 1;
+    }
+    
+    if (mapped != 0)
+    {
+        if (norflash_memory_mapped() != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return res;
+}
+
+/**
+ * @brief   ȡNOR Flash
+ * @param   
+ * @retval  ãοnorflash_w25q128.hļеnorflash_read_profile_t壩
+ */
+norflash_read_profile_t norflash_get_read_profile(void)
+{
+    return norflash_read_profile;
+}
+
+/**
+ * @brief   ȡNOR Flashֵ
+ * @param   
+ * @retval  NOR Flashֵ
+ */
+uint8_t norflash_get_empty_value(void)
+{
+    if (norflash == NULL)
+    {
+        return 0;
+    }
+    
+    return norflash->parameter.empty_value;
+}
+
+/**
+ * @brief   ȡNOR FlashƬС
+ * @param   
+ * @retval  NOR FlashƬС
+ */
+uint32_t norflash_get_chip_size(void)
+{
+    if (norflash == NULL)
+    {
+        return 0;
+    }
+    
+    return norflash->parameter.chip_size;
+}
+
+/**
+ * @brief   ȡNOR FlashС
+ * @param   
+ * @retval  NOR FlashС
+ */
+uint32_t norflash_get_block_size(void)
+{
+    if (norflash == NULL)
+    {
+        return 0;
+    }
+    
+    return norflash->parameter.block_size;
+}
+
+/**
+ * @brief   ȡNOR FlashС
+ * @param   
+ * @retval  NOR FlashС
+ */
+uint32_t norflash_get_half_block_size(void)
+{
+    if (norflash == NULL)
+    {
+        return 0;
+    }
+    
+    return norflash->parameter.half_block_size;
+}
+
+/**
+ * @brief   ȡNOR FlashС
+ * @param   
+ * @retval  NOR FlashС
+ */
+uint32_t norflash_get_sector_size(void)
+{
+    if (norflash == NULL)
+    {
+        return 0;
+    }
+    
+    return norflash->parameter.sector_size;
+}
+
+/**
+ * @brief   ȡNOR FlashҳС
+ * @param   
+ * @retval  NOR FlashҳС
+ */
+uint32_t norflash_get_page_size(void)
+{
+    if (norflash == NULL)
+    {
+        return 0;
+    }
+    
+    return norflash->parameter.page_size;
+}
+
+/**
+ * @brief   дNOR Flash
+ * @note    дҪĳЩλ0Ϊ1ʱŲ
+ *          ʱδ仯ҳ̷ǿҳ
+ * @param   address: ַ
+ * @param   data: ݻָ
+ * @param   length: ݳ
+ * @retval  д
+ * @arg     0: дɹ
+ * @arg     1: дʧ
+ */
+uint8_t norflash_write(uint32_t address, uint8_t *data, uint32_t length)
+{
+    uint32_t sector_size;
+    uint32_t sectors_index;
+    uint32_t sector_address;
+    uint32_t sector_offset;
+    uint32_t sector_remain;
+    uint32_t sector_write_length;
+    uint32_t sector_write_end;
+    uint32_t data_index;
+    uint32_t page_size;
+    uint32_t page_start;
+    uint32_t page_end;
+    uint8_t empty_value;
+    uint8_t need_erase;
+    
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return 1;
+    }
+    
+    if ((norflash_async.count != 0) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
+    {
+        return 1;
+    }
+    
+    sector_size = norflash_get_sector_size();
+    page_size = norflash_get_page_size();
+    empty_value = norflash_get_empty_value();
+    
+    /* NOR FlashСУ */
+    if (sector_size > (sizeof(norflash_sector_buffer) / sizeof(norflash_sector_buffer[0])))
+    {
+        return 1;
+    }
+    
+    sectors_index = address / sector_size;
+    sector_offset = address % sector_size;
+    while (length != 0)
+    {
+        sector_address = sectors_index * sector_size;
+        sector_remain = sector_size - sector_offset;
+        sector_write_length = (length < sector_remain) ? length : sector_remain;
+        sector_write_end = sector_offset + sector_write_length;
+        length -= sector_write_length;
+        
+        /* ȡNOR Flashдλ */
+        if (norflash_read(sector_address + sector_offset, &norflash_sector_buffer[sector_offset], sector_write_length) != 0)
+        {
+            return 1;
+        }
+        
+        /* ֻܽλ1Ϊ0λҪ0Ϊ1ʱ */
+        need_erase = 0;
+        for (data_index = 0; data_index < sector_write_length; data_index++)
+        {
+            if ((norflash_sector_buffer[sector_offset + data_index] & data[data_index]) != data[data_index])
+            {
+                need_erase = 1;
+                break;
+            }
+        }
+        
+        if (need_erase != 0)
+        {
+            /* ȡNOR Flash */
+            if (sector_offset != 0)
+            {
+                if (norflash_read(sector_address, norflash_sector_buffer, sector_offset) != 0)
+                {
+                    return 1;
+                }
+            }
+            if (sector_write_end < sector_size)
+            {
+                if (norflash_read(sector_address + sector_write_end, &norflash_sector_buffer[sector_write_end], sector_size - sector_write_end) != 0)
+                {
+                    return 1;
+                }
+            }
+            
+            /* ддNOR Flash */
+            for (data_index = 0; data_index < sector_write_length; data_index++)
+            {
+                norflash_sector_buffer[sector_offset + data_index] = data[data_index];
+            }
+            
+            /* NOR Flash */
+            if (norflash_erase_sector(sector_address) != 0)
+            {
+                return 1;
+            }
+            
+            /* NOR FlashǿҳдNOR Flash */
+            for (page_start = 0; page_start < sector_size; page_start += page_size)
+            {
+                for (data_index = page_start; data_index < (page_start + page_size); data_index++)
+                {
+                    if (norflash_sector_buffer[data_index] != empty_value)
+                    {
+                        break;
+                    }
+                }
+                
+                if (data_index == (page_start + page_size))
+                {
+                    continue;
+                }
+                
+                if (norflash_program_page(sector_address + page_start, &norflash_sector_buffer[page_start], page_size) != 0)
+                {
+                    return 1;
+                }
+            }
+        }
+        else
+        {
+            /* дб仯ҳдNOR Flash */
+            page_start = sector_offset;
+            while (page_start < sector_write_end)
+            {
+                page_end = (page_start / page_size + 1) * page_size;
+                if (page_end > sector_write_end)
+                {
+                    page_end = sector_write_end;
+                }
+                
+                for (data_index = page_start; data_index < page_end; data_index++)
+                {
+                    if (norflash_sector_buffer[data_index] != data[data_index - sector_offset])
+                    {
+                        break;
+                    }
+                }
+                
+                if (data_index < page_end)
+                {
+                    if (norflash_program_page(sector_address + page_start, &data[page_start - sector_offset], page_end - page_start) != 0)
+                    {
+                        return 1;
+                    }
+                }
+                
+                page_start = page_end;
+            }
+        }
+        
+        data += sector_write_length;
+        sectors_index++;
+        sector_offset = 0;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ͳλλ
+ * @param   value: ֵ
+ * @retval  λλ
+ */
+static uint32_t norflash_count_bits(uint32_t value)
+{
+    uint32_t count = 0;
+    
+    while (value != 0)
+    {
+        value &= value - 1;
+        count++;
+    }
+    
+    return count;
+}
+
+/**
+ * @brief   NOR FlashǷΪ
+ * @param   address: ַ
+ * @param   blank: ս1: Ϊ; 0: ǿգ
+ * @retval  ս
+ * @arg     0: ճɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_sector_blank_check(uint32_t address, uint8_t *blank)
+{
+    uint32_t sector_size;
+    uint8_t empty_value;
+    uint32_t index;
+    
+    sector_size = norflash->parameter.sector_size;
+    if (norflash_read(address, norflash_sector_buffer, sector_size) != 0)
+    {
+        return 1;
+    }
+    
+    empty_value = norflash->parameter.empty_value;
+    for (index = 0; index < sector_size; index++)
+    {
+        if (norflash_sector_buffer[index] != empty_value)
+        {
+            *blank = 0;
+            return 0;
+        }
+    }
+    
+    *blank = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief   滮ڵ
+ * @note    ڿаͲʱѡʱٵ
+ * @param   block_address: ַ
+ * @param   dirty_mask: ǿգλͼ
+ * @param   range_mask: λڲΧλͼ
+ * @param   execute: 0: ; 1: ִв
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_erase_range_block(uint32_t block_address, uint32_t dirty_mask, uint32_t range_mask, uint8_t execute)
+{
+    uint32_t sector_size;
+    uint32_t half_block_size;
+    uint32_t sectors_per_block;
+    uint32_t sectors_per_half;
+    uint32_t block_mask;
+    uint32_t half_mask;
+    uint32_t half_index;
+    uint32_t sector_index;
+    uint32_t half_dirty;
+    uint32_t half_time;
+    uint32_t split_time = 0;
+    
+    sector_size = norflash->parameter.sector_size;
+    half_block_size = (norflash->ops.erase_half_block != NULL) ? norflash->parameter.half_block_size : 0;
+    sectors_per_block = norflash->parameter.block_size / sector_size;
+    sectors_per_half = (half_block_size != 0) ? (half_block_size / sector_size) : sectors_per_block;
+    block_mask = (sectors_per_block < 32) ? ((1UL << sectors_per_block) - 1) : 0xFFFFFFFFUL;
+    half_mask = (sectors_per_half < 32) ? ((1UL << sectors_per_half) - 1) : 0xFFFFFFFFUL;
+    
+    if (dirty_mask == 0)
+    {
+        return 0;
+    }
+    
+    /* 㲻ʹÿʱĺʱ */
+    for (half_index = 0; half_index < sectors_per_block; half_index += sectors_per_half)
+    {
+        half_dirty = (dirty_mask >> half_index) & half_mask;
+        half_time = norflash_count_bits(half_dirty) * norflash->parameter.sector_erase_time;
+        
+        if ((half_block_size != 0) && (((range_mask >> half_index) & half_mask) == half_mask) && (half_dirty != 0))
+        {
+            if (norflash->parameter.half_block_erase_time < half_time)
+            {
+                half_time = norflash->parameter.half_block_erase_time;
+            }
+        }
+        split_time += half_time;
+    }
+    
+    /*  */
+    if ((range_mask == block_mask) && (norflash->parameter.block_erase_time < split_time))
+    {
+        norflash_erase_report.block_erases++;
+        norflash_erase_report.expected_time += norflash->parameter.block_erase_time;
+        if (execute != 0)
+        {
+            return norflash_erase_block(block_address);
+        }
+        
+        return 0;
+    }
+    
+    for (half_index = 0; half_index < sectors_per_block; half_index += sectors_per_half)
+    {
+        half_dirty = (dirty_mask >> half_index) & half_mask;
+        if (half_dirty == 0)
+        {
+            continue;
+        }
+        
+        /*  */
+        if ((half_block_size != 0) && (((range_mask >> half_index) & half_mask) == half_mask) &&
+            (norflash->parameter.half_block_erase_time < (norflash_count_bits(half_dirty) * norflash->parameter.sector_erase_time)))
+        {
+            norflash_erase_report.half_block_erases++;
+            norflash_erase_report.expected_time += norflash->parameter.half_block_erase_time;
+            if (execute != 0)
+            {
+                if (norflash_erase_half_block(block_address + half_index * sector_size) != 0)
+                {
+                    return 1;
+                }
+            }
+            continue;
+        }
+        
+        /*  */
+        for (sector_index = 0; sector_index < sectors_per_half; sector_index++)
+        {
+            if ((half_dirty & (1UL << sector_index)) == 0)
+            {
+                continue;
+            }
+            
+            norflash_erase_report.sector_erases++;
+            norflash_erase_report.expected_time += norflash->parameter.sector_erase_time;
+            if (execute != 0)
+            {
+                if (norflash_erase_sector(block_address + (half_index + sector_index) * sector_size) != 0)
+                {
+                    return 1;
+                }
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ղ滮NOR FlashΧ
+ * @param   address: ʼַ
+ * @param   length: 
+ * @param   execute: 0: ; 1: ִв
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_erase_range_pass(uint32_t address, uint32_t length, uint8_t execute)
+{
+    uint32_t sector_size;
+    uint32_t block_size;
+    uint32_t block_address;
+    uint32_t sector_address;
+    uint32_t sector_index;
+    uint32_t dirty_mask;
+    uint32_t range_mask;
+    uint8_t blank;
+    
+    sector_size = norflash->parameter.sector_size;
+    block_size = norflash->parameter.block_size;
+    
+    for (block_address = address & ~(block_size - 1); block_address < (address + length); block_address += block_size)
+    {
+        dirty_mask = 0;
+        range_mask = 0;
+        
+        for (sector_index = 0; sector_index < (block_size / sector_size); sector_index++)
+        {
+            sector_address = block_address + sector_index * sector_size;
+            if ((sector_address < address) || (sector_address >= (address + length)))
+            {
+                continue;
+            }
+            
+            range_mask |= 1UL << sector_index;
+            if (norflash_sector_blank_check(sector_address, &blank) != 0)
+            {
+                return 1;
+            }
+            
+            if (blank != 0)
+            {
+                norflash_erase_report.blank_sectors++;
+            }
+            else
+            {
+                dirty_mask |= 1UL << sector_index;
+            }
+        }
+        
+        if (norflash_erase_range_block(block_address, dirty_mask, range_mask, execute) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ΧNOR Flash
+ * @note    ַ볤밴룻ΪյͲʱ
+ *          ѡȫƬ///ϣͨnorflash_get_erase_report()ȡ
+ * @param   address: ʼַ
+ * @param   length: 
+ * @retval  Χ
+ * @arg     0: Χɹ
+ * @arg     1: Χʧ
+ */
+uint8_t norflash_erase_range(uint32_t address, uint32_t length)
+{
+    uint32_t start_tick;
+    uint32_t sector_size;
+    uint8_t res;
+    
+    memset(&norflash_erase_report, 0, sizeof(norflash_erase_report));
+    
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return 1;
+    }
+    
+    if ((norflash_async.count != 0) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
+    {
+        return 1;
+    }
+    
+    sector_size = norflash->parameter.sector_size;
+    if ((sector_size == 0) || (sector_size > sizeof(norflash_sector_buffer)) || ((norflash->parameter.block_size / sector_size) > 32))
+    {
+        return 1;
+    }
+    
+    if (((address | length) & (sector_size - 1)) != 0)
+    {
+        return 1;
+    }
+    
+    if ((address >= norflash->parameter.chip_size) || (length > (norflash->parameter.chip_size - address)))
+    {
+        return 1;
+    }
+    
+    start_tick = HAL_GetTick();
+    
+    /* ƬΧȹ㣬ȫƬʱֱȫƬ */
+    if ((address == 0) && (length == norflash->parameter.chip_size) && (norflash->ops.erase_chip != NULL))
+    {
+        if (norflash_erase_range_pass(address, length, 0) != 0)
+        {
+            return 1;
+        }
+        
+        if (norflash_erase_report.expected_time >= norflash->parameter.chip_erase_time)
+        {
+            memset(&norflash_erase_report, 0, sizeof(norflash_erase_report));
+            norflash_erase_report.chip_erases = 1;
+            norflash_erase_report.expected_time = norflash->parameter.chip_erase_time;
+            res = norflash_erase_chip();
+            norflash_erase_report.actual_time = HAL_GetTick() - start_tick;
+            
+            return res;
+        }
+        
+        memset(&norflash_erase_report, 0, sizeof(norflash_erase_report));
+    }
+    
+    res = norflash_erase_range_pass(address, length, 1);
+    norflash_erase_report.actual_time = HAL_GetTick() - start_tick;
+    
+    return res;
+}
+
+/**
+ * @brief   ȡһηΧ
+ * @param   report: Χָ
+ * @retval  
+ */
+void norflash_get_erase_report(norflash_erase_report_t *report)
+{
+    if (report != NULL)
+    {
+        *report = norflash_erase_report;
+    }
+}
+
+/**
+ * @brief   ǰ̨Ԫ
+ * @param   
+ * @retval  
+ */
+static void norflash_erase_background_unit_done(void)
+{
+    norflash_erase_bg.progress.done += norflash_erase_bg.unit_size;
+    norflash_erase_bg.address += norflash_erase_bg.unit_size;
+    norflash_erase_bg.state = (norflash_erase_bg.address >= norflash_erase_bg.end) ? NORFLASH_ERASE_BG_STATE_IDLE : NORFLASH_ERASE_BG_STATE_PENDING;
+}
+
+/**
+ * @brief   һ̨Ԫ
+ * @note    ʣ೤㹻ʱΪյĵԪֱ
+ * @param   
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_erase_background_issue(void)
+{
+    uint32_t block_size;
+    uint32_t sector_size;
+    uint32_t sector_address;
+    uint8_t blank = 1;
+    
+    block_size = norflash->parameter.block_size;
+    sector_size = norflash->parameter.sector_size;
+    
+    if (((norflash_erase_bg.address & (block_size - 1)) == 0) && ((norflash_erase_bg.end - norflash_erase_bg.address) >= block_size))
+    {
+        norflash_erase_bg.unit_size = block_size;
+    }
+    else
+    {
+        norflash_erase_bg.unit_size = sector_size;
+    }
+    
+    for (sector_address = norflash_erase_bg.address; (blank != 0) && (sector_address < (norflash_erase_bg.address + norflash_erase_bg.unit_size)); sector_address += sector_size)
+    {
+        if (norflash_sector_blank_check(sector_address, &blank) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    if (blank != 0)
+    {
+        norflash_erase_bg.progress.skipped += norflash_erase_bg.unit_size;
+        norflash_erase_background_unit_done();
+        return 0;
+    }
+    
+    if (norflash->ops.write_enable(&xspi1_handle) != 0)
+    {
+        return 1;
+    }
+    
+    if (norflash_erase_bg.unit_size == block_size)
+    {
+        if (norflash->ops.erase_block_start(&xspi1_handle, norflash_erase_bg.address) != 0)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        if (norflash->ops.erase_sector_start(&xspi1_handle, norflash_erase_bg.address) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    norflash_erase_bg.unit_time = 0;
+    norflash_erase_bg.state = NORFLASH_ERASE_BG_STATE_RUNNING;
+    
+    return 0;
+}
+
+/**
+ * @brief   NOR Flash̨
+ * @note    ǼǲΧnorflash_erase_background_run()ʱƬڽУ
+ *          Χ뵽ǰܽ/
+ * @param   address: ַ
+ * @param   length: 
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+uint8_t norflash_erase_background(uint32_t address, uint32_t length)
+{
+    uint32_t sector_size;
+    
+    if (norflash == NULL)
+    {
+        return 1;
+    }
+    
+    if ((norflash->ops.write_enable == NULL) || (norflash->ops.read_busy == NULL) || (norflash->ops.erase_suspend == NULL) || (norflash->ops.erase_resume == NULL) || (norflash->ops.erase_block_start == NULL) || (norflash->ops.erase_sector_start == NULL))
+    {
+        return 1;
+    }
+    
+    if ((length == 0) || (address >= norflash->parameter.chip_size) || (length > (norflash->parameter.chip_size - address)))
+    {
+        return 1;
+    }
+    
+    if ((norflash_async.count != 0) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
     {
         return 1;
     }
     
+    sector_size = norflash->parameter.sector_size;
+    norflash_erase_bg.end = ((address + length + sector_size - 1) / sector_size) * sector_size;
+    norflash_erase_bg.address = (address / sector_size) * sector_size;
+    memset(&norflash_erase_bg.progress, 0, sizeof(norflash_erase_bg.progress));
+    norflash_erase_bg.progress.total = norflash_erase_bg.end - norflash_erase_bg.address;
+    norflash_erase_bg.progress.busy = 1;
+    norflash_erase_bg.state = NORFLASH_ERASE_BG_STATE_PENDING;
+    
     return 0;
 }
 
-#ifndef __SYS_H
 /**
- * @brief   HALXSPIʼص
- * @param   hxspi: XSPIָ
- * @retval  
+ * @brief   DWTڼ
+ * @note    Ѵʱ㣬Ӱģļʱboot_trace
+ * @param   
+ * @retval  ÿ΢
  */
-void HAL_XSPI_MspInit(XSPI_HandleTypeDef* hxspi)
+static uint32_t norflash_erase_background_clock(void)
 {
-    RCC_PeriphCLKInitTypeDef rcc_periph_clk_init_struct = {0};
-    GPIO_InitTypeDef gpio_init_struct = {0};
-    
-    if (hxspi->Instance == XSPI1)
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
     {
-        /* ʱԴ */
-        rcc_periph_clk_init_struct.PeriphClockSelection = RCC_PERIPHCLK_XSPI1;
-        rcc_periph_clk_init_struct.Xspi1ClockSelection = RCC_XSPI1CLKSOURCE_PLL2S;
-        HAL_RCCEx_PeriphCLKConfig(&rcc_periph_clk_init_struct);
-        
-        /* ʹʱ */
-        __HAL_RCC_XSPIM_CLK_ENABLE();
-        __HAL_RCC_XSPI1_CLK_ENABLE();
-        __HAL_RCC_GPIOP_CLK_ENABLE();
-        __HAL_RCC_GPIOO_CLK_ENABLE();
-        
-        /* ʼͨѶ */
-        gpio_init_struct.Pin = GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7;
-        gpio_init_struct.Mode = GPIO_MODE_AF_PP;
-        gpio_init_struct.Pull = GPIO_NOPULL;
-        gpio_init_struct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
-        gpio_init_struct.Alternate = GPIO_AF9_XSPIM_P1;
-        HAL_GPIO_Init(GPIOP, &gpio_init_struct);
-        gpio_init_struct.Pin = GPIO_PIN_0 | GPIO_PIN_2 | GPIO_PIN_4;
-        gpio_init_struct.Mode = GPIO_MODE_AF_PP;
-        gpio_init_struct.Pull = GPIO_NOPULL;
-        gpio_init_struct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
-        gpio_init_struct.Alternate = GPIO_AF9_XSPIM_P1;
-        HAL_GPIO_Init(GPIOO, &gpio_init_struct);
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->LAR = 0xC5ACCE55;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
     }
+    
+    return (SystemCoreClock / 1000000 != 0) ? (SystemCoreClock / 1000000) : 1;
 }
 
 /**
- * @brief   HALXSPIʼص
- * @param   hxspi: XSPIָ
- * @retval  
+ * @brief   ִһNOR Flash̨ʱƬ
+ * @note    norflash_memory_mapped_suspend()˳ڴӳ䣨ԭڴӳģʽʱжϣ
+ *          ָѹĲһԪѯWIPbudget룬δ
+ *          ǰָڴӳж״̬ʱӳ䴰ڿȡ
+ *          жڼHAL_GetTick()ʱƬDWTڼʱжӳԼΪһʱƬ
+ *          ڴӳеĳITCMڲRAMñ
+ * @param   budget: ʱƬȣλmsNORFLASH_ERASE_BG_MIN_SLICE~NORFLASH_ERASE_BG_MAX_SLICE
+ * @retval  ִн
+ * @arg     0: ִгɹ
+ * @arg     1: ִʧܣֹ̨
  */
-void HAL_XSPI_MspDeInit(XSPI_HandleTypeDef* hxspi)
+uint8_t norflash_erase_background_run(uint32_t budget)
 {
-    if (hxspi->Instance == XSPI1)
+    uint32_t cycles_per_us;
+    uint32_t slice;
+    uint32_t start;
+    uint32_t unit_start;
+    uint32_t context;
+    uint8_t busy = 1;
+    uint8_t suspended;
+    uint8_t res = 0;
+    
+    if (norflash == NULL)
     {
-        /* ʱ */
-        __HAL_RCC_XSPIM_CLK_DISABLE();
-        __HAL_RCC_XSPI1_CLK_DISABLE();
-        
-        /* ʼͨѶ */
-        HAL_GPIO_DeInit(GPIOP, GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7);
-        HAL_GPIO_DeInit(GPIOO, GPIO_PIN_0 | GPIO_PIN_2 | GPIO_PIN_4);
+        return 1;
     }
-}
-#endif /* __SYS_H */
-
-/**
- * @brief   ʼNOR Flash
- * @param   
- * @retval  NOR Flash豸ͣοnorflash.hļеnorflash_type_t壩
- */
-norflash_type_t norflash_init(void)
-{
-    uint8_t norflash_index;
     
-    if (norflash != NULL)
+    if (norflash_erase_bg.state == NORFLASH_ERASE_BG_STATE_IDLE)
     {
-        if (norflash_deinit() != 0)
-        {
-            return 1;
-        }
+        return 0;
     }
     
-    for (norflash_index = 0; norflash_index < (sizeof(norflashs) / sizeof(norflashs[0])); norflash_index++)
+    if (norflash_async.count != 0)
     {
-        /* ʼXSPI1 */
-        if (norflash_xspi1_init(&xspi1_handle, norflashs[norflash_index]->type) != 0)
+        return 1;
+    }
+    
+    if (budget < NORFLASH_ERASE_BG_MIN_SLICE)
+    {
+        budget = NORFLASH_ERASE_BG_MIN_SLICE;
+    }
+    if (budget > NORFLASH_ERASE_BG_MAX_SLICE)
+    {
+        budget = NORFLASH_ERASE_BG_MAX_SLICE;
+    }
+    cycles_per_us = norflash_erase_background_clock();
+    slice = budget * 1000 * cycles_per_us;
+    
+    if (norflash_memory_mapped_suspend(&context) != 0)
+    {
+        return 1;
+    }
+    
+    norflash_erase_bg.progress.slices++;
+    start = DWT->CYCCNT;
+    while (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE)
+    {
+        if ((DWT->CYCCNT - start) >= slice)
         {
             break;
         }
         
-        if (norflashs[norflash_index]->ops.init == NULL)
+        if (norflash_erase_bg.state == NORFLASH_ERASE_BG_STATE_SUSPENDED)
+        {
+            if (norflash->ops.erase_resume(&xspi1_handle) != 0)
+            {
+                res = 1;
+                break;
+            }
+            norflash_erase_bg.state = NORFLASH_ERASE_BG_STATE_RUNNING;
+        }
+        else
         {
+            if (norflash_erase_background_issue() != 0)
+            {
+                res = 1;
+                break;
+            }
+            if (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_RUNNING)
+            {
+                continue;
+            }
+        }
+        
+        /* ѯWIPɻʱƬ */
+        unit_start = DWT->CYCCNT;
+        do
+        {
+            if (norflash->ops.read_busy(&xspi1_handle, &busy) != 0)
+            {
+                res = 1;
+                break;
+            }
+        } while ((busy != 0) && ((DWT->CYCCNT - start) < slice));
+        norflash_erase_bg.unit_time += (DWT->CYCCNT - unit_start) / cycles_per_us;
+        
+        if (res != 0)
+        {
+            break;
+        }
+        
+        if (busy == 0)
+        {
+            norflash_erase_background_unit_done();
             continue;
         }
         
-        /* ʼNOR Flash豸 */
-        if (norflashs[norflash_index]->ops.init(&xspi1_handle) == 0)
+        if (norflash_erase_bg.unit_time > (NORFLASH_ERASE_BG_UNIT_TIMEOUT * 1000))
         {
-//            if (norflashs[norflash_index]->type == NORFlash_MX25UM25645G)
-//            {
-//                /* MX25UM25645G֧200MHzʱ */
-//                HAL_XSPI_SetClockPrescaler(&xspi1_handle, 2 - 1);
-//            }
-            norflash = norflashs[norflash_index];
-            return norflash->type;
+            res = 1;
+            break;
+        }
+        
+        /* ʱƬ꣬ */
+        if (norflash->ops.erase_suspend(&xspi1_handle, &suspended) != 0)
+        {
+            res = 1;
+            break;
+        }
+        if (suspended != 0)
+        {
+            norflash_erase_bg.progress.suspends++;
+            norflash_erase_bg.state = NORFLASH_ERASE_BG_STATE_SUSPENDED;
         }
+        else
+        {
+            norflash_erase_background_unit_done();
+        }
+        break;
     }
     
-    return NORFlash_Unknow;
+    if (res != 0)
+    {
+        norflash_erase_bg.progress.error = 1;
+        norflash_erase_bg.state = NORFLASH_ERASE_BG_STATE_IDLE;
+    }
+    norflash_erase_bg.progress.busy = (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE) ? 1 : 0;
+    
+    if (norflash_memory_mapped_resume(context) != 0)
+    {
+        return 1;
+    }
+    
+    return res;
 }
 
 /**
- * @brief   ʼNOR Flash
+ * @brief   ѯNOR Flash̨Ƿ
  * @param   
- * @retval  ʼ
- * @arg     0: ʼɹ
- * @arg     1: ʼʧ
+ * @retval  ѯ
+ * @arg     0: 
+ * @arg     1: 
  */
-uint8_t norflash_deinit(void)
+uint8_t norflash_erase_background_busy(void)
 {
-    if (norflash == NULL)
+    return (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE) ? 1 : 0;
+}
+
+/**
+ * @brief   ȡNOR Flash̨
+ * @param   progress: Ƚṹָ
+ * @retval  
+ */
+void norflash_erase_background_get_progress(norflash_erase_progress_t *progress)
+{
+    if (progress != NULL)
+    {
+        *progress = norflash_erase_bg.progress;
+    }
+}
+
+
+/**
+ * @brief   NOR Flash첽һдʹܣ
+ * @param   
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: ʧ
+ */
+static uint8_t norflash_async_step_start(void)
+{
+    norflash_async_request_t *request = &norflash_async.queue[norflash_async.head];
+    uint32_t page_size;
+    uint32_t block_size;
+    
+    if (norflash->ops.write_enable_it == NULL)
     {
         return 1;
     }
     
-    /* ʼNOR Flash豸 */
-    if (norflash->ops.deinit != NULL)
+    if (request->type == NORFLASH_ASYNC_TYPE_WRITE)
     {
-        if (norflash->ops.deinit(&xspi1_handle) != 0)
+        /* ҳ߽ */
+        page_size = norflash->parameter.page_size;
+        norflash_async.step_length = page_size - (request->address % page_size);
+        if (norflash_async.step_length > request->length)
         {
-            return 1;
+            norflash_async.step_length = request->length;
+        }
+        norflash_async.step_timeout = NORFLASH_ASYNC_STEP_TIMEOUT;
+    }
+    else
+    {
+        /* ʹôȲ */
+        block_size = norflash->parameter.block_size;
+        if ((request->address == 0) && (request->length >= norflash->parameter.chip_size) && (norflash->ops.erase_chip_start != NULL))
+        {
+            norflash_async.step_length = norflash->parameter.chip_size;
+            norflash_async.step_timeout = NORFLASH_ASYNC_CHIP_ERASE_TIMEOUT;
+        }
+        else if (((request->address % block_size) == 0) && (request->length >= block_size) && (norflash->ops.erase_block_start != NULL))
+        {
+            norflash_async.step_length = block_size;
+            norflash_async.step_timeout = NORFLASH_ASYNC_STEP_TIMEOUT;
+        }
+        else
+        {
+            norflash_async.step_length = norflash->parameter.sector_size;
+            norflash_async.step_timeout = NORFLASH_ASYNC_STEP_TIMEOUT;
         }
     }
     
-    /* ʼXSPI1 */
-    if (norflash_xspi1_deinit(&xspi1_handle) != 0)
+    norflash_async.step_tick = HAL_GetTick();
+    norflash_async.state = NORFLASH_ASYNC_STATE_WEL;
+    if (norflash->ops.write_enable_it(&xspi1_handle) != 0)
     {
+        norflash_async.state = NORFLASH_ASYNC_STATE_IDLE;
         return 1;
     }
     
-    norflash = NULL;
-    
     return 0;
 }
 
 /**
- * @brief   ȫƬNOR Flash
- * @param   
- * @retval  ȫƬ
- * @arg     0: ȫƬɹ
- * @arg     1: ȫƬʧ
+ * @brief   NOR Flashǰ첽еһ
+ * @param   result: ǰ
+ * @retval  
  */
-uint8_t norflash_erase_chip(void)
+static void norflash_async_finish(uint8_t result)
 {
-    if (norflash == NULL)
+    norflash_async_callback_t callback;
+    void *arg;
+    
+    while (1)
     {
-        return 1;
+        callback = norflash_async.queue[norflash_async.head].callback;
+        arg = norflash_async.queue[norflash_async.head].arg;
+        norflash_async.state = NORFLASH_ASYNC_STATE_IDLE;
+        norflash_async.head = (norflash_async.head + 1) % NORFLASH_ASYNC_QUEUE_SIZE;
+        norflash_async.count--;
+        
+        if (callback != NULL)
+        {
+            callback(result, arg);
+        }
+        
+        /* صпѷ² */
+        if ((norflash_async.count == 0) || (norflash_async.state != NORFLASH_ASYNC_STATE_IDLE))
+        {
+            return;
+        }
+        
+        if (norflash_async_step_start() == 0)
+        {
+            return;
+        }
+        result = 1;
     }
+}
+
+/**
+ * @brief   дʹɺ̻
+ * @param   
+ * @retval  
+ */
+static void norflash_async_step_issue(void)
+{
+    norflash_async_request_t *request = &norflash_async.queue[norflash_async.head];
+    uint8_t res = 1;
     
-    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    if (request->type == NORFLASH_ASYNC_TYPE_WRITE)
     {
-        return 1;
+        norflash_async.state = NORFLASH_ASYNC_STATE_TX;
+        if (norflash->ops.program_page_dma != NULL)
+        {
+            res = norflash->ops.program_page_dma(&xspi1_handle, request->address, request->data, norflash_async.step_length);
+        }
     }
-    
-    /* ȫƬNOR Flash豸 */
-    if (norflash->ops.erase_chip != NULL)
+    else
     {
-        if (norflash->ops.erase_chip(&xspi1_handle) == 0)
+        norflash_async.state = NORFLASH_ASYNC_STATE_WIP;
+        if (norflash_async.step_length == norflash->parameter.chip_size)
         {
-            return 0;
+            res = norflash->ops.erase_chip_start(&xspi1_handle);
+        }
+        else if (norflash_async.step_length == norflash->parameter.block_size)
+        {
+            res = norflash->ops.erase_block_start(&xspi1_handle, request->address);
+        }
+        else if (norflash->ops.erase_sector_start != NULL)
+        {
+            res = norflash->ops.erase_sector_start(&xspi1_handle, request->address);
+        }
+        
+        if ((res == 0) && (norflash->ops.wait_ready_it != NULL))
+        {
+            res = norflash->ops.wait_ready_it(&xspi1_handle);
+        }
+        else
+        {
+            res = 1;
         }
     }
     
-    return 1;
+    if (res != 0)
+    {
+        norflash_async_finish(1);
+    }
 }
 
 /**
- * @brief   NOR Flash
- * @param   address: ַ
- * @retval  
- * @arg     0: ɹ
- * @arg     1: ʧ
+ * @brief   һ̻ɺƽǰ첽
+ * @param   
+ * @retval  
  */
-uint8_t norflash_erase_block(uint32_t address)
+static void norflash_async_step_done(void)
 {
-    if (norflash == NULL)
+    norflash_async_request_t *request = &norflash_async.queue[norflash_async.head];
+    
+    request->address += norflash_async.step_length;
+    if (request->data != NULL)
     {
-        return 1;
+        request->data += norflash_async.step_length;
     }
+    request->length -= norflash_async.step_length;
     
-    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    if (request->length == 0)
     {
-        return 1;
+        norflash_async_finish(0);
     }
-    
-    /* NOR Flash豸 */
-    if (norflash->ops.erase_block != NULL)
+    else if (norflash_async_step_start() != 0)
     {
-        if (norflash->ops.erase_block(&xspi1_handle, address) == 0)
-        {
-            return 0;
-        }
+        norflash_async_finish(1);
     }
-    
-    return 1;
 }
 
 /**
- * @brief   NOR Flash
- * @param   address: ַ
- * @retval  
- * @arg     0: ɹ
- * @arg     1: ʧ
+ * @brief   NOR Flash첽
+ * @param   type: 
+ * @param   address: ʼַ
+ * @param   data: дݣʱΪNULL
+ * @param   length: 
+ * @param   callback: ɻص
+ * @param   arg: ɻص
+ * @retval  ӽ
+ * @arg     0: ӳɹ
+ * @arg     1: ʧ
  */
-uint8_t norflash_erase_sector(uint32_t address)
+static uint8_t norflash_async_submit(uint8_t type, uint32_t address, uint8_t *data, uint32_t length, norflash_async_callback_t callback, void *arg)
 {
-    if (norflash == NULL)
-    {
-        return 1;
-    }
+    norflash_async_request_t *request;
+    uint32_t primask;
+    uint8_t res = 0;
     
-    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    primask = __get_PRIMASK();
+    __disable_irq();
+    
+    if ((norflash_async.count >= NORFLASH_ASYNC_QUEUE_SIZE) || (norflash_erase_bg.state != NORFLASH_ERASE_BG_STATE_IDLE))
     {
+        __set_PRIMASK(primask);
         return 1;
     }
     
-    /* NOR Flash豸 */
-    if (norflash->ops.erase_sector != NULL)
+    request = &norflash_async.queue[(norflash_async.head + norflash_async.count) % NORFLASH_ASYNC_QUEUE_SIZE];
+    request->type = type;
+    request->address = address;
+    request->data = data;
+    request->length = length;
+    request->callback = callback;
+    request->arg = arg;
+    norflash_async.count++;
+    
+    if (norflash_async.state == NORFLASH_ASYNC_STATE_IDLE)
     {
-        if (norflash->ops.erase_sector(&xspi1_handle, address) == 0)
+        if (norflash_async_step_start() != 0)
         {
-            return 0;
+            norflash_async.count--;
+            res = 1;
         }
     }
     
-    return 1;
+    __set_PRIMASK(primask);
+    
+    return res;
 }
 
 /**
- * @brief   ҳNOR Flash
- * @param   address: ҳַ
+ * @brief   첽дNOR Flash
+ * @note    ĿѲҳֺDMAͣȫдcallback
+ *          dataڻصǰЧλDMAɷʵĴ洢λDTCM
+ * @param   address: ַ
  * @param   data: ݻָ
  * @param   length: ݳ
- * @retval  ҳ̽
- * @arg     0: ҳ̳ɹ
- * @arg     1: ҳʧ
+ * @param   callback: ɻصжеãΪNULL
+ * @param   arg: ɻص
+ * @retval  
+ * @arg     0: 
+ * @arg     1: ʧ
  */
-uint8_t norflash_program_page(uint32_t address, uint8_t *data, uint32_t length)
+uint8_t norflash_write_async(uint32_t address, uint8_t *data, uint32_t length, norflash_async_callback_t callback, void *arg)
 {
     if (norflash == NULL)
     {
@@ -1360,297 +4052,160 @@ uint8_t norflash_program_page(uint32_t address, uint8_t *data, uint32_t length)
         return 1;
     }
     
-    if (length > norflash->parameter.page_size)
+    if ((data == NULL) || (length == 0) || (address >= norflash->parameter.chip_size) || (length > (norflash->parameter.chip_size - address)))
     {
         return 1;
     }
     
-    /* ҳNOR Flash豸 */
-    if (norflash->ops.program_page != NULL)
+    if (norflash->ops.program_page_dma == NULL)
     {
-        if (norflash->ops.program_page(&xspi1_handle, address, data, length) == 0)
-        {
-            return 0;
-        }
+        return 1;
     }
     
-    return 1;
+    return norflash_async_submit(NORFLASH_ASYNC_TYPE_WRITE, address, data, length, callback, arg);
 }
 
 /**
- * @brief   NOR Flash
+ * @brief   첽NOR Flash
+ * @note    Χ뵽ʹÿƬʹȫƬ
  * @param   address: ַ
- * @param   data: ݻָ
- * @param   length: ݳ
- * @retval  
- * @arg     0: ɹ
- * @arg     1: ʧ
+ * @param   length: 
+ * @param   callback: ɻصжеãΪNULL
+ * @param   arg: ɻص
+ * @retval  
+ * @arg     0: 
+ * @arg     1: ʧ
  */
-uint8_t norflash_read(uint32_t address, uint8_t *data, uint32_t length)
+uint8_t norflash_erase_async(uint32_t address, uint32_t length, norflash_async_callback_t callback, void *arg)
 {
-    uint32_t index;
-    uint32_t length_16b;
+    uint32_t sector_size;
+    uint32_t end;
     
     if (norflash == NULL)
     {
         return 1;
     }
     
-    /* ڴӳ״ֱ̬Ӵӳַȡ */
     if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
     {
-        length_16b = length >> 1;
-        for (index = 0; index < length_16b; index++)
-        {
-            ((uint16_t *)data)[index] = ((volatile uint16_t *)(NORFLASH_MEMORY_MAPPED_BASE + address))[index];
-        }
-        
-        if (length & 1UL)
-        {
-            data[length - 1] = *(volatile uint8_t *)(NORFLASH_MEMORY_MAPPED_BASE + address + length - 1);
-        }
-        
-        return 0;
+        return 1;
     }
     
-    /* NOR Flash豸 */
-    if (norflash->ops.read != NULL)
+    if ((length == 0) || (address >= norflash->parameter.chip_size) || (length > (norflash->parameter.chip_size - address)))
     {
-        if (norflash->ops.read(&xspi1_handle, address, data, length) == 0)
-        {
-            return 0;
-        }
+        return 1;
     }
     
-    return 1;
+    sector_size = norflash->parameter.sector_size;
+    end = ((address + length + sector_size - 1) / sector_size) * sector_size;
+    address = (address / sector_size) * sector_size;
+    
+    return norflash_async_submit(NORFLASH_ASYNC_TYPE_ERASE, address, NULL, end - address, callback, arg);
 }
 
 /**
- * @brief   NOR Flashڴӳ
+ * @brief   ѯNOR Flash첽Ƿ
+ * @note    ͬʱ鵱ǰǷʱʱֹʧܽǰ
  * @param   
- * @retval  ڴӳ
- * @arg     0: ڴӳɹ
- * @arg     1: ڴӳʧ
+ * @retval  ѯ
+ * @arg     0: 
+ * @arg     1: 
  */
-uint8_t norflash_memory_mapped(void)
+uint8_t norflash_async_busy(void)
 {
-    if (norflash == NULL)
-    {
-        return 1;
-    }
+    uint32_t primask;
     
-    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
-    {
-        return 0;
-    }
+    primask = __get_PRIMASK();
+    __disable_irq();
     
-    /* NOR Flash豸ڴӳ */
-    if (norflash->ops.memory_mapped != NULL)
+    if ((norflash_async.state != NORFLASH_ASYNC_STATE_IDLE) && ((HAL_GetTick() - norflash_async.step_tick) > norflash_async.step_timeout))
     {
-        if (norflash->ops.memory_mapped(&xspi1_handle) == 0)
-        {
-            return 0;
-        }
+        HAL_XSPI_Abort(&xspi1_handle);
+        norflash_async_finish(1);
     }
     
-    return 1;
+    __set_PRIMASK(primask);
+    
+    return (norflash_async.count != 0) ? 1 : 0;
 }
 
 /**
- * @brief   ȡNOR Flashֵ
- * @param   
- * @retval  NOR Flashֵ
+ * @brief   HALXSPI״̬ƥص
+ * @param   hxspi: XSPIָ
+ * @retval  
  */
-uint8_t norflash_get_empty_value(void)
+void HAL_XSPI_StatusMatchCallback(XSPI_HandleTypeDef *hxspi)
 {
-    if (norflash == NULL)
+    if (hxspi != &xspi1_handle)
     {
-        return 0;
+        return;
     }
     
-    return norflash->parameter.empty_value;
-}
-
-/**
- * @brief   ȡNOR FlashƬС
- * @param   
- * @retval  NOR FlashƬС
- */
-uint32_t norflash_get_chip_size(void)
-{
-    if (norflash == NULL)
+    if (norflash_async.state == NORFLASH_ASYNC_STATE_WEL)
     {
-        return 0;
+        norflash_async_step_issue();
+    }
+    else if (norflash_async.state == NORFLASH_ASYNC_STATE_WIP)
+    {
+        norflash_async_step_done();
     }
-    
-    return norflash->parameter.chip_size;
 }
 
 /**
- * @brief   ȡNOR FlashС
- * @param   
- * @retval  NOR FlashС
+ * @brief   HALXSPIɻص
+ * @param   hxspi: XSPIָ
+ * @retval  
  */
-uint32_t norflash_get_block_size(void)
+void HAL_XSPI_TxCpltCallback(XSPI_HandleTypeDef *hxspi)
 {
-    if (norflash == NULL)
+    if ((hxspi != &xspi1_handle) || (norflash_async.state != NORFLASH_ASYNC_STATE_TX))
     {
-        return 0;
+        return;
     }
     
-    return norflash->parameter.block_size;
+    norflash_async.state = NORFLASH_ASYNC_STATE_WIP;
+    if (norflash->ops.wait_ready_it(&xspi1_handle) != 0)
+    {
+        norflash_async_finish(1);
+    }
 }
 
 /**
- * @brief   ȡNOR FlashС
- * @param   
- * @retval  NOR FlashС
+ * @brief   HALXSPIص
+ * @param   hxspi: XSPIָ
+ * @retval  
  */
-uint32_t norflash_get_sector_size(void)
+void HAL_XSPI_ErrorCallback(XSPI_HandleTypeDef *hxspi)
 {
-    if (norflash == NULL)
+    if ((hxspi != &xspi1_handle) || (norflash_async.state == NORFLASH_ASYNC_STATE_IDLE))
     {
-        return 0;
+        return;
     }
     
-    return norflash->parameter.sector_size;
+    norflash_async_finish(1);
 }
 
 /**
- * @brief   ȡNOR FlashҳС
+ * @brief   NOR Flash XSPI1жϴXSPI1_IRQHandler()еã
  * @param   
- * @retval  NOR FlashҳС
+ * @retval  
  */
-uint32_t norflash_get_page_size(void)
+void norflash_xspi1_irq_handler(void)
 {
-    if (norflash == NULL)
-    {
-        return 0;
-    }
-    
-    return norflash->parameter.page_size;
+    HAL_XSPI_IRQHandler(&xspi1_handle);
 }
 
+#ifndef __SYS_H
 /**
- * @brief   дNOR Flash
- * @param   address: ַ
- * @param   data: ݻָ
- * @param   length: ݳ
- * @retval  д
- * @arg     0: дɹ
- * @arg     1: дʧ
+ * @brief   NOR Flash DMAжϴHPDMA1_Channel0_IRQHandler()еã
+ * @param   
+ * @retval  
  */
-uint8_t norflash_write(uint32_t address, uint8_t *data, uint32_t length)
+void norflash_dma_irq_handler(void)
 {
-    uint32_t sector_size;
-    uint32_t sectors_index;
-    uint32_t sector_offset;
-    uint32_t sector_remain;
-    uint32_t sector_write_length;
-    uint32_t data_index;
-    uint32_t page_size;
-    uint32_t pages_index;
-    uint32_t page_offset;
-    uint32_t page_remain;
-    uint32_t page_write_length;
-    
-    if (norflash == NULL)
-    {
-        return 1;
-    }
-    
-    if (xspi1_handle.State == HAL_XSPI_STATE_BUSY_MEM_MAPPED)
-    {
-        return 1;
-    }
-    
-    sector_size = norflash_get_sector_size();
-    page_size = norflash_get_page_size();
-    
-    /* NOR FlashСУ */
-    if (sector_size > (sizeof(norflash_sector_buffer) / sizeof(norflash_sector_buffer[0])))
-    {
-        return 1;
-    }
-    
-    sectors_index = address / sector_size;
-    sector_offset = address % sector_size;
-    while (length != 0)
-    {
-        sector_remain = sector_size - sector_offset;
-        sector_write_length = (length < sector_remain) ? length : sector_remain;
-        length -= sector_write_length;
-        
-        /* ȡNOR Flash */
-        if(norflash_read(sectors_index * sector_size, norflash_sector_buffer, sector_size) != 0)
-        {
-            return 1;
-        }
-        
-        /* NOR FlashдλݿУ */
-        for (data_index = 0; data_index < sector_write_length; data_index++)
-        {
-            if (norflash_sector_buffer[sector_offset + data_index] != norflash_get_empty_value())
-            {
-                break;
-            }
-        }
-        
-        /* NOR Flashдλзǿ */
-        if (data_index < sector_write_length)
-        {
-            /* NOR Flash */
-            if (norflash_erase_sector(sectors_index * sector_size) != 0)
-            {
-                return 1;
-            }
-            
-            /* ддNOR Flash */
-            for (data_index = 0; data_index < sector_write_length; data_index++)
-            {
-                norflash_sector_buffer[sector_offset + data_index] = *data;
-                data++;
-            }
-            
-            /* NOR FlashдNOR Flash */
-            for (pages_index = 0; pages_index < (sector_size / page_size); pages_index++)
-            {
-                if (norflash_program_page(sectors_index * sector_size + pages_index * page_size, &norflash_sector_buffer[pages_index * page_size], page_size) != 0)
-                {
-                    return 1;
-                }
-            }
-        }
-        /* NOR Flashдλ޷ǿ */
-        else
-        {
-            pages_index = sector_offset / page_size;
-            page_offset = sector_offset % page_size;
-            while (sector_write_length != 0)
-            {
-                page_remain = page_size - page_offset;
-                page_write_length = (sector_write_length < page_remain) ? sector_write_length : page_remain;
-                sector_write_length -= page_write_length;
-                
-                /* ддNOR Flash */
-                if (norflash_program_page(sectors_index * sector_size + pages_index * page_size + page_offset, data, page_write_length) != 0)
-                {
-                    return 1;
-                }
-                data += page_write_length;
-                
-                pages_index++;
-                page_offset = 0;
-            }
-        }
-        
-        sectors_index++;
-        sector_offset = 0;
-    }
-    
-    return 0;
+    HAL_DMA_IRQHandler(&norflash_dma_handle);
 }
-
+#endif /* __SYS_H */
 
 /**
  * @brief   NOR Flashڴӳ
@@ -1661,19 +4216,18 @@ uint8_t norflash_write(uint32_t address, uint8_t *data, uint32_t length)
  */
 static uint8_t norflash_ex_enter_mmap(void)
 {
-    norflash_init();
-    if (norflash_memory_mapped() != 0)
-    {
-        return 1;
-    }
+    uint8_t res;
+    
+    res = norflash_memory_mapped();
     
     __enable_irq();
     
-    return 0;
+    return res;
 }
 
 /**
  * @brief   ˳NOR Flashڴӳ
+ * @note    Ƚֹڴӳ䣬ʧʱ³ʼNOR Flash
  * @param   
  * @retval  ˳ڴӳ
  * @arg     0: ˳ڴӳɹ
@@ -1682,8 +4236,11 @@ static uint8_t norflash_ex_enter_mmap(void)
 static uint8_t norflash_ex_exit_mmap(void)
 {
     __disable_irq();
-    SCB_InvalidateICache();
-    SCB_InvalidateDCache();
+    if (norflash_memory_mapped_exit() == 0)
+    {
+        return 0;
+    }
+    
     if (norflash_init() == NORFlash_Unknow)
     {
         return 1;
@@ -1692,6 +4249,23 @@ static uint8_t norflash_ex_exit_mmap(void)
     return 0;
 }
 
+/**
+ * @brief   ЧNOR FlashӳַΧCache
+ * @param   address: ַ
+ * @param   length: ݳ
+ * @retval  
+ */
+static void norflash_ex_invalidate_cache(uint32_t address, uint32_t length)
+{
+    if (length == 0)
+    {
+        return;
+    }
+    
+    SCB_InvalidateDCache_by_Addr((volatile void *)(NORFLASH_MEMORY_MAPPED_BASE + address), (int32_t)length);
+    SCB_InvalidateICache_by_Addr((volatile void *)(NORFLASH_MEMORY_MAPPED_BASE + address), (int32_t)length);
+}
+
 /**
  * @brief   ʼNOR Flash
  * @param   
@@ -1734,6 +4308,7 @@ uint8_t norflash_ex_write(uint32_t address, uint8_t *data, uint32_t length)
         res = norflash_write(address, data, length);
     }
     
+    norflash_ex_invalidate_cache(address, length);
     norflash_ex_enter_mmap();
     
     return res;
@@ -1777,6 +4352,7 @@ uint8_t norflash_ex_erase_sector(uint32_t address)
         res = norflash_erase_sector(address);
     }
     
+    norflash_ex_invalidate_cache(address & ~(norflash_get_sector_size() - 1), norflash_get_sector_size());
     norflash_ex_enter_mmap();
     
     return res;
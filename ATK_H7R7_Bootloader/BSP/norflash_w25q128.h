@@ -30,11 +30,31 @@
 /* NOR FlashС */
 #define NORFLASH_SECTOR_BUFFER_SIZE (0x00002000UL)
 
+/* NOR Flash첽ȶ */
+#define NORFLASH_ASYNC_QUEUE_SIZE   (8)
+
 /* NOR Flashڴӳַ */
 #define NORFLASH_MEMORY_MAPPED_BASE (XSPI1_BASE)
 
+/* NOR FlashУͼС壨ͼλһ */
+#define NORFLASH_READ_PATTERN_SIZE  (0x00000200UL)
+
+/* NOR Flashʱӳɨ跶Χ벽 */
+#define NORFLASH_READ_DELAY_MAX     (0x7FUL)
+#define NORFLASH_READ_DELAY_STEP    (8UL)
+
+/* NOR Flash˳ڴӳĶ壨norflash_memory_mapped_suspend()棩 */
+#define NORFLASH_MAPPED_CONTEXT_MAPPED  (1UL << 0)  /* ԭڴӳģʽ */
+#define NORFLASH_MAPPED_CONTEXT_PRIMASK (1UL << 1)  /* ԭж */
+
+/* NOR Flash̨ʱƬ壨λms̵ʱƬʹڹ/ָƽ */
+#define NORFLASH_ERASE_BG_MIN_SLICE (2UL)
+
+/* NOR Flash̨ʱƬ壨λmsʱƬжDWTڼʱ600MHzʱԼ7һΣ */
+#define NORFLASH_ERASE_BG_MAX_SLICE (1000UL)
+
 /* NOR Flash豸Ͷ */
-typedef enum : uint8_t {
+typedef enum {
     NORFlash_Unknow = 0,    /* δ֪ */
 #ifdef NORFLASH_SUPPORT_MX25UM25645G
     NORFlash_MX25UM25645G,  /* MX25UM25645G */
@@ -45,6 +65,14 @@ typedef enum : uint8_t {
     NORFlash_Dummy,
 } norflash_type_t;
 
+/* NOR Flashö */
+typedef enum {
+    NORFlash_Read_Normal = 0,   /* 1-4-4 SDRÿζָ */
+    NORFlash_Read_XIP,          /* 1-4-4 SDRʱӣģʽʡָ */
+    NORFlash_Read_XIP_DTR,      /* 1-4-4 DTRģʽʡָ֧DTR */
+    NORFlash_Read_Dummy,
+} norflash_read_profile_t;
+
 /* NOR Flash豸 */
 typedef struct {
     /* NOR Flash豸 */
@@ -55,8 +83,13 @@ typedef struct {
         uint8_t empty_value;    /* ֵ */
         uint32_t chip_size;     /* ȫƬС */
         uint32_t block_size;    /* С */
+        uint32_t half_block_size;       /* С */
         uint32_t sector_size;   /* С */
         uint32_t page_size;     /* ҳС */
+        uint32_t chip_erase_time;       /* ȫƬʱ䣨룩 */
+        uint32_t block_erase_time;      /* ʱ䣨룩 */
+        uint32_t half_block_erase_time; /* ʱ䣨룩 */
+        uint32_t sector_erase_time;     /* ʱ䣨룩 */
     } parameter;
     
     /* NOR Flash */
@@ -65,13 +98,52 @@ typedef struct {
         uint8_t (*deinit)(XSPI_HandleTypeDef *hxspi);                                                           /* ʼ */
         uint8_t (*erase_chip)(XSPI_HandleTypeDef *hxspi);                                                       /* ȫƬ */
         uint8_t (*erase_block)(XSPI_HandleTypeDef *hxspi, uint32_t address);                                    /*  */
+        uint8_t (*erase_half_block)(XSPI_HandleTypeDef *hxspi, uint32_t address);                               /*  */
         uint8_t (*erase_sector)(XSPI_HandleTypeDef *hxspi, uint32_t address);                                   /*  */
         uint8_t (*program_page)(XSPI_HandleTypeDef *hxspi, uint32_t address, uint8_t *data, uint32_t length);   /* ҳ */
         uint8_t (*read)(XSPI_HandleTypeDef *hxspi, uint32_t address, uint8_t *data, uint32_t length);           /*  */
         uint8_t (*memory_mapped)(XSPI_HandleTypeDef *hxspi);                                                    /* ڴӳ */
+        uint8_t (*memory_mapped_exit)(XSPI_HandleTypeDef *hxspi);                                               /* ˳ڴӳ */
+        uint8_t (*set_read_profile)(XSPI_HandleTypeDef *hxspi, norflash_read_profile_t profile);                /* ö */
+        uint8_t (*write_enable_it)(XSPI_HandleTypeDef *hxspi);                                                  /* дʹܲжѯWEL */
+        uint8_t (*wait_ready_it)(XSPI_HandleTypeDef *hxspi);                                                    /* жѯWIP */
+        uint8_t (*erase_chip_start)(XSPI_HandleTypeDef *hxspi);                                                 /* ȫƬ */
+        uint8_t (*erase_block_start)(XSPI_HandleTypeDef *hxspi, uint32_t address);                              /*  */
+        uint8_t (*erase_sector_start)(XSPI_HandleTypeDef *hxspi, uint32_t address);                             /*  */
+        uint8_t (*program_page_dma)(XSPI_HandleTypeDef *hxspi, uint32_t address, uint8_t *data, uint32_t length);   /* DMAҳ */
+        uint8_t (*write_enable)(XSPI_HandleTypeDef *hxspi);                                                     /* дʹ */
+        uint8_t (*wait_ready)(XSPI_HandleTypeDef *hxspi, uint32_t timeout);                                     /* ѯWIPֱʱ */
+        uint8_t (*read_busy)(XSPI_HandleTypeDef *hxspi, uint8_t *busy);                                         /* ȡWIPȴ */
+        uint8_t (*erase_suspend)(XSPI_HandleTypeDef *hxspi, uint8_t *suspended);                                /*  */
+        uint8_t (*erase_resume)(XSPI_HandleTypeDef *hxspi);                                                     /* ָ */
     } ops;
 } norflash_t;
 
+/* NOR Flash첽ɻص壨жеãresult: 0: ɹ; 1: ʧܣ */
+typedef void (*norflash_async_callback_t)(uint8_t result, void *arg);
+
+/* NOR FlashΧ涨 */
+typedef struct {
+    uint32_t chip_erases;       /* ȫƬ */
+    uint32_t block_erases;      /*  */
+    uint32_t half_block_erases; /*  */
+    uint32_t sector_erases;     /*  */
+    uint32_t blank_sectors;     /* Ϊն */
+    uint32_t expected_time;     /* Ͳʱĺʱ룩 */
+    uint32_t actual_time;       /* ʵʺʱ룬գ */
+} norflash_erase_report_t;
+
+/* NOR Flash̨ȶ */
+typedef struct {
+    uint32_t total;         /* ܳ */
+    uint32_t done;          /* ɳȣΪնĳȣ */
+    uint32_t skipped;       /* Ϊնĳ */
+    uint32_t slices;        /* ִеʱƬ */
+    uint32_t suspends;      /*  */
+    uint8_t busy;           /*  */
+    uint8_t error;          /* ֹ */
+} norflash_erase_progress_t;
+
 /* NOR Flash豸 */
 extern const norflash_t norflash_w25q128_dual;
 
@@ -80,16 +152,35 @@ norflash_type_t norflash_init(void);
 uint8_t norflash_deinit(void);                                                      /* ʼNOR Flash */
 uint8_t norflash_erase_chip(void);                                                  /* ȫƬNOR Flash */
 uint8_t norflash_erase_block(uint32_t address);                                     /* NOR Flash */
+uint8_t norflash_erase_half_block(uint32_t address);                                /* NOR Flash */
 uint8_t norflash_erase_sector(uint32_t address);                                    /* NOR Flash */
+uint8_t norflash_erase_range(uint32_t address, uint32_t length);                    /* ΧNOR Flash */
+void norflash_get_erase_report(norflash_erase_report_t *report);                    /* ȡһηΧ */
 uint8_t norflash_program_page(uint32_t address, uint8_t *data, uint32_t length);    /* ҳNOR Flash */
 uint8_t norflash_read(uint32_t address, uint8_t *data, uint32_t length);            /* NOR Flash */
 uint8_t norflash_memory_mapped(void);                                               /* NOR Flashڴӳ */
+uint8_t norflash_memory_mapped_exit(void);                                          /* ˳NOR Flashڴӳ */
+uint8_t norflash_memory_mapped_state(void);                                         /* ѯNOR FlashǷڴӳģʽ */
+uint8_t norflash_memory_mapped_suspend(uint32_t *context);                          /* жϲ˳NOR Flashڴӳ */
+uint8_t norflash_memory_mapped_resume(uint32_t context);                            /* ָNOR Flashڴӳж״̬ */
+uint8_t norflash_set_read_profile(norflash_read_profile_t profile);                 /* NOR FlashãУ׼УЧ */
+norflash_read_profile_t norflash_get_read_profile(void);                            /* ȡNOR Flash */
 uint8_t norflash_get_empty_value(void);                                             /* ȡNOR Flashֵ */
 uint32_t norflash_get_chip_size(void);                                              /* ȡNOR FlashƬС */
 uint32_t norflash_get_block_size(void);                                             /* ȡNOR FlashС */
+uint32_t norflash_get_half_block_size(void);                                        /* ȡNOR FlashС */
 uint32_t norflash_get_sector_size(void);                                            /* ȡNOR FlashС */
 uint32_t norflash_get_page_size(void);                                              /* ȡNOR FlashҳС */
 uint8_t norflash_write(uint32_t address, uint8_t *data, uint32_t length);           /* дNOR Flash */
+uint8_t norflash_write_async(uint32_t address, uint8_t *data, uint32_t length, norflash_async_callback_t callback, void *arg);   /* 첽дNOR FlashĿѲ */
+uint8_t norflash_erase_async(uint32_t address, uint32_t length, norflash_async_callback_t callback, void *arg);                  /* 첽NOR Flash */
+uint8_t norflash_async_busy(void);                                                  /* ѯNOR Flash첽Ƿ */
+uint8_t norflash_erase_background(uint32_t address, uint32_t length);               /* NOR Flash̨ */
+uint8_t norflash_erase_background_run(uint32_t budget);                             /* ִһNOR Flash̨ʱƬ */
+uint8_t norflash_erase_background_busy(void);                                       /* ѯNOR Flash̨Ƿ */
+void norflash_erase_background_get_progress(norflash_erase_progress_t *progress);   /* ȡNOR Flash̨ */
+void norflash_xspi1_irq_handler(void);                                              /* NOR Flash XSPI1жϴ */
+void norflash_dma_irq_handler(void);                                                /* NOR Flash DMAжϴ */
 
 /*  */
 uint8_t norflash_ex_init(void);                                                 /* ʼNOR Flash */
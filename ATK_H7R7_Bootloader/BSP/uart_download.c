@@ -0,0 +1,781 @@
+/**
+ ****************************************************************************************************
+ * @file        uart_download.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       أ֡ЭNOR Flashˮд룩
+ ****************************************************************************************************
+ * @attention
+ *
+ * ÿҳһֱ֡֡ӴӴڽջеҳCRCȷDATA֡
+ * norflash_write_async()ύһҳգҳдʱͣȡ
+ * ڴڽջУɴڱ֤
+ * STARTnorflash_erase_async()Ŀ϶뵽첽а˳ִУ
+ * ڼENDУڼÿUART_DOWNLOAD_KEEPALIVEһBUSYӦ
+ * ǰѳʼNOR FlashҲڴӳģʽҳλDMAɷʵĴ洢λDTCM
+ *
+ ****************************************************************************************************
+ */
+
+#include "uart_download.h"
+#include "norflash_w25q128.h"
+#include "boot_image.h"
+#include <string.h>
+
+/* ҳ */
+#define UART_DOWNLOAD_BUFFER_NUM        (2)
+
+/* ҳ״̬ */
+#define UART_DOWNLOAD_BUFFER_FREE       (0)     /* Уɽ֡ */
+#define UART_DOWNLOAD_BUFFER_READY      (1)     /* ѽգȴύд */
+#define UART_DOWNLOAD_BUFFER_WRITING    (2)     /* д */
+
+/* ֡״̬ */
+#define UART_DOWNLOAD_PARSE_SOF         (0)     /* ֡ʼ */
+#define UART_DOWNLOAD_PARSE_HEADER      (1)     /* ֡ͷ */
+#define UART_DOWNLOAD_PARSE_BODY        (2)     /* CRC32 */
+
+/*  */
+#define UART_DOWNLOAD_ERASE_BUSY        (0)
+#define UART_DOWNLOAD_ERASE_OK          (1)
+#define UART_DOWNLOAD_ERASE_FAIL        (2)
+
+/* ҳ壨ֶ룬λ֡ͷ֮ */
+typedef struct {
+    uint32_t frame[(UART_DOWNLOAD_FRAME_MAX + 3) / 4];  /* ֡ */
+    uint32_t address;                                   /* дַ */
+    uint32_t length;                                    /* д볤 */
+    volatile uint8_t state;                             /* ҳ״̬ */
+} uart_download_buffer_t;
+
+/*  */
+static struct {
+    const uart_download_port_t *port;                       /* ڽӿ */
+    uart_download_status_t status;                          /* ״̬ͳ */
+    uart_download_buffer_t buffer[UART_DOWNLOAD_BUFFER_NUM];/* ҳ */
+    uint8_t current;                                        /* ڽյҳ */
+    uint8_t parse;                                          /* ֡״̬ */
+    uint8_t stalled;                                        /* ҳȫд */
+    uint8_t unacked;                                        /* ѽδӦDATA֡ */
+    uint8_t ack_pending;                                    /* 뷢ACK */
+    uint8_t nak_sent;                                       /* ѶԵǰŷ͹NAK */
+    uint8_t baud_trial;                                     /* лʣδյЧ֡ */
+    uint16_t expected;                                      /*  */
+    uint32_t fill;                                          /* ѽյ֡ */
+    uint32_t crc32;                                         /* STARTеCRC32 */
+    uint32_t baudrate;                                      /* ǰ */
+    uint32_t baud_tick;                                     /* лʵʱ */
+    uint32_t keepalive_tick;                                /* ϴαӦʱ */
+    volatile uint32_t written;                              /* дNOR Flash */
+    volatile uint8_t erase_result;                          /*  */
+    volatile uint8_t flash_error;                           /* дʧ */
+} uart_download;
+
+/**
+ * @brief   ȡС32λ
+ * @param   data: ָ
+ * @retval  ֵ
+ */
+static uint32_t uart_download_get32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/**
+ * @brief   һ֡
+ * @param   type: ֡
+ * @param   seq: 
+ * @param   data: ݣΪNULL
+ * @param   length: ݳ
+ * @retval  
+ */
+static void uart_download_send(uint8_t type, uint16_t seq, const uint8_t *data, uint16_t length)
+{
+    uint8_t frame[UART_DOWNLOAD_HEADER_SIZE + sizeof(uart_download_reply_t) + UART_DOWNLOAD_CRC_SIZE];
+    uint32_t crc = 0;
+    
+    if (length > sizeof(uart_download_reply_t))
+    {
+        return;
+    }
+    
+    frame[0] = UART_DOWNLOAD_SOF;
+    frame[1] = type;
+    frame[2] = (uint8_t)seq;
+    frame[3] = (uint8_t)(seq >> 8);
+    frame[4] = (uint8_t)length;
+    frame[5] = (uint8_t)(length >> 8);
+    frame[6] = 0;
+    frame[7] = (uint8_t)~(frame[1] ^ frame[2] ^ frame[3] ^ frame[4] ^ frame[5] ^ frame[6]);
+    if (length != 0)
+    {
+        memcpy(&frame[UART_DOWNLOAD_HEADER_SIZE], data, length);
+    }
+    
+    boot_image_crc32_calculate(&frame[1], UART_DOWNLOAD_HEADER_SIZE - 1 + length, &crc);
+    frame[UART_DOWNLOAD_HEADER_SIZE + length] = (uint8_t)crc;
+    frame[UART_DOWNLOAD_HEADER_SIZE + length + 1] = (uint8_t)(crc >> 8);
+    frame[UART_DOWNLOAD_HEADER_SIZE + length + 2] = (uint8_t)(crc >> 16);
+    frame[UART_DOWNLOAD_HEADER_SIZE + length + 3] = (uint8_t)(crc >> 24);
+    
+    uart_download.port->write(frame, UART_DOWNLOAD_HEADER_SIZE + length + UART_DOWNLOAD_CRC_SIZE);
+}
+
+/**
+ * @brief   Ӧ
+ * @note    ΪһţACKͬʱδӦ
+ * @param   type: UART_DOWNLOAD_TYPE_ACKUART_DOWNLOAD_TYPE_NAK
+ * @param   status: Ӧ״̬
+ * @retval  
+ */
+static void uart_download_reply(uint8_t type, uint8_t status)
+{
+    uart_download_reply_t reply;
+    
+    reply.status = status;
+    reply.window = UART_DOWNLOAD_WINDOW;
+    reply.page_size = UART_DOWNLOAD_PAGE_SIZE;
+    reply.offset = uart_download.status.received;
+    
+    uart_download_send(type, uart_download.expected, (const uint8_t *)&reply, sizeof(reply));
+    
+    uart_download.status.result = status;
+    if (type == UART_DOWNLOAD_TYPE_ACK)
+    {
+        uart_download.status.acks++;
+        uart_download.unacked = 0;
+        uart_download.ack_pending = 0;
+    }
+    else
+    {
+        uart_download.status.naks++;
+    }
+    uart_download.keepalive_tick = HAL_GetTick();
+}
+
+/**
+ * @brief   ״̬NAK
+ * @param   status: Ӧ״̬
+ * @retval  
+ */
+static void uart_download_fail(uint8_t status)
+{
+    uart_download.status.state = UART_DOWNLOAD_STATE_ERROR;
+    uart_download_reply(UART_DOWNLOAD_TYPE_NAK, status);
+}
+
+/**
+ * @brief   ɻصжеã
+ * @param   result: 
+ * @param   arg: δʹ
+ * @retval  
+ */
+static void uart_download_erase_done(uint8_t result, void *arg)
+{
+    (void)arg;
+    
+    uart_download.erase_result = (result == 0) ? UART_DOWNLOAD_ERASE_OK : UART_DOWNLOAD_ERASE_FAIL;
+}
+
+/**
+ * @brief   ҳдɻصжеã
+ * @param   result: д
+ * @param   arg: ҳ
+ * @retval  
+ */
+static void uart_download_write_done(uint8_t result, void *arg)
+{
+    uart_download_buffer_t *buffer = (uart_download_buffer_t *)arg;
+    
+    if (result != 0)
+    {
+        uart_download.flash_error = 1;
+    }
+    else
+    {
+        uart_download.written += buffer->length;
+    }
+    buffer->state = UART_DOWNLOAD_BUFFER_FREE;
+}
+
+/**
+ * @brief   ύѽյҳ
+ * @note    첽ʱ´εύ
+ * @param   
+ * @retval  
+ */
+static void uart_download_submit(void)
+{
+    uart_download_buffer_t *buffer;
+    uint8_t index;
+    
+    for (index = 0; index < UART_DOWNLOAD_BUFFER_NUM; index++)
+    {
+        buffer = &uart_download.buffer[index];
+        if (buffer->state != UART_DOWNLOAD_BUFFER_READY)
+        {
+            continue;
+        }
+        
+        buffer->state = UART_DOWNLOAD_BUFFER_WRITING;
+        if (norflash_write_async(buffer->address, (uint8_t *)buffer->frame + UART_DOWNLOAD_HEADER_SIZE, buffer->length,
+                                 uart_download_write_done, buffer) != 0)
+        {
+            buffer->state = UART_DOWNLOAD_BUFFER_READY;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief   ѯǷȫҳд
+ * @param   
+ * @retval  0: ҳδд, 1: ȫд
+ */
+static uint8_t uart_download_flushed(void)
+{
+    uint8_t index;
+    
+    for (index = 0; index < UART_DOWNLOAD_BUFFER_NUM; index++)
+    {
+        if (uart_download.buffer[index].state != UART_DOWNLOAD_BUFFER_FREE)
+        {
+            return 0;
+        }
+    }
+    
+    return (norflash_async_busy() == 0) ? 1 : 0;
+}
+
+/**
+ * @brief   Уд
+ * @note    ͨڴӳ䴰CRC㣬ǰ˳ڴӳ
+ * @param   
+ * @retval  Ӧ״̬
+ */
+static uint8_t uart_download_verify(void)
+{
+    uint32_t crc = 0;
+    uint8_t res;
+    
+    if (norflash_memory_mapped() != 0)
+    {
+        return UART_DOWNLOAD_STATUS_FLASH;
+    }
+    
+    /* Ŀǰܾӳ䴰ڶCacheеľ */
+    SCB_InvalidateDCache_by_Addr((volatile void *)(NORFLASH_MEMORY_MAPPED_BASE + uart_download.status.address), (int32_t)uart_download.status.length);
+    
+    res = boot_image_crc32_calculate((const uint8_t *)(NORFLASH_MEMORY_MAPPED_BASE + uart_download.status.address), uart_download.status.length, &crc);
+    res |= norflash_memory_mapped_exit();
+    if (res != 0)
+    {
+        return UART_DOWNLOAD_STATUS_FLASH;
+    }
+    
+    return (crc == uart_download.crc32) ? UART_DOWNLOAD_STATUS_OK : UART_DOWNLOAD_STATUS_IMAGE;
+}
+
+/**
+ * @brief   START֡
+ * @param   seq: 
+ * @param   data: 
+ * @retval  
+ */
+static void uart_download_start(uint16_t seq, const uint8_t *data)
+{
+    uint32_t address = uart_download_get32(&data[0]);
+    uint32_t length = uart_download_get32(&data[4]);
+    uint32_t crc32 = uart_download_get32(&data[8]);
+    uint32_t chip_size = norflash_get_chip_size();
+    
+    /* յطSTARTӦڷ */
+    if ((uart_download.status.state == UART_DOWNLOAD_STATE_ERASING) && (address == uart_download.status.address) &&
+        (length == uart_download.status.length) && (crc32 == uart_download.crc32))
+    {
+        return;
+    }
+    
+    /* һصдδɣӦʱط */
+    if (uart_download_flushed() == 0)
+    {
+        return;
+    }
+    
+    memset(&uart_download.status, 0, sizeof(uart_download.status));
+    uart_download.status.address = address;
+    uart_download.status.length = length;
+    uart_download.crc32 = crc32;
+    uart_download.expected = seq + 1;
+    uart_download.unacked = 0;
+    uart_download.ack_pending = 0;
+    uart_download.nak_sent = 0;
+    uart_download.written = 0;
+    uart_download.flash_error = 0;
+    
+    if ((length == 0) || (address >= chip_size) || (length > (chip_size - address)) || ((address % norflash_get_sector_size()) != 0))
+    {
+        uart_download_fail(UART_DOWNLOAD_STATUS_RANGE);
+        return;
+    }
+    
+    uart_download.erase_result = UART_DOWNLOAD_ERASE_BUSY;
+    if (norflash_erase_async(address, length, uart_download_erase_done, NULL) != 0)
+    {
+        uart_download_fail(UART_DOWNLOAD_STATUS_FLASH);
+        return;
+    }
+    
+    uart_download.status.state = UART_DOWNLOAD_STATE_ERASING;
+    uart_download_reply(UART_DOWNLOAD_TYPE_ACK, UART_DOWNLOAD_STATUS_BUSY);
+}
+
+/**
+ * @brief   Ųŵ֡
+ * @note    ѽչ֡δյACKطACKǰ֡м֡ʧһNAK
+ * @param   seq: 
+ * @retval  
+ */
+static void uart_download_out_of_order(uint16_t seq)
+{
+    if ((uint16_t)(uart_download.expected - seq) <= (2 * UART_DOWNLOAD_WINDOW))
+    {
+        uart_download.status.duplicates++;
+        uart_download.ack_pending = 1;
+        return;
+    }
+    
+    uart_download.status.sequence_errors++;
+    if (uart_download.nak_sent == 0)
+    {
+        uart_download.nak_sent = 1;
+        uart_download_reply(UART_DOWNLOAD_TYPE_NAK, UART_DOWNLOAD_STATUS_SEQUENCE);
+    }
+}
+
+/**
+ * @brief   DATA֡
+ * @param   buffer: ֡ڵҳ
+ * @param   seq: 
+ * @param   length: ݳ
+ * @retval  
+ */
+static void uart_download_data(uart_download_buffer_t *buffer, uint16_t seq, uint16_t length)
+{
+    uint32_t remain = uart_download.status.length - uart_download.status.received;
+    uint8_t *data = (uint8_t *)buffer->frame + UART_DOWNLOAD_HEADER_SIZE;
+    
+    if (seq != uart_download.expected)
+    {
+        uart_download_out_of_order(seq);
+        return;
+    }
+    
+    if (length != ((remain < UART_DOWNLOAD_PAGE_SIZE) ? remain : UART_DOWNLOAD_PAGE_SIZE))
+    {
+        uart_download_fail(UART_DOWNLOAD_STATUS_RANGE);
+        return;
+    }
+    
+    /* ˫ģʽ밴żд룬һֽڲ0xFFУCRC32 */
+    buffer->address = uart_download.status.address + uart_download.status.received;
+    buffer->length = length;
+    if ((length & 1) != 0)
+    {
+        data[buffer->length++] = 0xFF;
+    }
+    buffer->state = UART_DOWNLOAD_BUFFER_READY;
+    
+    uart_download.status.received += length;
+    uart_download.expected++;
+    uart_download.unacked++;
+    uart_download.nak_sent = 0;
+    
+    uart_download_submit();
+}
+
+/**
+ * @brief   һCRCȷ֡
+ * @param   buffer: ֡ڵҳ
+ * @retval  
+ */
+static void uart_download_frame(uart_download_buffer_t *buffer)
+{
+    const uint8_t *frame = (const uint8_t *)buffer->frame;
+    const uint8_t *data = &frame[UART_DOWNLOAD_HEADER_SIZE];
+    uint16_t seq = (uint16_t)(frame[2] | (frame[3] << 8));
+    uint16_t length = (uint16_t)(frame[4] | (frame[5] << 8));
+    uint8_t state = uart_download.status.state;
+    uint32_t baudrate;
+    
+    uart_download.status.frames++;
+    uart_download.baud_trial = 0;
+    
+    switch (frame[1])
+    {
+        case UART_DOWNLOAD_TYPE_BAUD:
+        {
+            if ((length != 4) || ((state != UART_DOWNLOAD_STATE_IDLE) && (state != UART_DOWNLOAD_STATE_DONE) && (state != UART_DOWNLOAD_STATE_ERROR)))
+            {
+                uart_download_send(UART_DOWNLOAD_TYPE_NAK, seq, NULL, 0);
+                break;
+            }
+            
+            /* ԭӦлյӦл */
+            baudrate = uart_download_get32(data);
+            if ((uart_download.port->set_baudrate == NULL) || (baudrate == 0))
+            {
+                uart_download.expected = seq;
+                uart_download_reply(UART_DOWNLOAD_TYPE_NAK, UART_DOWNLOAD_STATUS_BAUD);
+                break;
+            }
+            
+            uart_download.expected = seq + 1;
+            uart_download_reply(UART_DOWNLOAD_TYPE_ACK, UART_DOWNLOAD_STATUS_OK);
+            if ((baudrate != uart_download.baudrate) && (uart_download.port->set_baudrate(baudrate) == 0))
+            {
+                uart_download.baudrate = baudrate;
+                uart_download.baud_trial = 1;
+                uart_download.baud_tick = HAL_GetTick();
+            }
+            break;
+        }
+        case UART_DOWNLOAD_TYPE_START:
+        {
+            if (length != 12)
+            {
+                uart_download_fail(UART_DOWNLOAD_STATUS_RANGE);
+                break;
+            }
+            uart_download_start(seq, data);
+            break;
+        }
+        case UART_DOWNLOAD_TYPE_DATA:
+        {
+            if (state == UART_DOWNLOAD_STATE_RECEIVING)
+            {
+                uart_download_data(buffer, seq, length);
+            }
+            else if ((state == UART_DOWNLOAD_STATE_FINISHING) || (state == UART_DOWNLOAD_STATE_DONE))
+            {
+                uart_download_out_of_order(seq);
+            }
+            else if (state != UART_DOWNLOAD_STATE_ERASING)
+            {
+                uart_download_reply(UART_DOWNLOAD_TYPE_NAK, UART_DOWNLOAD_STATUS_STATE);
+            }
+            break;
+        }
+        case UART_DOWNLOAD_TYPE_END:
+        {
+            if ((state == UART_DOWNLOAD_STATE_RECEIVING) && (seq == uart_download.expected))
+            {
+                if (uart_download.status.received != uart_download.status.length)
+                {
+                    uart_download_fail(UART_DOWNLOAD_STATUS_RANGE);
+                    break;
+                }
+                uart_download.expected++;
+                uart_download.status.state = UART_DOWNLOAD_STATE_FINISHING;
+                uart_download_reply(UART_DOWNLOAD_TYPE_ACK, UART_DOWNLOAD_STATUS_BUSY);
+            }
+            else if (state == UART_DOWNLOAD_STATE_DONE)
+            {
+                /* δյӦطEND */
+                uart_download_reply(UART_DOWNLOAD_TYPE_ACK, UART_DOWNLOAD_STATUS_OK);
+            }
+            else if ((state == UART_DOWNLOAD_STATE_RECEIVING) || (state == UART_DOWNLOAD_STATE_FINISHING))
+            {
+                uart_download_out_of_order(seq);
+            }
+            else if (state == UART_DOWNLOAD_STATE_ERROR)
+            {
+                uart_download_reply(UART_DOWNLOAD_TYPE_NAK, uart_download.status.result);
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief   ѡһеҳһ֡
+ * @param   
+ * @retval  0: ѡ, 1: ȫд
+ */
+static uint8_t uart_download_select(void)
+{
+    uint8_t index;
+    
+    if (uart_download.buffer[uart_download.current].state == UART_DOWNLOAD_BUFFER_FREE)
+    {
+        return 0;
+    }
+    
+    /* ֡յһʱҳ */
+    if (uart_download.fill != 0)
+    {
+        return 1;
+    }
+    
+    for (index = 0; index < UART_DOWNLOAD_BUFFER_NUM; index++)
+    {
+        if (uart_download.buffer[index].state == UART_DOWNLOAD_BUFFER_FREE)
+        {
+            uart_download.current = index;
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   Ӵڽղ֡
+ * @param   
+ * @retval  
+ */
+static void uart_download_receive(void)
+{
+    uart_download_buffer_t *buffer;
+    uint8_t *frame;
+    uint32_t total;
+    uint32_t count;
+    uint32_t crc;
+    uint32_t index;
+    uint8_t check;
+    
+    while (1)
+    {
+        if (uart_download_select() != 0)
+        {
+            if (uart_download.stalled == 0)
+            {
+                uart_download.stalled = 1;
+                uart_download.status.stalls++;
+            }
+            return;
+        }
+        uart_download.stalled = 0;
+        
+        buffer = &uart_download.buffer[uart_download.current];
+        frame = (uint8_t *)buffer->frame;
+        
+        switch (uart_download.parse)
+        {
+            case UART_DOWNLOAD_PARSE_SOF:
+            {
+                if (uart_download.port->read(frame, 1) == 0)
+                {
+                    return;
+                }
+                if (frame[0] == UART_DOWNLOAD_SOF)
+                {
+                    uart_download.fill = 1;
+                    uart_download.parse = UART_DOWNLOAD_PARSE_HEADER;
+                }
+                break;
+            }
+            case UART_DOWNLOAD_PARSE_HEADER:
+            {
+                count = uart_download.port->read(&frame[uart_download.fill], UART_DOWNLOAD_HEADER_SIZE - uart_download.fill);
+                if (count == 0)
+                {
+                    return;
+                }
+                uart_download.fill += count;
+                if (uart_download.fill < UART_DOWNLOAD_HEADER_SIZE)
+                {
+                    break;
+                }
+                
+                check = (uint8_t)~(frame[1] ^ frame[2] ^ frame[3] ^ frame[4] ^ frame[5] ^ frame[6]);
+                if ((check == frame[7]) && ((frame[4] | (frame[5] << 8)) <= UART_DOWNLOAD_PAGE_SIZE))
+                {
+                    uart_download.parse = UART_DOWNLOAD_PARSE_BODY;
+                    break;
+                }
+                
+                /* ֡ͷЧ֡ͷеһSOFͬ */
+                uart_download.status.resyncs++;
+                for (index = 1; (index < UART_DOWNLOAD_HEADER_SIZE) && (frame[index] != UART_DOWNLOAD_SOF); index++)
+                {
+                }
+                memmove(frame, &frame[index], UART_DOWNLOAD_HEADER_SIZE - index);
+                uart_download.fill = UART_DOWNLOAD_HEADER_SIZE - index;
+                uart_download.parse = (uart_download.fill != 0) ? UART_DOWNLOAD_PARSE_HEADER : UART_DOWNLOAD_PARSE_SOF;
+                break;
+            }
+            case UART_DOWNLOAD_PARSE_BODY:
+            {
+                total = UART_DOWNLOAD_HEADER_SIZE + (frame[4] | (frame[5] << 8)) + UART_DOWNLOAD_CRC_SIZE;
+                count = uart_download.port->read(&frame[uart_download.fill], total - uart_download.fill);
+                if (count == 0)
+                {
+                    return;
+                }
+                uart_download.fill += count;
+                if (uart_download.fill < total)
+                {
+                    break;
+                }
+                
+                uart_download.fill = 0;
+                uart_download.parse = UART_DOWNLOAD_PARSE_SOF;
+                
+                crc = 0;
+                boot_image_crc32_calculate(&frame[1], total - UART_DOWNLOAD_CRC_SIZE - 1, &crc);
+                if (crc == uart_download_get32(&frame[total - UART_DOWNLOAD_CRC_SIZE]))
+                {
+                    uart_download_frame(buffer);
+                }
+                else
+                {
+                    uart_download.status.crc_errors++;
+                    if ((uart_download.status.state == UART_DOWNLOAD_STATE_RECEIVING) && (uart_download.nak_sent == 0))
+                    {
+                        uart_download.nak_sent = 1;
+                        uart_download_reply(UART_DOWNLOAD_TYPE_NAK, UART_DOWNLOAD_STATUS_CRC);
+                    }
+                }
+                break;
+            }
+            default:
+            {
+                uart_download.fill = 0;
+                uart_download.parse = UART_DOWNLOAD_PARSE_SOF;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief   ʼ
+ * @param   port: ڽӿ
+ * @retval  
+ */
+void uart_download_init(const uart_download_port_t *port)
+{
+    memset(&uart_download, 0, sizeof(uart_download));
+    uart_download.port = port;
+    uart_download.baudrate = port->baudrate;
+}
+
+/**
+ * @brief   NOR Flashд
+ * @note    ѭзãȴҳдں̨
+ * @param   
+ * @retval  
+ */
+void uart_download_poll(void)
+{
+    uint32_t now;
+    uint8_t status;
+    
+    if (uart_download.port == NULL)
+    {
+        return;
+    }
+    
+    uart_download_submit();
+    uart_download_receive();
+    now = HAL_GetTick();
+    
+    /* лʺһֱûЧ֡δлָ֧֣Ĭϲ */
+    if ((uart_download.baud_trial != 0) && ((now - uart_download.baud_tick) > UART_DOWNLOAD_BAUD_TIMEOUT))
+    {
+        uart_download.baud_trial = 0;
+        if (uart_download.port->set_baudrate(uart_download.port->baudrate) == 0)
+        {
+            uart_download.baudrate = uart_download.port->baudrate;
+        }
+    }
+    
+    switch (uart_download.status.state)
+    {
+        case UART_DOWNLOAD_STATE_ERASING:
+        {
+            if (uart_download.erase_result == UART_DOWNLOAD_ERASE_OK)
+            {
+                uart_download.status.state = UART_DOWNLOAD_STATE_RECEIVING;
+                uart_download_reply(UART_DOWNLOAD_TYPE_ACK, UART_DOWNLOAD_STATUS_OK);
+            }
+            else if (uart_download.erase_result == UART_DOWNLOAD_ERASE_FAIL)
+            {
+                uart_download_fail(UART_DOWNLOAD_STATUS_FLASH);
+            }
+            else if ((now - uart_download.keepalive_tick) >= UART_DOWNLOAD_KEEPALIVE)
+            {
+                uart_download_reply(UART_DOWNLOAD_TYPE_ACK, UART_DOWNLOAD_STATUS_BUSY);
+            }
+            break;
+        }
+        case UART_DOWNLOAD_STATE_RECEIVING:
+        {
+            if (uart_download.flash_error != 0)
+            {
+                uart_download_fail(UART_DOWNLOAD_STATUS_FLASH);
+                break;
+            }
+            
+            /* ÿӦ·Уһ֡꣩ʱӦʣ֡һ֡ʱٻNAK */
+            if (uart_download.unacked >= UART_DOWNLOAD_ACK_EVERY)
+            {
+                uart_download_reply(UART_DOWNLOAD_TYPE_ACK, UART_DOWNLOAD_STATUS_OK);
+            }
+            else if (uart_download.port->idle() != 0)
+            {
+                uart_download.nak_sent = 0;
+                if ((uart_download.unacked != 0) || (uart_download.ack_pending != 0))
+                {
+                    uart_download_reply(UART_DOWNLOAD_TYPE_ACK, UART_DOWNLOAD_STATUS_OK);
+                }
+            }
+            break;
+        }
+        case UART_DOWNLOAD_STATE_FINISHING:
+        {
+            if (uart_download_flushed() == 0)
+            {
+                if ((now - uart_download.keepalive_tick) >= UART_DOWNLOAD_KEEPALIVE)
+                {
+                    uart_download_reply(UART_DOWNLOAD_TYPE_ACK, UART_DOWNLOAD_STATUS_BUSY);
+                }
+                break;
+            }
+            
+            status = (uart_download.flash_error != 0) ? UART_DOWNLOAD_STATUS_FLASH : uart_download_verify();
+            if (status != UART_DOWNLOAD_STATUS_OK)
+            {
+                uart_download_fail(status);
+                break;
+            }
+            uart_download.status.state = UART_DOWNLOAD_STATE_DONE;
+            uart_download_reply(UART_DOWNLOAD_TYPE_ACK, UART_DOWNLOAD_STATUS_OK);
+            break;
+        }
+        default:
+        {
+            if ((uart_download.ack_pending != 0) && (uart_download.port->idle() != 0))
+            {
+                uart_download_reply(UART_DOWNLOAD_TYPE_ACK, uart_download.status.result);
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @brief   ȡ״̬ͳ
+ * @param   status: ״̬ͳ
+ * @retval  
+ */
+void uart_download_get_status(uart_download_status_t *status)
+{
+    *status = uart_download.status;
+    status->written = uart_download.written;
+}
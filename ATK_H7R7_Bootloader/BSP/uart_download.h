@@ -0,0 +1,110 @@
+/**
+ ****************************************************************************************************
+ * @file        uart_download.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       أ֡ЭNOR Flashˮд룩
+ ****************************************************************************************************
+ * @attention
+ *
+ * ֡ʽСˣSOF(0xA5)  (2) (2) (1) ͷУ(1) () CRC32(4)
+ *   ͷУΪֽȡCRC32zlibͬĩβ
+ * ֡BAUDлʣSTARTַȡCRC32Ӧ𣩡DATAÿ֡һҳENDУӦ
+ * 豸֡ACK/NAKΪһţۻӦ𣩣Ϊuart_download_reply_t
+ * window֡δӦ֡豸ֻ֡յҳӦ
+ * ޲ʱջλСwindow֡ŴCRCʱNAKNAKط
+ * طʱ;֡ʹλݰCRC
+ * ҳ˫壺һҳDMA첽дNOR FlashʱһҳӴڽ
+ * ЭӲ޹أuart_download_port_tṩBoot/Core/Src/usart.c棩
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __UART_DOWNLOAD_H
+#define __UART_DOWNLOAD_H
+
+#include <stdint.h>
+
+/* ֡ */
+#define UART_DOWNLOAD_SOF               (0xA5)
+#define UART_DOWNLOAD_HEADER_SIZE       (8)
+#define UART_DOWNLOAD_CRC_SIZE          (4)
+#define UART_DOWNLOAD_PAGE_SIZE         (512)   /* DATA֡ݳȣһ֡ɸ̣ */
+#define UART_DOWNLOAD_FRAME_MAX         (UART_DOWNLOAD_HEADER_SIZE + UART_DOWNLOAD_PAGE_SIZE + UART_DOWNLOAD_CRC_SIZE)
+
+/* ֡Ͷ */
+#define UART_DOWNLOAD_TYPE_BAUD         (0x01)  /* : (4) */
+#define UART_DOWNLOAD_TYPE_START        (0x02)  /* : ַ(4) (4) CRC32(4) */
+#define UART_DOWNLOAD_TYPE_DATA         (0x03)  /* : һҳ */
+#define UART_DOWNLOAD_TYPE_END          (0x04)  /*  */
+#define UART_DOWNLOAD_TYPE_ACK          (0x80)
+#define UART_DOWNLOAD_TYPE_NAK          (0x81)
+
+/* Ӧ״̬ */
+#define UART_DOWNLOAD_STATUS_OK         (0)     /* ɹ */
+#define UART_DOWNLOAD_STATUS_BUSY       (1)     /* УУȴ */
+#define UART_DOWNLOAD_STATUS_RANGE      (2)     /* ַ򳤶Ч */
+#define UART_DOWNLOAD_STATUS_SEQUENCE   (3)     /* Ų */
+#define UART_DOWNLOAD_STATUS_CRC        (4)     /* ֡CRC */
+#define UART_DOWNLOAD_STATUS_FLASH      (5)     /* NOR Flashдʧ */
+#define UART_DOWNLOAD_STATUS_IMAGE      (6)     /* дCRC32STARTһ */
+#define UART_DOWNLOAD_STATUS_STATE      (7)     /* ǰ״̬²ܸ֡ */
+#define UART_DOWNLOAD_STATUS_BAUD       (8)     /* ֵ֧Ĳ */
+
+/* ڶ壨֡ */
+#define UART_DOWNLOAD_WINDOW            (8)
+#define UART_DOWNLOAD_ACK_EVERY         (UART_DOWNLOAD_WINDOW / 2)
+
+/* ʱ壨ms */
+#define UART_DOWNLOAD_KEEPALIVE         (100)   /* УڼıӦ */
+#define UART_DOWNLOAD_BAUD_TIMEOUT      (1000)  /* лʺʱЧָ֡ԭ */
+
+/* ״̬ */
+#define UART_DOWNLOAD_STATE_IDLE        (0)     /* ȴSTART */
+#define UART_DOWNLOAD_STATE_ERASING     (1)     /* Ŀ */
+#define UART_DOWNLOAD_STATE_RECEIVING   (2)     /* DATA */
+#define UART_DOWNLOAD_STATE_FINISHING   (3)     /* ȴд겢У */
+#define UART_DOWNLOAD_STATE_DONE        (4)     /*  */
+#define UART_DOWNLOAD_STATE_ERROR       (5)     /* ֹȴµSTART */
+
+/* Ӧݶ */
+typedef struct {
+    uint8_t status;         /* Ӧ״̬ */
+    uint8_t window;         /* ڣ֡ */
+    uint16_t page_size;     /* DATA֡ݳ */
+    uint32_t offset;        /* ѽճ */
+} uart_download_reply_t;
+
+/* ڽӿڶ */
+typedef struct {
+    uint32_t (*read)(uint8_t *data, uint32_t length);       /* ȡѽյݣضȡȣȴ */
+    void (*write)(const uint8_t *data, uint32_t length);    /* ݣŷأ */
+    uint8_t (*idle)(void);                                  /* ѯ·б־ */
+    uint8_t (*set_baudrate)(uint32_t baudrate);             /* лʣΪNULL */
+    uint32_t baudrate;                                      /* Ĭϲ */
+} uart_download_port_t;
+
+/* ״̬ͳƶ */
+typedef struct {
+    uint8_t state;              /* ״̬ */
+    uint8_t result;             /* һӦ״̬ */
+    uint32_t address;           /* Ŀַ */
+    uint32_t length;            /* ܳ */
+    uint32_t received;          /* ѽճ */
+    uint32_t written;           /* дNOR Flash */
+    uint32_t frames;            /* յЧ֡ */
+    uint32_t crc_errors;        /* CRC֡ */
+    uint32_t sequence_errors;   /* ųǰ֡ */
+    uint32_t duplicates;        /* ظ֡ */
+    uint32_t resyncs;           /* ֡ͷЧͬ */
+    uint32_t acks;              /* ACK */
+    uint32_t naks;              /* NAK */
+    uint32_t stalls;            /* ҳȫдͣյĴ */
+} uart_download_status_t;
+
+/*  */
+void uart_download_init(const uart_download_port_t *port);                         /* ʼ */
+void uart_download_poll(void);                                                      /* NOR Flashд루ѭеã */
+void uart_download_get_status(uart_download_status_t *status);                      /* ȡ״̬ͳ */
+
+#endif /* __UART_DOWNLOAD_H */
@@ -39,7 +39,7 @@
 /* #define HAL_ADC_MODULE_ENABLED   */
 /* #define HAL_CEC_MODULE_ENABLED   */
 /* #define HAL_CORDIC_MODULE_ENABLED   */
-/* #define HAL_CRC_MODULE_ENABLED   */
+#define HAL_CRC_MODULE_ENABLED
 /* #define HAL_CRYP_MODULE_ENABLED   */
 /* #define HAL_DCMIPP_MODULE_ENABLED   */
 /* #define HAL_DMA2D_MODULE_ENABLED   */
@@ -49,7 +49,7 @@
 /* #define HAL_GFXMMU_MODULE_ENABLED   */
 /* #define HAL_GFXTIM_MODULE_ENABLED   */
 /* #define HAL_GPU2D_MODULE_ENABLED   */
-/* #define HAL_HASH_MODULE_ENABLED   */
+#define HAL_HASH_MODULE_ENABLED
 /* #define HAL_HCD_MODULE_ENABLED   */
 /* #define HAL_I2C_MODULE_ENABLED   */
 /* #define HAL_I2S_MODULE_ENABLED   */
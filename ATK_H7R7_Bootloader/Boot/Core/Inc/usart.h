@@ -40,6 +40,14 @@ void MX_USART1_UART_Init(void);
 
 /* USER CODE BEGIN Prototypes */
 void printf_tx1(char *fmt, ...);
+void uart1_rx_start(void);
+void uart1_rx_stop(void);
+uint32_t uart1_read(uint8_t *data, uint32_t length);
+uint8_t uart1_rx_idle(void);
+void uart1_write(const uint8_t *data, uint32_t length);
+uint8_t uart1_set_baudrate(uint32_t baudrate);
+void uart1_irq_handler(void);
+void uart1_rx_dma_irq_handler(void);
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
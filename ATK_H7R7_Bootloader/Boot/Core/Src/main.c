@@ -26,6 +26,13 @@
 /* USER CODE BEGIN Includes */
 #include "norflash_w25q128.h"
 #include "XSPI_Boot.h"
+#include "norflash_kv.h"
+#include "boot_image.h"
+#include "boot_slot.h"
+#include "uart_download.h"
+#include "boot_trace.h"
+#include "boot_handoff.h"
+#include "mpu_cache.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -63,6 +70,19 @@ uint32_t flashsize;
 static uint8_t g_text_buf[] = {"TX16 MK3 Bootloader NorFlash test"};
 #define TEXT_SIZE (sizeof(g_text_buf))
 uint8_t data[TEXT_SIZE];
+boot_image_header_t boot_header;
+boot_image_report_t boot_report;
+uint8_t boot_slot;
+uart_download_status_t download_status;
+
+/* ʹõUSART1ӿ */
+static const uart_download_port_t g_download_port = {
+    uart1_read,
+    uart1_write,
+    uart1_rx_idle,
+    uart1_set_baudrate,
+    115200
+};
 /* USER CODE END 0 */
 
 /**
@@ -73,26 +93,34 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
+	uint8_t res;
 
+	/* ʱ߸٣CYCCNT㣬¼ڱSRAMתӦó */
+	BOOT_TRACE_START();
+	BOOT_TRACE_BEGIN(BOOT_TRACE_ID_MPU_CONFIG);
   /* USER CODE END 1 */
 
   /* MPU Configuration--------------------------------------------------------*/
   MPU_Config();
 
   /* MCU Configuration--------------------------------------------------------*/
+  BOOT_TRACE_END(BOOT_TRACE_ID_MPU_CONFIG);
+  BOOT_TRACE_BEGIN(BOOT_TRACE_ID_HAL_INIT);
 
   /* Reset of all peripherals, Initializes the Flash interface and the Systick. */
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-
+	BOOT_TRACE_END(BOOT_TRACE_ID_HAL_INIT);
+	BOOT_TRACE_BEGIN(BOOT_TRACE_ID_CLOCK_CONFIG);
   /* USER CODE END Init */
 
   /* Configure the system clock */
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
-
+	BOOT_TRACE_END(BOOT_TRACE_ID_CLOCK_CONFIG);
+	BOOT_TRACE_BEGIN(BOOT_TRACE_ID_PERIPH_INIT);
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
@@ -100,8 +128,11 @@ int main(void)
   MX_USART1_UART_Init();
 //  MX_XSPI1_Init();
   /* USER CODE BEGIN 2 */
+	BOOT_TRACE_END(BOOT_TRACE_ID_PERIPH_INIT);
 	printf_tx1("init ok \n");
+	BOOT_TRACE_BEGIN(BOOT_TRACE_ID_NORFLASH_INIT);
 	norflash_type = norflash_init();
+	BOOT_TRACE_END(BOOT_TRACE_ID_NORFLASH_INIT);
 	if (norflash_type == NORFlash_W25Q128_Dual)
   {
 		printf_tx1("Is NORFlash :W25Q128_Dual\n");
@@ -109,13 +140,50 @@ int main(void)
 	    /* ȡNOR FlashƬС */
     flashsize = norflash_get_chip_size();
 	printf_tx1("flashsize =%d,Start Write...\n",flashsize);
+	BOOT_TRACE_BEGIN(BOOT_TRACE_ID_NORFLASH_TEST);
 	if(norflash_write(flashsize - TEXT_SIZE, g_text_buf, TEXT_SIZE)!=0) printf_tx1("norflash_write Err\n");
 	LL_mDelay(100);
 	if(norflash_read(flashsize - TEXT_SIZE, data, TEXT_SIZE)!=0) printf_tx1("norflash_read Err\n");
 	printf_tx1("The Data Readed Is:%s\n",(char *)data);
 	LL_mDelay(10);
-  norflash_memory_mapped();
-	Boot_JumpToApp();	
+	BOOT_TRACE_END(BOOT_TRACE_ID_NORFLASH_TEST);
+	/* ѡA/B۲УӦó񣬽ڸº״CRC32/SHA-256 */
+	BOOT_TRACE_BEGIN(BOOT_TRACE_ID_KV_MOUNT);
+	if (norflash_kv_mount() != 0) printf_tx1("norflash_kv_mount Err\n");
+	BOOT_TRACE_END(BOOT_TRACE_ID_KV_MOUNT);
+	BOOT_TRACE_BEGIN(BOOT_TRACE_ID_SLOT_SELECT);
+	res = boot_slot_select(&boot_slot, &boot_header);
+	BOOT_TRACE_END(BOOT_TRACE_ID_SLOT_SELECT);
+	if (res == 0)
+	{
+		boot_image_get_report(&boot_report);
+		printf_tx1("Slot %c: App v%08X, %d bytes, %s in %dms\n", (boot_slot == BOOT_SLOT_A) ? 'A' : 'B', boot_header.image_version,
+		           boot_header.image_size, boot_report.cached ? "cached" : "verified", boot_report.elapsed);
+		BOOT_TRACE_BEGIN(BOOT_TRACE_ID_MEMORY_MAPPED);
+		norflash_memory_mapped();
+		BOOT_TRACE_END(BOOT_TRACE_ID_MEMORY_MAPPED);
+		/* ѹʱѹITCM/AXI SRAMstm32h7rsxx_ROMxspi1.sct */
+		BOOT_TRACE_BEGIN(BOOT_TRACE_ID_LOAD_SECTIONS);
+		res = boot_image_load_sections(BOOT_SLOT_ADDRESS(boot_slot), &boot_header);
+		BOOT_TRACE_END(BOOT_TRACE_ID_LOAD_SECTIONS);
+		if (res == 0)
+		{
+			boot_image_get_report(&boot_report);
+			if (boot_report.section_count != 0)
+			{
+				printf_tx1("Sections: %d, %d -> %d bytes in %dms\n", boot_report.section_count, boot_report.section_packed,
+				           boot_report.section_size, boot_report.section_elapsed);
+			}
+			boot_handoff_save(boot_slot, boot_header.image_version, boot_header.load_address, norflash_type, norflash_get_read_profile());
+			Boot_JumpToApp(boot_header.load_address);
+		}
+		norflash_memory_mapped_exit();
+		printf_tx1("boot_image_load_sections Err\n");
+	}
+	printf_tx1("App image invalid, stay in Bootloader\n");	
+	/* ȴأTools/uart_download/uart_send */
+	uart1_rx_start();
+	uart_download_init(&g_download_port);
 	
   /* USER CODE END 2 */
 
@@ -126,8 +194,31 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
-		LL_GPIO_TogglePin(LED0_GPIO_Port, LED0_Pin);
-		LL_mDelay(400);
+		uart_download_poll();
+		uart_download_get_status(&download_status);
+		if (download_status.state == UART_DOWNLOAD_STATE_DONE)
+		{
+			/* صA/BʱΪвۣѡ */
+			if ((download_status.address == BOOT_SLOT_A_ADDRESS) || (download_status.address == BOOT_SLOT_B_ADDRESS))
+			{
+				boot_slot_update_install((download_status.address == BOOT_SLOT_B_ADDRESS) ? BOOT_SLOT_B : BOOT_SLOT_A, BOOT_SLOT_TRIALS);
+			}
+			if (boot_slot_select(&boot_slot, &boot_header) == 0)
+			{
+				uart1_rx_stop();
+				norflash_memory_mapped();
+				if (boot_image_load_sections(BOOT_SLOT_ADDRESS(boot_slot), &boot_header) == 0)
+				{
+					boot_handoff_save(boot_slot, boot_header.image_version, boot_header.load_address, norflash_type, norflash_get_read_profile());
+					Boot_JumpToApp(boot_header.load_address);
+				}
+				norflash_memory_mapped_exit();
+				uart1_rx_start();
+			}
+			uart_download_init(&g_download_port);
+		}
+		if ((HAL_GetTick() % 400) < 200) LL_GPIO_SetOutputPin(LED0_GPIO_Port, LED0_Pin);
+		else LL_GPIO_ResetOutputPin(LED0_GPIO_Port, LED0_Pin);
   }
   /* USER CODE END 3 */
 }
@@ -207,29 +298,8 @@ void SystemClock_Config(void)
 
 static void MPU_Config(void)
 {
-  MPU_Region_InitTypeDef MPU_InitStruct = {0};
-
-  /* Disables the MPU */
-  HAL_MPU_Disable();
-
-  /** Initializes and configures the Region and the memory to be protected
-  */
-  MPU_InitStruct.Enable = MPU_REGION_ENABLE;
-  MPU_InitStruct.Number = MPU_REGION_NUMBER0;
-  MPU_InitStruct.BaseAddress = 0x0;
-  MPU_InitStruct.Size = MPU_REGION_SIZE_4GB;
-  MPU_InitStruct.SubRegionDisable = 0x87;
-  MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL0;
-  MPU_InitStruct.AccessPermission = MPU_REGION_NO_ACCESS;
-  MPU_InitStruct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
-  MPU_InitStruct.IsShareable = MPU_ACCESS_SHAREABLE;
-  MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
-  MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
-
-  HAL_MPU_ConfigRegion(&MPU_InitStruct);
-  /* Enables the MPU */
-  HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
-
+  /* XSPI1AXI SRAMAHB SRAMnoncacheable_bufferԣʹI-CacheD-CacheBSP/mpu_cache.h */
+  mpu_cache_init();
 }
 
 /**
@@ -22,6 +22,8 @@
 #include "stm32h7rsxx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "norflash_w25q128.h"
+#include "usart.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -199,5 +201,36 @@ void SysTick_Handler(void)
 /******************************************************************************/
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles XSPI1 global interrupt.
+  */
+void XSPI1_IRQHandler(void)
+{
+  norflash_xspi1_irq_handler();
+}
+
+/**
+  * @brief This function handles HPDMA1 Channel 0 global interrupt.
+  */
+void HPDMA1_Channel0_IRQHandler(void)
+{
+  norflash_dma_irq_handler();
+}
+
+/**
+  * @brief This function handles USART1 global interrupt.
+  */
+void USART1_IRQHandler(void)
+{
+  uart1_irq_handler();
+}
+
+/**
+  * @brief This function handles GPDMA1 Channel 0 global interrupt.
+  */
+void GPDMA1_Channel0_IRQHandler(void)
+{
+  uart1_rx_dma_irq_handler();
+}
 
 /* USER CODE END 1 */
@@ -25,6 +25,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include "mpu_cache.h"
 /* USER CODE END 0 */
 
 /* USART1 init function */
@@ -90,10 +91,273 @@ void MX_USART1_UART_Init(void)
 }
 
 /* USER CODE BEGIN 1 */
+/* USART1ջλGPDMA1ͨ0ѭֻһڵָ */
+#define UART1_RX_DMA_CHANNEL        LL_DMA_CHANNEL_0
+#define UART1_RX_BUFFER_SIZE        (8192)
+#define UART1_BAUDRATE_ERROR_MAX    (3)     /* % */
+
+static uint8_t g_uart1_rx_buffer[UART1_RX_BUFFER_SIZE] __attribute__((aligned(32)));
+static LL_DMA_LinkNodeTypeDef g_uart1_rx_node __attribute__((aligned(32)));
+static volatile uint32_t g_uart1_rx_laps = 0;       /* DMAдλȦ */
+static volatile uint8_t g_uart1_rx_idle = 0;        /* ·б־ */
+static uint32_t g_uart1_rx_read = 0;                /* Ѷȡܳ */
+static uint32_t g_uart1_rx_errors = 0;              /* ֡ */
+static uint32_t g_uart1_rx_overflows = 0;           /* λ */
+
+/**
+ * @brief   USART1 DMA
+ * @note    GPDMA1ͨ0ѭд뻷λжϼȦUSART1ж·б־
+ * @param   
+ * @retval  
+ */
+void uart1_rx_start(void)
+{
+    LL_DMA_InitNodeTypeDef node_init = {0};
+    LL_DMA_InitLinkedListTypeDef list_init = {0};
+
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_GPDMA1);
+
+    LL_DMA_NodeStructInit(&node_init);
+    node_init.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    node_init.Request = LL_GPDMA1_REQUEST_USART1_RX;
+    node_init.SrcAddress = LL_USART_DMA_GetRegAddr(USART1, LL_USART_DMA_REG_DATA_RECEIVE);
+    node_init.SrcIncMode = LL_DMA_SRC_FIXED;
+    node_init.DestAddress = (uint32_t)g_uart1_rx_buffer;
+    node_init.DestIncMode = LL_DMA_DEST_INCREMENT;
+    node_init.BlkDataLength = UART1_RX_BUFFER_SIZE;
+    node_init.TransferEventMode = LL_DMA_TCEM_BLK_TRANSFER;
+    node_init.UpdateRegisters = LL_DMA_UPDATE_CTR1 | LL_DMA_UPDATE_CTR2 | LL_DMA_UPDATE_CBR1 |
+                                LL_DMA_UPDATE_CSAR | LL_DMA_UPDATE_CDAR | LL_DMA_UPDATE_CLLR;
+    node_init.NodeType = LL_DMA_GPDMA_LINEAR_NODE;
+    LL_DMA_CreateLinkNode(&node_init, &g_uart1_rx_node);
+    LL_DMA_ConnectLinkNode(&g_uart1_rx_node, LL_DMA_CLLR_OFFSET5, &g_uart1_rx_node, LL_DMA_CLLR_OFFSET5);
+
+    LL_DMA_ListStructInit(&list_init);
+    list_init.Priority = LL_DMA_HIGH_PRIORITY;
+    list_init.TransferEventMode = LL_DMA_TCEM_BLK_TRANSFER;
+    LL_DMA_List_Init(GPDMA1, UART1_RX_DMA_CHANNEL, &list_init);
+    LL_DMA_SetLinkedListBaseAddr(GPDMA1, UART1_RX_DMA_CHANNEL, (uint32_t)&g_uart1_rx_node);
+    LL_DMA_ConfigLinkUpdate(GPDMA1, UART1_RX_DMA_CHANNEL, node_init.UpdateRegisters, (uint32_t)&g_uart1_rx_node);
+
+    g_uart1_rx_laps = 0;
+    g_uart1_rx_read = 0;
+    g_uart1_rx_idle = 0;
+
+    LL_DMA_EnableIT_TC(GPDMA1, UART1_RX_DMA_CHANNEL);
+    HAL_NVIC_SetPriority(GPDMA1_Channel0_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(GPDMA1_Channel0_IRQn);
+    LL_DMA_EnableChannel(GPDMA1, UART1_RX_DMA_CHANNEL);
+
+    LL_USART_ClearFlag_IDLE(USART1);
+    LL_USART_ClearFlag_ORE(USART1);
+    LL_USART_EnableDMAReq_RX(USART1);
+    LL_USART_EnableIT_IDLE(USART1);
+    LL_USART_EnableIT_ERROR(USART1);
+    HAL_NVIC_SetPriority(USART1_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
+}
+
+/**
+ * @brief   ֹͣUSART1 DMA
+ * @note    תӦóǰãDMAд뻷λ
+ * @param   
+ * @retval  
+ */
+void uart1_rx_stop(void)
+{
+    HAL_NVIC_DisableIRQ(USART1_IRQn);
+    HAL_NVIC_DisableIRQ(GPDMA1_Channel0_IRQn);
+    LL_USART_DisableIT_IDLE(USART1);
+    LL_USART_DisableIT_ERROR(USART1);
+    LL_USART_DisableDMAReq_RX(USART1);
+    LL_DMA_DisableChannel(GPDMA1, UART1_RX_DMA_CHANNEL);
+}
+
+/**
+ * @brief   ȡDMAд뻷λܳ
+ * @param   
+ * @retval  ܳ
+ */
+static uint32_t uart1_rx_position(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t laps;
+    uint32_t remain;
+
+    __disable_irq();
+    laps = g_uart1_rx_laps;
+    remain = LL_DMA_GetBlkDataLength(GPDMA1, UART1_RX_DMA_CHANNEL);
+
+    /* תһȦװ鳤ȣжδ */
+    if ((LL_DMA_IsActiveFlag_TC(GPDMA1, UART1_RX_DMA_CHANNEL) != 0) && (remain > (UART1_RX_BUFFER_SIZE / 2)))
+    {
+        laps++;
+    }
+    __set_PRIMASK(primask);
+
+    return laps * UART1_RX_BUFFER_SIZE + (UART1_RX_BUFFER_SIZE - remain);
+}
+
+/**
+ * @brief   ȡUSART1ѽյ
+ * @note    ȴλʱȫδݣϲЭش
+ * @param   data: ݴ洢
+ * @param   length: ȡ
+ * @retval  ȡ
+ */
+uint32_t uart1_read(uint8_t *data, uint32_t length)
+{
+    uint32_t write = uart1_rx_position();
+    uint32_t count = write - g_uart1_rx_read;
+    uint32_t index;
+    uint32_t chunk;
+
+    if (count > UART1_RX_BUFFER_SIZE)
+    {
+        g_uart1_rx_overflows++;
+        g_uart1_rx_read = write;
+        return 0;
+    }
+
+    if (count > length)
+    {
+        count = length;
+    }
+
+    index = g_uart1_rx_read % UART1_RX_BUFFER_SIZE;
+    chunk = UART1_RX_BUFFER_SIZE - index;
+    if (chunk > count)
+    {
+        chunk = count;
+    }
+
+    /* D-CacheʱCacheеľ */
+    mpu_cache_invalidate(&g_uart1_rx_buffer[index], chunk);
+    mpu_cache_invalidate(g_uart1_rx_buffer, count - chunk);
+
+    memcpy(data, &g_uart1_rx_buffer[index], chunk);
+    memcpy(data + chunk, g_uart1_rx_buffer, count - chunk);
+    g_uart1_rx_read += count;
+
+    return count;
+}
+
+/**
+ * @brief   ѯUSART1·б־
+ * @param   
+ * @retval  0: δ, 1: չݺ·
+ */
+uint8_t uart1_rx_idle(void)
+{
+    uint8_t idle = g_uart1_rx_idle;
+
+    g_uart1_rx_idle = 0;
+
+    return idle;
+}
+
+/**
+ * @brief   USART1
+ * @note    ѯTXEͣͼĴռдһֽ
+ * @param   data: 
+ * @param   length: ݳ
+ * @retval  
+ */
+void uart1_write(const uint8_t *data, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        while (LL_USART_IsActiveFlag_TXE(USART1) == 0);
+        LL_USART_TransmitData8(USART1, data[i]);
+    }
+}
+
+/**
+ * @brief   лUSART1
+ * @note    ȴɺлUSART1ʱΪPCLK2Ƶ16ʱ8
+ * @param   baudrate: 
+ * @retval  0: ɹ, 1: UART1_BAUDRATE_ERROR_MAX
+ */
+uint8_t uart1_set_baudrate(uint32_t baudrate)
+{
+    uint32_t clock = HAL_RCC_GetPCLK2Freq();
+    uint32_t oversampling = LL_USART_OVERSAMPLING_16;
+    uint32_t factor = 1;
+    uint32_t div;
+    uint32_t actual;
+    uint32_t error;
+
+    if ((baudrate == 0) || ((clock / baudrate) < 8))
+    {
+        return 1;
+    }
+
+    if ((clock / baudrate) < 16)
+    {
+        oversampling = LL_USART_OVERSAMPLING_8;
+        factor = 2;
+    }
+
+    div = (clock * factor + baudrate / 2) / baudrate;
+    actual = clock * factor / div;
+    error = (actual > baudrate) ? (actual - baudrate) : (baudrate - actual);
+    if ((error * 100) > (baudrate * UART1_BAUDRATE_ERROR_MAX))
+    {
+        return 1;
+    }
+
+    while (LL_USART_IsActiveFlag_TC(USART1) == 0);
+
+    LL_USART_Disable(USART1);
+    LL_USART_SetOverSampling(USART1, oversampling);
+    LL_USART_SetBaudRate(USART1, clock, LL_USART_PRESCALER_DIV1, oversampling, baudrate);
+    LL_USART_Enable(USART1);
+
+    return 0;
+}
+
+/**
+ * @brief   USART1жϴ
+ * @param   
+ * @retval  
+ */
+void uart1_irq_handler(void)
+{
+    if (LL_USART_IsActiveFlag_IDLE(USART1) != 0)
+    {
+        LL_USART_ClearFlag_IDLE(USART1);
+        g_uart1_rx_idle = 1;
+    }
+
+    if ((LL_USART_IsActiveFlag_ORE(USART1) != 0) || (LL_USART_IsActiveFlag_FE(USART1) != 0) || (LL_USART_IsActiveFlag_NE(USART1) != 0))
+    {
+        LL_USART_ClearFlag_ORE(USART1);
+        LL_USART_ClearFlag_FE(USART1);
+        LL_USART_ClearFlag_NE(USART1);
+        g_uart1_rx_errors++;
+    }
+}
+
+/**
+ * @brief   USART1DMAжϴ
+ * @param   
+ * @retval  
+ */
+void uart1_rx_dma_irq_handler(void)
+{
+    if (LL_DMA_IsActiveFlag_TC(GPDMA1, UART1_RX_DMA_CHANNEL) != 0)
+    {
+        LL_DMA_ClearFlag_TC(GPDMA1, UART1_RX_DMA_CHANNEL);
+        g_uart1_rx_laps++;
+    }
+}
+
 static void uart1_send_byte(uint8_t Data)
 {
 
-	while(!LL_USART_IsActiveFlag_TC(USART1))
+	while(!LL_USART_IsActiveFlag_TXE(USART1))
         ; // wait;
     LL_USART_TransmitData8(USART1, Data);
 
@@ -0,0 +1,682 @@
+/**
+ ****************************************************************************************************
+ * @file        boot_trace_decode.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ʱ߽빤
+ ****************************************************************************************************
+ * @attention
+ *
+ * ѴӱSRAMĸٻBSP/boot_trace.hΪBootloaderӦó׶ʱ
+ * ¼֮ǰһ¼CPUƵʻ㣺лʱӵĽ׶ΣSystemClock_Configת
+ * лǰƵʼ㣬׶εĴ󲿷ʱ仨ڵȴPLL/HSIϣС
+ *
+ * ÷: boot_trace_decode [-a address] trace.hex|trace.bin
+ *       boot_trace_decode selftest
+ *       trace.hex: Keilʱ SAVE trace.hex 0x38800800,0x38800FFF Intel HEXļ
+ *       trace.bin: ӻ׵ַʼĶļJ-Link savebin
+ *       -a: Intel HEXлĵַĬBOOT_TRACE_BASE
+ *
+ ****************************************************************************************************
+ */
+
+#include "boot_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* ¼ */
+typedef struct {
+    uint32_t cycles;            /* DWT->CYCCNT */
+    uint16_t id;                /* ¼|׶ID */
+    uint16_t mhz;               /* CPUƵʣMHz */
+    double time;                /* Եһ¼ʱ䣨us */
+    double duration;            /* BEGINӦENDʱ䣨usENDʱΪ-1 */
+    int depth;                  /* Ƕ */
+} trace_event_t;
+
+/*  */
+typedef struct {
+    uint32_t count;             /* дļ¼ */
+    uint32_t boots;             /*  */
+    uint32_t lost;              /* ǵļ¼ */
+    uint32_t number;            /* ¼ */
+    trace_event_t event[BOOT_TRACE_CAPACITY];
+} trace_t;
+
+/* ׶ */
+static const struct {
+    uint16_t id;
+    const char *name;
+} trace_names[] = {
+    {BOOT_TRACE_ID_MAIN,                    "boot main"},
+    {BOOT_TRACE_ID_MPU_CONFIG,              "MPU_Config"},
+    {BOOT_TRACE_ID_HAL_INIT,                "HAL_Init"},
+    {BOOT_TRACE_ID_CLOCK_CONFIG,            "SystemClock_Config"},
+    {BOOT_TRACE_ID_PERIPH_INIT,             "GPIO/USART init"},
+    {BOOT_TRACE_ID_NORFLASH_INIT,           "norflash_init"},
+    {BOOT_TRACE_ID_NORFLASH_XSPI_INIT,      "XSPI1 init"},
+    {BOOT_TRACE_ID_NORFLASH_DEVICE_INIT,    "NOR Flash device init"},
+    {BOOT_TRACE_ID_NORFLASH_RESET,          "NOR Flash reset"},
+    {BOOT_TRACE_ID_NORFLASH_TEST,           "NOR Flash test"},
+    {BOOT_TRACE_ID_KV_MOUNT,                "norflash_kv_mount"},
+    {BOOT_TRACE_ID_SLOT_SELECT,             "boot_slot_select"},
+    {BOOT_TRACE_ID_MEMORY_MAPPED,           "norflash_memory_mapped"},
+    {BOOT_TRACE_ID_JUMP,                    "jump to app"},
+    {BOOT_TRACE_ID_LOAD_SECTIONS,           "boot_image_load_sections"},
+    {BOOT_TRACE_ID_APP_MAIN,                "app main"},
+    {BOOT_TRACE_ID_APP_MPU_CONFIG,          "app MPU_Config"},
+    {BOOT_TRACE_ID_APP_HAL_INIT,            "app HAL_Init"},
+    {BOOT_TRACE_ID_APP_PERIPH_INIT,         "app peripheral init"},
+    {BOOT_TRACE_ID_APP_READY,               "app ready"},
+};
+
+static int selftest_failures = 0;
+
+/**
+ * @brief   ӡ÷
+ * @param   name: 
+ * @retval  2
+ */
+static int usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-a address] trace.hex|trace.bin\n", name);
+    fprintf(stderr, "       %s selftest\n", name);
+    return 2;
+}
+
+/**
+ * @brief   ȡС32λ
+ * @param   data: 
+ * @retval  ֵ
+ */
+static uint32_t get_le32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/**
+ * @brief   ȡС16λ
+ * @param   data: 
+ * @retval  ֵ
+ */
+static uint16_t get_le16(const uint8_t *data)
+{
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+/**
+ * @brief   Intel HEXļ
+ * @param   file: ļ
+ * @param   address: ַ
+ * @param   image: BOOT_TRACE_SIZEֽڣ
+ * @retval  0: ɹ, -1: ʽδͷ
+ */
+static int load_hex(FILE *file, uint32_t address, uint8_t *image)
+{
+    char line[600];
+    uint8_t record[256 + 5];
+    uint32_t upper = 0;
+    uint32_t offset;
+    uint32_t covered = 0;
+    unsigned int value;
+    uint8_t sum;
+    int length;
+    int index;
+    int number = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        number++;
+        if ((line[0] == '\r') || (line[0] == '\n') || (line[0] == '\0'))
+        {
+            continue;
+        }
+
+        /* :LLAAAATT<>CC */
+        length = (int)strcspn(line + 1, "\r\n");
+        if ((line[0] != ':') || (length < 10) || ((length & 1) != 0))
+        {
+            fprintf(stderr, "line %d: bad record\n", number);
+            return -1;
+        }
+        sum = 0;
+        for (index = 0; index < length / 2; index++)
+        {
+            if (sscanf(line + 1 + index * 2, "%2x", &value) != 1)
+            {
+                fprintf(stderr, "line %d: bad hex digit\n", number);
+                return -1;
+            }
+            record[index] = (uint8_t)value;
+            sum += (uint8_t)value;
+        }
+        if ((sum != 0) || ((record[0] + 5) != (length / 2)))
+        {
+            fprintf(stderr, "line %d: bad checksum\n", number);
+            return -1;
+        }
+
+        switch (record[3])
+        {
+            case 0x00:  /*  */
+                for (index = 0; index < record[0]; index++)
+                {
+                    offset = upper + ((uint32_t)record[1] << 8) + record[2] + (uint32_t)index - address;
+                    if (offset < BOOT_TRACE_SIZE)
+                    {
+                        image[offset] = record[4 + index];
+                        if (offset < BOOT_TRACE_HEADER_SIZE)
+                        {
+                            covered |= 1UL << offset;
+                        }
+                    }
+                }
+                break;
+            case 0x01:  /*  */
+                return (covered == ((1UL << BOOT_TRACE_HEADER_SIZE) - 1)) ? 0 : -1;
+            case 0x02:  /* չεַ */
+                upper = (((uint32_t)record[4] << 8) | record[5]) << 4;
+                break;
+            case 0x04:  /* չԵַ */
+                upper = (((uint32_t)record[4] << 8) | record[5]) << 16;
+                break;
+            default:
+                break;
+        }
+    }
+
+    fprintf(stderr, "missing end record\n");
+    return -1;
+}
+
+/**
+ * @brief   ȡٻļ
+ * @note    ':'ͷİIntel HEX򰴴ӻ׵ַʼĶļȡ
+ * @param   path: ļ·
+ * @param   address: Intel HEXлĵַ
+ * @param   image: BOOT_TRACE_SIZEֽڣ
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int load_trace(const char *path, uint32_t address, uint8_t *image)
+{
+    FILE *file;
+    size_t length;
+    int first;
+    int res;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    memset(image, 0xFF, BOOT_TRACE_SIZE);
+    first = fgetc(file);
+    rewind(file);
+    if (first == ':')
+    {
+        res = load_hex(file, address, image);
+    }
+    else
+    {
+        length = fread(image, 1, BOOT_TRACE_SIZE, file);
+        res = (length >= BOOT_TRACE_HEADER_SIZE) ? 0 : -1;
+    }
+    fclose(file);
+
+    if (res != 0)
+    {
+        fprintf(stderr, "%s: no trace buffer\n", path);
+    }
+
+    return res;
+}
+
+/**
+ * @brief   ٻ
+ * @param   image: BOOT_TRACE_SIZEֽڣ
+ * @param   trace: 
+ * @retval  0: ɹ, -1: Ч
+ */
+static int trace_decode(const uint8_t *image, trace_t *trace)
+{
+    trace_event_t *event;
+    const uint8_t *record;
+    uint32_t capacity;
+    uint32_t first;
+    uint32_t index;
+    uint32_t later;
+    int depth = 0;
+    int nest;
+
+    capacity = get_le16(image + 6);
+    if ((get_le32(image) != BOOT_TRACE_MAGIC) || (get_le16(image + 4) != BOOT_TRACE_VERSION) || (capacity != BOOT_TRACE_CAPACITY))
+    {
+        return -1;
+    }
+
+    trace->count = get_le32(image + 8);
+    trace->boots = get_le32(image + 12);
+    trace->number = (trace->count < capacity) ? trace->count : capacity;
+    trace->lost = trace->count - trace->number;
+    first = trace->lost;
+
+    for (index = 0; index < trace->number; index++)
+    {
+        event = &trace->event[index];
+        record = image + BOOT_TRACE_HEADER_SIZE + ((first + index) % capacity) * 8;
+        event->cycles = get_le32(record);
+        event->id = get_le16(record + 4);
+        event->mhz = get_le16(record + 6);
+        event->duration = -1;
+
+        /* CYCCNTΪ32λֵģ2^32 */
+        if (index == 0)
+        {
+            event->time = 0;
+        }
+        else
+        {
+            event->time = event[-1].time + (double)(uint32_t)(event->cycles - event[-1].cycles) / ((event[-1].mhz != 0) ? event[-1].mhz : 1);
+        }
+
+        if ((event->id & BOOT_TRACE_FLAG_MASK) == BOOT_TRACE_FLAG_END)
+        {
+            depth = (depth > 0) ? (depth - 1) : 0;
+        }
+        event->depth = depth;
+        if ((event->id & BOOT_TRACE_FLAG_MASK) == BOOT_TRACE_FLAG_BEGIN)
+        {
+            depth++;
+        }
+    }
+
+    /* ΪÿBEGINҵͬIDENDͬIDǶף */
+    for (index = 0; index < trace->number; index++)
+    {
+        if ((trace->event[index].id & BOOT_TRACE_FLAG_MASK) != BOOT_TRACE_FLAG_BEGIN)
+        {
+            continue;
+        }
+        nest = 0;
+        for (later = index + 1; later < trace->number; later++)
+        {
+            if (trace->event[later].id == trace->event[index].id)
+            {
+                nest++;
+            }
+            else if (trace->event[later].id == ((trace->event[index].id & BOOT_TRACE_ID_MASK) | BOOT_TRACE_FLAG_END))
+            {
+                if (nest-- == 0)
+                {
+                    trace->event[index].duration = trace->event[later].time - trace->event[index].time;
+                    break;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief   ҵһָIDʱ׶οʼ
+ * @param   trace: 
+ * @param   id: ׶ID
+ * @retval  ¼δҵNULL
+ */
+static const trace_event_t *trace_find(const trace_t *trace, uint16_t id)
+{
+    uint32_t index;
+
+    for (index = 0; index < trace->number; index++)
+    {
+        if (((trace->event[index].id & BOOT_TRACE_ID_MASK) == id) && ((trace->event[index].id & BOOT_TRACE_FLAG_MASK) != BOOT_TRACE_FLAG_END))
+        {
+            return &trace->event[index];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief   ȡ׶
+ * @param   id: ׶ID
+ * @param   buffer: ԶIDƻ
+ * @retval  
+ */
+static const char *trace_name(uint16_t id, char buffer[16])
+{
+    size_t index;
+
+    for (index = 0; index < (sizeof(trace_names) / sizeof(trace_names[0])); index++)
+    {
+        if (trace_names[index].id == id)
+        {
+            return trace_names[index].name;
+        }
+    }
+    if (id >= BOOT_TRACE_ID_USER)
+    {
+        snprintf(buffer, 16, "user %u", (unsigned int)(id - BOOT_TRACE_ID_USER));
+    }
+    else
+    {
+        snprintf(buffer, 16, "id 0x%04X", (unsigned int)id);
+    }
+
+    return buffer;
+}
+
+/**
+ * @brief   ӡʱ֮ʱ
+ * @param   label: 
+ * @param   from: 
+ * @param   to: յ
+ * @retval  
+ */
+static void print_span(const char *label, const trace_event_t *from, const trace_event_t *to)
+{
+    if ((from != NULL) && (to != NULL))
+    {
+        printf("%-24s %12.3f us\n", label, to->time - from->time);
+    }
+}
+
+/**
+ * @brief   ӡʱ
+ * @param   trace: 
+ * @retval  
+ */
+static void trace_print(const trace_t *trace)
+{
+    const trace_event_t *event;
+    char name[16];
+    uint32_t index;
+
+    printf("boot #%u, %u records", (unsigned int)trace->boots, (unsigned int)trace->number);
+    if (trace->lost != 0)
+    {
+        printf(" (%u earliest overwritten, times relative to the oldest record)", (unsigned int)trace->lost);
+    }
+    printf("\n\n%12s %12s %5s  %s\n", "time(us)", "stage(us)", "MHz", "stage");
+
+    for (index = 0; index < trace->number; index++)
+    {
+        event = &trace->event[index];
+        switch (event->id & BOOT_TRACE_FLAG_MASK)
+        {
+            case BOOT_TRACE_FLAG_BEGIN:
+                if (event->duration >= 0)
+                {
+                    printf("%12.3f %12.3f %5u  %*s%s\n", event->time, event->duration, event->mhz, event->depth * 2, "",
+                           trace_name(event->id & BOOT_TRACE_ID_MASK, name));
+                }
+                else
+                {
+                    printf("%12.3f %12s %5u  %*s%s\n", event->time, "(no end)", event->mhz, event->depth * 2, "",
+                           trace_name(event->id & BOOT_TRACE_ID_MASK, name));
+                }
+                break;
+            case BOOT_TRACE_FLAG_MARK:
+                printf("%12.3f %12s %5u  %*s* %s\n", event->time, "", event->mhz, event->depth * 2, "",
+                       trace_name(event->id & BOOT_TRACE_ID_MASK, name));
+                break;
+            default:
+                break;
+        }
+    }
+
+    printf("\n");
+    print_span("bootloader", trace_find(trace, BOOT_TRACE_ID_MAIN), trace_find(trace, BOOT_TRACE_ID_JUMP));
+    print_span("jump to app main", trace_find(trace, BOOT_TRACE_ID_JUMP), trace_find(trace, BOOT_TRACE_ID_APP_MAIN));
+    print_span("application", trace_find(trace, BOOT_TRACE_ID_APP_MAIN), trace_find(trace, BOOT_TRACE_ID_APP_READY));
+    if (trace->number != 0)
+    {
+        print_span("total", &trace->event[0], &trace->event[trace->number - 1]);
+    }
+}
+
+/**
+ * @brief   Բ
+ * @param   name: 
+ * @param   ok: 
+ * @retval  
+ */
+static void selftest_check(const char *name, int ok)
+{
+    printf("%-32s %s\n", name, ok ? "ok" : "FAIL");
+    if (!ok)
+    {
+        selftest_failures++;
+    }
+}
+
+/**
+ * @brief   Ƚʱ䣨1ns
+ * @param   value: ʱ䣨us
+ * @param   expect: ֵus
+ * @retval  1: ͬ, 0: ͬ
+ */
+static int selftest_time(double value, double expect)
+{
+    return (value > (expect - 0.001)) && (value < (expect + 0.001));
+}
+
+/**
+ * @brief   ̼ķʽдһټ¼
+ * @param   image: 
+ * @param   cycles: DWT->CYCCNT
+ * @param   id: ¼|׶ID
+ * @param   mhz: CPUƵʣMHz
+ * @retval  
+ */
+static void selftest_record(uint8_t *image, uint32_t cycles, uint16_t id, uint16_t mhz)
+{
+    uint32_t count = get_le32(image + 8);
+    uint8_t *record = image + BOOT_TRACE_HEADER_SIZE + (count % BOOT_TRACE_CAPACITY) * 8;
+    int index;
+
+    for (index = 0; index < 4; index++)
+    {
+        record[index] = (uint8_t)(cycles >> (index * 8));
+        image[8 + index] = (uint8_t)((count + 1) >> (index * 8));
+    }
+    record[4] = (uint8_t)id;
+    record[5] = (uint8_t)(id >> 8);
+    record[6] = (uint8_t)mhz;
+    record[7] = (uint8_t)(mhz >> 8);
+}
+
+/**
+ * @brief   ½ٻ
+ * @param   image: 
+ * @param   boots: 
+ * @retval  
+ */
+static void selftest_start(uint8_t *image, uint32_t boots)
+{
+    memset(image, 0xA5, BOOT_TRACE_SIZE);
+    memset(image, 0, BOOT_TRACE_HEADER_SIZE);
+    image[0] = (uint8_t)BOOT_TRACE_MAGIC;
+    image[1] = (uint8_t)(BOOT_TRACE_MAGIC >> 8);
+    image[2] = (uint8_t)(BOOT_TRACE_MAGIC >> 16);
+    image[3] = (uint8_t)(BOOT_TRACE_MAGIC >> 24);
+    image[4] = BOOT_TRACE_VERSION;
+    image[6] = (uint8_t)BOOT_TRACE_CAPACITY;
+    image[7] = (uint8_t)(BOOT_TRACE_CAPACITY >> 8);
+    image[12] = (uint8_t)boots;
+}
+
+/**
+ * @brief   Keil SAVEĸʽдIntel HEXļ
+ * @param   path: ļ·
+ * @param   address: ַ
+ * @param   image: 
+ * @param   checksum: 0: ȷУ, 1: һݼ¼Уʹ
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int selftest_write_hex(const char *path, uint32_t address, const uint8_t *image, int checksum)
+{
+    FILE *file;
+    uint32_t offset;
+    uint32_t current;
+    uint8_t sum;
+    int index;
+
+    file = fopen(path, "w");
+    if (file == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    fprintf(file, ":02000004%04X%02X\n", (unsigned int)(address >> 16),
+            (unsigned int)(uint8_t)(0 - (2 + 4 + (address >> 24) + ((address >> 16) & 0xFF))));
+    for (offset = 0; offset < BOOT_TRACE_SIZE; offset += 16)
+    {
+        current = address + offset;
+        sum = (uint8_t)(16 + ((current >> 8) & 0xFF) + (current & 0xFF));
+        fprintf(file, ":10%04X00", (unsigned int)(current & 0xFFFF));
+        for (index = 0; index < 16; index++)
+        {
+            fprintf(file, "%02X", image[offset + index]);
+            sum += image[offset + index];
+        }
+        sum = (uint8_t)(0 - sum);
+        if ((checksum != 0) && (offset == 0))
+        {
+            sum++;
+        }
+        fprintf(file, "%02X\n", sum);
+    }
+    fprintf(file, ":00000001FF\n");
+    fclose(file);
+
+    return 0;
+}
+
+/**
+ * @brief   Բ
+ * @param   
+ * @retval  0: ͨ, 1: ʧ
+ */
+static int cmd_selftest(void)
+{
+    static uint8_t image[BOOT_TRACE_SIZE];
+    static uint8_t loaded[BOOT_TRACE_SIZE];
+    static trace_t trace;
+    const char *hex_path = "selftest_trace.hex";
+    const char *bin_path = "selftest_trace.bin";
+    const trace_event_t *event;
+    uint32_t cycles;
+    uint32_t index;
+    FILE *file;
+
+    /* ģһBootloader64MHzʱӵ600MHzתǰָHSIӦó¼ */
+    selftest_start(image, 3);
+    selftest_record(image, 0, BOOT_TRACE_ID_MAIN | BOOT_TRACE_FLAG_MARK, 64);
+    selftest_record(image, 64, BOOT_TRACE_ID_MPU_CONFIG | BOOT_TRACE_FLAG_BEGIN, 64);
+    selftest_record(image, 128, BOOT_TRACE_ID_MPU_CONFIG | BOOT_TRACE_FLAG_END, 64);
+    selftest_record(image, 128, BOOT_TRACE_ID_CLOCK_CONFIG | BOOT_TRACE_FLAG_BEGIN, 64);
+    selftest_record(image, 64128, BOOT_TRACE_ID_CLOCK_CONFIG | BOOT_TRACE_FLAG_END, 600);
+    selftest_record(image, 70128, BOOT_TRACE_ID_NORFLASH_INIT | BOOT_TRACE_FLAG_BEGIN, 600);
+    selftest_record(image, 70728, BOOT_TRACE_ID_NORFLASH_RESET | BOOT_TRACE_FLAG_BEGIN, 600);
+    selftest_record(image, 670728, BOOT_TRACE_ID_NORFLASH_RESET | BOOT_TRACE_FLAG_END, 600);
+    selftest_record(image, 700128, BOOT_TRACE_ID_NORFLASH_INIT | BOOT_TRACE_FLAG_END, 600);
+    selftest_record(image, 760128, BOOT_TRACE_ID_JUMP | BOOT_TRACE_FLAG_MARK, 64);
+    selftest_record(image, 760768, BOOT_TRACE_ID_APP_MAIN | BOOT_TRACE_FLAG_MARK, 64);
+    selftest_record(image, 762048, BOOT_TRACE_ID_USER | BOOT_TRACE_FLAG_BEGIN, 64);
+    selftest_record(image, 762048, BOOT_TRACE_ID_APP_READY | BOOT_TRACE_FLAG_MARK, 64);
+
+    selftest_check("write hex", selftest_write_hex(hex_path, BOOT_TRACE_BASE, image, 0) == 0);
+    selftest_check("load hex", (load_trace(hex_path, BOOT_TRACE_BASE, loaded) == 0) && (memcmp(image, loaded, BOOT_TRACE_SIZE) == 0));
+    selftest_check("decode", (trace_decode(loaded, &trace) == 0) && (trace.number == 13) && (trace.boots == 3) && (trace.lost == 0));
+    selftest_check("MPU_Config 1us", selftest_time(trace.event[1].duration, 1.0));
+    selftest_check("clock config at old clock", selftest_time(trace.event[3].duration, 1000.0));
+    selftest_check("nested reset 1000us", (trace.event[6].depth == 1) && selftest_time(trace.event[6].duration, 1000.0));
+    selftest_check("norflash_init 1050us", (trace.event[5].depth == 0) && selftest_time(trace.event[5].duration, 1050.0));
+    selftest_check("missing end", trace.event[11].duration < 0);
+    event = trace_find(&trace, BOOT_TRACE_ID_JUMP);
+    selftest_check("bootloader 2162us", (event != NULL) && selftest_time(event->time, 2162.0));
+    event = trace_find(&trace, BOOT_TRACE_ID_APP_READY);
+    selftest_check("app ready 2192us", (event != NULL) && selftest_time(event->time, 2192.0));
+
+    trace_print(&trace);
+    printf("\n");
+
+    selftest_check("reject wrong address", load_trace(hex_path, BOOT_TRACE_BASE + 0x800, loaded) != 0);
+    selftest_check("write bad checksum", selftest_write_hex(hex_path, BOOT_TRACE_BASE, image, 1) == 0);
+    selftest_check("reject bad checksum", load_trace(hex_path, BOOT_TRACE_BASE, loaded) != 0);
+
+    /* ļ¼ļ¼CYCCNTԽ2^32 */
+    selftest_start(image, 1);
+    cycles = 0xFFFFF000UL;
+    for (index = 0; index < (BOOT_TRACE_CAPACITY + 5); index++)
+    {
+        selftest_record(image, cycles, (uint16_t)(BOOT_TRACE_ID_USER | (((index & 1) == 0) ? BOOT_TRACE_FLAG_BEGIN : BOOT_TRACE_FLAG_END)), 100);
+        cycles += 100;
+    }
+    file = fopen(bin_path, "wb");
+    selftest_check("write bin", (file != NULL) && (fwrite(image, 1, BOOT_TRACE_SIZE, file) == BOOT_TRACE_SIZE) && (fclose(file) == 0));
+    selftest_check("load bin", (load_trace(bin_path, 0, loaded) == 0) && (memcmp(image, loaded, BOOT_TRACE_SIZE) == 0));
+    selftest_check("decode wrapped", (trace_decode(loaded, &trace) == 0) && (trace.number == BOOT_TRACE_CAPACITY) && (trace.lost == 5));
+    selftest_check("oldest record kept", trace.event[0].cycles == (uint32_t)(0xFFFFF000UL + 500));
+    selftest_check("CYCCNT wrap", selftest_time(trace.event[BOOT_TRACE_CAPACITY - 1].time, (BOOT_TRACE_CAPACITY - 1) * 1.0));
+    selftest_check("wrapped pairs", selftest_time(trace.event[1].duration, 1.0) && (trace.event[0].duration < 0));
+
+    loaded[0] ^= 1;
+    selftest_check("reject bad magic", trace_decode(loaded, &trace) != 0);
+
+    remove(hex_path);
+    remove(bin_path);
+    printf("%s\n", (selftest_failures == 0) ? "PASS" : "FAIL");
+
+    return (selftest_failures == 0) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t image[BOOT_TRACE_SIZE];
+    static trace_t trace;
+    uint32_t address = BOOT_TRACE_BASE;
+    int opt;
+
+    if ((argc == 2) && (strcmp(argv[1], "selftest") == 0))
+    {
+        return cmd_selftest();
+    }
+
+    while ((opt = getopt(argc, argv, "a:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'a':
+                address = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                return usage(argv[0]);
+        }
+    }
+    if ((argc - optind) != 1)
+    {
+        return usage(argv[0]);
+    }
+
+    if (load_trace(argv[optind], address, image) != 0)
+    {
+        return 1;
+    }
+    if (trace_decode(image, &trace) != 0)
+    {
+        fprintf(stderr, "%s: bad trace header (magic/version/capacity)\n", argv[optind]);
+        return 1;
+    }
+    trace_print(&trace);
+
+    return 0;
+}
@@ -0,0 +1,618 @@
+/**
+ ****************************************************************************************************
+ * @file        delta_sw.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ӦóοӦ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ɲʱ¾˳̰ƥ䣺γԽһεľɾλã滻룩
+ * 16ֽڴڹϣеλãֽͬڵ1ֽ֡ͬڿDELTA_SW_PENALTY죬
+ * ȡ÷ߴΪһΣȫͬCOPYADDֻ¼0ֵƥ䲻ʱDATA
+ * ӵһ۵ĴֻоԵַͬȫADDʾ
+ *
+ ****************************************************************************************************
+ */
+
+#include "delta_sw.h"
+#include "image_sw.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ƥ */
+#define DELTA_SW_WINDOW         (16)        /* ϣڳ */
+#define DELTA_SW_HASH_BITS      (22)        /* ϣСλ */
+#define DELTA_SW_MIN_SAME       (16)        /* һиֽͬڲþɾ */
+#define DELTA_SW_PENALTY        (3)         /* ÿֽͬڿ۷֣ԼΪADDһֵı볤ȣ */
+#define DELTA_SW_GIVE_UP        (64)        /* ÷ֵ߷ֵָʱֹͣ */
+#define DELTA_SW_GAP            (3)         /* ֵڸóȵ0 */
+#define DELTA_SW_EMPTY          (0xFFFFFFFFUL)
+
+/*  */
+typedef struct {
+    uint8_t *data;          /*  */
+    uint32_t length;        /* ó */
+    uint32_t size;          /* ѷ䳤 */
+    int error;              /* ʧ */
+} delta_sw_buffer_t;
+
+/**
+ * @brief   ׷ݵ
+ * @param   buffer: 
+ * @param   data: ָ
+ * @param   length: ݳ
+ * @retval  
+ */
+static void delta_sw_put(delta_sw_buffer_t *buffer, const uint8_t *data, uint32_t length)
+{
+    uint8_t *grown;
+    uint32_t size;
+
+    if (buffer->error != 0)
+    {
+        return;
+    }
+
+    if ((buffer->size - buffer->length) < length)
+    {
+        size = (buffer->size != 0) ? buffer->size : 4096;
+        while ((size - buffer->length) < length)
+        {
+            size *= 2;
+        }
+
+        grown = realloc(buffer->data, size);
+        if (grown == NULL)
+        {
+            buffer->error = 1;
+            return;
+        }
+        buffer->data = grown;
+        buffer->size = size;
+    }
+
+    memcpy(&buffer->data[buffer->length], data, length);
+    buffer->length += length;
+}
+
+/**
+ * @brief   ׷LEB128޷
+ * @param   buffer: 
+ * @param   value: ֵ
+ * @retval  
+ */
+static void delta_sw_put_varint(delta_sw_buffer_t *buffer, uint32_t value)
+{
+    uint8_t byte;
+
+    do
+    {
+        byte = value & 0x7F;
+        value >>= 7;
+        if (value != 0)
+        {
+            byte |= 0x80;
+        }
+        delta_sw_put(buffer, &byte, 1);
+    } while (value != 0);
+}
+
+/**
+ * @brief   ȡLEB128޷
+ * @param   patch: 
+ * @param   size: 
+ * @param   offset: ȡλãʱָһֶ
+ * @param   value: ֵ
+ * @retval  0: ɹ, -1: ݲ򳬳32λ
+ */
+static int delta_sw_get_varint(const uint8_t *patch, uint32_t size, uint32_t *offset, uint32_t *value)
+{
+    uint32_t shift = 0;
+    uint8_t byte;
+
+    *value = 0;
+    do
+    {
+        if ((*offset >= size) || (shift > 28) || ((shift == 28) && ((patch[*offset] & 0x70) != 0)))
+        {
+            return -1;
+        }
+        byte = patch[(*offset)++];
+        *value |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while ((byte & 0x80) != 0);
+
+    return 0;
+}
+
+/**
+ * @brief   㴰ڹϣ
+ * @param   data: ݣDELTA_SW_WINDOWֽڣ
+ * @retval  ϣ±
+ */
+static uint32_t delta_sw_hash(const uint8_t *data)
+{
+    uint64_t a;
+    uint64_t b;
+
+    memcpy(&a, data, 8);
+    memcpy(&b, data + 8, 8);
+
+    return (uint32_t)((((a * 0x9E3779B97F4A7C15ULL) ^ b) * 0xC2B2AE3D27D4EB4FULL) >> (64 - DELTA_SW_HASH_BITS));
+}
+
+/**
+ * @brief   һλƥ
+ * @param   old_image: ɾ
+ * @param   old_size: ɾ񳤶
+ * @param   old_pos: ɾλ
+ * @param   new_image: ¾
+ * @param   new_size: ¾񳤶
+ * @param   new_pos: ¾λ
+ * @param   table: ɾ񴰿ڹϣ
+ * @param   length: ÷ߴĳ
+ * @param   same: óֽͬ
+ * @note    ڲֽͬڴ¾ھɾһλȫͬĴڣֹͣ죬
+ *          ݣıADDλƥڸǲľȷƥ
+ * @retval  ߵ÷
+ */
+static int32_t delta_sw_extend(const uint8_t *old_image, uint32_t old_size, uint32_t old_pos,
+                               const uint8_t *new_image, uint32_t new_size, uint32_t new_pos,
+                               const uint32_t *table, uint32_t *length, uint32_t *same)
+{
+    uint32_t exact;
+    int32_t score = 0;
+    int32_t best = 0;
+    uint32_t count = 0;
+    uint32_t index;
+
+    *length = 0;
+    *same = 0;
+    for (index = 0; ((old_pos + index) < old_size) && ((new_pos + index) < new_size); index++)
+    {
+        if (old_image[old_pos + index] == new_image[new_pos + index])
+        {
+            score++;
+            count++;
+        }
+        else
+        {
+            if ((new_pos + index + DELTA_SW_WINDOW) <= new_size)
+            {
+                exact = table[delta_sw_hash(&new_image[new_pos + index])];
+                if ((exact != DELTA_SW_EMPTY) && (exact != (old_pos + index)) &&
+                    (memcmp(&old_image[exact], &new_image[new_pos + index], DELTA_SW_WINDOW) == 0))
+                {
+                    break;
+                }
+            }
+            score -= DELTA_SW_PENALTY;
+        }
+
+        if (score > best)
+        {
+            best = score;
+            *length = index + 1;
+            *same = count;
+        }
+        else if (score < (best - DELTA_SW_GIVE_UP))
+        {
+            break;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief   DATA
+ * @param   buffer: 
+ * @param   data: 
+ * @param   length: 
+ * @param   stats: ͳ
+ * @retval  
+ */
+static void delta_sw_emit_data(delta_sw_buffer_t *buffer, const uint8_t *data, uint32_t length, delta_sw_stats_t *stats)
+{
+    uint8_t op = BOOT_DELTA_OP_DATA;
+
+    if (length == 0)
+    {
+        return;
+    }
+
+    delta_sw_put(buffer, &op, 1);
+    delta_sw_put_varint(buffer, length);
+    delta_sw_put(buffer, data, length);
+
+    stats->data_ops++;
+    stats->data_bytes += length;
+}
+
+/**
+ * @brief   COPYADD
+ * @param   buffer: 
+ * @param   old_data: 
+ * @param   new_data: 
+ * @param   length: 
+ * @param   delta: ɾƫ
+ * @param   stats: ͳ
+ * @retval  
+ */
+static void delta_sw_emit_match(delta_sw_buffer_t *buffer, const uint8_t *old_data, const uint8_t *new_data, uint32_t length,
+                                int32_t delta, delta_sw_stats_t *stats)
+{
+    uint8_t diff[256];
+    uint32_t index;
+    uint32_t start;
+    uint32_t end;
+    uint32_t gap;
+    uint32_t count;
+    uint8_t op;
+
+    op = (memcmp(old_data, new_data, length) == 0) ? BOOT_DELTA_OP_COPY : BOOT_DELTA_OP_ADD;
+    delta_sw_put(buffer, &op, 1);
+    delta_sw_put_varint(buffer, length);
+    delta_sw_put_varint(buffer, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+
+    if (op == BOOT_DELTA_OP_COPY)
+    {
+        stats->copy_ops++;
+        stats->copy_bytes += length;
+        return;
+    }
+
+    stats->add_ops++;
+    stats->add_bytes += length;
+
+    /* 飨ȡֵֵDELTA_SW_GAP0ֵ */
+    index = 0;
+    while (index < length)
+    {
+        start = index;
+        while ((index < length) && (old_data[index] == new_data[index]))
+        {
+            index++;
+        }
+        delta_sw_put_varint(buffer, index - start);
+
+        start = index;
+        end = index;
+        while (end < length)
+        {
+            if (old_data[end] != new_data[end])
+            {
+                end++;
+                continue;
+            }
+
+            for (gap = 0; ((end + gap) < length) && (old_data[end + gap] == new_data[end + gap]); gap++)
+            {
+            }
+            if (((end + gap) == length) || (gap >= DELTA_SW_GAP))
+            {
+                break;
+            }
+            end += gap;
+        }
+
+        delta_sw_put_varint(buffer, end - start);
+        while (index < end)
+        {
+            count = end - index;
+            count = (count > sizeof(diff)) ? sizeof(diff) : count;
+            for (gap = 0; gap < count; gap++)
+            {
+                diff[gap] = (uint8_t)(new_data[index + gap] - old_data[index + gap]);
+                stats->diff_bytes += (diff[gap] != 0) ? 1 : 0;
+            }
+            delta_sw_put(buffer, diff, count);
+            index += count;
+        }
+    }
+}
+
+/**
+ * @brief   ɲ
+ * @param   old_image: ɾ񣨺ͷ
+ * @param   old_size: ɾ񳤶
+ * @param   new_image: ¾񣨺ͷ
+ * @param   new_size: ¾񳤶
+ * @param   patch: ͷfree
+ * @param   patch_size: 
+ * @param   stats: ͳƣΪNULL
+ * @retval  0: ɹ, -1: Чڴ治
+ */
+int delta_sw_diff(const uint8_t *old_image, uint32_t old_size, const uint8_t *new_image, uint32_t new_size,
+                  uint8_t **patch, uint32_t *patch_size, delta_sw_stats_t *stats)
+{
+    const boot_image_header_t *old_header = (const boot_image_header_t *)old_image;
+    const boot_image_header_t *new_header = (const boot_image_header_t *)new_image;
+    boot_delta_header_t header;
+    delta_sw_buffer_t buffer;
+    delta_sw_stats_t local;
+    uint32_t candidate[3];
+    uint32_t *table;
+    uint32_t index;
+    uint32_t new_pos;
+    uint32_t literal;
+    uint32_t cursor;
+    uint32_t length;
+    uint32_t same;
+    uint32_t best_pos;
+    uint32_t best_length;
+    uint32_t best_same;
+    int32_t best_score;
+    int32_t score;
+
+    if (stats == NULL)
+    {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(delta_sw_stats_t));
+
+    if ((old_size <= BOOT_IMAGE_HEADER_SIZE) || (new_size <= BOOT_IMAGE_HEADER_SIZE) ||
+        (old_header->magic != BOOT_IMAGE_MAGIC) || (new_header->magic != BOOT_IMAGE_MAGIC))
+    {
+        return -1;
+    }
+
+    table = malloc(sizeof(uint32_t) << DELTA_SW_HASH_BITS);
+    if (table == NULL)
+    {
+        return -1;
+    }
+    memset(table, 0xFF, sizeof(uint32_t) << DELTA_SW_HASH_BITS);
+
+    /* 򽨱ͬһϣǰλ */
+    for (index = old_size - DELTA_SW_WINDOW + 1; index-- > 0;)
+    {
+        table[delta_sw_hash(&old_image[index])] = index;
+    }
+
+    memset(&buffer, 0, sizeof(buffer));
+    memset(&header, 0, sizeof(header));
+    delta_sw_put(&buffer, (const uint8_t *)&header, sizeof(header));
+
+    new_pos = 0;
+    literal = 0;
+    cursor = 0;
+    while (new_pos < new_size)
+    {
+        candidate[0] = cursor + (new_pos - literal);
+        candidate[1] = cursor;
+        candidate[2] = ((new_pos + DELTA_SW_WINDOW) <= new_size) ? table[delta_sw_hash(&new_image[new_pos])] : DELTA_SW_EMPTY;
+
+        best_score = 0;
+        best_pos = 0;
+        best_length = 0;
+        best_same = 0;
+        for (index = 0; index < 3; index++)
+        {
+            if ((candidate[index] >= old_size) || ((index != 0) && (candidate[index] == candidate[0])))
+            {
+                continue;
+            }
+
+            score = delta_sw_extend(old_image, old_size, candidate[index], new_image, new_size, new_pos, table, &length, &same);
+            if (score > best_score)
+            {
+                best_score = score;
+                best_pos = candidate[index];
+                best_length = length;
+                best_same = same;
+            }
+        }
+
+        if (best_same < DELTA_SW_MIN_SAME)
+        {
+            new_pos++;
+            continue;
+        }
+
+        delta_sw_emit_data(&buffer, &new_image[literal], new_pos - literal, stats);
+        delta_sw_emit_match(&buffer, &old_image[best_pos], &new_image[new_pos], best_length, (int32_t)(best_pos - cursor), stats);
+        cursor = best_pos + best_length;
+        new_pos += best_length;
+        literal = new_pos;
+    }
+    delta_sw_emit_data(&buffer, &new_image[literal], new_pos - literal, stats);
+
+    free(table);
+    if (buffer.error != 0)
+    {
+        free(buffer.data);
+        return -1;
+    }
+
+    header.magic = BOOT_DELTA_MAGIC;
+    header.version = BOOT_DELTA_VERSION;
+    header.header_size = sizeof(header);
+    header.old_size = old_size;
+    header.old_header_crc = old_header->header_crc;
+    header.new_size = new_size;
+    header.new_header_crc = new_header->header_crc;
+    header.patch_size = buffer.length - sizeof(header);
+    header.header_crc = image_sw_crc32(0, (const uint8_t *)&header, offsetof(boot_delta_header_t, header_crc));
+    memcpy(buffer.data, &header, sizeof(header));
+
+    *patch = buffer.data;
+    *patch_size = buffer.length;
+
+    return 0;
+}
+
+/**
+ * @brief   Ӧò
+ * @param   old_image: ɾ񣨺ͷ
+ * @param   old_size: ɾ񳤶
+ * @param   patch: ͷ
+ * @param   patch_size: 
+ * @param   new_image: ¾free
+ * @param   new_size: ¾񳤶
+ * @param   reason: ʧԭ򣨿ΪNULL
+ * @retval  0: ɹ, -1: Чɾƥ
+ */
+int delta_sw_apply(const uint8_t *old_image, uint32_t old_size, const uint8_t *patch, uint32_t patch_size,
+                   uint8_t **new_image, uint32_t *new_size, const char **reason)
+{
+    const boot_image_header_t *old_header = (const boot_image_header_t *)old_image;
+    boot_delta_header_t header;
+    const uint8_t *ops;
+    const char *error = NULL;
+    uint8_t *output = NULL;
+    uint32_t produced = 0;
+    uint32_t offset = 0;
+    uint32_t cursor = 0;
+    uint32_t length;
+    uint32_t value;
+    uint32_t skip;
+    uint32_t count;
+    uint32_t index;
+    uint8_t op;
+
+    if (patch_size < sizeof(header))
+    {
+        error = "patch shorter than header";
+        goto out;
+    }
+    memcpy(&header, patch, sizeof(header));
+    ops = patch + sizeof(header);
+
+    if ((header.magic != BOOT_DELTA_MAGIC) || (header.version != BOOT_DELTA_VERSION) || (header.header_size != sizeof(header)))
+    {
+        error = "bad magic or patch version";
+        goto out;
+    }
+    if (header.header_crc != image_sw_crc32(0, patch, offsetof(boot_delta_header_t, header_crc)))
+    {
+        error = "patch header crc mismatch";
+        goto out;
+    }
+    if (header.patch_size != (patch_size - sizeof(header)))
+    {
+        error = "patch size mismatch";
+        goto out;
+    }
+    if ((old_size != header.old_size) || (old_size <= BOOT_IMAGE_HEADER_SIZE) || (old_header->header_crc != header.old_header_crc))
+    {
+        error = "old image mismatch";
+        goto out;
+    }
+    if (header.new_size <= BOOT_IMAGE_HEADER_SIZE)
+    {
+        error = "bad new image size";
+        goto out;
+    }
+
+    output = malloc(header.new_size);
+    if (output == NULL)
+    {
+        error = "out of memory";
+        goto out;
+    }
+
+    while ((error == NULL) && (produced < header.new_size))
+    {
+        if (offset >= header.patch_size)
+        {
+            error = "patch truncated";
+            break;
+        }
+
+        op = ops[offset++];
+        if ((op != BOOT_DELTA_OP_COPY) && (op != BOOT_DELTA_OP_DATA) && (op != BOOT_DELTA_OP_ADD))
+        {
+            error = "bad opcode";
+            break;
+        }
+        if ((delta_sw_get_varint(ops, header.patch_size, &offset, &length) != 0) || (length == 0) || (length > (header.new_size - produced)))
+        {
+            error = "bad length";
+            break;
+        }
+
+        if (op == BOOT_DELTA_OP_DATA)
+        {
+            if (length > (header.patch_size - offset))
+            {
+                error = "patch truncated";
+                break;
+            }
+            memcpy(&output[produced], &ops[offset], length);
+            offset += length;
+            produced += length;
+            continue;
+        }
+
+        if (delta_sw_get_varint(ops, header.patch_size, &offset, &value) != 0)
+        {
+            error = "patch truncated";
+            break;
+        }
+        cursor += (value >> 1) ^ (0U - (value & 1));
+        if ((cursor > old_size) || (length > (old_size - cursor)))
+        {
+            error = "copy outside old image";
+            break;
+        }
+
+        if (op == BOOT_DELTA_OP_COPY)
+        {
+            memcpy(&output[produced], &old_image[cursor], length);
+            cursor += length;
+            produced += length;
+            continue;
+        }
+
+        while (length != 0)
+        {
+            if ((delta_sw_get_varint(ops, header.patch_size, &offset, &skip) != 0) || (skip > length))
+            {
+                error = "bad add run";
+                break;
+            }
+            memcpy(&output[produced], &old_image[cursor], skip);
+            cursor += skip;
+            produced += skip;
+            length -= skip;
+
+            if ((delta_sw_get_varint(ops, header.patch_size, &offset, &count) != 0) || (count > length) || (count > (header.patch_size - offset)))
+            {
+                error = "bad add run";
+                break;
+            }
+            for (index = 0; index < count; index++)
+            {
+                output[produced + index] = (uint8_t)(old_image[cursor + index] + ops[offset + index]);
+            }
+            offset += count;
+            cursor += count;
+            produced += count;
+            length -= count;
+        }
+    }
+
+    if ((error == NULL) && (offset != header.patch_size))
+    {
+        error = "trailing patch data";
+    }
+
+out:
+    if (reason != NULL)
+    {
+        *reason = error;
+    }
+    if (error != NULL)
+    {
+        free(output);
+        return -1;
+    }
+
+    *new_image = output;
+    *new_size = header.new_size;
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+/**
+ ****************************************************************************************************
+ * @file        delta_sw.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ӦóοӦ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ʽBSP/boot_delta.himage_deltaNOR Flash׼Թã
+ * οӦõļBSP/boot_delta.cʽӦõļһ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __DELTA_SW_H
+#define __DELTA_SW_H
+
+#include "boot_delta.h"
+#include "boot_image.h"
+
+/* ͳƶ */
+typedef struct {
+    uint32_t copy_ops;      /* COPY */
+    uint32_t add_ops;       /* ADD */
+    uint32_t data_ops;      /* DATA */
+    uint32_t copy_bytes;    /* COPYֽ */
+    uint32_t add_bytes;     /* ADDֽ */
+    uint32_t diff_bytes;    /* ADDз0ֵֽ */
+    uint32_t data_bytes;    /* DATAֽ */
+} delta_sw_stats_t;
+
+/*  */
+int delta_sw_diff(const uint8_t *old_image, uint32_t old_size, const uint8_t *new_image, uint32_t new_size,
+                  uint8_t **patch, uint32_t *patch_size, delta_sw_stats_t *stats);      /* ɲͷfree */
+int delta_sw_apply(const uint8_t *old_image, uint32_t old_size, const uint8_t *patch, uint32_t patch_size,
+                   uint8_t **new_image, uint32_t *new_size, const char **reason);       /* Ӧò¾free */
+
+#endif /* __DELTA_SW_H */
@@ -0,0 +1,472 @@
+/**
+ ****************************************************************************************************
+ * @file        image_delta.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       Ӧó
+ ****************************************************************************************************
+ * @attention
+ *
+ * ݾɡimage_packerľɲ豸BSP/boot_delta.cʽӦã
+ * applyοʵӦòڼ鲹ȶ豸д
+ *
+ * ÷: image_delta diff old_image.bin new_image.bin patch.bin
+ *       image_delta apply old_image.bin patch.bin new_image.bin
+ *       image_delta info patch.bin
+ *       image_delta selftest
+ *
+ ****************************************************************************************************
+ */
+
+#include "delta_sw.h"
+#include "image_sw.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Բ⾵ */
+#define SELFTEST_BODY_SIZE      (0x00040003UL)
+#define SELFTEST_IMAGE_SIZE     (BOOT_IMAGE_HEADER_SIZE + SELFTEST_BODY_SIZE)
+#define SELFTEST_POINTER_STEP   (64U)
+#define SELFTEST_SLOT_B_BASE    (BOOT_IMAGE_XSPI_BASE + 0x01000000UL)
+
+static int selftest_failures = 0;
+
+/**
+ * @brief   ӡ÷
+ * @param   name: 
+ * @retval  2
+ */
+static int usage(const char *name)
+{
+    fprintf(stderr, "usage: %s diff old_image.bin new_image.bin patch.bin\n", name);
+    fprintf(stderr, "       %s apply old_image.bin patch.bin new_image.bin\n", name);
+    fprintf(stderr, "       %s info patch.bin\n", name);
+    fprintf(stderr, "       %s selftest\n", name);
+    return 2;
+}
+
+/**
+ * @brief   ȡļ
+ * @param   path: ļ·
+ * @param   length: ļ
+ * @retval  ļݣfreeʧܷNULL
+ */
+static uint8_t *read_file(const char *path, uint32_t *length)
+{
+    FILE *file;
+    uint8_t *data;
+    long size;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if ((size < 0) || (size > 0x02000000L))
+    {
+        fprintf(stderr, "%s: bad size\n", path);
+        fclose(file);
+        return NULL;
+    }
+
+    data = malloc((size_t)size + 1);
+    if ((data == NULL) || (fread(data, 1, (size_t)size, file) != (size_t)size))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    *length = (uint32_t)size;
+
+    return data;
+}
+
+/**
+ * @brief   дļ
+ * @param   path: ļ·
+ * @param   data: 
+ * @param   length: ݳ
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int write_file(const char *path, const uint8_t *data, uint32_t length)
+{
+    FILE *file;
+
+    file = fopen(path, "wb");
+    if ((file == NULL) || (fwrite(data, 1, length, file) != length))
+    {
+        perror(path);
+        if (file != NULL)
+        {
+            fclose(file);
+        }
+        return -1;
+    }
+
+    fclose(file);
+
+    return 0;
+}
+
+/**
+ * @brief   ӡͳ
+ * @param   stats: ͳ
+ * @param   new_size: ¾񳤶
+ * @param   patch_size: 
+ * @retval  
+ */
+static void print_stats(const delta_sw_stats_t *stats, uint32_t new_size, uint32_t patch_size)
+{
+    printf("copy           %u ops, %u bytes\n", (unsigned int)stats->copy_ops, (unsigned int)stats->copy_bytes);
+    printf("add            %u ops, %u bytes, %u changed\n", (unsigned int)stats->add_ops, (unsigned int)stats->add_bytes, (unsigned int)stats->diff_bytes);
+    printf("data           %u ops, %u bytes\n", (unsigned int)stats->data_ops, (unsigned int)stats->data_bytes);
+    printf("patch          %u bytes for %u byte image (%.2f%%)\n", (unsigned int)patch_size, (unsigned int)new_size, patch_size * 100.0 / new_size);
+}
+
+/**
+ * @brief   ɲ
+ * @param   argc: 
+ * @param   argv: 
+ * @retval  0: ɹ, 1: ʧ, 2: 
+ */
+static int cmd_diff(int argc, char *argv[])
+{
+    delta_sw_stats_t stats;
+    uint32_t old_size;
+    uint32_t new_size;
+    uint32_t patch_size;
+    uint8_t *old_image;
+    uint8_t *new_image;
+    uint8_t *patch = NULL;
+    int res = 1;
+
+    if (argc != 4)
+    {
+        return usage("image_delta");
+    }
+
+    old_image = read_file(argv[1], &old_size);
+    new_image = read_file(argv[2], &new_size);
+    if ((old_image != NULL) && (new_image != NULL))
+    {
+        if (delta_sw_diff(old_image, old_size, new_image, new_size, &patch, &patch_size, &stats) != 0)
+        {
+            fprintf(stderr, "diff failed: both files must be images made by image_packer\n");
+        }
+        else if (write_file(argv[3], patch, patch_size) == 0)
+        {
+            print_stats(&stats, new_size, patch_size);
+            res = 0;
+        }
+    }
+
+    free(patch);
+    free(new_image);
+    free(old_image);
+
+    return res;
+}
+
+/**
+ * @brief   Ӧò
+ * @param   argc: 
+ * @param   argv: 
+ * @retval  0: ɹ, 1: ʧ, 2: 
+ */
+static int cmd_apply(int argc, char *argv[])
+{
+    uint32_t old_size;
+    uint32_t patch_size;
+    uint32_t new_size;
+    uint8_t *old_image;
+    uint8_t *patch;
+    uint8_t *new_image = NULL;
+    const char *reason;
+    int res = 1;
+
+    if (argc != 4)
+    {
+        return usage("image_delta");
+    }
+
+    old_image = read_file(argv[1], &old_size);
+    patch = read_file(argv[2], &patch_size);
+    if ((old_image != NULL) && (patch != NULL))
+    {
+        if (delta_sw_apply(old_image, old_size, patch, patch_size, &new_image, &new_size, &reason) != 0)
+        {
+            printf("%s: INVALID (%s)\n", argv[2], reason);
+        }
+        else if (write_file(argv[3], new_image, new_size) == 0)
+        {
+            printf("%s: %u bytes\n", argv[3], (unsigned int)new_size);
+            res = 0;
+        }
+    }
+
+    free(new_image);
+    free(patch);
+    free(old_image);
+
+    return res;
+}
+
+/**
+ * @brief   ӡͷ
+ * @param   argc: 
+ * @param   argv: 
+ * @retval  0: ɹ, 1: ʧ, 2: 
+ */
+static int cmd_info(int argc, char *argv[])
+{
+    boot_delta_header_t header;
+    uint32_t length;
+    uint8_t *patch;
+
+    if (argc != 2)
+    {
+        return usage("image_delta");
+    }
+
+    patch = read_file(argv[1], &length);
+    if (patch == NULL)
+    {
+        return 1;
+    }
+    if (length < sizeof(header))
+    {
+        fprintf(stderr, "%s: too short\n", argv[1]);
+        free(patch);
+        return 1;
+    }
+    memcpy(&header, patch, sizeof(header));
+    free(patch);
+
+    printf("magic          0x%08X\n", (unsigned int)header.magic);
+    printf("header         v%u, %u bytes, crc 0x%08X\n", header.version, header.header_size, (unsigned int)header.header_crc);
+    printf("old image      %u bytes, header crc 0x%08X\n", (unsigned int)header.old_size, (unsigned int)header.old_header_crc);
+    printf("new image      %u bytes, header crc 0x%08X\n", (unsigned int)header.new_size, (unsigned int)header.new_header_crc);
+    printf("operations     %u bytes\n", (unsigned int)header.patch_size);
+
+    return 0;
+}
+
+/**
+ * @brief   Բ
+ * @param   name: 
+ * @param   ok: 
+ * @retval  
+ */
+static void selftest_check(const char *name, int ok)
+{
+    printf("%-32s %s\n", name, ok ? "ok" : "FAIL");
+    if (!ok)
+    {
+        selftest_failures++;
+    }
+}
+
+/**
+ * @brief   Բ⾵
+ * @note    α""ÿSELFTEST_POINTER_STEPֽڷһָڵľԵַģֳ
+ * @param   image: 񻺳SELFTEST_IMAGE_SIZEֽڣ
+ * @param   base: ͷCPUַ
+ * @param   version: Ӧó汾
+ * @param   seed: 
+ * @retval  
+ */
+static void selftest_image(uint8_t *image, uint32_t base, uint32_t version, uint32_t seed)
+{
+    boot_image_header_t header;
+    uint8_t *body = &image[BOOT_IMAGE_HEADER_SIZE];
+    uint32_t load_address = base + BOOT_IMAGE_HEADER_SIZE;
+    uint32_t pointer;
+    uint32_t index;
+
+    for (index = 0; index < SELFTEST_BODY_SIZE; index++)
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        body[index] = (uint8_t)(seed >> 16);
+    }
+    for (index = SELFTEST_POINTER_STEP; (index + 4) <= SELFTEST_BODY_SIZE; index += SELFTEST_POINTER_STEP)
+    {
+        pointer = load_address + ((index * 7) % SELFTEST_BODY_SIZE);
+        memcpy(&body[index], &pointer, 4);
+    }
+    pointer = 0x20010000UL;
+    memcpy(&body[0], &pointer, 4);
+    pointer = load_address + 0x201UL;
+    memcpy(&body[4], &pointer, 4);
+
+    /* 汾ֻӰ쾵ͷӾ */
+    image_sw_make_header(&header, body, SELFTEST_BODY_SIZE, version, base, BOOT_IMAGE_FLAG_SHA256);
+    memset(image, 0xFF, BOOT_IMAGE_HEADER_SIZE);
+    memcpy(image, &header, sizeof(header));
+}
+
+/**
+ * @brief   Բ⾵ͷ
+ * @param   image: 񻺳
+ * @param   base: ͷCPUַ
+ * @param   version: Ӧó汾
+ * @retval  
+ */
+static void selftest_seal(uint8_t *image, uint32_t base, uint32_t version)
+{
+    boot_image_header_t header;
+
+    image_sw_make_header(&header, &image[BOOT_IMAGE_HEADER_SIZE], SELFTEST_BODY_SIZE, version, base, BOOT_IMAGE_FLAG_SHA256);
+    memcpy(image, &header, sizeof(header));
+}
+
+/**
+ * @brief   ɲӦòȶ
+ * @param   name: 
+ * @param   old_image: ɾ
+ * @param   new_image: ¾
+ * @param   max_percent: ޣռ¾İٷֱȣ
+ * @param   patch: ΪNULLfree
+ * @param   patch_size: 
+ * @retval  
+ */
+static void selftest_roundtrip(const char *name, const uint8_t *old_image, const uint8_t *new_image, uint32_t max_percent,
+                               uint8_t **patch, uint32_t *patch_size)
+{
+    delta_sw_stats_t stats;
+    uint8_t *local;
+    uint8_t *output = NULL;
+    uint32_t local_size;
+    uint32_t output_size = 0;
+    int ok;
+
+    ok = (delta_sw_diff(old_image, SELFTEST_IMAGE_SIZE, new_image, SELFTEST_IMAGE_SIZE, &local, &local_size, &stats) == 0);
+    if (ok)
+    {
+        ok = (delta_sw_apply(old_image, SELFTEST_IMAGE_SIZE, local, local_size, &output, &output_size, NULL) == 0) &&
+             (output_size == SELFTEST_IMAGE_SIZE) && (memcmp(output, new_image, SELFTEST_IMAGE_SIZE) == 0) &&
+             (((uint64_t)local_size * 100) <= ((uint64_t)SELFTEST_IMAGE_SIZE * max_percent));
+        printf("  %u bytes (%.2f%%): copy %u/%u, add %u/%u (%u changed), data %u/%u\n", (unsigned int)local_size,
+               local_size * 100.0 / SELFTEST_IMAGE_SIZE, (unsigned int)stats.copy_ops, (unsigned int)stats.copy_bytes,
+               (unsigned int)stats.add_ops, (unsigned int)stats.add_bytes, (unsigned int)stats.diff_bytes,
+               (unsigned int)stats.data_ops, (unsigned int)stats.data_bytes);
+    }
+    selftest_check(name, ok);
+
+    free(output);
+    if ((patch != NULL) && ok)
+    {
+        *patch = local;
+        *patch_size = local_size;
+    }
+    else if (ok)
+    {
+        free(local);
+    }
+}
+
+/**
+ * @brief   Բ⣺ͬӡ޸롢޹ؾĲԼЧ
+ * @param   
+ * @retval  0: ȫͨ, 1: ʧ
+ */
+static int cmd_selftest(void)
+{
+    static uint8_t old_image[SELFTEST_IMAGE_SIZE];
+    static uint8_t new_image[SELFTEST_IMAGE_SIZE];
+    static uint8_t other_image[SELFTEST_IMAGE_SIZE];
+    uint8_t *body = &new_image[BOOT_IMAGE_HEADER_SIZE];
+    uint8_t *patch = NULL;
+    uint8_t *output = NULL;
+    uint32_t patch_size = 0;
+    uint32_t output_size;
+    const char *reason;
+    uint32_t index;
+
+    selftest_image(old_image, BOOT_IMAGE_XSPI_BASE, 1, 1);
+
+    selftest_roundtrip("identical image", old_image, old_image, 1, NULL, NULL);
+
+    /* ͬһӵBֻоͷԵַͬ */
+    selftest_image(new_image, SELFTEST_SLOT_B_BASE, 2, 1);
+    selftest_roundtrip("relink to slot B", old_image, new_image, 5, NULL, NULL);
+
+    /* Ӳ޸м300ֽڣݺƣ */
+    for (index = 0; index < 3; index++)
+    {
+        memset(&body[0x1000 + index * 0x9000], 0x5A + index, 48);
+    }
+    memmove(&body[0x20000 + 300], &body[0x20000], SELFTEST_BODY_SIZE - 0x20000 - 300);
+    for (index = 0; index < 300; index++)
+    {
+        body[0x20000 + index] = (uint8_t)(index * 13);
+    }
+    selftest_seal(new_image, SELFTEST_SLOT_B_BASE, 3);
+    selftest_roundtrip("relink, edit and insert", old_image, new_image, 5, &patch, &patch_size);
+    selftest_check("patched image valid in slot B", (patch != NULL) &&
+                   (delta_sw_apply(old_image, SELFTEST_IMAGE_SIZE, patch, patch_size, &output, &output_size, NULL) == 0) &&
+                   (image_sw_check(output, output_size, SELFTEST_SLOT_B_BASE, NULL, &reason) == 0));
+    free(output);
+    output = NULL;
+
+    selftest_image(other_image, SELFTEST_SLOT_B_BASE, 4, 2);
+    selftest_roundtrip("unrelated image", old_image, other_image, 101, NULL, NULL);
+
+    if (patch == NULL)
+    {
+        return 1;
+    }
+
+    /* Ч뱻ܾ */
+    selftest_check("reject wrong old image", (delta_sw_apply(other_image, SELFTEST_IMAGE_SIZE, patch, patch_size, &output, &output_size, &reason) != 0) &&
+                   (strcmp(reason, "old image mismatch") == 0));
+    selftest_check("reject truncated patch", delta_sw_apply(old_image, SELFTEST_IMAGE_SIZE, patch, patch_size - 1, &output, &output_size, &reason) != 0);
+    patch[offsetof(boot_delta_header_t, new_size)] ^= 0x01;
+    selftest_check("reject header corruption", (delta_sw_apply(old_image, SELFTEST_IMAGE_SIZE, patch, patch_size, &output, &output_size, &reason) != 0) &&
+                   (strcmp(reason, "patch header crc mismatch") == 0));
+    patch[offsetof(boot_delta_header_t, new_size)] ^= 0x01;
+    patch[sizeof(boot_delta_header_t)] = 0x7F;
+    selftest_check("reject bad opcode", (delta_sw_apply(old_image, SELFTEST_IMAGE_SIZE, patch, patch_size, &output, &output_size, &reason) != 0) &&
+                   (strcmp(reason, "bad opcode") == 0));
+
+    free(patch);
+    printf("%s\n", (selftest_failures == 0) ? "selftest PASS" : "selftest FAIL");
+
+    return (selftest_failures == 0) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        return usage(argv[0]);
+    }
+
+    if (strcmp(argv[1], "diff") == 0)
+    {
+        return cmd_diff(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[1], "apply") == 0)
+    {
+        return cmd_apply(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[1], "info") == 0)
+    {
+        return cmd_info(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[1], "selftest") == 0)
+    {
+        return cmd_selftest();
+    }
+
+    return usage(argv[0]);
+}
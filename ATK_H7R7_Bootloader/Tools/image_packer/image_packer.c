@@ -0,0 +1,951 @@
+/**
+ ****************************************************************************************************
+ * @file        image_packer.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       Ӧó
+ ****************************************************************************************************
+ * @attention
+ *
+ * ӦóbinļӵַΪbase+0x400ǰϾͷɿдNOR Flashľ
+ * ͷ֮0x400Ŀռ0xFFverifyBootloaderļοʵУ龵
+ * -zָĶΣscatterļеļLR_AXI_PACKEDLZ4ѹ󸽼Ӧó֮
+ * BootloaderתǰѹĿĵַlz4benchͳӦóELFĸضλbinļѹѹٶ
+ *
+ * ÷: image_packer pack [-b base] [-v version] [-n] [-z address:file]... app.bin image.bin
+ *       image_packer verify [-b base] image.bin
+ *       image_packer info image.bin
+ *       image_packer lz4bench file...
+ *       image_packer selftest
+ *       -b: ͷCPUַĬ0x90000000ABΪ0x91000000BSP/boot_slot.h
+ *       -v: Ӧó汾ֵmajor.minor.patch
+ *       -n: SHA-256BootloaderֻУCRC32
+ *       -z: ѹΣaddressΪѹĿĵַITCMAXI SRAM 0x24050000𣬼BSP/boot_image.hظ
+ *
+ ****************************************************************************************************
+ */
+
+#include "image_sw.h"
+#include "section_sw.h"
+#include "boot_lz4.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Բ⾵ */
+#define SELFTEST_BODY_SIZE      (0x00010003UL)
+#define SELFTEST_RESET_OFFSET   (0x00000201UL)
+#define SELFTEST_SECTION_SIZE   (0x00008000UL)
+
+/* ѹٶȲԶ */
+#define BENCH_MIN_TIME          (0.2)   /* ÿеʱ䣨s */
+
+/* ELF32壨ֻȡlz4benchҪĳԱ */
+#define ELF_PT_LOAD             (1)
+
+static int selftest_failures = 0;
+
+/**
+ * @brief   ӡ÷
+ * @param   name: 
+ * @retval  2
+ */
+static int usage(const char *name)
+{
+    fprintf(stderr, "usage: %s pack [-b base] [-v version] [-n] [-z address:file]... app.bin image.bin\n", name);
+    fprintf(stderr, "       %s verify [-b base] image.bin\n", name);
+    fprintf(stderr, "       %s info image.bin\n", name);
+    fprintf(stderr, "       %s lz4bench file...\n", name);
+    fprintf(stderr, "       %s selftest\n", name);
+    return 2;
+}
+
+/**
+ * @brief   ȡļ
+ * @param   path: ļ·
+ * @param   length: ļ
+ * @retval  ļݣfreeʧܷNULL
+ */
+static uint8_t *read_file(const char *path, uint32_t *length)
+{
+    FILE *file;
+    uint8_t *data;
+    long size;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if ((size < 0) || (size > 0x02000000L))
+    {
+        fprintf(stderr, "%s: bad size\n", path);
+        fclose(file);
+        return NULL;
+    }
+
+    data = malloc((size_t)size + 1);
+    if ((data == NULL) || (fread(data, 1, (size_t)size, file) != (size_t)size))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    *length = (uint32_t)size;
+
+    return data;
+}
+
+/**
+ * @brief   汾
+ * @param   text: ֵmajor.minor.patchmajorminor8λpatch 16λ
+ * @param   version: 汾
+ * @retval  0: ɹ, -1: ʽ
+ */
+static int parse_version(const char *text, uint32_t *version)
+{
+    unsigned int major;
+    unsigned int minor;
+    unsigned int patch;
+    char *end;
+
+    if (sscanf(text, "%u.%u.%u", &major, &minor, &patch) == 3)
+    {
+        if ((major > 0xFF) || (minor > 0xFF) || (patch > 0xFFFF))
+        {
+            return -1;
+        }
+        *version = (major << 24) | (minor << 16) | patch;
+        return 0;
+    }
+
+    *version = (uint32_t)strtoul(text, &end, 0);
+
+    return (*end == '\0') ? 0 : -1;
+}
+
+/**
+ * @brief   ӡͷ
+ * @param   header: ͷ
+ * @retval  
+ */
+static void print_header(const boot_image_header_t *header)
+{
+    int index;
+
+    printf("magic          0x%08X\n", (unsigned int)header->magic);
+    printf("header         v%u, %u bytes, crc 0x%08X\n", header->header_version, header->header_size, (unsigned int)header->header_crc);
+    printf("version        %u.%u.%u (0x%08X)\n", (unsigned int)(header->image_version >> 24), (unsigned int)((header->image_version >> 16) & 0xFF),
+           (unsigned int)(header->image_version & 0xFFFF), (unsigned int)header->image_version);
+    printf("size           %u\n", (unsigned int)header->image_size);
+    printf("load           0x%08X\n", (unsigned int)header->load_address);
+    printf("entry          0x%08X\n", (unsigned int)header->entry_address);
+    printf("crc32          0x%08X\n", (unsigned int)header->crc32);
+    printf("sha256         ");
+    if ((header->flags & BOOT_IMAGE_FLAG_SHA256) != 0)
+    {
+        for (index = 0; index < 32; index++)
+        {
+            printf("%02x", header->sha256[index]);
+        }
+        printf("\n");
+    }
+    else
+    {
+        printf("(none)\n");
+    }
+}
+
+/**
+ * @brief   ӡα
+ * @param   body: Ӧó򣨾ͷ֮
+ * @param   length: Ӧóɶ
+ * @param   header: ͷ
+ * @retval  
+ */
+static void print_sections(const uint8_t *body, uint32_t length, const boot_image_header_t *header)
+{
+    boot_image_section_table_t table;
+    boot_image_section_t section;
+    uint32_t index;
+
+    if ((header->flags & BOOT_IMAGE_FLAG_SECTIONS) == 0)
+    {
+        return;
+    }
+
+    printf("sections       table at +0x%X\n", (unsigned int)header->section_table);
+    if ((header->section_table > length) || ((length - header->section_table) < sizeof(table)))
+    {
+        return;
+    }
+    memcpy(&table, &body[header->section_table], sizeof(table));
+    for (index = 0; (index < table.count) && (index < BOOT_IMAGE_SECTION_MAX); index++)
+    {
+        if ((length - header->section_table - sizeof(table)) < ((index + 1) * sizeof(section)))
+        {
+            break;
+        }
+        memcpy(&section, &body[header->section_table + sizeof(table) + index * sizeof(section)], sizeof(section));
+        printf("  [%u] 0x%08X %6u -> %6u bytes (%5.1f%%) %s at +0x%X, crc32 0x%08X\n", (unsigned int)index, (unsigned int)section.address,
+               (unsigned int)section.size, (unsigned int)section.packed_size, (section.size != 0) ? (section.packed_size * 100.0 / section.size) : 0.0,
+               (section.method == BOOT_IMAGE_METHOD_LZ4) ? "lz4" : ((section.method == BOOT_IMAGE_METHOD_STORED) ? "stored" : "?"),
+               (unsigned int)section.offset, (unsigned int)section.crc32);
+    }
+}
+
+/**
+ * @brief   
+ * @param   argc: 
+ * @param   argv: 
+ * @retval  0: ɹ, 1: ʧ, 2: 
+ */
+static int cmd_pack(int argc, char *argv[])
+{
+    boot_image_header_t header;
+    uint8_t pad[BOOT_IMAGE_HEADER_SIZE];
+    uint32_t base = BOOT_IMAGE_XSPI_BASE;
+    uint32_t version = 0;
+    uint32_t flags = BOOT_IMAGE_FLAG_SHA256;
+    uint32_t length;
+    uint32_t table_offset = 0;
+    uint32_t count = 0;
+    uint32_t index;
+    uint8_t *section_data[BOOT_IMAGE_SECTION_MAX];
+    section_sw_input_t section[BOOT_IMAGE_SECTION_MAX];
+    const char *reason;
+    uint8_t *body;
+    FILE *file;
+    char *end;
+    int res = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:v:nz:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+                base = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'v':
+                if (parse_version(optarg, &version) != 0)
+                {
+                    fprintf(stderr, "bad version %s\n", optarg);
+                    res = 2;
+                    goto out;
+                }
+                break;
+            case 'n':
+                flags &= ~BOOT_IMAGE_FLAG_SHA256;
+                break;
+            case 'z':
+                if (count >= BOOT_IMAGE_SECTION_MAX)
+                {
+                    fprintf(stderr, "at most %d sections\n", BOOT_IMAGE_SECTION_MAX);
+                    goto out;
+                }
+                section[count].address = (uint32_t)strtoul(optarg, &end, 0);
+                if (*end != ':')
+                {
+                    fprintf(stderr, "bad section %s, expected address:file\n", optarg);
+                    goto out;
+                }
+                section_data[count] = read_file(end + 1, &section[count].size);
+                if (section_data[count] == NULL)
+                {
+                    goto out;
+                }
+                section[count].data = section_data[count];
+                count++;
+                break;
+            default:
+                res = usage("image_packer");
+                goto out;
+        }
+    }
+    if ((argc - optind) != 2)
+    {
+        res = usage("image_packer");
+        goto out;
+    }
+
+    body = read_file(argv[optind], &length);
+    if (body == NULL)
+    {
+        goto out;
+    }
+
+    /* θӦó֮󣬾ͷĳȡCRC32SHA-256һ */
+    if ((count != 0) && (section_sw_append(&body, &length, section, count, SECTION_SW_DEPTH_HIGH, &table_offset, &reason) != 0))
+    {
+        fprintf(stderr, "%s: %s\n", argv[optind], reason);
+        free(body);
+        goto out;
+    }
+
+    if (image_sw_make_header(&header, body, length, version, base, flags) != 0)
+    {
+        fprintf(stderr, "%s: reset vector not inside image, link the application at 0x%08X\n",
+                argv[optind], (unsigned int)(base + BOOT_IMAGE_HEADER_SIZE));
+        free(body);
+        goto out;
+    }
+    if (count != 0)
+    {
+        section_sw_seal(&header, table_offset);
+    }
+
+    memset(pad, 0xFF, sizeof(pad));
+    memcpy(pad, &header, sizeof(header));
+
+    file = fopen(argv[optind + 1], "wb");
+    if ((file == NULL) || (fwrite(pad, 1, sizeof(pad), file) != sizeof(pad)) || (fwrite(body, 1, length, file) != length))
+    {
+        perror(argv[optind + 1]);
+        if (file != NULL)
+        {
+            fclose(file);
+        }
+        free(body);
+        goto out;
+    }
+
+    fclose(file);
+    print_header(&header);
+    print_sections(body, length, &header);
+    free(body);
+    res = 0;
+
+out:
+    for (index = 0; index < count; index++)
+    {
+        free(section_data[index]);
+    }
+
+    return res;
+}
+
+/**
+ * @brief   У龵ӡͷ
+ * @param   argc: 
+ * @param   argv: 
+ * @param   verify: 1: У, 0: ֻӡͷ
+ * @retval  0: Ч, 1: Ч, 2: 
+ */
+static int cmd_verify(int argc, char *argv[], int verify)
+{
+    boot_image_header_t header;
+    uint32_t base = BOOT_IMAGE_XSPI_BASE;
+    uint32_t length;
+    uint8_t *image;
+    const char *reason;
+    int opt;
+    int res;
+
+    while ((opt = getopt(argc, argv, "b:")) != -1)
+    {
+        if (opt != 'b')
+        {
+            return usage("image_packer");
+        }
+        base = (uint32_t)strtoul(optarg, NULL, 0);
+    }
+    if ((argc - optind) != 1)
+    {
+        return usage("image_packer");
+    }
+
+    image = read_file(argv[optind], &length);
+    if (image == NULL)
+    {
+        return 1;
+    }
+
+    if (verify == 0)
+    {
+        if (length < sizeof(header))
+        {
+            fprintf(stderr, "%s: too short\n", argv[optind]);
+            free(image);
+            return 1;
+        }
+        memcpy(&header, image, sizeof(header));
+        print_header(&header);
+        if (length >= BOOT_IMAGE_HEADER_SIZE)
+        {
+            print_sections(&image[BOOT_IMAGE_HEADER_SIZE], length - BOOT_IMAGE_HEADER_SIZE, &header);
+        }
+        free(image);
+        return 0;
+    }
+
+    res = image_sw_check(image, length, base, &header, &reason);
+    if (res == 0)
+    {
+        res = section_sw_check(&image[BOOT_IMAGE_HEADER_SIZE], &header, &reason);
+    }
+    if (res != 0)
+    {
+        printf("%s: INVALID (%s)\n", argv[optind], reason);
+        free(image);
+        return 1;
+    }
+
+    print_header(&header);
+    print_sections(&image[BOOT_IMAGE_HEADER_SIZE], length - BOOT_IMAGE_HEADER_SIZE, &header);
+    printf("%s: OK\n", argv[optind]);
+    free(image);
+
+    return 0;
+}
+
+/**
+ * @brief   ȡС16/32λ
+ * @param   data: ָ
+ * @retval  ֵ
+ */
+static uint32_t get16(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *data)
+{
+    return get16(data) | (get16(&data[2]) << 16);
+}
+
+/**
+ * @brief   ȡõʱ
+ * @param   
+ * @retval  ʱ䣨s
+ */
+static double bench_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief   ͳһݵѹѹ/ѹٶ
+ * @note    ѹѹظBENCH_MIN_TIME룻ٶΪٶȣֻڱȽϣ
+ *          ĿϵĽѹʱBootloaderʱߣBOOT_TRACE_ID_LOAD_SECTIONS
+ * @param   address: صַ
+ * @param   data: 
+ * @param   size: 
+ * @param   total_size: ۼԭʼ
+ * @param   total_packed: ۼѹ󳤶ȣĬȣ
+ * @retval  0: ɹ, -1: ѹѹʧ
+ */
+static int bench_segment(uint32_t address, const uint8_t *data, uint32_t size, uint64_t *total_size, uint64_t *total_packed)
+{
+    static const uint32_t depth[2] = {SECTION_SW_DEPTH_FAST, SECTION_SW_DEPTH_HIGH};
+    uint32_t packed_size[2] = {0, 0};
+    double compress_rate[2] = {0, 0};
+    double decode_rate;
+    double copy_rate;
+    double start;
+    double elapsed;
+    uint64_t runs;
+    uint32_t length = 0;
+    uint8_t *packed;
+    uint8_t *unpacked;
+    int index;
+    int res = -1;
+
+    packed = malloc(BOOT_LZ4_BOUND(size));
+    unpacked = malloc(size + 1);
+    if ((packed == NULL) || (unpacked == NULL))
+    {
+        goto out;
+    }
+
+    for (index = 0; index < 2; index++)
+    {
+        start = bench_now();
+        runs = 0;
+        do
+        {
+            packed_size[index] = section_sw_lz4_compress(data, size, packed, BOOT_LZ4_BOUND(size), depth[index]);
+            runs++;
+            elapsed = bench_now() - start;
+        } while ((packed_size[index] != 0) && (elapsed < BENCH_MIN_TIME));
+        if (packed_size[index] == 0)
+        {
+            goto out;
+        }
+        compress_rate[index] = size * (double)runs / elapsed / 1e6;
+    }
+
+    /* ѹĬȵ */
+    start = bench_now();
+    runs = 0;
+    do
+    {
+        if ((boot_lz4_decompress(packed, packed_size[1], unpacked, size, &length) != 0) || (length != size))
+        {
+            goto out;
+        }
+        runs++;
+        elapsed = bench_now() - start;
+    } while (elapsed < BENCH_MIN_TIME);
+    decode_rate = size * (double)runs / elapsed / 1e6;
+    if (memcmp(unpacked, data, size) != 0)
+    {
+        goto out;
+    }
+
+    /* ѹֱӸΪԱ */
+    start = bench_now();
+    runs = 0;
+    do
+    {
+        memcpy(unpacked, data, size);
+        runs++;
+        elapsed = bench_now() - start;
+    } while (elapsed < BENCH_MIN_TIME);
+    copy_rate = size * (double)runs / elapsed / 1e6;
+
+    printf("  0x%08X %8u  %8u %5.1f%% %7.1f  %8u %5.1f%% %7.1f  %8.1f %8.1f\n", (unsigned int)address, (unsigned int)size,
+           (unsigned int)packed_size[0], packed_size[0] * 100.0 / size, compress_rate[0],
+           (unsigned int)packed_size[1], packed_size[1] * 100.0 / size, compress_rate[1], decode_rate, copy_rate);
+    *total_size += size;
+    *total_packed += packed_size[1];
+    res = 0;
+
+out:
+    if (res != 0)
+    {
+        printf("  0x%08X %8u  FAIL\n", (unsigned int)address, (unsigned int)size);
+    }
+    free(packed);
+    free(unpacked);
+
+    return res;
+}
+
+/**
+ * @brief   ͳӦóLZ4ѹѹٶ
+ * @note    ELFļ.axfͳÿݵļضΣļΪһͳ
+ * @param   argc: 
+ * @param   argv: 
+ * @retval  0: ɹ, 1: ʧ, 2: 
+ */
+static int cmd_lz4bench(int argc, char *argv[])
+{
+    uint64_t total_size = 0;
+    uint64_t total_packed = 0;
+    uint32_t length;
+    uint32_t phoff;
+    uint32_t phentsize;
+    uint32_t phnum;
+    uint32_t offset;
+    uint32_t filesz;
+    uint32_t index;
+    const uint8_t *ph;
+    uint8_t *data;
+    int failures = 0;
+    int file;
+
+    if (argc < 2)
+    {
+        return usage("image_packer");
+    }
+
+    printf("  address        size      fast  ratio    MB/s      high  ratio    MB/s    decode     copy (MB/s, host)\n");
+    for (file = 1; file < argc; file++)
+    {
+        data = read_file(argv[file], &length);
+        if (data == NULL)
+        {
+            failures++;
+            continue;
+        }
+        printf("%s\n", argv[file]);
+
+        /* ELF32СˣPT_LOADͷ */
+        if ((length >= 52) && (memcmp(data, "\177ELF", 4) == 0) && (data[4] == 1) && (data[5] == 1))
+        {
+            phoff = get32(&data[28]);
+            phentsize = get16(&data[42]);
+            phnum = get16(&data[44]);
+            for (index = 0; index < phnum; index++)
+            {
+                if ((phentsize < 32) || (phoff > length) || (((length - phoff) / phentsize) <= index))
+                {
+                    printf("  bad program header\n");
+                    failures++;
+                    break;
+                }
+                ph = &data[phoff + index * phentsize];
+                offset = get32(&ph[4]);
+                filesz = get32(&ph[16]);
+                if ((get32(&ph[0]) != ELF_PT_LOAD) || (filesz == 0))
+                {
+                    continue;
+                }
+                if ((offset > length) || (filesz > (length - offset)))
+                {
+                    printf("  segment outside file\n");
+                    failures++;
+                    continue;
+                }
+                failures += (bench_segment(get32(&ph[12]), &data[offset], filesz, &total_size, &total_packed) != 0) ? 1 : 0;
+            }
+        }
+        else if (length != 0)
+        {
+            failures += (bench_segment(0, data, length, &total_size, &total_packed) != 0) ? 1 : 0;
+        }
+        free(data);
+    }
+
+    if (total_size != 0)
+    {
+        printf("total %llu -> %llu bytes (%.1f%%)\n", (unsigned long long)total_size, (unsigned long long)total_packed,
+               total_packed * 100.0 / total_size);
+    }
+
+    return (failures == 0) ? 0 : 1;
+}
+
+/**
+ * @brief   Բ
+ * @param   name: 
+ * @param   ok: 
+ * @retval  
+ */
+static void selftest_check(const char *name, int ok)
+{
+    printf("%-32s %s\n", name, ok ? "ok" : "FAIL");
+    if (!ok)
+    {
+        selftest_failures++;
+    }
+}
+
+/**
+ * @brief   ȽSHA-256ʮַ
+ * @param   digest: SHA-256
+ * @param   hex: 64ʮַ
+ * @retval  1: ͬ, 0: ͬ
+ */
+static int selftest_digest(const uint8_t digest[32], const char *hex)
+{
+    char text[65];
+    int index;
+
+    for (index = 0; index < 32; index++)
+    {
+        sprintf(&text[2 * index], "%02x", digest[index]);
+    }
+
+    return strcmp(text, hex) == 0;
+}
+
+/**
+ * @brief   LZ4ѹѹȽ
+ * @param   data: ԭʼ
+ * @param   size: ԭʼݳ
+ * @param   depth: 
+ * @retval  ѹ󳤶ȣ0: ѹѹʧܡݲһ
+ */
+static uint32_t selftest_lz4_roundtrip(const uint8_t *data, uint32_t size, uint32_t depth)
+{
+    uint8_t *packed;
+    uint8_t *unpacked;
+    uint32_t packed_size;
+    uint32_t length = 0;
+
+    packed = malloc(BOOT_LZ4_BOUND(size));
+    unpacked = malloc(size + 1);
+    if ((packed == NULL) || (unpacked == NULL))
+    {
+        free(packed);
+        free(unpacked);
+        return 0;
+    }
+
+    packed_size = section_sw_lz4_compress(data, size, packed, BOOT_LZ4_BOUND(size), depth);
+    if ((packed_size == 0) || (boot_lz4_decompress(packed, packed_size, unpacked, size, &length) != 0) ||
+        (length != size) || (memcmp(unpacked, data, size) != 0))
+    {
+        packed_size = 0;
+    }
+
+    free(packed);
+    free(unpacked);
+
+    return packed_size;
+}
+
+/**
+ * @brief   LZ4ѹѹԲ
+ * @note    ǿݡĩβ򸽽Ķݡصƥ䡢ѹ
+ * @param   
+ * @retval  
+ */
+static void selftest_lz4(void)
+{
+    static const uint8_t known[] = {0x1A, 'a', 0x01, 0x00, 0x50, 'a', 'a', 'a', 'a', 'a'};  /* 20'a'1ƥ145 */
+    static const uint8_t bad_offset[] = {0x10, 'a', 0x02, 0x00};
+    static const uint8_t bad_literal[] = {0xF0, 0x10, 'a'};
+    static uint8_t data[0x00030000];
+    uint8_t out[64];
+    uint32_t length;
+    uint32_t index;
+    uint32_t seed = 7;
+    uint32_t size;
+    int ok = 1;
+
+    for (size = 0; size <= 40; size++)
+    {
+        memset(data, 'x', size);
+        ok &= (selftest_lz4_roundtrip(data, size, SECTION_SW_DEPTH_FAST) != 0);
+    }
+    selftest_check("lz4 short blocks", ok);
+
+    memset(data, 0, 0x10000);
+    size = selftest_lz4_roundtrip(data, 0x10000, SECTION_SW_DEPTH_FAST);
+    selftest_check("lz4 zeros (overlapping match)", (size != 0) && (size < 300));
+
+    for (index = 0; index < sizeof(data); index++)
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        data[index] = (uint8_t)(seed >> 16);
+    }
+    size = selftest_lz4_roundtrip(data, sizeof(data), SECTION_SW_DEPTH_HIGH);
+    selftest_check("lz4 random (long literals)", (size != 0) && (size <= BOOT_LZ4_BOUND(sizeof(data))));
+
+    /* ıظṹƥ볬64KBĲֲ */
+    for (index = 0; index < sizeof(data); index++)
+    {
+        data[index] = (uint8_t)("const uint32_t table[] = {0x00000000, 0x77073096};\n"[index % 52] ^ ((index / 0x11000) & 1));
+    }
+    size = selftest_lz4_roundtrip(data, sizeof(data), SECTION_SW_DEPTH_FAST);
+    selftest_check("lz4 text fast", (size != 0) && (size < sizeof(data) / 20));
+    length = selftest_lz4_roundtrip(data, sizeof(data), SECTION_SW_DEPTH_HIGH);
+    selftest_check("lz4 text high <= fast", (length != 0) && (length <= size));
+
+    selftest_check("lz4 decode reference block", (boot_lz4_decompress(known, sizeof(known), out, sizeof(out), &length) == 0) &&
+                   (length == 20) && (memcmp(out, "aaaaaaaaaaaaaaaaaaaa", 20) == 0));
+    selftest_check("lz4 decode output too small", boot_lz4_decompress(known, sizeof(known), out, 19, &length) != 0);
+    selftest_check("lz4 decode truncated", (boot_lz4_decompress(known, sizeof(known) - 6, out, sizeof(out), &length) != 0) || (length != 20));
+    selftest_check("lz4 decode offset before start", boot_lz4_decompress(bad_offset, sizeof(bad_offset), out, sizeof(out), &length) != 0);
+    selftest_check("lz4 decode literal past input", boot_lz4_decompress(bad_literal, sizeof(bad_literal), out, sizeof(out), &length) != 0);
+}
+
+/**
+ * @brief   ѹδУԲ
+ * @note    bodyΪԲӦóSELFTEST_BODY_SIZEֽڣ
+ * @param   body: ԲӦó
+ * @retval  
+ */
+static void selftest_sections(const uint8_t *body)
+{
+    static uint8_t axi[SELFTEST_SECTION_SIZE];
+    static uint8_t itcm[0x100];
+    section_sw_input_t input[2];
+    boot_image_header_t header;
+    boot_image_section_t section;
+    uint32_t table_offset;
+    uint32_t length = SELFTEST_BODY_SIZE;
+    uint32_t index;
+    uint8_t *app;
+    uint8_t *image;
+    const char *reason;
+
+    for (index = 0; index < sizeof(axi); index++)
+    {
+        axi[index] = (uint8_t)((index % 97) + (index / 4096));
+    }
+    memset(itcm, 0xA5, sizeof(itcm));
+    input[0].address = BOOT_IMAGE_AXI_BASE;
+    input[0].data = axi;
+    input[0].size = sizeof(axi);
+    input[1].address = BOOT_IMAGE_ITCM_BASE + 0xC000;
+    input[1].data = itcm;
+    input[1].size = sizeof(itcm);
+
+    /* θӦó󣬾ͷ¼αCRCǶ */
+    app = malloc(SELFTEST_BODY_SIZE);
+    if (app == NULL)
+    {
+        selftest_check("sections alloc", 0);
+        return;
+    }
+    memcpy(app, body, SELFTEST_BODY_SIZE);
+    selftest_check("sections append", section_sw_append(&app, &length, input, 2, SECTION_SW_DEPTH_HIGH, &table_offset, &reason) == 0);
+    image = malloc(BOOT_IMAGE_HEADER_SIZE + length);
+    if (image == NULL)
+    {
+        selftest_check("sections alloc", 0);
+        free(app);
+        return;
+    }
+    memcpy(&image[BOOT_IMAGE_HEADER_SIZE], app, length);
+    free(app);
+    selftest_check("sections header", image_sw_make_header(&header, &image[BOOT_IMAGE_HEADER_SIZE], length, 1, BOOT_IMAGE_XSPI_BASE, 0) == 0);
+    section_sw_seal(&header, table_offset);
+    memset(image, 0xFF, BOOT_IMAGE_HEADER_SIZE);
+    memcpy(image, &header, sizeof(header));
+    selftest_check("sections verify", (image_sw_check(image, BOOT_IMAGE_HEADER_SIZE + length, BOOT_IMAGE_XSPI_BASE, &header, &reason) == 0) &&
+                   (section_sw_check(&image[BOOT_IMAGE_HEADER_SIZE], &header, &reason) == 0));
+
+    memcpy(&section, &image[BOOT_IMAGE_HEADER_SIZE + table_offset + sizeof(boot_image_section_table_t)], sizeof(section));
+    selftest_check("sections lz4 packed", (section.method == BOOT_IMAGE_METHOD_LZ4) && (section.packed_size < (section.size / 4)));
+
+    /* 𻵣CRC֮ļ飺ѹѹCRCʧܣ */
+    image[BOOT_IMAGE_HEADER_SIZE + section.offset + section.packed_size / 2] ^= 0x20;
+    selftest_check("sections corrupt data", section_sw_check(&image[BOOT_IMAGE_HEADER_SIZE], &header, &reason) != 0);
+    image[BOOT_IMAGE_HEADER_SIZE + section.offset + section.packed_size / 2] ^= 0x20;
+
+    header.section_table += 4;
+    selftest_check("sections bad table", (section_sw_check(&image[BOOT_IMAGE_HEADER_SIZE], &header, &reason) != 0) &&
+                   (strcmp(reason, "bad section table") == 0));
+    free(image);
+
+    /* ĿĵַITCM/AXI SRAMBootloader RAMصص */
+    image = malloc(SELFTEST_BODY_SIZE);
+    if (image != NULL)
+    {
+        memcpy(image, body, SELFTEST_BODY_SIZE);
+        length = SELFTEST_BODY_SIZE;
+        input[0].address = BOOT_IMAGE_AXI_BASE - 4;
+        selftest_check("sections reject boot RAM", section_sw_append(&image, &length, input, 1, SECTION_SW_DEPTH_FAST, &table_offset, &reason) != 0);
+        input[0].address = BOOT_IMAGE_AXI_BASE + BOOT_IMAGE_AXI_SIZE - sizeof(axi) + 4;
+        selftest_check("sections reject past AXI end", section_sw_append(&image, &length, input, 1, SECTION_SW_DEPTH_FAST, &table_offset, &reason) != 0);
+        input[0].address = BOOT_IMAGE_ITCM_BASE + 0xC000 - 0x10;
+        selftest_check("sections reject overlap", section_sw_append(&image, &length, input, 2, SECTION_SW_DEPTH_FAST, &table_offset, &reason) != 0);
+        free(image);
+    }
+}
+
+/**
+ * @brief   οʵԲ
+ * @note    CRC32SHA-256ʹùͷɺֱƻӦó򡢾ͷӵַ
+ * @param   
+ * @retval  0: ͨ, 1: ʧ
+ */
+static int cmd_selftest(void)
+{
+    static const char abc448[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    static uint8_t image[BOOT_IMAGE_HEADER_SIZE + SELFTEST_BODY_SIZE];
+    uint8_t *body = &image[BOOT_IMAGE_HEADER_SIZE];
+    boot_image_header_t header;
+    image_sw_sha256_t ctx;
+    uint8_t digest[32];
+    uint8_t *million;
+    const char *reason;
+    uint32_t entry;
+    uint32_t index;
+    uint32_t seed = 1;
+
+    selftest_check("crc32 \"123456789\"", image_sw_crc32(0, (const uint8_t *)"123456789", 9) == 0xCBF43926UL);
+    selftest_check("crc32 split", image_sw_crc32(image_sw_crc32(0, (const uint8_t *)"1234", 4), (const uint8_t *)"56789", 5) == 0xCBF43926UL);
+
+    image_sw_sha256((const uint8_t *)"", 0, digest);
+    selftest_check("sha256 \"\"", selftest_digest(digest, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    image_sw_sha256((const uint8_t *)"abc", 3, digest);
+    selftest_check("sha256 \"abc\"", selftest_digest(digest, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    image_sw_sha256((const uint8_t *)abc448, sizeof(abc448) - 1, digest);
+    selftest_check("sha256 448 bit", selftest_digest(digest, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+
+    million = malloc(1000000);
+    if (million != NULL)
+    {
+        memset(million, 'a', 1000000);
+        image_sw_sha256_init(&ctx);
+        for (index = 0; index < 1000000; index += 7)
+        {
+            image_sw_sha256_update(&ctx, &million[index], ((1000000 - index) < 7) ? (1000000 - index) : 7);
+        }
+        image_sw_sha256_final(&ctx, digest);
+        free(million);
+        selftest_check("sha256 million 'a' (7B chunks)", selftest_digest(digest, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+    }
+
+    /* MSPλΪα */
+    for (index = 0; index < SELFTEST_BODY_SIZE; index++)
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        body[index] = (uint8_t)(seed >> 16);
+    }
+    entry = BOOT_IMAGE_XSPI_BASE + BOOT_IMAGE_HEADER_SIZE + SELFTEST_RESET_OFFSET;
+    memcpy(&body[0], &(uint32_t){0x20010000UL}, 4);
+    memcpy(&body[4], &entry, 4);
+
+    selftest_check("pack", image_sw_make_header(&header, body, SELFTEST_BODY_SIZE, 0x01020003UL, BOOT_IMAGE_XSPI_BASE, BOOT_IMAGE_FLAG_SHA256) == 0);
+    memset(image, 0xFF, BOOT_IMAGE_HEADER_SIZE);
+    memcpy(image, &header, sizeof(header));
+    selftest_check("verify packed", image_sw_check(image, sizeof(image), BOOT_IMAGE_XSPI_BASE, NULL, &reason) == 0);
+    selftest_check("verify wrong base", (image_sw_check(image, sizeof(image), BOOT_IMAGE_XSPI_BASE + 0x01000000UL, NULL, &reason) != 0) &&
+                   (strcmp(reason, "load address mismatch") == 0));
+    selftest_check("verify truncated", image_sw_check(image, sizeof(image) - 1, BOOT_IMAGE_XSPI_BASE, NULL, &reason) != 0);
+
+    body[SELFTEST_BODY_SIZE / 2] ^= 0x01;
+    selftest_check("verify body bit flip", (image_sw_check(image, sizeof(image), BOOT_IMAGE_XSPI_BASE, NULL, &reason) != 0) &&
+                   (strcmp(reason, "image crc mismatch") == 0));
+    body[SELFTEST_BODY_SIZE / 2] ^= 0x01;
+
+    image[offsetof(boot_image_header_t, image_version)] ^= 0x01;
+    selftest_check("verify header bit flip", (image_sw_check(image, sizeof(image), BOOT_IMAGE_XSPI_BASE, NULL, &reason) != 0) &&
+                   (strcmp(reason, "header crc mismatch") == 0));
+    image[offsetof(boot_image_header_t, image_version)] ^= 0x01;
+
+    memcpy(&body[4], &(uint32_t){entry + 2}, 4);
+    selftest_check("verify reset vector changed", image_sw_check(image, sizeof(image), BOOT_IMAGE_XSPI_BASE, NULL, &reason) != 0);
+    selftest_check("pack entry outside image", image_sw_make_header(&header, body, 0x100, 0, BOOT_IMAGE_XSPI_BASE, 0) != 0);
+    memcpy(&body[4], &entry, 4);
+
+    selftest_lz4();
+    selftest_sections(body);
+
+    printf("%s\n", (selftest_failures == 0) ? "PASS" : "FAIL");
+
+    return (selftest_failures == 0) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        return usage(argv[0]);
+    }
+
+    if (strcmp(argv[1], "pack") == 0)
+    {
+        return cmd_pack(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[1], "verify") == 0)
+    {
+        return cmd_verify(argc - 1, argv + 1, 1);
+    }
+    if (strcmp(argv[1], "info") == 0)
+    {
+        return cmd_verify(argc - 1, argv + 1, 0);
+    }
+    if (strcmp(argv[1], "lz4bench") == 0)
+    {
+        return cmd_lz4bench(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[1], "selftest") == 0)
+    {
+        return cmd_selftest();
+    }
+
+    return usage(argv[0]);
+}
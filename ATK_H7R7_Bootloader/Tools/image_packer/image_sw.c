@@ -0,0 +1,361 @@
+/**
+ ****************************************************************************************************
+ * @file        image_sw.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ӦóCRC32/SHA-256οʵ뾵ͷɡУ
+ ****************************************************************************************************
+ * @attention
+ *
+ * CRC32Ϊʽ0xEDB88320ֵ0xFFFFFFFFzlib
+ * ӦCRCĬ϶ʽ0x04C11DB7밴ֽڷתתȡ
+ * SHA-256FIPS 180-4ʵ֣ͷԱС˴洢֧С
+ *
+ ****************************************************************************************************
+ */
+
+#include "image_sw.h"
+#include <stddef.h>
+#include <string.h>
+
+/* SHA-256ֳ */
+static const uint32_t image_sw_sha256_k[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+/* CRC32ұ */
+static uint32_t image_sw_crc_table[256];
+static int image_sw_crc_ready = 0;
+
+#define IMAGE_SW_ROR(x, n)          (((x) >> (n)) | ((x) << (32 - (n))))
+
+/**
+ * @brief   CRC32
+ * @param   crc: ǰһݵCRC32״Ϊ0
+ * @param   data: ָ
+ * @param   length: ݳ
+ * @retval  CRC32
+ */
+uint32_t image_sw_crc32(uint32_t crc, const uint8_t *data, uint32_t length)
+{
+    uint32_t index;
+    uint32_t value;
+    int bit;
+
+    if (image_sw_crc_ready == 0)
+    {
+        for (index = 0; index < 256; index++)
+        {
+            value = index;
+            for (bit = 0; bit < 8; bit++)
+            {
+                value = (value & 1) ? ((value >> 1) ^ 0xEDB88320UL) : (value >> 1);
+            }
+            image_sw_crc_table[index] = value;
+        }
+        image_sw_crc_ready = 1;
+    }
+
+    crc = ~crc;
+    while (length-- != 0)
+    {
+        crc = image_sw_crc_table[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+/**
+ * @brief   һSHA-256ݿ
+ * @param   ctx: 
+ * @param   block: 64ֽݿ
+ * @retval  
+ */
+static void image_sw_sha256_block(image_sw_sha256_t *ctx, const uint8_t *block)
+{
+    uint32_t w[64];
+    uint32_t s[8];
+    uint32_t t1;
+    uint32_t t2;
+    int index;
+
+    for (index = 0; index < 16; index++)
+    {
+        w[index] = ((uint32_t)block[4 * index] << 24) | ((uint32_t)block[4 * index + 1] << 16) |
+                   ((uint32_t)block[4 * index + 2] << 8) | block[4 * index + 3];
+    }
+    for (index = 16; index < 64; index++)
+    {
+        t1 = IMAGE_SW_ROR(w[index - 2], 17) ^ IMAGE_SW_ROR(w[index - 2], 19) ^ (w[index - 2] >> 10);
+        t2 = IMAGE_SW_ROR(w[index - 15], 7) ^ IMAGE_SW_ROR(w[index - 15], 18) ^ (w[index - 15] >> 3);
+        w[index] = t1 + w[index - 7] + t2 + w[index - 16];
+    }
+
+    memcpy(s, ctx->state, sizeof(s));
+    for (index = 0; index < 64; index++)
+    {
+        t1 = s[7] + (IMAGE_SW_ROR(s[4], 6) ^ IMAGE_SW_ROR(s[4], 11) ^ IMAGE_SW_ROR(s[4], 25)) +
+             ((s[4] & s[5]) ^ (~s[4] & s[6])) + image_sw_sha256_k[index] + w[index];
+        t2 = (IMAGE_SW_ROR(s[0], 2) ^ IMAGE_SW_ROR(s[0], 13) ^ IMAGE_SW_ROR(s[0], 22)) +
+             ((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+        s[7] = s[6];
+        s[6] = s[5];
+        s[5] = s[4];
+        s[4] = s[3] + t1;
+        s[3] = s[2];
+        s[2] = s[1];
+        s[1] = s[0];
+        s[0] = t1 + t2;
+    }
+
+    for (index = 0; index < 8; index++)
+    {
+        ctx->state[index] += s[index];
+    }
+}
+
+/**
+ * @brief   ʼSHA-256
+ * @param   ctx: 
+ * @retval  
+ */
+void image_sw_sha256_init(image_sw_sha256_t *ctx)
+{
+    static const uint32_t init[8] = {
+        0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+    };
+
+    memcpy(ctx->state, init, sizeof(init));
+    ctx->length = 0;
+}
+
+/**
+ * @brief   SHA-256
+ * @param   ctx: 
+ * @param   data: ָ
+ * @param   length: ݳ
+ * @retval  
+ */
+void image_sw_sha256_update(image_sw_sha256_t *ctx, const uint8_t *data, uint32_t length)
+{
+    uint32_t fill;
+    uint32_t copy;
+
+    while (length != 0)
+    {
+        fill = (uint32_t)(ctx->length & 63);
+        if ((fill == 0) && (length >= 64))
+        {
+            image_sw_sha256_block(ctx, data);
+            copy = 64;
+        }
+        else
+        {
+            copy = 64 - fill;
+            if (copy > length)
+            {
+                copy = length;
+            }
+            memcpy(&ctx->block[fill], data, copy);
+            if ((fill + copy) == 64)
+            {
+                image_sw_sha256_block(ctx, ctx->block);
+            }
+        }
+
+        ctx->length += copy;
+        data += copy;
+        length -= copy;
+    }
+}
+
+/**
+ * @brief   SHA-256
+ * @param   ctx: 
+ * @param   digest: 32ֽڽ
+ * @retval  
+ */
+void image_sw_sha256_final(image_sw_sha256_t *ctx, uint8_t digest[32])
+{
+    uint64_t bits = ctx->length * 8;
+    uint8_t pad[72];
+    uint32_t fill;
+    uint32_t length;
+    int index;
+
+    /* 0x800ʹģ6456ٲ64λλ */
+    fill = (uint32_t)(ctx->length & 63);
+    length = (fill < 56) ? (56 - fill) : (120 - fill);
+    memset(pad, 0, sizeof(pad));
+    pad[0] = 0x80;
+    for (index = 0; index < 8; index++)
+    {
+        pad[length + index] = (uint8_t)(bits >> (56 - 8 * index));
+    }
+    image_sw_sha256_update(ctx, pad, length + 8);
+
+    for (index = 0; index < 8; index++)
+    {
+        digest[4 * index] = (uint8_t)(ctx->state[index] >> 24);
+        digest[4 * index + 1] = (uint8_t)(ctx->state[index] >> 16);
+        digest[4 * index + 2] = (uint8_t)(ctx->state[index] >> 8);
+        digest[4 * index + 3] = (uint8_t)ctx->state[index];
+    }
+}
+
+/**
+ * @brief   SHA-256
+ * @param   data: ָ
+ * @param   length: ݳ
+ * @param   digest: 32ֽڽ
+ * @retval  
+ */
+void image_sw_sha256(const uint8_t *data, uint32_t length, uint8_t digest[32])
+{
+    image_sw_sha256_t ctx;
+
+    image_sw_sha256_init(&ctx);
+    image_sw_sha256_update(&ctx, data, length);
+    image_sw_sha256_final(&ctx, digest);
+}
+
+/**
+ * @brief   ȡС32λ
+ * @param   data: ָ
+ * @retval  ֵ
+ */
+static uint32_t image_sw_get32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/**
+ * @brief   ɾͷ
+ * @note    ڵַȡӦóĸλ
+ * @param   header: ͷ
+ * @param   body: Ӧó򣨴ʼ
+ * @param   length: Ӧó򳤶
+ * @param   version: Ӧó汾
+ * @param   base: ͷCPUַӦóӵַΪbase+BOOT_IMAGE_HEADER_SIZE
+ * @param   flags: ־
+ * @retval  0: ɹ, -1: Ӧó̻λӦó
+ */
+int image_sw_make_header(boot_image_header_t *header, const uint8_t *body, uint32_t length,
+                         uint32_t version, uint32_t base, uint32_t flags)
+{
+    uint32_t load_address = base + BOOT_IMAGE_HEADER_SIZE;
+    uint32_t entry;
+
+    if (length < 8)
+    {
+        return -1;
+    }
+
+    entry = image_sw_get32(&body[4]);
+    if (((entry & 1) == 0) || (entry < load_address) || ((entry - load_address) >= length))
+    {
+        return -1;
+    }
+
+    memset(header, 0, sizeof(boot_image_header_t));
+    header->magic = BOOT_IMAGE_MAGIC;
+    header->header_version = BOOT_IMAGE_HEADER_VERSION;
+    header->header_size = BOOT_IMAGE_HEADER_SIZE;
+    header->image_version = version;
+    header->image_size = length;
+    header->load_address = load_address;
+    header->entry_address = entry;
+    header->flags = flags;
+    header->crc32 = image_sw_crc32(0, body, length);
+    if ((flags & BOOT_IMAGE_FLAG_SHA256) != 0)
+    {
+        image_sw_sha256(body, length, header->sha256);
+    }
+    header->header_crc = image_sw_crc32(0, (const uint8_t *)header, offsetof(boot_image_header_t, header_crc));
+
+    return 0;
+}
+
+/**
+ * @brief   У龵
+ * @note    Bootloaderͬʶ汾ͷCRCӵַȡڡλCRC32SHA-256
+ * @param   image: 񣨾ͷ+Ӧó
+ * @param   length: 񳤶ȣɴھͷ¼ĳȣۣ
+ * @param   base: ͷCPUַ
+ * @param   header: ľͷΪNULL
+ * @param   reason: ʧԭ򣬿ΪNULL
+ * @retval  0: Ч, -1: Ч
+ */
+int image_sw_check(const uint8_t *image, uint32_t length, uint32_t base,
+                   boot_image_header_t *header, const char **reason)
+{
+    boot_image_header_t local;
+    uint8_t digest[32];
+    const uint8_t *body = image + BOOT_IMAGE_HEADER_SIZE;
+    const char *error = NULL;
+
+    if (header == NULL)
+    {
+        header = &local;
+    }
+
+    if (length < BOOT_IMAGE_HEADER_SIZE)
+    {
+        error = "image shorter than header";
+        goto out;
+    }
+    memcpy(header, image, sizeof(boot_image_header_t));
+
+    if ((header->magic != BOOT_IMAGE_MAGIC) || (header->header_version != BOOT_IMAGE_HEADER_VERSION) || (header->header_size != BOOT_IMAGE_HEADER_SIZE))
+    {
+        error = "bad magic or header version";
+    }
+    else if (header->header_crc != image_sw_crc32(0, image, offsetof(boot_image_header_t, header_crc)))
+    {
+        error = "header crc mismatch";
+    }
+    else if (header->load_address != (base + BOOT_IMAGE_HEADER_SIZE))
+    {
+        error = "load address mismatch";
+    }
+    else if ((header->image_size < 8) || (header->image_size > (length - BOOT_IMAGE_HEADER_SIZE)))
+    {
+        error = "bad image size";
+    }
+    else if (((header->entry_address & 1) == 0) || (header->entry_address < header->load_address) ||
+             ((header->entry_address - header->load_address) >= header->image_size))
+    {
+        error = "bad entry address";
+    }
+    else if (image_sw_get32(&body[4]) != header->entry_address)
+    {
+        error = "reset vector mismatch";
+    }
+    else if (image_sw_crc32(0, body, header->image_size) != header->crc32)
+    {
+        error = "image crc mismatch";
+    }
+    else if ((header->flags & BOOT_IMAGE_FLAG_SHA256) != 0)
+    {
+        image_sw_sha256(body, header->image_size, digest);
+        if (memcmp(digest, header->sha256, sizeof(digest)) != 0)
+        {
+            error = "image sha256 mismatch";
+        }
+    }
+
+out:
+    if (reason != NULL)
+    {
+        *reason = error;
+    }
+
+    return (error == NULL) ? 0 : -1;
+}
@@ -0,0 +1,39 @@
+/**
+ ****************************************************************************************************
+ * @file        image_sw.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ӦóCRC32/SHA-256οʵ뾵ͷɡУ
+ ****************************************************************************************************
+ * @attention
+ *
+ * image_packerNOR FlashCRC/HASH裩ã
+ * УBSP/boot_image.cBootloaderУһ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __IMAGE_SW_H
+#define __IMAGE_SW_H
+
+#include "boot_image.h"
+
+/* SHA-256Ķ */
+typedef struct {
+    uint32_t state[8];      /* мϣֵ */
+    uint64_t length;        /* ֽ */
+    uint8_t block[64];      /* δһ */
+} image_sw_sha256_t;
+
+/*  */
+uint32_t image_sw_crc32(uint32_t crc, const uint8_t *data, uint32_t length);           /* CRC32zlib crc32()ͬ״crcΪ0 */
+void image_sw_sha256_init(image_sw_sha256_t *ctx);                                      /* ʼSHA-256 */
+void image_sw_sha256_update(image_sw_sha256_t *ctx, const uint8_t *data, uint32_t length);  /* SHA-256 */
+void image_sw_sha256_final(image_sw_sha256_t *ctx, uint8_t digest[32]);                 /* SHA-256 */
+void image_sw_sha256(const uint8_t *data, uint32_t length, uint8_t digest[32]);         /* SHA-256 */
+int image_sw_make_header(boot_image_header_t *header, const uint8_t *body, uint32_t length,
+                         uint32_t version, uint32_t base, uint32_t flags);              /* ɾͷ */
+int image_sw_check(const uint8_t *image, uint32_t length, uint32_t base,
+                   boot_image_header_t *header, const char **reason);                   /* У龵񣨾ͷ+Ӧó */
+
+#endif /* __IMAGE_SW_H */
@@ -0,0 +1,441 @@
+/**
+ ****************************************************************************************************
+ * @file        section_sw.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ѹεLZ4ѹαУ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ѹʹùϣƥ䣨̰ģֻӰѹѹʱ䣬Ϊ׼LZ4ʽ
+ * lz4BSP/boot_lz4.cѹĩβ5ֽΪһƥĩβ12ֽ֮ǰʼ
+ * lz4ͬ
+ *
+ ****************************************************************************************************
+ */
+
+#include "section_sw.h"
+#include "image_sw.h"
+#include "boot_lz4.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ϣ */
+#define SECTION_SW_HASH_BITS    (16)
+
+/**
+ * @brief   4ֽڹϣ
+ * @param   data: ָ
+ * @retval  ϣֵ
+ */
+static uint32_t section_sw_hash(const uint8_t *data)
+{
+    uint32_t value = (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+
+    return (uint32_t)(value * 2654435761UL) >> (32 - SECTION_SW_HASH_BITS);
+}
+
+/**
+ * @brief   дչ
+ * @param   out: ָ룬ʱָչ֮
+ * @param   length: 15ĳ
+ * @retval  
+ */
+static void section_sw_put_length(uint8_t **out, uint32_t length)
+{
+    uint8_t *p = *out;
+
+    while (length >= 255)
+    {
+        *p++ = 255;
+        length -= 255;
+    }
+    *p++ = (uint8_t)length;
+
+    *out = p;
+}
+
+/**
+ * @brief   һ
+ * @param   dst: 
+ * @param   capacity: 
+ * @param   op: 
+ * @param   literal: 
+ * @param   literal_length: 
+ * @param   offset: ƥ
+ * @param   match_length: ƥ䳤ȣ0: һУֻ
+ * @retval  0: ɹ, -1: 
+ */
+static int section_sw_emit(uint8_t *dst, uint32_t capacity, uint32_t *op, const uint8_t *literal, uint32_t literal_length,
+                           uint32_t offset, uint32_t match_length)
+{
+    uint8_t *p = dst + *op;
+    uint8_t *token = p;
+    uint32_t need = 1 + literal_length + (literal_length / 255) + 1 + 2 + (match_length / 255) + 1;
+
+    if (need > (capacity - *op))
+    {
+        return -1;
+    }
+
+    p++;
+    *token = (uint8_t)(((literal_length < 15) ? literal_length : 15) << 4);
+    if (literal_length >= 15)
+    {
+        section_sw_put_length(&p, literal_length - 15);
+    }
+    memcpy(p, literal, literal_length);
+    p += literal_length;
+
+    if (match_length != 0)
+    {
+        *p++ = (uint8_t)offset;
+        *p++ = (uint8_t)(offset >> 8);
+        match_length -= BOOT_LZ4_MIN_MATCH;
+        *token |= (uint8_t)((match_length < 15) ? match_length : 15);
+        if (match_length >= 15)
+        {
+            section_sw_put_length(&p, match_length - 15);
+        }
+    }
+
+    *op = (uint32_t)(p - dst);
+
+    return 0;
+}
+
+/**
+ * @brief   LZ4ѹ
+ * @param   src: ԭʼ
+ * @param   size: ԭʼݳ
+ * @param   dst: BOOT_LZ4_BOUND(size)ֽʱ᲻㣩
+ * @param   capacity: 
+ * @param   depth: ÿλñȽϵĺѡSECTION_SW_DEPTH_xxx
+ * @retval  ѹ󳤶ȣ0: ڴ治
+ */
+uint32_t section_sw_lz4_compress(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t capacity, uint32_t depth)
+{
+    int32_t *head;
+    int32_t *chain;
+    int32_t candidate;
+    uint32_t anchor = 0;
+    uint32_t pos = 0;
+    uint32_t op = 0;
+    uint32_t limit;
+    uint32_t match_limit;
+    uint32_t best_length;
+    uint32_t best_offset;
+    uint32_t length;
+    uint32_t tries;
+    uint32_t hash;
+    uint32_t index;
+
+    head = malloc(sizeof(int32_t) << SECTION_SW_HASH_BITS);
+    chain = malloc(sizeof(int32_t) * ((size != 0) ? size : 1));
+    if ((head == NULL) || (chain == NULL))
+    {
+        free(head);
+        free(chain);
+        return 0;
+    }
+    memset(head, 0xFF, sizeof(int32_t) << SECTION_SW_HASH_BITS);
+
+    if (size > BOOT_LZ4_MF_LIMIT)
+    {
+        limit = size - BOOT_LZ4_MF_LIMIT;
+        match_limit = size - BOOT_LZ4_LAST_LITERALS;
+
+        while (pos < limit)
+        {
+            /* عϣƥ */
+            hash = section_sw_hash(&src[pos]);
+            best_length = 0;
+            best_offset = 0;
+            tries = depth;
+            for (candidate = head[hash]; (candidate >= 0) && ((pos - (uint32_t)candidate) <= BOOT_LZ4_MAX_OFFSET) && (tries != 0);
+                 candidate = chain[candidate], tries--)
+            {
+                if (src[candidate + best_length] != src[pos + best_length])
+                {
+                    continue;
+                }
+                for (length = 0; ((pos + length) < match_limit) && (src[candidate + length] == src[pos + length]); length++)
+                {
+                }
+                if (length > best_length)
+                {
+                    best_length = length;
+                    best_offset = pos - (uint32_t)candidate;
+                }
+            }
+            chain[pos] = head[hash];
+            head[hash] = (int32_t)pos;
+
+            if (best_length < BOOT_LZ4_MIN_MATCH)
+            {
+                pos++;
+                continue;
+            }
+
+            if (section_sw_emit(dst, capacity, &op, &src[anchor], pos - anchor, best_offset, best_length) != 0)
+            {
+                op = 0;
+                goto out;
+            }
+
+            /* ƥ串ǵλͬϣ */
+            for (index = pos + 1; (index < (pos + best_length)) && ((index + 4) <= size); index++)
+            {
+                hash = section_sw_hash(&src[index]);
+                chain[index] = head[hash];
+                head[hash] = (int32_t)index;
+            }
+            pos += best_length;
+            anchor = pos;
+        }
+    }
+
+    if (section_sw_emit(dst, capacity, &op, &src[anchor], size - anchor, 0, 0) != 0)
+    {
+        op = 0;
+    }
+
+out:
+    free(head);
+    free(chain);
+
+    return op;
+}
+
+/**
+ * @brief   ĿĵַΧBootloaderͬ
+ * @param   address: Ŀĵַ
+ * @param   size: 
+ * @retval  0: λITCMAXI SRAM÷Χ, -1: Χ
+ */
+int section_sw_range(uint32_t address, uint32_t size)
+{
+    if (((address - BOOT_IMAGE_ITCM_BASE) < BOOT_IMAGE_ITCM_SIZE) && (size <= (BOOT_IMAGE_ITCM_SIZE - (address - BOOT_IMAGE_ITCM_BASE))))
+    {
+        return 0;
+    }
+    if (((address - BOOT_IMAGE_AXI_BASE) < BOOT_IMAGE_AXI_SIZE) && (size <= (BOOT_IMAGE_AXI_SIZE - (address - BOOT_IMAGE_AXI_BASE))))
+    {
+        return 0;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief   Ӧó󸽼Ӷα
+ * @note    Ӧó0xFF4ֽڶηŶαݣ4ֽڶ룩
+ *          ѹСԭȵĶΰѹ洢֮䲻ص
+ * @param   body: Ӧómalloc䣬ʱ·䣩
+ * @param   length: Ӧó򳤶ȣظӺĳȣͷimage_size
+ * @param   input: 
+ * @param   count: 
+ * @param   depth: LZ4
+ * @param   table_offset: αƫ
+ * @param   reason: ʧԭ򣬿ΪNULL
+ * @retval  0: ɹ, -1: ʧ
+ */
+int section_sw_append(uint8_t **body, uint32_t *length, const section_sw_input_t *input, uint32_t count,
+                      uint32_t depth, uint32_t *table_offset, const char **reason)
+{
+    boot_image_section_table_t table;
+    boot_image_section_t section;
+    const char *error = NULL;
+    uint8_t *data;
+    uint32_t capacity;
+    uint32_t offset;
+    uint32_t packed;
+    uint32_t index;
+    uint32_t other;
+
+    if ((count == 0) || (count > BOOT_IMAGE_SECTION_MAX))
+    {
+        error = "bad section count";
+        goto out;
+    }
+
+    capacity = ((*length + 3) & ~3UL) + sizeof(table) + count * sizeof(section);
+    for (index = 0; index < count; index++)
+    {
+        if ((input[index].size == 0) || (section_sw_range(input[index].address, input[index].size) != 0))
+        {
+            error = "section empty or outside ITCM/AXI SRAM";
+            goto out;
+        }
+        for (other = 0; other < index; other++)
+        {
+            if ((input[index].address < (input[other].address + input[other].size)) && (input[other].address < (input[index].address + input[index].size)))
+            {
+                error = "sections overlap";
+                goto out;
+            }
+        }
+        capacity += (BOOT_LZ4_BOUND(input[index].size) + 3) & ~3UL;
+    }
+
+    data = realloc(*body, capacity);
+    if (data == NULL)
+    {
+        error = "out of memory";
+        goto out;
+    }
+    *body = data;
+
+    offset = (*length + 3) & ~3UL;
+    memset(&data[*length], 0xFF, offset - *length);
+    *table_offset = offset;
+    offset += sizeof(table) + count * sizeof(section);
+
+    for (index = 0; index < count; index++)
+    {
+        section.address = input[index].address;
+        section.size = input[index].size;
+        section.offset = offset;
+        section.crc32 = image_sw_crc32(0, input[index].data, input[index].size);
+
+        packed = section_sw_lz4_compress(input[index].data, input[index].size, &data[offset], capacity - offset, depth);
+        if ((packed != 0) && (packed < input[index].size))
+        {
+            section.method = BOOT_IMAGE_METHOD_LZ4;
+            section.packed_size = packed;
+        }
+        else
+        {
+            section.method = BOOT_IMAGE_METHOD_STORED;
+            section.packed_size = input[index].size;
+            memcpy(&data[offset], input[index].data, input[index].size);
+        }
+
+        memcpy(&data[*table_offset + sizeof(table) + index * sizeof(section)], &section, sizeof(section));
+        offset += section.packed_size;
+        memset(&data[offset], 0xFF, ((offset + 3) & ~3UL) - offset);
+        offset = (offset + 3) & ~3UL;
+    }
+
+    table.magic = BOOT_IMAGE_SECTION_MAGIC;
+    table.count = count;
+    memcpy(&data[*table_offset], &table, sizeof(table));
+    *length = offset;
+
+out:
+    if (reason != NULL)
+    {
+        *reason = error;
+    }
+
+    return (error == NULL) ? 0 : -1;
+}
+
+/**
+ * @brief   ھͷм¼α
+ * @note    image_sw_make_header()֮ã¼㾵ͷCRC
+ * @param   header: ͷ
+ * @param   table_offset: αƫ
+ * @retval  
+ */
+void section_sw_seal(boot_image_header_t *header, uint32_t table_offset)
+{
+    header->flags |= BOOT_IMAGE_FLAG_SECTIONS;
+    header->section_table = table_offset;
+    header->header_crc = image_sw_crc32(0, (const uint8_t *)header, offsetof(boot_image_header_t, header_crc));
+}
+
+/**
+ * @brief   У鲢ѹȫ
+ * @note    boot_image_load_sections()ͬͷͨimage_sw_check()αʱֱͨ
+ * @param   body: Ӧó򣨾ͷ֮
+ * @param   header: ͷ
+ * @param   reason: ʧԭ򣬿ΪNULL
+ * @retval  0: ȫЧ, -1: αЧ
+ */
+int section_sw_check(const uint8_t *body, const boot_image_header_t *header, const char **reason)
+{
+    boot_image_section_table_t table;
+    boot_image_section_t section;
+    const char *error = NULL;
+    uint8_t *ram;
+    uint32_t length;
+    uint32_t index;
+
+    if ((header->flags & BOOT_IMAGE_FLAG_SECTIONS) == 0)
+    {
+        goto out;
+    }
+
+    if (((header->section_table & 3) != 0) || (header->section_table > header->image_size) ||
+        ((header->image_size - header->section_table) < sizeof(table)))
+    {
+        error = "section table outside image";
+        goto out;
+    }
+    memcpy(&table, &body[header->section_table], sizeof(table));
+    if ((table.magic != BOOT_IMAGE_SECTION_MAGIC) || (table.count > BOOT_IMAGE_SECTION_MAX) ||
+        ((header->image_size - header->section_table - sizeof(table)) < (table.count * sizeof(section))))
+    {
+        error = "bad section table";
+        goto out;
+    }
+
+    for (index = 0; (index < table.count) && (error == NULL); index++)
+    {
+        memcpy(&section, &body[header->section_table + sizeof(table) + index * sizeof(section)], sizeof(section));
+        if ((section.offset > header->image_size) || (section.packed_size > (header->image_size - section.offset)))
+        {
+            error = "section data outside image";
+            break;
+        }
+        if (section_sw_range(section.address, section.size) != 0)
+        {
+            error = "section outside ITCM/AXI SRAM";
+            break;
+        }
+
+        ram = malloc((section.size != 0) ? section.size : 1);
+        if (ram == NULL)
+        {
+            error = "out of memory";
+            break;
+        }
+        if (section.method == BOOT_IMAGE_METHOD_STORED)
+        {
+            if (section.packed_size != section.size)
+            {
+                error = "stored section size mismatch";
+            }
+            else
+            {
+                memcpy(ram, &body[section.offset], section.size);
+            }
+        }
+        else if (section.method == BOOT_IMAGE_METHOD_LZ4)
+        {
+            if ((boot_lz4_decompress(&body[section.offset], section.packed_size, ram, section.size, &length) != 0) || (length != section.size))
+            {
+                error = "section lz4 data corrupt";
+            }
+        }
+        else
+        {
+            error = "unknown section method";
+        }
+        if ((error == NULL) && (image_sw_crc32(0, ram, section.size) != section.crc32))
+        {
+            error = "section crc mismatch";
+        }
+        free(ram);
+    }
+
+out:
+    if (reason != NULL)
+    {
+        *reason = error;
+    }
+
+    return (error == NULL) ? 0 : -1;
+}
@@ -0,0 +1,40 @@
+/**
+ ****************************************************************************************************
+ * @file        section_sw.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ѹεLZ4ѹαУ
+ ****************************************************************************************************
+ * @attention
+ *
+ * αݸӦó֮󣨼BSP/boot_image.hѹʹBSP/boot_lz4.c
+ * Bootloaderboot_image_load_sections()һ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __SECTION_SW_H
+#define __SECTION_SW_H
+
+#include "boot_image.h"
+
+/* LZ4ѹȶ */
+#define SECTION_SW_DEPTH_FAST   (1)     /* ֻȽһѡLZ4_compress_default()൱ */
+#define SECTION_SW_DEPTH_HIGH   (256)   /* ĬֵѹѹٶȲ */
+
+/* Ķζ */
+typedef struct {
+    uint32_t address;       /* ĿĵַCPUַ */
+    const uint8_t *data;    /*  */
+    uint32_t size;          /* γ */
+} section_sw_input_t;
+
+/*  */
+uint32_t section_sw_lz4_compress(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t capacity, uint32_t depth);  /* LZ4ѹ */
+int section_sw_range(uint32_t address, uint32_t size);                                  /* ĿĵַΧ */
+int section_sw_append(uint8_t **body, uint32_t *length, const section_sw_input_t *input, uint32_t count,
+                      uint32_t depth, uint32_t *table_offset, const char **reason);     /* Ӧó󸽼Ӷα */
+void section_sw_seal(boot_image_header_t *header, uint32_t table_offset);               /* ھͷм¼α */
+int section_sw_check(const uint8_t *body, const boot_image_header_t *header, const char **reason);  /* У鲢ѹȫ */
+
+#endif /* __SECTION_SW_H */
@@ -0,0 +1,113 @@
+/**
+ ****************************************************************************************************
+ * @file        crc_hash_sim.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       CRCHASH
+ ****************************************************************************************************
+ * @attention
+ *
+ * Tools/image_packerеοʵִCRC裨Ĭ϶ʽĬϳֵ밴ֽڷת
+ * תHASH裨SHA-256÷ش
+ * λڴӳ䴰ʱ˳ȡƽʱ
+ *
+ ****************************************************************************************************
+ */
+
+#include "main.h"
+#include "image_sw.h"
+#include "w25q128_sim.h"
+
+CRC_TypeDef crc_sim_instance;
+HASH_TypeDef hash_sim_instance;
+
+/**
+ * @brief   HALʼCRC
+ * @param   hcrc: CRCָ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_CRC_Init(CRC_HandleTypeDef *hcrc)
+{
+    if ((hcrc->Instance != CRC) || (hcrc->Init.DefaultPolynomialUse != DEFAULT_POLYNOMIAL_ENABLE) ||
+        (hcrc->Init.DefaultInitValueUse != DEFAULT_INIT_VALUE_ENABLE) ||
+        (hcrc->Init.InputDataInversionMode != CRC_INPUTDATA_INVERSION_BYTE) ||
+        (hcrc->Init.OutputDataInversionMode != CRC_OUTPUTDATA_INVERSION_ENABLE) ||
+        (hcrc->InputDataFormat != CRC_INPUTDATA_FORMAT_BYTES))
+    {
+        return HAL_ERROR;
+    }
+
+    hcrc->Instance->DR = 0xFFFFFFFFUL;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALCRCۼӼ
+ * @note    ݼĴ淴CRCмֵδȡzlibΪȡ
+ * @param   hcrc: CRCָ
+ * @param   pBuffer: ָ
+ * @param   BufferLength: ݳȣֽڣ
+ * @retval  ݼĴֵ
+ */
+uint32_t HAL_CRC_Accumulate(CRC_HandleTypeDef *hcrc, uint32_t pBuffer[], uint32_t BufferLength)
+{
+    hcrc->Instance->DR = ~image_sw_crc32(~hcrc->Instance->DR, (const uint8_t *)pBuffer, BufferLength);
+    w25q128_sim_mmap_stream(pBuffer, BufferLength);
+
+    return hcrc->Instance->DR;
+}
+
+/**
+ * @brief   HALCRC
+ * @param   hcrc: CRCָ
+ * @param   pBuffer: ָ
+ * @param   BufferLength: ݳȣֽڣ
+ * @retval  ݼĴֵ
+ */
+uint32_t HAL_CRC_Calculate(CRC_HandleTypeDef *hcrc, uint32_t pBuffer[], uint32_t BufferLength)
+{
+    hcrc->Instance->DR = 0xFFFFFFFFUL;
+
+    return HAL_CRC_Accumulate(hcrc, pBuffer, BufferLength);
+}
+
+/**
+ * @brief   HALʼHASH
+ * @param   hhash: HASHָ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_HASH_Init(HASH_HandleTypeDef *hhash)
+{
+    if ((hhash->Instance != HASH) || (hhash->Init.DataType != HASH_BYTE_SWAP) || (hhash->Init.Algorithm != HASH_ALGOSELECTION_SHA256))
+    {
+        return HAL_ERROR;
+    }
+
+    hhash->Instance->CR = hhash->Init.Algorithm | hhash->Init.DataType;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALHASH
+ * @param   hhash: HASHָ
+ * @param   pInBuffer: ָ
+ * @param   Size: ݳ
+ * @param   pOutBuffer: 32ֽڽ
+ * @param   Timeout: ʱʱ䣨δʹã
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_HASH_Start(HASH_HandleTypeDef *hhash, const uint8_t *const pInBuffer, uint32_t Size,
+                                 uint8_t *const pOutBuffer, uint32_t Timeout)
+{
+    if (hhash->Instance->CR != (HASH_ALGOSELECTION_SHA256 | HASH_BYTE_SWAP))
+    {
+        return HAL_ERROR;
+    }
+
+    image_sw_sha256(pInBuffer, Size, pOutBuffer);
+    w25q128_sim_mmap_stream(pInBuffer, Size);
+
+    return HAL_OK;
+}
@@ -0,0 +1,32 @@
+/**
+ ****************************************************************************************************
+ * @file        main.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       main.hCubeMXɵmain.h
+ ****************************************************************************************************
+ * @attention
+ *
+ * BSPʱĿ¼λڰ·λʹе#include "main.h"ñļ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#include "stm32h7rsxx_hal_sim.h"
+
+/* еHAL_XSPI_MspInit()/HAL_XSPI_MspDeInit() */
+#define __SYS_H
+
+/* в¼ʱߣûDWT뱸SRAM */
+#define BOOT_TRACE_ENABLE   (0)
+
+/* νѹRAMBSP/boot_image.cw25q128_sim_ram() */
+uint8_t *w25q128_sim_ram(uint32_t address);
+#define BOOT_IMAGE_SECTION_POINTER(address)     w25q128_sim_ram(address)
+
+void Error_Handler(void);
+
+#endif /* __MAIN_H */
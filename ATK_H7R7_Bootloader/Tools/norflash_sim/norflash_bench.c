@@ -0,0 +1,1547 @@
+/**
+ ****************************************************************************************************
+ * @file        norflash_bench.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       NOR Flash׼
+ ****************************************************************************************************
+ * @attention
+ *
+ * ڷδ޸ĵBSP/norflash_w25q128.cͳڡ
+ * ʱ/̴УݣУʧʱط0
+ *
+ * ÷: norflash_bench [-i ļ] [-t typ|max] [-k] [-j] [-v]
+ *       -k: оļݣĬÿ´հ׾
+ *       -j: 治֧DTRٶW25Q128JVDTRӦУʧܲˣ
+ *
+ ****************************************************************************************************
+ */
+
+#include "norflash_w25q128.h"
+#include "norflash_cache.h"
+#include "norflash_kv.h"
+#include "norflash_bd.h"
+#include "norflash_fs.h"
+#include "boot_image.h"
+#include "boot_slot.h"
+#include "boot_delta.h"
+#include "image_sw.h"
+#include "section_sw.h"
+#include "delta_sw.h"
+#include "w25q128_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*  */
+#define BENCH_BASE              (0x00100000UL)
+#define BENCH_LENGTH            (0x00010000UL)
+#define BENCH_SMALL_OFFSET      (0x00000100UL)
+#define BENCH_SMALL_LENGTH      (16U)
+#define BENCH_INTERLEAVE_ROUNDS (8U)
+#define BENCH_RANGE_BASE        (0x00400000UL)
+#define BENCH_RANGE_LENGTH      (0x00400000UL)
+#define BENCH_CACHE_LINE        (32U)
+#define BENCH_ERASE_SLICE       (5U)
+#define BENCH_KV_KEYS           (8U)
+#define BENCH_KV_ROUNDS         (250U)
+#define BENCH_IMAGE_ADDRESS     (0x00000000UL)
+#define BENCH_IMAGE_SIZE        (0x000C0000UL)
+#define BENCH_SLOT_CHUNK        (0x00000800UL)
+#define BENCH_POINTER_STEP      (256U)
+#define BENCH_DELTA_CHUNK       (0x00000400UL)
+#define BENCH_SECTION_ADDRESS   (0x00800000UL)
+#define BENCH_SECTION_AXI_SIZE  (0x00020000UL)
+#define BENCH_SECTION_ITCM      (0x0000C000UL)
+#define BENCH_SECTION_ITCM_SIZE (0x00001000UL)
+#define BENCH_FS_LARGE_SIZE     (0x00100000UL)
+#define BENCH_FS_SMALL_READ     (256U)
+#define BENCH_FS_FILES          (16U)
+#define BENCH_FS_ROUNDS         (150U)
+#define BENCH_FS_APPENDS        (50U)
+#define BENCH_FS_APPEND_LENGTH  (300U)
+
+/* ݶ */
+static uint8_t bench_image[BOOT_IMAGE_HEADER_SIZE + BENCH_IMAGE_SIZE];
+static uint8_t bench_old_image[BOOT_IMAGE_HEADER_SIZE + BENCH_IMAGE_SIZE];
+static uint8_t bench_expect[BENCH_LENGTH];
+static uint8_t bench_buffer[BENCH_LENGTH];
+static int bench_failures = 0;
+
+/* ó */
+static const char *const bench_profile_name[NORFlash_Read_Dummy] = {
+    [NORFlash_Read_Normal] = "profile_normal",
+    [NORFlash_Read_XIP] = "profile_xip",
+    [NORFlash_Read_XIP_DTR] = "profile_xip_dtr",
+};
+
+/* 첽ɼ */
+static uint32_t bench_async_done = 0;
+static uint32_t bench_async_failed = 0;
+
+/**
+ * @brief   CubeMX
+ * @param   
+ * @retval  
+ */
+void Error_Handler(void)
+{
+    fprintf(stderr, "Error_Handler\n");
+    exit(2);
+}
+
+/**
+ * @brief   ӡͷ
+ * @param   
+ * @retval  
+ */
+static void bench_print_header(void)
+{
+    printf("%-24s %5s %8s %8s %10s %11s %9s %4s %4s %4s %6s %4s\n",
+           "scenario", "res", "commands", "polls", "bus_cycles", "sim_ms", "KB/s", "4K", "32K", "64K", "pages", "viol");
+}
+
+/**
+ * @brief   ӡһͳ
+ * @param   name: 
+ * @param   res: ֵ
+ * @param   bytes: 
+ * @retval  
+ */
+static void bench_print_row(const char *name, uint32_t res, uint32_t bytes)
+{
+    w25q128_sim_stats_t stats;
+    double ms;
+    double kbps;
+
+    w25q128_sim_get_stats(&stats);
+    ms = stats.time_ns / 1000000.0;
+    kbps = ((bytes != 0) && (stats.time_ns != 0)) ? (bytes / 1024.0) / (stats.time_ns / 1000000000.0) : 0.0;
+
+    printf("%-24s %5u %8u %8u %10llu %11.3f %9.1f %4u %4u %4u %6u %4u\n",
+           name, (unsigned int)res, (unsigned int)stats.commands, (unsigned int)stats.polls, (unsigned long long)stats.bus_cycles,
+           ms, kbps, (unsigned int)stats.sector_erases, (unsigned int)stats.block32_erases, (unsigned int)stats.block64_erases,
+           (unsigned int)stats.page_programs, (unsigned int)stats.violations);
+
+    if (stats.violations != 0)
+    {
+        bench_failures++;
+    }
+}
+
+/**
+ * @brief   У
+ * @param   name: 
+ * @param   data: 
+ * @param   length: ݳ
+ * @retval  
+ */
+static void bench_verify(const char *name, const uint8_t *data, uint32_t length)
+{
+    uint32_t index;
+
+    for (index = 0; index < length; index++)
+    {
+        if (data[index] != bench_expect[index])
+        {
+            printf("  %s: mismatch at 0x%08X, read 0x%02X expect 0x%02X\n", name, (unsigned int)(BENCH_BASE + index), data[index], bench_expect[index]);
+            bench_failures++;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief   ֵ
+ * @param   name: 
+ * @param   res: ֵ
+ * @retval  
+ */
+static void bench_check(const char *name, uint32_t res)
+{
+    if (res != 0)
+    {
+        printf("  %s: driver returned %u\n", name, (unsigned int)res);
+        bench_failures++;
+    }
+}
+
+/**
+ * @brief   첽ɻص
+ * @param   result: 
+ * @param   arg: ص
+ * @retval  
+ */
+static void bench_async_callback(uint8_t result, void *arg)
+{
+    (void)arg;
+
+    bench_async_done++;
+    if (result != 0)
+    {
+        bench_async_failed++;
+    }
+}
+
+/**
+ * @brief   ȴȫ첽ɣģжϷ
+ * @param   
+ * @retval  жϴ
+ */
+static uint32_t bench_async_wait(void)
+{
+    uint32_t irqs = 0;
+
+    while (norflash_async_busy() != 0)
+    {
+        if (w25q128_sim_wait_event() != 0)
+        {
+            norflash_xspi1_irq_handler();
+            irqs++;
+        }
+    }
+
+    return irqs;
+}
+
+/**
+ * @brief   4Сݸ
+ * @note    ÿθ¾ȡֱдʱÿζҪ
+ * @param   cached: Ƿдػд
+ * @retval  д
+ */
+static uint32_t bench_interleave(int cached)
+{
+    uint32_t round;
+    uint32_t sector;
+    uint32_t offset;
+    uint32_t index;
+    uint32_t res = 0;
+
+    for (round = 0; round < BENCH_INTERLEAVE_ROUNDS; round++)
+    {
+        for (sector = 0; sector < 4; sector++)
+        {
+            offset = sector * norflash_get_sector_size() + round * BENCH_SMALL_LENGTH;
+            for (index = 0; index < BENCH_SMALL_LENGTH; index++)
+            {
+                bench_expect[offset + index] = (uint8_t)~bench_expect[offset + index];
+            }
+            if (cached != 0)
+            {
+                res |= norflash_cache_write(BENCH_BASE + offset, &bench_expect[offset], BENCH_SMALL_LENGTH);
+            }
+            else
+            {
+                res |= norflash_write(BENCH_BASE + offset, &bench_expect[offset], BENCH_SMALL_LENGTH);
+            }
+        }
+    }
+
+    return res;
+}
+
+/**
+ * @brief   ڷΧÿҳдݣʹǿ
+ * @param   address: ʼַ
+ * @param   length: 
+ * @retval  д
+ */
+static uint32_t bench_dirty_range(uint32_t address, uint32_t length)
+{
+    uint32_t offset;
+    uint32_t res = 0;
+
+    for (offset = 0; offset < length; offset += norflash_get_sector_size())
+    {
+        res |= norflash_program_page(address + offset, bench_expect, norflash_get_page_size());
+    }
+
+    return res;
+}
+
+/**
+ * @brief   ɼֵ洢Եļֵ
+ * @param   key: 
+ * @param   value: ֵBENCH_SMALL_LENGTHֽڣ
+ * @param   index: 
+ * @param   round: ִ
+ * @retval  
+ */
+static void bench_kv_item(char *key, uint8_t *value, uint32_t index, uint32_t round)
+{
+    uint32_t offset;
+
+    snprintf(key, NORFLASH_KV_KEY_MAX + 1, "setting.%u", (unsigned int)index);
+    for (offset = 0; offset < BENCH_SMALL_LENGTH; offset++)
+    {
+        value[offset] = (uint8_t)(index * 31 + round * 7 + offset);
+    }
+}
+
+/**
+ * @brief   Уֵ洢иΪһֵֵ
+ * @param   name: 
+ * @param   round: һִָ
+ * @retval  
+ */
+static void bench_kv_verify(const char *name, uint32_t round)
+{
+    char key[NORFLASH_KV_KEY_MAX + 1];
+    uint8_t expect[BENCH_SMALL_LENGTH];
+    uint8_t value[BENCH_SMALL_LENGTH];
+    uint16_t length;
+    uint32_t index;
+
+    for (index = 0; index < BENCH_KV_KEYS; index++)
+    {
+        bench_kv_item(key, expect, index, round);
+        if ((norflash_kv_get(key, value, sizeof(value), &length) != 0) || (length != BENCH_SMALL_LENGTH) || (memcmp(value, expect, BENCH_SMALL_LENGTH) != 0))
+        {
+            printf("  %s: %s mismatch\n", name, key);
+            bench_failures++;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief   ӡֵ洢ͳ
+ * @param   
+ * @retval  
+ */
+static void bench_print_kv_stats(void)
+{
+    norflash_kv_stats_t stats;
+
+    norflash_kv_get_stats(&stats);
+    printf("  kv: keys %u, used %u, free %u, head free %u, seq %u, appends %u, compactions %u\n",
+           (unsigned int)stats.keys, (unsigned int)stats.used_sectors, (unsigned int)stats.free_sectors,
+           (unsigned int)stats.head_free, (unsigned int)stats.sequence, (unsigned int)stats.appends, (unsigned int)stats.compactions);
+}
+
+/**
+ * @brief   Ӧó
+ * @note    ΪMSP븴λÿBENCH_POINTER_STEPֽһָڵľԵַģֳأ
+ *          ΪӾαݣͬһӵһʱֻЩַͬ
+ * @param   address: ӦNOR Flashַ
+ * @param   seed: 
+ * @retval  
+ */
+static void bench_image_fill(uint32_t address, uint32_t seed)
+{
+    uint8_t *body = &bench_image[BOOT_IMAGE_HEADER_SIZE];
+    uint32_t load_address = BOOT_IMAGE_XSPI_BASE + address + BOOT_IMAGE_HEADER_SIZE;
+    uint32_t vector[2] = {0x20010000UL, load_address + 0x201UL};
+    uint32_t pointer;
+    uint32_t index;
+
+    for (index = 0; index < BENCH_IMAGE_SIZE; index++)
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        body[index] = (uint8_t)(seed >> 16);
+    }
+    for (index = BENCH_POINTER_STEP; index < BENCH_IMAGE_SIZE; index += BENCH_POINTER_STEP)
+    {
+        pointer = load_address + ((index * 7) % BENCH_IMAGE_SIZE);
+        memcpy(&body[index], &pointer, sizeof(pointer));
+    }
+    memcpy(body, vector, sizeof(vector));
+}
+
+/**
+ * @brief   Ӧóͷ
+ * @param   address: ӦNOR Flashַ
+ * @param   version: Ӧó汾
+ * @retval  ɽ
+ */
+static uint32_t bench_image_seal(uint32_t address, uint32_t version)
+{
+    boot_image_header_t header;
+
+    if (image_sw_make_header(&header, &bench_image[BOOT_IMAGE_HEADER_SIZE], BENCH_IMAGE_SIZE, version, BOOT_IMAGE_XSPI_BASE + address, BOOT_IMAGE_FLAG_SHA256) != 0)
+    {
+        return 1;
+    }
+    memset(bench_image, 0xFF, BOOT_IMAGE_HEADER_SIZE);
+    memcpy(bench_image, &header, sizeof(header));
+
+    return 0;
+}
+
+/**
+ * @brief   Ӧó
+ * @param   address: ӦNOR Flashַ
+ * @param   version: Ӧó汾ͬʱΪӣ
+ * @retval  ɽ
+ */
+static uint32_t bench_image_build(uint32_t address, uint32_t version)
+{
+    bench_image_fill(address, version);
+
+    return bench_image_seal(address, version);
+}
+
+/**
+ * @brief   ӦóдNOR Flash
+ * @param   version: Ӧó汾
+ * @retval  д
+ */
+static uint32_t bench_image_write(uint32_t version)
+{
+    if (bench_image_build(BENCH_IMAGE_ADDRESS, version) != 0)
+    {
+        return 1;
+    }
+
+    return norflash_write(BENCH_IMAGE_ADDRESS, bench_image, sizeof(bench_image));
+}
+
+/**
+ * @brief   УӦó񲢴ӡ
+ * @param   name: 
+ * @param   expect_ok: Ч
+ * @param   expect_cached: У
+ * @retval  
+ */
+static void bench_image_check(const char *name, uint8_t expect_ok, uint8_t expect_cached)
+{
+    boot_image_header_t header;
+    boot_image_report_t report;
+    uint32_t res;
+
+    w25q128_sim_reset_stats();
+    res = boot_image_check(BENCH_IMAGE_ADDRESS, &header);
+    boot_image_get_report(&report);
+    bench_print_row(name, res, ((res == 0) && (report.cached == 0)) ? header.image_size : 0);
+
+    printf("  image: header %u, cached %u, crc %u, sha256 %u, size %u, elapsed %u ms\n",
+           report.header_ok, report.cached, report.crc_ok, report.sha256_ok, (unsigned int)report.image_size, (unsigned int)report.elapsed);
+
+    if (((res == 0) != (expect_ok != 0)) || ((expect_ok != 0) && (report.cached != expect_cached)))
+    {
+        printf("  %s: unexpected result %u, cached %u\n", name, (unsigned int)res, report.cached);
+        bench_failures++;
+    }
+}
+
+/**
+ * @brief   ģӦóڴӳ°¾ʽдв
+ * @note    ÿεøºڴӳжѻָ¼ӳ䴰ʱ䣻
+ *          ӳ䴰м˳ӳڼж
+ * @param   name: 
+ * @param   address: ӦNOR Flashַ
+ * @param   version: Ӧó汾
+ * @param   trials: д
+ * @retval  д
+ */
+static uint32_t bench_slot_install(const char *name, uint32_t address, uint32_t version, uint8_t trials)
+{
+    boot_slot_progress_t progress;
+    norflash_erase_progress_t erase;
+    w25q128_sim_stats_t stats;
+    uint64_t stall_ns = 0;
+    uint64_t call_ns;
+    uint32_t offset;
+    uint32_t chunk;
+    uint32_t res;
+
+    if (bench_image_build(address, version) != 0)
+    {
+        return 1;
+    }
+
+    w25q128_sim_reset_stats();
+    res = norflash_memory_mapped();
+    w25q128_sim_set_xip(1);
+    res |= boot_slot_update_begin(sizeof(bench_image));
+    while (res == 0)
+    {
+        boot_slot_update_get_progress(&progress);
+        if (progress.erasing == 0)
+        {
+            break;
+        }
+
+        call_ns = w25q128_sim_now_ns();
+        res = boot_slot_update_run(BENCH_ERASE_SLICE);
+        call_ns = w25q128_sim_now_ns() - call_ns;
+        stall_ns = (call_ns > stall_ns) ? call_ns : stall_ns;
+        res |= ((norflash_memory_mapped_state() == 0) || (__get_PRIMASK() != 0)) ? 1 : 0;
+    }
+    norflash_erase_background_get_progress(&erase);
+
+    for (offset = 0; (offset < sizeof(bench_image)) && (res == 0); offset += chunk)
+    {
+        chunk = sizeof(bench_image) - offset;
+        if (chunk > BENCH_SLOT_CHUNK)
+        {
+            chunk = BENCH_SLOT_CHUNK;
+        }
+
+        call_ns = w25q128_sim_now_ns();
+        res = boot_slot_update_write(&bench_image[offset], chunk);
+        call_ns = w25q128_sim_now_ns() - call_ns;
+        stall_ns = (call_ns > stall_ns) ? call_ns : stall_ns;
+        res |= ((norflash_memory_mapped_state() == 0) || (__get_PRIMASK() != 0)) ? 1 : 0;
+    }
+
+    if (res == 0)
+    {
+        res = boot_slot_update_finish(trials);
+        res |= ((norflash_memory_mapped_state() == 0) || (__get_PRIMASK() != 0)) ? 1 : 0;
+    }
+    w25q128_sim_set_xip(0);
+    w25q128_sim_get_stats(&stats);
+    res |= (stats.xip_unmasked != 0) ? 1 : 0;
+    res |= norflash_memory_mapped_exit();
+
+    bench_print_row(name, res, (res == 0) ? sizeof(bench_image) : 0);
+    printf("  update: erase slices %u, suspends %u, %u bytes in %u byte writes, max mmap stall %.2f ms, unmasked commands %u\n",
+           (unsigned int)erase.slices, (unsigned int)erase.suspends, (unsigned int)sizeof(bench_image),
+           (unsigned int)BENCH_SLOT_CHUNK, stall_ns / 1000000.0, (unsigned int)stats.xip_unmasked);
+
+    return res;
+}
+
+/**
+ * @brief   ģһθλBootloaderѡ񲢴ӡ
+ * @param   name: 
+ * @param   expect_slot: Ĳ
+ * @param   expect_version: Ӧó汾
+ * @retval  
+ */
+static void bench_slot_boot(const char *name, uint8_t expect_slot, uint32_t expect_version)
+{
+    boot_image_header_t header;
+    boot_slot_ctrl_t ctrl;
+    norflash_kv_stats_t before;
+    norflash_kv_stats_t after;
+    uint8_t slot = BOOT_SLOT_NONE;
+    uint32_t res;
+
+    w25q128_sim_reset_stats();
+    res = norflash_kv_mount();
+    norflash_kv_get_stats(&before);
+    res |= boot_slot_select(&slot, &header);
+    norflash_kv_get_stats(&after);
+    res |= boot_slot_get_ctrl(&ctrl);
+    bench_print_row(name, res, 0);
+
+    printf("  slot: %c v%u, active %c, pending %c, trials %u, confirmed %u, rollbacks %u, kv appends %u\n",
+           (slot == BOOT_SLOT_A) ? 'A' : 'B', (unsigned int)header.image_version, (ctrl.active == BOOT_SLOT_A) ? 'A' : 'B',
+           (ctrl.pending == BOOT_SLOT_NONE) ? '-' : ((ctrl.pending == BOOT_SLOT_A) ? 'A' : 'B'), ctrl.trials, ctrl.confirmed,
+           (unsigned int)ctrl.rollbacks, (unsigned int)(after.appends - before.appends));
+
+    if ((res != 0) || (slot != expect_slot) || (header.image_version != expect_version))
+    {
+        printf("  %s: unexpected result %u, slot %u\n", name, (unsigned int)res, slot);
+        bench_failures++;
+    }
+}
+
+/**
+ * @brief   
+ * @note    ɾΪӵAv5¾v6ΪͬһӵB޸мһ
+ * @param   patch: free
+ * @param   patch_size: 
+ * @retval  ɽ
+ */
+static uint32_t bench_delta_build(uint8_t **patch, uint32_t *patch_size)
+{
+    delta_sw_stats_t stats;
+    uint8_t *body = &bench_image[BOOT_IMAGE_HEADER_SIZE];
+    uint32_t index;
+
+    if (bench_image_build(BOOT_SLOT_A_ADDRESS, 5) != 0)
+    {
+        return 1;
+    }
+    memcpy(bench_old_image, bench_image, sizeof(bench_image));
+
+    bench_image_fill(BOOT_SLOT_B_ADDRESS, 5);
+    memset(&body[0x00010000], 0x5A, 100);
+    memset(&body[0x00090000], 0xA5, 100);
+    memmove(&body[0x00040000 + 1000], &body[0x00040000], BENCH_IMAGE_SIZE - 0x00040000 - 1000);
+    for (index = 0; index < 1000; index++)
+    {
+        body[0x00040000 + index] = (uint8_t)(index * 13);
+    }
+    if (bench_image_seal(BOOT_SLOT_B_ADDRESS, 6) != 0)
+    {
+        return 1;
+    }
+
+    if (delta_sw_diff(bench_old_image, sizeof(bench_old_image), bench_image, sizeof(bench_image), patch, patch_size, &stats) != 0)
+    {
+        return 1;
+    }
+
+    printf("  diff: patch %u bytes for %u byte image (%.2f%%), copy %u, add %u (%u changed), data %u\n",
+           (unsigned int)*patch_size, (unsigned int)sizeof(bench_image), *patch_size * 100.0 / sizeof(bench_image),
+           (unsigned int)stats.copy_bytes, (unsigned int)stats.add_bytes, (unsigned int)stats.diff_bytes, (unsigned int)stats.data_bytes);
+
+    return 0;
+}
+
+/**
+ * @brief   ģӦóڴӳʽӦ
+ * @note    αȷֶ룬ÿεúڴӳжѻָӳ䴰
+ *          дУڼжϣstop_output0ʱﵽóȼֹģ磩
+ * @param   name: 
+ * @param   patch: ͷ
+ * @param   patch_size: 
+ * @param   stop_output: ֹλã0: Ӧ겢װ
+ * @param   trials: д
+ * @retval  Ӧý
+ */
+static uint32_t bench_delta_apply(const char *name, const uint8_t *patch, uint32_t patch_size, uint32_t stop_output, uint8_t trials)
+{
+    const boot_delta_header_t *header = (const boot_delta_header_t *)patch;
+    const uint8_t *ops = patch + sizeof(boot_delta_header_t);
+    boot_delta_progress_t progress;
+    boot_slot_ctrl_t ctrl;
+    w25q128_sim_stats_t stats;
+    uint64_t call_max_ns = 0;
+    uint64_t call_ns;
+    uint32_t seed = patch_size;
+    uint32_t begin_offset = 0;
+    uint32_t offset = 0;
+    uint32_t chunk;
+    uint32_t res;
+    uint8_t slot = BOOT_SLOT_NONE;
+
+    w25q128_sim_reset_stats();
+    res = boot_slot_get_ctrl(&ctrl);
+    res |= boot_slot_update_target(&slot);
+    res |= norflash_memory_mapped();
+    w25q128_sim_set_xip(1);
+    if (res == 0)
+    {
+        res = boot_delta_begin(BOOT_SLOT_ADDRESS(ctrl.booted), BOOT_SLOT_ADDRESS(slot), header, &begin_offset);
+        res |= ((norflash_memory_mapped_state() == 0) || (__get_PRIMASK() != 0)) ? 1 : 0;
+        offset = begin_offset;
+    }
+
+    while ((res == 0) && (offset < header->patch_size))
+    {
+        boot_delta_get_progress(&progress);
+        if ((stop_output != 0) && (progress.output >= stop_output))
+        {
+            break;
+        }
+
+        seed = seed * 1103515245UL + 12345UL;
+        chunk = 1 + ((seed >> 16) % BENCH_DELTA_CHUNK);
+        chunk = (chunk > (header->patch_size - offset)) ? (header->patch_size - offset) : chunk;
+
+        call_ns = w25q128_sim_now_ns();
+        res = boot_delta_write(&ops[offset], chunk);
+        call_ns = w25q128_sim_now_ns() - call_ns;
+        call_max_ns = (call_ns > call_max_ns) ? call_ns : call_max_ns;
+        res |= ((norflash_memory_mapped_state() == 0) || (__get_PRIMASK() != 0)) ? 1 : 0;
+        offset += chunk;
+    }
+
+    if ((res == 0) && (stop_output == 0))
+    {
+        res = boot_delta_finish();
+        res |= ((norflash_memory_mapped_state() == 0) || (__get_PRIMASK() != 0)) ? 1 : 0;
+        res |= boot_slot_update_install(slot, trials);
+    }
+    w25q128_sim_set_xip(0);
+    w25q128_sim_get_stats(&stats);
+    res |= (stats.xip_unmasked != 0) ? 1 : 0;
+    res |= norflash_memory_mapped_exit();
+
+    boot_delta_get_progress(&progress);
+    bench_print_row(name, res, (res == 0) ? progress.output : 0);
+    printf("  delta: slot %c, patch %u/%u from %u, output %u/%u, sectors %u, records %u, resumed %u, max write call %.2f ms, unmasked commands %u\n",
+           (slot == BOOT_SLOT_A) ? 'A' : 'B', (unsigned int)progress.patch_offset, (unsigned int)progress.patch_size,
+           (unsigned int)begin_offset, (unsigned int)progress.output, (unsigned int)progress.new_size,
+           (unsigned int)progress.sectors, (unsigned int)progress.records, progress.resumed, call_max_ns / 1000000.0,
+           (unsigned int)stats.xip_unmasked);
+
+    return res;
+}
+
+/**
+ * @brief   ģBootloaderתǰѹ
+ * @note    Ӧóȡbench_imageǰBENCH_LENGTHֽڣһѹAXI SRAMһѹITCMΣ
+ *          Уڴӳ½ѹԭʼݱȽϣ֮дһֽڶݣУֱӽѹģУУʧ
+ * @param   name: 
+ * @retval  ѹ
+ */
+static uint32_t bench_sections(const char *name)
+{
+    static uint8_t axi[BENCH_SECTION_AXI_SIZE];
+    static uint8_t itcm[BENCH_SECTION_ITCM_SIZE];
+    section_sw_input_t input[2];
+    boot_image_header_t header;
+    boot_image_report_t report;
+    boot_image_section_t section;
+    uint32_t table_offset;
+    uint32_t length = BENCH_LENGTH;
+    uint32_t index;
+    uint32_t seed = 11;
+    uint32_t res;
+    uint8_t *body;
+
+    /* ÿ64ֽǰΪԱݡΪα */
+    for (index = 0; index < BENCH_SECTION_AXI_SIZE; index++)
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        axi[index] = ((index & 0x20) == 0) ? (uint8_t)((index >> 6) % 24 * 11) : (uint8_t)(seed >> 16);
+    }
+    for (index = 0; index < BENCH_SECTION_ITCM_SIZE; index++)
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        itcm[index] = (uint8_t)(seed >> 16);
+    }
+    input[0].address = BOOT_IMAGE_AXI_BASE;
+    input[0].data = axi;
+    input[0].size = sizeof(axi);
+    input[1].address = BENCH_SECTION_ITCM;
+    input[1].data = itcm;
+    input[1].size = sizeof(itcm);
+
+    /* ɾдNOR Flash */
+    bench_image_fill(BENCH_SECTION_ADDRESS, 7);
+    body = malloc(BENCH_LENGTH);
+    if (body == NULL)
+    {
+        return 1;
+    }
+    memcpy(body, &bench_image[BOOT_IMAGE_HEADER_SIZE], BENCH_LENGTH);
+    res = (section_sw_append(&body, &length, input, 2, SECTION_SW_DEPTH_HIGH, &table_offset, NULL) != 0) ? 1 : 0;
+    res |= (image_sw_make_header(&header, body, length, 7, BOOT_IMAGE_XSPI_BASE + BENCH_SECTION_ADDRESS, BOOT_IMAGE_FLAG_SHA256) != 0) ? 1 : 0;
+    if (res == 0)
+    {
+        section_sw_seal(&header, table_offset);
+        memset(bench_image, 0xFF, BOOT_IMAGE_HEADER_SIZE);
+        memcpy(bench_image, &header, sizeof(header));
+        memcpy(&bench_image[BOOT_IMAGE_HEADER_SIZE], body, length);
+        memcpy(&section, &body[table_offset + sizeof(boot_image_section_table_t)], sizeof(section));
+    }
+    free(body);
+    if (norflash_memory_mapped_state() != 0)
+    {
+        res |= norflash_memory_mapped_exit();
+    }
+    if (res == 0)
+    {
+        res = norflash_write(BENCH_SECTION_ADDRESS, bench_image, BOOT_IMAGE_HEADER_SIZE + length);
+        res |= boot_image_check(BENCH_SECTION_ADDRESS, &header);
+    }
+
+    /* ѹȽ */
+    if (res == 0)
+    {
+        res = norflash_memory_mapped();
+        w25q128_sim_reset_stats();
+        res |= boot_image_load_sections(BENCH_SECTION_ADDRESS, &header);
+        boot_image_get_report(&report);
+        bench_print_row(name, res, report.section_size);
+        printf("  sections: %u, %u -> %u bytes, NOR read %.1f us (stored %.1f us)\n", (unsigned int)report.section_count,
+               (unsigned int)report.section_packed, (unsigned int)report.section_size,
+               w25q128_sim_mmap_read_ns(report.section_packed) / 1000.0, w25q128_sim_mmap_read_ns(report.section_size) / 1000.0);
+        res |= (report.section_count == 2) ? 0 : 1;
+        res |= (memcmp(w25q128_sim_ram(BOOT_IMAGE_AXI_BASE), axi, sizeof(axi)) == 0) ? 0 : 1;
+        res |= (memcmp(w25q128_sim_ram(BENCH_SECTION_ITCM), itcm, sizeof(itcm)) == 0) ? 0 : 1;
+        res |= norflash_memory_mapped_exit();
+    }
+    bench_check(name, res);
+
+    /* ݱд */
+    if (res == 0)
+    {
+        index = BENCH_SECTION_ADDRESS + BOOT_IMAGE_HEADER_SIZE + section.offset + section.packed_size / 2;
+        bench_image[index - BENCH_SECTION_ADDRESS] ^= 0x40;
+        res = norflash_write(index, &bench_image[index - BENCH_SECTION_ADDRESS], 1);
+        res |= norflash_memory_mapped();
+        bench_check("boot_sections_corrupt", (boot_image_load_sections(BENCH_SECTION_ADDRESS, &header) != 0) ? res : 1);
+        res |= norflash_memory_mapped_exit();
+    }
+
+    return res;
+}
+
+/**
+ * @brief   ӡΧ
+ * @param   
+ * @retval  
+ */
+static void bench_print_erase_report(void)
+{
+    norflash_erase_report_t report;
+
+    norflash_get_erase_report(&report);
+    printf("  plan: chip %u, block %u, half %u, sector %u, blank %u, expected %u ms, actual %u ms\n",
+           (unsigned int)report.chip_erases, (unsigned int)report.block_erases, (unsigned int)report.half_block_erases,
+           (unsigned int)report.sector_erases, (unsigned int)report.blank_sectors,
+           (unsigned int)report.expected_time, (unsigned int)report.actual_time);
+}
+
+/**
+ * @brief   ļϵͳ
+ * @param   data: ݻ
+ * @param   offset: ļеƫ
+ * @param   length: ݳ
+ * @param   seed: 
+ * @retval  
+ */
+static void bench_fs_fill(uint8_t *data, uint32_t offset, uint32_t length, uint32_t seed)
+{
+    uint32_t index;
+
+    for (index = 0; index < length; index++)
+    {
+        data[index] = (uint8_t)((offset + index) * 13 + seed + ((offset + index) >> 9));
+    }
+}
+
+/**
+ * @brief   ļݱȽ
+ * @param   name: 
+ * @param   path: ļ
+ * @param   size: ļ
+ * @param   seed: 
+ * @retval  У
+ */
+static uint32_t bench_fs_verify(const char *name, const char *path, uint32_t size, uint32_t seed)
+{
+    norflash_fs_file_t file;
+    norflash_fs_stat_t stat;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t count;
+    uint32_t res;
+
+    res = norflash_fs_stat(path, &stat);
+    res |= (stat.size == size) ? 0 : 1;
+    res |= norflash_fs_open(&file, path, NORFLASH_FS_O_READ);
+    for (offset = 0; (res == 0) && (offset < size); offset += length)
+    {
+        length = ((size - offset) > BENCH_LENGTH) ? BENCH_LENGTH : (size - offset);
+        res |= norflash_fs_read(&file, bench_buffer, BENCH_LENGTH, &count);
+        bench_fs_fill(bench_expect, offset, length, seed);
+        res |= ((count == length) && (memcmp(bench_buffer, bench_expect, length) == 0)) ? 0 : 1;
+    }
+    res |= norflash_fs_close(&file);
+    if (res != 0)
+    {
+        printf("  %s: %s mismatch\n", name, path);
+        bench_failures++;
+    }
+
+    return res;
+}
+
+/**
+ * @brief   ӡļϵͳͳ
+ * @param   
+ * @retval  
+ */
+static void bench_print_fs_stats(void)
+{
+    norflash_fs_stats_t stats;
+    norflash_bd_stats_t bd;
+
+    norflash_fs_get_stats(&stats);
+    norflash_bd_get_stats(&bd);
+    printf("  fs: files %u, free blocks %u, meta free %u, seq %u, commits %u, compactions %u, block erases %u\n",
+           (unsigned int)stats.files, (unsigned int)stats.free_blocks, (unsigned int)stats.meta_free, (unsigned int)stats.sequence,
+           (unsigned int)stats.commits, (unsigned int)stats.compactions, (unsigned int)stats.block_erases);
+    printf("  fs: cache %u hit / %u miss, read-ahead %u hit / %u fill, direct %u; bd: reads %u, progs %u, syncs %u\n",
+           (unsigned int)stats.cache_hits, (unsigned int)stats.cache_misses, (unsigned int)stats.read_ahead_hits,
+           (unsigned int)stats.read_ahead_fills, (unsigned int)stats.direct_reads, (unsigned int)bd.reads, (unsigned int)bd.progs, (unsigned int)bd.syncs);
+}
+
+/**
+ * @brief   ļϵͳ
+ * @note    ļϵͳѹγľصݿڷʱղ
+ *          ͬȵֱӶNOR FlashȽϺʱС˳Ԥٶ
+ * @param   
+ * @retval  
+ */
+static void bench_fs(void)
+{
+    norflash_fs_file_t file;
+    norflash_fs_stat_t stat;
+    w25q128_sim_stats_t stats;
+    char path[NORFLASH_FS_NAME_MAX + 1];
+    uint64_t fs_ns;
+    uint32_t offset;
+    uint32_t index;
+    uint32_t round;
+    uint32_t count;
+    uint32_t cursor;
+    uint32_t free_blocks;
+    uint32_t res;
+    uint8_t found;
+
+    /* ʽ */
+    w25q128_sim_reset_stats();
+    res = norflash_bd_init(NORFLASH_FS_ADDRESS, NORFLASH_FS_SIZE);
+    res |= norflash_fs_format();
+    bench_print_row("fs_format", res, 0);
+    bench_check("fs_format", res);
+    if (res != 0)
+    {
+        return;
+    }
+
+    /* ļ˳д */
+    w25q128_sim_reset_stats();
+    res = norflash_fs_open(&file, "font/large.bin", NORFLASH_FS_O_WRITE);
+    for (offset = 0; offset < BENCH_FS_LARGE_SIZE; offset += BENCH_LENGTH)
+    {
+        bench_fs_fill(bench_buffer, offset, BENCH_LENGTH, 1);
+        res |= norflash_fs_write(&file, bench_buffer, BENCH_LENGTH);
+    }
+    res |= norflash_fs_close(&file);
+    bench_print_row("fs_write_1m", res, BENCH_FS_LARGE_SIZE);
+    bench_check("fs_write_1m", res);
+
+    /* ֱӶNOR FlashȽ */
+    w25q128_sim_reset_stats();
+    res = bench_fs_verify("fs_read_1m", "font/large.bin", BENCH_FS_LARGE_SIZE, 1);
+    w25q128_sim_get_stats(&stats);
+    fs_ns = stats.time_ns;
+    bench_print_row("fs_read_1m", res, BENCH_FS_LARGE_SIZE);
+
+    w25q128_sim_reset_stats();
+    res = 0;
+    for (offset = 0; offset < BENCH_FS_LARGE_SIZE; offset += BENCH_LENGTH)
+    {
+        res |= norflash_read(NORFLASH_FS_ADDRESS + offset, bench_buffer, BENCH_LENGTH);
+    }
+    w25q128_sim_get_stats(&stats);
+    bench_print_row("raw_read_1m", res, BENCH_FS_LARGE_SIZE);
+    printf("  fs read time %.1f%% of raw read\n", (stats.time_ns != 0) ? (fs_ns * 100.0 / stats.time_ns) : 0.0);
+    bench_check("fs_read_overhead", (fs_ns * 100 <= stats.time_ns * 105) ? res : 1);
+
+    /* С˳ */
+    w25q128_sim_reset_stats();
+    res = norflash_fs_open(&file, "font/large.bin", NORFLASH_FS_O_READ);
+    res |= norflash_fs_seek(&file, BENCH_FS_LARGE_SIZE / 2 + 1);
+    for (offset = 0; offset < BENCH_LENGTH; offset += BENCH_FS_SMALL_READ)
+    {
+        res |= norflash_fs_read(&file, bench_buffer, BENCH_FS_SMALL_READ, &count);
+        bench_fs_fill(bench_expect, BENCH_FS_LARGE_SIZE / 2 + 1 + offset, BENCH_FS_SMALL_READ, 1);
+        res |= ((count == BENCH_FS_SMALL_READ) && (memcmp(bench_buffer, bench_expect, BENCH_FS_SMALL_READ) == 0)) ? 0 : 1;
+    }
+    res |= norflash_fs_close(&file);
+    w25q128_sim_get_stats(&stats);
+    bench_print_row("fs_read_256b", res, BENCH_LENGTH);
+    bench_check("fs_read_256b", res);
+    bench_check("fs_read_ahead", (stats.commands <= (BENCH_LENGTH / NORFLASH_FS_READ_AHEAD + 2)) ? 0 : 1);
+
+    /* СļдԪݿ */
+    w25q128_sim_reset_stats();
+    res = 0;
+    for (round = 0; round < BENCH_FS_ROUNDS; round++)
+    {
+        for (index = 0; index < BENCH_FS_FILES; index++)
+        {
+            snprintf(path, sizeof(path), "config/item_%u.bin", (unsigned int)index);
+            bench_fs_fill(bench_buffer, 0, 100 + index, round);
+            res |= norflash_fs_open(&file, path, NORFLASH_FS_O_WRITE);
+            res |= norflash_fs_write(&file, bench_buffer, 100 + index);
+            res |= norflash_fs_close(&file);
+        }
+    }
+    bench_print_row("fs_rewrite_small", res, 0);
+    bench_check("fs_rewrite_small", res);
+
+    /* ־׷ */
+    w25q128_sim_reset_stats();
+    res = 0;
+    for (round = 0; round < BENCH_FS_APPENDS; round++)
+    {
+        bench_fs_fill(bench_buffer, round * BENCH_FS_APPEND_LENGTH, BENCH_FS_APPEND_LENGTH, 3);
+        res |= norflash_fs_open(&file, "log/boot.log", NORFLASH_FS_O_APPEND);
+        res |= norflash_fs_write(&file, bench_buffer, BENCH_FS_APPEND_LENGTH);
+        res |= norflash_fs_close(&file);
+    }
+    bench_print_row("fs_append_300b", res, BENCH_FS_APPENDS * BENCH_FS_APPEND_LENGTH);
+    bench_check("fs_append_300b", res);
+
+    /* ׷дδύģ磩´׷Ӹһ */
+    bench_fs_fill(bench_buffer, 0, BENCH_FS_APPEND_LENGTH, 9);
+    res = norflash_fs_open(&file, "log/boot.log", NORFLASH_FS_O_APPEND);
+    res |= norflash_fs_write(&file, bench_buffer, BENCH_FS_APPEND_LENGTH);
+    res |= norflash_bd_sync();
+    bench_fs_fill(bench_buffer, round * BENCH_FS_APPEND_LENGTH, BENCH_FS_APPEND_LENGTH, 3);
+    res |= norflash_fs_open(&file, "log/boot.log", NORFLASH_FS_O_APPEND);
+    res |= norflash_fs_write(&file, bench_buffer, BENCH_FS_APPEND_LENGTH);
+    res |= norflash_fs_close(&file);
+    bench_check("fs_append_uncommitted", res);
+    bench_print_fs_stats();
+
+    /* ¹غУȫļļ */
+    w25q128_sim_reset_stats();
+    res = norflash_fs_mount();
+    bench_print_row("fs_mount", res, 0);
+    bench_check("fs_mount", res);
+    bench_fs_verify("fs_remount", "font/large.bin", BENCH_FS_LARGE_SIZE, 1);
+    bench_fs_verify("fs_remount", "log/boot.log", (BENCH_FS_APPENDS + 1) * BENCH_FS_APPEND_LENGTH, 3);
+    for (index = 0; index < BENCH_FS_FILES; index++)
+    {
+        snprintf(path, sizeof(path), "config/item_%u.bin", (unsigned int)index);
+        bench_fs_verify("fs_remount", path, 100 + index, BENCH_FS_ROUNDS - 1);
+    }
+
+    cursor = 0;
+    count = 0;
+    offset = 0;
+    do
+    {
+        res = norflash_fs_dir_read(&cursor, &stat, &found);
+        count += found;
+        offset += (found != 0) ? stat.blocks : 0;
+    } while ((res == 0) && (found != 0));
+    norflash_fs_get_stats((norflash_fs_stats_t *)bench_buffer);
+    free_blocks = ((norflash_fs_stats_t *)bench_buffer)->free_blocks;
+    bench_check("fs_dir", ((count == BENCH_FS_FILES + 2) && ((free_blocks + offset + NORFLASH_FS_META_BLOCKS) == NORFLASH_FS_SIZE / norflash_get_sector_size())) ? res : 1);
+
+    /* ɾļп */
+    res = norflash_fs_remove("font/large.bin");
+    norflash_fs_get_stats((norflash_fs_stats_t *)bench_buffer);
+    res |= (((norflash_fs_stats_t *)bench_buffer)->free_blocks == free_blocks + BENCH_FS_LARGE_SIZE / norflash_get_sector_size()) ? 0 : 1;
+    res |= (norflash_fs_stat("font/large.bin", &stat) != 0) ? 0 : 1;
+    bench_check("fs_remove", res);
+
+    /* ӳ䴰еĳļϵͳnorflash_memory_mapped_suspend()/resume()Χڼж */
+    w25q128_sim_reset_stats();
+    res = norflash_memory_mapped();
+    w25q128_sim_set_xip(1);
+    res |= norflash_memory_mapped_suspend(&cursor);
+    bench_fs_fill(bench_buffer, 0, BENCH_FS_APPEND_LENGTH, 5);
+    res |= norflash_fs_open(&file, "log/xip.log", NORFLASH_FS_O_WRITE);
+    res |= norflash_fs_write(&file, bench_buffer, BENCH_FS_APPEND_LENGTH);
+    res |= norflash_fs_close(&file);
+    res |= norflash_fs_open(&file, "log/xip.log", NORFLASH_FS_O_READ);
+    res |= norflash_fs_read(&file, bench_expect, BENCH_FS_APPEND_LENGTH, &count);
+    res |= norflash_fs_close(&file);
+    res |= norflash_fs_remove("log/xip.log");
+    res |= norflash_memory_mapped_resume(cursor);
+    w25q128_sim_set_xip(0);
+    w25q128_sim_get_stats(&stats);
+    res |= ((count == BENCH_FS_APPEND_LENGTH) && (memcmp(bench_buffer, bench_expect, BENCH_FS_APPEND_LENGTH) == 0)) ? 0 : 1;
+    res |= ((norflash_memory_mapped_state() == 0) || (__get_PRIMASK() != 0) || (stats.xip_unmasked != 0)) ? 1 : 0;
+    res |= norflash_memory_mapped_exit();
+    bench_print_row("fs_xip", res, BENCH_FS_APPEND_LENGTH);
+    bench_check("fs_xip", res);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *image = "norflash.img";
+    int keep = 0;
+    int dtr_support = 1;
+    int opt;
+    uint32_t res;
+    uint32_t index;
+    uint32_t profile;
+    uint64_t line_ns;
+    uint64_t slice_ns;
+    char kv_key[NORFLASH_KV_KEY_MAX + 1];
+    uint8_t kv_value[BENCH_SMALL_LENGTH];
+    uint64_t stall_ns;
+    uint8_t *delta_patch = NULL;
+    uint32_t delta_size = 0;
+    uint32_t delta_chunk;
+    boot_delta_progress_t delta_progress;
+    norflash_erase_progress_t progress;
+    w25q128_sim_stats_t stats;
+
+    while ((opt = getopt(argc, argv, "i:t:kjv")) != -1)
+    {
+        switch (opt)
+        {
+            case 'i':
+            {
+                image = optarg;
+                break;
+            }
+            case 't':
+            {
+                w25q128_sim_set_timing((strcmp(optarg, "max") == 0) ? W25Q128_SIM_TIMING_MAX : W25Q128_SIM_TIMING_TYPICAL);
+                break;
+            }
+            case 'k':
+            {
+                keep = 1;
+                break;
+            }
+            case 'j':
+            {
+                dtr_support = 0;
+                break;
+            }
+            case 'v':
+            {
+                w25q128_sim_set_verbose(1);
+                break;
+            }
+            default:
+            {
+                fprintf(stderr, "usage: %s [-i image] [-t typ|max] [-k] [-j] [-v]\n", argv[0]);
+                return 2;
+            }
+        }
+    }
+
+    if (keep == 0)
+    {
+        unlink(image);
+    }
+    if (w25q128_sim_open(image) != 0)
+    {
+        fprintf(stderr, "cannot open %s\n", image);
+        return 2;
+    }
+    w25q128_sim_set_dtr_support(dtr_support);
+
+    for (index = 0; index < BENCH_LENGTH; index++)
+    {
+        bench_expect[index] = (uint8_t)((index * 7) ^ (index >> 8));
+    }
+
+    bench_print_header();
+
+    /* ʼ */
+    w25q128_sim_reset_stats();
+    res = (norflash_init() == NORFlash_W25Q128_Dual) ? 0 : 1;
+    bench_check("init", res);
+    bench_print_row("init", res, 0);
+
+    /* ȷΪգ-kʱоݣ */
+    for (index = 0; index < BENCH_LENGTH; index += norflash_get_sector_size())
+    {
+        norflash_erase_sector(BENCH_BASE + index);
+    }
+
+    /* հ˳д */
+    w25q128_sim_reset_stats();
+    res = norflash_write(BENCH_BASE, bench_expect, BENCH_LENGTH);
+    bench_check("write_blank_64k", res);
+    bench_print_row("write_blank_64k", res, BENCH_LENGTH);
+
+    /* ͬд */
+    w25q128_sim_reset_stats();
+    res = norflash_write(BENCH_BASE, bench_expect, BENCH_LENGTH);
+    bench_check("rewrite_same_64k", res);
+    bench_print_row("rewrite_same_64k", res, BENCH_LENGTH);
+
+    /* Сݸ */
+    for (index = 0; index < BENCH_SMALL_LENGTH; index++)
+    {
+        bench_expect[BENCH_SMALL_OFFSET + index] = (uint8_t)~bench_expect[BENCH_SMALL_OFFSET + index];
+    }
+    w25q128_sim_reset_stats();
+    res = norflash_write(BENCH_BASE + BENCH_SMALL_OFFSET, &bench_expect[BENCH_SMALL_OFFSET], BENCH_SMALL_LENGTH);
+    bench_check("update_16b", res);
+    bench_print_row("update_16b", res, BENCH_SMALL_LENGTH);
+
+    /* Сݸ£ֻλ1Ϊ0 */
+    for (index = 0; index < BENCH_SMALL_LENGTH; index++)
+    {
+        bench_expect[BENCH_SMALL_OFFSET + index] &= 0x5A;
+    }
+    w25q128_sim_reset_stats();
+    res = norflash_write(BENCH_BASE + BENCH_SMALL_OFFSET, &bench_expect[BENCH_SMALL_OFFSET], BENCH_SMALL_LENGTH);
+    bench_check("update_clear_16b", res);
+    bench_print_row("update_clear_16b", res, BENCH_SMALL_LENGTH);
+
+    /* Ӷ */
+    memset(bench_buffer, 0, sizeof(bench_buffer));
+    w25q128_sim_reset_stats();
+    res = norflash_read(BENCH_BASE, bench_buffer, BENCH_LENGTH);
+    bench_check("read_indirect_64k", res);
+    bench_print_row("read_indirect_64k", res, BENCH_LENGTH);
+    bench_verify("read_indirect_64k", bench_buffer, BENCH_LENGTH);
+
+    /*  */
+    w25q128_sim_reset_stats();
+    res = norflash_erase_sector(BENCH_BASE + BENCH_LENGTH);
+    bench_check("erase_sector", res);
+    bench_print_row("erase_sector", res, norflash_get_sector_size());
+
+    /*  */
+    w25q128_sim_reset_stats();
+    res = norflash_erase_block(BENCH_BASE + 2 * BENCH_LENGTH);
+    bench_check("erase_block", res);
+    bench_print_row("erase_block", res, norflash_get_block_size());
+
+    /* 첽첽д */
+    w25q128_sim_reset_stats();
+    res = norflash_erase_async(BENCH_BASE + 4 * BENCH_LENGTH, 2 * BENCH_LENGTH, bench_async_callback, NULL);
+    res |= norflash_write_async(BENCH_BASE + 4 * BENCH_LENGTH, bench_expect, BENCH_LENGTH, bench_async_callback, NULL);
+    index = bench_async_wait();
+    res |= ((bench_async_done == 2) && (bench_async_failed == 0)) ? 0 : 1;
+    bench_check("async_erase_write_64k", res);
+    bench_print_row("async_erase_write_64k", res, BENCH_LENGTH);
+    printf("  async: %u interrupts, %u callbacks\n", (unsigned int)index, (unsigned int)bench_async_done);
+    memset(bench_buffer, 0, sizeof(bench_buffer));
+    res = norflash_read(BENCH_BASE + 4 * BENCH_LENGTH, bench_buffer, BENCH_LENGTH);
+    bench_check("async_read_64k", res);
+    bench_verify("async_read_64k", bench_buffer, BENCH_LENGTH);
+
+    /* 4MB */
+    res = bench_dirty_range(BENCH_RANGE_BASE, BENCH_RANGE_LENGTH);
+    w25q128_sim_reset_stats();
+    for (index = 0; index < BENCH_RANGE_LENGTH; index += norflash_get_sector_size())
+    {
+        res |= norflash_erase_sector(BENCH_RANGE_BASE + index);
+    }
+    bench_check("erase_4m_sectors", res);
+    bench_print_row("erase_4m_sectors", res, BENCH_RANGE_LENGTH);
+
+    /* Χ4MB */
+    res = bench_dirty_range(BENCH_RANGE_BASE, BENCH_RANGE_LENGTH);
+    w25q128_sim_reset_stats();
+    res |= norflash_erase_range(BENCH_RANGE_BASE, BENCH_RANGE_LENGTH);
+    bench_check("erase_range_4m", res);
+    bench_print_row("erase_range_4m", res, BENCH_RANGE_LENGTH);
+    bench_print_erase_report();
+
+    /* ΧΪյ4MB */
+    w25q128_sim_reset_stats();
+    res = norflash_erase_range(BENCH_RANGE_BASE, BENCH_RANGE_LENGTH);
+    bench_check("erase_range_4m_blank", res);
+    bench_print_row("erase_range_4m_blank", res, BENCH_RANGE_LENGTH);
+    bench_print_erase_report();
+
+    /* ΧǿҲΪյ */
+    res = bench_dirty_range(BENCH_RANGE_BASE + 3 * norflash_get_sector_size(), 12 * norflash_get_sector_size());
+    res |= bench_dirty_range(BENCH_RANGE_BASE + norflash_get_block_size() + 5 * norflash_get_sector_size(), 2 * norflash_get_sector_size());
+    w25q128_sim_reset_stats();
+    res |= norflash_erase_range(BENCH_RANGE_BASE + norflash_get_sector_size(), 2 * norflash_get_block_size() - 2 * norflash_get_sector_size());
+    bench_check("erase_range_partial", res);
+    bench_print_row("erase_range_partial", res, 2 * norflash_get_block_size());
+    bench_print_erase_report();
+    memset(bench_buffer, 0, sizeof(bench_buffer));
+    res = norflash_read(BENCH_RANGE_BASE, bench_buffer, BENCH_LENGTH);
+    bench_check("erase_range_read", res);
+    for (index = 0; index < BENCH_LENGTH; index++)
+    {
+        if (bench_buffer[index] != norflash_get_empty_value())
+        {
+            printf("  erase_range_read: not blank at 0x%08X\n", (unsigned int)(BENCH_RANGE_BASE + index));
+            bench_failures++;
+            break;
+        }
+    }
+
+    /* Сݸ4ֱд */
+    w25q128_sim_reset_stats();
+    res = bench_interleave(0);
+    bench_check("interleave_direct", res);
+    bench_print_row("interleave_direct", res, 4 * BENCH_INTERLEAVE_ROUNDS * BENCH_SMALL_LENGTH);
+
+    /* Сݸ4дػ棩 */
+    w25q128_sim_reset_stats();
+    res = bench_interleave(1);
+    res |= norflash_sync();
+    bench_check("interleave_cached", res);
+    bench_print_row("interleave_cached", res, 4 * BENCH_INTERLEAVE_ROUNDS * BENCH_SMALL_LENGTH);
+    w25q128_sim_reset_stats();
+    res = norflash_cache_read(BENCH_BASE, bench_buffer, BENCH_LENGTH);
+    bench_check("cache_read_64k", res);
+    bench_print_row("cache_read_64k", res, BENCH_LENGTH);
+    bench_verify("cache_read_64k", bench_buffer, BENCH_LENGTH);
+    res = norflash_cache_invalidate();
+    res |= norflash_read(BENCH_BASE, bench_buffer, BENCH_LENGTH);
+    bench_check("cache_sync_read_64k", res);
+    bench_verify("cache_sync_read_64k", bench_buffer, BENCH_LENGTH);
+
+    /* ڴӳ䲢У */
+    w25q128_sim_reset_stats();
+    res = norflash_memory_mapped();
+    bench_check("mmap_enter", res);
+    bench_print_row("mmap_enter", res, 0);
+    memset(bench_buffer, 0, sizeof(bench_buffer));
+    res = norflash_read(BENCH_BASE, bench_buffer, BENCH_LENGTH);
+    bench_check("read_mmap_64k", res);
+    bench_verify("read_mmap_64k", bench_buffer, BENCH_LENGTH);
+
+    /* ڴӳģʽл */
+    w25q128_sim_reset_stats();
+    res = norflash_memory_mapped_exit();
+    res |= norflash_memory_mapped();
+    bench_check("mmap_switch", res);
+    bench_print_row("mmap_switch", res, 0);
+
+    /* ڴӳСݸ£˳ӳ䡢дӳ䣩 */
+    for (index = 0; index < BENCH_SMALL_LENGTH; index++)
+    {
+        bench_expect[BENCH_SMALL_OFFSET + index] = (uint8_t)~bench_expect[BENCH_SMALL_OFFSET + index];
+    }
+    w25q128_sim_reset_stats();
+    res = norflash_ex_write(BENCH_BASE + BENCH_SMALL_OFFSET, &bench_expect[BENCH_SMALL_OFFSET], BENCH_SMALL_LENGTH);
+    bench_check("ex_update_16b", res);
+    bench_print_row("ex_update_16b", res, BENCH_SMALL_LENGTH);
+    memset(bench_buffer, 0, sizeof(bench_buffer));
+    res = norflash_ex_read(BENCH_BASE, bench_buffer, BENCH_LENGTH);
+    bench_check("ex_read_64k", res);
+    bench_verify("ex_read_64k", bench_buffer, BENCH_LENGTH);
+
+    /* ãУ׼УڴӳأͳһCacheʱ */
+    for (profile = NORFlash_Read_Normal; profile < NORFlash_Read_Dummy; profile++)
+    {
+        w25q128_sim_reset_stats();
+        res = norflash_set_read_profile((norflash_read_profile_t)profile);
+        if ((profile == NORFlash_Read_XIP_DTR) && (dtr_support == 0))
+        {
+            /* ֧DTRʱӦУʧܲ˵Ĭ϶ */
+            bench_check(bench_profile_name[profile], ((res != 0) && (norflash_get_read_profile() == NORFlash_Read_Normal)) ? 0 : 1);
+        }
+        else
+        {
+            bench_check(bench_profile_name[profile], res);
+        }
+        bench_print_row(bench_profile_name[profile], res, 0);
+        if (res != 0)
+        {
+            continue;
+        }
+
+        res = norflash_memory_mapped();
+        memset(bench_buffer, 0, sizeof(bench_buffer));
+        res |= norflash_read(BENCH_BASE, bench_buffer, BENCH_LENGTH);
+        bench_check(bench_profile_name[profile], res);
+        bench_verify(bench_profile_name[profile], bench_buffer, BENCH_LENGTH);
+        line_ns = w25q128_sim_mmap_read_ns(BENCH_CACHE_LINE);
+        printf("  %u B line fill: %llu ns, %.1f MB/s\n", BENCH_CACHE_LINE, (unsigned long long)line_ns,
+               (line_ns != 0) ? (BENCH_CACHE_LINE * 1000.0) / line_ns : 0.0);
+    }
+
+    /* ģʽСݸ£˳ӳ븴λģʽ */
+    for (index = 0; index < BENCH_SMALL_LENGTH; index++)
+    {
+        bench_expect[BENCH_SMALL_OFFSET + index] = (uint8_t)~bench_expect[BENCH_SMALL_OFFSET + index];
+    }
+    w25q128_sim_reset_stats();
+    res = norflash_set_read_profile(NORFlash_Read_XIP);
+    res |= norflash_ex_write(BENCH_BASE + BENCH_SMALL_OFFSET, &bench_expect[BENCH_SMALL_OFFSET], BENCH_SMALL_LENGTH);
+    bench_check("xip_update_16b", res);
+    bench_print_row("xip_update_16b", res, BENCH_SMALL_LENGTH);
+    memset(bench_buffer, 0, sizeof(bench_buffer));
+    res = norflash_ex_read(BENCH_BASE, bench_buffer, BENCH_LENGTH);
+    res |= norflash_set_read_profile(NORFlash_Read_Normal);
+    bench_check("xip_read_64k", res);
+    bench_verify("xip_read_64k", bench_buffer, BENCH_LENGTH);
+
+    /* ̨ÿʱƬڴӳУ飬ͳͣ٣ӳ䴰УʱƬж */
+    res = norflash_memory_mapped_exit();
+    res |= bench_dirty_range(BENCH_RANGE_BASE, 2 * norflash_get_block_size() + 2 * norflash_get_sector_size());
+    res |= norflash_memory_mapped();
+    w25q128_sim_reset_stats();
+    res |= norflash_erase_background(BENCH_RANGE_BASE, 2 * norflash_get_block_size() + 2 * norflash_get_sector_size());
+    w25q128_sim_set_xip(1);
+    stall_ns = 0;
+    while ((res == 0) && (norflash_erase_background_busy() != 0))
+    {
+        slice_ns = w25q128_sim_now_ns();
+        res |= norflash_erase_background_run(BENCH_ERASE_SLICE);
+        slice_ns = w25q128_sim_now_ns() - slice_ns;
+        if (slice_ns > stall_ns)
+        {
+            stall_ns = slice_ns;
+        }
+
+        memset(bench_buffer, 0, norflash_get_sector_size());
+        res |= norflash_read(BENCH_BASE, bench_buffer, norflash_get_sector_size());
+        bench_verify("erase_background_read", bench_buffer, norflash_get_sector_size());
+        res |= ((norflash_memory_mapped_state() == 0) || (__get_PRIMASK() != 0)) ? 1 : 0;
+    }
+    w25q128_sim_set_xip(0);
+    w25q128_sim_get_stats(&stats);
+    res |= (stats.xip_unmasked != 0) ? 1 : 0;
+    bench_check("erase_background_272k", res);
+    bench_print_row("erase_background_272k", res, 2 * norflash_get_block_size() + 2 * norflash_get_sector_size());
+    norflash_erase_background_get_progress(&progress);
+    printf("  slices %u, suspends %u, skipped %u, error %u, longest stall %.3f ms (blocking block erase %u ms)\n",
+           (unsigned int)progress.slices, (unsigned int)progress.suspends, (unsigned int)progress.skipped,
+           (unsigned int)progress.error, stall_ns / 1000000.0, (unsigned int)norflash_w25q128_dual.parameter.block_erase_time);
+    bench_check("erase_background_272k", ((progress.error == 0) && (progress.done == progress.total)) ? 0 : 1);
+    res = norflash_read(BENCH_RANGE_BASE, bench_buffer, BENCH_LENGTH);
+    bench_check("erase_background_blank", res);
+    for (index = 0; index < BENCH_LENGTH; index++)
+    {
+        if (bench_buffer[index] != 0xFF)
+        {
+            printf("  erase_background_blank: not blank at 0x%08X\n", (unsigned int)(BENCH_RANGE_BASE + index));
+            bench_failures++;
+            break;
+        }
+    }
+
+    /* ֵ洢׷Ӹֻҳ̣Աupdate_16bд */
+    res = norflash_memory_mapped_exit();
+    w25q128_sim_reset_stats();
+    res |= norflash_kv_mount();
+    bench_check("kv_mount_blank", res);
+    bench_print_row("kv_mount_blank", res, 0);
+
+    w25q128_sim_reset_stats();
+    for (index = 0; index < BENCH_KV_KEYS; index++)
+    {
+        bench_kv_item(kv_key, kv_value, index, 0);
+        res |= norflash_kv_set(kv_key, kv_value, BENCH_SMALL_LENGTH);
+    }
+    bench_check("kv_set_16b", res);
+    bench_print_row("kv_set_16b", res, BENCH_KV_KEYS * BENCH_SMALL_LENGTH);
+
+    w25q128_sim_reset_stats();
+    for (index = 0; index < BENCH_KV_KEYS; index++)
+    {
+        bench_kv_item(kv_key, kv_value, index, 0);
+        res |= norflash_kv_set(kv_key, kv_value, BENCH_SMALL_LENGTH);
+    }
+    bench_check("kv_set_same_16b", res);
+    bench_print_row("kv_set_same_16b", res, BENCH_KV_KEYS * BENCH_SMALL_LENGTH);
+
+    /* ´ */
+    w25q128_sim_reset_stats();
+    for (profile = 1; profile <= BENCH_KV_ROUNDS; profile++)
+    {
+        for (index = 0; index < BENCH_KV_KEYS; index++)
+        {
+            bench_kv_item(kv_key, kv_value, index, profile);
+            res |= norflash_kv_set(kv_key, kv_value, BENCH_SMALL_LENGTH);
+        }
+    }
+    bench_check("kv_update_16b", res);
+    bench_print_row("kv_update_16b", res, BENCH_KV_ROUNDS * BENCH_KV_KEYS * BENCH_SMALL_LENGTH);
+    bench_print_kv_stats();
+
+    /* ɾһ¹أģ⸴λУطŽ */
+    bench_kv_item(kv_key, kv_value, BENCH_KV_KEYS, 0);
+    res = norflash_kv_set(kv_key, kv_value, BENCH_SMALL_LENGTH);
+    res |= norflash_kv_delete(kv_key);
+    w25q128_sim_reset_stats();
+    res |= norflash_kv_mount();
+    bench_check("kv_remount", res);
+    bench_print_row("kv_remount", res, 0);
+    bench_kv_verify("kv_remount", BENCH_KV_ROUNDS);
+    bench_check("kv_deleted", (norflash_kv_get(kv_key, kv_value, sizeof(kv_value), NULL) != 0) ? 0 : 1);
+    bench_print_kv_stats();
+
+    w25q128_sim_reset_stats();
+    for (index = 0; index < BENCH_KV_KEYS; index++)
+    {
+        bench_kv_item(kv_key, kv_value, index, 0);
+        res |= norflash_kv_get(kv_key, kv_value, sizeof(kv_value), NULL);
+    }
+    bench_check("kv_get_16b", res);
+    bench_print_row("kv_get_16b", res, BENCH_KV_KEYS * BENCH_SMALL_LENGTH);
+
+    /* ӦóУ飺״㣬֮Уǣ»򱻸д¼ */
+    w25q128_sim_reset_stats();
+    res = bench_image_write(1);
+    bench_check("boot_image_write", res);
+    bench_print_row("boot_image_write", res, sizeof(bench_image));
+    bench_image_check("boot_image_full", 1, 0);
+    bench_image_check("boot_image_cached", 1, 1);
+
+    res = norflash_kv_mount();
+    bench_check("boot_image_remount", res);
+    bench_image_check("boot_image_remount", 1, 1);
+
+    bench_image[BOOT_IMAGE_HEADER_SIZE + BENCH_IMAGE_SIZE / 2] ^= 0x01;
+    res = boot_image_invalidate(BENCH_IMAGE_ADDRESS);
+    res |= norflash_write(BENCH_IMAGE_ADDRESS + BOOT_IMAGE_HEADER_SIZE + BENCH_IMAGE_SIZE / 2, &bench_image[BOOT_IMAGE_HEADER_SIZE + BENCH_IMAGE_SIZE / 2], 2);
+    bench_check("boot_image_corrupt", res);
+    bench_image_check("boot_image_corrupt", 0, 0);
+
+    res = boot_image_invalidate(BENCH_IMAGE_ADDRESS);
+    res |= bench_image_write(2);
+    bench_check("boot_image_update", res);
+    bench_image_check("boot_image_update", 1, 0);
+    bench_image_check("boot_image_update_cached", 1, 1);
+
+    /* A/B˫ۣ¾дBУδȷعAȷϺ󱣳֣ȷϲдֵ洢 */
+    bench_slot_boot("slot_boot_a", BOOT_SLOT_A, 2);
+    res = bench_slot_install("slot_update_b", BOOT_SLOT_B_ADDRESS, 3, 2);
+    bench_check("slot_update_b", res);
+    bench_slot_boot("slot_trial_1", BOOT_SLOT_B, 3);
+    bench_slot_boot("slot_trial_2", BOOT_SLOT_B, 3);
+    bench_slot_boot("slot_rollback", BOOT_SLOT_A, 2);
+    bench_slot_boot("slot_rollback_2", BOOT_SLOT_A, 2);
+
+    res = bench_slot_install("slot_update_b_2", BOOT_SLOT_B_ADDRESS, 4, 0);
+    bench_check("slot_update_b_2", res);
+    bench_slot_boot("slot_trial", BOOT_SLOT_B, 4);
+    res = boot_slot_confirm();
+    bench_check("slot_confirm", res);
+    bench_slot_boot("slot_confirmed", BOOT_SLOT_B, 4);
+    bench_slot_boot("slot_confirmed_2", BOOT_SLOT_B, 4);
+
+    /* BӵľдAУʧ */
+    res = bench_slot_install("slot_wrong_link", BOOT_SLOT_B_ADDRESS, 5, 0);
+    bench_check("slot_wrong_link", (res != 0) ? 0 : 1);
+    bench_slot_boot("slot_wrong_link_boot", BOOT_SLOT_B, 4);
+
+    /* δȷʱдΪعĿĲ */
+    res = bench_slot_install("slot_update_a", BOOT_SLOT_A_ADDRESS, 5, 0);
+    bench_check("slot_update_a", res);
+    bench_slot_boot("slot_trial_a", BOOT_SLOT_A, 5);
+    bench_check("slot_update_unconfirmed", (boot_slot_update_begin(sizeof(bench_image)) != 0) ? 0 : 1);
+    res = boot_slot_confirm();
+    bench_check("slot_confirm_a", res);
+    bench_slot_boot("slot_confirmed_a", BOOT_SLOT_A, 5);
+
+    /* £ɲAv5벹ڲBv6;ֹ¹ؼֵ洢ӽȼ¼ */
+    w25q128_sim_reset_stats();
+    res = bench_delta_build(&delta_patch, &delta_size);
+    bench_check("delta_diff", res);
+    bench_check("delta_diff_size", ((res == 0) && ((delta_size * 20) < sizeof(bench_image))) ? 0 : 1);
+
+    if (res == 0)
+    {
+        res = bench_delta_apply("delta_interrupt", delta_patch, delta_size, sizeof(bench_image) / 2, 0);
+        bench_check("delta_interrupt", res);
+        res = norflash_kv_mount();
+        res |= bench_delta_apply("delta_resume", delta_patch, delta_size, 0, 0);
+        bench_check("delta_resume", res);
+        boot_delta_get_progress(&delta_progress);
+        bench_check("delta_resumed", (delta_progress.resumed != 0) ? 0 : 1);
+        /* ¾ɵľֽڱȽϣֶζ */
+        res = 0;
+        for (index = 0; index < sizeof(bench_image); index += delta_chunk)
+        {
+            delta_chunk = sizeof(bench_image) - index;
+            delta_chunk = (delta_chunk > BENCH_LENGTH) ? BENCH_LENGTH : delta_chunk;
+            res |= norflash_read(BOOT_SLOT_B_ADDRESS + index, bench_buffer, delta_chunk);
+            res |= (memcmp(bench_buffer, &bench_image[index], delta_chunk) == 0) ? 0 : 1;
+        }
+        bench_check("delta_output", res);
+        bench_slot_boot("delta_trial", BOOT_SLOT_B, 6);
+        res = boot_slot_confirm();
+        bench_check("delta_confirm", res);
+        bench_slot_boot("delta_confirmed", BOOT_SLOT_B, 6);
+
+        /* ֻӦʱľɾеǲBv6 */
+        res = bench_delta_apply("delta_wrong_old", delta_patch, delta_size, 0, 0);
+        bench_check("delta_wrong_old", (res != 0) ? 0 : 1);
+        bench_slot_boot("delta_wrong_old_boot", BOOT_SLOT_B, 6);
+    }
+    free(delta_patch);
+
+    /* ѹΣתǰѹAXI SRAMITCM */
+    bench_sections("boot_sections");
+
+    /* ļϵͳ豸֮ϵԴļ */
+    bench_fs();
+
+    printf("max sector erase count: %u\n", (unsigned int)w25q128_sim_max_erase_count());
+    printf("%s\n", (bench_failures == 0) ? "PASS" : "FAIL");
+
+    w25q128_sim_close();
+
+    return (bench_failures == 0) ? 0 : 1;
+}
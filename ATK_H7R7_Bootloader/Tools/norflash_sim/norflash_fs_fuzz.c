@@ -0,0 +1,385 @@
+/**
+ ****************************************************************************************************
+ * @file        norflash_fs_fuzz.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       NOR Flashļϵͳģ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ڷ϶BSP/norflash_fs.cִид׷ӡɾÿβǰһ/е磬
+ * ģϵ硢³ʼأڴеģͱȽϣжϵļΪǰݣ
+ * ļ벻䣬пļռõĿһ£޿й©Уʧʱط0
+ *
+ * ÷: norflash_fs_fuzz [-i ļ] [-n ] [-s ]
+ *
+ ****************************************************************************************************
+ */
+
+#include "norflash_w25q128.h"
+#include "norflash_bd.h"
+#include "norflash_fs.h"
+#include "w25q128_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Բ */
+#define FUZZ_FILES              (8U)
+#define FUZZ_FILE_MAX           (0x00006000UL)
+#define FUZZ_APPEND_MAX         (0x00000C00UL)
+#define FUZZ_CUT_RANGE          (48U)
+#define FUZZ_CHUNK              (0x00000700UL)
+
+/* ļģͶ */
+typedef struct {
+    uint8_t exist;
+    uint32_t size;
+    uint8_t data[FUZZ_FILE_MAX];
+} fuzz_file_t;
+
+static fuzz_file_t fuzz_model[FUZZ_FILES];
+static fuzz_file_t fuzz_next;
+static fuzz_file_t fuzz_readback;
+static uint32_t fuzz_seed = 1;
+
+/**
+ * @brief   CubeMX
+ * @param   
+ * @retval  
+ */
+void Error_Handler(void)
+{
+    fprintf(stderr, "Error_Handler\n");
+    exit(2);
+}
+
+/**
+ * @brief   α
+ * @param   range: Χ
+ * @retval  0 ~ range-1
+ */
+static uint32_t fuzz_random(uint32_t range)
+{
+    fuzz_seed = fuzz_seed * 1103515245UL + 12345UL;
+
+    return (fuzz_seed >> 8) % range;
+}
+
+/**
+ * @brief   ȡļ
+ * @param   index: ļ
+ * @retval  ļ
+ */
+static const char *fuzz_name(uint32_t index)
+{
+    static char name[NORFLASH_FS_NAME_MAX + 1];
+
+    snprintf(name, sizeof(name), "res/file_%u.bin", (unsigned int)index);
+
+    return name;
+}
+
+/**
+ * @brief   ģϵ粢
+ * @param   
+ * @retval  0: ɹ; 1: ʧ
+ */
+static int fuzz_reboot(void)
+{
+    w25q128_sim_power_restore();
+    if (norflash_init() != NORFlash_W25Q128_Dual)
+    {
+        return 1;
+    }
+    if (norflash_bd_init(NORFLASH_FS_ADDRESS, NORFLASH_FS_SIZE) != 0)
+    {
+        return 1;
+    }
+
+    return norflash_fs_mount();
+}
+
+/**
+ * @brief   ļ
+ * @param   index: ļ
+ * @param   file: ļexistΪ0ʾڣ
+ * @retval  0: ɹ; 1: ʧ
+ */
+static int fuzz_read(uint32_t index, fuzz_file_t *file)
+{
+    norflash_fs_stat_t stat;
+    norflash_fs_file_t handle;
+    uint32_t count;
+
+    file->exist = 0;
+    file->size = 0;
+    if (norflash_fs_stat(fuzz_name(index), &stat) != 0)
+    {
+        return 0;
+    }
+    if ((stat.size > FUZZ_FILE_MAX) || (norflash_fs_open(&handle, fuzz_name(index), NORFLASH_FS_O_READ) != 0))
+    {
+        return 1;
+    }
+
+    /* ȷִζԤֱӶ */
+    while (file->size < stat.size)
+    {
+        if ((norflash_fs_read(&handle, &file->data[file->size], 1 + fuzz_random(FUZZ_CHUNK * 2), &count) != 0) || (count == 0))
+        {
+            return 1;
+        }
+        file->size += count;
+    }
+    file->exist = 1;
+
+    return norflash_fs_close(&handle);
+}
+
+/**
+ * @brief   Ƚļ
+ * @param   a: ļa
+ * @param   b: ļb
+ * @retval  1: ͬ; 0: ͬ
+ */
+static int fuzz_equal(const fuzz_file_t *a, const fuzz_file_t *b)
+{
+    if (a->exist != b->exist)
+    {
+        return 0;
+    }
+
+    return (a->exist == 0) || ((a->size == b->size) && (memcmp(a->data, b->data, a->size) == 0));
+}
+
+/**
+ * @brief   ļռһ
+ * @param   
+ * @retval  0: һ; 1: һ
+ */
+static int fuzz_check_blocks(void)
+{
+    norflash_bd_geometry_t geometry;
+    norflash_fs_stats_t stats;
+    norflash_fs_stat_t stat;
+    uint32_t cursor = 0;
+    uint32_t blocks = 0;
+    uint32_t files = 0;
+    uint8_t found;
+
+    do
+    {
+        if (norflash_fs_dir_read(&cursor, &stat, &found) != 0)
+        {
+            return 1;
+        }
+        if (found != 0)
+        {
+            blocks += stat.blocks;
+            files++;
+        }
+    } while (found != 0);
+
+    norflash_bd_get_geometry(&geometry);
+    norflash_fs_get_stats(&stats);
+
+    return ((stats.files == files) && (stats.free_blocks + blocks + NORFLASH_FS_META_BLOCKS == geometry.block_count)) ? 0 : 1;
+}
+
+/**
+ * @brief   ִһ
+ * @param   index: ļ
+ * @param   op: 0: д; 1: ׷; 2: ɾ
+ * @retval  ļϵͳֵ
+ */
+static uint8_t fuzz_apply(uint32_t index, uint32_t op)
+{
+    norflash_fs_file_t handle;
+    uint32_t length;
+    uint32_t offset;
+    uint32_t chunk;
+    uint8_t res;
+
+    fuzz_next = fuzz_model[index];
+    if (op == 2)
+    {
+        fuzz_next.exist = 0;
+        fuzz_next.size = 0;
+        return norflash_fs_remove(fuzz_name(index));
+    }
+
+    if (op == 0)
+    {
+        fuzz_next.size = 0;
+        length = fuzz_random(FUZZ_FILE_MAX + 1);
+    }
+    else
+    {
+        length = 1 + fuzz_random(FUZZ_APPEND_MAX);
+        if ((fuzz_next.size + length) > FUZZ_FILE_MAX)
+        {
+            length = FUZZ_FILE_MAX - fuzz_next.size;
+        }
+    }
+    for (offset = 0; offset < length; offset++)
+    {
+        fuzz_next.data[fuzz_next.size + offset] = (uint8_t)fuzz_random(256);
+    }
+    fuzz_next.exist = 1;
+
+    res = norflash_fs_open(&handle, fuzz_name(index), (op == 0) ? NORFLASH_FS_O_WRITE : NORFLASH_FS_O_APPEND);
+    for (offset = 0; (res == 0) && (offset < length); offset += chunk)
+    {
+        chunk = 1 + fuzz_random(FUZZ_CHUNK);
+        if (chunk > (length - offset))
+        {
+            chunk = length - offset;
+        }
+        res = norflash_fs_write(&handle, &fuzz_next.data[fuzz_next.size + offset], chunk);
+    }
+    fuzz_next.size += length;
+    if (res == 0)
+    {
+        res = norflash_fs_close(&handle);
+    }
+
+    return res;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *image = "norflash_fs_fuzz.img";
+    norflash_fs_stats_t stats;
+    uint32_t iterations = 2000;
+    uint32_t iteration;
+    uint32_t index;
+    uint32_t op;
+    uint32_t cuts = 0;
+    uint32_t kept_old = 0;
+    uint32_t compactions = 0;
+    int lost;
+    int failures = 0;
+    int opt;
+    uint8_t res;
+
+    while ((opt = getopt(argc, argv, "i:n:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'i':
+            {
+                image = optarg;
+                break;
+            }
+            case 'n':
+            {
+                iterations = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            }
+            case 's':
+            {
+                fuzz_seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            }
+            default:
+            {
+                fprintf(stderr, "usage: %s [-i image] [-n iterations] [-s seed]\n", argv[0]);
+                return 2;
+            }
+        }
+    }
+
+    unlink(image);
+    if (w25q128_sim_open(image) != 0)
+    {
+        fprintf(stderr, "cannot open %s\n", image);
+        return 2;
+    }
+
+    if ((norflash_init() != NORFlash_W25Q128_Dual) || (norflash_bd_init(NORFLASH_FS_ADDRESS, NORFLASH_FS_SIZE) != 0) || (norflash_fs_format() != 0))
+    {
+        fprintf(stderr, "format failed\n");
+        w25q128_sim_close();
+        return 2;
+    }
+    memset(fuzz_model, 0, sizeof(fuzz_model));
+
+    for (iteration = 0; (iteration < iterations) && (failures == 0); iteration++)
+    {
+        index = fuzz_random(FUZZ_FILES);
+        op = fuzz_random(4);
+        op = (op == 3) ? ((fuzz_model[index].exist != 0) ? 2 : 0) : (op & 1);
+
+        w25q128_sim_set_power_cut(fuzz_random(FUZZ_CUT_RANGE), fuzz_seed);
+        res = fuzz_apply(index, op);
+        lost = w25q128_sim_power_lost();
+        if (lost != 0)
+        {
+            cuts++;
+        }
+        else if (res != 0)
+        {
+            printf("iteration %u: op %u on %s returned %u\n", (unsigned int)iteration, (unsigned int)op, fuzz_name(index), res);
+            failures++;
+            break;
+        }
+
+        /* ۼʱͳ㣩 */
+        norflash_fs_get_stats(&stats);
+        compactions += stats.compactions;
+
+        if (fuzz_reboot() != 0)
+        {
+            printf("iteration %u: mount failed\n", (unsigned int)iteration);
+            failures++;
+            break;
+        }
+
+        /* жϵļΪǰݣļ */
+        for (op = 0; op < FUZZ_FILES; op++)
+        {
+            if (fuzz_read(op, &fuzz_readback) != 0)
+            {
+                printf("iteration %u: %s read failed\n", (unsigned int)iteration, fuzz_name(op));
+                failures++;
+                break;
+            }
+
+            if ((op == index) && (fuzz_equal(&fuzz_readback, &fuzz_next) != 0))
+            {
+                fuzz_model[index] = fuzz_next;
+            }
+            else if ((op == index) && (lost != 0) && (fuzz_equal(&fuzz_readback, &fuzz_model[index]) != 0))
+            {
+                kept_old++;
+            }
+            else if ((op == index) || (fuzz_equal(&fuzz_readback, &fuzz_model[op]) == 0))
+            {
+                printf("iteration %u: %s mismatch (exist %u, size %u, expect %u)\n", (unsigned int)iteration, fuzz_name(op),
+                       fuzz_readback.exist, (unsigned int)fuzz_readback.size, (unsigned int)fuzz_model[op].size);
+                failures++;
+                break;
+            }
+        }
+
+        /* غĿпļռһ */
+        if ((failures == 0) && (fuzz_check_blocks() != 0))
+        {
+            printf("iteration %u: block accounting mismatch\n", (unsigned int)iteration);
+            failures++;
+        }
+    }
+
+    norflash_fs_get_stats(&stats);
+    printf("iterations %u, power cuts %u (kept old %u), compactions %u, sequence %u, files %u, free blocks %u, max sector erase count %u\n",
+           (unsigned int)iteration, (unsigned int)cuts, (unsigned int)kept_old, (unsigned int)compactions, (unsigned int)stats.sequence,
+           (unsigned int)stats.files, (unsigned int)stats.free_blocks, (unsigned int)w25q128_sim_max_erase_count());
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+
+    w25q128_sim_close();
+    unlink(image);
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,348 @@
+/**
+ ****************************************************************************************************
+ * @file        stm32h7rsxx_hal_sim.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       HALXSPIӼ
+ ****************************************************************************************************
+ * @attention
+ *
+ * NOR Flashõ͡ͺԱHALⱣһ£
+ * ȡֵΪڲ룬ӲĴλ޹
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __STM32H7RSXX_HAL_SIM_H
+#define __STM32H7RSXX_HAL_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __IO volatile
+
+/* Ĵλ */
+#define MODIFY_REG(REG, CLEARMASK, SETMASK) ((REG) = (((REG) & (~(CLEARMASK))) | (SETMASK)))
+
+/* HAL״̬ */
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U,
+} HAL_StatusTypeDef;
+
+/* XSPI趨 */
+typedef struct {
+    __IO uint32_t TCR;
+} XSPI_TypeDef;
+
+/* XSPI_TCRĴλ */
+#define XSPI_TCR_SSHIFT                     (0x40000000U)
+#define XSPI_TCR_DHQC                       (0x10000000U)
+
+extern XSPI_TypeDef xspi1_sim_instance;
+#define XSPI1                               (&xspi1_sim_instance)
+
+/* XSPI1ڴӳַ壨ָӳ䴰ڣ */
+extern uint8_t *w25q128_sim_window;
+#define XSPI1_BASE                          ((uintptr_t)w25q128_sim_window)
+
+/* XSPIʼ */
+typedef struct {
+    uint32_t FifoThresholdByte;
+    uint32_t MemoryMode;
+    uint32_t MemoryType;
+    uint32_t MemorySize;
+    uint32_t ChipSelectHighTimeCycle;
+    uint32_t FreeRunningClock;
+    uint32_t ClockMode;
+    uint32_t WrapSize;
+    uint32_t ClockPrescaler;
+    uint32_t SampleShifting;
+    uint32_t DelayHoldQuarterCycle;
+    uint32_t ChipSelectBoundary;
+    uint32_t MaxTran;
+    uint32_t Refresh;
+    uint32_t MemorySelect;
+} XSPI_InitTypeDef;
+
+/* XSPI */
+typedef struct __XSPI_HandleTypeDef {
+    XSPI_TypeDef *Instance;
+    XSPI_InitTypeDef Init;
+    uint8_t *pBuffPtr;
+    __IO uint32_t XferSize;
+    __IO uint32_t XferCount;
+    __IO uint32_t State;
+    __IO uint32_t ErrorCode;
+    uint32_t Timeout;
+} XSPI_HandleTypeDef;
+
+/* XSPI */
+typedef struct {
+    uint32_t OperationType;
+    uint32_t IOSelect;
+    uint32_t Instruction;
+    uint32_t InstructionMode;
+    uint32_t InstructionWidth;
+    uint32_t InstructionDTRMode;
+    uint32_t Address;
+    uint32_t AddressMode;
+    uint32_t AddressWidth;
+    uint32_t AddressDTRMode;
+    uint32_t AlternateBytes;
+    uint32_t AlternateBytesMode;
+    uint32_t AlternateBytesWidth;
+    uint32_t AlternateBytesDTRMode;
+    uint32_t DataMode;
+    uint32_t DataLength;
+    uint32_t DataDTRMode;
+    uint32_t DummyCycles;
+    uint32_t DQSMode;
+} XSPI_RegularCmdTypeDef;
+
+/* XSPIԶѯ */
+typedef struct {
+    uint32_t MatchValue;
+    uint32_t MatchMask;
+    uint32_t MatchMode;
+    uint32_t AutomaticStop;
+    uint32_t IntervalTime;
+} XSPI_AutoPollingTypeDef;
+
+/* XSPIڴӳ䶨 */
+typedef struct {
+    uint32_t TimeOutActivation;
+    uint32_t TimeoutPeriodClock;
+} XSPI_MemoryMappedTypeDef;
+
+/* XSPIٽӿУ׼ */
+typedef struct {
+    uint32_t DelayValueType;
+    uint32_t FineCalibrationUnit;
+    uint32_t CoarseCalibrationUnit;
+    uint32_t MaxCalibration;
+} XSPI_HSCalTypeDef;
+
+/* XSPIMö */
+typedef struct {
+    uint32_t nCSOverride;
+    uint32_t IOPort;
+    uint32_t Req2AckTime;
+} XSPIM_CfgTypeDef;
+
+/* XSPI״̬ */
+#define HAL_XSPI_STATE_RESET                (0x00000000U)
+#define HAL_XSPI_STATE_READY                (0x00000002U)
+#define HAL_XSPI_STATE_CMD_CFG              (0x00000004U)
+#define HAL_XSPI_STATE_BUSY_CMD             (0x00000008U)
+#define HAL_XSPI_STATE_BUSY_TX              (0x00000018U)
+#define HAL_XSPI_STATE_BUSY_RX              (0x00000028U)
+#define HAL_XSPI_STATE_BUSY_AUTO_POLLING    (0x00000048U)
+#define HAL_XSPI_STATE_BUSY_MEM_MAPPED      (0x00000088U)
+#define HAL_XSPI_STATE_ABORT                (0x00000100U)
+#define HAL_XSPI_STATE_ERROR                (0x00000200U)
+
+/* XSPI */
+#define HAL_XSPI_ERROR_NONE                 (0x00000000U)
+#define HAL_XSPI_ERROR_TIMEOUT              (0x00000001U)
+#define HAL_XSPI_ERROR_TRANSFER             (0x00000002U)
+#define HAL_XSPI_ERROR_INVALID_PARAM        (0x00000008U)
+#define HAL_XSPI_ERROR_INVALID_SEQUENCE     (0x00000010U)
+
+/* XSPIʼȡֵ */
+#define HAL_XSPI_SINGLE_MEM                 (0x00000000U)
+#define HAL_XSPI_DUAL_MEM                   (0x00000040U)
+#define HAL_XSPI_MEMTYPE_MICRON             (0x00000000U)
+#define HAL_XSPI_MEMTYPE_MACRONIX           (0x01000000U)
+#define HAL_XSPI_MEMTYPE_APMEM              (0x02000000U)
+#define HAL_XSPI_SIZE_256MB                 (0x00000018U)
+#define HAL_XSPI_FREERUNCLK_DISABLE         (0x00000000U)
+#define HAL_XSPI_CLOCK_MODE_0               (0x00000000U)
+#define HAL_XSPI_WRAP_NOT_SUPPORTED         (0x00000000U)
+#define HAL_XSPI_SAMPLE_SHIFT_NONE          (0x00000000U)
+#define HAL_XSPI_SAMPLE_SHIFT_HALFCYCLE     (0x40000000U)
+#define HAL_XSPI_DHQC_DISABLE               (0x00000000U)
+#define HAL_XSPI_DHQC_ENABLE                (0x10000000U)
+#define HAL_XSPI_BONDARYOF_NONE             (0x00000000U)
+#define HAL_XSPI_CSSEL_NCS1                 (0x00000000U)
+#define HAL_XSPI_CSSEL_OVR_NCS1             (0x00000010U)
+#define HAL_XSPIM_IOPORT_1                  (0x00000000U)
+
+/* XSPIȡֵ壨3λ */
+#define HAL_XSPI_OPTYPE_COMMON_CFG          (0x00000000U)
+#define HAL_XSPI_OPTYPE_READ_CFG            (0x00000001U)
+#define HAL_XSPI_OPTYPE_WRITE_CFG           (0x00000002U)
+#define HAL_XSPI_SELECT_IO_7_0              (0x00000000U)
+#define HAL_XSPI_INSTRUCTION_NONE           (0x00000000U)
+#define HAL_XSPI_INSTRUCTION_1_LINE         (0x00000001U)
+#define HAL_XSPI_INSTRUCTION_2_LINES        (0x00000002U)
+#define HAL_XSPI_INSTRUCTION_4_LINES        (0x00000003U)
+#define HAL_XSPI_INSTRUCTION_8_LINES        (0x00000004U)
+#define HAL_XSPI_INSTRUCTION_8_BITS         (0x00000000U)
+#define HAL_XSPI_INSTRUCTION_16_BITS        (0x00000001U)
+#define HAL_XSPI_INSTRUCTION_24_BITS        (0x00000002U)
+#define HAL_XSPI_INSTRUCTION_32_BITS        (0x00000003U)
+#define HAL_XSPI_INSTRUCTION_DTR_DISABLE    (0x00000000U)
+#define HAL_XSPI_INSTRUCTION_DTR_ENABLE     (0x00000008U)
+#define HAL_XSPI_ADDRESS_NONE               (0x00000000U)
+#define HAL_XSPI_ADDRESS_1_LINE             (0x00000001U)
+#define HAL_XSPI_ADDRESS_2_LINES            (0x00000002U)
+#define HAL_XSPI_ADDRESS_4_LINES            (0x00000003U)
+#define HAL_XSPI_ADDRESS_8_LINES            (0x00000004U)
+#define HAL_XSPI_ADDRESS_8_BITS             (0x00000000U)
+#define HAL_XSPI_ADDRESS_16_BITS            (0x00000001U)
+#define HAL_XSPI_ADDRESS_24_BITS            (0x00000002U)
+#define HAL_XSPI_ADDRESS_32_BITS            (0x00000003U)
+#define HAL_XSPI_ADDRESS_DTR_DISABLE        (0x00000000U)
+#define HAL_XSPI_ADDRESS_DTR_ENABLE         (0x00000008U)
+#define HAL_XSPI_ALT_BYTES_NONE             (0x00000000U)
+#define HAL_XSPI_ALT_BYTES_1_LINE           (0x00000001U)
+#define HAL_XSPI_ALT_BYTES_2_LINES          (0x00000002U)
+#define HAL_XSPI_ALT_BYTES_4_LINES          (0x00000003U)
+#define HAL_XSPI_ALT_BYTES_8_LINES          (0x00000004U)
+#define HAL_XSPI_ALT_BYTES_8_BITS           (0x00000000U)
+#define HAL_XSPI_ALT_BYTES_16_BITS          (0x00000001U)
+#define HAL_XSPI_ALT_BYTES_24_BITS          (0x00000002U)
+#define HAL_XSPI_ALT_BYTES_32_BITS          (0x00000003U)
+#define HAL_XSPI_ALT_BYTES_DTR_DISABLE      (0x00000000U)
+#define HAL_XSPI_ALT_BYTES_DTR_ENABLE       (0x00000008U)
+#define HAL_XSPI_DATA_NONE                  (0x00000000U)
+#define HAL_XSPI_DATA_1_LINE                (0x00000001U)
+#define HAL_XSPI_DATA_2_LINES               (0x00000002U)
+#define HAL_XSPI_DATA_4_LINES               (0x00000003U)
+#define HAL_XSPI_DATA_8_LINES               (0x00000004U)
+#define HAL_XSPI_DATA_DTR_DISABLE           (0x00000000U)
+#define HAL_XSPI_DATA_DTR_ENABLE            (0x00000008U)
+#define HAL_XSPI_DQS_DISABLE                (0x00000000U)
+#define HAL_XSPI_DQS_ENABLE                 (0x00000008U)
+#define HAL_XSPI_MATCH_MODE_AND             (0x00000000U)
+#define HAL_XSPI_MATCH_MODE_OR              (0x00000001U)
+#define HAL_XSPI_AUTOMATIC_STOP_DISABLE     (0x00000000U)
+#define HAL_XSPI_AUTOMATIC_STOP_ENABLE      (0x00000001U)
+#define HAL_XSPI_TIMEOUT_COUNTER_DISABLE    (0x00000000U)
+#define HAL_XSPI_TIMEOUT_COUNTER_ENABLE     (0x00000001U)
+#define HAL_XSPI_TIMEOUT_DEFAULT_VALUE      (5000U)
+#define HAL_XSPI_CAL_FEEDBACK_CLK_DELAY     (0x00000001U)
+#define HAL_XSPI_CAL_DATA_OUTPUT_DELAY      (0x00000002U)
+#define HAL_XSPI_CAL_DQS_INPUT_DELAY        (0x00000003U)
+
+/* CRCHASH趨壨֧boot_image.cʹõãCRC32SHA-256 */
+typedef struct {
+    __IO uint32_t DR;
+} CRC_TypeDef;
+
+typedef struct {
+    __IO uint32_t CR;
+} HASH_TypeDef;
+
+extern CRC_TypeDef crc_sim_instance;
+extern HASH_TypeDef hash_sim_instance;
+#define CRC                                 (&crc_sim_instance)
+#define HASH                                (&hash_sim_instance)
+#define __HAL_RCC_CRC_CLK_ENABLE()          do {} while (0)
+#define __HAL_RCC_HASH_CLK_ENABLE()         do {} while (0)
+
+typedef struct {
+    uint8_t DefaultPolynomialUse;
+    uint8_t DefaultInitValueUse;
+    uint32_t GeneratingPolynomial;
+    uint32_t CRCLength;
+    uint32_t InitValue;
+    uint32_t InputDataInversionMode;
+    uint32_t OutputDataInversionMode;
+} CRC_InitTypeDef;
+
+typedef struct {
+    CRC_TypeDef *Instance;
+    CRC_InitTypeDef Init;
+    uint32_t InputDataFormat;
+} CRC_HandleTypeDef;
+
+#define DEFAULT_POLYNOMIAL_ENABLE           ((uint8_t)0x00U)
+#define DEFAULT_INIT_VALUE_ENABLE           ((uint8_t)0x00U)
+#define CRC_INPUTDATA_INVERSION_NONE        (0x00000000U)
+#define CRC_INPUTDATA_INVERSION_BYTE        (0x00000020U)
+#define CRC_OUTPUTDATA_INVERSION_DISABLE    (0x00000000U)
+#define CRC_OUTPUTDATA_INVERSION_ENABLE     (0x00000080U)
+#define CRC_INPUTDATA_FORMAT_BYTES          (0x00000001U)
+
+typedef struct {
+    uint32_t DataType;
+    uint32_t KeySize;
+    uint8_t *pKey;
+    uint32_t Algorithm;
+} HASH_ConfigTypeDef;
+
+typedef struct {
+    HASH_TypeDef *Instance;
+    HASH_ConfigTypeDef Init;
+} HASH_HandleTypeDef;
+
+#define HASH_BYTE_SWAP                      (0x00000020U)
+#define HASH_ALGOSELECTION_SHA256           (0x00060000U)
+
+/* HALCRCHASH */
+HAL_StatusTypeDef HAL_CRC_Init(CRC_HandleTypeDef *hcrc);
+uint32_t HAL_CRC_Accumulate(CRC_HandleTypeDef *hcrc, uint32_t pBuffer[], uint32_t BufferLength);
+uint32_t HAL_CRC_Calculate(CRC_HandleTypeDef *hcrc, uint32_t pBuffer[], uint32_t BufferLength);
+HAL_StatusTypeDef HAL_HASH_Init(HASH_HandleTypeDef *hhash);
+HAL_StatusTypeDef HAL_HASH_Start(HASH_HandleTypeDef *hhash, const uint8_t *const pInBuffer, uint32_t Size,
+                                 uint8_t *const pOutBuffer, uint32_t Timeout);
+
+/* HALXSPI */
+HAL_StatusTypeDef HAL_XSPI_Init(XSPI_HandleTypeDef *hxspi);
+HAL_StatusTypeDef HAL_XSPI_DeInit(XSPI_HandleTypeDef *hxspi);
+HAL_StatusTypeDef HAL_XSPIM_Config(XSPI_HandleTypeDef *const hxspi, XSPIM_CfgTypeDef *const pCfg, uint32_t Timeout);
+HAL_StatusTypeDef HAL_XSPI_Command(XSPI_HandleTypeDef *hxspi, XSPI_RegularCmdTypeDef *const pCmd, uint32_t Timeout);
+HAL_StatusTypeDef HAL_XSPI_Transmit(XSPI_HandleTypeDef *hxspi, const uint8_t *pData, uint32_t Timeout);
+HAL_StatusTypeDef HAL_XSPI_Receive(XSPI_HandleTypeDef *hxspi, uint8_t *const pData, uint32_t Timeout);
+HAL_StatusTypeDef HAL_XSPI_AutoPolling(XSPI_HandleTypeDef *hxspi, XSPI_AutoPollingTypeDef *const pCfg, uint32_t Timeout);
+HAL_StatusTypeDef HAL_XSPI_Transmit_DMA(XSPI_HandleTypeDef *hxspi, const uint8_t *pData);
+HAL_StatusTypeDef HAL_XSPI_AutoPolling_IT(XSPI_HandleTypeDef *hxspi, XSPI_AutoPollingTypeDef *const pCfg);
+void HAL_XSPI_IRQHandler(XSPI_HandleTypeDef *hxspi);
+void HAL_XSPI_TxCpltCallback(XSPI_HandleTypeDef *hxspi);
+void HAL_XSPI_StatusMatchCallback(XSPI_HandleTypeDef *hxspi);
+void HAL_XSPI_ErrorCallback(XSPI_HandleTypeDef *hxspi);
+HAL_StatusTypeDef HAL_XSPI_MemoryMapped(XSPI_HandleTypeDef *hxspi, XSPI_MemoryMappedTypeDef *const pCfg);
+HAL_StatusTypeDef HAL_XSPI_Abort(XSPI_HandleTypeDef *hxspi);
+HAL_StatusTypeDef HAL_XSPI_SetClockPrescaler(XSPI_HandleTypeDef *hxspi, uint32_t Prescaler);
+HAL_StatusTypeDef HAL_XSPI_SetDelayValue(XSPI_HandleTypeDef *hxspi, XSPI_HSCalTypeDef *const pCfg);
+uint32_t HAL_GetTick(void);
+
+/* LLCMSIS */
+void LL_mDelay(uint32_t Delay);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+static inline void __enable_irq(void) { __set_PRIMASK(0); }
+static inline void __disable_irq(void) { __set_PRIMASK(1); }
+
+/* DWTڼCoreDebugÿηDWTʱʱSystemCoreClockˢCYCCNT */
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+    __IO uint32_t LAR;
+} DWT_Type;
+
+typedef struct {
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk              (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk          (1UL << 24)
+
+extern uint32_t SystemCoreClock;
+extern CoreDebug_Type w25q128_sim_core_debug;
+DWT_Type *w25q128_sim_dwt(void);
+#define DWT                                 (w25q128_sim_dwt())
+#define CoreDebug                           (&w25q128_sim_core_debug)
+
+static inline void SCB_InvalidateICache(void) {}
+static inline void SCB_InvalidateDCache(void) {}
+static inline void SCB_CleanDCache(void) {}
+static inline void SCB_InvalidateDCache_by_Addr(volatile void *addr, int32_t dsize) { (void)addr; (void)dsize; }
+static inline void SCB_CleanDCache_by_Addr(volatile void *addr, int32_t dsize) { (void)addr; (void)dsize; }
+static inline void SCB_InvalidateICache_by_Addr(volatile void *addr, int32_t isize) { (void)addr; (void)isize; }
+
+#endif /* __STM32H7RSXX_HAL_SIM_H */
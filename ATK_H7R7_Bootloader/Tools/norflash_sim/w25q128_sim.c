@@ -0,0 +1,1900 @@
+/**
+ ****************************************************************************************************
+ * @file        w25q128_sim.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ˫W25Q128(XSPI˫洢ģʽ)
+ ****************************************************************************************************
+ * @attention
+ *
+ * ʵBSPʹõHAL_XSPI_xxx()ֱڷƬW25Q128
+ * ״̬ĴWIP/WEL塢ֻ1->0ı̡4KB/32KB/64KB/ȫƬȣ
+ * ʱ䰴XSPIʱ׶㣬оƬæʱ䰴ֲʱ
+ * ע: ִ趨ı/һֻһ֣дǰһֽڣ
+ * ֻǰһ֣֮ʧܣֱw25q128_sim_power_restore()ģϵ
+ *
+ ****************************************************************************************************
+ */
+
+#include "w25q128_sim.h"
+#include "main.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* W25Q128 */
+#define W25Q128_SIM_WRITE_STATUS_REGISTER_1     (0x01U)
+#define W25Q128_SIM_PAGE_PROGRAM                (0x02U)
+#define W25Q128_SIM_READ                        (0x03U)
+#define W25Q128_SIM_WRITE_DISABLE               (0x04U)
+#define W25Q128_SIM_READ_STATUS_REGISTER_1      (0x05U)
+#define W25Q128_SIM_WRITE_ENABLE                (0x06U)
+#define W25Q128_SIM_FAST_READ                   (0x0BU)
+#define W25Q128_SIM_WRITE_STATUS_REGISTER_3     (0x11U)
+#define W25Q128_SIM_READ_STATUS_REGISTER_3      (0x15U)
+#define W25Q128_SIM_SECTOR_ERASE                (0x20U)
+#define W25Q128_SIM_WRITE_STATUS_REGISTER_2     (0x31U)
+#define W25Q128_SIM_QUAD_INPUT_PAGE_PROGRAM     (0x32U)
+#define W25Q128_SIM_READ_STATUS_REGISTER_2      (0x35U)
+#define W25Q128_SIM_BLOCK_ERASE_32K             (0x52U)
+#define W25Q128_SIM_CHIP_ERASE_60               (0x60U)
+#define W25Q128_SIM_ENABLE_RESET                (0x66U)
+#define W25Q128_SIM_FAST_READ_QUAD_OUTPUT       (0x6BU)
+#define W25Q128_SIM_ERASE_SUSPEND               (0x75U)
+#define W25Q128_SIM_ERASE_RESUME                (0x7AU)
+#define W25Q128_SIM_MANUFACTURER_DEVICE_ID      (0x90U)
+#define W25Q128_SIM_RESET_DEVICE                (0x99U)
+#define W25Q128_SIM_JEDEC_ID                    (0x9FU)
+#define W25Q128_SIM_CHIP_ERASE                  (0xC7U)
+#define W25Q128_SIM_BLOCK_ERASE_64K             (0xD8U)
+#define W25Q128_SIM_FAST_READ_QUAD_IO           (0xEBU)
+#define W25Q128_SIM_DTR_FAST_READ_QUAD_IO       (0xEDU)
+#define W25Q128_SIM_CONTINUOUS_READ_RESET       (0xFFU)
+
+/* ״̬Ĵλ */
+#define W25Q128_SIM_SR1_BUSY                    (1U << 0)
+#define W25Q128_SIM_SR1_WEL                     (1U << 1)
+#define W25Q128_SIM_SR2_QE                      (1U << 1)
+#define W25Q128_SIM_SR2_SUS                     (1U << 7)
+
+/* ID */
+#define W25Q128_SIM_MANUFACTURER_ID             (0xEFU)
+#define W25Q128_SIM_DEVICE_ID                   (0x17U)
+#define W25Q128_SIM_MEMORY_TYPE                 (0x40U)
+#define W25Q128_SIM_CAPACITY                    (0x18U)
+
+/* ģʽλ壨M5-4Ϊ10bʱģʽ */
+#define W25Q128_SIM_CONTINUOUS_READ_MASK        (0x30U)
+#define W25Q128_SIM_CONTINUOUS_READ_ENABLE      (0x20U)
+
+/* ҳС */
+#define W25Q128_SIM_PAGE_SIZE                   (0x00000100UL)
+
+/* ʱƵʶ */
+#define W25Q128_SIM_MAX_CLOCK_HZ                (133000000UL)
+#define W25Q128_SIM_MAX_DTR_CLOCK_HZ            (80000000UL)
+
+/* ʱģͶ壺λʱЧڿɸǵSDRʱӣ
+ * ڴƵʵSDRDTR뷴ʱӳЧ */
+#define W25Q128_SIM_MAX_UNSHIFTED_CLOCK_HZ      (70000000UL)
+#define W25Q128_SIM_DELAY_WINDOW_MIN            (24U)
+#define W25Q128_SIM_DELAY_WINDOW_MAX            (80U)
+
+/* жϷʽͶ */
+#define W25Q128_SIM_PENDING_NONE                (0U)
+#define W25Q128_SIM_PENDING_TX                  (1U)
+#define W25Q128_SIM_PENDING_POLL                (2U)
+
+/* жϷʽԶѯȴʱ䶨壨ȫƬʱ䣩 */
+#define W25Q128_SIM_IT_POLL_LIMIT               (300000000000ULL)
+
+/* ʱ壨λns */
+typedef struct {
+    uint64_t page_program;      /* tPP */
+    uint64_t sector_erase;      /* tSE */
+    uint64_t block32_erase;     /* tBE1 */
+    uint64_t block64_erase;     /* tBE2 */
+    uint64_t chip_erase;        /* tCE */
+    uint64_t write_status;      /* tW */
+    uint64_t reset;             /* tRST */
+    uint64_t suspend;           /* tSUS */
+} w25q128_sim_timing_param_t;
+
+static const w25q128_sim_timing_param_t w25q128_sim_timings[] = {
+    [W25Q128_SIM_TIMING_TYPICAL] = {
+        .page_program = 400000ULL,
+        .sector_erase = 45000000ULL,
+        .block32_erase = 120000000ULL,
+        .block64_erase = 150000000ULL,
+        .chip_erase = 40000000000ULL,
+        .write_status = 10000000ULL,
+        .reset = 30000ULL,
+        .suspend = 20000ULL,
+    },
+    [W25Q128_SIM_TIMING_MAX] = {
+        .page_program = 3000000ULL,
+        .sector_erase = 400000000ULL,
+        .block32_erase = 1600000000ULL,
+        .block64_erase = 2000000000ULL,
+        .chip_erase = 200000000000ULL,
+        .write_status = 15000000ULL,
+        .reset = 30000ULL,
+        .suspend = 20000ULL,
+    },
+};
+
+/* ƬW25Q128״̬ */
+typedef struct {
+    uint8_t sr[3];              /* ״̬Ĵ1~3 */
+    uint8_t reset_enabled;      /* յλʹ */
+    uint8_t continuous;         /* ģʽõĶָ0ʾδģʽ */
+    uint64_t busy_until;        /* æʱ */
+    uint8_t busy_erase;         /* ǰæΪɹ/ */
+    uint8_t suspended;          /* ѹ */
+    uint64_t suspend_remaining; /* ʱʣʱ */
+    uint32_t erase_count[W25Q128_SIM_DIE_SECTOR_NUM];
+} w25q128_sim_die_t;
+
+/* XSPIʵ */
+XSPI_TypeDef xspi1_sim_instance;
+
+/* ڴӳ䴰 */
+uint8_t *w25q128_sim_window = NULL;
+
+/* ںʱDWTCoreDebug */
+uint32_t SystemCoreClock = W25Q128_SIM_CORE_CLOCK_HZ;
+CoreDebug_Type w25q128_sim_core_debug;
+static DWT_Type w25q128_sim_dwt_instance;
+
+/* ״̬ */
+static struct {
+    int fd;
+    uint8_t *image;             /* ļӳ */
+    uint8_t *invalid_window;    /* ôʱӳ䴰 */
+    w25q128_sim_die_t die[W25Q128_SIM_DIE_NUM];
+    w25q128_sim_timing_t timing;
+    int verbose;
+    uint64_t now;
+    XSPI_RegularCmdTypeDef cmd;         /* ģʽ */
+    XSPI_RegularCmdTypeDef read_cfg;    /* ڴӳ */
+    XSPI_RegularCmdTypeDef write_cfg;   /* ڴӳд */
+    uint8_t read_cfg_valid;
+    uint8_t dtr_support;                /* ֧DTRٶ */
+    uint32_t feedback_delay;            /* ʱӳ(Ԫ) */
+    XSPI_HandleTypeDef *mmap_hxspi;     /* ڴӳʹõXSPI */
+    struct {
+        uint32_t type;                  /* жϷʽ */
+        uint8_t ready;                  /* ɣȴжϴ */
+        XSPI_HandleTypeDef *hxspi;
+        XSPI_AutoPollingTypeDef polling;
+    } pending;                          /* ежϷʽ */
+    uint32_t primask;
+    uint32_t masked_tick;               /* жʱʱSysTickжϲִУHAL_GetTick() */
+    uint8_t xip;                        /* ڴӳ䴰У˳ӳڼжϣ */
+    struct {
+        uint8_t armed;                  /* õ */
+        uint8_t lost;                   /* ѵ磬Ӧ */
+        uint32_t remaining;             /* ǰִеı/ */
+        uint32_t seed;                  /* жλα */
+    } power;                            /* ע */
+    w25q128_sim_stats_t stats;
+} sim = {
+    .fd = -1,
+    .dtr_support = 1,
+};
+
+/**
+ * @brief   ȡ׶
+ * @param   mode: ׶ģʽ룬3λ
+ * @retval  0ʾ޴˽׶
+ */
+static uint32_t sim_lines(uint32_t mode)
+{
+    static const uint32_t lines[] = {0, 1, 2, 4, 8};
+
+    return lines[(mode & 0x7U) % (sizeof(lines) / sizeof(lines[0]))];
+}
+
+/**
+ * @brief   ׶ʱ
+ * @param   bits: λ
+ * @param   mode: ׶ģʽ
+ * @param   dtr: DTRģʽ
+ * @retval  ʱ
+ */
+static uint64_t sim_phase_cycles(uint64_t bits, uint32_t mode, uint32_t dtr)
+{
+    uint32_t lines = sim_lines(mode);
+    uint64_t cycles;
+
+    if (lines == 0)
+    {
+        return 0;
+    }
+
+    cycles = (bits + lines - 1) / lines;
+    if (dtr != 0)
+    {
+        cycles = (cycles + 1) / 2;
+    }
+
+    return cycles;
+}
+
+/**
+ * @brief   ȡXSPIʱ
+ * @param   hxspi: XSPIָ
+ * @retval  ʱ(ns)
+ */
+static uint64_t sim_clock_period_ns(XSPI_HandleTypeDef *hxspi)
+{
+    return (1000000000ULL * (hxspi->Init.ClockPrescaler + 1)) / W25Q128_SIM_KERNEL_CLOCK_HZ;
+}
+
+/**
+ * @brief   ȡ˫洢ģʽµƬֽ
+ * @param   hxspi: XSPIָ
+ * @param   length: ݳ
+ * @retval  Ƭֽ
+ */
+static uint32_t sim_die_length(XSPI_HandleTypeDef *hxspi, uint32_t length)
+{
+    if (hxspi->Init.MemoryMode == HAL_XSPI_DUAL_MEM)
+    {
+        return (length + 1) / 2;
+    }
+
+    return length;
+}
+
+/**
+ * @brief   һʱ
+ * @param   hxspi: XSPIָ
+ * @param   cmd: ָ
+ * @retval  ʱ
+ */
+static uint64_t sim_command_cycles(XSPI_HandleTypeDef *hxspi, const XSPI_RegularCmdTypeDef *cmd)
+{
+    uint64_t cycles = 0;
+
+    cycles += sim_phase_cycles(8 * (cmd->InstructionWidth + 1), cmd->InstructionMode, cmd->InstructionDTRMode);
+    cycles += sim_phase_cycles(8 * (cmd->AddressWidth + 1), cmd->AddressMode, cmd->AddressDTRMode);
+    cycles += sim_phase_cycles(8 * (cmd->AlternateBytesWidth + 1), cmd->AlternateBytesMode, cmd->AlternateBytesDTRMode);
+    cycles += cmd->DummyCycles;
+    if (cmd->DataMode != HAL_XSPI_DATA_NONE)
+    {
+        cycles += sim_phase_cycles(8ULL * sim_die_length(hxspi, cmd->DataLength), cmd->DataMode, cmd->DataDTRMode);
+    }
+    cycles += hxspi->Init.ChipSelectHighTimeCycle;
+
+    return cycles;
+}
+
+/**
+ * @brief   鵱ǰʱ¶Ƿɿ
+ * @param   hxspi: XSPIָ
+ * @param   dtr: DTR
+ * @retval  
+ * @arg     0: 
+ * @arg     1: ȷ
+ */
+static uint8_t sim_sampling_check(XSPI_HandleTypeDef *hxspi, uint32_t dtr)
+{
+    uint64_t bus_hz = W25Q128_SIM_KERNEL_CLOCK_HZ / (hxspi->Init.ClockPrescaler + 1);
+    uint32_t tcr = hxspi->Instance->TCR;
+
+    if (dtr != 0)
+    {
+        /* DTRλַģʽλӳ1/4ڱ */
+        if (((tcr & XSPI_TCR_SSHIFT) != 0) || ((tcr & XSPI_TCR_DHQC) == 0))
+        {
+            return 0;
+        }
+    }
+    else
+    {
+        if (bus_hz <= W25Q128_SIM_MAX_UNSHIFTED_CLOCK_HZ)
+        {
+            return 1;
+        }
+        if ((tcr & XSPI_TCR_SSHIFT) == 0)
+        {
+            return 0;
+        }
+    }
+
+    return ((sim.feedback_delay >= W25Q128_SIM_DELAY_WINDOW_MIN) && (sim.feedback_delay <= W25Q128_SIM_DELAY_WINDOW_MAX)) ? 1 : 0;
+}
+
+/**
+ * @brief   ƽʱ䲢ͳʱ
+ * @param   hxspi: XSPIָ
+ * @param   cycles: ʱ
+ * @retval  
+ */
+static void sim_bus_advance(XSPI_HandleTypeDef *hxspi, uint64_t cycles)
+{
+    uint64_t ns = cycles * sim_clock_period_ns(hxspi);
+
+    sim.stats.bus_cycles += cycles;
+    sim.stats.bus_ns += ns;
+    sim.now += ns;
+}
+
+/**
+ * @brief   ȡƬ洢Ԫָ
+ * @param   die: Ƭ
+ * @param   address: Ƭڵַ
+ * @retval  洢Ԫָ
+ */
+static uint8_t *sim_cell(uint32_t die, uint32_t address)
+{
+    return &sim.image[(uint64_t)(address % W25Q128_SIM_DIE_SIZE) * W25Q128_SIM_DIE_NUM + die];
+}
+
+/**
+ * @brief   µƬ״̬æWEL
+ * @param   die: Ƭ״ָ̬
+ * @retval  
+ */
+static void sim_die_update(w25q128_sim_die_t *die)
+{
+    if ((die->busy_until != 0) && (sim.now >= die->busy_until))
+    {
+        die->busy_until = 0;
+        die->busy_erase = 0;
+
+        /* ʱδWEL */
+        if (die->suspended == 0)
+        {
+            die->sr[0] &= ~W25Q128_SIM_SR1_WEL;
+        }
+    }
+}
+
+/**
+ * @brief   Ƭʼһæ
+ * @param   die: Ƭ״ָ̬
+ * @param   duration: æʱ(ns)
+ * @retval  
+ */
+static void sim_die_start_busy(w25q128_sim_die_t *die, uint64_t duration)
+{
+    die->busy_until = sim.now + duration;
+    die->busy_erase = 0;
+}
+
+/**
+ * @brief   Ƭ״̬Ĵ
+ * @param   die: Ƭ״ָ̬
+ * @param   index: ״̬Ĵ(0~2)
+ * @retval  ״̬Ĵֵ
+ */
+static uint8_t sim_die_status(w25q128_sim_die_t *die, uint32_t index)
+{
+    uint8_t value = die->sr[index];
+
+    if ((index == 0) && (die->busy_until != 0))
+    {
+        value |= W25Q128_SIM_SR1_BUSY;
+    }
+
+    return value;
+}
+
+/**
+ * @brief   Ƭ
+ * @param   die_index: Ƭ
+ * @param   address: Ƭڵַ
+ * @param   size: С
+ * @param   duration: ʱ(ns)
+ * @retval  
+ */
+static void sim_die_erase(uint32_t die_index, uint32_t address, uint32_t size, uint64_t duration)
+{
+    w25q128_sim_die_t *die = &sim.die[die_index];
+    uint32_t base;
+    uint32_t offset;
+
+    base = (address % W25Q128_SIM_DIE_SIZE) & ~(size - 1);
+    for (offset = 0; offset < size; offset++)
+    {
+        *sim_cell(die_index, base + offset) = 0xFF;
+    }
+    for (offset = 0; offset < size; offset += W25Q128_SIM_DIE_SECTOR_SIZE)
+    {
+        die->erase_count[(base + offset) / W25Q128_SIM_DIE_SECTOR_SIZE]++;
+    }
+
+    sim_die_start_busy(die, duration);
+
+    /* ȫƬܹ */
+    die->busy_erase = (size != W25Q128_SIM_DIE_SIZE) ? 1 : 0;
+}
+
+/**
+ * @brief   Ƭִһ
+ * @param   hxspi: XSPIָ
+ * @param   die_index: Ƭ
+ * @param   cmd: ָ
+ * @param   tx: д뱾ƬݣƬ˳
+ * @param   rx: ƬݣƬ˳
+ * @param   length: Ƭݳ
+ * @retval  
+ */
+static void sim_die_execute(XSPI_HandleTypeDef *hxspi, uint32_t die_index, const XSPI_RegularCmdTypeDef *cmd, const uint8_t *tx, uint8_t *rx, uint32_t length)
+{
+    const w25q128_sim_timing_param_t *timing = &w25q128_sim_timings[sim.timing];
+    w25q128_sim_die_t *die = &sim.die[die_index];
+    uint8_t opcode = (uint8_t)cmd->Instruction;
+    uint32_t address = cmd->Address;
+    uint32_t index;
+    uint32_t page_base;
+    uint8_t cell;
+
+    if (hxspi->Init.MemoryMode == HAL_XSPI_DUAL_MEM)
+    {
+        address >>= 1;
+    }
+
+    sim_die_update(die);
+
+    if (rx != NULL)
+    {
+        memset(rx, 0xFF, length);
+    }
+
+    /* ģʽָϴεĶָ0xFFģʽλ˳ģʽָᱻַ */
+    if (die->continuous != 0)
+    {
+        if (cmd->InstructionMode == HAL_XSPI_INSTRUCTION_NONE)
+        {
+            opcode = die->continuous;
+        }
+        else if (opcode == W25Q128_SIM_CONTINUOUS_READ_RESET)
+        {
+            die->continuous = 0;
+            return;
+        }
+        else
+        {
+            sim.stats.violations++;
+            return;
+        }
+    }
+    else if (cmd->InstructionMode == HAL_XSPI_INSTRUCTION_NONE)
+    {
+        sim.stats.violations++;
+        return;
+    }
+
+    /* æʱֻӦ״̬Ĵ */
+    if ((die->busy_until != 0) && (opcode != W25Q128_SIM_READ_STATUS_REGISTER_1) && (opcode != W25Q128_SIM_READ_STATUS_REGISTER_2) && (opcode != W25Q128_SIM_READ_STATUS_REGISTER_3) && (opcode != W25Q128_SIM_ERASE_SUSPEND))
+    {
+        sim.stats.violations++;
+        return;
+    }
+
+    if (opcode != W25Q128_SIM_RESET_DEVICE)
+    {
+        die->reset_enabled = 0;
+    }
+
+    switch (opcode)
+    {
+        case W25Q128_SIM_WRITE_ENABLE:
+        {
+            die->sr[0] |= W25Q128_SIM_SR1_WEL;
+            break;
+        }
+        case W25Q128_SIM_WRITE_DISABLE:
+        {
+            die->sr[0] &= ~W25Q128_SIM_SR1_WEL;
+            break;
+        }
+        case W25Q128_SIM_READ_STATUS_REGISTER_1:
+        case W25Q128_SIM_READ_STATUS_REGISTER_2:
+        case W25Q128_SIM_READ_STATUS_REGISTER_3:
+        {
+            index = (opcode == W25Q128_SIM_READ_STATUS_REGISTER_1) ? 0 : ((opcode == W25Q128_SIM_READ_STATUS_REGISTER_2) ? 1 : 2);
+            for (uint32_t i = 0; (rx != NULL) && (i < length); i++)
+            {
+                rx[i] = sim_die_status(die, index);
+            }
+            break;
+        }
+        case W25Q128_SIM_WRITE_STATUS_REGISTER_1:
+        case W25Q128_SIM_WRITE_STATUS_REGISTER_2:
+        case W25Q128_SIM_WRITE_STATUS_REGISTER_3:
+        {
+            if (((die->sr[0] & W25Q128_SIM_SR1_WEL) == 0) || (tx == NULL) || (length == 0) || (die->suspended != 0))
+            {
+                sim.stats.violations++;
+                break;
+            }
+            index = (opcode == W25Q128_SIM_WRITE_STATUS_REGISTER_1) ? 0 : ((opcode == W25Q128_SIM_WRITE_STATUS_REGISTER_2) ? 1 : 2);
+            if (index == 0)
+            {
+                die->sr[0] = (tx[0] & ~(W25Q128_SIM_SR1_BUSY | W25Q128_SIM_SR1_WEL)) | W25Q128_SIM_SR1_WEL;
+            }
+            else
+            {
+                die->sr[index] = tx[0];
+            }
+            sim_die_start_busy(die, timing->write_status);
+            break;
+        }
+        case W25Q128_SIM_ENABLE_RESET:
+        {
+            die->reset_enabled = 1;
+            break;
+        }
+        case W25Q128_SIM_RESET_DEVICE:
+        {
+            if (die->reset_enabled == 0)
+            {
+                sim.stats.violations++;
+                break;
+            }
+            die->reset_enabled = 0;
+            die->sr[0] &= ~W25Q128_SIM_SR1_WEL;
+            sim_die_start_busy(die, timing->reset);
+            break;
+        }
+        case W25Q128_SIM_MANUFACTURER_DEVICE_ID:
+        {
+            for (uint32_t i = 0; (rx != NULL) && (i < length); i++)
+            {
+                rx[i] = (((address + i) & 1UL) == 0) ? W25Q128_SIM_MANUFACTURER_ID : W25Q128_SIM_DEVICE_ID;
+            }
+            break;
+        }
+        case W25Q128_SIM_JEDEC_ID:
+        {
+            static const uint8_t jedec_id[3] = {W25Q128_SIM_MANUFACTURER_ID, W25Q128_SIM_MEMORY_TYPE, W25Q128_SIM_CAPACITY};
+            for (uint32_t i = 0; (rx != NULL) && (i < length); i++)
+            {
+                rx[i] = jedec_id[i % 3];
+            }
+            break;
+        }
+        case W25Q128_SIM_READ:
+        case W25Q128_SIM_FAST_READ:
+        case W25Q128_SIM_FAST_READ_QUAD_OUTPUT:
+        case W25Q128_SIM_FAST_READ_QUAD_IO:
+        case W25Q128_SIM_DTR_FAST_READ_QUAD_IO:
+        {
+            if (((opcode == W25Q128_SIM_FAST_READ_QUAD_OUTPUT) || (opcode == W25Q128_SIM_FAST_READ_QUAD_IO) || (opcode == W25Q128_SIM_DTR_FAST_READ_QUAD_IO)) && ((die->sr[1] & W25Q128_SIM_SR2_QE) == 0))
+            {
+                sim.stats.violations++;
+                break;
+            }
+            /* ֧DTRԸָָ߱ߵƽ */
+            if ((opcode == W25Q128_SIM_DTR_FAST_READ_QUAD_IO) && (sim.dtr_support == 0))
+            {
+                break;
+            }
+            for (uint32_t i = 0; (rx != NULL) && (i < length); i++)
+            {
+                rx[i] = *sim_cell(die_index, address + i);
+            }
+            if ((opcode == W25Q128_SIM_FAST_READ_QUAD_IO) || (opcode == W25Q128_SIM_DTR_FAST_READ_QUAD_IO))
+            {
+                if ((cmd->AlternateBytesMode != HAL_XSPI_ALT_BYTES_NONE) && ((cmd->AlternateBytes & W25Q128_SIM_CONTINUOUS_READ_MASK) == W25Q128_SIM_CONTINUOUS_READ_ENABLE))
+                {
+                    die->continuous = opcode;
+                }
+                else
+                {
+                    die->continuous = 0;
+                }
+            }
+            if (die_index == 0)
+            {
+                sim.stats.bytes_read += (uint64_t)length * ((hxspi->Init.MemoryMode == HAL_XSPI_DUAL_MEM) ? 2 : 1);
+            }
+            break;
+        }
+        case W25Q128_SIM_PAGE_PROGRAM:
+        case W25Q128_SIM_QUAD_INPUT_PAGE_PROGRAM:
+        {
+            if (((die->sr[0] & W25Q128_SIM_SR1_WEL) == 0) || (tx == NULL))
+            {
+                sim.stats.violations++;
+                break;
+            }
+            if ((opcode == W25Q128_SIM_QUAD_INPUT_PAGE_PROGRAM) && ((die->sr[1] & W25Q128_SIM_SR2_QE) == 0))
+            {
+                sim.stats.violations++;
+                break;
+            }
+            /* ҳ߽ʱƵҳףֻ1->0 */
+            page_base = address & ~(W25Q128_SIM_PAGE_SIZE - 1);
+            for (uint32_t i = 0; i < length; i++)
+            {
+                uint8_t *p = sim_cell(die_index, page_base + ((address + i) & (W25Q128_SIM_PAGE_SIZE - 1)));
+                cell = *p;
+                if ((cell & tx[i]) != tx[i])
+                {
+                    sim.stats.violations++;
+                }
+                *p = cell & tx[i];
+            }
+            if (die_index == 0)
+            {
+                sim.stats.page_programs++;
+            }
+            sim.stats.bytes_programmed += length;
+            sim_die_start_busy(die, timing->page_program);
+            break;
+        }
+        case W25Q128_SIM_SECTOR_ERASE:
+        case W25Q128_SIM_BLOCK_ERASE_32K:
+        case W25Q128_SIM_BLOCK_ERASE_64K:
+        case W25Q128_SIM_CHIP_ERASE:
+        case W25Q128_SIM_CHIP_ERASE_60:
+        {
+            /* ڼ䲻ٲ */
+            if (((die->sr[0] & W25Q128_SIM_SR1_WEL) == 0) || (die->suspended != 0))
+            {
+                sim.stats.violations++;
+                break;
+            }
+            if (opcode == W25Q128_SIM_SECTOR_ERASE)
+            {
+                sim_die_erase(die_index, address, W25Q128_SIM_DIE_SECTOR_SIZE, timing->sector_erase);
+                sim.stats.sector_erases += (die_index == 0) ? 1 : 0;
+            }
+            else if (opcode == W25Q128_SIM_BLOCK_ERASE_32K)
+            {
+                sim_die_erase(die_index, address, 0x8000UL, timing->block32_erase);
+                sim.stats.block32_erases += (die_index == 0) ? 1 : 0;
+            }
+            else if (opcode == W25Q128_SIM_BLOCK_ERASE_64K)
+            {
+                sim_die_erase(die_index, address, 0x10000UL, timing->block64_erase);
+                sim.stats.block64_erases += (die_index == 0) ? 1 : 0;
+            }
+            else
+            {
+                sim_die_erase(die_index, 0, W25Q128_SIM_DIE_SIZE, timing->chip_erase);
+                sim.stats.chip_erases += (die_index == 0) ? 1 : 0;
+            }
+            break;
+        }
+        case W25Q128_SIM_ERASE_SUSPEND:
+        {
+            /* /ɹԣtSUSWIP */
+            if ((die->busy_until == 0) || (die->busy_erase == 0))
+            {
+                break;
+            }
+            die->suspend_remaining = die->busy_until - sim.now;
+            die->suspended = 1;
+            die->sr[1] |= W25Q128_SIM_SR2_SUS;
+            sim_die_start_busy(die, timing->suspend);
+            sim.stats.suspends += (die_index == 0) ? 1 : 0;
+            break;
+        }
+        case W25Q128_SIM_ERASE_RESUME:
+        {
+            if (die->suspended == 0)
+            {
+                break;
+            }
+            die->suspended = 0;
+            die->sr[1] &= ~W25Q128_SIM_SR2_SUS;
+            sim_die_start_busy(die, die->suspend_remaining);
+            die->busy_erase = 1;
+            break;
+        }
+        case W25Q128_SIM_CONTINUOUS_READ_RESET:
+        {
+            /* δģʽʱ */
+            break;
+        }
+        default:
+        {
+            sim.stats.violations++;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief   ɵжλα
+ * @param   
+ * @retval  α
+ */
+static uint32_t sim_power_random(void)
+{
+    sim.power.seed = sim.power.seed * 1103515245UL + 12345UL;
+
+    return sim.power.seed >> 8;
+}
+
+/**
+ * @brief   жǷע루дʹܵı/
+ * @param   opcode: ָ
+ * @retval  жϽ
+ * @arg     0: 
+ * @arg     1: 
+ */
+static uint8_t sim_power_counted(uint8_t opcode)
+{
+    if ((sim.die[0].sr[0] & W25Q128_SIM_SR1_WEL) == 0)
+    {
+        return 0;
+    }
+
+    switch (opcode)
+    {
+        case W25Q128_SIM_PAGE_PROGRAM:
+        case W25Q128_SIM_QUAD_INPUT_PAGE_PROGRAM:
+        case W25Q128_SIM_SECTOR_ERASE:
+        case W25Q128_SIM_BLOCK_ERASE_32K:
+        case W25Q128_SIM_BLOCK_ERASE_64K:
+        case W25Q128_SIM_CHIP_ERASE:
+        case W25Q128_SIM_CHIP_ERASE_60:
+        {
+            return 1;
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief   Ƭִбжϵı/
+ * @note    ֻдǰһֽڣֻѲΧǰһָֻΪ0xFFౣԭ
+ * @param   hxspi: XSPIָ
+ * @param   die_index: Ƭ
+ * @param   cmd: ָ
+ * @param   tx: д뱾ƬݣƬ˳
+ * @param   length: Ƭݳ
+ * @retval  
+ */
+static void sim_die_power_cut(XSPI_HandleTypeDef *hxspi, uint32_t die_index, const XSPI_RegularCmdTypeDef *cmd, const uint8_t *tx, uint32_t length)
+{
+    uint8_t opcode = (uint8_t)cmd->Instruction;
+    uint32_t address = cmd->Address;
+    uint32_t size;
+    uint32_t base;
+    uint32_t done;
+    uint32_t offset;
+
+    if ((opcode == W25Q128_SIM_PAGE_PROGRAM) || (opcode == W25Q128_SIM_QUAD_INPUT_PAGE_PROGRAM))
+    {
+        sim_die_execute(hxspi, die_index, cmd, tx, NULL, sim_power_random() % (length + 1));
+        return;
+    }
+
+    if (hxspi->Init.MemoryMode == HAL_XSPI_DUAL_MEM)
+    {
+        address >>= 1;
+    }
+
+    if (opcode == W25Q128_SIM_SECTOR_ERASE)
+    {
+        size = W25Q128_SIM_DIE_SECTOR_SIZE;
+    }
+    else if (opcode == W25Q128_SIM_BLOCK_ERASE_32K)
+    {
+        size = 0x8000UL;
+    }
+    else if (opcode == W25Q128_SIM_BLOCK_ERASE_64K)
+    {
+        size = 0x10000UL;
+    }
+    else
+    {
+        size = W25Q128_SIM_DIE_SIZE;
+        address = 0;
+    }
+
+    base = (address % W25Q128_SIM_DIE_SIZE) & ~(size - 1);
+    done = sim_power_random() % size;
+    for (offset = 0; offset < done; offset++)
+    {
+        *sim_cell(die_index, base + offset) = 0xFF;
+    }
+    for (offset = 0; offset < done; offset += W25Q128_SIM_DIE_SECTOR_SIZE)
+    {
+        sim.die[die_index].erase_count[(base + offset) / W25Q128_SIM_DIE_SECTOR_SIZE]++;
+    }
+}
+
+/**
+ * @brief   ִһַƬ
+ * @param   hxspi: XSPIָ
+ * @param   cmd: ָ
+ * @param   tx: ݻָ루߽֯˳
+ * @param   rx: ݻָ루߽֯˳
+ * @retval  
+ */
+static void sim_execute(XSPI_HandleTypeDef *hxspi, const XSPI_RegularCmdTypeDef *cmd, const uint8_t *tx, uint8_t *rx)
+{
+    static uint8_t die_tx[W25Q128_SIM_DIE_NUM][W25Q128_SIM_DIE_SIZE / 64];
+    static uint8_t die_rx[W25Q128_SIM_DIE_NUM][W25Q128_SIM_DIE_SIZE / 64];
+    uint32_t length = (cmd->DataMode != HAL_XSPI_DATA_NONE) ? cmd->DataLength : 0;
+    uint32_t die_num = (hxspi->Init.MemoryMode == HAL_XSPI_DUAL_MEM) ? W25Q128_SIM_DIE_NUM : 1;
+    uint32_t die_length = (length + die_num - 1) / die_num;
+    uint32_t die_index;
+    uint32_t index;
+    uint8_t cut = 0;
+
+    sim.stats.commands++;
+    sim.stats.opcode_count[cmd->Instruction & 0xFFU]++;
+    if ((sim.xip != 0) && (sim.primask == 0))
+    {
+        sim.stats.xip_unmasked++;
+    }
+    sim_bus_advance(hxspi, sim_command_cycles(hxspi, cmd));
+
+    if (sim.verbose != 0)
+    {
+        printf("[%12.3f us] %-22s addr=0x%08X len=%u\n", sim.now / 1000.0, w25q128_sim_opcode_name((uint8_t)cmd->Instruction), (unsigned int)cmd->Address, (unsigned int)length);
+    }
+
+    if ((die_num == W25Q128_SIM_DIE_NUM) && (((length & 1UL) != 0) || ((cmd->Address & 1UL) != 0 && cmd->AddressMode != HAL_XSPI_ADDRESS_NONE)))
+    {
+        /* ˫洢ģʽµַ볤Ϊż */
+        sim.stats.violations++;
+    }
+
+    if (die_length > sizeof(die_tx[0]))
+    {
+        sim.stats.violations++;
+        return;
+    }
+
+    /* ֽ֯ */
+    for (index = 0; (tx != NULL) && (index < length); index++)
+    {
+        die_tx[index % die_num][index / die_num] = tx[index];
+    }
+
+    /* ע */
+    if ((sim.power.armed != 0) && (cmd->InstructionMode != HAL_XSPI_INSTRUCTION_NONE) && (sim_power_counted((uint8_t)cmd->Instruction) != 0))
+    {
+        if (sim.power.remaining == 0)
+        {
+            cut = 1;
+        }
+        else
+        {
+            sim.power.remaining--;
+        }
+    }
+
+    for (die_index = 0; die_index < die_num; die_index++)
+    {
+        if (cut != 0)
+        {
+            sim_die_power_cut(hxspi, die_index, cmd, (tx != NULL) ? die_tx[die_index] : NULL, die_length);
+        }
+        else
+        {
+            sim_die_execute(hxspi, die_index, cmd, (tx != NULL) ? die_tx[die_index] : NULL, (rx != NULL) ? die_rx[die_index] : NULL, die_length);
+        }
+    }
+
+    if (cut != 0)
+    {
+        sim.power.armed = 0;
+        sim.power.lost = 1;
+        return;
+    }
+
+    /* ϲ֯ݣʱݴλ1λ */
+    for (index = 0; (rx != NULL) && (index < length); index++)
+    {
+        rx[index] = die_rx[index % die_num][index / die_num];
+        if (sim_sampling_check(hxspi, cmd->DataDTRMode) == 0)
+        {
+            rx[index] = (uint8_t)((rx[index] << 1) | (rx[index] >> 7));
+        }
+    }
+}
+
+/**
+ * @brief   Уڴӳ
+ * @param   hxspi: XSPIָ
+ * @param   cfg: ָ
+ * @retval  У
+ * @arg     0: ô
+ * @arg     1: ȷ
+ */
+static uint8_t sim_read_cfg_check(XSPI_HandleTypeDef *hxspi, const XSPI_RegularCmdTypeDef *cfg)
+{
+    uint64_t bus_hz = W25Q128_SIM_KERNEL_CLOCK_HZ / (hxspi->Init.ClockPrescaler + 1);
+    uint32_t die_index;
+    uint8_t opcode = (uint8_t)cfg->Instruction;
+
+    if (bus_hz > W25Q128_SIM_MAX_CLOCK_HZ)
+    {
+        return 0;
+    }
+
+    /* ʡָ׶ʱƬѴͬһָģʽ */
+    if (cfg->InstructionMode == HAL_XSPI_INSTRUCTION_NONE)
+    {
+        opcode = sim.die[0].continuous;
+        for (die_index = 0; die_index < W25Q128_SIM_DIE_NUM; die_index++)
+        {
+            if ((sim.die[die_index].continuous == 0) || (sim.die[die_index].continuous != opcode))
+            {
+                return 0;
+            }
+        }
+    }
+
+    for (die_index = 0; die_index < W25Q128_SIM_DIE_NUM; die_index++)
+    {
+        if (((opcode == W25Q128_SIM_FAST_READ_QUAD_IO) || (opcode == W25Q128_SIM_DTR_FAST_READ_QUAD_IO)) && ((sim.die[die_index].sr[1] & W25Q128_SIM_SR2_QE) == 0))
+        {
+            return 0;
+        }
+    }
+
+    switch (opcode)
+    {
+        case W25Q128_SIM_READ:
+        {
+            return (cfg->DummyCycles == 0) ? 1 : 0;
+        }
+        case W25Q128_SIM_FAST_READ:
+        case W25Q128_SIM_FAST_READ_QUAD_OUTPUT:
+        {
+            return (cfg->DummyCycles == 8) ? 1 : 0;
+        }
+        case W25Q128_SIM_FAST_READ_QUAD_IO:
+        {
+            /* M7-M0ռ2ʱӣ4dummyʱ */
+            if ((cfg->AddressMode != HAL_XSPI_ADDRESS_4_LINES) || (cfg->DataMode != HAL_XSPI_DATA_4_LINES))
+            {
+                return 0;
+            }
+            if (cfg->AlternateBytesMode == HAL_XSPI_ALT_BYTES_NONE)
+            {
+                return (cfg->DummyCycles == 6) ? 1 : 0;
+            }
+            return ((cfg->AlternateBytesMode == HAL_XSPI_ALT_BYTES_4_LINES) && (cfg->DummyCycles == 4)) ? 1 : 0;
+        }
+        case W25Q128_SIM_DTR_FAST_READ_QUAD_IO:
+        {
+            /* ַM7-M0ݾΪDTRM7-M0ռ1ʱӣ7dummyʱ */
+            if ((sim.dtr_support == 0) || (bus_hz > W25Q128_SIM_MAX_DTR_CLOCK_HZ))
+            {
+                return 0;
+            }
+            if ((cfg->AddressMode != HAL_XSPI_ADDRESS_4_LINES) || (cfg->AddressDTRMode != HAL_XSPI_ADDRESS_DTR_ENABLE))
+            {
+                return 0;
+            }
+            if ((cfg->DataMode != HAL_XSPI_DATA_4_LINES) || (cfg->DataDTRMode != HAL_XSPI_DATA_DTR_ENABLE))
+            {
+                return 0;
+            }
+            return ((cfg->AlternateBytesMode == HAL_XSPI_ALT_BYTES_4_LINES) && (cfg->AlternateBytesDTRMode == HAL_XSPI_ALT_BYTES_DTR_ENABLE) && (cfg->DummyCycles == 7)) ? 1 : 0;
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief   HALXSPIʼ
+ * @param   hxspi: XSPIָ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_Init(XSPI_HandleTypeDef *hxspi)
+{
+    if ((hxspi == NULL) || (sim.image == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    /* HALһ£ڸλ״̬üĴ */
+    if (hxspi->State == HAL_XSPI_STATE_RESET)
+    {
+        hxspi->Instance->TCR = hxspi->Init.SampleShifting | hxspi->Init.DelayHoldQuarterCycle;
+    }
+
+    hxspi->State = HAL_XSPI_STATE_READY;
+    hxspi->ErrorCode = HAL_XSPI_ERROR_NONE;
+    hxspi->Timeout = HAL_XSPI_TIMEOUT_DEFAULT_VALUE;
+    w25q128_sim_window = NULL;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALXSPIʼ
+ * @param   hxspi: XSPIָ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_DeInit(XSPI_HandleTypeDef *hxspi)
+{
+    if (hxspi == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    hxspi->State = HAL_XSPI_STATE_RESET;
+    if (hxspi->Instance != NULL)
+    {
+        hxspi->Instance->TCR = 0;
+    }
+    sim.feedback_delay = 0;
+    sim.pending.type = W25Q128_SIM_PENDING_NONE;
+    w25q128_sim_window = NULL;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALXSPIM
+ * @param   hxspi: XSPIָ
+ * @param   pCfg: ָ
+ * @param   Timeout: ʱʱ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPIM_Config(XSPI_HandleTypeDef *const hxspi, XSPIM_CfgTypeDef *const pCfg, uint32_t Timeout)
+{
+    (void)pCfg;
+    (void)Timeout;
+
+    return (hxspi->State == HAL_XSPI_STATE_READY) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+ * @brief   HALXSPI
+ * @param   hxspi: XSPIָ
+ * @param   pCmd: ָ
+ * @param   Timeout: ʱʱ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_Command(XSPI_HandleTypeDef *hxspi, XSPI_RegularCmdTypeDef *const pCmd, uint32_t Timeout)
+{
+    (void)Timeout;
+
+    /* Ӧ */
+    if (sim.power.lost != 0)
+    {
+        hxspi->ErrorCode = HAL_XSPI_ERROR_TIMEOUT;
+        return HAL_ERROR;
+    }
+
+    if ((hxspi->State != HAL_XSPI_STATE_READY) && (hxspi->State != HAL_XSPI_STATE_CMD_CFG))
+    {
+        hxspi->ErrorCode = HAL_XSPI_ERROR_INVALID_SEQUENCE;
+        return HAL_ERROR;
+    }
+
+    if (pCmd->OperationType == HAL_XSPI_OPTYPE_READ_CFG)
+    {
+        sim.read_cfg = *pCmd;
+        sim.read_cfg_valid = 1;
+        hxspi->State = HAL_XSPI_STATE_READY;
+        return HAL_OK;
+    }
+
+    if (pCmd->OperationType == HAL_XSPI_OPTYPE_WRITE_CFG)
+    {
+        sim.write_cfg = *pCmd;
+        hxspi->State = HAL_XSPI_STATE_READY;
+        return HAL_OK;
+    }
+
+    sim.cmd = *pCmd;
+    if (pCmd->DataMode == HAL_XSPI_DATA_NONE)
+    {
+        sim_execute(hxspi, &sim.cmd, NULL, NULL);
+        hxspi->State = HAL_XSPI_STATE_READY;
+    }
+    else
+    {
+        hxspi->State = HAL_XSPI_STATE_CMD_CFG;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALXSPI
+ * @param   hxspi: XSPIָ
+ * @param   pData: ݻָ
+ * @param   Timeout: ʱʱ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_Transmit(XSPI_HandleTypeDef *hxspi, const uint8_t *pData, uint32_t Timeout)
+{
+    (void)Timeout;
+
+    if ((hxspi->State != HAL_XSPI_STATE_CMD_CFG) || (pData == NULL))
+    {
+        hxspi->ErrorCode = HAL_XSPI_ERROR_INVALID_SEQUENCE;
+        return HAL_ERROR;
+    }
+
+    sim_execute(hxspi, &sim.cmd, pData, NULL);
+    hxspi->State = HAL_XSPI_STATE_READY;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALXSPI
+ * @param   hxspi: XSPIָ
+ * @param   pData: ݻָ
+ * @param   Timeout: ʱʱ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_Receive(XSPI_HandleTypeDef *hxspi, uint8_t *const pData, uint32_t Timeout)
+{
+    (void)Timeout;
+
+    if ((hxspi->State != HAL_XSPI_STATE_CMD_CFG) || (pData == NULL))
+    {
+        hxspi->ErrorCode = HAL_XSPI_ERROR_INVALID_SEQUENCE;
+        return HAL_ERROR;
+    }
+
+    sim_execute(hxspi, &sim.cmd, NULL, pData);
+    hxspi->State = HAL_XSPI_STATE_READY;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   ִԶѯֱƥʱ
+ * @note    ״̬仯֮ѯִУѯֱƽʱ
+ * @param   hxspi: XSPIָ
+ * @param   cfg: Զѯָ
+ * @param   deadline: ʱʱ(ns)
+ * @retval  ѯ
+ * @arg     0: ʱ
+ * @arg     1: ƥ
+ */
+static uint8_t sim_auto_polling(XSPI_HandleTypeDef *hxspi, const XSPI_AutoPollingTypeDef *cfg, uint64_t deadline)
+{
+    uint8_t status[4] = {0};
+    uint32_t value;
+    uint32_t die_index;
+    uint64_t next_event;
+    uint64_t poll_cycles;
+    uint64_t period;
+    uint64_t skip;
+    uint8_t match;
+
+    poll_cycles = sim_command_cycles(hxspi, &sim.cmd) + cfg->IntervalTime;
+    period = poll_cycles * sim_clock_period_ns(hxspi);
+
+    while (1)
+    {
+        sim.stats.polls++;
+        sim_execute(hxspi, &sim.cmd, NULL, status);
+        value = (uint32_t)status[0] | ((uint32_t)status[1] << 8) | ((uint32_t)status[2] << 16) | ((uint32_t)status[3] << 24);
+        if (cfg->MatchMode == HAL_XSPI_MATCH_MODE_AND)
+        {
+            match = ((value & cfg->MatchMask) == cfg->MatchValue) ? 1 : 0;
+        }
+        else
+        {
+            match = (((value ^ ~cfg->MatchValue) & cfg->MatchMask) != 0) ? 1 : 0;
+        }
+        if (match != 0)
+        {
+            return 1;
+        }
+        sim_bus_advance(hxspi, cfg->IntervalTime);
+
+        /* һ״̬仯 */
+        next_event = 0;
+        for (die_index = 0; die_index < W25Q128_SIM_DIE_NUM; die_index++)
+        {
+            if ((sim.die[die_index].busy_until != 0) && ((next_event == 0) || (sim.die[die_index].busy_until < next_event)))
+            {
+                next_event = sim.die[die_index].busy_until;
+            }
+        }
+
+        if ((next_event == 0) || (next_event > deadline))
+        {
+            if (sim.now < deadline)
+            {
+                sim.now = deadline;
+            }
+            return 0;
+        }
+
+        if (next_event > sim.now)
+        {
+            skip = (next_event - sim.now) / period;
+            sim.stats.polls += (uint32_t)skip;
+            sim.stats.commands += (uint32_t)skip;
+            sim.stats.opcode_count[sim.cmd.Instruction & 0xFFU] += (uint32_t)skip;
+            sim_bus_advance(hxspi, skip * poll_cycles);
+        }
+    }
+}
+
+/**
+ * @brief   HALXSPIԶѯ
+ * @param   hxspi: XSPIָ
+ * @param   pCfg: Զѯָ
+ * @param   Timeout: ʱʱ(ms)
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_AutoPolling(XSPI_HandleTypeDef *hxspi, XSPI_AutoPollingTypeDef *const pCfg, uint32_t Timeout)
+{
+    if ((hxspi->State != HAL_XSPI_STATE_CMD_CFG) || (sim.cmd.DataLength > 4))
+    {
+        hxspi->ErrorCode = HAL_XSPI_ERROR_INVALID_SEQUENCE;
+        return HAL_ERROR;
+    }
+
+    if (sim_auto_polling(hxspi, pCfg, sim.now + (uint64_t)Timeout * 1000000ULL) == 0)
+    {
+        hxspi->State = HAL_XSPI_STATE_READY;
+        hxspi->ErrorCode = HAL_XSPI_ERROR_TIMEOUT;
+        return HAL_TIMEOUT;
+    }
+
+    hxspi->State = HAL_XSPI_STATE_READY;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALXSPIжϷʽԶѯ
+ * @note    ѯw25q128_sim_wait_event()ִ
+ * @param   hxspi: XSPIָ
+ * @param   pCfg: Զѯָ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_AutoPolling_IT(XSPI_HandleTypeDef *hxspi, XSPI_AutoPollingTypeDef *const pCfg)
+{
+    if ((hxspi->State != HAL_XSPI_STATE_CMD_CFG) || (sim.cmd.DataLength > 4) || (sim.pending.type != W25Q128_SIM_PENDING_NONE))
+    {
+        hxspi->ErrorCode = HAL_XSPI_ERROR_INVALID_SEQUENCE;
+        return HAL_ERROR;
+    }
+
+    sim.pending.type = W25Q128_SIM_PENDING_POLL;
+    sim.pending.ready = 0;
+    sim.pending.hxspi = hxspi;
+    sim.pending.polling = *pCfg;
+    hxspi->State = HAL_XSPI_STATE_BUSY_AUTO_POLLING;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALXSPI DMAʽ
+ * @param   hxspi: XSPIָ
+ * @param   pData: ݻָ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_Transmit_DMA(XSPI_HandleTypeDef *hxspi, const uint8_t *pData)
+{
+    if ((hxspi->State != HAL_XSPI_STATE_CMD_CFG) || (pData == NULL) || (sim.pending.type != W25Q128_SIM_PENDING_NONE))
+    {
+        hxspi->ErrorCode = HAL_XSPI_ERROR_INVALID_SEQUENCE;
+        return HAL_ERROR;
+    }
+
+    sim_execute(hxspi, &sim.cmd, pData, NULL);
+    sim.pending.type = W25Q128_SIM_PENDING_TX;
+    sim.pending.ready = 1;
+    sim.pending.hxspi = hxspi;
+    hxspi->State = HAL_XSPI_STATE_BUSY_TX;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALXSPIжϴ
+ * @note    w25q128_sim_wait_event()ɵжϷʽ
+ * @param   hxspi: XSPIָ
+ * @retval  
+ */
+void HAL_XSPI_IRQHandler(XSPI_HandleTypeDef *hxspi)
+{
+    uint32_t type = sim.pending.type;
+
+    if ((type == W25Q128_SIM_PENDING_NONE) || (sim.pending.ready == 0) || (sim.pending.hxspi != hxspi))
+    {
+        return;
+    }
+
+    sim.pending.type = W25Q128_SIM_PENDING_NONE;
+    sim.pending.ready = 0;
+    hxspi->State = HAL_XSPI_STATE_READY;
+
+    if (type == W25Q128_SIM_PENDING_TX)
+    {
+        HAL_XSPI_TxCpltCallback(hxspi);
+    }
+    else
+    {
+        HAL_XSPI_StatusMatchCallback(hxspi);
+    }
+}
+
+/**
+ * @brief   HALXSPIڴӳ
+ * @param   hxspi: XSPIָ
+ * @param   pCfg: ڴӳָ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_MemoryMapped(XSPI_HandleTypeDef *hxspi, XSPI_MemoryMappedTypeDef *const pCfg)
+{
+    (void)pCfg;
+
+    if ((hxspi->State != HAL_XSPI_STATE_READY) || (sim.read_cfg_valid == 0) || (sim.power.lost != 0))
+    {
+        hxspi->ErrorCode = HAL_XSPI_ERROR_INVALID_SEQUENCE;
+        return HAL_ERROR;
+    }
+
+    /* ƥʱӳ䴰ڶȫ0󲻼Υ棬ͬȫ0 */
+    if (sim_read_cfg_check(hxspi, &sim.read_cfg) != 0)
+    {
+        if (sim_sampling_check(hxspi, sim.read_cfg.DataDTRMode) != 0)
+        {
+            w25q128_sim_window = sim.image;
+        }
+        else
+        {
+            w25q128_sim_window = sim.invalid_window;
+        }
+
+        /* ָĶðM7-M0˳ģʽ */
+        if (sim.read_cfg.InstructionMode != HAL_XSPI_INSTRUCTION_NONE)
+        {
+            for (uint32_t die_index = 0; die_index < W25Q128_SIM_DIE_NUM; die_index++)
+            {
+                if ((sim.read_cfg.AlternateBytesMode != HAL_XSPI_ALT_BYTES_NONE) && ((sim.read_cfg.AlternateBytes & W25Q128_SIM_CONTINUOUS_READ_MASK) == W25Q128_SIM_CONTINUOUS_READ_ENABLE))
+                {
+                    sim.die[die_index].continuous = (uint8_t)sim.read_cfg.Instruction;
+                }
+                else
+                {
+                    sim.die[die_index].continuous = 0;
+                }
+            }
+        }
+    }
+    else
+    {
+        sim.stats.violations++;
+        w25q128_sim_window = sim.invalid_window;
+    }
+
+    sim.mmap_hxspi = hxspi;
+    sim.stats.mmap_enters++;
+    hxspi->State = HAL_XSPI_STATE_BUSY_MEM_MAPPED;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALXSPIֹ
+ * @param   hxspi: XSPIָ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_Abort(XSPI_HandleTypeDef *hxspi)
+{
+    if (hxspi->State == HAL_XSPI_STATE_RESET)
+    {
+        return HAL_ERROR;
+    }
+
+    w25q128_sim_window = NULL;
+    sim.pending.type = W25Q128_SIM_PENDING_NONE;
+    hxspi->State = HAL_XSPI_STATE_READY;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALXSPIʱӷƵ
+ * @param   hxspi: XSPIָ
+ * @param   Prescaler: Ƶϵ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_SetClockPrescaler(XSPI_HandleTypeDef *hxspi, uint32_t Prescaler)
+{
+    if (hxspi->State != HAL_XSPI_STATE_READY)
+    {
+        return HAL_ERROR;
+    }
+
+    hxspi->Init.ClockPrescaler = Prescaler;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALXSPIУ׼ӳ
+ * @note    淴ʱӳٵľԪ
+ * @param   hxspi: XSPIָ
+ * @param   pCfg: У׼ָ
+ * @retval  HAL״̬
+ */
+HAL_StatusTypeDef HAL_XSPI_SetDelayValue(XSPI_HandleTypeDef *hxspi, XSPI_HSCalTypeDef *const pCfg)
+{
+    if ((hxspi->State != HAL_XSPI_STATE_READY) || (pCfg == NULL))
+    {
+        hxspi->ErrorCode = HAL_XSPI_ERROR_INVALID_SEQUENCE;
+        return HAL_ERROR;
+    }
+
+    if (pCfg->DelayValueType == HAL_XSPI_CAL_FEEDBACK_CLK_DELAY)
+    {
+        sim.feedback_delay = pCfg->FineCalibrationUnit;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief   HALȡʱ
+ * @note    жڼ䷵ʱʱĿSysTickжϲִʱͬ
+ * @param   
+ * @retval  ʱ(ms)
+ */
+uint32_t HAL_GetTick(void)
+{
+    if (sim.primask != 0)
+    {
+        return sim.masked_tick;
+    }
+
+    return (uint32_t)(sim.now / 1000000ULL);
+}
+
+/**
+ * @brief   LLʱ
+ * @param   Delay: ʱʱ(ms)
+ * @retval  
+ */
+void LL_mDelay(uint32_t Delay)
+{
+    sim.now += (uint64_t)Delay * 1000000ULL;
+}
+
+/**
+ * @brief   (򴴽)ļ
+ * @param   path: ļ·
+ * @retval  򿪽
+ * @arg     0: 򿪳ɹ
+ * @arg     -1: ʧ
+ */
+int w25q128_sim_open(const char *path)
+{
+    struct stat st;
+    uint8_t created;
+    uint32_t die_index;
+
+    w25q128_sim_close();
+
+    sim.fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (sim.fd < 0)
+    {
+        return -1;
+    }
+
+    if (fstat(sim.fd, &st) != 0)
+    {
+        w25q128_sim_close();
+        return -1;
+    }
+
+    created = (st.st_size == 0) ? 1 : 0;
+    if ((uint64_t)st.st_size != W25Q128_SIM_IMAGE_SIZE)
+    {
+        if (ftruncate(sim.fd, W25Q128_SIM_IMAGE_SIZE) != 0)
+        {
+            w25q128_sim_close();
+            return -1;
+        }
+    }
+
+    sim.image = mmap(NULL, W25Q128_SIM_IMAGE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, sim.fd, 0);
+    sim.invalid_window = mmap(NULL, W25Q128_SIM_IMAGE_SIZE, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((sim.image == MAP_FAILED) || (sim.invalid_window == MAP_FAILED))
+    {
+        sim.image = (sim.image == MAP_FAILED) ? NULL : sim.image;
+        sim.invalid_window = (sim.invalid_window == MAP_FAILED) ? NULL : sim.invalid_window;
+        w25q128_sim_close();
+        return -1;
+    }
+
+    /* ½Ϊ״̬ */
+    if (created != 0)
+    {
+        memset(sim.image, 0xFF, W25Q128_SIM_IMAGE_SIZE);
+    }
+
+    /* ϵ״̬QEλΪʧλĬλ */
+    memset(sim.die, 0, sizeof(sim.die));
+    for (die_index = 0; die_index < W25Q128_SIM_DIE_NUM; die_index++)
+    {
+        sim.die[die_index].sr[1] = W25Q128_SIM_SR2_QE;
+    }
+    sim.now = 0;
+    sim.read_cfg_valid = 0;
+    w25q128_sim_reset_stats();
+
+    return 0;
+}
+
+/**
+ * @brief   رվļ
+ * @param   
+ * @retval  
+ */
+void w25q128_sim_close(void)
+{
+    if (sim.image != NULL)
+    {
+        msync(sim.image, W25Q128_SIM_IMAGE_SIZE, MS_SYNC);
+        munmap(sim.image, W25Q128_SIM_IMAGE_SIZE);
+        sim.image = NULL;
+    }
+
+    if (sim.invalid_window != NULL)
+    {
+        munmap(sim.invalid_window, W25Q128_SIM_IMAGE_SIZE);
+        sim.invalid_window = NULL;
+    }
+
+    if (sim.fd >= 0)
+    {
+        close(sim.fd);
+        sim.fd = -1;
+    }
+
+    w25q128_sim_window = NULL;
+}
+
+/**
+ * @brief   ʱģ
+ * @param   timing: ʱģ
+ * @retval  
+ */
+void w25q128_sim_set_timing(w25q128_sim_timing_t timing)
+{
+    sim.timing = timing;
+}
+
+/**
+ * @brief   Ƿӡÿ
+ * @param   verbose: 0: ӡ; 1: ӡ
+ * @retval  
+ */
+void w25q128_sim_set_verbose(int verbose)
+{
+    sim.verbose = verbose;
+}
+
+/**
+ * @brief   óǷڴӳ䴰
+ * @note    úδжʱxip_unmaskedĿжϷλӳ䴰ڣ
+ *          ˳ӳڼӦжϻHardFault
+ * @param   xip: 0: ڲFlashRAM; 1: ӳ䴰
+ * @retval  
+ */
+void w25q128_sim_set_xip(int xip)
+{
+    sim.xip = (xip != 0) ? 1 : 0;
+}
+
+/**
+ * @brief   ȡʱ
+ * @param   
+ * @retval  ʱ(ns)
+ */
+uint64_t w25q128_sim_now_ns(void)
+{
+    return sim.now;
+}
+
+/**
+ * @brief   ȡͳ
+ * @param   stats: ͳƽṹָ
+ * @retval  
+ */
+void w25q128_sim_get_stats(w25q128_sim_stats_t *stats)
+{
+    *stats = sim.stats;
+    stats->time_ns = sim.now - sim.stats.time_ns;
+}
+
+/**
+ * @brief   ͳ
+ * @param   
+ * @retval  
+ */
+void w25q128_sim_reset_stats(void)
+{
+    memset(&sim.stats, 0, sizeof(sim.stats));
+
+    /* ¼ͳʼʱ */
+    sim.stats.time_ns = sim.now;
+}
+
+/**
+ * @brief   ȡƬ
+ * @param   
+ * @retval  
+ */
+uint32_t w25q128_sim_max_erase_count(void)
+{
+    uint32_t die_index;
+    uint32_t sector_index;
+    uint32_t max = 0;
+
+    for (die_index = 0; die_index < W25Q128_SIM_DIE_NUM; die_index++)
+    {
+        for (sector_index = 0; sector_index < W25Q128_SIM_DIE_SECTOR_NUM; sector_index++)
+        {
+            if (sim.die[die_index].erase_count[sector_index] > max)
+            {
+                max = sim.die[die_index].erase_count[sector_index];
+            }
+        }
+    }
+
+    return max;
+}
+
+/**
+ * @brief   ȴжϷʽ
+ * @note    нежϷʽʱƽʱ䵽ʱ̣
+ *          ֮HAL_XSPI_IRQHandler()Ӧصƽ1ms
+ * @param   
+ * @retval  ȴ
+ * @arg     0: ûв
+ * @arg     1: вɣȴжϴ
+ */
+int w25q128_sim_wait_event(void)
+{
+    if (sim.pending.type == W25Q128_SIM_PENDING_TX)
+    {
+        sim.pending.ready = 1;
+        return 1;
+    }
+
+    if (sim.pending.type == W25Q128_SIM_PENDING_POLL)
+    {
+        if (sim_auto_polling(sim.pending.hxspi, &sim.pending.polling, sim.now + W25Q128_SIM_IT_POLL_LIMIT) != 0)
+        {
+            sim.pending.ready = 1;
+            return 1;
+        }
+        return 0;
+    }
+
+    sim.now += 1000000ULL;
+
+    return 0;
+}
+
+/**
+ * @brief   õ
+ * @param   operations: ǰִеı/˫ƬһΣһж
+ * @param   seed: жλα
+ * @retval  
+ */
+void w25q128_sim_set_power_cut(uint32_t operations, uint32_t seed)
+{
+    sim.power.armed = 1;
+    sim.power.remaining = operations;
+    sim.power.seed = seed;
+}
+
+/**
+ * @brief   ѯǷѵ
+ * @param   
+ * @retval  0: δ; 1: ѵ
+ */
+int w25q128_sim_power_lost(void)
+{
+    return sim.power.lost;
+}
+
+/**
+ * @brief   ģϵ
+ * @note    ʧ״̬WELæģʽXSPI³ʼnorflash_init()
+ * @param   
+ * @retval  
+ */
+void w25q128_sim_power_restore(void)
+{
+    uint32_t die_index;
+
+    for (die_index = 0; die_index < W25Q128_SIM_DIE_NUM; die_index++)
+    {
+        sim.die[die_index].sr[0] = 0;
+        sim.die[die_index].sr[1] &= (uint8_t)~W25Q128_SIM_SR2_SUS;
+        sim.die[die_index].reset_enabled = 0;
+        sim.die[die_index].continuous = 0;
+        sim.die[die_index].busy_until = 0;
+        sim.die[die_index].busy_erase = 0;
+        sim.die[die_index].suspended = 0;
+        sim.die[die_index].suspend_remaining = 0;
+    }
+    sim.power.armed = 0;
+    sim.power.lost = 0;
+    sim.read_cfg_valid = 0;
+    sim.feedback_delay = 0;
+    sim.pending.type = W25Q128_SIM_PENDING_NONE;
+    sim.pending.ready = 0;
+    w25q128_sim_window = NULL;
+}
+
+/**
+ * @brief   Ƿ֧DTRٶ
+ * @param   support: 0: ֧(W25Q128JV); 1: ֧(W25Q128FV)
+ * @retval  
+ */
+void w25q128_sim_set_dtr_support(int support)
+{
+    sim.dtr_support = (support != 0) ? 1 : 0;
+}
+
+/**
+ * @brief   ȡڴӳһͻʱ
+ * @param   length: ͻȣCacheдС
+ * @retval  ʱ(ns)δڴӳʱ0
+ */
+uint64_t w25q128_sim_mmap_read_ns(uint32_t length)
+{
+    XSPI_RegularCmdTypeDef cfg = sim.read_cfg;
+
+    if ((w25q128_sim_window == NULL) || (sim.mmap_hxspi == NULL))
+    {
+        return 0;
+    }
+
+    cfg.DataLength = length;
+
+    return sim_command_cycles(sim.mmap_hxspi, &cfg) * sim_clock_period_ns(sim.mmap_hxspi);
+}
+
+/**
+ * @brief   ڴӳ˳ʱ
+ * @note    CPUֱӷʣCRC/HASH˳괰еһݺã
+ *          һͻƽʱ䣬ݲڴʱʱ
+ * @param   data: ָ
+ * @param   length: ݳ
+ * @retval  
+ */
+void w25q128_sim_mmap_stream(const void *data, uint32_t length)
+{
+    XSPI_RegularCmdTypeDef cfg = sim.read_cfg;
+    const uint8_t *start = data;
+
+    if ((w25q128_sim_window == NULL) || (sim.mmap_hxspi == NULL) ||
+        (start < w25q128_sim_window) || (start >= (w25q128_sim_window + W25Q128_SIM_IMAGE_SIZE)))
+    {
+        return;
+    }
+
+    cfg.DataLength = length;
+    sim_bus_advance(sim.mmap_hxspi, sim_command_cycles(sim.mmap_hxspi, &cfg));
+}
+
+/**
+ * @brief   ITCM/AXI SRAMַתΪRAMָ
+ * @note    BootloaderѹΣBOOT_IMAGE_SECTION_POINTERmain.hַNULL
+ * @param   address: CPUַ
+ * @retval  RAMָ
+ */
+uint8_t *w25q128_sim_ram(uint32_t address)
+{
+    static uint8_t itcm[W25Q128_SIM_ITCM_SIZE];
+    static uint8_t axi[W25Q128_SIM_AXI_SIZE];
+
+    if ((address - W25Q128_SIM_ITCM_BASE) < W25Q128_SIM_ITCM_SIZE)
+    {
+        return &itcm[address - W25Q128_SIM_ITCM_BASE];
+    }
+    if ((address - W25Q128_SIM_AXI_BASE) < W25Q128_SIM_AXI_SIZE)
+    {
+        return &axi[address - W25Q128_SIM_AXI_BASE];
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief   ȡж״̬
+ * @param   
+ * @retval  PRIMASKֵ
+ */
+uint32_t __get_PRIMASK(void)
+{
+    return sim.primask;
+}
+
+/**
+ * @brief   ж״̬
+ * @param   primask: PRIMASKֵ
+ * @retval  
+ */
+void __set_PRIMASK(uint32_t primask)
+{
+    if ((sim.primask == 0) && (primask != 0))
+    {
+        sim.masked_tick = (uint32_t)(sim.now / 1000000ULL);
+    }
+    sim.primask = primask;
+}
+
+/**
+ * @brief   ȡDWT
+ * @note    ڼʹʱʱˢCYCCNT32λƣ
+ * @param   
+ * @retval  DWTָ
+ */
+DWT_Type *w25q128_sim_dwt(void)
+{
+    if ((w25q128_sim_dwt_instance.CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0)
+    {
+        w25q128_sim_dwt_instance.CYCCNT = (uint32_t)(sim.now * (SystemCoreClock / 1000000U) / 1000U);
+    }
+
+    return &w25q128_sim_dwt_instance;
+}
+
+/**
+ * @brief   ȡָ
+ * @param   opcode: ָ
+ * @retval  ָ
+ */
+const char *w25q128_sim_opcode_name(uint8_t opcode)
+{
+    switch (opcode)
+    {
+        case W25Q128_SIM_WRITE_STATUS_REGISTER_1: return "WRITE_STATUS_REG_1";
+        case W25Q128_SIM_PAGE_PROGRAM: return "PAGE_PROGRAM";
+        case W25Q128_SIM_READ: return "READ";
+        case W25Q128_SIM_WRITE_DISABLE: return "WRITE_DISABLE";
+        case W25Q128_SIM_READ_STATUS_REGISTER_1: return "READ_STATUS_REG_1";
+        case W25Q128_SIM_WRITE_ENABLE: return "WRITE_ENABLE";
+        case W25Q128_SIM_FAST_READ: return "FAST_READ";
+        case W25Q128_SIM_WRITE_STATUS_REGISTER_3: return "WRITE_STATUS_REG_3";
+        case W25Q128_SIM_READ_STATUS_REGISTER_3: return "READ_STATUS_REG_3";
+        case W25Q128_SIM_SECTOR_ERASE: return "SECTOR_ERASE";
+        case W25Q128_SIM_WRITE_STATUS_REGISTER_2: return "WRITE_STATUS_REG_2";
+        case W25Q128_SIM_QUAD_INPUT_PAGE_PROGRAM: return "QUAD_INPUT_PAGE_PROG";
+        case W25Q128_SIM_READ_STATUS_REGISTER_2: return "READ_STATUS_REG_2";
+        case W25Q128_SIM_BLOCK_ERASE_32K: return "BLOCK_ERASE_32K";
+        case W25Q128_SIM_CHIP_ERASE_60: return "CHIP_ERASE_60";
+        case W25Q128_SIM_ENABLE_RESET: return "ENABLE_RESET";
+        case W25Q128_SIM_FAST_READ_QUAD_OUTPUT: return "FAST_READ_QUAD_OUT";
+        case W25Q128_SIM_ERASE_SUSPEND: return "ERASE_SUSPEND";
+        case W25Q128_SIM_ERASE_RESUME: return "ERASE_RESUME";
+        case W25Q128_SIM_MANUFACTURER_DEVICE_ID: return "MANUFACTURER_DEV_ID";
+        case W25Q128_SIM_RESET_DEVICE: return "RESET_DEVICE";
+        case W25Q128_SIM_JEDEC_ID: return "JEDEC_ID";
+        case W25Q128_SIM_CHIP_ERASE: return "CHIP_ERASE";
+        case W25Q128_SIM_BLOCK_ERASE_64K: return "BLOCK_ERASE_64K";
+        case W25Q128_SIM_FAST_READ_QUAD_IO: return "FAST_READ_QUAD_IO";
+        case W25Q128_SIM_DTR_FAST_READ_QUAD_IO: return "DTR_FAST_READ_QUAD_IO";
+        case W25Q128_SIM_CONTINUOUS_READ_RESET: return "CONTINUOUS_READ_RESET";
+        default: return "UNKNOWN";
+    }
+}
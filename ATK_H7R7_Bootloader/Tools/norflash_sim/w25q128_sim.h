@@ -0,0 +1,88 @@
+/**
+ ****************************************************************************************************
+ * @file        w25q128_sim.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ˫W25Q128(XSPI˫洢ģʽ)
+ ****************************************************************************************************
+ * @attention
+ *
+ * Ƭ֯W25Q128żֽλڴ洢1ֽλڴ洢2
+ * ÿƬյĵַΪַһ룻洢ݱڴӳľļУ
+ * ļ0x90000000ڴӳ䴰ڿĲһ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __W25Q128_SIM_H
+#define __W25Q128_SIM_H
+
+#include <stdint.h>
+
+/*  */
+#define W25Q128_SIM_DIE_NUM             (2U)
+#define W25Q128_SIM_DIE_SIZE            (0x01000000UL)
+#define W25Q128_SIM_IMAGE_SIZE          (W25Q128_SIM_DIE_NUM * W25Q128_SIM_DIE_SIZE)
+#define W25Q128_SIM_DIE_SECTOR_SIZE     (0x00001000UL)
+#define W25Q128_SIM_DIE_SECTOR_NUM      (W25Q128_SIM_DIE_SIZE / W25Q128_SIM_DIE_SECTOR_SIZE)
+
+/* XSPIںʱӶ壨PLL2S */
+#define W25Q128_SIM_KERNEL_CLOCK_HZ     (200000000UL)
+
+/* ںʱӶ壨DWTڼ */
+#define W25Q128_SIM_CORE_CLOCK_HZ       (600000000UL)
+
+/* RAM壨ITCMAXI SRAMڽѹΣ */
+#define W25Q128_SIM_ITCM_BASE           (0x00000000UL)
+#define W25Q128_SIM_ITCM_SIZE           (0x00010000UL)
+#define W25Q128_SIM_AXI_BASE            (0x24000000UL)
+#define W25Q128_SIM_AXI_SIZE            (0x00072000UL)
+
+/* ʱģͶ */
+typedef enum {
+    W25Q128_SIM_TIMING_TYPICAL = 0,     /* ֲֵ */
+    W25Q128_SIM_TIMING_MAX,             /* ֲֵ */
+} w25q128_sim_timing_t;
+
+/* ͳƶ */
+typedef struct {
+    uint64_t time_ns;                   /* ʱ */
+    uint64_t bus_ns;                    /* ߴʱ */
+    uint64_t bus_cycles;                /* ʱ */
+    uint32_t commands;                  /*  */
+    uint32_t opcode_count[256];         /* ָ */
+    uint32_t polls;                     /* Զѯ״̬Ĵ */
+    uint32_t page_programs;             /* ҳ̴(˫Ƭһ) */
+    uint32_t sector_erases;             /* 4KB(˫Ƭһ) */
+    uint32_t block32_erases;            /* 32KB(˫Ƭһ) */
+    uint32_t block64_erases;            /* 64KB(˫Ƭһ) */
+    uint32_t chip_erases;               /* ȫƬ */
+    uint64_t bytes_programmed;          /* ֽ */
+    uint64_t bytes_read;                /* Ӷֽ */
+    uint32_t mmap_enters;               /* ڴӳ */
+    uint32_t suspends;                  /* (˫Ƭһ) */
+    uint32_t violations;                /* ЭΥæʱδдʹܡ1->0ı̵ȣ */
+    uint32_t xip_unmasked;              /* ӳ䴰ʱδжϷĿжȡָʧܣ */
+} w25q128_sim_stats_t;
+
+/*  */
+int w25q128_sim_open(const char *path);                             /* (򴴽)ļ */
+void w25q128_sim_close(void);                                       /* رվļ */
+void w25q128_sim_set_timing(w25q128_sim_timing_t timing);           /* ʱģ */
+void w25q128_sim_set_verbose(int verbose);                          /* ӡÿ */
+void w25q128_sim_set_xip(int xip);                                  /* óǷڴӳ䴰 */
+uint64_t w25q128_sim_now_ns(void);                                  /* ȡʱ */
+void w25q128_sim_get_stats(w25q128_sim_stats_t *stats);             /* ȡͳ */
+void w25q128_sim_reset_stats(void);                                 /* ͳ */
+uint32_t w25q128_sim_max_erase_count(void);                         /* ȡƬ */
+const char *w25q128_sim_opcode_name(uint8_t opcode);                /* ȡָ */
+int w25q128_sim_wait_event(void);                                   /* ȴжϷʽ */
+void w25q128_sim_set_dtr_support(int support);                      /* Ƿ֧DTRٶ(FV֧֣JV֧) */
+uint64_t w25q128_sim_mmap_read_ns(uint32_t length);                 /* ȡڴӳһͻʱ */
+void w25q128_sim_mmap_stream(const void *data, uint32_t length);   /* ڴӳ˳ʱ */
+uint8_t *w25q128_sim_ram(uint32_t address);                         /* ITCM/AXI SRAMַתΪRAMָ */
+void w25q128_sim_set_power_cut(uint32_t operations, uint32_t seed); /* ڵoperations+1/е */
+int w25q128_sim_power_lost(void);                                   /* ѯǷѵ */
+void w25q128_sim_power_restore(void);                               /* ģϵ */
+
+#endif /* __W25Q128_SIM_H */
@@ -0,0 +1,1367 @@
+/**
+ ****************************************************************************************************
+ * @file        tcm_place.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ܲITCM/DTCMĹ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ӳļܲѲࣨÿֽڲ򣩵ĺITCMݷDTCM
+ * scatterļER_ITCM/RW_DTCMѡÿѡΪ" ()"ҪԴмsection
+ * ER_ITCM/RW_DTCMER_ROMͬһУļת__main__scatterload
+ * main()֮ǰǴFlashƵTCMZI㣩˲Ҫƴ
+ *
+ * ֻб̵Ķ*.oοƶ⺯mc_w.lеmemcpyļ
+ * ɵĶΣƺ$$!ͷƶ__scatterload֮ǰеĺSystemInitFlash
+ * ITCMеĺFlashеĺBLָķΧER_ITCMveneerÿΰTCM_VENEER_SIZEԤ
+ *
+ * ÷: tcm_place [-i size] [-d size] [-x symbol]... [-o fragment.sct] [-s scatter.sct] app.map profile.txt
+ *       tcm_place selftest
+ *       app.map: armlink --map --symbolsɵӳļKeilĬListingsĿ¼
+ *                蹴ѡOne ELF Section per Functionarmclang -ffunction-sectionsÿǵ
+ *       profile.txt: ÿ"0xַ []"PCDWT PCĲĬΪ1
+ *                    " "üݷʼ#֮Ϊעַͣݶеİݷʼ
+ *       -i/-d: ITCM/DTCMĬϸ64KBѡֽITCM_AXI_SHARE/DTCM_AXI_SHAREıTCMСʱ޸ģ
+ *       -x: TCMķţڵΣظSystemInitų
+ *       -o: scatterƬдļĬϴӡ׼
+ *       -s: ֱӸscatterļ滻ER_ITCM/RW_DTCM"; tcm_place begin""; tcm_place end"֮ݣ
+ *           ûʱ뵽ĩβԭеѡER_ITCMеNOR Flashд·
+ *
+ ****************************************************************************************************
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* ִ壨MDK-ARM/Appliµscatterļһ£ */
+#define TCM_ITCM_REGION         "ER_ITCM"
+#define TCM_DTCM_REGION         "RW_DTCM"
+#define TCM_CODE_REGION         "ER_ROM"        /* ֻ */
+#define TCM_DATA_REGION         "RW_RAM"        /* RW/ZI */
+#define TCM_ITCM_SIZE           (0x00010000UL)
+#define TCM_DTCM_SIZE           (0x00010000UL)
+#define TCM_VENEER_SIZE         (8)             /* ÿITCMԤĳתveneer */
+
+#define TCM_NAME_MAX            (128)
+#define TCM_EXCLUDE_MAX         (16)
+#define TCM_REPORT_MAX          (40)            /* гĶ */
+#define TCM_MARK_BEGIN          "; tcm_place begin"
+#define TCM_MARK_END            "; tcm_place end"
+
+/* ηλ */
+#define TCM_PLACE_NONE          (0)
+#define TCM_PLACE_ITCM          (1)
+#define TCM_PLACE_DTCM          (2)
+
+/* ӳļ״̬ */
+#define MAP_NONE                (0)
+#define MAP_SYMBOLS             (1)             /* Image Symbol Table */
+#define MAP_MEMORY              (2)             /* Memory Map of the image */
+
+/*  */
+typedef struct {
+    uint32_t address;           /* ִеַ */
+    uint32_t size;              /*  */
+    int data;                   /* 0: , 1: ݣRO/RW/ZI */
+    int region;                 /* ִ-1:  */
+    int candidate;              /* ԷTCM */
+    int place;                  /* TCM_PLACE_xxx */
+    double hits;                /*  */
+    char name[TCM_NAME_MAX];    /* .text.main */
+    char object[TCM_NAME_MAX];  /* main.o */
+} tcm_section_t;
+
+/*  */
+typedef struct {
+    uint32_t address;           /* ַThumbȥλ */
+    char name[TCM_NAME_MAX];
+} tcm_symbol_t;
+
+/* ִ */
+typedef struct {
+    uint32_t base;
+    uint32_t size;
+    char name[TCM_NAME_MAX];
+} tcm_region_t;
+
+/* TCMʹ */
+typedef struct {
+    uint32_t capacity;          /*  */
+    uint32_t used;              /* ݣER_ITCMԭеĶΡRW_DTCMеջͶѣ */
+    uint32_t bytes;             /* ·ֽveneer */
+    uint32_t sections;          /* ·Ķ */
+    double hits;                /* ·ĶεĲ */
+    double total;               /* ͬࣨݣȫ */
+} tcm_usage_t;
+
+/* ӳ */
+typedef struct {
+    tcm_section_t *section;     /* ַ */
+    uint32_t sections;
+    uint32_t section_capacity;
+    tcm_symbol_t *symbol;
+    uint32_t symbols;
+    uint32_t symbol_capacity;
+    tcm_region_t *region;
+    uint32_t regions;
+    uint32_t region_capacity;
+    tcm_section_t **order;      /* вĺѡΣÿֽڲӸߵ */
+    uint32_t orders;
+    double total;               /* ȫ */
+    double unmatched;           /* κζеĲ */
+    double resident;            /* TCMеĲ */
+    tcm_usage_t itcm;
+    tcm_usage_t dtcm;
+} tcm_map_t;
+
+/* ı */
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} tcm_text_t;
+
+static int selftest_failures = 0;
+
+/**
+ * @brief   ӡ÷
+ * @param   name: 
+ * @retval  2
+ */
+static int usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-i size] [-d size] [-x symbol]... [-o fragment.sct] [-s scatter.sct] app.map profile.txt\n", name);
+    fprintf(stderr, "       %s selftest\n", name);
+    return 2;
+}
+
+/**
+ * @brief   
+ * @param   array: 
+ * @param   count: Ԫ
+ * @param   capacity: Ԫ
+ * @param   item: ԪشС
+ * @retval  飨ڴ治ʱ˳
+ */
+static void *array_grow(void *array, uint32_t count, uint32_t *capacity, size_t item)
+{
+    void *grown;
+
+    if (count < *capacity)
+    {
+        return array;
+    }
+
+    *capacity = (*capacity == 0) ? 256 : (*capacity * 2);
+    grown = realloc(array, *capacity * item);
+    if (grown == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    return grown;
+}
+
+/**
+ * @brief   ı׷Ӹʽı
+ * @param   text: ı
+ * @param   format: ʽ
+ * @retval  ޣڴ治ʱ˳
+ */
+static void text_printf(tcm_text_t *text, const char *format, ...)
+{
+    va_list args;
+    size_t need;
+    int length;
+
+    va_start(args, format);
+    length = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if (length < 0)
+    {
+        return;
+    }
+
+    need = text->length + (size_t)length + 1;
+    if (need > text->capacity)
+    {
+        text->capacity = need * 2;
+        text->data = realloc(text->data, text->capacity);
+        if (text->data == NULL)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+
+    va_start(args, format);
+    vsnprintf(text->data + text->length, (size_t)length + 1, format, args);
+    va_end(args);
+    text->length += (size_t)length;
+}
+
+/**
+ * @brief   ȡıļ
+ * @param   path: ļ·
+ * @retval  '\0'βļݣʧܷNULL
+ */
+static char *text_load(const char *path)
+{
+    FILE *file;
+    char *data;
+    long size;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data = (size >= 0) ? malloc((size_t)size + 1) : NULL;
+    if ((data == NULL) || (fread(data, 1, (size_t)size, file) != (size_t)size))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    data[size] = '\0';
+
+    return data;
+}
+
+/**
+ * @brief   հ׷ָһ
+ * @param   line: У޸ģ
+ * @param   token: ָ
+ * @param   max: ָ
+ * @retval  ָ
+ */
+static int split(char *line, char *token[], int max)
+{
+    char *p;
+    int count = 0;
+
+    p = strtok(line, " \t\r\n");
+    while ((p != NULL) && (count < max))
+    {
+        token[count++] = p;
+        p = strtok(NULL, " \t\r\n");
+    }
+
+    return count;
+}
+
+/**
+ * @brief   ַȽ
+ * @param   a: 
+ * @param   b: 
+ * @retval  ȽϽ
+ */
+static int compare_address(const void *a, const void *b)
+{
+    const tcm_section_t *x = a;
+    const tcm_section_t *y = b;
+
+    if (x->address != y->address)
+    {
+        return (x->address < y->address) ? -1 : 1;
+    }
+
+    return (x->size < y->size) ? -1 : (x->size > y->size);
+}
+
+/**
+ * @brief   TCMռõĿռ
+ * @note    밴4ֽڶ벢Ԥveneerݰ8ֽڶ
+ * @param   section: 
+ * @retval  ֽ
+ */
+static uint32_t section_cost(const tcm_section_t *section)
+{
+    if (section->data != 0)
+    {
+        return (section->size + 7) & ~7UL;
+    }
+
+    return ((section->size + 3) & ~3UL) + TCM_VENEER_SIZE;
+}
+
+/**
+ * @brief   ÿֽڲӸߵͱȽϺѡ
+ * @param   a: ָ
+ * @param   b: ָ
+ * @retval  ȽϽ
+ */
+static int compare_density(const void *a, const void *b)
+{
+    const tcm_section_t *x = *(tcm_section_t * const *)a;
+    const tcm_section_t *y = *(tcm_section_t * const *)b;
+    double dx = x->hits / section_cost(x);
+    double dy = y->hits / section_cost(y);
+    int res;
+
+    if (dx != dy)
+    {
+        return (dx > dy) ? -1 : 1;
+    }
+    if (x->hits != y->hits)
+    {
+        return (x->hits > y->hits) ? -1 : 1;
+    }
+
+    res = strcmp(x->object, y->object);
+
+    return (res != 0) ? res : strcmp(x->name, y->name);
+}
+
+/**
+ * @brief   ִ
+ * @param   map: ӳ
+ * @param   name: ִ
+ * @retval  ִδҵNULL
+ */
+static const tcm_region_t *map_region(const tcm_map_t *map, const char *name)
+{
+    uint32_t index;
+
+    for (index = 0; index < map->regions; index++)
+    {
+        if (strcmp(map->region[index].name, name) == 0)
+        {
+            return &map->region[index];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief   Ұַ
+ * @param   map: ӳ
+ * @param   address: ִеַ
+ * @retval  ΣδҵNULL
+ */
+static tcm_section_t *map_find(tcm_map_t *map, uint32_t address)
+{
+    uint32_t low = 0;
+    uint32_t high = map->sections;
+    uint32_t middle;
+
+    /* ҵһʼַaddressĶΣǰĿնΣ.ARM.Collect$$ */
+    while (low < high)
+    {
+        middle = (low + high) / 2;
+        if (map->section[middle].address <= address)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    while ((low > 0) && (map->section[low - 1].size == 0))
+    {
+        low--;
+    }
+    if ((low > 0) && ((address - map->section[low - 1].address) < map->section[low - 1].size))
+    {
+        return &map->section[low - 1];
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief   
+ * @param   map: ӳ
+ * @param   name: 
+ * @retval  ΣδҵNULL
+ */
+static tcm_section_t *map_symbol(tcm_map_t *map, const char *name)
+{
+    uint32_t index;
+
+    for (index = 0; index < map->symbols; index++)
+    {
+        if (strcmp(map->symbol[index].name, name) == 0)
+        {
+            return map_find(map, map->symbol[index].address);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief   Memory Mapеһ
+ * @note    ִ: Execution Region ER_ROM (Exec base: 0x90000400, Load base: 0x90000400, Size: 0x00003140, ...)
+ *          : ִеַ صַ     [*]  УPADֻǰ4
+ * @param   map: ӳ
+ * @param   line: 
+ * @retval  
+ */
+static void map_memory_line(tcm_map_t *map, char *line)
+{
+    tcm_section_t *section;
+    tcm_region_t *region;
+    char *token[12];
+    char *p;
+    int count;
+
+    p = strstr(line, "Execution Region ");
+    if (p != NULL)
+    {
+        map->region = array_grow(map->region, map->regions, &map->region_capacity, sizeof(tcm_region_t));
+        region = &map->region[map->regions++];
+        memset(region, 0, sizeof(tcm_region_t));
+        sscanf(p + 17, "%127s", region->name);
+        p = strstr(line, "Exec base:");
+        region->base = (p != NULL) ? (uint32_t)strtoul(p + 10, NULL, 0) : 0;
+        p = strstr(line, "Size:");
+        region->size = (p != NULL) ? (uint32_t)strtoul(p + 5, NULL, 0) : 0;
+        return;
+    }
+
+    count = split(line, token, 12);
+    if ((count < 8) || (strncmp(token[0], "0x", 2) != 0) || (map->regions == 0))
+    {
+        return;
+    }
+
+    map->section = array_grow(map->section, map->sections, &map->section_capacity, sizeof(tcm_section_t));
+    section = &map->section[map->sections++];
+    memset(section, 0, sizeof(tcm_section_t));
+    section->address = (uint32_t)strtoul(token[0], NULL, 16);
+    section->size = (uint32_t)strtoul(token[2], NULL, 16);
+    section->data = (strcmp(token[3], "Code") != 0);
+    section->region = (int)map->regions - 1;
+    snprintf(section->name, TCM_NAME_MAX, "%s", token[count - 2]);
+    snprintf(section->object, TCM_NAME_MAX, "%s", token[count - 1]);
+}
+
+/**
+ * @brief   Image Symbol Tableеһ
+ * @note     ֵ   ()ΪThumb Code/ARM Code/Data/Number/Sectionֻ¼
+ * @param   map: ӳ
+ * @param   line: 
+ * @retval  
+ */
+static void map_symbol_line(tcm_map_t *map, char *line)
+{
+    tcm_symbol_t *symbol;
+    char *token[8];
+    uint32_t address;
+    int count;
+    int code;
+
+    count = split(line, token, 8);
+    if ((count < 5) || (strncmp(token[1], "0x", 2) != 0))
+    {
+        return;
+    }
+
+    code = (strcmp(token[count - 3], "Code") == 0);
+    if (!code && (strcmp(token[count - 3], "Data") != 0))
+    {
+        return;
+    }
+
+    address = (uint32_t)strtoul(token[1], NULL, 16);
+    if (code)
+    {
+        address &= ~1UL;
+    }
+
+    map->symbol = array_grow(map->symbol, map->symbols, &map->symbol_capacity, sizeof(tcm_symbol_t));
+    symbol = &map->symbol[map->symbols++];
+    symbol->address = address;
+    snprintf(symbol->name, TCM_NAME_MAX, "%s", token[0]);
+}
+
+/**
+ * @brief   ȡarmlinkӳļ
+ * @param   path: ļ·
+ * @param   map: ӳ
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int map_load(const char *path, tcm_map_t *map)
+{
+    FILE *file;
+    char line[1024];
+    int state = MAP_NONE;
+
+    file = fopen(path, "r");
+    if (file == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        /* Ǹֵı */
+        if ((line[0] != ' ') && (line[0] != '\t') && (line[0] != '\r') && (line[0] != '\n') && (line[0] != '='))
+        {
+            if (strncmp(line, "Image Symbol Table", 18) == 0)
+            {
+                state = MAP_SYMBOLS;
+            }
+            else if (strncmp(line, "Memory Map of the image", 23) == 0)
+            {
+                state = MAP_MEMORY;
+            }
+            else
+            {
+                state = MAP_NONE;
+            }
+            continue;
+        }
+
+        if (state == MAP_SYMBOLS)
+        {
+            map_symbol_line(map, line);
+        }
+        else if (state == MAP_MEMORY)
+        {
+            map_memory_line(map, line);
+        }
+    }
+    fclose(file);
+
+    if (map->sections == 0)
+    {
+        fprintf(stderr, "%s: no memory map (link with --map)\n", path);
+        return -1;
+    }
+    if (map->symbols == 0)
+    {
+        fprintf(stderr, "%s: no symbol table (link with --symbols)\n", path);
+        return -1;
+    }
+
+    qsort(map->section, map->sections, sizeof(tcm_section_t), compare_address);
+
+    return 0;
+}
+
+/**
+ * @brief   ȡܲ
+ * @param   path: ļ·
+ * @param   map: ӳ
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int profile_load(const char *path, tcm_map_t *map)
+{
+    tcm_section_t *section;
+    FILE *file;
+    char line[512];
+    char *token[3];
+    char *end;
+    double weight;
+    uint32_t address;
+    int number = 0;
+    int count;
+
+    file = fopen(path, "r");
+    if (file == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        number++;
+        line[strcspn(line, "#")] = '\0';
+        count = split(line, token, 3);
+        if (count == 0)
+        {
+            continue;
+        }
+
+        weight = 1;
+        end = "";
+        if (count >= 2)
+        {
+            weight = strtod(token[1], &end);
+        }
+        if ((count > 2) || (*end != '\0') || (weight < 0))
+        {
+            fprintf(stderr, "%s:%d: expected \"0xaddress [count]\" or \"symbol count\"\n", path, number);
+            fclose(file);
+            return -1;
+        }
+
+        if ((token[0][0] == '0') && ((token[0][1] == 'x') || (token[0][1] == 'X')))
+        {
+            address = (uint32_t)strtoul(token[0], &end, 16);
+            if (*end != '\0')
+            {
+                fprintf(stderr, "%s:%d: bad address\n", path, number);
+                fclose(file);
+                return -1;
+            }
+            section = map_find(map, address);
+        }
+        else
+        {
+            section = map_symbol(map, token[0]);
+        }
+
+        if (section != NULL)
+        {
+            section->hits += weight;
+        }
+        else
+        {
+            map->unmatched += weight;
+        }
+        map->total += weight;
+    }
+    fclose(file);
+
+    if (map->total == 0)
+    {
+        fprintf(stderr, "%s: empty profile\n", path);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief   ǿԷTCM
+ * @param   map: ӳ
+ * @param   exclude: ųķ
+ * @param   excludes: ųķ
+ * @retval  
+ */
+static void map_candidates(tcm_map_t *map, char *const exclude[], int excludes)
+{
+    static const char *const fixed[] = {"SystemInit"};
+    const char *startup = "";
+    const char *region;
+    tcm_section_t *section;
+    size_t length;
+    uint32_t index;
+    int number;
+
+    /* ڵļ */
+    for (index = 0; index < map->sections; index++)
+    {
+        if (strcmp(map->section[index].name, "RESET") == 0)
+        {
+            startup = map->section[index].object;
+        }
+    }
+
+    for (index = 0; index < map->sections; index++)
+    {
+        section = &map->section[index];
+        region = (section->region >= 0) ? map->region[section->region].name : "";
+        length = strlen(section->object);
+        section->candidate = (section->size != 0) &&
+                             ((strcmp(region, TCM_CODE_REGION) == 0) || (section->data && (strcmp(region, TCM_DATA_REGION) == 0))) &&
+                             (length > 2) && (strcmp(section->object + length - 2, ".o") == 0) &&
+                             (strchr(section->object, '(') == NULL) && (strcmp(section->object, startup) != 0) &&
+                             (section->name[0] != '!') && (strstr(section->name, "$$") == NULL);
+    }
+
+    for (number = 0; number < (int)(sizeof(fixed) / sizeof(fixed[0])); number++)
+    {
+        section = map_symbol(map, fixed[number]);
+        if (section != NULL)
+        {
+            section->candidate = 0;
+        }
+    }
+    for (number = 0; number < excludes; number++)
+    {
+        section = map_symbol(map, exclude[number]);
+        if (section != NULL)
+        {
+            section->candidate = 0;
+        }
+        else
+        {
+            fprintf(stderr, "warning: -x %s: no such symbol\n", exclude[number]);
+        }
+    }
+}
+
+/**
+ * @brief   ÿֽڲӸߵͰѺѡηITCM/DTCM
+ * @note    ŲµĶԺСĶ
+ * @param   map: ӳ
+ * @param   itcm_size: ITCM
+ * @param   dtcm_size: DTCM
+ * @retval  
+ */
+static void map_place(tcm_map_t *map, uint32_t itcm_size, uint32_t dtcm_size)
+{
+    const tcm_region_t *region;
+    tcm_section_t *section;
+    tcm_usage_t *usage;
+    uint32_t index;
+    uint32_t cost;
+
+    memset(&map->itcm, 0, sizeof(tcm_usage_t));
+    memset(&map->dtcm, 0, sizeof(tcm_usage_t));
+    map->itcm.capacity = itcm_size;
+    map->dtcm.capacity = dtcm_size;
+    region = map_region(map, TCM_ITCM_REGION);
+    map->itcm.used = (region != NULL) ? region->size : 0;
+    region = map_region(map, TCM_DTCM_REGION);
+    map->dtcm.used = (region != NULL) ? region->size : 0;
+
+    free(map->order);
+    map->order = malloc((map->sections + 1) * sizeof(tcm_section_t *));
+    if (map->order == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    map->orders = 0;
+    map->resident = 0;
+
+    for (index = 0; index < map->sections; index++)
+    {
+        section = &map->section[index];
+        section->place = TCM_PLACE_NONE;
+        usage = section->data ? &map->dtcm : &map->itcm;
+        usage->total += section->hits;
+        if ((section->region >= 0) && ((strcmp(map->region[section->region].name, TCM_ITCM_REGION) == 0) ||
+                                       (strcmp(map->region[section->region].name, TCM_DTCM_REGION) == 0)))
+        {
+            map->resident += section->hits;
+        }
+        if (section->candidate && (section->hits > 0))
+        {
+            map->order[map->orders++] = section;
+        }
+    }
+    qsort(map->order, map->orders, sizeof(tcm_section_t *), compare_density);
+
+    for (index = 0; index < map->orders; index++)
+    {
+        section = map->order[index];
+        usage = section->data ? &map->dtcm : &map->itcm;
+        cost = section_cost(section);
+        if ((usage->used + usage->bytes + cost) <= usage->capacity)
+        {
+            section->place = section->data ? TCM_PLACE_DTCM : TCM_PLACE_ITCM;
+            usage->bytes += cost;
+            usage->sections++;
+            usage->hits += section->hits;
+        }
+    }
+}
+
+/**
+ * @brief   ٷֱ
+ * @param   part: 
+ * @param   total: 
+ * @retval  ٷֱ
+ */
+static double percent(double part, double total)
+{
+    return (total > 0) ? (part * 100.0 / total) : 0;
+}
+
+/**
+ * @brief   ӡ
+ * @param   map: ӳ
+ * @retval  
+ */
+static void map_report(const tcm_map_t *map)
+{
+    static const char *const place_name[] = {"-", "ITCM", "DTCM"};
+    const tcm_section_t *section;
+    char selector[TCM_NAME_MAX * 2 + 4];
+    uint32_t index;
+
+    printf("map: %u sections, %u symbols\n", (unsigned int)map->sections, (unsigned int)map->symbols);
+    printf("profile: %.0f samples, %.0f unmatched, %.0f already in TCM\n", map->total, map->unmatched, map->resident);
+    printf("ITCM: %u sections, %u bytes added, %u/%u bytes used, %.1f%% of %.0f code samples\n",
+           (unsigned int)map->itcm.sections, (unsigned int)map->itcm.bytes, (unsigned int)(map->itcm.used + map->itcm.bytes),
+           (unsigned int)map->itcm.capacity, percent(map->itcm.hits, map->itcm.total), map->itcm.total);
+    printf("DTCM: %u sections, %u bytes added, %u/%u bytes used, %.1f%% of %.0f data samples\n",
+           (unsigned int)map->dtcm.sections, (unsigned int)map->dtcm.bytes, (unsigned int)(map->dtcm.used + map->dtcm.bytes),
+           (unsigned int)map->dtcm.capacity, percent(map->dtcm.hits, map->dtcm.total), map->dtcm.total);
+
+    printf("\n%5s  %-5s %10s %8s %10s  %s\n", "rank", "place", "samples", "bytes", "per byte", "section");
+    for (index = 0; (index < map->orders) && (index < TCM_REPORT_MAX); index++)
+    {
+        section = map->order[index];
+        snprintf(selector, sizeof(selector), "%s (%s)", section->object, section->name);
+        printf("%5u  %-5s %10.0f %8u %10.3f  %s\n", (unsigned int)(index + 1), place_name[section->place], section->hits,
+               (unsigned int)section->size, section->hits / section_cost(section), selector);
+    }
+    if (map->orders > TCM_REPORT_MAX)
+    {
+        printf("  ... %u more\n", (unsigned int)(map->orders - TCM_REPORT_MAX));
+    }
+    printf("\n");
+}
+
+/**
+ * @brief   һִѡ
+ * @param   text: 
+ * @param   map: ӳ
+ * @param   place: TCM_PLACE_ITCM/TCM_PLACE_DTCM
+ * @retval  
+ */
+static void block_write(tcm_text_t *text, const tcm_map_t *map, int place)
+{
+    const tcm_usage_t *usage = (place == TCM_PLACE_ITCM) ? &map->itcm : &map->dtcm;
+    const tcm_section_t *section;
+    char selector[TCM_NAME_MAX * 2 + 4];
+    uint32_t index;
+
+    text_printf(text, "   %s: %u sections, %u bytes, %.1f%% of %s samples\n", TCM_MARK_BEGIN, (unsigned int)usage->sections,
+                (unsigned int)usage->bytes, percent(usage->hits, usage->total), (place == TCM_PLACE_ITCM) ? "code" : "data");
+    for (index = 0; index < map->orders; index++)
+    {
+        section = map->order[index];
+        if (section->place == place)
+        {
+            snprintf(selector, sizeof(selector), "%s (%s)", section->object, section->name);
+            text_printf(text, "   %-44s ; %.0f samples, %u bytes\n", selector, section->hits, (unsigned int)section->size);
+        }
+    }
+    text_printf(text, "   %s\n", TCM_MARK_END);
+}
+
+/**
+ * @brief   ѡдscatterļִ
+ * @note    ɾԭе"; tcm_place begin""; tcm_place end""}"֮ǰblock
+ * @param   input: scatterļ
+ * @param   output: 
+ * @param   region: ִ
+ * @param   block: ѡ
+ * @retval  0: ɹ, -1: δҵִ
+ */
+static int scatter_insert(const char *input, tcm_text_t *output, const char *region, const char *block)
+{
+    const char *line = input;
+    const char *next;
+    const char *trimmed;
+    char first[TCM_NAME_MAX];
+    size_t length;
+    int state = 0;  /* 0: ֮ǰ, 1: , 2: ɵѡ, 3: Ѳ */
+
+    while (*line != '\0')
+    {
+        next = strchr(line, '\n');
+        length = (next != NULL) ? (size_t)(next - line + 1) : strlen(line);
+        trimmed = line + strspn(line, " \t");
+
+        if (state == 0)
+        {
+            if ((sscanf(trimmed, "%127s", first) == 1) && (strcmp(first, region) == 0) && (memchr(line, '{', length) != NULL))
+            {
+                state = 1;
+            }
+        }
+        else if (state == 1)
+        {
+            if (strncmp(trimmed, TCM_MARK_BEGIN, strlen(TCM_MARK_BEGIN)) == 0)
+            {
+                state = 2;
+                line += length;
+                continue;
+            }
+            if (*trimmed == '}')
+            {
+                text_printf(output, "%s", block);
+                state = 3;
+            }
+        }
+        else if (state == 2)
+        {
+            if (strncmp(trimmed, TCM_MARK_END, strlen(TCM_MARK_END)) == 0)
+            {
+                state = 1;
+            }
+            line += length;
+            continue;
+        }
+
+        text_printf(output, "%.*s", (int)length, line);
+        line += length;
+    }
+
+    if (state != 3)
+    {
+        fprintf(stderr, "%s: execution region not found\n", region);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief   scatterļ
+ * @param   path: ļ·
+ * @param   itcm: ER_ITCMѡ
+ * @param   dtcm: RW_DTCMѡ
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int scatter_update(const char *path, const char *itcm, const char *dtcm)
+{
+    tcm_text_t first = {NULL, 0, 0};
+    tcm_text_t second = {NULL, 0, 0};
+    FILE *file;
+    char *input;
+    int res = -1;
+
+    input = text_load(path);
+    if (input == NULL)
+    {
+        return -1;
+    }
+
+    if ((scatter_insert(input, &first, TCM_ITCM_REGION, itcm) == 0) &&
+        (scatter_insert(first.data, &second, TCM_DTCM_REGION, dtcm) == 0))
+    {
+        file = fopen(path, "wb");
+        if ((file != NULL) && (fwrite(second.data, 1, second.length, file) == second.length) && (fclose(file) == 0))
+        {
+            res = 0;
+        }
+        else
+        {
+            perror(path);
+        }
+    }
+
+    free(input);
+    free(first.data);
+    free(second.data);
+
+    return res;
+}
+
+/**
+ * @brief   ͷӳ
+ * @param   map: ӳ
+ * @retval  
+ */
+static void map_free(tcm_map_t *map)
+{
+    free(map->section);
+    free(map->symbol);
+    free(map->region);
+    free(map->order);
+    memset(map, 0, sizeof(tcm_map_t));
+}
+
+/**
+ * @brief   ȡӳTCM
+ * @param   map: ӳ
+ * @param   map_path: ӳļ
+ * @param   profile_path: ļ
+ * @param   itcm_size: ITCM
+ * @param   dtcm_size: DTCM
+ * @param   exclude: ųķ
+ * @param   excludes: ųķ
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int tcm_run(tcm_map_t *map, const char *map_path, const char *profile_path, uint32_t itcm_size, uint32_t dtcm_size,
+                   char *const exclude[], int excludes)
+{
+    memset(map, 0, sizeof(tcm_map_t));
+    if ((map_load(map_path, map) != 0) || (profile_load(profile_path, map) != 0))
+    {
+        return -1;
+    }
+
+    map_candidates(map, exclude, excludes);
+    map_place(map, itcm_size, dtcm_size);
+
+    return 0;
+}
+
+/**
+ * @brief   Բ
+ * @param   name: 
+ * @param   ok: 
+ * @retval  
+ */
+static void selftest_check(const char *name, int ok)
+{
+    printf("%-32s %s\n", name, ok ? "ok" : "FAIL");
+    if (!ok)
+    {
+        selftest_failures++;
+    }
+}
+
+/**
+ * @brief   Ҷεķλ
+ * @param   map: ӳ
+ * @param   symbol: еķ
+ * @retval  TCM_PLACE_xxxδҵ-1
+ */
+static int selftest_place(tcm_map_t *map, const char *symbol)
+{
+    const tcm_section_t *section = map_symbol(map, symbol);
+
+    return (section != NULL) ? section->place : -1;
+}
+
+/* Բӳarmlink --map --symbolsĸʽѡ */
+static const char selftest_map_text[] =
+    "Component: Arm Compiler for Embedded 6.21 Tool: armlink [5ec1fa00]\n"
+    "\n"
+    "==============================================================================\n"
+    "\n"
+    "Section Cross References\n"
+    "\n"
+    "    startup_stm32h7r7xx.o(RESET) refers to startup_stm32h7r7xx.o(STACK) for __initial_sp\n"
+    "    main.o(.text.hot) refers to dsp.o(.text.warm) for warm\n"
+    "\n"
+    "==============================================================================\n"
+    "\n"
+    "Image Symbol Table\n"
+    "\n"
+    "    Local Symbols\n"
+    "\n"
+    "    Symbol Name                              Value     Ov Type        Size  Object(Section)\n"
+    "\n"
+    "    RESET                                    0x90000400   Section      716  startup_stm32h7r7xx.o(RESET)\n"
+    "    .text.cold                               0x90000900   Section        0  main.o(.text.cold)\n"
+    "    cold                                     0x90000901   Thumb Code    64  main.o(.text.cold)\n"
+    "    state                                    0x24000000   Data          16  main.o(.data.state)\n"
+    "\n"
+    "    Global Symbols\n"
+    "\n"
+    "    Symbol Name                              Value     Ov Type        Size  Object(Section)\n"
+    "\n"
+    "    BuildAttributes$$THM_ISAv4$E$P$D$K$B$S$7EM$VFPi3$EXTD16$VFPS$VFMA$PE$A:L22UL41UL21$X:L11$S22US41US21$IEEE1$IW$~IW$USESV6$~STKCKD$USESV7$~SHL$OTIME$ROPI$IEEEJ$EBA8$UX$STANDARDLIB$REQ8$PRES8$EABIv2 0x00000000   Number         0  anon$$obj.o ABSOLUTE\n"
+    "    __main                                   0x900006cd   Thumb Code     0  entry.o(.ARM.Collect$$$$00000000)\n"
+    "    Reset_Handler                            0x900006d1   Thumb Code     8  startup_stm32h7r7xx.o(.text)\n"
+    "    __aeabi_memcpy                           0x90000711   Thumb Code     0  memcpya.o(.text)\n"
+    "    SystemInit                               0x90000775   Thumb Code   140  system_stm32h7rsxx.o(.text.SystemInit)\n"
+    "    hot                                      0x90000801   Thumb Code   256  main.o(.text.hot)\n"
+    "    warm                                     0x90000941   Thumb Code 12288  dsp.o(.text.warm)\n"
+    "    table                                    0x90003940   Data         512  table.o(.rodata.table)\n"
+    "    norflash_write                           0x00000001   Thumb Code  8192  norflash_w25q128.o(.text.norflash_write)\n"
+    "    buffer                                   0x24000010   Data        2048  main.o(.bss.buffer)\n"
+    "    big                                      0x24000810   Data      131072  dsp.o(.bss.big)\n"
+    "\n"
+    "\n"
+    "\n"
+    "==============================================================================\n"
+    "\n"
+    "Memory Map of the image\n"
+    "\n"
+    "  Image Entry point : 0x900006cd\n"
+    "\n"
+    "  Load Region LOAD_FLASH (Base: 0x90000400, Size: 0x00005b50, Max: 0x00fdfc00, ABSOLUTE)\n"
+    "\n"
+    "    Execution Region ER_ROM (Exec base: 0x90000400, Load base: 0x90000400, Size: 0x00003740, Max: 0x00fdfc00, ABSOLUTE)\n"
+    "\n"
+    "    Exec Addr    Load Addr    Size         Type   Attr      Idx    E Section Name        Object\n"
+    "\n"
+    "    0x90000400   0x90000400   0x000002cc   Data   RO            3    RESET               startup_stm32h7r7xx.o\n"
+    "    0x900006cc   0x900006cc   0x00000000   Code   RO          210  * .ARM.Collect$$$$00000000  mc_w.l(entry.o)\n"
+    "    0x900006d0   0x900006d0   0x00000040   Code   RO            4    .text               startup_stm32h7r7xx.o\n"
+    "    0x90000710   0x90000710   0x00000062   Code   RO          221    .text               mc_w.l(memcpya.o)\n"
+    "    0x90000772   0x90000772   0x00000002   PAD\n"
+    "    0x90000774   0x90000774   0x0000008c   Code   RO           12    .text.SystemInit    system_stm32h7rsxx.o\n"
+    "    0x90000800   0x90000800   0x00000100   Code   RO           20    .text.hot           main.o\n"
+    "    0x90000900   0x90000900   0x00000040   Code   RO           22    .text.cold          main.o\n"
+    "    0x90000940   0x90000940   0x00003000   Code   RO           30    .text.warm          dsp.o\n"
+    "    0x90003940   0x90003940   0x00000200   Data   RO           40    .rodata.table       table.o\n"
+    "\n"
+    "\n"
+    "    Execution Region ER_ITCM (Exec base: 0x00000000, Load base: 0x90003b40, Size: 0x00002000, Max: 0x00010000, ABSOLUTE)\n"
+    "\n"
+    "    Exec Addr    Load Addr    Size         Type   Attr      Idx    E Section Name        Object\n"
+    "\n"
+    "    0x00000000   0x90003b40   0x00002000   Code   RO           50    .text.norflash_write  norflash_w25q128.o\n"
+    "\n"
+    "\n"
+    "    Execution Region RW_DTCM (Exec base: 0x20000000, Load base: 0x90005b40, Size: 0x00000600, Max: 0x00010000, ABSOLUTE, UNINIT)\n"
+    "\n"
+    "    Exec Addr    Load Addr    Size         Type   Attr      Idx    E Section Name        Object\n"
+    "\n"
+    "    0x20000000        -       0x00000400   Zero   RW            2    STACK               startup_stm32h7r7xx.o\n"
+    "    0x20000400        -       0x00000200   Zero   RW            1    HEAP                startup_stm32h7r7xx.o\n"
+    "\n"
+    "\n"
+    "    Execution Region RW_RAM (Exec base: 0x24000000, Load base: 0x90005b40, Size: 0x00020810, Max: 0x0004fc00, ABSOLUTE)\n"
+    "\n"
+    "    Exec Addr    Load Addr    Size         Type   Attr      Idx    E Section Name        Object\n"
+    "\n"
+    "    0x24000000   0x90005b40   0x00000010   Data   RW           60    .data.state         main.o\n"
+    "    0x24000010        -       0x00000800   Zero   RW           61    .bss.buffer         main.o\n"
+    "    0x24000810        -       0x00020000   Zero   RW           62    .bss.big            dsp.o\n"
+    "\n"
+    "\n"
+    "==============================================================================\n"
+    "\n"
+    "Image component sizes\n"
+    "\n"
+    "      Code (inc. data)   RO Data    RW Data    ZI Data      Debug   Object Name\n"
+    "\n"
+    "       256         16          0          0          0        512   main.o\n";
+
+/* ԲscatterļER_ITCMѡ */
+static const char selftest_scatter_text[] =
+    "LOAD_FLASH 0x90000400 0x00FDFC00  {    ; load region size_region\n"
+    "  ER_ROM 0x90000400 0x00FDFC00  {  ; load address = execution address\n"
+    "   *.o (RESET, +First)\n"
+    "   .ANY (+RO)\n"
+    "  }\n"
+    "\n"
+    "  ER_ITCM 0x00000000 0x00010000  {  ; NOR Flash write path\n"
+    "   norflash_w25q128.o (+RO)\n"
+    "  }\n"
+    "\n"
+    "  RW_DTCM 0x20000000 0x00010000  {  ; RW data\n"
+    "   *(STACK)\n"
+    "   *(HEAP)\n"
+    "  }\n"
+    "}\n";
+
+/**
+ * @brief   дıļ
+ * @param   path: ļ·
+ * @param   text: 
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int selftest_write(const char *path, const char *text)
+{
+    FILE *file;
+    int res;
+
+    file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    res = (fputs(text, file) >= 0) ? 0 : -1;
+    if (fclose(file) != 0)
+    {
+        res = -1;
+    }
+
+    return res;
+}
+
+/**
+ * @brief   Բ
+ * @note    selftest.mapselftest_profile.txtmake testһ
+ * @param   
+ * @retval  0: ͨ, 1: ʧ
+ */
+static int cmd_selftest(void)
+{
+    static char *const exclude[] = {"cold"};
+    const char *map_path = "selftest.map";
+    const char *profile_path = "selftest_profile.txt";
+    const char *scatter_path = "selftest.sct";
+    tcm_text_t profile = {NULL, 0, 0};
+    tcm_text_t itcm = {NULL, 0, 0};
+    tcm_text_t dtcm = {NULL, 0, 0};
+    tcm_text_t scratch = {NULL, 0, 0};
+    tcm_map_t map;
+    char *first;
+    char *second;
+    char *p;
+    int index;
+
+    /* PChot 1000300Ĳwarm 600cold 10SystemInit 500⺯300ITCM50Чַ5 */
+    text_printf(&profile, "# PC samples\n0x90000802 700\n");
+    for (index = 0; index < 300; index++)
+    {
+        text_printf(&profile, "0x%08X\n", 0x90000800U + (unsigned int)(index % 128) * 2);
+    }
+    text_printf(&profile, "0x90000950 600\n0x90000910 10\n0x90000780 500\n0x90000720 300\n0x00000100 50\n0x12345678 5\n");
+    /* ݷʼ */
+    text_printf(&profile, "\nbuffer 400\nstate 100   # .data\nbig 900\ntable 50\nnosuch 7\n");
+
+    selftest_check("write map", selftest_write(map_path, selftest_map_text) == 0);
+    selftest_check("write profile", selftest_write(profile_path, profile.data) == 0);
+
+    /* ITCMʣ0x2000warmŲ */
+    selftest_check("load", tcm_run(&map, map_path, profile_path, 0x4000, 0x8000, NULL, 0) == 0);
+    selftest_check("parse", (map.sections == 15) && (map.symbols == 12) && (map.regions == 4));
+    selftest_check("samples", (map.total == 3922) && (map.unmatched == 12) && (map.resident == 50));
+    selftest_check("hot in ITCM", selftest_place(&map, "hot") == TCM_PLACE_ITCM);
+    selftest_check("cold in ITCM", selftest_place(&map, "cold") == TCM_PLACE_ITCM);
+    selftest_check("warm does not fit", selftest_place(&map, "warm") == TCM_PLACE_NONE);
+    selftest_check("SystemInit stays in flash", selftest_place(&map, "SystemInit") == TCM_PLACE_NONE);
+    selftest_check("library stays in flash", selftest_place(&map, "__aeabi_memcpy") == TCM_PLACE_NONE);
+    selftest_check("startup stays in flash", selftest_place(&map, "Reset_Handler") == TCM_PLACE_NONE);
+    selftest_check("ITCM usage", (map.itcm.used == 0x2000) && (map.itcm.sections == 2) && (map.itcm.bytes == (264 + 72)) &&
+                                 (map.itcm.hits == 1010) && (map.itcm.total == 2460));
+    selftest_check("data in DTCM", (selftest_place(&map, "buffer") == TCM_PLACE_DTCM) && (selftest_place(&map, "state") == TCM_PLACE_DTCM) &&
+                                   (selftest_place(&map, "table") == TCM_PLACE_DTCM));
+    selftest_check("big does not fit", selftest_place(&map, "big") == TCM_PLACE_NONE);
+    selftest_check("DTCM usage", (map.dtcm.used == 0x600) && (map.dtcm.sections == 3) && (map.dtcm.hits == 550) && (map.dtcm.total == 1450));
+    selftest_check("rank by samples per byte", (map.orders == 7) && (strcmp(map.order[0]->name, ".data.state") == 0) &&
+                                               (strcmp(map.order[1]->name, ".text.hot") == 0));
+    map_report(&map);
+
+    block_write(&itcm, &map, TCM_PLACE_ITCM);
+    block_write(&dtcm, &map, TCM_PLACE_DTCM);
+    printf("%s%s\n", itcm.data, dtcm.data);
+    selftest_check("selector", (strstr(itcm.data, "   main.o (.text.hot)") != NULL) && (strstr(itcm.data, "dsp.o") == NULL) &&
+                               (strstr(dtcm.data, "   table.o (.rodata.table)") != NULL));
+
+    /* дscatterļٴд滻ԭеѡ */
+    selftest_check("write scatter", selftest_write(scatter_path, selftest_scatter_text) == 0);
+    selftest_check("update scatter", scatter_update(scatter_path, itcm.data, dtcm.data) == 0);
+    first = text_load(scatter_path);
+    p = (first != NULL) ? strstr(first, "ER_ITCM") : NULL;
+    selftest_check("selectors in ER_ITCM", (p != NULL) && (strstr(p, "norflash_w25q128.o (+RO)") < strstr(p, "main.o (.text.hot)")) &&
+                                           (strstr(p, "main.o (.text.hot)") < strstr(p, "  }")));
+    p = (first != NULL) ? strstr(first, "RW_DTCM") : NULL;
+    selftest_check("selectors in RW_DTCM", (p != NULL) && (strstr(p, "*(HEAP)") < strstr(p, "main.o (.bss.buffer)")) &&
+                                           (strstr(p, "main.o (.bss.buffer)") < strstr(p, "  }")));
+    selftest_check("update again", scatter_update(scatter_path, itcm.data, dtcm.data) == 0);
+    second = text_load(scatter_path);
+    selftest_check("update replaces", (first != NULL) && (second != NULL) && (strcmp(first, second) == 0));
+    free(first);
+    free(second);
+    selftest_check("missing region", scatter_insert("LOAD 0x0 {\n}\n", &scratch, TCM_ITCM_REGION, itcm.data) != 0);
+    map_free(&map);
+
+    /* ĬwarmԷ룬-xųķFlash */
+    selftest_check("load default size", tcm_run(&map, map_path, profile_path, TCM_ITCM_SIZE, TCM_DTCM_SIZE, exclude, 1) == 0);
+    selftest_check("warm in ITCM", selftest_place(&map, "warm") == TCM_PLACE_ITCM);
+    selftest_check("excluded cold", selftest_place(&map, "cold") == TCM_PLACE_NONE);
+    map_free(&map);
+
+    selftest_check("reject map without memory map", (selftest_write(scatter_path, "Image Symbol Table\n") == 0) &&
+                                                    (tcm_run(&map, scatter_path, profile_path, TCM_ITCM_SIZE, TCM_DTCM_SIZE, NULL, 0) != 0));
+    map_free(&map);
+    selftest_check("reject bad profile", (selftest_write(scatter_path, "hot 1 2\n") == 0) &&
+                                         (tcm_run(&map, map_path, scatter_path, TCM_ITCM_SIZE, TCM_DTCM_SIZE, NULL, 0) != 0));
+    map_free(&map);
+
+    remove(scatter_path);
+    free(profile.data);
+    free(itcm.data);
+    free(dtcm.data);
+    free(scratch.data);
+    printf("%s\n", (selftest_failures == 0) ? "PASS" : "FAIL");
+
+    return (selftest_failures == 0) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    char *exclude[TCM_EXCLUDE_MAX];
+    tcm_text_t itcm = {NULL, 0, 0};
+    tcm_text_t dtcm = {NULL, 0, 0};
+    tcm_map_t map;
+    const char *output = NULL;
+    const char *scatter = NULL;
+    uint32_t itcm_size = TCM_ITCM_SIZE;
+    uint32_t dtcm_size = TCM_DTCM_SIZE;
+    FILE *file;
+    int excludes = 0;
+    int res = 0;
+    int opt;
+
+    if ((argc == 2) && (strcmp(argv[1], "selftest") == 0))
+    {
+        return cmd_selftest();
+    }
+
+    while ((opt = getopt(argc, argv, "i:d:x:o:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'i':
+                itcm_size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                dtcm_size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'x':
+                if (excludes >= TCM_EXCLUDE_MAX)
+                {
+                    fprintf(stderr, "too many -x\n");
+                    return 2;
+                }
+                exclude[excludes++] = optarg;
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            case 's':
+                scatter = optarg;
+                break;
+            default:
+                return usage(argv[0]);
+        }
+    }
+    if ((argc - optind) != 2)
+    {
+        return usage(argv[0]);
+    }
+
+    if (tcm_run(&map, argv[optind], argv[optind + 1], itcm_size, dtcm_size, exclude, excludes) != 0)
+    {
+        map_free(&map);
+        return 1;
+    }
+    map_report(&map);
+    block_write(&itcm, &map, TCM_PLACE_ITCM);
+    block_write(&dtcm, &map, TCM_PLACE_DTCM);
+
+    if (scatter != NULL)
+    {
+        if (scatter_update(scatter, itcm.data, dtcm.data) != 0)
+        {
+            res = 1;
+        }
+        else
+        {
+            printf("%s: %s and %s updated\n", scatter, TCM_ITCM_REGION, TCM_DTCM_REGION);
+        }
+    }
+    else
+    {
+        file = (output != NULL) ? fopen(output, "w") : stdout;
+        if (file == NULL)
+        {
+            perror(output);
+            res = 1;
+        }
+        else
+        {
+            fprintf(file, "; %s\n%s; %s\n%s", TCM_ITCM_REGION, itcm.data, TCM_DTCM_REGION, dtcm.data);
+            if (output != NULL)
+            {
+                fclose(file);
+            }
+        }
+    }
+
+    free(itcm.data);
+    free(dtcm.data);
+    map_free(&map);
+
+    return res;
+}
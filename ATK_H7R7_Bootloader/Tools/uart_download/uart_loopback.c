@@ -0,0 +1,428 @@
+/**
+ ****************************************************************************************************
+ * @file        uart_loopback.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       αն˻ػ
+ ****************************************************************************************************
+ * @attention
+ *
+ * αն˴Ӷuart_sendΪ豸ڣBSP/uart_download.cд
+ * Tools/norflash_simNOR Flash첽дں̨ʱɣֽڱȶ
+ * -e N: 豸ÿNֽڷתһֽڣ-d N: 豸ÿNֽڶһֽڣNAKʱش
+ *
+ * ÷: uart_loopback [-a ַ] [-b ] [-e N] [-d N] [-s ͹] ļ
+ *
+ ****************************************************************************************************
+ */
+
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+
+#include "uart_download.h"
+#include "norflash_w25q128.h"
+#include "w25q128_sim.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define LOOPBACK_IMAGE          "uart_loopback.img"
+#define LOOPBACK_CHUNK          (0x00010000UL)  /* ȶʱÿζȡ */
+#define LOOPBACK_RX_SIZE        (8192)          /* ջλСBoot/Core/Src/usart.cͬ */
+
+/* αնע */
+static struct {
+    int fd;                     /* αն */
+    uint32_t corrupt_every;     /* ÿNֽڷתһֽڣ0: ע룩 */
+    uint32_t drop_every;        /* ÿNֽڶһֽڣ0: ע룩 */
+    uint8_t rx_ring[LOOPBACK_RX_SIZE];  /* ջλģDMAգ */
+    uint32_t rx_head;           /* λдܳ */
+    uint32_t rx_tail;           /* λȡܳ */
+    uint32_t rx_overflows;      /* λֽ */
+    uint32_t rx_count;          /* ѽֽ */
+    uint32_t tx_count;          /* ѷֽ */
+    uint32_t corrupted;         /* תֽ */
+    uint32_t dropped;           /* ֽ */
+    uint32_t baudrate;          /* 豸ǰ */
+    uint32_t baud_changes;      /* лʴ */
+    uint8_t received;           /* ϴβѯкչ */
+} loopback;
+
+void Error_Handler(void)
+{
+    fprintf(stderr, "Error_Handler\n");
+    exit(2);
+}
+
+/**
+ * @brief   ӡ÷
+ * @param   name: 
+ * @retval  2
+ */
+static int usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-a address] [-b baudrate] [-e corrupt_every] [-d drop_every] [-s sender] file\n", name);
+    return 2;
+}
+
+/**
+ * @brief   αն˽յλ
+ * @note    ģDMAգ豸ʱҲڽգʱӲͬЭش
+ * @param   
+ * @retval  
+ */
+static void loopback_pump(void)
+{
+    uint8_t data[1024];
+    ssize_t n;
+    ssize_t i;
+
+    while ((n = read(loopback.fd, data, sizeof(data))) > 0)
+    {
+        for (i = 0; i < n; i++)
+        {
+            loopback.rx_count++;
+            if ((loopback.corrupt_every != 0) && ((loopback.rx_count % loopback.corrupt_every) == 0))
+            {
+                data[i] ^= 0x55;
+                loopback.corrupted++;
+            }
+
+            if ((loopback.rx_head - loopback.rx_tail) >= LOOPBACK_RX_SIZE)
+            {
+                loopback.rx_overflows++;
+                continue;
+            }
+            loopback.rx_ring[loopback.rx_head++ % LOOPBACK_RX_SIZE] = data[i];
+        }
+        loopback.received = 1;
+    }
+}
+
+/**
+ * @brief   豸ڶȡȴ
+ * @param   data: ݴ洢
+ * @param   length: ȡ
+ * @retval  ȡ
+ */
+static uint32_t loopback_read(uint8_t *data, uint32_t length)
+{
+    uint32_t count;
+
+    loopback_pump();
+
+    for (count = 0; (count < length) && (loopback.rx_tail != loopback.rx_head); count++)
+    {
+        data[count] = loopback.rx_ring[loopback.rx_tail++ % LOOPBACK_RX_SIZE];
+    }
+
+    return count;
+}
+
+/**
+ * @brief   豸ڷ
+ * @param   data: 
+ * @param   length: ݳ
+ * @retval  
+ */
+static void loopback_write(const uint8_t *data, uint32_t length)
+{
+    struct pollfd pfd;
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        loopback.tx_count++;
+        if ((loopback.drop_every != 0) && ((loopback.tx_count % loopback.drop_every) == 0))
+        {
+            loopback.dropped++;
+            continue;
+        }
+
+        while (write(loopback.fd, &data[i], 1) != 1)
+        {
+            if ((errno != EAGAIN) && (errno != EINTR))
+            {
+                return;
+            }
+            loopback_pump();
+            pfd.fd = loopback.fd;
+            pfd.events = POLLOUT;
+            poll(&pfd, 1, 1);
+        }
+    }
+}
+
+/**
+ * @brief   豸·вѯչҵǰ޴ݣ
+ * @param   
+ * @retval  0: δ, 1: 
+ */
+static uint8_t loopback_idle(void)
+{
+    loopback_pump();
+
+    if ((loopback.received == 0) || (loopback.rx_tail != loopback.rx_head))
+    {
+        return 0;
+    }
+
+    loopback.received = 0;
+    return 1;
+}
+
+/**
+ * @brief   豸лʣαնʵʲʣֻ¼
+ * @param   baudrate: 
+ * @retval  0: ɹ
+ */
+static uint8_t loopback_set_baudrate(uint32_t baudrate)
+{
+    loopback.baudrate = baudrate;
+    loopback.baud_changes++;
+    return 0;
+}
+
+static const uart_download_port_t loopback_port = {
+    loopback_read,
+    loopback_write,
+    loopback_idle,
+    loopback_set_baudrate,
+    115200
+};
+
+/**
+ * @brief   ȡļ
+ * @param   path: ļ·
+ * @param   length: ļ
+ * @retval  ļݣfreeʧܷNULL
+ */
+static uint8_t *read_file(const char *path, uint32_t *length)
+{
+    FILE *file;
+    uint8_t *data;
+    long size;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if ((size <= 0) || (size > 0x02000000L))
+    {
+        fprintf(stderr, "%s: bad size\n", path);
+        fclose(file);
+        return NULL;
+    }
+
+    data = malloc((size_t)size);
+    if ((data == NULL) || (fread(data, 1, (size_t)size, file) != (size_t)size))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    *length = (uint32_t)size;
+    return data;
+}
+
+/**
+ * @brief   ȶԷNOR Flashļ
+ * @param   address: ʼַ
+ * @param   data: ļ
+ * @param   length: ļ
+ * @retval  0: һ, 1: һ
+ */
+static int loopback_compare(uint32_t address, const uint8_t *data, uint32_t length)
+{
+    static uint8_t chunk[LOOPBACK_CHUNK];
+    uint32_t offset;
+    uint32_t count;
+    uint32_t i;
+
+    for (offset = 0; offset < length; offset += count)
+    {
+        count = ((length - offset) < LOOPBACK_CHUNK) ? (length - offset) : LOOPBACK_CHUNK;
+        if (norflash_read(address + offset, chunk, (count + 1) & ~1UL) != 0)
+        {
+            fprintf(stderr, "norflash_read failed at 0x%08X\n", (unsigned int)(address + offset));
+            return 1;
+        }
+        for (i = 0; i < count; i++)
+        {
+            if (chunk[i] != data[offset + i])
+            {
+                fprintf(stderr, "mismatch at 0x%08X: %02X != %02X\n", (unsigned int)(address + offset + i), chunk[i], data[offset + i]);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *sender = "./uart_send";
+    const char *address_text = "0x01000000";
+    const char *baud_text = "3000000";
+    uart_download_status_t status;
+    struct pollfd pfd;
+    uint32_t address;
+    uint32_t length;
+    uint8_t *data;
+    char *slave;
+    pid_t pid;
+    int child_status = 0;
+    int exited = 0;
+    int opt;
+    int res;
+
+    while ((opt = getopt(argc, argv, "a:b:e:d:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'a':
+                address_text = optarg;
+                break;
+            case 'b':
+                baud_text = optarg;
+                break;
+            case 'e':
+                loopback.corrupt_every = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                loopback.drop_every = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                sender = optarg;
+                break;
+            default:
+                return usage("uart_loopback");
+        }
+    }
+    if ((argc - optind) != 1)
+    {
+        return usage("uart_loopback");
+    }
+    address = (uint32_t)strtoul(address_text, NULL, 0);
+
+    data = read_file(argv[optind], &length);
+    if (data == NULL)
+    {
+        return 1;
+    }
+
+    /* NOR Flash */
+    remove(LOOPBACK_IMAGE);
+    if ((w25q128_sim_open(LOOPBACK_IMAGE) != 0) || (norflash_init() != NORFlash_W25Q128_Dual))
+    {
+        fprintf(stderr, "cannot init simulated NOR Flash\n");
+        free(data);
+        return 1;
+    }
+
+    /* αնˣΪ豸ڣӶ˽uart_send */
+    loopback.fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((loopback.fd < 0) || (grantpt(loopback.fd) != 0) || (unlockpt(loopback.fd) != 0) || ((slave = ptsname(loopback.fd)) == NULL))
+    {
+        perror("posix_openpt");
+        free(data);
+        return 1;
+    }
+    fcntl(loopback.fd, F_SETFL, fcntl(loopback.fd, F_GETFL) | O_NONBLOCK);
+
+    pid = fork();
+    if (pid < 0)
+    {
+        perror("fork");
+        free(data);
+        return 1;
+    }
+    if (pid == 0)
+    {
+        close(loopback.fd);
+        execl(sender, sender, "-a", address_text, "-b", baud_text, slave, argv[optind], (char *)NULL);
+        perror(sender);
+        _exit(127);
+    }
+
+    loopback.baudrate = loopback_port.baudrate;
+    uart_download_init(&loopback_port);
+
+    /* 豸ѭݲʱƽʱ䣬첽дڵȴ¼ */
+    while (1)
+    {
+        uart_download_poll();
+
+        if (norflash_async_busy())
+        {
+            if (w25q128_sim_wait_event())
+            {
+                norflash_xspi1_irq_handler();
+            }
+            continue;
+        }
+
+        if (exited)
+        {
+            break;
+        }
+        if (waitpid(pid, &child_status, WNOHANG) == pid)
+        {
+            exited = 1;
+            continue;
+        }
+
+        pfd.fd = loopback.fd;
+        pfd.events = POLLIN;
+        if ((loopback.rx_tail == loopback.rx_head) && (poll(&pfd, 1, 1) == 0))
+        {
+            LL_mDelay(1);
+        }
+    }
+
+    uart_download_get_status(&status);
+    printf("device: state %u, %u/%u bytes written, frames %u, crc errors %u, sequence errors %u, duplicates %u, resyncs %u\n",
+           status.state, (unsigned int)status.written, (unsigned int)status.length, (unsigned int)status.frames,
+           (unsigned int)status.crc_errors, (unsigned int)status.sequence_errors, (unsigned int)status.duplicates,
+           (unsigned int)status.resyncs);
+    printf("        acks %u, naks %u, stalls %u, rx overflows %u, baudrate %u, injected %u corrupt / %u dropped\n",
+           (unsigned int)status.acks, (unsigned int)status.naks, (unsigned int)status.stalls, (unsigned int)loopback.rx_overflows,
+           (unsigned int)loopback.baudrate, (unsigned int)loopback.corrupted, (unsigned int)loopback.dropped);
+
+    res = 0;
+    if (!WIFEXITED(child_status) || (WEXITSTATUS(child_status) != 0))
+    {
+        fprintf(stderr, "sender failed\n");
+        res = 1;
+    }
+    if (status.state != UART_DOWNLOAD_STATE_DONE)
+    {
+        fprintf(stderr, "device not done\n");
+        res = 1;
+    }
+    if ((res == 0) && (loopback_compare(address, data, length) != 0))
+    {
+        res = 1;
+    }
+    printf("loopback %s\n", (res == 0) ? "PASS" : "FAIL");
+
+    close(loopback.fd);
+    w25q128_sim_close();
+    free(data);
+    return res;
+}
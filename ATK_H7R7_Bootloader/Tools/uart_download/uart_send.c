@@ -0,0 +1,704 @@
+/**
+ ****************************************************************************************************
+ * @file        uart_send.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ط͹
+ ****************************************************************************************************
+ * @attention
+ *
+ * BSP/uart_download.h֡Э龭ڰļصNOR Flash
+ * 115200BAUDлʣٷSTART豸ڼBUSY
+ * Ȼ󰴴DATAN֡شNAKʱδӦ֡طENDȴУ
+ *
+ * ÷: uart_send [-a ַ] [-b ] [-w ] [-t ʱms] [-v]  ļ
+ *
+ ****************************************************************************************************
+ */
+
+#include "uart_download.h"
+#include "image_sw.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Ĭϲ */
+#define SEND_DEFAULT_BAUDRATE   (115200U)
+#define SEND_DEFAULT_TIMEOUT    (200U)      /* ȴӦʱms */
+#define SEND_RETRIES            (10U)       /* ʱ */
+
+/* Ӧ֡ */
+typedef struct {
+    uint8_t type;                   /* UART_DOWNLOAD_TYPE_ACKUART_DOWNLOAD_TYPE_NAK */
+    uint16_t seq;                   /* һ */
+    uart_download_reply_t reply;    /* Ӧ */
+} send_reply_t;
+
+/* ͳƶ */
+typedef struct {
+    uint32_t frames;                /* ͵DATA֡ */
+    uint32_t retransmits;           /* طDATA֡ */
+    uint32_t naks;                  /* յNAK */
+    uint32_t timeouts;              /* ȴӦʱ */
+    uint32_t busy;                  /* յBUSY */
+    uint32_t bad_replies;           /* ЧӦ֡ */
+} send_stats_t;
+
+static int send_verbose = 0;
+static send_stats_t send_stats;
+
+/**
+ * @brief   ӡ÷
+ * @param   name: 
+ * @retval  2
+ */
+static int usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-a address] [-b baudrate] [-w window] [-t timeout_ms] [-v] serial file\n", name);
+    return 2;
+}
+
+/**
+ * @brief   ȡʱӣms
+ * @param   
+ * @retval  ʱ
+ */
+static uint64_t now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+/**
+ * @brief   ȡļ
+ * @param   path: ļ·
+ * @param   length: ļ
+ * @retval  ļݣfreeʧܷNULL
+ */
+static uint8_t *read_file(const char *path, uint32_t *length)
+{
+    FILE *file;
+    uint8_t *data;
+    long size;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if ((size <= 0) || (size > 0x02000000L))
+    {
+        fprintf(stderr, "%s: bad size\n", path);
+        fclose(file);
+        return NULL;
+    }
+
+    data = malloc((size_t)size);
+    if ((data == NULL) || (fread(data, 1, (size_t)size, file) != (size_t)size))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    *length = (uint32_t)size;
+    return data;
+}
+
+/**
+ * @brief   תΪtermios
+ * @param   baudrate: 
+ * @retval  ʣַ֧B0
+ */
+static speed_t baud_to_speed(uint32_t baudrate)
+{
+    switch (baudrate)
+    {
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        case 1000000: return B1000000;
+        case 1500000: return B1500000;
+        case 2000000: return B2000000;
+        case 3000000: return B3000000;
+        case 4000000: return B4000000;
+        default: return B0;
+    }
+}
+
+/**
+ * @brief   ôΪԭʼģʽָ
+ * @param   fd: 
+ * @param   baudrate: 
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int serial_config(int fd, uint32_t baudrate)
+{
+    struct termios tio;
+    speed_t speed = baud_to_speed(baudrate);
+
+    if ((speed == B0) || (tcgetattr(fd, &tio) != 0))
+    {
+        return -1;
+    }
+
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+
+    return (tcsetattr(fd, TCSANOW, &tio) == 0) ? 0 : -1;
+}
+
+/**
+ * @brief   ȫ
+ * @param   fd: 
+ * @param   data: 
+ * @param   length: ݳ
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int serial_write(int fd, const uint8_t *data, uint32_t length)
+{
+    ssize_t n;
+
+    while (length != 0)
+    {
+        n = write(fd, data, length);
+        if (n < 0)
+        {
+            if ((errno == EINTR) || (errno == EAGAIN))
+            {
+                continue;
+            }
+            perror("write");
+            return -1;
+        }
+        data += n;
+        length -= (uint32_t)n;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief   һ֡
+ * @param   fd: 
+ * @param   type: ֡
+ * @param   seq: 
+ * @param   data: ݣΪNULL
+ * @param   length: ݳ
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int send_frame(int fd, uint8_t type, uint16_t seq, const uint8_t *data, uint16_t length)
+{
+    uint8_t frame[UART_DOWNLOAD_FRAME_MAX];
+    uint32_t crc;
+
+    frame[0] = UART_DOWNLOAD_SOF;
+    frame[1] = type;
+    frame[2] = (uint8_t)seq;
+    frame[3] = (uint8_t)(seq >> 8);
+    frame[4] = (uint8_t)length;
+    frame[5] = (uint8_t)(length >> 8);
+    frame[6] = 0;
+    frame[7] = (uint8_t)~(frame[1] ^ frame[2] ^ frame[3] ^ frame[4] ^ frame[5] ^ frame[6]);
+    if (length != 0)
+    {
+        memcpy(&frame[UART_DOWNLOAD_HEADER_SIZE], data, length);
+    }
+
+    crc = image_sw_crc32(0, &frame[1], UART_DOWNLOAD_HEADER_SIZE - 1 + length);
+    frame[UART_DOWNLOAD_HEADER_SIZE + length] = (uint8_t)crc;
+    frame[UART_DOWNLOAD_HEADER_SIZE + length + 1] = (uint8_t)(crc >> 8);
+    frame[UART_DOWNLOAD_HEADER_SIZE + length + 2] = (uint8_t)(crc >> 16);
+    frame[UART_DOWNLOAD_HEADER_SIZE + length + 3] = (uint8_t)(crc >> 24);
+
+    return serial_write(fd, frame, UART_DOWNLOAD_HEADER_SIZE + length + UART_DOWNLOAD_CRC_SIZE);
+}
+
+/**
+ * @brief   ȴһӦ֡
+ * @note    ֽڲSOF֡ͷCRCʱ
+ * @param   fd: 
+ * @param   reply: Ӧ֡
+ * @param   timeout: ʱms
+ * @retval  0: յ, 1: ʱ, -1: ڴ
+ */
+static int recv_reply(int fd, send_reply_t *reply, uint32_t timeout)
+{
+    static uint8_t frame[UART_DOWNLOAD_HEADER_SIZE + sizeof(uart_download_reply_t) + UART_DOWNLOAD_CRC_SIZE];
+    static uint32_t fill = 0;
+    uint64_t deadline = now_ms() + timeout;
+    uint32_t total;
+    uint32_t length;
+    uint32_t crc;
+    uint32_t index;
+    uint64_t now;
+    struct timeval tv;
+    fd_set fds;
+    ssize_t n;
+
+    while (1)
+    {
+        /* ѽյֽ */
+        while (fill != 0)
+        {
+            if (frame[0] != UART_DOWNLOAD_SOF)
+            {
+                memmove(frame, &frame[1], --fill);
+                continue;
+            }
+            if (fill < UART_DOWNLOAD_HEADER_SIZE)
+            {
+                break;
+            }
+
+            length = frame[4] | (frame[5] << 8);
+            if ((frame[7] != (uint8_t)~(frame[1] ^ frame[2] ^ frame[3] ^ frame[4] ^ frame[5] ^ frame[6])) ||
+                (length > sizeof(uart_download_reply_t)))
+            {
+                send_stats.bad_replies++;
+                memmove(frame, &frame[1], --fill);
+                continue;
+            }
+
+            total = UART_DOWNLOAD_HEADER_SIZE + length + UART_DOWNLOAD_CRC_SIZE;
+            if (fill < total)
+            {
+                break;
+            }
+
+            crc = image_sw_crc32(0, &frame[1], UART_DOWNLOAD_HEADER_SIZE - 1 + length);
+            index = UART_DOWNLOAD_HEADER_SIZE + length;
+            if ((crc != ((uint32_t)frame[index] | ((uint32_t)frame[index + 1] << 8) | ((uint32_t)frame[index + 2] << 16) | ((uint32_t)frame[index + 3] << 24))) ||
+                ((frame[1] != UART_DOWNLOAD_TYPE_ACK) && (frame[1] != UART_DOWNLOAD_TYPE_NAK)))
+            {
+                send_stats.bad_replies++;
+                memmove(frame, &frame[1], --fill);
+                continue;
+            }
+
+            reply->type = frame[1];
+            reply->seq = (uint16_t)(frame[2] | (frame[3] << 8));
+            memset(&reply->reply, 0, sizeof(reply->reply));
+            if (length == sizeof(uart_download_reply_t))
+            {
+                memcpy(&reply->reply, &frame[UART_DOWNLOAD_HEADER_SIZE], sizeof(reply->reply));
+            }
+            else
+            {
+                reply->reply.status = (frame[1] == UART_DOWNLOAD_TYPE_ACK) ? UART_DOWNLOAD_STATUS_OK : UART_DOWNLOAD_STATUS_STATE;
+            }
+            fill -= total;
+            memmove(frame, &frame[total], fill);
+
+            if (send_verbose)
+            {
+                printf("  %s seq=%u status=%u offset=%u\n", (reply->type == UART_DOWNLOAD_TYPE_ACK) ? "ACK" : "NAK",
+                       reply->seq, reply->reply.status, (unsigned int)reply->reply.offset);
+            }
+            return 0;
+        }
+
+        now = now_ms();
+        if (now >= deadline)
+        {
+            return 1;
+        }
+
+        FD_ZERO(&fds);
+        FD_SET(fd, &fds);
+        tv.tv_sec = (time_t)((deadline - now) / 1000);
+        tv.tv_usec = (suseconds_t)(((deadline - now) % 1000) * 1000);
+        if (select(fd + 1, &fds, NULL, NULL, &tv) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("select");
+            return -1;
+        }
+        if (!FD_ISSET(fd, &fds))
+        {
+            continue;
+        }
+
+        n = read(fd, &frame[fill], sizeof(frame) - fill);
+        if (n < 0)
+        {
+            if ((errno == EINTR) || (errno == EAGAIN))
+            {
+                continue;
+            }
+            perror("read");
+            return -1;
+        }
+        if (n == 0)
+        {
+            continue;
+        }
+        fill += (uint32_t)n;
+    }
+}
+
+/**
+ * @brief   л
+ * @note    豸ԭӦл豸֧ʱԭʼ
+ * @param   fd: 
+ * @param   baudrate: 
+ * @param   timeout: ȴӦʱms
+ * @retval  0: ɹ򱣳ԭʣ, -1: ʧ
+ */
+static int send_baudrate(int fd, uint32_t baudrate, uint32_t timeout)
+{
+    send_reply_t reply;
+    uint8_t data[4];
+    uint32_t retry;
+    int res;
+
+    if (baud_to_speed(baudrate) == B0)
+    {
+        fprintf(stderr, "unsupported baudrate %u\n", (unsigned int)baudrate);
+        return -1;
+    }
+
+    data[0] = (uint8_t)baudrate;
+    data[1] = (uint8_t)(baudrate >> 8);
+    data[2] = (uint8_t)(baudrate >> 16);
+    data[3] = (uint8_t)(baudrate >> 24);
+
+    for (retry = 0; retry < SEND_RETRIES; retry++)
+    {
+        if (send_frame(fd, UART_DOWNLOAD_TYPE_BAUD, 0, data, sizeof(data)) != 0)
+        {
+            return -1;
+        }
+
+        res = recv_reply(fd, &reply, timeout);
+        if (res < 0)
+        {
+            return -1;
+        }
+        if (res == 0)
+        {
+            if (reply.type == UART_DOWNLOAD_TYPE_NAK)
+            {
+                fprintf(stderr, "baudrate %u rejected, stay at %u\n", (unsigned int)baudrate, SEND_DEFAULT_BAUDRATE);
+                return 0;
+            }
+
+            /* ȴһֽڷл */
+            tcdrain(fd);
+            return serial_config(fd, baudrate);
+        }
+
+        /* Ӧʧʱ豸лȴ豸ʱָԭʺ */
+        send_stats.timeouts++;
+        usleep((UART_DOWNLOAD_BAUD_TIMEOUT + 200) * 1000);
+    }
+
+    fprintf(stderr, "no reply to BAUD\n");
+    return -1;
+}
+
+/**
+ * @brief   STARTȴ
+ * @param   fd: 
+ * @param   address: Ŀַ
+ * @param   data: ļ
+ * @param   length: ļ
+ * @param   timeout: ȴӦʱms
+ * @param   window: ڣ豸ӦС
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int send_start(int fd, uint32_t address, const uint8_t *data, uint32_t length, uint32_t timeout, uint32_t *window)
+{
+    send_reply_t reply;
+    uint8_t start[12];
+    uint32_t crc = image_sw_crc32(0, data, length);
+    uint32_t retry = 0;
+    int res;
+
+    memcpy(&start[0], &address, 4);
+    memcpy(&start[4], &length, 4);
+    memcpy(&start[8], &crc, 4);
+
+    if (send_frame(fd, UART_DOWNLOAD_TYPE_START, 0, start, sizeof(start)) != 0)
+    {
+        return -1;
+    }
+
+    while (retry < SEND_RETRIES)
+    {
+        res = recv_reply(fd, &reply, timeout);
+        if (res < 0)
+        {
+            return -1;
+        }
+        if (res != 0)
+        {
+            send_stats.timeouts++;
+            retry++;
+            if (send_frame(fd, UART_DOWNLOAD_TYPE_START, 0, start, sizeof(start)) != 0)
+            {
+                return -1;
+            }
+            continue;
+        }
+
+        retry = 0;
+        if (reply.type == UART_DOWNLOAD_TYPE_NAK)
+        {
+            fprintf(stderr, "START rejected (status %u)\n", reply.reply.status);
+            return -1;
+        }
+        if (reply.reply.status == UART_DOWNLOAD_STATUS_BUSY)
+        {
+            send_stats.busy++;
+            continue;
+        }
+        if ((reply.reply.status == UART_DOWNLOAD_STATUS_OK) && (reply.seq == 1))
+        {
+            if ((reply.reply.window != 0) && (reply.reply.window < *window))
+            {
+                *window = reply.reply.window;
+            }
+            if (reply.reply.page_size != UART_DOWNLOAD_PAGE_SIZE)
+            {
+                fprintf(stderr, "unsupported page size %u\n", reply.reply.page_size);
+                return -1;
+            }
+            return 0;
+        }
+    }
+
+    fprintf(stderr, "no reply to START\n");
+    return -1;
+}
+
+/**
+ * @brief   ڷDATA֡END
+ * @note    ֡32λΪ(+1)ĵ16λ
+ * @param   fd: 
+ * @param   data: ļ
+ * @param   length: ļ
+ * @param   window: 
+ * @param   timeout: ȴӦʱms
+ * @retval  0: ɹ, -1: ʧ
+ */
+static int send_data(int fd, const uint8_t *data, uint32_t length, uint32_t window, uint32_t timeout)
+{
+    uint32_t pages = (length + UART_DOWNLOAD_PAGE_SIZE - 1) / UART_DOWNLOAD_PAGE_SIZE;
+    uint32_t base = 0;
+    uint32_t next = 0;
+    uint32_t sent = 0;
+    uint32_t retry = 0;
+    uint32_t acked;
+    uint32_t page;
+    uint16_t end_seq = (uint16_t)(pages + 1);
+    send_reply_t reply;
+    int res;
+
+    while (1)
+    {
+        /* ڵ֡ȫ */
+        while ((next < pages) && ((next - base) < window))
+        {
+            page = (length - next * UART_DOWNLOAD_PAGE_SIZE < UART_DOWNLOAD_PAGE_SIZE) ? (length - next * UART_DOWNLOAD_PAGE_SIZE) : UART_DOWNLOAD_PAGE_SIZE;
+            if (send_frame(fd, UART_DOWNLOAD_TYPE_DATA, (uint16_t)(next + 1), &data[next * UART_DOWNLOAD_PAGE_SIZE], (uint16_t)page) != 0)
+            {
+                return -1;
+            }
+            send_stats.frames++;
+            if (next < sent)
+            {
+                send_stats.retransmits++;
+            }
+            next++;
+            if (next > sent)
+            {
+                sent = next;
+            }
+        }
+
+        if ((base == pages) && (next == pages))
+        {
+            if (send_frame(fd, UART_DOWNLOAD_TYPE_END, end_seq, NULL, 0) != 0)
+            {
+                return -1;
+            }
+            next++;
+        }
+
+        res = recv_reply(fd, &reply, timeout);
+        if (res < 0)
+        {
+            return -1;
+        }
+        if (res != 0)
+        {
+            /* ʱδӦ֡ط */
+            send_stats.timeouts++;
+            if (send_verbose)
+            {
+                printf("  timeout, resend from frame %u\n", (unsigned int)base);
+            }
+            if (++retry > SEND_RETRIES)
+            {
+                fprintf(stderr, "no reply at frame %u\n", (unsigned int)base);
+                return -1;
+            }
+            next = base;
+            continue;
+        }
+        retry = 0;
+
+        if (reply.reply.status == UART_DOWNLOAD_STATUS_BUSY)
+        {
+            send_stats.busy++;
+            continue;
+        }
+
+        if (base == pages)
+        {
+            /* ȴENDӦ */
+            if (reply.seq != (uint16_t)(end_seq + 1))
+            {
+                if (reply.type == UART_DOWNLOAD_TYPE_NAK)
+                {
+                    send_stats.naks++;
+                    next = base;
+                }
+                continue;
+            }
+            if ((reply.type == UART_DOWNLOAD_TYPE_ACK) && (reply.reply.status == UART_DOWNLOAD_STATUS_OK))
+            {
+                return 0;
+            }
+            fprintf(stderr, "download failed (status %u)\n", reply.reply.status);
+            return -1;
+        }
+
+        /* ۻӦ֮ǰ֡ѽ */
+        acked = (uint16_t)(reply.seq - (uint16_t)(base + 1));
+        if (acked <= (next - base))
+        {
+            base += acked;
+        }
+
+        if (reply.type == UART_DOWNLOAD_TYPE_NAK)
+        {
+            send_stats.naks++;
+            if ((reply.reply.status != UART_DOWNLOAD_STATUS_SEQUENCE) && (reply.reply.status != UART_DOWNLOAD_STATUS_CRC))
+            {
+                fprintf(stderr, "download failed at frame %u (status %u)\n", (unsigned int)base, reply.reply.status);
+                return -1;
+            }
+            next = base;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t address = 0;
+    uint32_t baudrate = SEND_DEFAULT_BAUDRATE;
+    uint32_t window = UART_DOWNLOAD_WINDOW;
+    uint32_t timeout = SEND_DEFAULT_TIMEOUT;
+    uint32_t length;
+    uint64_t start;
+    uint64_t elapsed;
+    uint8_t *data;
+    int opt;
+    int fd;
+    int res;
+
+    while ((opt = getopt(argc, argv, "a:b:w:t:v")) != -1)
+    {
+        switch (opt)
+        {
+            case 'a':
+                address = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'b':
+                baudrate = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                window = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                timeout = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'v':
+                send_verbose = 1;
+                break;
+            default:
+                return usage("uart_send");
+        }
+    }
+    if (((argc - optind) != 2) || (window == 0) || (timeout == 0))
+    {
+        return usage("uart_send");
+    }
+
+    data = read_file(argv[optind + 1], &length);
+    if (data == NULL)
+    {
+        return 1;
+    }
+
+    fd = open(argv[optind], O_RDWR | O_NOCTTY);
+    if ((fd < 0) || (serial_config(fd, SEND_DEFAULT_BAUDRATE) != 0))
+    {
+        perror(argv[optind]);
+        free(data);
+        return 1;
+    }
+    tcflush(fd, TCIOFLUSH);
+
+    start = now_ms();
+    res = 0;
+    if (baudrate != SEND_DEFAULT_BAUDRATE)
+    {
+        res = send_baudrate(fd, baudrate, timeout);
+    }
+    if (res == 0)
+    {
+        res = send_start(fd, address, data, length, timeout, &window);
+    }
+    if (res == 0)
+    {
+        res = send_data(fd, data, length, window, timeout);
+    }
+    elapsed = now_ms() - start;
+
+    printf("%s: %u bytes to 0x%08X, %s in %u ms (%.1f KB/s)\n", argv[optind + 1], (unsigned int)length, (unsigned int)address,
+           (res == 0) ? "OK" : "FAILED", (unsigned int)elapsed, (elapsed != 0) ? (length / 1024.0) * 1000.0 / (double)elapsed : 0.0);
+    printf("frames %u, retransmits %u, naks %u, timeouts %u, busy %u, bad replies %u\n",
+           (unsigned int)send_stats.frames, (unsigned int)send_stats.retransmits, (unsigned int)send_stats.naks,
+           (unsigned int)send_stats.timeouts, (unsigned int)send_stats.busy, (unsigned int)send_stats.bad_replies);
+
+    close(fd);
+    free(data);
+    return (res == 0) ? 0 : 1;
+}
@@ -0,0 +1,1440 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_cmd.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ʸͼбդ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ʽͷ1֣8λΪͣ24λΪͷΪṹ壻
+ * ·Ĳ֮·ԪأÿԪ1֣ÿ2
+ * դ·չƽΪֱ߱ߣ1/8أy0ɨ裬
+ * ÿɨߵĽ㣬õۼӵиʻһн󰴸뻭ˢɫϵĿ
+ * ʹgfx_soft_blend()DMA2Dʽ˫ԲֵڷԤɫϽ
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfx_cmd.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ͷ */
+#define GFX_CMD_HEADER(type, words) ((uint32_t)(type) | ((uint32_t)(words) << 8))
+#define GFX_CMD_WORDS(bytes)        (((uint32_t)(bytes) + 3) / 4)
+#define GFX_CMD_NONE                (0xFFFFFFFFUL)
+
+/* ɨ߶壨ÿ4ÿ1/16صĸΪ4Ϊ644ϼ256 */
+#define GFX_CMD_SUBSAMPLES          (4)
+#define GFX_CMD_SUB_WEIGHT          (4)
+
+/* չƽ */
+#define GFX_CMD_CURVE_STEPS         (64)
+
+/* 任ϵΧ壨ֵ256.0֤㲻 */
+#define GFX_CMD_MATRIX_MAX          (256 * GFX_CMD_ONE)
+
+/* ڲˢͶ */
+#define GFX_PAINT_TEXTURE           (3U)
+
+/*  */
+typedef struct {
+    gfx_rect_t rect;
+    gfx_paint_t paint;
+} gfx_cmd_rect_arg_t;
+
+/* ԲǾ */
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+    int32_t radius;
+    gfx_paint_t paint;
+} gfx_cmd_round_arg_t;
+
+/* · */
+typedef struct {
+    uint32_t fill_rule;
+    gfx_paint_t paint;
+} gfx_cmd_path_arg_t;
+
+/* ı */
+typedef struct {
+    const gfx_surface_t *texture;
+    int32_t matrix[6];
+    uint32_t alpha;
+    uint32_t filter;
+} gfx_cmd_quad_arg_t;
+
+/* դߣy0 < y11/16أ */
+typedef struct {
+    int32_t x0;             /* ϶˵x */
+    int32_t y0;             /* ϶˵y */
+    int32_t y1;             /* ¶˵y */
+    int32_t slope;          /* dx/dy16.16 */
+    int32_t dir;            /* 1: ԭ; -1:  */
+} gfx_cmd_edge_t;
+
+/* ˢ״̬ */
+typedef struct {
+    uint8_t type;
+    uint8_t filter;
+    uint8_t alpha;
+    uint32_t color0;
+    uint32_t color1;
+    int32_t x0;             /* /Բģƽƣ16.16 */
+    int32_t y0;
+    int64_t fx;             /* Խ: txyĵÿ1/16أ32λС: 16.16 */
+    int64_t fy;
+    int64_t gx;
+    int64_t gy;
+    uint32_t radius_inv;    /* 򽥱: 2^32 / 뾶 */
+    const gfx_surface_t *texture;
+} gfx_cmd_paint_state_t;
+
+static gfx_cmd_edge_t gfx_cmd_edges[GFX_CMD_MAX_EDGES];
+static uint32_t gfx_cmd_edge_count = 0;
+static uint8_t gfx_cmd_edge_overflow = 0;
+static int32_t gfx_cmd_min_x = 0;
+static int32_t gfx_cmd_min_y = 0;
+static int32_t gfx_cmd_max_x = 0;
+static int32_t gfx_cmd_max_y = 0;
+static uint16_t gfx_cmd_cover[GFX_CMD_MAX_WIDTH + 1];
+static uint16_t gfx_cmd_active[GFX_CMD_MAX_EDGES];
+static int32_t gfx_cmd_cross_x[GFX_CMD_MAX_EDGES];
+static int8_t gfx_cmd_cross_dir[GFX_CMD_MAX_EDGES];
+
+/* sin(0 ~ 90)6516.16 */
+static const int32_t gfx_cmd_sin_table[65] = {
+    0, 1608, 3216, 4821, 6424, 8022, 9616, 11204,
+    12785, 14359, 15924, 17479, 19024, 20557, 22078, 23586,
+    25080, 26558, 28020, 29466, 30893, 32303, 33692, 35062,
+    36410, 37736, 39040, 40320, 41576, 42806, 44011, 45190,
+    46341, 47464, 48559, 49624, 50660, 51665, 52639, 53581,
+    54491, 55368, 56212, 57022, 57798, 58538, 59244, 59914,
+    60547, 61145, 61705, 62228, 62714, 63162, 63572, 63944,
+    64277, 64571, 64827, 65043, 65220, 65358, 65457, 65516,
+    65536,
+};
+
+/**
+ * @brief   ʼб
+ * @param   list: бṹָ
+ * @param   buffer: 
+ * @param   size: С֣
+ * @retval  
+ */
+void gfx_cmd_init(gfx_cmd_list_t *list, uint32_t *buffer, uint32_t size)
+{
+    list->buffer = buffer;
+    list->size = size;
+    gfx_cmd_reset(list);
+}
+
+/**
+ * @brief   б
+ * @param   list: бṹָ
+ * @retval  
+ */
+void gfx_cmd_reset(gfx_cmd_list_t *list)
+{
+    list->used = 0;
+    list->count = 0;
+    list->path = GFX_CMD_NONE;
+    list->error = 0;
+}
+
+/**
+ * @brief   һ
+ * @param   list: бṹָ
+ * @param   type: 
+ * @param   data: 
+ * @param   bytes: ֽ
+ * @retval  0: ɹ; 1: ռ䲻㡢֮ǰѳ·δ
+ */
+static uint8_t gfx_cmd_push(gfx_cmd_list_t *list, uint32_t type, const void *data, uint32_t bytes)
+{
+    uint32_t words = 1 + GFX_CMD_WORDS(bytes);
+    
+    if ((list->error != 0) || (list->path != GFX_CMD_NONE) || ((list->used + words) > list->size))
+    {
+        list->error = 1;
+        return 1;
+    }
+    
+    list->buffer[list->used] = GFX_CMD_HEADER(type, words);
+    list->buffer[list->used + words - 1] = 0;
+    memcpy(&list->buffer[list->used + 1], data, bytes);
+    list->used += words;
+    list->count++;
+    
+    return 0;
+}
+
+/**
+ * @brief   黭ˢ
+ * @param   paint: ˢ
+ * @retval  0: Ч; 1: Ч
+ */
+static uint8_t gfx_cmd_paint_check(const gfx_paint_t *paint)
+{
+    if ((paint == NULL) || (paint->type > GFX_PAINT_RADIAL))
+    {
+        return 1;
+    }
+    
+    return (paint->type == GFX_PAINT_RADIAL) && (paint->x1 <= 0);
+}
+
+/**
+ * @brief   ɾΣ鷶Χ
+ * @param   rect: 
+ * @param   x, y, width, height: ߣأ
+ * @retval  0: Ч; 1: Χ
+ */
+static uint8_t gfx_cmd_make_rect(gfx_rect_t *rect, int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    if ((x < INT16_MIN) || (x > INT16_MAX) || (y < INT16_MIN) || (y > INT16_MAX) || (width < 0) || (width > INT16_MAX) ||
+        (height < 0) || (height > INT16_MAX))
+    {
+        return 1;
+    }
+    
+    rect->x = (int16_t)x;
+    rect->y = (int16_t)y;
+    rect->width = (int16_t)width;
+    rect->height = (int16_t)height;
+    
+    return 0;
+}
+
+/**
+ * @brief   òü
+ * @note    ֻƲüΣĿཻڵأֱһü
+ * @param   list: бṹָ
+ * @param   x, y, width, height: üΣأ
+ * @retval  0: ɹ; 1: ʧܣlist->errorλ
+ */
+uint8_t gfx_cmd_clip(gfx_cmd_list_t *list, int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    gfx_rect_t rect;
+    
+    if (gfx_cmd_make_rect(&rect, x, y, width, height) != 0)
+    {
+        list->error = 1;
+        return 1;
+    }
+    
+    return gfx_cmd_push(list, GFX_CMD_CLIP, &rect, sizeof(rect));
+}
+
+/**
+ * @brief   ضľ
+ * @param   list: бṹָ
+ * @param   x, y, width, height: Σأ
+ * @param   paint: ˢ
+ * @retval  0: ɹ; 1: ʧܣlist->errorλ
+ */
+uint8_t gfx_cmd_rect(gfx_cmd_list_t *list, int32_t x, int32_t y, int32_t width, int32_t height, const gfx_paint_t *paint)
+{
+    gfx_cmd_rect_arg_t arg;
+    
+    memset(&arg, 0, sizeof(arg));
+    if ((gfx_cmd_make_rect(&arg.rect, x, y, width, height) != 0) || (gfx_cmd_paint_check(paint) != 0))
+    {
+        list->error = 1;
+        return 1;
+    }
+    arg.paint = *paint;
+    
+    return gfx_cmd_push(list, GFX_CMD_RECT, &arg, sizeof(arg));
+}
+
+/**
+ * @brief   ԲǾ
+ * @param   list: бṹָ
+ * @param   x, y, width, height: Σ1/16أ
+ * @param   radius: Բǰ뾶1/16أһʱȡһ룩
+ * @param   paint: ˢ
+ * @retval  0: ɹ; 1: ʧܣlist->errorλ
+ */
+uint8_t gfx_cmd_round_rect(gfx_cmd_list_t *list, int32_t x, int32_t y, int32_t width, int32_t height, int32_t radius, const gfx_paint_t *paint)
+{
+    gfx_cmd_round_arg_t arg;
+    
+    memset(&arg, 0, sizeof(arg));
+    if ((width < 0) || (height < 0) || (radius < 0) || (gfx_cmd_paint_check(paint) != 0))
+    {
+        list->error = 1;
+        return 1;
+    }
+    arg.x = x;
+    arg.y = y;
+    arg.width = width;
+    arg.height = height;
+    arg.radius = radius;
+    arg.paint = *paint;
+    
+    return gfx_cmd_push(list, GFX_CMD_ROUND_RECT, &arg, sizeof(arg));
+}
+
+/**
+ * @brief   ʼ·
+ * @note    ֮gfx_cmd_move_to()ȼ·Ԫأgfx_cmd_path_end()δպϵ·ʱԶպ
+ * @param   list: бṹָ
+ * @param   fill_rule: 
+ * @param   paint: ˢ
+ * @retval  0: ɹ; 1: ʧܣlist->errorλ
+ */
+uint8_t gfx_cmd_path_begin(gfx_cmd_list_t *list, uint8_t fill_rule, const gfx_paint_t *paint)
+{
+    gfx_cmd_path_arg_t arg;
+    
+    memset(&arg, 0, sizeof(arg));
+    if ((fill_rule > GFX_FILL_EVENODD) || (gfx_cmd_paint_check(paint) != 0))
+    {
+        list->error = 1;
+        return 1;
+    }
+    arg.fill_rule = fill_rule;
+    arg.paint = *paint;
+    
+    if (gfx_cmd_push(list, GFX_CMD_PATH, &arg, sizeof(arg)) != 0)
+    {
+        return 1;
+    }
+    list->path = list->used - (1 + GFX_CMD_WORDS(sizeof(arg)));
+    
+    return 0;
+}
+
+/**
+ * @brief   ·Ԫ
+ * @note    ռ䲻ʱ·
+ * @param   list: бṹָ
+ * @param   verb: ·Ԫ
+ * @param   points: ꣨x, y棬1/16أ
+ * @param   count: 
+ * @retval  0: ɹ; 1: ʧܣlist->errorλ
+ */
+static uint8_t gfx_cmd_path_add(gfx_cmd_list_t *list, uint32_t verb, const int32_t *points, uint32_t count)
+{
+    uint32_t words = 1 + count * 2;
+    
+    if ((list->error != 0) || (list->path == GFX_CMD_NONE))
+    {
+        list->error = 1;
+        return 1;
+    }
+    if ((list->used + words) > list->size)
+    {
+        list->used = list->path;
+        list->count--;
+        list->path = GFX_CMD_NONE;
+        list->error = 1;
+        return 1;
+    }
+    
+    list->buffer[list->used] = verb;
+    if (count != 0)
+    {
+        memcpy(&list->buffer[list->used + 1], points, count * 2 * sizeof(int32_t));
+    }
+    list->used += words;
+    list->buffer[list->path] = GFX_CMD_HEADER(GFX_CMD_PATH, list->used - list->path);
+    
+    return 0;
+}
+
+/**
+ * @brief   ʼ·
+ * @param   list: бṹָ
+ * @param   x, y: 㣨1/16أ
+ * @retval  0: ɹ; 1: ʧ
+ */
+uint8_t gfx_cmd_move_to(gfx_cmd_list_t *list, int32_t x, int32_t y)
+{
+    int32_t points[2] = {x, y};
+    
+    return gfx_cmd_path_add(list, GFX_PATH_MOVE, points, 1);
+}
+
+/**
+ * @brief   ֱ
+ * @param   list: бṹָ
+ * @param   x, y: յ㣨1/16أ
+ * @retval  0: ɹ; 1: ʧ
+ */
+uint8_t gfx_cmd_line_to(gfx_cmd_list_t *list, int32_t x, int32_t y)
+{
+    int32_t points[2] = {x, y};
+    
+    return gfx_cmd_path_add(list, GFX_PATH_LINE, points, 1);
+}
+
+/**
+ * @brief   α
+ * @param   list: бṹָ
+ * @param   cx, cy: Ƶ㣨1/16أ
+ * @param   x, y: յ㣨1/16أ
+ * @retval  0: ɹ; 1: ʧ
+ */
+uint8_t gfx_cmd_quad_to(gfx_cmd_list_t *list, int32_t cx, int32_t cy, int32_t x, int32_t y)
+{
+    int32_t points[4] = {cx, cy, x, y};
+    
+    return gfx_cmd_path_add(list, GFX_PATH_QUAD, points, 2);
+}
+
+/**
+ * @brief   α
+ * @param   list: бṹָ
+ * @param   cx0, cy0, cx1, cy1: Ƶ㣨1/16أ
+ * @param   x, y: յ㣨1/16أ
+ * @retval  0: ɹ; 1: ʧ
+ */
+uint8_t gfx_cmd_cubic_to(gfx_cmd_list_t *list, int32_t cx0, int32_t cy0, int32_t cx1, int32_t cy1, int32_t x, int32_t y)
+{
+    int32_t points[6] = {cx0, cy0, cx1, cy1, x, y};
+    
+    return gfx_cmd_path_add(list, GFX_PATH_CUBIC, points, 3);
+}
+
+/**
+ * @brief   պ·
+ * @param   list: бṹָ
+ * @retval  0: ɹ; 1: ʧ
+ */
+uint8_t gfx_cmd_close(gfx_cmd_list_t *list)
+{
+    return gfx_cmd_path_add(list, GFX_PATH_CLOSE, NULL, 0);
+}
+
+/**
+ * @brief   ·
+ * @param   list: бṹָ
+ * @retval  0: ɹ; 1: ·δʼ򹹽г
+ */
+uint8_t gfx_cmd_path_end(gfx_cmd_list_t *list)
+{
+    if (list->path == GFX_CMD_NONE)
+    {
+        list->error = 1;
+        return 1;
+    }
+    list->path = GFX_CMD_NONE;
+    
+    return list->error;
+}
+
+/**
+ * @brief   ı
+ * @note    (u, v)matrix任Ļε߿ݣִǰ뱣Ч
+ * @param   list: бṹָ
+ * @param   texture: ARGB8888RGB565
+ * @param   matrix: Ļı任gfx_cmd_tϵֵ256.0ʱʧܣ
+ * @param   alpha: alpha
+ * @param   filter: ˷ʽ
+ * @retval  0: ɹ; 1: ʧܣlist->errorλ
+ */
+uint8_t gfx_cmd_quad(gfx_cmd_list_t *list, const gfx_surface_t *texture, const int32_t matrix[6], uint8_t alpha, uint8_t filter)
+{
+    gfx_cmd_quad_arg_t arg;
+    uint32_t i;
+    
+    memset(&arg, 0, sizeof(arg));
+    if ((texture == NULL) || (texture->data == NULL) || (texture->width == 0) || (texture->height == 0) ||
+        ((texture->format != GFX_FORMAT_ARGB8888) && (texture->format != GFX_FORMAT_RGB565)) || (filter > GFX_FILTER_BILINEAR) ||
+        (((int64_t)matrix[0] * matrix[3] - (int64_t)matrix[1] * matrix[2]) == 0))
+    {
+        list->error = 1;
+        return 1;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        if ((matrix[i] > GFX_CMD_MATRIX_MAX) || (matrix[i] < -GFX_CMD_MATRIX_MAX))
+        {
+            list->error = 1;
+            return 1;
+        }
+    }
+    
+    arg.texture = texture;
+    memcpy(arg.matrix, matrix, sizeof(arg.matrix));
+    arg.alpha = alpha;
+    arg.filter = filter;
+    
+    return gfx_cmd_push(list, GFX_CMD_QUAD, &arg, sizeof(arg));
+}
+
+/**
+ * @brief   ұ
+ * @param   angle: Ƕȣ1/4096ܣ
+ * @retval  sin16.16
+ */
+static int32_t gfx_cmd_sin(int32_t angle)
+{
+    uint32_t a = (uint32_t)angle & 4095;
+    uint32_t r = a & 1023;
+    uint32_t i;
+    int32_t value;
+    
+    if ((a & 1024) != 0)
+    {
+        r = 1024 - r;
+    }
+    i = r >> 4;
+    value = (i >= 64) ? gfx_cmd_sin_table[64] : gfx_cmd_sin_table[i] + ((gfx_cmd_sin_table[i + 1] - gfx_cmd_sin_table[i]) * (int32_t)(r & 15)) / 16;
+    
+    return ((a & 2048) != 0) ? -value : value;
+}
+
+/**
+ * @brief   תƽƾ
+ * @note    ϵĵ(cx, cy)ŵĻ(x, y)ƸõתanglescaleangleΪʱĻ˳ʱתy£
+ * @param   matrix: 
+ * @param   angle: תǶȣ1/4096ܣ1024Ϊ90㣩
+ * @param   scale: ţ16.16GFX_CMD_ONEΪԭߴ磩
+ * @param   x, y: Ļλã1/16أ
+ * @param   cx, cy: ϵתģ1/16أ
+ * @retval  
+ */
+void gfx_cmd_matrix(int32_t matrix[6], int32_t angle, int32_t scale, int32_t x, int32_t y, int32_t cx, int32_t cy)
+{
+    int32_t s = (int32_t)(((int64_t)gfx_cmd_sin(angle) * scale) >> 16);
+    int32_t c = (int32_t)(((int64_t)gfx_cmd_sin(angle + 1024) * scale) >> 16);
+    
+    matrix[0] = c;
+    matrix[1] = -s;
+    matrix[2] = s;
+    matrix[3] = c;
+    matrix[4] = x * 4096 - (int32_t)(((int64_t)c * cx - (int64_t)s * cy) >> 4);
+    matrix[5] = y * 4096 - (int32_t)(((int64_t)s * cx + (int64_t)c * cy) >> 4);
+}
+
+/**
+ * @brief   һ
+ * @param   list: бṹָ
+ * @param   pos: ȡλã0ʼ£
+ * @param   cmd: 
+ * @retval  0: ɹ; 1: ûи
+ */
+uint8_t gfx_cmd_next(const gfx_cmd_list_t *list, uint32_t *pos, gfx_cmd_t *cmd)
+{
+    gfx_cmd_rect_arg_t rect;
+    gfx_cmd_round_arg_t round;
+    gfx_cmd_path_arg_t path;
+    gfx_cmd_quad_arg_t quad;
+    const uint32_t *data;
+    uint32_t header;
+    uint32_t words;
+    
+    if (*pos >= list->used)
+    {
+        return 1;
+    }
+    
+    header = list->buffer[*pos];
+    words = header >> 8;
+    data = &list->buffer[*pos + 1];
+    memset(cmd, 0, sizeof(gfx_cmd_t));
+    cmd->type = (uint8_t)(header & 0xFF);
+    
+    switch (cmd->type)
+    {
+        case GFX_CMD_CLIP:
+        {
+            memcpy(&cmd->rect, data, sizeof(gfx_rect_t));
+            break;
+        }
+        case GFX_CMD_RECT:
+        {
+            memcpy(&rect, data, sizeof(rect));
+            cmd->rect = rect.rect;
+            cmd->paint = rect.paint;
+            break;
+        }
+        case GFX_CMD_ROUND_RECT:
+        {
+            memcpy(&round, data, sizeof(round));
+            cmd->x = round.x;
+            cmd->y = round.y;
+            cmd->width = round.width;
+            cmd->height = round.height;
+            cmd->radius = round.radius;
+            cmd->paint = round.paint;
+            break;
+        }
+        case GFX_CMD_PATH:
+        {
+            memcpy(&path, data, sizeof(path));
+            cmd->fill_rule = (uint8_t)path.fill_rule;
+            cmd->paint = path.paint;
+            cmd->path = data + GFX_CMD_WORDS(sizeof(path));
+            cmd->path_words = words - 1 - GFX_CMD_WORDS(sizeof(path));
+            break;
+        }
+        case GFX_CMD_QUAD:
+        {
+            memcpy(&quad, data, sizeof(quad));
+            cmd->texture = quad.texture;
+            memcpy(cmd->matrix, quad.matrix, sizeof(cmd->matrix));
+            cmd->alpha = (uint8_t)quad.alpha;
+            cmd->filter = (uint8_t)quad.filter;
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    
+    *pos += (words != 0) ? words : 1;
+    
+    return 0;
+}
+
+/**
+ * @brief   8λ˲255룩
+ * @param   a: 
+ * @param   b: 
+ * @retval  round(a * b / 255)
+ */
+static uint32_t gfx_cmd_mul(uint32_t a, uint32_t b)
+{
+    uint32_t t = a * b + 128;
+    
+    return (t + (t >> 8)) >> 8;
+}
+
+/**
+ * @brief   ƽ
+ * @param   value: 
+ * @retval  floor(sqrt(value))
+ */
+static uint32_t gfx_cmd_isqrt(uint64_t value)
+{
+    uint64_t result = 0;
+    uint64_t bit = 1ULL << 62;
+    
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (value >= (result + bit))
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    
+    return (uint32_t)result;
+}
+
+/**
+ * @brief   з룩
+ * @param   num: 
+ * @param   den: 0
+ * @retval  round(num / den)
+ */
+static int32_t gfx_cmd_div(int64_t num, int64_t den)
+{
+    return (int32_t)((num >= 0) ? ((num + den / 2) / den) : -((-num + den / 2) / den));
+}
+
+/**
+ * @brief   ɫԲֵ
+ * @param   c0, c1: ɫARGB8888
+ * @param   t: λã0 ~ 65536
+ * @retval  ɫ
+ */
+static uint32_t gfx_cmd_lerp(uint32_t c0, uint32_t c1, uint32_t t)
+{
+    uint32_t result = 0;
+    uint32_t shift;
+    
+    for (shift = 0; shift < 32; shift += 8)
+    {
+        result |= ((((c0 >> shift) & 0xFF) * (65536 - t) + ((c1 >> shift) & 0xFF) * t + 32768) >> 16) << shift;
+    }
+    
+    return result;
+}
+
+/**
+ * @brief   ձ߱
+ * @param   
+ * @retval  
+ */
+static void gfx_cmd_edge_reset(void)
+{
+    gfx_cmd_edge_count = 0;
+    gfx_cmd_edge_overflow = 0;
+    gfx_cmd_min_x = INT32_MAX;
+    gfx_cmd_min_y = INT32_MAX;
+    gfx_cmd_max_x = INT32_MIN;
+    gfx_cmd_max_y = INT32_MIN;
+}
+
+/**
+ * @brief   һֱ߱
+ * @param   x0, y0: 㣨1/16أ
+ * @param   x1, y1: յ㣨1/16أ
+ * @retval  
+ */
+static void gfx_cmd_edge_line(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    gfx_cmd_edge_t *edge;
+    
+    gfx_cmd_min_x = (x0 < gfx_cmd_min_x) ? x0 : gfx_cmd_min_x;
+    gfx_cmd_min_x = (x1 < gfx_cmd_min_x) ? x1 : gfx_cmd_min_x;
+    gfx_cmd_max_x = (x0 > gfx_cmd_max_x) ? x0 : gfx_cmd_max_x;
+    gfx_cmd_max_x = (x1 > gfx_cmd_max_x) ? x1 : gfx_cmd_max_x;
+    gfx_cmd_min_y = (y0 < gfx_cmd_min_y) ? y0 : gfx_cmd_min_y;
+    gfx_cmd_min_y = (y1 < gfx_cmd_min_y) ? y1 : gfx_cmd_min_y;
+    gfx_cmd_max_y = (y0 > gfx_cmd_max_y) ? y0 : gfx_cmd_max_y;
+    gfx_cmd_max_y = (y1 > gfx_cmd_max_y) ? y1 : gfx_cmd_max_y;
+    
+    /* ˮƽ߲ɨཻ */
+    if (y0 == y1)
+    {
+        return;
+    }
+    if (gfx_cmd_edge_count >= GFX_CMD_MAX_EDGES)
+    {
+        gfx_cmd_edge_overflow = 1;
+        return;
+    }
+    
+    edge = &gfx_cmd_edges[gfx_cmd_edge_count++];
+    if (y0 < y1)
+    {
+        edge->x0 = x0;
+        edge->y0 = y0;
+        edge->y1 = y1;
+        edge->dir = 1;
+    }
+    else
+    {
+        edge->x0 = x1;
+        edge->y0 = y1;
+        edge->y1 = y0;
+        edge->dir = -1;
+        x1 = x0;
+    }
+    edge->slope = (int32_t)((((int64_t)x1 - edge->x0) * 65536) / (edge->y1 - edge->y0));
+}
+
+/**
+ * @brief   αչƽΪֱ߱
+ * @param   p: 㡢Ƶ㡢յ㣨x, y棬1/16أ
+ * @retval  
+ */
+static void gfx_cmd_edge_quad(const int32_t *p)
+{
+    int32_t ddx = p[0] - 2 * p[2] + p[4];
+    int32_t ddy = p[1] - 2 * p[3] + p[5];
+    uint32_t dd = (uint32_t)((ddx < 0) ? -ddx : ddx) + (uint32_t)((ddy < 0) ? -ddy : ddy);
+    int64_t n = 1 + gfx_cmd_isqrt(dd / 16);     /* dd / (8 * n^2)21/8أ */
+    int64_t n2;
+    int64_t i;
+    int32_t x = p[0];
+    int32_t y = p[1];
+    int32_t nx;
+    int32_t ny;
+    
+    n = (n > GFX_CMD_CURVE_STEPS) ? GFX_CMD_CURVE_STEPS : n;
+    n2 = n * n;
+    for (i = 1; i <= n; i++)
+    {
+        nx = gfx_cmd_div((n - i) * (n - i) * p[0] + 2 * (n - i) * i * p[2] + i * i * p[4], n2);
+        ny = gfx_cmd_div((n - i) * (n - i) * p[1] + 2 * (n - i) * i * p[3] + i * i * p[5], n2);
+        gfx_cmd_edge_line(x, y, nx, ny);
+        x = nx;
+        y = ny;
+    }
+}
+
+/**
+ * @brief   αչƽΪֱ߱
+ * @param   p: 㡢Ƶ㡢յ㣨x, y棬1/16أ
+ * @retval  
+ */
+static void gfx_cmd_edge_cubic(const int32_t *p)
+{
+    int32_t d0 = abs(p[0] - 2 * p[2] + p[4]) + abs(p[1] - 2 * p[3] + p[5]);
+    int32_t d1 = abs(p[2] - 2 * p[4] + p[6]) + abs(p[3] - 2 * p[5] + p[7]);
+    uint32_t dd = (uint32_t)((d0 > d1) ? d0 : d1);
+    int64_t n = 1 + gfx_cmd_isqrt((uint64_t)dd * 3 / 8);   /* 3 * dd / (4 * n^2)21/8أ */
+    int64_t n3;
+    int64_t i;
+    int64_t j;
+    int32_t x = p[0];
+    int32_t y = p[1];
+    int32_t nx;
+    int32_t ny;
+    
+    n = (n > GFX_CMD_CURVE_STEPS) ? GFX_CMD_CURVE_STEPS : n;
+    n3 = n * n * n;
+    for (i = 1; i <= n; i++)
+    {
+        j = n - i;
+        nx = gfx_cmd_div(j * j * j * p[0] + 3 * j * j * i * p[2] + 3 * j * i * i * p[4] + i * i * i * p[6], n3);
+        ny = gfx_cmd_div(j * j * j * p[1] + 3 * j * j * i * p[3] + 3 * j * i * i * p[5] + i * i * i * p[7], n3);
+        gfx_cmd_edge_line(x, y, nx, ny);
+        x = nx;
+        y = ny;
+    }
+}
+
+/**
+ * @brief   ·չƽΪֱ߱
+ * @param   path: ·Ԫ
+ * @param   words: ·Ԫ
+ * @retval  
+ */
+static void gfx_cmd_edge_path(const uint32_t *path, uint32_t words)
+{
+    static const uint8_t point_count[5] = {1, 1, 2, 3, 0};
+    const int32_t *p;
+    int32_t curve[8];
+    int32_t start_x = 0;
+    int32_t start_y = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+    uint32_t verb;
+    uint32_t i = 0;
+    
+    while (i < words)
+    {
+        verb = path[i++];
+        if ((verb > GFX_PATH_CLOSE) || ((i + point_count[verb] * 2U) > words))
+        {
+            break;
+        }
+        p = (const int32_t *)&path[i];
+        i += point_count[verb] * 2U;
+        
+        switch (verb)
+        {
+            case GFX_PATH_MOVE:
+            {
+                gfx_cmd_edge_line(x, y, start_x, start_y);
+                start_x = p[0];
+                start_y = p[1];
+                x = p[0];
+                y = p[1];
+                break;
+            }
+            case GFX_PATH_LINE:
+            {
+                gfx_cmd_edge_line(x, y, p[0], p[1]);
+                x = p[0];
+                y = p[1];
+                break;
+            }
+            case GFX_PATH_QUAD:
+            case GFX_PATH_CUBIC:
+            {
+                curve[0] = x;
+                curve[1] = y;
+                memcpy(&curve[2], p, point_count[verb] * 2 * sizeof(int32_t));
+                if (verb == GFX_PATH_QUAD)
+                {
+                    gfx_cmd_edge_quad(curve);
+                }
+                else
+                {
+                    gfx_cmd_edge_cubic(curve);
+                }
+                x = p[point_count[verb] * 2 - 2];
+                y = p[point_count[verb] * 2 - 1];
+                break;
+            }
+            default:
+            {
+                gfx_cmd_edge_line(x, y, start_x, start_y);
+                x = start_x;
+                y = start_y;
+                break;
+            }
+        }
+    }
+    
+    /* δպϵ·Զպ */
+    gfx_cmd_edge_line(x, y, start_x, start_y);
+}
+
+/**
+ * @brief   ԲǾչƽΪֱ߱
+ * @param   cmd: 
+ * @retval  
+ */
+static void gfx_cmd_edge_round_rect(const gfx_cmd_t *cmd)
+{
+    int32_t x0 = cmd->x;
+    int32_t y0 = cmd->y;
+    int32_t x1 = cmd->x + cmd->width;
+    int32_t y1 = cmd->y + cmd->height;
+    int32_t r = cmd->radius;
+    int32_t k;
+    int32_t curve[8];
+    
+    r = (r > (cmd->width / 2)) ? (cmd->width / 2) : r;
+    r = (r > (cmd->height / 2)) ? (cmd->height / 2) : r;
+    k = (int32_t)(((int64_t)r * 36195) >> 16);      /* ߽1/4ԲĿƵ0.5523r */
+    
+    gfx_cmd_edge_line(x0 + r, y0, x1 - r, y0);
+    curve[0] = x1 - r; curve[1] = y0; curve[2] = x1 - r + k; curve[3] = y0;
+    curve[4] = x1; curve[5] = y0 + r - k; curve[6] = x1; curve[7] = y0 + r;
+    gfx_cmd_edge_cubic(curve);
+    gfx_cmd_edge_line(x1, y0 + r, x1, y1 - r);
+    curve[0] = x1; curve[1] = y1 - r; curve[2] = x1; curve[3] = y1 - r + k;
+    curve[4] = x1 - r + k; curve[5] = y1; curve[6] = x1 - r; curve[7] = y1;
+    gfx_cmd_edge_cubic(curve);
+    gfx_cmd_edge_line(x1 - r, y1, x0 + r, y1);
+    curve[0] = x0 + r; curve[1] = y1; curve[2] = x0 + r - k; curve[3] = y1;
+    curve[4] = x0; curve[5] = y1 - r + k; curve[6] = x0; curve[7] = y1 - r;
+    gfx_cmd_edge_cubic(curve);
+    gfx_cmd_edge_line(x0, y1 - r, x0, y0 + r);
+    curve[0] = x0; curve[1] = y0 + r; curve[2] = x0; curve[3] = y0 + r - k;
+    curve[4] = x0 + r - k; curve[5] = y0; curve[6] = x0 + r; curve[7] = y0;
+    gfx_cmd_edge_cubic(curve);
+}
+
+/**
+ * @brief   ıε
+ * @param   cmd: 
+ * @retval  
+ */
+static void gfx_cmd_edge_quad_texture(const gfx_cmd_t *cmd)
+{
+    const int32_t *m = cmd->matrix;
+    int64_t u[4] = {0, cmd->texture->width, cmd->texture->width, 0};
+    int64_t v[4] = {0, 0, cmd->texture->height, cmd->texture->height};
+    int32_t x[4];
+    int32_t y[4];
+    uint32_t i;
+    
+    for (i = 0; i < 4; i++)
+    {
+        x[i] = (int32_t)((m[0] * u[i] + m[1] * v[i] + m[4]) >> 12);
+        y[i] = (int32_t)((m[2] * u[i] + m[3] * v[i] + m[5]) >> 12);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        gfx_cmd_edge_line(x[i], y[i], x[(i + 1) % 4], y[(i + 1) % 4]);
+    }
+}
+
+/**
+ * @brief   ׼ˢ״̬
+ * @param   state: ˢ״̬
+ * @param   cmd: 
+ * @retval  0: ɹ; 1: 任
+ */
+static uint8_t gfx_cmd_paint_setup(gfx_cmd_paint_state_t *state, const gfx_cmd_t *cmd)
+{
+    const gfx_paint_t *paint = &cmd->paint;
+    int64_t dx;
+    int64_t dy;
+    int64_t len2;
+    int64_t det;
+    
+    memset(state, 0, sizeof(gfx_cmd_paint_state_t));
+    
+    if (cmd->type == GFX_CMD_QUAD)
+    {
+        /* : (u, v) = inv * ((x, y) - t)16.16 */
+        det = (int64_t)cmd->matrix[0] * cmd->matrix[3] - (int64_t)cmd->matrix[1] * cmd->matrix[2];
+        if (det == 0)
+        {
+            return 1;
+        }
+        state->type = GFX_PAINT_TEXTURE;
+        state->texture = cmd->texture;
+        state->alpha = cmd->alpha;
+        state->filter = cmd->filter;
+        state->x0 = cmd->matrix[4];
+        state->y0 = cmd->matrix[5];
+        state->fx = ((int64_t)cmd->matrix[3] * 4294967296LL) / det;
+        state->fy = (-(int64_t)cmd->matrix[1] * 4294967296LL) / det;
+        state->gx = (-(int64_t)cmd->matrix[2] * 4294967296LL) / det;
+        state->gy = ((int64_t)cmd->matrix[0] * 4294967296LL) / det;
+        return 0;
+    }
+    
+    state->type = paint->type;
+    state->color0 = paint->color0;
+    state->color1 = paint->color1;
+    state->x0 = paint->x0;
+    state->y0 = paint->y0;
+    
+    if (paint->type == GFX_PAINT_LINEAR)
+    {
+        /* t = ((p - p0) . d) / |d|^2fxfyΪ32λС */
+        dx = (int64_t)paint->x1 - paint->x0;
+        dy = (int64_t)paint->y1 - paint->y0;
+        len2 = dx * dx + dy * dy;
+        if (len2 == 0)
+        {
+            state->type = GFX_PAINT_SOLID;
+        }
+        else
+        {
+            state->fx = (dx * 4294967296LL) / len2;
+            state->fy = (dy * 4294967296LL) / len2;
+        }
+    }
+    else if (paint->type == GFX_PAINT_RADIAL)
+    {
+        state->radius_inv = (uint32_t)(4294967295ULL / (uint32_t)paint->x1);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡأ곬ΧʱȡԵ
+ * @param   texture: 
+ * @param   u, v: 
+ * @retval  ARGB8888ɫ
+ */
+static uint32_t gfx_cmd_texel(const gfx_surface_t *texture, int32_t u, int32_t v)
+{
+    const uint8_t *line;
+    
+    u = (u < 0) ? 0 : ((u >= texture->width) ? (texture->width - 1) : u);
+    v = (v < 0) ? 0 : ((v >= texture->height) ? (texture->height - 1) : v);
+    line = (const uint8_t *)texture->data + v * texture->pitch;
+    
+    if (texture->format == GFX_FORMAT_RGB565)
+    {
+        return gfx_soft_from_rgb565(((const uint16_t *)line)[u]);
+    }
+    
+    return ((const uint32_t *)line)[u];
+}
+
+/**
+ * @brief   㻭ˢĵɫ
+ * @param   state: ˢ״̬
+ * @param   x, y: 
+ * @retval  ARGB8888ɫԤˣ
+ */
+static uint32_t gfx_cmd_shade(const gfx_cmd_paint_state_t *state, int32_t x, int32_t y)
+{
+    int64_t t;
+    int64_t px;
+    int64_t py;
+    int32_t u;
+    int32_t v;
+    uint32_t fu;
+    uint32_t fv;
+    uint32_t c[4];
+    uint32_t result;
+    uint32_t shift;
+    uint32_t top;
+    uint32_t bottom;
+    uint32_t i;
+    
+    switch (state->type)
+    {
+        case GFX_PAINT_SOLID:
+        {
+            return state->color0;
+        }
+        case GFX_PAINT_LINEAR:
+        {
+            t = ((int64_t)(x * 16 + 8 - state->x0) * state->fx + (int64_t)(y * 16 + 8 - state->y0) * state->fy) >> 16;
+            t = (t < 0) ? 0 : ((t > 65536) ? 65536 : t);
+            return gfx_cmd_lerp(state->color0, state->color1, (uint32_t)t);
+        }
+        case GFX_PAINT_RADIAL:
+        {
+            px = (int64_t)x * 16 + 8 - state->x0;
+            py = (int64_t)y * 16 + 8 - state->y0;
+            t = ((int64_t)gfx_cmd_isqrt((uint64_t)(px * px + py * py)) * state->radius_inv) >> 16;
+            t = (t > 65536) ? 65536 : t;
+            return gfx_cmd_lerp(state->color0, state->color1, (uint32_t)t);
+        }
+        default:
+        {
+            break;
+        }
+    }
+    
+    /* 任꣨16.16 */
+    px = ((int64_t)x << 16) + 32768 - state->x0;
+    py = ((int64_t)y << 16) + 32768 - state->y0;
+    u = (int32_t)((state->fx * px + state->fy * py) >> 16);
+    v = (int32_t)((state->gx * px + state->gy * py) >> 16);
+    
+    if (state->filter == GFX_FILTER_NEAREST)
+    {
+        result = gfx_cmd_texel(state->texture, u >> 16, v >> 16);
+    }
+    else
+    {
+        u -= 32768;
+        v -= 32768;
+        fu = ((uint32_t)u >> 8) & 0xFF;
+        fv = ((uint32_t)v >> 8) & 0xFF;
+        c[0] = gfx_cmd_texel(state->texture, u >> 16, v >> 16);
+        c[1] = gfx_cmd_texel(state->texture, (u >> 16) + 1, v >> 16);
+        c[2] = gfx_cmd_texel(state->texture, u >> 16, (v >> 16) + 1);
+        c[3] = gfx_cmd_texel(state->texture, (u >> 16) + 1, (v >> 16) + 1);
+        result = 0;
+        for (shift = 0; shift < 32; shift += 8)
+        {
+            i = shift;
+            top = ((c[0] >> i) & 0xFF) * (256 - fu) + ((c[1] >> i) & 0xFF) * fu;
+            bottom = ((c[2] >> i) & 0xFF) * (256 - fu) + ((c[3] >> i) & 0xFF) * fu;
+            result |= ((top * (256 - fv) + bottom * fv + 32768) >> 16) << shift;
+        }
+    }
+    
+    return (result & 0x00FFFFFF) | (gfx_cmd_mul(result >> 24, state->alpha) << 24);
+}
+
+/**
+ * @brief   ʰɫϵĿ
+ * @param   line: Ŀ׵ַ
+ * @param   format: Ŀظʽ
+ * @param   x: 
+ * @param   color: ɫARGB8888
+ * @param   cover: ʣ0 ~ 255
+ * @retval  
+ */
+static void gfx_cmd_plot(uint8_t *line, uint8_t format, int32_t x, uint32_t color, uint32_t cover)
+{
+    uint32_t alpha = gfx_cmd_mul(color >> 24, cover);
+    uint16_t *pixel16;
+    uint32_t *pixel32;
+    
+    if (alpha == 0)
+    {
+        return;
+    }
+    color = (color & 0x00FFFFFF) | (alpha << 24);
+    
+    if (format == GFX_FORMAT_RGB565)
+    {
+        pixel16 = &((uint16_t *)line)[x];
+        *pixel16 = gfx_soft_to_rgb565((alpha == 0xFF) ? color : gfx_soft_blend(color, gfx_soft_from_rgb565(*pixel16)));
+    }
+    else
+    {
+        pixel32 = &((uint32_t *)line)[x];
+        *pixel32 = gfx_soft_blend(color, *pixel32);
+    }
+}
+
+/**
+ * @brief   ɨϵһۼӵиʻ
+ * @param   xa, xb: 䣨1/16أڲüΧڣ
+ * @param   span_min, span_max: иǵطΧ£
+ * @retval  
+ */
+static void gfx_cmd_span(int32_t xa, int32_t xb, int32_t *span_min, int32_t *span_max)
+{
+    int32_t i = xa >> 4;
+    int32_t j = xb >> 4;
+    int32_t k;
+    
+    if (xa >= xb)
+    {
+        return;
+    }
+    
+    if (i == j)
+    {
+        gfx_cmd_cover[i] += (uint16_t)((xb - xa) * GFX_CMD_SUB_WEIGHT);
+    }
+    else
+    {
+        gfx_cmd_cover[i] += (uint16_t)((16 - (xa & 15)) * GFX_CMD_SUB_WEIGHT);
+        for (k = i + 1; k < j; k++)
+        {
+            gfx_cmd_cover[k] += 16 * GFX_CMD_SUB_WEIGHT;
+        }
+        gfx_cmd_cover[j] += (uint16_t)((xb & 15) * GFX_CMD_SUB_WEIGHT);
+    }
+    
+    *span_min = (i < *span_min) ? i : *span_min;
+    *span_max = (j > *span_max) ? j : *span_max;
+}
+
+/**
+ * @brief   ߱䣨ݣ
+ * @param   dst: Ŀ
+ * @param   clip: üΣĿཻ
+ * @param   fill_rule: 
+ * @param   state: ˢ״̬
+ * @retval  
+ */
+static void gfx_cmd_fill(const gfx_surface_t *dst, const gfx_rect_t *clip, uint8_t fill_rule, const gfx_cmd_paint_state_t *state)
+{
+    gfx_cmd_edge_t edge;
+    gfx_cmd_edge_t *e;
+    uint8_t *line;
+    int32_t clip_x0 = clip->x * 16;
+    int32_t clip_x1 = (clip->x + clip->width) * 16;
+    int32_t row0 = gfx_cmd_min_y >> 4;
+    int32_t row1 = (gfx_cmd_max_y + 15) >> 4;
+    int32_t span_min;
+    int32_t span_max;
+    int32_t winding;
+    int32_t row;
+    int32_t ys;
+    int32_t x;
+    int32_t xa;
+    int32_t xb;
+    uint32_t active = 0;
+    uint32_t next = 0;
+    uint32_t count;
+    uint32_t cover;
+    uint32_t i;
+    uint32_t j;
+    uint32_t s;
+    
+    if ((gfx_cmd_edge_count == 0) || (gfx_cmd_edge_overflow != 0) || (gfx_cmd_max_x <= clip_x0) || (gfx_cmd_min_x >= clip_x1))
+    {
+        return;
+    }
+    row0 = (row0 < clip->y) ? clip->y : row0;
+    row1 = (row1 > (clip->y + clip->height)) ? (clip->y + clip->height) : row1;
+    
+    /* ߰϶˵ */
+    for (i = 1; i < gfx_cmd_edge_count; i++)
+    {
+        edge = gfx_cmd_edges[i];
+        for (j = i; (j > 0) && (gfx_cmd_edges[j - 1].y0 > edge.y0); j--)
+        {
+            gfx_cmd_edges[j] = gfx_cmd_edges[j - 1];
+        }
+        gfx_cmd_edges[j] = edge;
+    }
+    
+    for (row = row0; row < row1; row++)
+    {
+        span_min = INT32_MAX;
+        span_max = INT32_MIN;
+        
+        for (s = 0; s < GFX_CMD_SUBSAMPLES; s++)
+        {
+            ys = row * 16 + 2 + (int32_t)s * 4;
+            
+            while ((next < gfx_cmd_edge_count) && (gfx_cmd_edges[next].y0 <= ys))
+            {
+                gfx_cmd_active[active++] = (uint16_t)next;
+                next++;
+            }
+            
+            /* 󽻵㲢xƳѽı */
+            count = 0;
+            for (i = 0; i < active;)
+            {
+                e = &gfx_cmd_edges[gfx_cmd_active[i]];
+                if (e->y1 <= ys)
+                {
+                    gfx_cmd_active[i] = gfx_cmd_active[--active];
+                    continue;
+                }
+                
+                x = e->x0 + (int32_t)(((int64_t)(ys - e->y0) * e->slope) >> 16);
+                for (j = count; (j > 0) && (gfx_cmd_cross_x[j - 1] > x); j--)
+                {
+                    gfx_cmd_cross_x[j] = gfx_cmd_cross_x[j - 1];
+                    gfx_cmd_cross_dir[j] = gfx_cmd_cross_dir[j - 1];
+                }
+                gfx_cmd_cross_x[j] = x;
+                gfx_cmd_cross_dir[j] = (int8_t)e->dir;
+                count++;
+                i++;
+            }
+            
+            winding = 0;
+            for (i = 0; (i + 1) < count; i++)
+            {
+                winding += gfx_cmd_cross_dir[i];
+                if (((fill_rule == GFX_FILL_EVENODD) && ((winding & 1) != 0)) || ((fill_rule == GFX_FILL_NONZERO) && (winding != 0)))
+                {
+                    xa = (gfx_cmd_cross_x[i] < clip_x0) ? clip_x0 : gfx_cmd_cross_x[i];
+                    xb = (gfx_cmd_cross_x[i + 1] > clip_x1) ? clip_x1 : gfx_cmd_cross_x[i + 1];
+                    gfx_cmd_span(xa, xb, &span_min, &span_max);
+                }
+            }
+        }
+        
+        if (span_min > span_max)
+        {
+            continue;
+        }
+        
+        line = (uint8_t *)dst->data + row * dst->pitch;
+        for (x = span_min; x <= span_max; x++)
+        {
+            cover = gfx_cmd_cover[x];
+            if (cover != 0)
+            {
+                gfx_cmd_cover[x] = 0;
+                gfx_cmd_plot(line, dst->format, x, gfx_cmd_shade(state, x, row), cover - (cover >> 8));
+            }
+        }
+    }
+}
+
+/**
+ * @brief   ضľ
+ * @param   dst: Ŀ
+ * @param   clip: üΣĿཻ
+ * @param   rect: 
+ * @param   state: ˢ״̬
+ * @retval  
+ */
+static void gfx_cmd_fill_rect(const gfx_surface_t *dst, const gfx_rect_t *clip, const gfx_rect_t *rect, const gfx_cmd_paint_state_t *state)
+{
+    int32_t x0 = (rect->x > clip->x) ? rect->x : clip->x;
+    int32_t y0 = (rect->y > clip->y) ? rect->y : clip->y;
+    int32_t x1 = ((rect->x + rect->width) < (clip->x + clip->width)) ? (rect->x + rect->width) : (clip->x + clip->width);
+    int32_t y1 = ((rect->y + rect->height) < (clip->y + clip->height)) ? (rect->y + rect->height) : (clip->y + clip->height);
+    uint8_t *line;
+    uint16_t color16;
+    int32_t x;
+    int32_t y;
+    
+    for (y = y0; y < y1; y++)
+    {
+        line = (uint8_t *)dst->data + y * dst->pitch;
+        
+        /* ͸ɫֱд */
+        if ((state->type == GFX_PAINT_SOLID) && ((state->color0 >> 24) == 0xFF))
+        {
+            color16 = gfx_soft_to_rgb565(state->color0);
+            for (x = x0; x < x1; x++)
+            {
+                if (dst->format == GFX_FORMAT_RGB565)
+                {
+                    ((uint16_t *)line)[x] = color16;
+                }
+                else
+                {
+                    ((uint32_t *)line)[x] = state->color0;
+                }
+            }
+            continue;
+        }
+        
+        for (x = x0; x < x1; x++)
+        {
+            gfx_cmd_plot(line, dst->format, x, gfx_cmd_shade(state, x, y), 0xFF);
+        }
+    }
+}
+
+/**
+ * @brief   CPUִһ
+ * @note    üڴ˴ɵ߱üΣĿȲܳGFX_CMD_MAX_WIDTH
+ *          ·չƽ󳬹GFX_CMD_MAX_EDGESʱ
+ * @param   cmd: 
+ * @param   dst: Ŀ棨ARGB8888RGB565
+ * @param   clip: üΣNULLʾĿ棩
+ * @retval  
+ */
+void gfx_cmd_draw(const gfx_cmd_t *cmd, const gfx_surface_t *dst, const gfx_rect_t *clip)
+{
+    gfx_cmd_paint_state_t state;
+    gfx_rect_t area;
+    int32_t x0 = 0;
+    int32_t y0 = 0;
+    int32_t x1 = dst->width;
+    int32_t y1 = dst->height;
+    
+    if ((dst->width > GFX_CMD_MAX_WIDTH) || ((dst->format != GFX_FORMAT_ARGB8888) && (dst->format != GFX_FORMAT_RGB565)))
+    {
+        return;
+    }
+    
+    if (clip != NULL)
+    {
+        x0 = (clip->x > 0) ? clip->x : 0;
+        y0 = (clip->y > 0) ? clip->y : 0;
+        x1 = ((clip->x + clip->width) < x1) ? (clip->x + clip->width) : x1;
+        y1 = ((clip->y + clip->height) < y1) ? (clip->y + clip->height) : y1;
+    }
+    if ((x1 <= x0) || (y1 <= y0) || (gfx_cmd_paint_setup(&state, cmd) != 0))
+    {
+        return;
+    }
+    area.x = (int16_t)x0;
+    area.y = (int16_t)y0;
+    area.width = (int16_t)(x1 - x0);
+    area.height = (int16_t)(y1 - y0);
+    
+    gfx_cmd_edge_reset();
+    switch (cmd->type)
+    {
+        case GFX_CMD_RECT:
+        {
+            gfx_cmd_fill_rect(dst, &area, &cmd->rect, &state);
+            return;
+        }
+        case GFX_CMD_ROUND_RECT:
+        {
+            gfx_cmd_edge_round_rect(cmd);
+            gfx_cmd_fill(dst, &area, GFX_FILL_NONZERO, &state);
+            return;
+        }
+        case GFX_CMD_PATH:
+        {
+            gfx_cmd_edge_path(cmd->path, cmd->path_words);
+            gfx_cmd_fill(dst, &area, cmd->fill_rule, &state);
+            return;
+        }
+        case GFX_CMD_QUAD:
+        {
+            gfx_cmd_edge_quad_texture(cmd);
+            gfx_cmd_fill(dst, &area, GFX_FILL_NONZERO, &state);
+            return;
+        }
+        default:
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief   CPUִб
+ * @param   list: бṹָ
+ * @param   dst: Ŀ棨ARGB8888RGB565
+ * @retval  
+ */
+void gfx_cmd_render(const gfx_cmd_list_t *list, const gfx_surface_t *dst)
+{
+    gfx_rect_t clip = {0, 0, (int16_t)dst->width, (int16_t)dst->height};
+    gfx_cmd_t cmd;
+    uint32_t pos = 0;
+    
+    while (gfx_cmd_next(list, &pos, &cmd) == 0)
+    {
+        if (cmd.type == GFX_CMD_CLIP)
+        {
+            clip = cmd.rect;
+        }
+        else
+        {
+            gfx_cmd_draw(&cmd, dst, &clip);
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_cmd.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ʸͼбդ
+ ****************************************************************************************************
+ * @attention
+ *
+ * б¼һͼüΡԲǾΡ·ֱߡαߣ
+ * /ż򣩡תŵıΣˢǴɫԽ򽥱
+ * бڵṩĻУظִУgfx_cmd_render()CPUִУ
+ * gfx_cmd_exec.hĿϰDMA2DDMA2DñļĹդ
+ * Ϊ1/16ض任Ϊ16.16ȫ㣬ĿλͬTools/gfx_sim
+ * ݣÿ4ɨߣˮƽ1/16ؾȷ㸲
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __GFX_CMD_H
+#define __GFX_CMD_H
+
+#include <stdint.h>
+#include "gfx_soft.h"
+#include "gfx_dirty.h"
+
+/*  */
+#define GFX_CMD_FIXED(v)            ((int32_t)(v) * 16)         /* ת1/16 */
+#define GFX_CMD_ONE                 (65536)                     /* 任е1.0 */
+
+/* դ */
+#define GFX_CMD_MAX_WIDTH           (1024)      /* Ŀȣиʻ */
+#define GFX_CMD_MAX_EDGES           (512)       /* һ·չƽ */
+
+/* Ͷ */
+#define GFX_CMD_CLIP                (1U)        /* òüΣأĿཻ */
+#define GFX_CMD_RECT                (2U)        /* ضľΣ޿ */
+#define GFX_CMD_ROUND_RECT          (3U)        /* ԲǾ */
+#define GFX_CMD_PATH                (4U)        /* · */
+#define GFX_CMD_QUAD                (5U)        /* ıΣ任ƣ */
+
+/* ·Ԫض */
+#define GFX_PATH_MOVE               (0U)        /* 1 */
+#define GFX_PATH_LINE               (1U)        /* 1 */
+#define GFX_PATH_QUAD               (2U)        /* Ƶյ */
+#define GFX_PATH_CUBIC              (3U)        /* 2Ƶյ */
+#define GFX_PATH_CLOSE              (4U)        /* ص· */
+
+/*  */
+#define GFX_FILL_NONZERO            (0U)
+#define GFX_FILL_EVENODD            (1U)
+
+/* ˢͶ */
+#define GFX_PAINT_SOLID             (0U)        /* ɫcolor0 */
+#define GFX_PAINT_LINEAR            (1U)        /* (x0, y0)Ϊcolor0(x1, y1)Ϊcolor1֮˵ɫ */
+#define GFX_PAINT_RADIAL            (2U)        /* Բ(x0, y0)Ϊcolor0뾶x1Ϊcolor1 */
+
+/* ˷ʽ */
+#define GFX_FILTER_NEAREST          (0U)
+#define GFX_FILTER_BILINEAR         (1U)
+
+/* ˢ */
+typedef struct {
+    uint8_t type;           /* ˢ */
+    uint32_t color0;        /* ɫ򽥱ɫARGB8888Ԥˣ */
+    uint32_t color1;        /* յɫ */
+    int32_t x0;             /* 伸β1/16أ */
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+} gfx_paint_t;
+
+/*  */
+typedef struct {
+    uint8_t type;           /*  */
+    uint8_t fill_rule;      /* · */
+    uint8_t alpha;          /* ıalpha */
+    uint8_t filter;         /* ˷ʽ */
+    gfx_rect_t rect;        /* üλΣأ */
+    int32_t x;              /* ԲǾΣ1/16أ */
+    int32_t y;
+    int32_t width;
+    int32_t height;
+    int32_t radius;
+    gfx_paint_t paint;      /* ˢ */
+    const uint32_t *path;   /* ·ԪأÿԪ1֣ÿ2: x, y */
+    uint32_t path_words;    /* ·Ԫ */
+    const gfx_surface_t *texture;   /* ARGB8888RGB565 */
+    int32_t matrix[6];      /* Ļı任: x = a * u + b * v + tx, y = c * u + d * v + tya, b, c, d, tx, ty16.16 */
+} gfx_cmd_t;
+
+/* б */
+typedef struct {
+    uint32_t *buffer;       /*  */
+    uint32_t size;          /* С֣ */
+    uint32_t used;          /* ôС֣ */
+    uint32_t count;         /*  */
+    uint32_t path;          /* ڹ·λãUINT32_MAXʾûУ */
+    uint8_t error;          /* ռ䲻󣩣 */
+} gfx_cmd_list_t;
+
+/*  */
+void gfx_cmd_init(gfx_cmd_list_t *list, uint32_t *buffer, uint32_t size);           /* ʼб */
+void gfx_cmd_reset(gfx_cmd_list_t *list);                                           /* б */
+uint8_t gfx_cmd_clip(gfx_cmd_list_t *list, int32_t x, int32_t y, int32_t width, int32_t height);  /* òü */
+uint8_t gfx_cmd_rect(gfx_cmd_list_t *list, int32_t x, int32_t y, int32_t width, int32_t height, const gfx_paint_t *paint);   /* ضľ */
+uint8_t gfx_cmd_round_rect(gfx_cmd_list_t *list, int32_t x, int32_t y, int32_t width, int32_t height, int32_t radius, const gfx_paint_t *paint);   /* ԲǾ */
+uint8_t gfx_cmd_path_begin(gfx_cmd_list_t *list, uint8_t fill_rule, const gfx_paint_t *paint);   /* ʼ· */
+uint8_t gfx_cmd_move_to(gfx_cmd_list_t *list, int32_t x, int32_t y);               /* ʼ· */
+uint8_t gfx_cmd_line_to(gfx_cmd_list_t *list, int32_t x, int32_t y);               /* ֱ */
+uint8_t gfx_cmd_quad_to(gfx_cmd_list_t *list, int32_t cx, int32_t cy, int32_t x, int32_t y);   /* α */
+uint8_t gfx_cmd_cubic_to(gfx_cmd_list_t *list, int32_t cx0, int32_t cy0, int32_t cx1, int32_t cy1, int32_t x, int32_t y);  /* α */
+uint8_t gfx_cmd_close(gfx_cmd_list_t *list);                                        /* պ· */
+uint8_t gfx_cmd_path_end(gfx_cmd_list_t *list);                                     /* · */
+uint8_t gfx_cmd_quad(gfx_cmd_list_t *list, const gfx_surface_t *texture, const int32_t matrix[6], uint8_t alpha, uint8_t filter);  /* ı */
+void gfx_cmd_matrix(int32_t matrix[6], int32_t angle, int32_t scale, int32_t x, int32_t y, int32_t cx, int32_t cy);   /* תƽƾ */
+uint8_t gfx_cmd_next(const gfx_cmd_list_t *list, uint32_t *pos, gfx_cmd_t *cmd);    /* һ */
+void gfx_cmd_draw(const gfx_cmd_t *cmd, const gfx_surface_t *dst, const gfx_rect_t *clip);   /* CPUִһ */
+void gfx_cmd_render(const gfx_cmd_list_t *list, const gfx_surface_t *dst);          /* CPUִб */
+
+#endif /* __GFX_CMD_H */
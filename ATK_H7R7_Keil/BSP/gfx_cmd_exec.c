@@ -0,0 +1,209 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_cmd_exec.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ʸͼбִд루DMA2Dֵ
+ ****************************************************************************************************
+ * @attention
+ *
+ * DMA2Dֻ䡢ϣֵֻضҲҪݵ
+ * ύʱgfx_dma2d_submit()дزЧĿD-Cache֮ǰCPUдزᶪʧ
+ * CPUդǰȴDMA2Dɣ֤˳Ч
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfx_cmd_exec.h"
+#include "gfx_dma2d.h"
+#include <string.h>
+
+/**
+ * @brief   ȡÿ΢DWT
+ * @param   
+ * @retval  
+ */
+static uint32_t gfx_cmd_exec_cycles_per_us(void)
+{
+    return (SystemCoreClock / 1000000 != 0) ? (SystemCoreClock / 1000000) : 1;
+}
+
+/**
+ * @brief   ü
+ * @param   clip: ü
+ * @param   x, y, width, height: ΣΪཻ֣
+ * @retval  0: ַཻǿ; 1: Ϊ
+ */
+static uint8_t gfx_cmd_exec_clip(const gfx_rect_t *clip, int32_t *x, int32_t *y, int32_t *width, int32_t *height)
+{
+    int32_t x0 = (*x > clip->x) ? *x : clip->x;
+    int32_t y0 = (*y > clip->y) ? *y : clip->y;
+    int32_t x1 = ((*x + *width) < (clip->x + clip->width)) ? (*x + *width) : (clip->x + clip->width);
+    int32_t y1 = ((*y + *height) < (clip->y + clip->height)) ? (*y + *height) : (clip->y + clip->height);
+    
+    if ((x1 <= x0) || (y1 <= y0))
+    {
+        return 1;
+    }
+    
+    *x = x0;
+    *y = y0;
+    *width = x1 - x0;
+    *height = y1 - y0;
+    
+    return 0;
+}
+
+/**
+ * @brief   һDMA2D
+ * @param   cmd: 
+ * @param   dst: Ŀ
+ * @param   clip: ü
+ * @retval  0: ύüΪգ; 1: DMA2DִиύʧܣҪCPUִ
+ */
+static uint8_t gfx_cmd_exec_offload(const gfx_cmd_t *cmd, const gfx_surface_t *dst, const gfx_rect_t *clip)
+{
+    const int32_t *m = cmd->matrix;
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+    int32_t sx;
+    int32_t sy;
+    
+    /* ͸ɫΣ */
+    if ((cmd->type == GFX_CMD_RECT) && (cmd->paint.type == GFX_PAINT_SOLID) && ((cmd->paint.color0 >> 24) == 0xFF))
+    {
+        x = cmd->rect.x;
+        y = cmd->rect.y;
+        width = cmd->rect.width;
+        height = cmd->rect.height;
+        if (gfx_cmd_exec_clip(clip, &x, &y, &width, &height) != 0)
+        {
+            return 0;
+        }
+        
+        return gfx_dma2d_fill(dst, x, y, width, height, cmd->paint.color0);
+    }
+    
+    /* ֻƽƵıΣƻϣʱֹ˷ʽĽر */
+    if ((cmd->type == GFX_CMD_QUAD) && (m[0] == GFX_CMD_ONE) && (m[1] == 0) && (m[2] == 0) && (m[3] == GFX_CMD_ONE) &&
+        ((m[4] & 0xFFFF) == 0) && ((m[5] & 0xFFFF) == 0))
+    {
+        x = m[4] >> 16;
+        y = m[5] >> 16;
+        width = cmd->texture->width;
+        height = cmd->texture->height;
+        sx = x;
+        sy = y;
+        if (gfx_cmd_exec_clip(clip, &x, &y, &width, &height) != 0)
+        {
+            return 0;
+        }
+        sx = x - sx;
+        sy = y - sy;
+        
+        if ((cmd->texture->format == GFX_FORMAT_RGB565) && (cmd->alpha == 0xFF))
+        {
+            return gfx_dma2d_copy(dst, x, y, cmd->texture, sx, sy, width, height);
+        }
+        
+        return gfx_dma2d_blend(dst, x, y, cmd->texture, sx, sy, width, height, cmd->alpha);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief   ִб
+ * @note    use_dma2dΪ0ʱȫCPUִУgfx_cmd_render()ͬʱִ
+ * @param   list: бṹָ
+ * @param   dst: Ŀ棨ARGB8888RGB565
+ * @param   use_dma2d: 0: ֻCPU; 1: ֵDMA2D
+ * @param   stats: ִͳƣΪNULL
+ * @retval  ִн
+ * @arg     0: ִ
+ * @arg     1: бδִУȴDMA2Dʱ
+ */
+uint8_t gfx_cmd_exec(const gfx_cmd_list_t *list, const gfx_surface_t *dst, uint8_t use_dma2d, gfx_cmd_exec_stats_t *stats)
+{
+    gfx_rect_t clip = {0, 0, (int16_t)dst->width, (int16_t)dst->height};
+    gfx_cmd_exec_stats_t result;
+    gfx_cmd_t cmd;
+    uint32_t cycles_per_us = gfx_cmd_exec_cycles_per_us();
+    uint32_t total_start = DWT->CYCCNT;
+    uint32_t cpu_cycles = 0;
+    uint32_t start;
+    uint32_t pos = 0;
+    uint8_t res = 0;
+    
+    memset(&result, 0, sizeof(result));
+    if (list->error != 0)
+    {
+        res = 1;
+    }
+    
+    while ((res == 0) && (gfx_cmd_next(list, &pos, &cmd) == 0))
+    {
+        if (cmd.type == GFX_CMD_CLIP)
+        {
+            clip = cmd.rect;
+            continue;
+        }
+        
+        result.commands++;
+        if ((use_dma2d != 0) && (gfx_cmd_exec_offload(&cmd, dst, &clip) == 0))
+        {
+            result.offloaded++;
+            continue;
+        }
+        
+        /* CPUдǰȴ֮ǰύDMA2D */
+        if ((use_dma2d != 0) && (gfx_dma2d_wait(GFX_CMD_EXEC_TIMEOUT) != 0))
+        {
+            res = 1;
+            break;
+        }
+        
+        start = DWT->CYCCNT;
+        gfx_cmd_draw(&cmd, dst, &clip);
+        cpu_cycles += DWT->CYCCNT - start;
+    }
+    
+    if ((use_dma2d != 0) && (gfx_dma2d_wait(GFX_CMD_EXEC_TIMEOUT) != 0))
+    {
+        res = 1;
+    }
+    
+    result.cpu_us = cpu_cycles / cycles_per_us;
+    result.total_us = (DWT->CYCCNT - total_start) / cycles_per_us;
+    if (stats != NULL)
+    {
+        *stats = result;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief   CPUDMA2Dִֵмʱ
+ * @note    ͬһбִΣȴCPUٷֵDMA2DνͬҪȵgfx_dma2d_init()
+ * @param   list: бṹָ
+ * @param   dst: Ŀ棨ARGB8888RGB565
+ * @param   result: ʱ
+ * @retval  0: ɹ; 1: бȴDMA2Dʱ
+ */
+uint8_t gfx_cmd_exec_time(const gfx_cmd_list_t *list, const gfx_surface_t *dst, gfx_cmd_exec_time_t *result)
+{
+    gfx_cmd_exec_stats_t stats;
+    
+    memset(result, 0, sizeof(gfx_cmd_exec_time_t));
+    
+    if (gfx_cmd_exec(list, dst, 0, &stats) != 0)
+    {
+        return 1;
+    }
+    result->cpu_only_us = stats.total_us;
+    
+    return gfx_cmd_exec(list, dst, 1, &result->accel);
+}
@@ -0,0 +1,45 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_cmd_exec.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ʸͼбִд루DMA2Dֵ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ִб͸ɫֻƽƵıνDMA2D䡢ơϣ
+ * ȴDMA2Dɺgfx_cmd_draw()CPUϹդִнgfx_cmd_render()λͬ
+ * ĿλDMA2DɷʵĴ洢Ҫȵgfx_dma2d_init()
+ * gfx_cmd_exec_time()ֱʱCPUִDMA2DִֵУֵЧ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __GFX_CMD_EXEC_H
+#define __GFX_CMD_EXEC_H
+
+#include "main.h"
+#include "gfx_cmd.h"
+
+/* ȴDMA2Dɳʱʱ䶨壨ms */
+#define GFX_CMD_EXEC_TIMEOUT        (100)
+
+/* бִͳƶ */
+typedef struct {
+    uint32_t commands;      /* ִеü */
+    uint32_t offloaded;     /* DMA2D */
+    uint32_t cpu_us;        /* CPUդʱ䣨us */
+    uint32_t total_us;      /* ִʱ䣨ȴDMA2Dus */
+} gfx_cmd_exec_stats_t;
+
+/* ʱ */
+typedef struct {
+    uint32_t cpu_only_us;   /* CPUִʱ䣨us */
+    gfx_cmd_exec_stats_t accel;     /* DMA2Dִֵеͳ */
+} gfx_cmd_exec_time_t;
+
+/*  */
+uint8_t gfx_cmd_exec(const gfx_cmd_list_t *list, const gfx_surface_t *dst, uint8_t use_dma2d, gfx_cmd_exec_stats_t *stats);   /* ִб */
+uint8_t gfx_cmd_exec_time(const gfx_cmd_list_t *list, const gfx_surface_t *dst, gfx_cmd_exec_time_t *result);  /* CPUDMA2Dִֵмʱ */
+
+#endif /* __GFX_CMD_EXEC_H */
@@ -0,0 +1,217 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_compose.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ֲˢºϳɴ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ƶȡʾǰֻӰʾдĺ󻺳ڷҳɺŲٱɨ裬
+ * ԸǰȴһηҳɣػʱΪ࣬һ֡ػָһ
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfx_compose.h"
+#include "gfx_dma2d.h"
+#include "ltdc_fb.h"
+
+static gfx_dirty_t gfx_compose_dirty;
+static uint8_t gfx_compose_format = GFX_FORMAT_RGB565;
+static uint8_t gfx_compose_dma2d = 0;
+static uint8_t gfx_compose_ready = 0;
+
+/**
+ * @brief   ʼֲˢºϳ
+ * @note    ltdc_fb_init()֮ãuse_dma2dΪ1ʱѵgfx_dma2d_init()
+ *          δ֪һ֡ػ
+ * @param   use_dma2d: 0: CPU; 1: DMA2D
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: ֡δʼظʽֻ֧֣֧ARGB8888RGB565
+ */
+uint8_t gfx_compose_init(uint8_t use_dma2d)
+{
+    uint32_t width = ltdc_fb_get_width();
+    uint32_t height = ltdc_fb_get_height();
+    uint8_t pixel_size;
+    
+    gfx_compose_ready = 0;
+    
+    switch (hltdc.LayerCfg[0].PixelFormat)
+    {
+        case LTDC_PIXEL_FORMAT_ARGB8888:
+        {
+            gfx_compose_format = GFX_FORMAT_ARGB8888;
+            pixel_size = 4;
+            break;
+        }
+        case LTDC_PIXEL_FORMAT_RGB565:
+        {
+            gfx_compose_format = GFX_FORMAT_RGB565;
+            pixel_size = 2;
+            break;
+        }
+        default:
+        {
+            return 1;
+        }
+    }
+    
+    if ((width == 0) || (height == 0) || (ltdc_fb_get_front() == NULL))
+    {
+        return 1;
+    }
+    
+    gfx_dirty_init(&gfx_compose_dirty, (uint16_t)width, (uint16_t)height, pixel_size);
+    gfx_dirty_add_all(&gfx_compose_dirty);
+    gfx_compose_dma2d = use_dma2d;
+    gfx_compose_ready = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief   Ǳ仯
+ * @note    ֻѭеãgfx_compose_frame()ͬһģ
+ * @param   x, y: ϽǣΪĻĲֱü
+ * @param   width, height: 
+ * @retval  
+ */
+void gfx_compose_invalidate(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    if (gfx_compose_ready != 0)
+    {
+        gfx_dirty_add(&gfx_compose_dirty, x, y, width, height);
+    }
+}
+
+/**
+ * @brief   仯
+ * @param   
+ * @retval  
+ */
+void gfx_compose_invalidate_all(void)
+{
+    if (gfx_compose_ready != 0)
+    {
+        gfx_dirty_add_all(&gfx_compose_dirty);
+    }
+}
+
+/**
+ * @brief   ֡Ļͼ
+ * @param   surface: ͼ
+ * @param   data: ַ
+ * @retval  
+ */
+static void gfx_compose_surface(gfx_surface_t *surface, void *data)
+{
+    surface->data = data;
+    surface->pitch = ltdc_fb_get_pitch();
+    surface->width = gfx_compose_dirty.width;
+    surface->height = gfx_compose_dirty.height;
+    surface->format = gfx_compose_format;
+    surface->clut = NULL;
+    surface->color = 0;
+}
+
+/**
+ * @brief   ϳһ֡
+ * @note    б仯ʱȴһηҳɣƹ򣬶ÿεrenderȴDMA2Dɺҳ
+ *          ҳһδֱЧȴٴεʱȴ
+ * @param   render: ػص
+ * @param   arg: ص
+ * @retval  ϳɽ
+ * @arg     0: ػ沢ҳ
+ * @arg     1: δʼȴҳDMA2DʱΪࣩ
+ * @arg     2: ûб仯
+ */
+uint8_t gfx_compose_frame(gfx_compose_render_t render, void *arg)
+{
+    gfx_rect_t copy[GFX_DIRTY_RECT_NUM];
+    gfx_rect_t rects[GFX_DIRTY_RECT_NUM];
+    gfx_surface_t front;
+    gfx_surface_t back;
+    gfx_op_t op;
+    uint32_t copy_num;
+    uint32_t render_num;
+    uint32_t i;
+    
+    if ((gfx_compose_ready == 0) || (render == NULL))
+    {
+        return 1;
+    }
+    
+    if (gfx_compose_dirty.count == 0)
+    {
+        gfx_dirty_frame(&gfx_compose_dirty, copy, &copy_num, rects, &render_num);
+        return 2;
+    }
+    
+    /* 󻺳ڷҳǰʾ */
+    if (ltdc_fb_wait(GFX_COMPOSE_TIMEOUT) != 0)
+    {
+        return 1;
+    }
+    
+    gfx_dirty_frame(&gfx_compose_dirty, copy, &copy_num, rects, &render_num);
+    gfx_compose_surface(&front, ltdc_fb_get_front());
+    gfx_compose_surface(&back, ltdc_fb_get_back());
+    
+    /* 󻺳һ֡Ȳһ֡ػ */
+    for (i = 0; i < copy_num; i++)
+    {
+        if ((gfx_compose_dma2d != 0) &&
+            (gfx_dma2d_copy(&back, copy[i].x, copy[i].y, &front, copy[i].x, copy[i].y, copy[i].width, copy[i].height) == 0))
+        {
+            continue;
+        }
+        
+        if (gfx_op_copy(&op, &back, copy[i].x, copy[i].y, &front, copy[i].x, copy[i].y, copy[i].width, copy[i].height) == 0)
+        {
+            gfx_soft_execute(&op);
+        }
+    }
+    
+    if (gfx_dma2d_wait(GFX_COMPOSE_TIMEOUT) != 0)
+    {
+        gfx_dirty_add_all(&gfx_compose_dirty);
+        return 1;
+    }
+    
+    for (i = 0; i < render_num; i++)
+    {
+        render(&back, &rects[i], arg);
+    }
+    
+    /* صύDMA2Dڷҳǰ */
+    if ((gfx_dma2d_wait(GFX_COMPOSE_TIMEOUT) != 0) || (ltdc_fb_flip() != 0))
+    {
+        gfx_dirty_add_all(&gfx_compose_dirty);
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡϳͳ
+ * @param   stats: ͳƽṹָ
+ * @retval  
+ */
+void gfx_compose_get_stats(gfx_dirty_stats_t *stats)
+{
+    *stats = gfx_compose_dirty.stats;
+}
+
+/**
+ * @brief   ϳͳ
+ * @param   
+ * @retval  
+ */
+void gfx_compose_reset_stats(void)
+{
+    gfx_dirty_reset_stats(&gfx_compose_dirty);
+}
@@ -0,0 +1,40 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_compose.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ֲˢºϳɴ
+ ****************************************************************************************************
+ * @attention
+ *
+ * gfx_compose_invalidate()Ǳ仯gfx_compose_frame()ÿ֡
+ * ȴһηҳɣһ֡ػǰƵ󻺳gfx_dirty.h
+ * ԺϲÿεػصȻltdc_fb_flip()ûб仯֡ơҳ
+ * ʹDMA2Dgfx_dma2d_init()ѵʱgfx_soft_execute()ڻص֮ǰ
+ * 800x480 RGB565ػÿ֡д750KBֲˢֻͳƼgfx_compose_get_stats()
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __GFX_COMPOSE_H
+#define __GFX_COMPOSE_H
+
+#include "main.h"
+#include "gfx_soft.h"
+#include "gfx_dirty.h"
+
+/* ȴҳDMA2DƵĳʱʱ䶨壨ms */
+#define GFX_COMPOSE_TIMEOUT         (100)
+
+/* ػص壨surfaceΪ󻺳ػrectڵÿأصύDMA2Dڷҳǰȴɣ */
+typedef void (*gfx_compose_render_t)(const gfx_surface_t *surface, const gfx_rect_t *rect, void *arg);
+
+/*  */
+uint8_t gfx_compose_init(uint8_t use_dma2d);                                        /* ʼֲˢºϳ */
+void gfx_compose_invalidate(int32_t x, int32_t y, int32_t width, int32_t height);   /* Ǳ仯 */
+void gfx_compose_invalidate_all(void);                                              /* 仯 */
+uint8_t gfx_compose_frame(gfx_compose_render_t render, void *arg);                  /* ϳһ֡ */
+void gfx_compose_get_stats(gfx_dirty_stats_t *stats);                               /* ȡϳͳ */
+void gfx_compose_reset_stats(void);                                                 /* ϳͳ */
+
+#endif /* __GFX_COMPOSE_H */
@@ -0,0 +1,300 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_dirty.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       θٴ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ϲоݣӾ - θǵ˷GFX_DIRTY_MERGE_SLACK
+ * ϲľομϲ֮صصֻᱻػ
+ * ֽд㣨ػдһΣƶдһΣػʱȡز
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfx_dirty.h"
+#include <string.h>
+
+/**
+ * @brief   
+ * @param   rect: 
+ * @retval  أ
+ */
+static uint32_t gfx_rect_area(const gfx_rect_t *rect)
+{
+    return (uint32_t)rect->width * (uint32_t)rect->height;
+}
+
+/**
+ * @brief   жϾaǷb
+ * @param   a, b: 
+ * @retval  0: ; 1: 
+ */
+static uint8_t gfx_rect_contains(const gfx_rect_t *a, const gfx_rect_t *b)
+{
+    return (b->x >= a->x) && (b->y >= a->y) && ((b->x + b->width) <= (a->x + a->width)) &&
+           ((b->y + b->height) <= (a->y + a->height));
+}
+
+/**
+ * @brief   εӾ
+ * @param   a, b: 
+ * @param   out: ӾΣabͬ
+ * @retval  
+ */
+static void gfx_rect_union(const gfx_rect_t *a, const gfx_rect_t *b, gfx_rect_t *out)
+{
+    int32_t x0 = (a->x < b->x) ? a->x : b->x;
+    int32_t y0 = (a->y < b->y) ? a->y : b->y;
+    int32_t x1 = ((a->x + a->width) > (b->x + b->width)) ? (a->x + a->width) : (b->x + b->width);
+    int32_t y1 = ((a->y + a->height) > (b->y + b->height)) ? (a->y + a->height) : (b->y + b->height);
+    
+    out->x = (int16_t)x0;
+    out->y = (int16_t)y0;
+    out->width = (int16_t)(x1 - x0);
+    out->height = (int16_t)(y1 - y0);
+}
+
+/**
+ * @brief   κϲ˷
+ * @param   a, b: 
+ * @retval  Ӿвabأ
+ */
+static uint32_t gfx_rect_waste(const gfx_rect_t *a, const gfx_rect_t *b)
+{
+    gfx_rect_t both;
+    int32_t overlap_w;
+    int32_t overlap_h;
+    uint32_t overlap = 0;
+    
+    gfx_rect_union(a, b, &both);
+    overlap_w = (a->width + b->width) - both.width;
+    overlap_h = (a->height + b->height) - both.height;
+    if ((overlap_w > 0) && (overlap_h > 0))
+    {
+        overlap = (uint32_t)overlap_w * (uint32_t)overlap_h;
+    }
+    
+    return gfx_rect_area(&both) - (gfx_rect_area(a) + gfx_rect_area(b) - overlap);
+}
+
+/**
+ * @brief   ʼθ
+ * @note    δ֪ʱӦgfx_dirty_add_all()
+ * @param   dirty: θٽṹָ
+ * @param   width, height: Ļߣأ
+ * @param   pixel_size: ÿֽͳƣ
+ * @retval  
+ */
+void gfx_dirty_init(gfx_dirty_t *dirty, uint16_t width, uint16_t height, uint8_t pixel_size)
+{
+    memset(dirty, 0, sizeof(gfx_dirty_t));
+    dirty->width = width;
+    dirty->height = height;
+    dirty->pixel_size = pixel_size;
+}
+
+/**
+ * @brief   
+ * @param   dirty: θٽṹָ
+ * @param   x, y: ϽǣΪ
+ * @param   width, height: ο
+ * @retval  
+ */
+void gfx_dirty_add(gfx_dirty_t *dirty, int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    gfx_rect_t rect;
+    uint32_t best_waste;
+    uint32_t waste;
+    uint32_t best;
+    uint32_t i;
+    
+    /* üĻ */
+    if (x < 0)
+    {
+        width += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        height += y;
+        y = 0;
+    }
+    if ((width <= 0) || (height <= 0) || (x >= dirty->width) || (y >= dirty->height))
+    {
+        return;
+    }
+    if (width > (dirty->width - x))
+    {
+        width = dirty->width - x;
+    }
+    if (height > (dirty->height - y))
+    {
+        height = dirty->height - y;
+    }
+    
+    rect.x = (int16_t)x;
+    rect.y = (int16_t)y;
+    rect.width = (int16_t)width;
+    rect.height = (int16_t)height;
+    dirty->stats.rects++;
+    
+    /* ˷Сľκϲֱϲпλ */
+    while (1)
+    {
+        best = dirty->count;
+        best_waste = UINT32_MAX;
+        for (i = 0; i < dirty->count; i++)
+        {
+            if (gfx_rect_contains(&dirty->rects[i], &rect) != 0)
+            {
+                return;
+            }
+            
+            waste = gfx_rect_waste(&dirty->rects[i], &rect);
+            if (waste < best_waste)
+            {
+                best_waste = waste;
+                best = i;
+            }
+        }
+        
+        if ((best == dirty->count) || ((best_waste > GFX_DIRTY_MERGE_SLACK) && (dirty->count < GFX_DIRTY_RECT_NUM)))
+        {
+            break;
+        }
+        
+        gfx_rect_union(&dirty->rects[best], &rect, &rect);
+        dirty->count--;
+        dirty->rects[best] = dirty->rects[dirty->count];
+        dirty->stats.merges++;
+    }
+    
+    dirty->rects[dirty->count] = rect;
+    dirty->count++;
+}
+
+/**
+ * @brief   Ϊ
+ * @param   dirty: θٽṹָ
+ * @retval  
+ */
+void gfx_dirty_add_all(gfx_dirty_t *dirty)
+{
+    dirty->count = 0;
+    gfx_dirty_add(dirty, 0, 0, dirty->width, dirty->height);
+}
+
+/**
+ * @brief   ȡ֡
+ * @param   dirty: θٽṹָ
+ * @retval  ֮ͣأ
+ */
+uint32_t gfx_dirty_area(const gfx_dirty_t *dirty)
+{
+    uint32_t area = 0;
+    uint32_t i;
+    
+    for (i = 0; i < dirty->count; i++)
+    {
+        area += gfx_rect_area(&dirty->rects[i]);
+    }
+    
+    return area;
+}
+
+/**
+ * @brief   һ֡ػ
+ * @note    ȰcopyǰƵ󻺳ػrenderеľΣػڵÿأȻҳ
+ *          ʱκξΡҪҳھαһиµ֡
+ * @param   dirty: θٽṹָ
+ * @param   copy: ƾGFX_DIRTY_RECT_NUM
+ * @param   copy_num: ƾ
+ * @param   render: ػGFX_DIRTY_RECT_NUM
+ * @param   render_num: ػ
+ * @retval  ֡˵ֽ
+ */
+uint32_t gfx_dirty_frame(gfx_dirty_t *dirty, gfx_rect_t *copy, uint32_t *copy_num, gfx_rect_t *render, uint32_t *render_num)
+{
+    uint32_t screen = (uint32_t)dirty->width * dirty->height;
+    uint32_t copy_area = 0;
+    uint32_t render_area;
+    uint32_t bytes;
+    uint32_t i;
+    uint32_t j;
+    
+    dirty->stats.frames++;
+    dirty->stats.full_bytes += (uint64_t)screen * dirty->pixel_size;
+    *copy_num = 0;
+    *render_num = 0;
+    
+    if (dirty->count == 0)
+    {
+        dirty->stats.idle_frames++;
+        dirty->stats.last_bytes = 0;
+        return 0;
+    }
+    
+    render_area = gfx_dirty_area(dirty);
+    if ((render_area * 100ULL) >= ((uint64_t)screen * GFX_DIRTY_FULL_PERCENT))
+    {
+        dirty->rects[0].x = 0;
+        dirty->rects[0].y = 0;
+        dirty->rects[0].width = (int16_t)dirty->width;
+        dirty->rects[0].height = (int16_t)dirty->height;
+        dirty->count = 1;
+        render_area = screen;
+    }
+    if (render_area == screen)
+    {
+        dirty->stats.full_frames++;
+    }
+    
+    /* ھδ֡ػȫǵĲҪ */
+    for (i = 0; i < dirty->stale_count; i++)
+    {
+        for (j = 0; j < dirty->count; j++)
+        {
+            if (gfx_rect_contains(&dirty->rects[j], &dirty->stale[i]) != 0)
+            {
+                break;
+            }
+        }
+        
+        if (j == dirty->count)
+        {
+            copy[*copy_num] = dirty->stale[i];
+            (*copy_num)++;
+            copy_area += gfx_rect_area(&dirty->stale[i]);
+        }
+    }
+    
+    memcpy(render, dirty->rects, dirty->count * sizeof(gfx_rect_t));
+    *render_num = dirty->count;
+    memcpy(dirty->stale, dirty->rects, dirty->count * sizeof(gfx_rect_t));
+    dirty->stale_count = dirty->count;
+    dirty->count = 0;
+    
+    bytes = (copy_area * 2 + render_area) * dirty->pixel_size;
+    dirty->stats.last_bytes = bytes;
+    if (bytes > dirty->stats.max_bytes)
+    {
+        dirty->stats.max_bytes = bytes;
+    }
+    dirty->stats.render_bytes += (uint64_t)render_area * dirty->pixel_size;
+    dirty->stats.copy_bytes += (uint64_t)copy_area * 2 * dirty->pixel_size;
+    
+    return bytes;
+}
+
+/**
+ * @brief   ͳ
+ * @param   dirty: θٽṹָ
+ * @retval  
+ */
+void gfx_dirty_reset_stats(gfx_dirty_t *dirty)
+{
+    memset(&dirty->stats, 0, sizeof(gfx_dirty_stats_t));
+}
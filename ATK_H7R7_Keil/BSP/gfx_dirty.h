@@ -0,0 +1,75 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_dirty.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       θٴ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ¼һ֡ҪػľΣʱüĻصܽľκϲ
+ * ﵽGFX_DIRTY_RECT_NUMʱ˷СľκϲĻGFX_DIRTY_FULL_PERCENTʱΪػ
+ * ˫º󻺳ǰһ֡һ֡ػstaleڱ֡ػǰǰƵ󻺳
+ * ѱ֡ػȫǵ򲻸ƣgfx_dirty_frame()֡ĸػβͳư˵ֽ
+ * ļHALϱ루Tools/gfx_simطŽ¼¼
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __GFX_DIRTY_H
+#define __GFX_DIRTY_H
+
+#include <stdint.h>
+
+/* ÿ֡ */
+#define GFX_DIRTY_RECT_NUM          (16)
+
+/* ϲ壨أεӾα֮Ͷֵʱϲÿε */
+#define GFX_DIRTY_MERGE_SLACK       (2048)
+
+/* ػֵ壨ռĻİٷֱȣ */
+#define GFX_DIRTY_FULL_PERCENT      (70)
+
+/* ζ */
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t width;
+    int16_t height;
+} gfx_rect_t;
+
+/* ͳƶ */
+typedef struct {
+    uint32_t frames;        /* ϳɵ֡޸µ֡ */
+    uint32_t idle_frames;   /* ޸µ֡ */
+    uint32_t full_frames;   /* ػ֡ */
+    uint32_t rects;         /* ľüǿգ */
+    uint32_t merges;        /* ϲ */
+    uint32_t last_bytes;    /* һ֡˵ֽ */
+    uint32_t max_bytes;     /* ֵֽ֡ */
+    uint64_t render_bytes;  /* ػдֽ */
+    uint64_t copy_bytes;    /* ǰƵ󻺳ֽдһΣ */
+    uint64_t full_bytes;    /* ÿ֡ػʱдֽԱȻ׼ */
+} gfx_dirty_stats_t;
+
+/* θٶ */
+typedef struct {
+    uint16_t width;                         /* Ļ */
+    uint16_t height;                        /* Ļ߶ */
+    uint8_t pixel_size;                     /* ÿֽ */
+    uint8_t count;                          /* ֡ */
+    uint8_t stale_count;                    /* 󻺳йڵľ */
+    gfx_rect_t rects[GFX_DIRTY_RECT_NUM];   /* ֡ */
+    gfx_rect_t stale[GFX_DIRTY_RECT_NUM];   /* 󻺳йڵľΣһ֡ػľΣ */
+    gfx_dirty_stats_t stats;
+} gfx_dirty_t;
+
+/*  */
+void gfx_dirty_init(gfx_dirty_t *dirty, uint16_t width, uint16_t height, uint8_t pixel_size);  /* ʼθ */
+void gfx_dirty_add(gfx_dirty_t *dirty, int32_t x, int32_t y, int32_t width, int32_t height);   /*  */
+void gfx_dirty_add_all(gfx_dirty_t *dirty);                                                    /* Ϊ */
+uint32_t gfx_dirty_area(const gfx_dirty_t *dirty);                                             /* ȡ֡ */
+uint32_t gfx_dirty_frame(gfx_dirty_t *dirty, gfx_rect_t *copy, uint32_t *copy_num, gfx_rect_t *render, uint32_t *render_num);  /* һ֡ػ */
+void gfx_dirty_reset_stats(gfx_dirty_t *dirty);                                                /* ͳ */
+
+#endif /* __GFX_DIRTY_H */
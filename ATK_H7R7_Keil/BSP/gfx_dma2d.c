@@ -0,0 +1,648 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_dma2d.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       DMA2D 2Dͼٴ
+ ****************************************************************************************************
+ * @attention
+ *
+ * HALֻڳʼжϱ־ÿֱдDMA2DĴHAL_DMA2D_Start_IT()ȺÿζҪ
+ * þʺڴж
+ * R2MͬʽM2MʽתM2M_PFCM2M_BLENDĿ꣩
+ * alphaΪ255ʱǰalphaģʽΪˣA4ɫдFGCOLRL8ǰصɫ壨ѯCLUTɣ
+ * ύʱЧĿD-CacheǰһĿΪԴʱдԴ򲻻ḲDMA2Dд
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfx_dma2d.h"
+#include "mpu_cache.h"
+#include <string.h>
+
+/* Ƕ */
+#define GFX_DMA2D_DONE_NONE         (0)
+#define GFX_DMA2D_DONE_OK           (1)
+#define GFX_DMA2D_DONE_ERROR        (2)
+
+/* Բͼߴ綨 */
+#define GFX_DMA2D_TEST_WIDTH        (64)
+#define GFX_DMA2D_TEST_HEIGHT       (48)
+
+/* DMA2D */
+static DMA2D_HandleTypeDef gfx_dma2d_handle = {0};
+static gfx_op_t gfx_dma2d_queue[GFX_DMA2D_QUEUE_NUM];
+static volatile uint32_t gfx_dma2d_head = 0;        /* ύĲ */
+static volatile uint32_t gfx_dma2d_tail = 0;        /* ѽĲеһΪִеĲ */
+static volatile uint8_t gfx_dma2d_running = 0;      /* DMA2Dִж */
+static volatile uint8_t gfx_dma2d_done = GFX_DMA2D_DONE_NONE;
+static uint32_t gfx_dma2d_start_time = 0;
+static uint32_t gfx_dma2d_cycles_per_us = 1;
+static gfx_dma2d_stats_t gfx_dma2d_stats = {0};
+
+/**
+ * @brief   DMA2Dɻص
+ * @param   hdma2d: DMA2D
+ * @retval  
+ */
+static void gfx_dma2d_xfer_cplt(DMA2D_HandleTypeDef *hdma2d)
+{
+    gfx_dma2d_done = GFX_DMA2D_DONE_OK;
+}
+
+/**
+ * @brief   DMA2Dص
+ * @param   hdma2d: DMA2D
+ * @retval  
+ */
+static void gfx_dma2d_xfer_error(DMA2D_HandleTypeDef *hdma2d)
+{
+    gfx_dma2d_done = GFX_DMA2D_DONE_ERROR;
+}
+
+/**
+ * @brief   ڴ洢ռõĳ
+ * @param   pitch: гȣֽڣ
+ * @param   width: ȣأ
+ * @param   height: ߶ȣأ
+ * @param   format: ظʽ
+ * @retval  صĩصֽ
+ */
+static uint32_t gfx_dma2d_span(uint32_t pitch, uint32_t width, uint32_t height, uint8_t format)
+{
+    return (height - 1) * pitch + (width * gfx_format_bits(format) + 7) / 8;
+}
+
+/**
+ * @brief   еһ
+ * @note    DMA2DжϱλDMA2Dже
+ * @param   
+ * @retval  
+ */
+static void gfx_dma2d_start(void)
+{
+    const gfx_op_t *op = &gfx_dma2d_queue[gfx_dma2d_tail % GFX_DMA2D_QUEUE_NUM];
+    uint32_t mode;
+    uint32_t fg;
+    uint32_t output_offset;
+    uint32_t timeout;
+    
+    gfx_dma2d_running = 1;
+    
+    output_offset = op->dst_pitch / (gfx_format_bits(op->dst_format) / 8) - op->width;
+    DMA2D->OPFCCR = op->dst_format;
+    DMA2D->OMAR = (uint32_t)op->dst;
+    DMA2D->OOR = output_offset;
+    DMA2D->NLR = ((uint32_t)op->width << DMA2D_NLR_PL_Pos) | ((uint32_t)op->height << DMA2D_NLR_NL_Pos);
+    
+    if (op->type == GFX_OP_FILL)
+    {
+        mode = DMA2D_R2M;
+        if (op->dst_format == GFX_FORMAT_RGB565)
+        {
+            DMA2D->OCOLR = GFX_RGB565((op->color >> 16) & 0xFF, (op->color >> 8) & 0xFF, op->color & 0xFF);
+        }
+        else
+        {
+            DMA2D->OCOLR = op->color;
+        }
+    }
+    else
+    {
+        fg = op->src_format;
+        if (op->alpha != 0xFF)
+        {
+            fg |= (DMA2D_COMBINE_ALPHA << DMA2D_FGPFCCR_AM_Pos) | ((uint32_t)op->alpha << DMA2D_FGPFCCR_ALPHA_Pos);
+        }
+        
+        DMA2D->FGMAR = (uint32_t)op->src;
+        DMA2D->FGOR = (op->src_pitch * 8) / gfx_format_bits(op->src_format) - op->width;
+        DMA2D->FGCOLR = op->color & 0x00FFFFFF;
+        
+        /* L8ɫ壨256ARGB8888Լ256 */
+        if (op->src_format == GFX_FORMAT_L8)
+        {
+            DMA2D->FGCMAR = (uint32_t)op->clut;
+            DMA2D->FGPFCCR = fg | (DMA2D_CCM_ARGB8888 << DMA2D_FGPFCCR_CCM_Pos) | (0xFFUL << DMA2D_FGPFCCR_CS_Pos) | DMA2D_FGPFCCR_START;
+            for (timeout = 0x10000; ((DMA2D->FGPFCCR & DMA2D_FGPFCCR_START) != 0) && (timeout != 0); timeout--)
+            {
+            }
+            gfx_dma2d_stats.clut_loads++;
+        }
+        DMA2D->FGPFCCR = fg;
+        
+        if (op->type == GFX_OP_BLEND)
+        {
+            mode = DMA2D_M2M_BLEND;
+            DMA2D->BGMAR = (uint32_t)op->dst;
+            DMA2D->BGOR = output_offset;
+            DMA2D->BGPFCCR = op->dst_format;
+        }
+        else if ((op->src_format == op->dst_format) && (op->alpha == 0xFF))
+        {
+            mode = DMA2D_M2M;
+        }
+        else
+        {
+            mode = DMA2D_M2M_PFC;
+        }
+    }
+    
+    gfx_dma2d_start_time = DWT->CYCCNT;
+    DMA2D->CR = mode | DMA2D_CR_TCIE | DMA2D_CR_TEIE | DMA2D_CR_CEIE | DMA2D_CR_START;
+}
+
+/**
+ * @brief   ʼDMA2D
+ * @note    DMA2DʱжϣնУDWTڼͳƴʱ
+ * @param   
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: ʼʧ
+ */
+uint8_t gfx_dma2d_init(void)
+{
+    HAL_NVIC_DisableIRQ(DMA2D_IRQn);
+    __HAL_RCC_DMA2D_CLK_ENABLE();
+    
+    gfx_dma2d_handle.Instance = DMA2D;
+    gfx_dma2d_handle.Init.Mode = DMA2D_M2M;
+    gfx_dma2d_handle.Init.ColorMode = DMA2D_OUTPUT_RGB565;
+    gfx_dma2d_handle.Init.OutputOffset = 0;
+    gfx_dma2d_handle.Init.AlphaInverted = DMA2D_REGULAR_ALPHA;
+    gfx_dma2d_handle.Init.RedBlueSwap = DMA2D_RB_REGULAR;
+    gfx_dma2d_handle.Init.BytesSwap = DMA2D_BYTES_REGULAR;
+    gfx_dma2d_handle.Init.LineOffsetMode = DMA2D_LOM_PIXELS;
+    gfx_dma2d_handle.XferCpltCallback = gfx_dma2d_xfer_cplt;
+    gfx_dma2d_handle.XferErrorCallback = gfx_dma2d_xfer_error;
+    if (HAL_DMA2D_Init(&gfx_dma2d_handle) != HAL_OK)
+    {
+        gfx_dma2d_handle.Instance = NULL;
+        return 1;
+    }
+    
+    gfx_dma2d_head = 0;
+    gfx_dma2d_tail = 0;
+    gfx_dma2d_running = 0;
+    gfx_dma2d_done = GFX_DMA2D_DONE_NONE;
+    gfx_dma2d_reset_stats();
+    
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->LAR = 0xC5ACCE55;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    gfx_dma2d_cycles_per_us = (SystemCoreClock / 1000000 != 0) ? (SystemCoreClock / 1000000) : 1;
+    
+    HAL_NVIC_SetPriority(DMA2D_IRQn, GFX_DMA2D_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA2D_IRQn);
+    
+    return 0;
+}
+
+/**
+ * @brief   ύͼ
+ * @note    ʱȴGFX_DMA2D_TIMEOUT msݱƣغop
+ * @param   op: ṹָ루gfx_op_xxx()ɣ
+ * @retval  ύ
+ * @arg     0: ύɹ
+ * @arg     1: δʼֻ֧ʱ
+ */
+uint8_t gfx_dma2d_submit(const gfx_op_t *op)
+{
+    uint32_t tickstart = HAL_GetTick();
+    uint32_t bytes = gfx_format_bits(op->dst_format) / 8;
+    uint32_t depth;
+    
+    if ((gfx_dma2d_handle.Instance == NULL) || (bytes == 0) || ((op->dst_pitch % bytes) != 0) || (op->width == 0) ||
+        (op->height == 0) || (op->width > (DMA2D_NLR_PL_Msk >> DMA2D_NLR_PL_Pos)) ||
+        ((op->src != NULL) && (((op->src_pitch * 8) % gfx_format_bits(op->src_format)) != 0)))
+    {
+        return 1;
+    }
+    
+    while ((gfx_dma2d_head - gfx_dma2d_tail) >= GFX_DMA2D_QUEUE_NUM)
+    {
+        if ((HAL_GetTick() - tickstart) > GFX_DMA2D_TIMEOUT)
+        {
+            return 1;
+        }
+    }
+    
+    /* DMA2DȡдأддزЧ */
+    if (op->src != NULL)
+    {
+        mpu_cache_clean(op->src, gfx_dma2d_span(op->src_pitch, op->width, op->height, op->src_format));
+    }
+    if ((op->src_format == GFX_FORMAT_L8) && (op->clut != NULL))
+    {
+        mpu_cache_clean(op->clut, 256 * sizeof(uint32_t));
+    }
+    mpu_cache_clean_invalidate(op->dst, gfx_dma2d_span(op->dst_pitch, op->width, op->height, op->dst_format));
+    
+    gfx_dma2d_queue[gfx_dma2d_head % GFX_DMA2D_QUEUE_NUM] = *op;
+    
+    HAL_NVIC_DisableIRQ(DMA2D_IRQn);
+    gfx_dma2d_head++;
+    gfx_dma2d_stats.submitted++;
+    depth = gfx_dma2d_head - gfx_dma2d_tail;
+    if (depth > gfx_dma2d_stats.queue_max)
+    {
+        gfx_dma2d_stats.queue_max = depth;
+    }
+    if (gfx_dma2d_running == 0)
+    {
+        gfx_dma2d_start();
+    }
+    HAL_NVIC_EnableIRQ(DMA2D_IRQn);
+    
+    return 0;
+}
+
+/**
+ * @brief   
+ * @param   dst: Ŀ
+ * @param   x, y: Ͻ
+ * @param   width, height: ο
+ * @param   color: ɫARGB8888
+ * @retval  0: ύɹüΪ; 1: ύʧ
+ */
+uint8_t gfx_dma2d_fill(const gfx_surface_t *dst, int32_t x, int32_t y, int32_t width, int32_t height, uint32_t color)
+{
+    gfx_op_t op;
+    uint8_t res = gfx_op_fill(&op, dst, x, y, width, height, color);
+    
+    if (res != 0)
+    {
+        return (res == 2) ? 0 : 1;
+    }
+    
+    return gfx_dma2d_submit(&op);
+}
+
+/**
+ * @brief   ƾΣʽͬʱת
+ * @param   dst: Ŀ
+ * @param   x, y: ĿϽ
+ * @param   src: Դ
+ * @param   sx, sy: ԴϽ
+ * @param   width, height: 
+ * @retval  0: ύɹüΪ; 1: ύʧ
+ */
+uint8_t gfx_dma2d_copy(const gfx_surface_t *dst, int32_t x, int32_t y, const gfx_surface_t *src, int32_t sx, int32_t sy, int32_t width, int32_t height)
+{
+    gfx_op_t op;
+    uint8_t res = gfx_op_copy(&op, dst, x, y, src, sx, sy, width, height);
+    
+    if (res != 0)
+    {
+        return (res == 2) ? 0 : 1;
+    }
+    
+    return gfx_dma2d_submit(&op);
+}
+
+/**
+ * @brief   Ͼ
+ * @param   dst: Ŀ
+ * @param   x, y: ĿϽ
+ * @param   src: Դ
+ * @param   sx, sy: ԴϽ
+ * @param   width, height: 
+ * @param   alpha: Դalpha255ı䣩
+ * @retval  0: ύɹüΪ; 1: ύʧ
+ */
+uint8_t gfx_dma2d_blend(const gfx_surface_t *dst, int32_t x, int32_t y, const gfx_surface_t *src, int32_t sx, int32_t sy, int32_t width, int32_t height, uint8_t alpha)
+{
+    gfx_op_t op;
+    uint8_t res = gfx_op_blend(&op, dst, x, y, src, sx, sy, width, height, alpha);
+    
+    if (res != 0)
+    {
+        return (res == 2) ? 0 : 1;
+    }
+    
+    return gfx_dma2d_submit(&op);
+}
+
+/**
+ * @brief   ѯǷδɵĲ
+ * @param   
+ * @retval  0: ; 1: æ
+ */
+uint8_t gfx_dma2d_busy(void)
+{
+    return gfx_dma2d_running;
+}
+
+/**
+ * @brief   ȴв
+ * @param   timeout: ʱʱ䣨ms
+ * @retval  ȴ
+ * @arg     0: ȫ
+ * @arg     1: ʱ
+ */
+uint8_t gfx_dma2d_wait(uint32_t timeout)
+{
+    uint32_t tickstart = HAL_GetTick();
+    
+    while (gfx_dma2d_running != 0)
+    {
+        if ((HAL_GetTick() - tickstart) > timeout)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡDMA2Dͳ
+ * @param   stats: ͳƽṹָ
+ * @retval  
+ */
+void gfx_dma2d_get_stats(gfx_dma2d_stats_t *stats)
+{
+    uint32_t enabled = NVIC_GetEnableIRQ(DMA2D_IRQn);
+    
+    HAL_NVIC_DisableIRQ(DMA2D_IRQn);
+    *stats = gfx_dma2d_stats;
+    if (enabled != 0)
+    {
+        HAL_NVIC_EnableIRQ(DMA2D_IRQn);
+    }
+}
+
+/**
+ * @brief   DMA2Dͳ
+ * @param   
+ * @retval  
+ */
+void gfx_dma2d_reset_stats(void)
+{
+    uint32_t enabled = NVIC_GetEnableIRQ(DMA2D_IRQn);
+    
+    HAL_NVIC_DisableIRQ(DMA2D_IRQn);
+    memset(&gfx_dma2d_stats, 0, sizeof(gfx_dma2d_stats));
+    if (enabled != 0)
+    {
+        HAL_NVIC_EnableIRQ(DMA2D_IRQn);
+    }
+}
+
+/**
+ * @brief   Ƚ
+ * @param   a: aڵַ
+ * @param   b: bڵַ
+ * @param   format: ظʽ
+ * @retval  ɫRGB5655/6λƣ
+ */
+static uint32_t gfx_dma2d_test_diff(const uint8_t *a, const uint8_t *b, uint8_t format)
+{
+    static const uint8_t rgb565_shift[3] = {0, 5, 11};
+    static const uint8_t rgb565_mask[3] = {0x1F, 0x3F, 0x1F};
+    uint32_t pa;
+    uint32_t pb;
+    uint32_t ca;
+    uint32_t cb;
+    uint32_t diff = 0;
+    uint32_t i;
+    
+    if (format == GFX_FORMAT_RGB565)
+    {
+        pa = *(const uint16_t *)a;
+        pb = *(const uint16_t *)b;
+    }
+    else
+    {
+        pa = *(const uint32_t *)a;
+        pb = *(const uint32_t *)b;
+    }
+    
+    for (i = 0; i < ((format == GFX_FORMAT_RGB565) ? 3U : 4U); i++)
+    {
+        if (format == GFX_FORMAT_RGB565)
+        {
+            ca = (pa >> rgb565_shift[i]) & rgb565_mask[i];
+            cb = (pb >> rgb565_shift[i]) & rgb565_mask[i];
+        }
+        else
+        {
+            ca = (pa >> (i * 8)) & 0xFF;
+            cb = (pb >> (i * 8)) & 0xFF;
+        }
+        
+        ca = (ca > cb) ? (ca - cb) : (cb - ca);
+        if (ca > diff)
+        {
+            diff = ca;
+        }
+    }
+    
+    return diff;
+}
+
+/**
+ * @brief   DMA2DCPUοʵֱȶ
+ * @note    ڹԴͼ񣬶ÿֱֲDMA2Dgfx_soft_execute()ͬĿͼ
+ *          رȽͼ񣨰أۼߵִʱ䣻gfx_dma2d_init()֮DMA2Dʱ
+ * @param   work: 32ֽڶ룬DMA2Dɷʣ
+ * @param   size: ССGFX_DMA2D_TEST_SIZE
+ * @param   result: ȶԽ
+ * @retval  ȶԽ
+ * @arg     0: ȫһ£ݲڣ
+ * @arg     1: DMA2DʱڳݲĲ
+ */
+uint8_t gfx_dma2d_test(void *work, uint32_t size, gfx_dma2d_test_t *result)
+{
+    static const uint8_t cases[][4] = {
+        /* , Դʽ, Ŀʽ, alpha */
+        {GFX_OP_FILL, GFX_FORMAT_RGB565, GFX_FORMAT_RGB565, 0xFF},
+        {GFX_OP_FILL, GFX_FORMAT_ARGB8888, GFX_FORMAT_ARGB8888, 0xFF},
+        {GFX_OP_COPY, GFX_FORMAT_RGB565, GFX_FORMAT_RGB565, 0xFF},
+        {GFX_OP_COPY, GFX_FORMAT_ARGB8888, GFX_FORMAT_RGB565, 0xFF},
+        {GFX_OP_COPY, GFX_FORMAT_RGB565, GFX_FORMAT_ARGB8888, 0xFF},
+        {GFX_OP_COPY, GFX_FORMAT_L8, GFX_FORMAT_RGB565, 0xFF},
+        {GFX_OP_COPY, GFX_FORMAT_A4, GFX_FORMAT_ARGB8888, 0xFF},
+        {GFX_OP_BLEND, GFX_FORMAT_ARGB8888, GFX_FORMAT_RGB565, 0xFF},
+        {GFX_OP_BLEND, GFX_FORMAT_ARGB8888, GFX_FORMAT_ARGB8888, 0x80},
+        {GFX_OP_BLEND, GFX_FORMAT_L8, GFX_FORMAT_RGB565, 0xC8},
+        {GFX_OP_BLEND, GFX_FORMAT_A4, GFX_FORMAT_RGB565, 0xFF},
+    };
+    static const uint8_t formats[4] = {GFX_FORMAT_ARGB8888, GFX_FORMAT_RGB565, GFX_FORMAT_L8, GFX_FORMAT_A4};
+    gfx_surface_t src[4];
+    gfx_surface_t hw;
+    gfx_surface_t sw;
+    const gfx_surface_t *source;
+    gfx_op_t op_hw;
+    gfx_op_t op_sw;
+    uint8_t *base = (uint8_t *)work;
+    uint32_t *clut;
+    uint32_t seed = 0x12345678;
+    uint32_t offset;
+    uint32_t bytes;
+    uint32_t start;
+    uint32_t diff;
+    uint32_t max_diff;
+    uint32_t index;
+    uint32_t i;
+    uint8_t res;
+    
+    memset(result, 0, sizeof(gfx_dma2d_test_t));
+    if ((work == NULL) || (size < GFX_DMA2D_TEST_SIZE) || (((uint32_t)work & 31) != 0) || (gfx_dma2d_wait(GFX_DMA2D_TIMEOUT) != 0))
+    {
+        return 1;
+    }
+    
+    /* ԴͼARGB8888RGB565L8A4ɫ壬 */
+    offset = 0;
+    memset(src, 0, sizeof(src));
+    for (index = 0; index < 4; index++)
+    {
+        src[index].data = base + offset;
+        src[index].format = formats[index];
+        src[index].width = GFX_DMA2D_TEST_WIDTH;
+        src[index].height = GFX_DMA2D_TEST_HEIGHT;
+        src[index].pitch = GFX_DMA2D_TEST_WIDTH * gfx_format_bits(formats[index]) / 8;
+        src[index].color = 0xC0FF8020;
+        offset += src[index].pitch * GFX_DMA2D_TEST_HEIGHT;
+    }
+    clut = (uint32_t *)(base + offset);
+    offset += 256 * sizeof(uint32_t);
+    src[2].clut = clut;
+    for (i = 0; i < offset; i++)
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        base[i] = (uint8_t)(seed >> 16);
+    }
+    
+    /* ĿͼDMA2DCPUһ */
+    memset(&hw, 0, sizeof(hw));
+    hw.data = base + offset;
+    hw.width = GFX_DMA2D_TEST_WIDTH;
+    hw.height = GFX_DMA2D_TEST_HEIGHT;
+    sw = hw;
+    sw.data = base + offset + GFX_DMA2D_TEST_WIDTH * GFX_DMA2D_TEST_HEIGHT * 4;
+    
+    for (index = 0; index < (sizeof(cases) / sizeof(cases[0])); index++)
+    {
+        hw.format = cases[index][2];
+        hw.pitch = GFX_DMA2D_TEST_WIDTH * gfx_format_bits(cases[index][2]) / 8;
+        sw.format = hw.format;
+        sw.pitch = hw.pitch;
+        bytes = hw.pitch * GFX_DMA2D_TEST_HEIGHT;
+        for (i = 0; i < bytes; i++)
+        {
+            seed = seed * 1103515245UL + 12345UL;
+            ((uint8_t *)hw.data)[i] = (uint8_t)(seed >> 16);
+        }
+        memcpy(sw.data, hw.data, bytes);
+        
+        source = &src[0];
+        for (i = 0; i < 4; i++)
+        {
+            if (src[i].format == cases[index][1])
+            {
+                source = &src[i];
+            }
+        }
+        
+        if (cases[index][0] == GFX_OP_FILL)
+        {
+            res = gfx_op_fill(&op_hw, &hw, 3, 2, 50, 40, 0x80C04020);
+            res |= gfx_op_fill(&op_sw, &sw, 3, 2, 50, 40, 0x80C04020);
+        }
+        else if (cases[index][0] == GFX_OP_COPY)
+        {
+            res = gfx_op_copy(&op_hw, &hw, 3, 2, source, 4, 5, 50, 40);
+            res |= gfx_op_copy(&op_sw, &sw, 3, 2, source, 4, 5, 50, 40);
+        }
+        else
+        {
+            res = gfx_op_blend(&op_hw, &hw, 3, 2, source, 4, 5, 50, 40, cases[index][3]);
+            res |= gfx_op_blend(&op_sw, &sw, 3, 2, source, 4, 5, 50, 40, cases[index][3]);
+        }
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        start = DWT->CYCCNT;
+        gfx_soft_execute(&op_sw);
+        result->soft_us += (DWT->CYCCNT - start) / gfx_dma2d_cycles_per_us;
+        
+        start = DWT->CYCCNT;
+        if ((gfx_dma2d_submit(&op_hw) != 0) || (gfx_dma2d_wait(GFX_DMA2D_TIMEOUT) != 0))
+        {
+            return 1;
+        }
+        result->dma2d_us += (DWT->CYCCNT - start) / gfx_dma2d_cycles_per_us;
+        
+        /* Ƚͼ񣬾Ҳܱд */
+        max_diff = 0;
+        for (i = 0; i < bytes; i += gfx_format_bits(hw.format) / 8)
+        {
+            diff = gfx_dma2d_test_diff((const uint8_t *)hw.data + i, (const uint8_t *)sw.data + i, hw.format);
+            if (diff > max_diff)
+            {
+                max_diff = diff;
+            }
+        }
+        if (max_diff > ((cases[index][0] == GFX_OP_BLEND) ? 1U : 0U))
+        {
+            result->mismatches++;
+        }
+        if (max_diff > result->max_diff)
+        {
+            result->max_diff = max_diff;
+        }
+        result->ops++;
+    }
+    
+    return (result->mismatches == 0) ? 0 : 1;
+}
+
+/**
+ * @brief   DMA2DжϴDMA2D_IRQHandler()еã
+ * @note    ǰɻеһ
+ * @param   
+ * @retval  
+ */
+void gfx_dma2d_irq_handler(void)
+{
+    const gfx_op_t *op;
+    uint8_t done;
+    
+    HAL_DMA2D_IRQHandler(&gfx_dma2d_handle);
+    
+    done = gfx_dma2d_done;
+    if ((done == GFX_DMA2D_DONE_NONE) || (gfx_dma2d_running == 0))
+    {
+        return;
+    }
+    gfx_dma2d_done = GFX_DMA2D_DONE_NONE;
+    
+    op = &gfx_dma2d_queue[gfx_dma2d_tail % GFX_DMA2D_QUEUE_NUM];
+    gfx_dma2d_stats.busy_us += (DWT->CYCCNT - gfx_dma2d_start_time) / gfx_dma2d_cycles_per_us;
+    if (done == GFX_DMA2D_DONE_OK)
+    {
+        gfx_dma2d_stats.completed++;
+        gfx_dma2d_stats.pixels += (uint32_t)op->width * op->height;
+    }
+    else
+    {
+        gfx_dma2d_stats.errors++;
+    }
+    
+    gfx_dma2d_tail++;
+    if (gfx_dma2d_head != gfx_dma2d_tail)
+    {
+        gfx_dma2d_start();
+    }
+    else
+    {
+        gfx_dma2d_running = 0;
+    }
+}
@@ -0,0 +1,70 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_dma2d.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       DMA2D 2Dͼٴ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ͼgfx_soft.hеgfx_op_tкأDMA2Dжһ
+ * 䡢ơʽת֮䲻ҪCPUȴgfx_dma2d_wait()ȴִ
+ * ύʱдԴɫD-CacheдزЧĿD-CacheǰCPUӦĿ
+ * ԴĿɫλDMA2DɷʵĴ洢AXI SRAMⲿ洢DTCM/ITCM
+ * ؼgfx_soft.hgfx_dma2d_test()ĿϰDMA2Dgfx_soft_execute()رȶԲʱ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __GFX_DMA2D_H
+#define __GFX_DMA2D_H
+
+#include "main.h"
+#include "gfx_soft.h"
+
+/* DMA2Dгȶ */
+#define GFX_DMA2D_QUEUE_NUM         (16)
+
+/* DMA2Dжȼ */
+#define GFX_DMA2D_IRQ_PRIORITY      (5)
+
+/* ʱȴʱʱ䶨壨ms */
+#define GFX_DMA2D_TIMEOUT           (100)
+
+/* Բ⹤С */
+#define GFX_DMA2D_TEST_SIZE         (0x0000C000UL)
+
+/* DMA2Dͳƶ */
+typedef struct {
+    uint32_t submitted;     /* ύĲ */
+    uint32_t completed;     /* ɵĲ */
+    uint32_t errors;        /* ôĲ */
+    uint32_t clut_loads;    /* ɫش */
+    uint32_t queue_max;     /*  */
+    uint64_t pixels;        /* ɵ */
+    uint64_t busy_us;       /* DMA2Dʱ䣨us */
+} gfx_dma2d_stats_t;
+
+/* DMA2DԲ */
+typedef struct {
+    uint32_t ops;           /* ȶԵĲ */
+    uint32_t mismatches;    /* ݲĲ븴ݲΪ0Ϊ1 */
+    uint32_t max_diff;      /* ɫ */
+    uint32_t dma2d_us;      /* DMA2Dִʱ䣨ύus */
+    uint32_t soft_us;       /* CPUִʱ䣨us */
+} gfx_dma2d_test_t;
+
+/*  */
+uint8_t gfx_dma2d_init(void);                                                       /* ʼDMA2D */
+uint8_t gfx_dma2d_submit(const gfx_op_t *op);                                       /* ύͼ */
+uint8_t gfx_dma2d_fill(const gfx_surface_t *dst, int32_t x, int32_t y, int32_t width, int32_t height, uint32_t color);    /*  */
+uint8_t gfx_dma2d_copy(const gfx_surface_t *dst, int32_t x, int32_t y, const gfx_surface_t *src, int32_t sx, int32_t sy, int32_t width, int32_t height);  /* ƾΣʽͬʱת */
+uint8_t gfx_dma2d_blend(const gfx_surface_t *dst, int32_t x, int32_t y, const gfx_surface_t *src, int32_t sx, int32_t sy, int32_t width, int32_t height, uint8_t alpha);   /* Ͼ */
+uint8_t gfx_dma2d_busy(void);                                                       /* ѯǷδɵĲ */
+uint8_t gfx_dma2d_wait(uint32_t timeout);                                           /* ȴв */
+void gfx_dma2d_get_stats(gfx_dma2d_stats_t *stats);                                 /* ȡDMA2Dͳ */
+void gfx_dma2d_reset_stats(void);                                                   /* DMA2Dͳ */
+uint8_t gfx_dma2d_test(void *work, uint32_t size, gfx_dma2d_test_t *result);        /* DMA2DCPUοʵֱȶ */
+void gfx_dma2d_irq_handler(void);                                                   /* DMA2Dжϴ */
+
+#endif /* __GFX_DMA2D_H */
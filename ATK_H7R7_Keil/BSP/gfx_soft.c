@@ -0,0 +1,553 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_soft.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       2Dͼ봿Cοʵִ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ϹʽDMA2Dһ£fΪԴbΪĿ꣬aΪalphacΪɫ
+ *     a_mult = f_a * b_a / 255
+ *     a_out  = f_a + b_a - a_mult
+ *     c_out  = (f_c * f_a + b_c * b_a - b_c * a_mult) / a_out
+ * 룻DMA2Dڲ뷽ʽδϽӲ1䡢ʽתλһ
+ * gfx_soft_pixel()ؼ㣬Ϊ׼gfx_soft_execute()Գ߰еĿ·ؼͬ
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfx_soft.h"
+#include <string.h>
+
+/**
+ * @brief   ȡÿλ
+ * @param   format: ظʽ
+ * @retval  λ0ʾ֧֣
+ */
+uint32_t gfx_format_bits(uint8_t format)
+{
+    switch (format)
+    {
+        case GFX_FORMAT_ARGB8888:
+        {
+            return 32;
+        }
+        case GFX_FORMAT_RGB565:
+        {
+            return 16;
+        }
+        case GFX_FORMAT_L8:
+        {
+            return 8;
+        }
+        case GFX_FORMAT_A4:
+        {
+            return 4;
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief   8λ˲255룩
+ * @param   a: 
+ * @param   b: 
+ * @retval  round(a * b / 255)
+ */
+static uint32_t gfx_mul(uint32_t a, uint32_t b)
+{
+    uint32_t t = a * b + 128;
+    
+    return (t + (t >> 8)) >> 8;
+}
+
+/**
+ * @brief   RGB565չΪARGB8888Ƹλ
+ * @param   pixel: RGB565
+ * @retval  ARGB8888
+ */
+uint32_t gfx_soft_from_rgb565(uint32_t pixel)
+{
+    uint32_t r = (pixel >> 11) & 0x1F;
+    uint32_t g = (pixel >> 5) & 0x3F;
+    uint32_t b = pixel & 0x1F;
+    
+    return GFX_ARGB(0xFF, (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
+
+/**
+ * @brief   ARGB8888ѹΪRGB565ضϣ
+ * @param   pixel: ARGB8888
+ * @retval  RGB565
+ */
+uint16_t gfx_soft_to_rgb565(uint32_t pixel)
+{
+    return GFX_RGB565((pixel >> 16) & 0xFF, (pixel >> 8) & 0xFF, pixel & 0xFF);
+}
+
+/**
+ * @brief   жǷΪΪĿĸʽ
+ * @param   format: ظʽ
+ * @retval  1: ; 0: 
+ */
+static uint8_t gfx_dst_format(uint8_t format)
+{
+    return (format == GFX_FORMAT_ARGB8888) || (format == GFX_FORMAT_RGB565);
+}
+
+/**
+ * @brief   ͼ
+ * @param   surface: ͼ
+ * @retval  0: Ч; 1: Ч
+ */
+static uint8_t gfx_surface_check(const gfx_surface_t *surface)
+{
+    uint32_t bits = gfx_format_bits(surface->format);
+    
+    if ((surface->data == NULL) || (bits == 0) || (surface->pitch < ((surface->width * bits + 7) / 8)))
+    {
+        return 1;
+    }
+    
+    if ((surface->format == GFX_FORMAT_L8) && (surface->clut == NULL))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ѾβüĿ꣨ԴΧ
+ * @param   dst: Ŀ
+ * @param   src: Դ棨NULLʾԴ
+ * @param   x, y: Ŀ꣨ü£
+ * @param   sx, sy: Դ꣨ü£
+ * @param   width, height: ߣü£
+ * @retval  0: ; 1: üΪ
+ */
+static uint8_t gfx_clip(const gfx_surface_t *dst, const gfx_surface_t *src, int32_t *x, int32_t *y, int32_t *sx, int32_t *sy,
+                        int32_t *width, int32_t *height)
+{
+    if (*x < 0)
+    {
+        *sx -= *x;
+        *width += *x;
+        *x = 0;
+    }
+    if (*y < 0)
+    {
+        *sy -= *y;
+        *height += *y;
+        *y = 0;
+    }
+    if ((*x + *width) > dst->width)
+    {
+        *width = dst->width - *x;
+    }
+    if ((*y + *height) > dst->height)
+    {
+        *height = dst->height - *y;
+    }
+    
+    if (src != NULL)
+    {
+        if (*sx < 0)
+        {
+            *x -= *sx;
+            *width += *sx;
+            *sx = 0;
+        }
+        if (*sy < 0)
+        {
+            *y -= *sy;
+            *height += *sy;
+            *sy = 0;
+        }
+        if ((*sx + *width) > src->width)
+        {
+            *width = src->width - *sx;
+        }
+        if ((*sy + *height) > src->height)
+        {
+            *height = src->height - *sy;
+        }
+    }
+    
+    return ((*width <= 0) || (*height <= 0)) ? 1 : 0;
+}
+
+/**
+ * @brief   
+ * @param   op: ṹָ
+ * @param   dst: Ŀ棨ARGB8888RGB565
+ * @param   x, y: Ͻ
+ * @param   width, height: ο
+ * @param   color: ɫARGB8888ĿΪRGB565ʱalpha
+ * @retval  ɽ
+ * @arg     0: ɳɹ
+ * @arg     1: 
+ * @arg     2: üΪ
+ */
+uint8_t gfx_op_fill(gfx_op_t *op, const gfx_surface_t *dst, int32_t x, int32_t y, int32_t width, int32_t height, uint32_t color)
+{
+    int32_t sx = 0;
+    int32_t sy = 0;
+    uint32_t bits = gfx_format_bits(dst->format);
+    
+    if ((gfx_dst_format(dst->format) == 0) || (gfx_surface_check(dst) != 0))
+    {
+        return 1;
+    }
+    if (gfx_clip(dst, NULL, &x, &y, &sx, &sy, &width, &height) != 0)
+    {
+        return 2;
+    }
+    
+    memset(op, 0, sizeof(gfx_op_t));
+    op->type = GFX_OP_FILL;
+    op->src_format = dst->format;
+    op->dst_format = dst->format;
+    op->alpha = 0xFF;
+    op->width = (uint16_t)width;
+    op->height = (uint16_t)height;
+    op->dst = (uint8_t *)dst->data + y * dst->pitch + x * (bits / 8);
+    op->dst_pitch = dst->pitch;
+    op->color = color;
+    
+    return 0;
+}
+
+/**
+ * @brief   ɸƻϲ
+ * @param   op: ṹָ
+ * @param   type: 
+ * @param   dst: Ŀ棨ARGB8888RGB565
+ * @param   x, y: ĿϽ
+ * @param   src: Դ
+ * @param   sx, sy: ԴϽ
+ * @param   width, height: 
+ * @param   alpha: Դalpha
+ * @retval  0: ɳɹ; 1: ; 2: üΪ
+ */
+static uint8_t gfx_op_source(gfx_op_t *op, uint8_t type, const gfx_surface_t *dst, int32_t x, int32_t y, const gfx_surface_t *src,
+                             int32_t sx, int32_t sy, int32_t width, int32_t height, uint8_t alpha)
+{
+    uint32_t dst_bits = gfx_format_bits(dst->format);
+    uint32_t src_bits = gfx_format_bits(src->format);
+    
+    if ((gfx_dst_format(dst->format) == 0) || (gfx_surface_check(dst) != 0) || (gfx_surface_check(src) != 0))
+    {
+        return 1;
+    }
+    if (gfx_clip(dst, src, &x, &y, &sx, &sy, &width, &height) != 0)
+    {
+        return 2;
+    }
+    
+    /* A4Դֽڱ߽翪ʼÿΪżDMA2D 4λʽҪ */
+    if ((src->format == GFX_FORMAT_A4) && (((sx & 1) != 0) || ((width & 1) != 0)))
+    {
+        return 1;
+    }
+    
+    memset(op, 0, sizeof(gfx_op_t));
+    op->type = type;
+    op->src_format = src->format;
+    op->dst_format = dst->format;
+    op->alpha = alpha;
+    op->width = (uint16_t)width;
+    op->height = (uint16_t)height;
+    op->src = (const uint8_t *)src->data + sy * src->pitch + (sx * src_bits) / 8;
+    op->src_pitch = src->pitch;
+    op->dst = (uint8_t *)dst->data + y * dst->pitch + x * (dst_bits / 8);
+    op->dst_pitch = dst->pitch;
+    op->clut = src->clut;
+    
+    /* A4ɫalphaϲalpha */
+    if (src->format == GFX_FORMAT_A4)
+    {
+        op->color = src->color | 0xFF000000;
+        op->alpha = (uint8_t)gfx_mul(alpha, src->color >> 24);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ɸƲ
+ * @note    ԴĿʽͬʱתʽԴalpha㣨ĿΪARGB8888ʱԭд룩
+ * @param   op: ṹָ
+ * @param   dst: Ŀ棨ARGB8888RGB565
+ * @param   x, y: ĿϽ
+ * @param   src: Դ棨A4ԴsxΪż
+ * @param   sx, sy: ԴϽ
+ * @param   width, height: 
+ * @retval  ɽ
+ * @arg     0: ɳɹ
+ * @arg     1: 
+ * @arg     2: üΪ
+ */
+uint8_t gfx_op_copy(gfx_op_t *op, const gfx_surface_t *dst, int32_t x, int32_t y, const gfx_surface_t *src, int32_t sx, int32_t sy, int32_t width, int32_t height)
+{
+    return gfx_op_source(op, GFX_OP_COPY, dst, x, y, src, sx, sy, width, height, 0xFF);
+}
+
+/**
+ * @brief   ɻϲ
+ * @note    ԴalphaȳalphaٰDMA2DʽĿϺдĿ
+ * @param   op: ṹָ
+ * @param   dst: Ŀ棨ARGB8888RGB565
+ * @param   x, y: ĿϽ
+ * @param   src: Դ棨A4ԴsxΪż
+ * @param   sx, sy: ԴϽ
+ * @param   width, height: 
+ * @param   alpha: Դalpha255ı䣩
+ * @retval  ɽ
+ * @arg     0: ɳɹ
+ * @arg     1: 
+ * @arg     2: üΪ
+ */
+uint8_t gfx_op_blend(gfx_op_t *op, const gfx_surface_t *dst, int32_t x, int32_t y, const gfx_surface_t *src, int32_t sx, int32_t sy, int32_t width, int32_t height, uint8_t alpha)
+{
+    return gfx_op_source(op, GFX_OP_BLEND, dst, x, y, src, sx, sy, width, height, alpha);
+}
+
+/**
+ * @brief   ȡԴزalpha
+ * @param   op: ṹָ
+ * @param   x, y: 
+ * @retval  ARGB8888
+ */
+static uint32_t gfx_read_src(const gfx_op_t *op, uint32_t x, uint32_t y)
+{
+    const uint8_t *line = op->src + y * op->src_pitch;
+    uint32_t pixel;
+    uint32_t alpha;
+    
+    switch (op->src_format)
+    {
+        case GFX_FORMAT_ARGB8888:
+        {
+            pixel = ((const uint32_t *)line)[x];
+            break;
+        }
+        case GFX_FORMAT_RGB565:
+        {
+            pixel = gfx_soft_from_rgb565(((const uint16_t *)line)[x]);
+            break;
+        }
+        case GFX_FORMAT_L8:
+        {
+            pixel = op->clut[line[x]];
+            break;
+        }
+        default:
+        {
+            /* A44λΪż */
+            alpha = (line[x >> 1] >> ((x & 1) * 4)) & 0x0F;
+            pixel = (op->color & 0x00FFFFFF) | ((alpha * 17) << 24);
+            break;
+        }
+    }
+    
+    alpha = gfx_mul(pixel >> 24, op->alpha);
+    
+    return (pixel & 0x00FFFFFF) | (alpha << 24);
+}
+
+/**
+ * @brief   ȡĿ
+ * @param   op: ṹָ
+ * @param   x, y: 
+ * @retval  ARGB8888
+ */
+static uint32_t gfx_read_dst(const gfx_op_t *op, uint32_t x, uint32_t y)
+{
+    const uint8_t *line = op->dst + y * op->dst_pitch;
+    
+    if (op->dst_format == GFX_FORMAT_RGB565)
+    {
+        return gfx_soft_from_rgb565(((const uint16_t *)line)[x]);
+    }
+    
+    return ((const uint32_t *)line)[x];
+}
+
+/**
+ * @brief   DMA2Dʽ
+ * @param   fg: ǰԴ
+ * @param   bg: Ŀ꣩
+ * @retval  ϽARGB8888
+ */
+uint32_t gfx_soft_blend(uint32_t fg, uint32_t bg)
+{
+    uint32_t fa = fg >> 24;
+    uint32_t ba = bg >> 24;
+    uint32_t mult;
+    uint32_t out;
+    uint32_t result;
+    uint32_t shift;
+    uint32_t fc;
+    uint32_t bc;
+    
+    if (fa == 0xFF)
+    {
+        return fg;
+    }
+    if (fa == 0)
+    {
+        return bg;
+    }
+    
+    mult = gfx_mul(fa, ba);
+    out = fa + ba - mult;
+    result = out << 24;
+    for (shift = 0; shift < 24; shift += 8)
+    {
+        fc = (fg >> shift) & 0xFF;
+        bc = (bg >> shift) & 0xFF;
+        result |= ((fc * fa + bc * (ba - mult) + out / 2) / out) << shift;
+    }
+    
+    return result;
+}
+
+/**
+ * @brief   һ
+ * @param   op: ṹָ
+ * @param   x, y: 
+ * @retval  дĿǰARGB8888أĿΪRGB565ʱٽضϣ
+ */
+uint32_t gfx_soft_pixel(const gfx_op_t *op, uint32_t x, uint32_t y)
+{
+    switch (op->type)
+    {
+        case GFX_OP_FILL:
+        {
+            return op->color;
+        }
+        case GFX_OP_COPY:
+        {
+            return gfx_read_src(op, x, y);
+        }
+        default:
+        {
+            return gfx_soft_blend(gfx_read_src(op, x, y), gfx_read_dst(op, x, y));
+        }
+    }
+}
+
+/**
+ * @brief   дһأؼ㣩
+ * @param   op: ṹָ
+ * @param   y: к
+ * @retval  
+ */
+static void gfx_soft_line(const gfx_op_t *op, uint32_t y)
+{
+    uint8_t *line = op->dst + y * op->dst_pitch;
+    uint32_t pixel;
+    uint32_t x;
+    
+    for (x = 0; x < op->width; x++)
+    {
+        pixel = gfx_soft_pixel(op, x, y);
+        if (op->dst_format == GFX_FORMAT_RGB565)
+        {
+            ((uint16_t *)line)[x] = gfx_soft_to_rgb565(pixel);
+        }
+        else
+        {
+            ((uint32_t *)line)[x] = pixel;
+        }
+    }
+}
+
+/**
+ * @brief   CPUִлͼ
+ * @param   op: ṹָ루gfx_op_xxx()ɣ
+ * @retval  
+ */
+void gfx_soft_execute(const gfx_op_t *op)
+{
+    const uint16_t *src16;
+    const uint32_t *src32;
+    uint16_t *dst16;
+    uint32_t *dst32;
+    uint32_t pixel;
+    uint32_t x;
+    uint32_t y;
+    
+    for (y = 0; y < op->height; y++)
+    {
+        dst16 = (uint16_t *)(op->dst + y * op->dst_pitch);
+        dst32 = (uint32_t *)dst16;
+        src16 = (op->src != NULL) ? (const uint16_t *)(op->src + y * op->src_pitch) : NULL;
+        src32 = (const uint32_t *)src16;
+        
+        if (op->type == GFX_OP_FILL)
+        {
+            if (op->dst_format == GFX_FORMAT_RGB565)
+            {
+                pixel = gfx_soft_to_rgb565(op->color);
+                for (x = 0; x < op->width; x++)
+                {
+                    dst16[x] = (uint16_t)pixel;
+                }
+            }
+            else
+            {
+                for (x = 0; x < op->width; x++)
+                {
+                    dst32[x] = op->color;
+                }
+            }
+        }
+        else if ((op->type == GFX_OP_COPY) && (op->src_format == op->dst_format) && (op->alpha == 0xFF))
+        {
+            memcpy(dst16, src16, op->width * (gfx_format_bits(op->dst_format) / 8));
+        }
+        else if ((op->type == GFX_OP_COPY) && (op->src_format == GFX_FORMAT_RGB565))
+        {
+            /* RGB565 -> ARGB8888 */
+            for (x = 0; x < op->width; x++)
+            {
+                dst32[x] = gfx_soft_from_rgb565(src16[x]);
+            }
+        }
+        else if ((op->type == GFX_OP_COPY) && (op->src_format == GFX_FORMAT_ARGB8888) && (op->alpha == 0xFF))
+        {
+            /* ARGB8888 -> RGB565 */
+            for (x = 0; x < op->width; x++)
+            {
+                dst16[x] = gfx_soft_to_rgb565(src32[x]);
+            }
+        }
+        else if ((op->type == GFX_OP_BLEND) && (op->src_format == GFX_FORMAT_ARGB8888) && (op->dst_format == GFX_FORMAT_RGB565))
+        {
+            /* ARGB8888ϵRGB565ȫ͸ */
+            for (x = 0; x < op->width; x++)
+            {
+                pixel = src32[x];
+                if ((pixel >> 24) == 0)
+                {
+                    continue;
+                }
+                if (op->alpha != 0xFF)
+                {
+                    pixel = (pixel & 0x00FFFFFF) | (gfx_mul(pixel >> 24, op->alpha) << 24);
+                }
+                dst16[x] = gfx_soft_to_rgb565(gfx_soft_blend(pixel, gfx_soft_from_rgb565(dst16[x])));
+            }
+        }
+        else
+        {
+            gfx_soft_line(op, y);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_soft.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       2Dͼ봿Cοʵִ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ͼ䡢/ʽתalphaϣgfx_op_xxx()ügfx_op_t
+ * ٽDMA2Dgfx_dma2d.hgfx_soft_execute()ִУ߰ͬһع
+ * 5/6λɫչΪ8λʱƸλ8λѹΪ5/6λʱضϣA44λalphaչΪa * 17
+ * alphaΪround(a * b / 255)ϰDMA2Dʽgfx_soft.c
+ * ļHALϱ루Tools/gfx_simرȶٶȶԱ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __GFX_SOFT_H
+#define __GFX_SOFT_H
+
+#include <stdint.h>
+
+/* ظʽ壨ֵDMA2Dɫģʽһ£ */
+#define GFX_FORMAT_ARGB8888         (0U)
+#define GFX_FORMAT_RGB565           (2U)
+#define GFX_FORMAT_L8               (5U)        /* 8λɫΪ256ARGB8888ֻΪԴ */
+#define GFX_FORMAT_A4               (10U)       /* 4λalphaɫȡsurfacecolorֻΪԴ */
+
+/* ͼͶ */
+#define GFX_OP_FILL                 (0U)        /* ɫ */
+#define GFX_OP_COPY                 (1U)        /* ƾΣʽͬʱת */
+#define GFX_OP_BLEND                (2U)        /* ԴalphaϵĿ */
+
+/* ɫת궨 */
+#define GFX_ARGB(a, r, g, b)        (((uint32_t)(a) << 24) | ((uint32_t)(r) << 16) | ((uint32_t)(g) << 8) | (uint32_t)(b))
+#define GFX_RGB565(r, g, b)         ((uint16_t)((((r) & 0xF8U) << 8) | (((g) & 0xFCU) << 3) | ((b) >> 3)))
+
+/* ͼ涨 */
+typedef struct {
+    void *data;             /* صַ */
+    uint32_t pitch;         /* гȣֽڣ */
+    uint16_t width;         /* ȣأ */
+    uint16_t height;        /* ߶ȣأ */
+    uint8_t format;         /* ظʽ */
+    const uint32_t *clut;   /* L8ɫ */
+    uint32_t color;         /* A4ɫARGB8888alphaalphaˣ */
+} gfx_surface_t;
+
+/* ͼ */
+typedef struct {
+    uint8_t type;           /*  */
+    uint8_t src_format;     /* Դظʽ */
+    uint8_t dst_format;     /* Ŀظʽ */
+    uint8_t alpha;          /* Դalpha255ı䣩 */
+    uint16_t width;         /* ȣأ */
+    uint16_t height;        /* ߶ȣأ */
+    const uint8_t *src;     /* Դصַ */
+    uint8_t *dst;           /* Ŀصַ */
+    uint32_t src_pitch;     /* Դгȣֽڣ */
+    uint32_t dst_pitch;     /* Ŀгȣֽڣ */
+    uint32_t color;         /* ɫA4ɫARGB8888 */
+    const uint32_t *clut;   /* L8ɫ */
+} gfx_op_t;
+
+/*  */
+uint32_t gfx_format_bits(uint8_t format);                                           /* ȡÿλ */
+uint8_t gfx_op_fill(gfx_op_t *op, const gfx_surface_t *dst, int32_t x, int32_t y, int32_t width, int32_t height, uint32_t color);  /*  */
+uint8_t gfx_op_copy(gfx_op_t *op, const gfx_surface_t *dst, int32_t x, int32_t y, const gfx_surface_t *src, int32_t sx, int32_t sy, int32_t width, int32_t height);    /* ɸƲ */
+uint8_t gfx_op_blend(gfx_op_t *op, const gfx_surface_t *dst, int32_t x, int32_t y, const gfx_surface_t *src, int32_t sx, int32_t sy, int32_t width, int32_t height, uint8_t alpha);  /* ɻϲ */
+uint32_t gfx_soft_from_rgb565(uint32_t pixel);                                      /* RGB565չΪARGB8888 */
+uint16_t gfx_soft_to_rgb565(uint32_t pixel);                                        /* ARGB8888ѹΪRGB565 */
+uint32_t gfx_soft_blend(uint32_t fg, uint32_t bg);                                  /* DMA2Dʽ */
+uint32_t gfx_soft_pixel(const gfx_op_t *op, uint32_t x, uint32_t y);                /* һأARGB8888 */
+void gfx_soft_execute(const gfx_op_t *op);                                          /* CPUִлͼ */
+
+#endif /* __GFX_SOFT_H */
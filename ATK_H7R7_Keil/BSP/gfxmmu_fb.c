@@ -0,0 +1,203 @@
+/**
+ ****************************************************************************************************
+ * @file        gfxmmu_fb.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       GFXMMU֡
+ ****************************************************************************************************
+ * @attention
+ *
+ * нУ0ǰͬһŲұGFXMMU⻺ѡ׵ַBxCR
+ * HAL_GFXMMU_Init()ұʼʱдȫ1024У״н
+ * Ҫ12ֽڿ飨HAL_GFXMMU_ConfigPacking()飩MSBƳģʽ
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfxmmu_fb.h"
+#include "ltdc_fb.h"
+#include <string.h>
+
+/* GFXMMU */
+static GFXMMU_HandleTypeDef gfxmmu_fb_handle = {0};
+
+/* ڴԤ */
+static gfxmmu_fb_budget_t gfxmmu_fb_budget = {0};
+
+/**
+ * @brief   ȡLTDCظʽÿֽ
+ * @param   format: LTDCظʽ
+ * @retval  ÿֽ0ʾ֧֣
+ */
+static uint8_t gfxmmu_fb_pixel_size(uint32_t format)
+{
+    switch (format)
+    {
+        case LTDC_PIXEL_FORMAT_ARGB8888:
+        {
+            return 4;
+        }
+        case LTDC_PIXEL_FORMAT_RGB565:
+        case LTDC_PIXEL_FORMAT_ARGB1555:
+        case LTDC_PIXEL_FORMAT_ARGB4444:
+        case LTDC_PIXEL_FORMAT_AL88:
+        {
+            return 2;
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief   дұ
+ * @param   cfg: ʾ״
+ * @retval  0: ɹ; 1: ʧ
+ */
+static uint8_t gfxmmu_fb_load_lut(const gfxmmu_lut_config_t *cfg)
+{
+    uint32_t lut[2 * GFXMMU_FB_LUT_LINES];
+    uint32_t line;
+    uint32_t count;
+    
+    for (line = 0; line < GFXMMU_LUT_LINE_NUM; line += count)
+    {
+        count = GFXMMU_LUT_LINE_NUM - line;
+        if (count > GFXMMU_FB_LUT_LINES)
+        {
+            count = GFXMMU_FB_LUT_LINES;
+        }
+        
+        if ((gfxmmu_lut_build(cfg, line, count, lut) != 0) ||
+            (HAL_GFXMMU_ConfigLut(&gfxmmu_fb_handle, line, count, (uint32_t)lut) != HAL_OK))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ʼGFXMMU֡
+ * @note    ltdc_fb_init()ãMX_LTDC_Init()֮󣩣ߴظʽȡԲ1Ĵã
+ *          GFXMMUltdc_fb_init_ex()ʹ⻺01֮ltdc_fbgfx_compose÷
+ *          ʱ1ΪARGB8888alpha棬ΪGFXMMU_FB_DEFAULT_ALPHA
+ * @param   radius: Բǰ뾶أ0ΪΣСڿһʱΪԲ
+ * @param   packing: 0: ; 1: ARGB8888Ϊ24bpp
+ * @param   base: ׵ַ16ֽڶ룩
+ * @param   size: ССLTDC_FB_NUMҪ2ݣ800x480 ARGB8888Ҫ2304000ֽڣLTDC_FB_RAM_SIZE
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: Խ8MB߽硢HALLTDCδʼ
+ */
+uint8_t gfxmmu_fb_init(uint16_t radius, uint8_t packing, uint32_t base, uint32_t size)
+{
+    const LTDC_LayerCfgTypeDef *layer = &hltdc.LayerCfg[0];
+    GFXMMU_PackingTypeDef pack;
+    gfxmmu_lut_config_t cfg;
+    uint32_t buffer_size;
+    uint32_t start;
+    uint8_t index;
+    
+    memset(&gfxmmu_fb_budget, 0, sizeof(gfxmmu_fb_budget));
+    if (hltdc.State == HAL_LTDC_STATE_RESET)
+    {
+        return 1;
+    }
+    
+    cfg.width = (uint16_t)(layer->WindowX1 - layer->WindowX0);
+    cfg.height = (uint16_t)(layer->WindowY1 - layer->WindowY0);
+    cfg.pixel_size = gfxmmu_fb_pixel_size(layer->PixelFormat);
+    cfg.packing = (packing != 0) ? 1 : 0;
+    cfg.radius = radius;
+    buffer_size = gfxmmu_lut_size(&cfg);
+    if ((buffer_size == 0) || ((base % GFXMMU_LUT_PHYSICAL_ALIGN) != 0) || ((size / LTDC_FB_NUM) < buffer_size))
+    {
+        return 1;
+    }
+    
+    /* ÿܿԽ8MB߽ */
+    for (index = 0; index < LTDC_FB_NUM; index++)
+    {
+        start = base + index * buffer_size;
+        if ((start / GFXMMU_LUT_WINDOW_SIZE) != ((start + buffer_size - 1) / GFXMMU_LUT_WINDOW_SIZE))
+        {
+            return 1;
+        }
+    }
+    
+    __HAL_RCC_GFXMMU_CLK_ENABLE();
+    
+    gfxmmu_fb_handle.Instance = GFXMMU;
+    gfxmmu_fb_handle.Init.BlockSize = (cfg.packing != 0) ? GFXMMU_12BYTE_BLOCKS : GFXMMU_16BYTE_BLOCKS;
+    gfxmmu_fb_handle.Init.DefaultValue = GFXMMU_FB_DEFAULT_VALUE;
+    gfxmmu_fb_handle.Init.AddressTranslation = ENABLE;
+    gfxmmu_fb_handle.Init.Buffers.Buf0Address = base;
+    gfxmmu_fb_handle.Init.Buffers.Buf1Address = base + buffer_size;
+    gfxmmu_fb_handle.Init.Buffers.Buf2Address = base;                 /* ʹ */
+    gfxmmu_fb_handle.Init.Buffers.Buf3Address = base;
+    gfxmmu_fb_handle.Init.Interrupts.Activation = DISABLE;
+    gfxmmu_fb_handle.Init.Interrupts.UsedInterrupts = 0;
+    if (HAL_GFXMMU_Init(&gfxmmu_fb_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    if (gfxmmu_fb_load_lut(&cfg) != 0)
+    {
+        return 1;
+    }
+    
+    if (cfg.packing != 0)
+    {
+        pack.Buffer0Activation = ENABLE;
+        pack.Buffer0Mode = GFXMMU_PACKING_MSB_REMOVE;
+        pack.Buffer1Activation = ENABLE;
+        pack.Buffer1Mode = GFXMMU_PACKING_MSB_REMOVE;
+        pack.Buffer2Activation = DISABLE;
+        pack.Buffer2Mode = GFXMMU_PACKING_MSB_REMOVE;
+        pack.Buffer3Activation = DISABLE;
+        pack.Buffer3Mode = GFXMMU_PACKING_MSB_REMOVE;
+        pack.DefaultAlpha = GFXMMU_FB_DEFAULT_ALPHA;
+        if (HAL_GFXMMU_ConfigPacking(&gfxmmu_fb_handle, &pack) != HAL_OK)
+        {
+            return 1;
+        }
+    }
+    
+    gfxmmu_fb_budget.buffer_size = buffer_size;
+    gfxmmu_fb_budget.linear_size = (uint32_t)cfg.width * cfg.height * cfg.pixel_size;
+    gfxmmu_fb_budget.total_size = buffer_size * LTDC_FB_NUM;
+    gfxmmu_fb_budget.saved_percent = 100 - (uint32_t)(((uint64_t)buffer_size * 100 + gfxmmu_fb_budget.linear_size - 1) / gfxmmu_fb_budget.linear_size);
+    
+    return ltdc_fb_init_ex(GFXMMU_FB_VIRTUAL_BASE, GFXMMU_FB_VIRTUAL_SIZE, GFXMMU_FB_VIRTUAL_STRIDE, GFXMMU_LUT_VIRTUAL_PITCH);
+}
+
+/**
+ * @brief   ȡڴԤ
+ * @param   budget: ڴԤṹָ루δʼʱȫΪ0
+ * @retval  
+ */
+void gfxmmu_fb_get_budget(gfxmmu_fb_budget_t *budget)
+{
+    *budget = gfxmmu_fb_budget;
+}
+
+/**
+ * @brief   ȡGFXMMU־
+ * @note    ʹGFXMMUжϣֱӶ״̬Ĵʾұӳ䳬8MBڣ
+ *          豸ʾGFXMMU洢ʱAXIߴ
+ * @param   
+ * @retval  ־GFXMMU_ERROR_BUFFERx_OVERFLOWGFXMMU_ERROR_BUS_MASTERϣ0ʾ޴
+ */
+uint32_t gfxmmu_fb_get_error(void)
+{
+    uint32_t flags = GFXMMU->SR & (GFXMMU_SR_B0OF | GFXMMU_SR_B1OF | GFXMMU_SR_B2OF | GFXMMU_SR_B3OF | GFXMMU_SR_AMEF);
+    
+    GFXMMU->FCR = flags;
+    
+    return flags;
+}
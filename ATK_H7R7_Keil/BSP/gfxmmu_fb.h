@@ -0,0 +1,63 @@
+/**
+ ****************************************************************************************************
+ * @file        gfxmmu_fb.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       GFXMMU֡
+ ****************************************************************************************************
+ * @attention
+ *
+ * GFXMMULTDC_FB_NUM֡ӳΪ⻺010x250000000x25400000ÿ4096ֽڣ
+ * ڴֻÿеĿɼ飺ǾԲΡԲǣֻӳɼأARGB8888ɴΪ24bpp
+ * gfxmmu_fb_init()ltdc_fb_init()GFXMMUltdc_fb_init_ex()ʹ⻺LTDCDMA2DCPUͼַ
+ * ͼ밴ltdc_fb_get_pitch()4096ѰַҪ޸ģд벻ɼĿ鱻ԣΪ0
+ *
+ * ڴԤ㣨ÿֽTools/gfx_simmake budget㲢У飩:
+ *   800x480  RGB565         768000벻GFXMMUͬÿ1600ֽ100飬Բr=40Ҳֻʡ0.2%
+ *   800x480  ARGB8888      15360001152000-25%
+ *   480x480  RGB565   Բ      369600-19.8%ARGB8888549504-40.4%
+ *   240x240  RGB565   Բ       94080-18.3%
+ * AXI SRAM֡LTDC_FB_BASELTDC_FB_RAM_SIZE = 203776ֽڣ240x240λ230400Ų£
+ * 240x240Բλ188160ŵ£main.cLCD_USE_GFXMMUΪ1ʱʹøôڣ
+ * 800x480ĻⲿPSRAMУGFXMMUʡPSRAMLTDCɨ800x480 ARGB888860Hzɨ92MB/s69MB/s
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __GFXMMU_FB_H
+#define __GFXMMU_FB_H
+
+#include "main.h"
+#include "gfxmmu_lut.h"
+
+/* ֡壨⻺01ͬʱΪltdc_fbMPU */
+#define GFXMMU_FB_VIRTUAL_BASE      GFXMMU_VIRTUAL_BUFFER0_BASE
+#define GFXMMU_FB_VIRTUAL_STRIDE    (GFXMMU_VIRTUAL_BUFFER1_BASE - GFXMMU_VIRTUAL_BUFFER0_BASE)
+#define GFXMMU_FB_VIRTUAL_SIZE      (0x00800000UL)
+
+/* δӳֵʱalpha */
+#define GFXMMU_FB_DEFAULT_VALUE     (0x00000000UL)
+#define GFXMMU_FB_DEFAULT_ALPHA     (0xFFU)
+
+/* ĬĲ1ڶ壨RGB565ԲΣLTDC_FB_BASEϷڴԤ㣩 */
+#define GFXMMU_FB_WIDTH             (240)
+#define GFXMMU_FB_HEIGHT            (240)
+#define GFXMMU_FB_RADIUS            (120)
+
+/* ÿдұ壨ջϵʱΪ2 * GFXMMU_FB_LUT_LINES֣ */
+#define GFXMMU_FB_LUT_LINES         (32U)
+
+/* ڴԤ㶨 */
+typedef struct {
+    uint32_t buffer_size;   /* ÿֽ */
+    uint32_t linear_size;   /* GFXMMUʱÿֽ */
+    uint32_t total_size;    /* ȫֽ */
+    uint32_t saved_percent; /* ԲGFXMMUʡİٷֱ */
+} gfxmmu_fb_budget_t;
+
+/*  */
+uint8_t gfxmmu_fb_init(uint16_t radius, uint8_t packing, uint32_t base, uint32_t size);    /* ʼGFXMMU֡ */
+void gfxmmu_fb_get_budget(gfxmmu_fb_budget_t *budget);                              /* ȡڴԤ */
+uint32_t gfxmmu_fb_get_error(void);                                                 /* ȡGFXMMU־ */
+
+#endif /* __GFXMMU_FB_H */
@@ -0,0 +1,293 @@
+/**
+ ****************************************************************************************************
+ * @file        gfxmmu_lut.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       GFXMMUвұַתģʹ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ɼ䰴ظǱؼ㣺״κصضɼݱԵҲд
+ * ƫ = ֮ǰÿ - еһɼ飬ַ = ׵ַ + (ƫ + ) * ֽ
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfxmmu_lut.h"
+
+/**
+ * @brief   ȡ
+ * @param   value: 
+ * @retval  ƽ
+ */
+static uint32_t gfxmmu_lut_sqrt_ceil(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    uint32_t rest = value;
+    
+    while (bit > rest)
+    {
+        bit >>= 2;
+    }
+    
+    while (bit != 0)
+    {
+        if (rest >= (root + bit))
+        {
+            rest -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    
+    return ((root * root) < value) ? (root + 1) : root;
+}
+
+/**
+ * @brief   ȡһеĿɼ
+ * @param   cfg: ʾ״
+ * @param   line: к
+ * @param   first: һɼ
+ * @param   last: һɼ
+ * @retval  ɼ0ʾвɼ
+ */
+static uint32_t gfxmmu_lut_blocks(const gfxmmu_lut_config_t *cfg, uint32_t line, uint32_t *first, uint32_t *last)
+{
+    uint32_t x0;
+    uint32_t x1;
+    
+    gfxmmu_lut_span(cfg, line, &x0, &x1);
+    if (x1 <= x0)
+    {
+        *first = 0;
+        *last = 0;
+        return 0;
+    }
+    
+    *first = x0 * cfg->pixel_size / GFXMMU_LUT_VIRTUAL_BLOCK;
+    *last = (x1 * cfg->pixel_size - 1) / GFXMMU_LUT_VIRTUAL_BLOCK;
+    
+    return *last - *first + 1;
+}
+
+/**
+ * @brief   ״
+ * @param   cfg: ʾ״
+ * @retval  0: ȷ; 1: 
+ */
+uint8_t gfxmmu_lut_check(const gfxmmu_lut_config_t *cfg)
+{
+    if ((cfg->pixel_size != 2) && (cfg->pixel_size != 4))
+    {
+        return 1;
+    }
+    
+    if ((cfg->packing != 0) && (cfg->pixel_size != 4))
+    {
+        return 1;
+    }
+    
+    if ((cfg->width == 0) || ((uint32_t)cfg->width * cfg->pixel_size > GFXMMU_LUT_VIRTUAL_PITCH) ||
+        (cfg->height == 0) || (cfg->height > GFXMMU_LUT_LINE_NUM))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡһеĿɼ
+ * @note    Բǰ뾶Ϊ߽Сֵһ룬ԲصɼΪ[x0, x1)ʱx0 = x1 = 0
+ * @param   cfg: ʾ״
+ * @param   line: к
+ * @param   x0: һɼ
+ * @param   x1: һɼ + 1
+ * @retval  
+ */
+void gfxmmu_lut_span(const gfxmmu_lut_config_t *cfg, uint32_t line, uint32_t *x0, uint32_t *x1)
+{
+    uint32_t radius = cfg->radius;
+    uint32_t row;
+    uint32_t dy;
+    uint32_t dx;
+    
+    *x0 = 0;
+    *x1 = 0;
+    if (line >= cfg->height)
+    {
+        return;
+    }
+    *x1 = cfg->width;
+    
+    if (radius > cfg->width / 2)
+    {
+        radius = cfg->width / 2;
+    }
+    if (radius > cfg->height / 2)
+    {
+        radius = cfg->height / 2;
+    }
+    
+    /* ·ԲϷԳ */
+    row = (line >= (cfg->height - radius)) ? (cfg->height - 1 - line) : line;
+    if (row >= radius)
+    {
+        return;
+    }
+    
+    /* Բĵһرߵľ룬ñԲĽɼ */
+    dy = radius - row - 1;
+    dx = gfxmmu_lut_sqrt_ceil(radius * radius - dy * dy);
+    *x0 = radius - dx;
+    *x1 = cfg->width - *x0;
+}
+
+/**
+ * @brief   ȡֽ
+ * @param   cfg: ʾ״
+ * @retval  1216
+ */
+uint32_t gfxmmu_lut_block_size(const gfxmmu_lut_config_t *cfg)
+{
+    return (cfg->packing != 0) ? 12 : 16;
+}
+
+/**
+ * @brief   ȡС
+ * @param   cfg: ʾ״
+ * @retval  һֽGFXMMU_LUT_PHYSICAL_ALIGN룬ʱΪ0
+ */
+uint32_t gfxmmu_lut_size(const gfxmmu_lut_config_t *cfg)
+{
+    uint32_t blocks = 0;
+    uint32_t first;
+    uint32_t last;
+    uint32_t line;
+    
+    if (gfxmmu_lut_check(cfg) != 0)
+    {
+        return 0;
+    }
+    
+    for (line = 0; line < cfg->height; line++)
+    {
+        blocks += gfxmmu_lut_blocks(cfg, line, &first, &last);
+    }
+    
+    return (blocks * gfxmmu_lut_block_size(cfg) + GFXMMU_LUT_PHYSICAL_ALIGN - 1) & ~(GFXMMU_LUT_PHYSICAL_ALIGN - 1);
+}
+
+/**
+ * @brief   ɲұ
+ * @note    ÿ֣LUTxL, LUTxHHAL_GFXMMU_ConfigLut()ıʽͬɷֶɣ
+ *          ״Уheight֮У
+ * @param   cfg: ʾ״
+ * @param   first_line: һ
+ * @param   count: 
+ * @param   lut: ұ2 * count֣
+ * @retval  0: ɹ; 1: ƫƳΧ
+ */
+uint8_t gfxmmu_lut_build(const gfxmmu_lut_config_t *cfg, uint32_t first_line, uint32_t count, uint32_t *lut)
+{
+    uint32_t used = 0;
+    uint32_t blocks;
+    uint32_t first;
+    uint32_t last;
+    uint32_t line;
+    int32_t offset;
+    
+    if ((gfxmmu_lut_check(cfg) != 0) || ((first_line + count) > GFXMMU_LUT_LINE_NUM))
+    {
+        return 1;
+    }
+    
+    /* ֮ǰõ */
+    for (line = 0; line < first_line; line++)
+    {
+        used += gfxmmu_lut_blocks(cfg, line, &first, &last);
+    }
+    
+    for (line = first_line; line < (first_line + count); line++)
+    {
+        blocks = gfxmmu_lut_blocks(cfg, line, &first, &last);
+        if (blocks == 0)
+        {
+            lut[0] = 0;
+            lut[1] = 0;
+        }
+        else
+        {
+            offset = (int32_t)used - (int32_t)first;
+            if ((offset < GFXMMU_LUT_LO_MIN) || (offset > GFXMMU_LUT_LO_MAX))
+            {
+                return 1;
+            }
+            
+            lut[0] = GFXMMU_LUT_EN | (first << GFXMMU_LUT_FVB_POS) | (last << GFXMMU_LUT_LVB_POS);
+            lut[1] = (uint32_t)offset & GFXMMU_LUT_LO_MASK;
+            used += blocks;
+        }
+        lut += 2;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ƫתΪƫ
+ * @note    GFXMMUĹģһֽڷʣУұ
+ * @param   lut: ұ2 * GFXMMU_LUT_LINE_NUM֣
+ * @param   packing: 1: ģʽ12ֽ飬ȥÿصalphaֽڣ
+ * @param   offset: ⻺ڵֽƫ
+ * @param   physical: ڵֽƫƣGFXMMU_LUT_MAPPEDʱЧ
+ * @retval  ת
+ * @arg     GFXMMU_LUT_MAPPED: ӳ䵽ֽ
+ * @arg     GFXMMU_LUT_UNMAPPED: нû鲻ɼ
+ * @arg     GFXMMU_LUT_PACKED: ʱȥalphaֽ
+ */
+uint8_t gfxmmu_lut_translate(const uint32_t *lut, uint8_t packing, uint32_t offset, uint32_t *physical)
+{
+    uint32_t line = offset / GFXMMU_LUT_VIRTUAL_PITCH;
+    uint32_t block = (offset % GFXMMU_LUT_VIRTUAL_PITCH) / GFXMMU_LUT_VIRTUAL_BLOCK;
+    uint32_t byte = offset % GFXMMU_LUT_VIRTUAL_BLOCK;
+    uint32_t first;
+    uint32_t last;
+    
+    if (line >= GFXMMU_LUT_LINE_NUM)
+    {
+        return GFXMMU_LUT_UNMAPPED;
+    }
+    lut += 2 * line;
+    
+    first = (lut[0] >> GFXMMU_LUT_FVB_POS) & 0xFF;
+    last = (lut[0] >> GFXMMU_LUT_LVB_POS) & 0xFF;
+    if (((lut[0] & GFXMMU_LUT_EN) == 0) || (block < first) || (block > last))
+    {
+        return GFXMMU_LUT_UNMAPPED;
+    }
+    
+    /* ƫΪ18λӺ2^18ȡģƫԲţ */
+    block = (lut[1] + block) & GFXMMU_LUT_LO_MASK;
+    
+    if (packing != 0)
+    {
+        if ((byte % 4) == 3)
+        {
+            return GFXMMU_LUT_PACKED;
+        }
+        
+        *physical = block * 12 + (byte / 4) * 3 + (byte % 4);
+    }
+    else
+    {
+        *physical = block * 16 + byte;
+    }
+    
+    return GFXMMU_LUT_MAPPED;
+}
@@ -0,0 +1,67 @@
+/**
+ ****************************************************************************************************
+ * @file        gfxmmu_lut.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       GFXMMUвұַתģʹ
+ ****************************************************************************************************
+ * @attention
+ *
+ * GFXMMU⻺ÿ4096ֽڣ25616ֽ飩1024Уұÿиһ/һɼƫƣ
+ * ֻпɼռڴ棬еĿɼνУɼĬֵDVRд
+ * ļʾ״ΡԲǾΡԲΣÿеĿɼӲʽĲұLUTxL/LUTxH
+ * СͬĹģַַתTools/gfx_simУ
+ * ģʽΪ12ֽڣÿ16ֽ飨4ARGB8888أȥalphaֽںΪ12ֽڣMSBƳ
+ * صalphaΪĬalphaDARڴLTDC25%
+ * ļHALϱ
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __GFXMMU_LUT_H
+#define __GFXMMU_LUT_H
+
+#include <stdint.h>
+
+/* ⻺ */
+#define GFXMMU_LUT_LINE_NUM         (1024U)                     /*  */
+#define GFXMMU_LUT_BLOCK_NUM        (256U)                      /* ÿ */
+#define GFXMMU_LUT_VIRTUAL_BLOCK    (16U)                       /* ֽ */
+#define GFXMMU_LUT_VIRTUAL_PITCH    (GFXMMU_LUT_BLOCK_NUM * GFXMMU_LUT_VIRTUAL_BLOCK)      /* гȣֽڣ */
+#define GFXMMU_LUT_VIRTUAL_SIZE     (GFXMMU_LUT_LINE_NUM * GFXMMU_LUT_VIRTUAL_PITCH)       /* ⻺С4MB */
+
+/* 壨ܿԽ8MB߽磬16ֽڶ룩 */
+#define GFXMMU_LUT_WINDOW_SIZE      (0x00800000UL)
+#define GFXMMU_LUT_PHYSICAL_ALIGN   (16U)
+
+/* ұֶζ壨GFXMMU_LUTxL/GFXMMU_LUTxHĴͬ */
+#define GFXMMU_LUT_EN               (1UL << 0)                  /* ʹ */
+#define GFXMMU_LUT_FVB_POS          (8U)                        /* һɼ */
+#define GFXMMU_LUT_LVB_POS          (16U)                       /* һɼ */
+#define GFXMMU_LUT_LO_MASK          (0x3FFFFUL)                 /* ƫƣ飬18λֵԲţ */
+#define GFXMMU_LUT_LO_MIN           (-255)
+#define GFXMMU_LUT_LO_MAX           (261888)
+
+/* ַת */
+#define GFXMMU_LUT_MAPPED           (0U)        /* ӳ䵽ֽ */
+#define GFXMMU_LUT_UNMAPPED         (1U)        /* нû鲻ɼDVR */
+#define GFXMMU_LUT_PACKED           (2U)        /* ʱȥalphaֽڣDAR */
+
+/* ʾ״ */
+typedef struct {
+    uint16_t width;         /* ȣأ */
+    uint16_t height;        /* ߶ȣУGFXMMU_LUT_LINE_NUM */
+    uint8_t pixel_size;     /* ÿֽ24 */
+    uint8_t packing;        /* 1: Ϊ24bpppixel_sizeΪ4 */
+    uint16_t radius;        /* Բǰ뾶أ0ΪΣСڿһʱΪԲΣܵΣ */
+} gfxmmu_lut_config_t;
+
+/*  */
+uint8_t gfxmmu_lut_check(const gfxmmu_lut_config_t *cfg);                                      /* ״ */
+void gfxmmu_lut_span(const gfxmmu_lut_config_t *cfg, uint32_t line, uint32_t *x0, uint32_t *x1); /* ȡһеĿɼ */
+uint32_t gfxmmu_lut_block_size(const gfxmmu_lut_config_t *cfg);                                /* ȡֽ */
+uint32_t gfxmmu_lut_size(const gfxmmu_lut_config_t *cfg);                                      /* ȡС */
+uint8_t gfxmmu_lut_build(const gfxmmu_lut_config_t *cfg, uint32_t first_line, uint32_t count, uint32_t *lut);    /* ɲұ */
+uint8_t gfxmmu_lut_translate(const uint32_t *lut, uint8_t packing, uint32_t offset, uint32_t *physical);   /* ƫתΪƫ */
+
+#endif /* __GFXMMU_LUT_H */
@@ -0,0 +1,556 @@
+/**
+ ****************************************************************************************************
+ * @file        ltdc_fb.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       LTDC˫֡
+ ****************************************************************************************************
+ * @attention
+ *
+ * ҳֻд1ӰӼĴֱأжϣHAL_LTDC_ReloadEventCallbackнǰ󻺳
+ * жλΪЧʾһ֮AccumulatedActiveH + 1HALжйرжϣÿ֡ڻصʹ
+ * HAL_LTDC_SetAddress_NoReload()HAL_LTDC_Reload()ҳʱLTDCжϣжзѼľ
+ * ֡ηҳ֮ˢ´ͳƣҳDWTڼԼ7һΣڵļ׼ȷ
+ *
+ ****************************************************************************************************
+ */
+
+#include "ltdc_fb.h"
+#include "mpu_cache.h"
+#include <string.h>
+
+/* LTDC֡ */
+static uint8_t *ltdc_fb_buffer[LTDC_FB_NUM] = {NULL};
+static volatile uint8_t ltdc_fb_front = 0;          /* ʾĻ */
+static volatile uint8_t ltdc_fb_pending = 0;        /* ҳȴֱ */
+static uint32_t ltdc_fb_width = 0;
+static uint32_t ltdc_fb_height = 0;
+static uint32_t ltdc_fb_pitch = 0;
+static uint32_t ltdc_fb_line = 0;                   /* жλ */
+static uint32_t ltdc_fb_cycles_per_us = 1;
+static ltdc_fb_callback_t ltdc_fb_callback = NULL;
+static void *ltdc_fb_callback_arg = NULL;
+
+/* LTDC֡ʱͳ */
+static struct {
+    volatile uint32_t refreshes;    /* ˢ´ */
+    volatile uint32_t flips;        /* ɵķҳ */
+    volatile uint32_t dropped;      /* ظʾ֡ */
+    uint32_t refresh_time;          /* ϴжʱ䣨ڣ */
+    uint32_t refresh_intervals;     /* ˢ¼ */
+    uint64_t refresh_sum;           /* ˢ¼ͣus */
+    uint32_t flip_time;             /* ϴηҳʱ䣨ڣ */
+    uint32_t flip_refresh;          /* ϴηҳʱˢ´ */
+    uint32_t frame_intervals;       /* ҳ */
+    uint32_t frame_min;             /* ҳСֵus */
+    uint32_t frame_max;             /* ҳֵus */
+    uint64_t frame_sum;             /* ҳͣus */
+    uint64_t frame_square_sum;      /* ҳƽͣus^2 */
+} ltdc_fb_timing = {0};
+
+/**
+ * @brief   ȡظʽÿֽ
+ * @param   format: LTDCظʽ
+ * @retval  ÿֽ0ʾ֧֣
+ */
+static uint32_t ltdc_fb_pixel_size(uint32_t format)
+{
+    switch (format)
+    {
+        case LTDC_PIXEL_FORMAT_ARGB8888:
+        {
+            return 4;
+        }
+        case LTDC_PIXEL_FORMAT_RGB888:
+        {
+            return 3;
+        }
+        case LTDC_PIXEL_FORMAT_RGB565:
+        case LTDC_PIXEL_FORMAT_ARGB1555:
+        case LTDC_PIXEL_FORMAT_ARGB4444:
+        case LTDC_PIXEL_FORMAT_AL88:
+        {
+            return 2;
+        }
+        case LTDC_PIXEL_FORMAT_L8:
+        case LTDC_PIXEL_FORMAT_AL44:
+        {
+            return 1;
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief   64λ
+ * @param   value: 
+ * @retval  ƽȡ
+ */
+static uint32_t ltdc_fb_sqrt(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    
+    while (bit != 0)
+    {
+        if (value >= (root + bit))
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    
+    return (uint32_t)root;
+}
+
+/**
+ * @brief   DWTڼ
+ * @note    Ѵʱ㣬Ӱģļʱ
+ * @param   
+ * @retval  
+ */
+static void ltdc_fb_dwt_enable(void)
+{
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->LAR = 0xC5ACCE55;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    
+    ltdc_fb_cycles_per_us = SystemCoreClock / 1000000;
+    if (ltdc_fb_cycles_per_us == 0)
+    {
+        ltdc_fb_cycles_per_us = 1;
+    }
+}
+
+/**
+ * @brief   ʼ֡
+ * @note    MX_LTDC_Init()֮ãߴظʽȡԲ1Ĵã
+ *          ռΪMPUдͨ㣬1л0Ϊ͸ȻʹжLTDCжϣ
+ *          MPUmpu_cache_region_size()ȡ벻size˲Ḳ֮ĵַ
+ * @param   base: ֡׵ַСڻܳȵ2ݶ룩
+ * @param   size: ֡ʵʴڵĴ洢ССLTDC_FB_NUMҪ2ݣ
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: LTDCδʼ
+ */
+uint8_t ltdc_fb_init(uint32_t base, uint32_t size)
+{
+    return ltdc_fb_init_ex(base, size, 0, 0);
+}
+
+/**
+ * @brief   ָĻгȳʼ֡
+ * @note    ֡еGFXMMU⻺ÿ4096ֽڣ4MB
+ *          ʱֻÿеЧ֣ͬltdc_fb_init()
+ * @param   base: ֡׵ַСڻܳȵ2ݶ룩
+ * @param   size: ֡ʵʴڵĴ洢Сȫ
+ * @param   stride: ڻ׵ַļֽڣ0ʾУLTDC_FB_ALIGN룩
+ * @param   pitch: гȣֽڣΪֽ0ʾ * ÿֽ
+ * @retval  ʼ
+ * @arg     0: ʼɹ
+ * @arg     1: LTDCδʼ
+ */
+uint8_t ltdc_fb_init_ex(uint32_t base, uint32_t size, uint32_t stride, uint32_t pitch)
+{
+    LTDC_LayerCfgTypeDef layer;
+    uint32_t pixel_size;
+    uint32_t frame_size;
+    uint32_t mpu_size;
+    uint32_t line;
+    uint8_t index;
+    
+    HAL_NVIC_DisableIRQ(LTDC_IRQn);
+    for (index = 0; index < LTDC_FB_NUM; index++)
+    {
+        ltdc_fb_buffer[index] = NULL;
+    }
+    ltdc_fb_front = 0;
+    ltdc_fb_pending = 0;
+    
+    if (hltdc.State == HAL_LTDC_STATE_RESET)
+    {
+        return 1;
+    }
+    
+    layer = hltdc.LayerCfg[0];
+    pixel_size = ltdc_fb_pixel_size(layer.PixelFormat);
+    ltdc_fb_width = layer.WindowX1 - layer.WindowX0;
+    ltdc_fb_height = layer.WindowY1 - layer.WindowY0;
+    ltdc_fb_pitch = (pitch != 0) ? pitch : (ltdc_fb_width * pixel_size);
+    if ((pixel_size == 0) || (ltdc_fb_pitch < ltdc_fb_width * pixel_size) || ((ltdc_fb_pitch % pixel_size) != 0))
+    {
+        return 1;
+    }
+    
+    frame_size = (ltdc_fb_pitch * ltdc_fb_height + LTDC_FB_ALIGN - 1) & ~(LTDC_FB_ALIGN - 1);
+    if (stride == 0)
+    {
+        stride = frame_size;
+    }
+    if ((frame_size == 0) || (stride < frame_size) || ((size / LTDC_FB_NUM) < stride))
+    {
+        return 1;
+    }
+    
+    /* MPUֻǻռ֣ҲʵʴڵĴ洢 */
+    mpu_size = mpu_cache_region_size((LTDC_FB_NUM - 1) * stride + frame_size);
+    if ((mpu_size == 0) || (mpu_size > size))
+    {
+        return 1;
+    }
+    
+    /* CPUдֱӵRAMLTDCȡǰҪдD-Cache */
+    if (mpu_cache_config(LTDC_FB_MPU_REGION, base, mpu_size, MPU_Cache_Write_Through, 0) != 0)
+    {
+        return 1;
+    }
+    
+    for (index = 0; index < LTDC_FB_NUM; index++)
+    {
+        ltdc_fb_buffer[index] = (uint8_t *)(base + index * stride);
+        for (line = 0; line < ltdc_fb_height; line++)
+        {
+            memset(ltdc_fb_buffer[index] + line * ltdc_fb_pitch, 0, ltdc_fb_width * pixel_size);
+        }
+    }
+    __DSB();
+    
+    /* г = ImageWidth * ÿֽ */
+    layer.FBStartAdress = (uint32_t)ltdc_fb_buffer[0];
+    layer.ImageWidth = ltdc_fb_pitch / pixel_size;
+    layer.ImageHeight = ltdc_fb_height;
+    layer.Alpha = 255;
+    if (HAL_LTDC_ConfigLayer(&hltdc, &layer, 0) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    ltdc_fb_dwt_enable();
+    ltdc_fb_reset_stats();
+    
+    /* Чʾɨʱж */
+    ltdc_fb_line = hltdc.Init.AccumulatedActiveH + 1;
+    HAL_NVIC_SetPriority(LTDC_IRQn, LTDC_FB_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(LTDC_IRQn);
+    if (HAL_LTDC_ProgramLineEvent(&hltdc, ltdc_fb_line) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡ֡
+ * @param   
+ * @retval  ȣأ
+ */
+uint32_t ltdc_fb_get_width(void)
+{
+    return ltdc_fb_width;
+}
+
+/**
+ * @brief   ȡ֡߶
+ * @param   
+ * @retval  ߶ȣأ
+ */
+uint32_t ltdc_fb_get_height(void)
+{
+    return ltdc_fb_height;
+}
+
+/**
+ * @brief   ȡ֡г
+ * @param   
+ * @retval  гȣֽڣ
+ */
+uint32_t ltdc_fb_get_pitch(void)
+{
+    return ltdc_fb_pitch;
+}
+
+/**
+ * @brief   ȡʾĻ
+ * @param   
+ * @retval  ׵ַδʼʱΪNULL
+ */
+void *ltdc_fb_get_front(void)
+{
+    return ltdc_fb_buffer[ltdc_fb_front];
+}
+
+/**
+ * @brief   ȡɻƵĺ󻺳
+ * @note    ҳδʱ󻺳ʾNULL
+ * @param   
+ * @retval  ׵ַ
+ */
+void *ltdc_fb_get_back(void)
+{
+    if (ltdc_fb_pending != 0)
+    {
+        return NULL;
+    }
+    
+    return ltdc_fb_buffer[(ltdc_fb_front + 1) % LTDC_FB_NUM];
+}
+
+/**
+ * @brief   һδֱʱǰ󻺳
+ * @note    󻺳ɺãأDMA2D豸Ƶģȴ䴫ɺٵ
+ * @param   
+ * @retval  
+ * @arg     0: ɹ
+ * @arg     1: δʼһηҳδɻHAL
+ */
+uint8_t ltdc_fb_flip(void)
+{
+    uint8_t back;
+    uint8_t res = 0;
+    
+    if ((ltdc_fb_buffer[0] == NULL) || (ltdc_fb_pending != 0))
+    {
+        return 1;
+    }
+    back = (ltdc_fb_front + 1) % LTDC_FB_NUM;
+    
+    /* дͨеCPUдǰ */
+    __DSB();
+    
+    HAL_NVIC_DisableIRQ(LTDC_IRQn);
+    ltdc_fb_pending = 1;
+    if ((HAL_LTDC_SetAddress_NoReload(&hltdc, (uint32_t)ltdc_fb_buffer[back], 0) != HAL_OK) ||
+        (HAL_LTDC_Reload(&hltdc, LTDC_RELOAD_VERTICAL_BLANKING) != HAL_OK))
+    {
+        ltdc_fb_pending = 0;
+        res = 1;
+    }
+    HAL_NVIC_EnableIRQ(LTDC_IRQn);
+    
+    return res;
+}
+
+/**
+ * @brief   ѯҳǷδ
+ * @param   
+ * @retval  0: ; 1: ȴֱ
+ */
+uint8_t ltdc_fb_flip_pending(void)
+{
+    return ltdc_fb_pending;
+}
+
+/**
+ * @brief   ȴҳ
+ * @param   timeout: ʱʱ䣨ms
+ * @retval  ȴ
+ * @arg     0: ҳ
+ * @arg     1: ʱ
+ */
+uint8_t ltdc_fb_wait(uint32_t timeout)
+{
+    uint32_t tickstart = HAL_GetTick();
+    
+    while (ltdc_fb_pending != 0)
+    {
+        if ((HAL_GetTick() - tickstart) > timeout)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ֡ɻص
+ * @note    صLTDCжеãӦ췵أcallbackΪNULLʱȡ
+ * @param   callback: ص
+ * @param   arg: ص
+ * @retval  
+ */
+void ltdc_fb_set_callback(ltdc_fb_callback_t callback, void *arg)
+{
+    uint32_t enabled = NVIC_GetEnableIRQ(LTDC_IRQn);
+    
+    HAL_NVIC_DisableIRQ(LTDC_IRQn);
+    ltdc_fb_callback = callback;
+    ltdc_fb_callback_arg = arg;
+    if (enabled != 0)
+    {
+        HAL_NVIC_EnableIRQ(LTDC_IRQn);
+    }
+}
+
+/**
+ * @brief   ȡ֡ͳ
+ * @param   stats: ͳƽṹָ
+ * @retval  
+ */
+void ltdc_fb_get_stats(ltdc_fb_stats_t *stats)
+{
+    uint32_t refresh_intervals;
+    uint64_t refresh_sum;
+    uint32_t frame_intervals;
+    uint64_t frame_sum;
+    uint64_t frame_square_sum;
+    uint64_t average;
+    uint32_t enabled = NVIC_GetEnableIRQ(LTDC_IRQn);
+    
+    memset(stats, 0, sizeof(ltdc_fb_stats_t));
+    
+    HAL_NVIC_DisableIRQ(LTDC_IRQn);
+    stats->refreshes = ltdc_fb_timing.refreshes;
+    stats->flips = ltdc_fb_timing.flips;
+    stats->dropped = ltdc_fb_timing.dropped;
+    stats->frame_min_us = ltdc_fb_timing.frame_min;
+    stats->frame_max_us = ltdc_fb_timing.frame_max;
+    refresh_intervals = ltdc_fb_timing.refresh_intervals;
+    refresh_sum = ltdc_fb_timing.refresh_sum;
+    frame_intervals = ltdc_fb_timing.frame_intervals;
+    frame_sum = ltdc_fb_timing.frame_sum;
+    frame_square_sum = ltdc_fb_timing.frame_square_sum;
+    if (enabled != 0)
+    {
+        HAL_NVIC_EnableIRQ(LTDC_IRQn);
+    }
+    
+    if (refresh_intervals != 0)
+    {
+        stats->refresh_us = (uint32_t)(refresh_sum / refresh_intervals);
+    }
+    
+    if ((frame_intervals != 0) && (frame_sum != 0))
+    {
+        average = frame_sum / frame_intervals;
+        stats->frame_avg_us = (uint32_t)average;
+        stats->fps_x100 = (uint32_t)((100000000ULL * frame_intervals) / frame_sum);
+        
+        /* ׼ = sqrt(E[x^2] - E[x]^2) */
+        if ((frame_square_sum / frame_intervals) > (average * average))
+        {
+            stats->jitter_us = ltdc_fb_sqrt(frame_square_sum / frame_intervals - average * average);
+        }
+    }
+    else
+    {
+        stats->frame_min_us = 0;
+    }
+}
+
+/**
+ * @brief   ֡ͳ
+ * @param   
+ * @retval  
+ */
+void ltdc_fb_reset_stats(void)
+{
+    uint32_t enabled = NVIC_GetEnableIRQ(LTDC_IRQn);
+    
+    HAL_NVIC_DisableIRQ(LTDC_IRQn);
+    memset(&ltdc_fb_timing, 0, sizeof(ltdc_fb_timing));
+    ltdc_fb_timing.frame_min = 0xFFFFFFFF;
+    if (enabled != 0)
+    {
+        HAL_NVIC_EnableIRQ(LTDC_IRQn);
+    }
+}
+
+/**
+ * @brief   LTDCжϴLTDC_IRQHandler()еã
+ * @param   
+ * @retval  
+ */
+void ltdc_fb_irq_handler(void)
+{
+    HAL_LTDC_IRQHandler(&hltdc);
+}
+
+/**
+ * @brief   LTDCжϻصЧʾɨ
+ * @param   hltdc: LTDC
+ * @retval  
+ */
+void HAL_LTDC_LineEventCallback(LTDC_HandleTypeDef *hltdc)
+{
+    uint32_t now = DWT->CYCCNT;
+    
+    if (ltdc_fb_timing.refreshes != 0)
+    {
+        ltdc_fb_timing.refresh_sum += (now - ltdc_fb_timing.refresh_time) / ltdc_fb_cycles_per_us;
+        ltdc_fb_timing.refresh_intervals++;
+    }
+    ltdc_fb_timing.refresh_time = now;
+    ltdc_fb_timing.refreshes++;
+    
+    if (ltdc_fb_callback != NULL)
+    {
+        ltdc_fb_callback(ltdc_fb_timing.refreshes, ltdc_fb_buffer[ltdc_fb_front], ltdc_fb_callback_arg);
+    }
+    
+    /* HALѹرжϣֱдĴʹܣHAL_LTDC_ProgramLineEvent() */
+    LTDC->LIPCR = ltdc_fb_line;
+    __HAL_LTDC_ENABLE_IT(hltdc, LTDC_IT_LI);
+}
+
+/**
+ * @brief   LTDCжϻصֱʱӰӼĴЧ
+ * @param   hltdc: LTDC
+ * @retval  
+ */
+void HAL_LTDC_ReloadEventCallback(LTDC_HandleTypeDef *hltdc)
+{
+    uint32_t now = DWT->CYCCNT;
+    uint32_t interval;
+    uint32_t refreshes;
+    
+    if (ltdc_fb_pending == 0)
+    {
+        return;
+    }
+    ltdc_fb_front = (ltdc_fb_front + 1) % LTDC_FB_NUM;
+    ltdc_fb_pending = 0;
+    
+    if (ltdc_fb_timing.flips != 0)
+    {
+        interval = (now - ltdc_fb_timing.flip_time) / ltdc_fb_cycles_per_us;
+        ltdc_fb_timing.frame_intervals++;
+        ltdc_fb_timing.frame_sum += interval;
+        ltdc_fb_timing.frame_square_sum += (uint64_t)interval * interval;
+        if (interval < ltdc_fb_timing.frame_min)
+        {
+            ltdc_fb_timing.frame_min = interval;
+        }
+        if (interval > ltdc_fb_timing.frame_max)
+        {
+            ltdc_fb_timing.frame_max = interval;
+        }
+        
+        /* ηҳ֮ÿһˢ£֡Ͷʾһ */
+        refreshes = ltdc_fb_timing.refreshes - ltdc_fb_timing.flip_refresh;
+        if (refreshes > 1)
+        {
+            ltdc_fb_timing.dropped += refreshes - 1;
+        }
+    }
+    ltdc_fb_timing.flip_time = now;
+    ltdc_fb_timing.flip_refresh = ltdc_fb_timing.refreshes;
+    ltdc_fb_timing.flips++;
+}
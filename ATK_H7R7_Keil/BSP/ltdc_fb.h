@@ -0,0 +1,85 @@
+/**
+ ****************************************************************************************************
+ * @file        ltdc_fb.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       LTDC˫֡
+ ****************************************************************************************************
+ * @attention
+ *
+ * ָRAMзǰ֡ߴظʽȡԲ1ڣ
+ * 800x480 RGB565ÿ750KBӦóں󻺳ɺltdc_fb_flip()
+ * µַһδֱʱЧHAL_LTDC_SetAddress_NoReload + ֱأ˺ѣ
+ * ҳǰ󻺳ʾltdc_fb_get_back()NULLltdc_fb_wait()ȴ
+ * ÿ֡Чʾɨʱжϣ֡ɻصصжִ
+ * ͳˢڡʵ֡ʣҳҳС//ƽֵ׼ʱDWTڼ
+ * ռΪMPUдͨMPU_CACHE_REGION_USERȥĩβС
+ * CPUдֱӵRAMҳǰҪдD-Cache
+ * 豸DMA2DдCPUҪʱmpu_cache_invalidate()
+ * ĬΪAXI SRAMĩˣscatterļRW_NONCACHEABLEBUFFER֮󣬵0x24071BFFLTDC_FB_RAM_SIZEֽڣ
+ * 800x480Ų£main.cѲ1СΪLTDC_FB_WIDTH x LTDC_FB_HEIGHTУʾLTDCɫ
+ * ⲿPSRAMɸڴӳ䴰ڣltdc_fb_init()ǰѽڴӳģʽʾ
+ * ҲGFXMMU⻺gfxmmu_fb.hг뻺ltdc_fb_init_ex()ָͼ밴ltdc_fb_get_pitch()
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __LTDC_FB_H
+#define __LTDC_FB_H
+
+#include "main.h"
+#include "ltdc.h"
+
+/* Ĭ֡壨AXI SRAM׵ַ256KB룻СΪʵʴڵRAM0x24071BFF */
+#define LTDC_FB_BASE                (0x24040000UL)
+#define LTDC_FB_RAM_SIZE            (0x00031C00UL)
+
+/* ĬĲ1ڶ壨RGB565196608ֽڣMPUΪ256KBеǰ632KB */
+#define LTDC_FB_WIDTH               (256)
+#define LTDC_FB_HEIGHT              (192)
+
+/* ֡ */
+#define LTDC_FB_NUM                 (2)
+
+/* ֡붨壨LTDC AXIͻȣ */
+#define LTDC_FB_ALIGN               (64UL)
+
+/* ֡MPU */
+#define LTDC_FB_MPU_REGION          MPU_CACHE_REGION_USER
+
+/* LTDCжȼ */
+#define LTDC_FB_IRQ_PRIORITY        (5)
+
+/* ֡ɻص壨жеãframeΪˢ¼frontΪʾĻ */
+typedef void (*ltdc_fb_callback_t)(uint32_t frame, void *front, void *arg);
+
+/* LTDC֡ͳƶ */
+typedef struct {
+    uint32_t refreshes;     /* ˢ´ */
+    uint32_t flips;         /* ɵķҳ */
+    uint32_t dropped;       /* ҳһˢڶظʾ֡ */
+    uint32_t refresh_us;    /* ƽˢڣus */
+    uint32_t fps_x100;      /* ʵ֡x100 */
+    uint32_t frame_min_us;  /* ҳСֵus */
+    uint32_t frame_max_us;  /* ҳֵus */
+    uint32_t frame_avg_us;  /* ҳƽֵus */
+    uint32_t jitter_us;     /* ҳ׼us */
+} ltdc_fb_stats_t;
+
+/*  */
+uint8_t ltdc_fb_init(uint32_t base, uint32_t size);                                 /* ʼ֡ */
+uint8_t ltdc_fb_init_ex(uint32_t base, uint32_t size, uint32_t stride, uint32_t pitch);     /* ָĻгȳʼ֡ */
+uint32_t ltdc_fb_get_width(void);                                                   /* ȡ֡ȣأ */
+uint32_t ltdc_fb_get_height(void);                                                  /* ȡ֡߶ȣأ */
+uint32_t ltdc_fb_get_pitch(void);                                                   /* ȡ֡гȣֽڣ */
+void *ltdc_fb_get_front(void);                                                      /* ȡʾĻ */
+void *ltdc_fb_get_back(void);                                                       /* ȡɻƵĺ󻺳 */
+uint8_t ltdc_fb_flip(void);                                                         /* һδֱʱǰ󻺳 */
+uint8_t ltdc_fb_flip_pending(void);                                                 /* ѯҳǷδ */
+uint8_t ltdc_fb_wait(uint32_t timeout);                                             /* ȴҳ */
+void ltdc_fb_set_callback(ltdc_fb_callback_t callback, void *arg);                  /* ֡ɻص */
+void ltdc_fb_get_stats(ltdc_fb_stats_t *stats);                                     /* ȡ֡ͳ */
+void ltdc_fb_reset_stats(void);                                                     /* ֡ͳ */
+void ltdc_fb_irq_handler(void);                                                     /* LTDCжϴ */
+
+#endif /* __LTDC_FB_H */
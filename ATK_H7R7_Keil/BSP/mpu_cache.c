@@ -0,0 +1,308 @@
+/**
+ ****************************************************************************************************
+ * @file        mpu_cache.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       MPU洢L1 Cache
+ ****************************************************************************************************
+ * @attention
+ *
+ * BootloaderӦó򶼵mpu_cache_init()ӦóBootloaderתʱCacheѾʹܣ
+ * ǰдزЧD-CacheⰴԻв
+ * Ըıʱmpu_cache_config()ͬдزЧD-Cache
+ *
+ ****************************************************************************************************
+ */
+
+#include "mpu_cache.h"
+
+/* noncacheable_bufferִ׵ַɣ */
+extern uint32_t Image$$RW_NONCACHEABLEBUFFER$$Base;
+
+/**
+ * @brief   жD-CacheǷʹ
+ * @param   
+ * @retval  жϽ
+ * @arg     0: δʹ
+ * @arg     1: ʹ
+ */
+static uint8_t mpu_cache_dcache_enabled(void)
+{
+    return ((SCB->CCR & SCB_CCR_DC_Msk) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief   дһMPU
+ * @note    ǰѹرMPU
+ * @param   number: 
+ * @param   base: ׵ַ
+ * @param   size_code: СMPU_REGION_SIZE_xxx
+ * @param   subregion: ֹ
+ * @param   attr: 洢
+ * @param   flags: ־MPU_CACHE_FLAG_xxx
+ * @retval  
+ */
+static void mpu_cache_region(uint8_t number, uint32_t base, uint8_t size_code, uint8_t subregion, mpu_cache_attr_t attr, uint8_t flags)
+{
+    MPU_Region_InitTypeDef mpu_init_struct = {0};
+    
+    mpu_init_struct.Enable = MPU_REGION_ENABLE;
+    mpu_init_struct.Number = number;
+    mpu_init_struct.BaseAddress = base;
+    mpu_init_struct.Size = size_code;
+    mpu_init_struct.SubRegionDisable = subregion;
+    mpu_init_struct.AccessPermission = ((flags & MPU_CACHE_FLAG_READONLY) != 0) ? MPU_REGION_PRIV_RO_URO : MPU_REGION_FULL_ACCESS;
+    mpu_init_struct.DisableExec = ((flags & MPU_CACHE_FLAG_EXEC) != 0) ? MPU_INSTRUCTION_ACCESS_ENABLE : MPU_INSTRUCTION_ACCESS_DISABLE;
+    mpu_init_struct.IsShareable = MPU_ACCESS_NOT_SHAREABLE;
+    
+    /* TEX/C/B */
+    switch (attr)
+    {
+        case MPU_Cache_Device:
+            mpu_init_struct.TypeExtField = MPU_TEX_LEVEL0;
+            mpu_init_struct.IsShareable = MPU_ACCESS_SHAREABLE;
+            mpu_init_struct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+            mpu_init_struct.IsBufferable = MPU_ACCESS_BUFFERABLE;
+            mpu_init_struct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+            break;
+        case MPU_Cache_Non_Cacheable:
+            mpu_init_struct.TypeExtField = MPU_TEX_LEVEL1;
+            mpu_init_struct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+            mpu_init_struct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+            break;
+        case MPU_Cache_Write_Through:
+            mpu_init_struct.TypeExtField = MPU_TEX_LEVEL0;
+            mpu_init_struct.IsCacheable = MPU_ACCESS_CACHEABLE;
+            mpu_init_struct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+            break;
+        case MPU_Cache_Write_Back:
+            mpu_init_struct.TypeExtField = MPU_TEX_LEVEL1;
+            mpu_init_struct.IsCacheable = MPU_ACCESS_CACHEABLE;
+            mpu_init_struct.IsBufferable = MPU_ACCESS_BUFFERABLE;
+            break;
+        default:
+            mpu_init_struct.TypeExtField = MPU_TEX_LEVEL0;
+            mpu_init_struct.AccessPermission = MPU_REGION_NO_ACCESS;
+            mpu_init_struct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+            mpu_init_struct.IsShareable = MPU_ACCESS_SHAREABLE;
+            mpu_init_struct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+            mpu_init_struct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+            break;
+    }
+    
+    HAL_MPU_ConfigRegion(&mpu_init_struct);
+}
+
+/**
+ * @brief   MPUʹL1 Cache
+ * @note    MPU_Config()еãʼδʹõ5~15ȫر
+ * @param   
+ * @retval  
+ */
+void mpu_cache_init(void)
+{
+    uint32_t regions;
+    uint32_t number;
+    
+    if (mpu_cache_dcache_enabled() != 0)
+    {
+        SCB_CleanInvalidateDCache();
+    }
+    
+    HAL_MPU_Disable();
+    
+    /* : 0x60000000~0xDFFFFFFFֹʣ0~27ʹܣ */
+    mpu_cache_region(MPU_CACHE_REGION_BACKGROUND, 0x00000000UL, MPU_REGION_SIZE_4GB, 0x87, MPU_Cache_No_Access, 0);
+    
+    /* XSPI1ڴӳ䴰: ֻдͨ */
+    mpu_cache_region(MPU_CACHE_REGION_XSPI1, MPU_CACHE_XSPI1_BASE, MPU_REGION_SIZE_32MB, 0x00, MPU_Cache_Write_Through,
+                     MPU_CACHE_FLAG_EXEC | MPU_CACHE_FLAG_READONLY);
+    
+    /* AXI SRAM: д */
+    mpu_cache_region(MPU_CACHE_REGION_AXI_SRAM, MPU_CACHE_AXI_SRAM_BASE, MPU_REGION_SIZE_512KB, 0x00, MPU_Cache_Write_Back, MPU_CACHE_FLAG_EXEC);
+    
+    /* AHB SRAMnoncacheable_buffer: ɻ */
+    mpu_cache_region(MPU_CACHE_REGION_AHB_SRAM, MPU_CACHE_AHB_SRAM_BASE, MPU_REGION_SIZE_32KB, 0x00, MPU_Cache_Non_Cacheable, 0);
+    mpu_cache_region(MPU_CACHE_REGION_NONCACHEABLE, (uint32_t)&Image$$RW_NONCACHEABLEBUFFER$$Base, MPU_REGION_SIZE_1KB, 0x00,
+                     MPU_Cache_Non_Cacheable, 0);
+    
+    regions = (MPU->TYPE & MPU_TYPE_DREGION_Msk) >> MPU_TYPE_DREGION_Pos;
+    for (number = MPU_CACHE_REGION_USER; number < regions; number++)
+    {
+        HAL_MPU_DisableRegion(number);
+    }
+    
+    HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+    
+    SCB_EnableICache();
+    SCB_EnableDCache();
+}
+
+/**
+ * @brief   һMPU
+ * @note    еʱдزЧD-CacheڹرMPU¸д
+ * @param   number: ţMPU_CACHE_REGION_USER
+ * @note    size2ʱ2򲢽ĩβֻsizeֽ
+ * @param   base: ׵ַ밴Сsize2ݶ
+ * @param   size: С32B~2GB2ʱΪmpu_cache_region_size()ķֵ
+ * @param   attr: 洢
+ * @param   flags: ־MPU_CACHE_FLAG_xxx
+ * @retval  ý
+ * @arg     0: óɹ
+ * @arg     1: 
+ */
+uint8_t mpu_cache_config(uint8_t number, uint32_t base, uint32_t size, mpu_cache_attr_t attr, uint8_t flags)
+{
+    uint32_t control;
+    uint32_t region;
+    uint8_t subregion;
+    uint8_t bits;
+    
+    if ((number < MPU_CACHE_REGION_USER) || (number >= ((MPU->TYPE & MPU_TYPE_DREGION_Msk) >> MPU_TYPE_DREGION_Pos)) ||
+        (attr >= MPU_Cache_Dummy) || (size < 32) || (size > 0x80000000UL) || (mpu_cache_region_size(size) != size))
+    {
+        return 1;
+    }
+    
+    /* СΪlog2(region)-1regionΪСsize2 */
+    for (bits = 5; (1UL << bits) < size; bits++)
+    {
+    }
+    region = 1UL << bits;
+    if ((base & (region - 1)) != 0)
+    {
+        return 1;
+    }
+    
+    /* Ϊ8򣨲С256Bʱsize֮ */
+    subregion = (bits >= 8) ? (uint8_t)(0xFFUL << (size / (region >> 3))) : 0x00;
+    
+    mpu_cache_clean_invalidate((volatile void *)base, size);
+    
+    control = MPU->CTRL;
+    HAL_MPU_Disable();
+    mpu_cache_region(number, base, bits - 1, subregion, attr, flags);
+    if ((control & MPU_CTRL_ENABLE_Msk) != 0)
+    {
+        HAL_MPU_Enable(control & ~MPU_CTRL_ENABLE_Msk);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief   ȡָMPUС
+ * @note    С256Bɰ1/8˷ֵlength2ݵ1/8ȡ
+ *          mpu_cache_config()sizeʱ򲻻ᳬlength̫
+ * @param   length: Ҫǵĳȣ1B~2GB
+ * @retval  С0ʾlengthΧ
+ */
+uint32_t mpu_cache_region_size(uint32_t length)
+{
+    uint32_t region = 32;
+    uint32_t granule;
+    
+    if ((length == 0) || (length > 0x80000000UL))
+    {
+        return 0;
+    }
+    
+    while (region < length)
+    {
+        region <<= 1;
+    }
+    
+    if (region < 256)
+    {
+        return region;
+    }
+    
+    granule = region >> 3;
+    return (length + granule - 1) & ~(granule - 1);
+}
+
+/**
+ * @brief   дD-Cache
+ * @note    CPUдDMAȡǰãȳD-CacheСʱдD-Cache
+ * @param   address: ׵ַ
+ * @param   length: 
+ * @retval  
+ */
+void mpu_cache_clean(const volatile void *address, uint32_t length)
+{
+    if ((length == 0) || (mpu_cache_dcache_enabled() == 0))
+    {
+        return;
+    }
+    
+    if (length > MPU_CACHE_DCACHE_SIZE)
+    {
+        SCB_CleanDCache();
+    }
+    else
+    {
+        SCB_CleanDCache_by_Addr((volatile void *)address, (int32_t)length);
+    }
+}
+
+/**
+ * @brief   ЧD-Cache
+ * @note    DMAдCPUȡǰãβCacheдЧʧͬһ޸
+ * @param   address: ׵ַ
+ * @param   length: 
+ * @retval  
+ */
+void mpu_cache_invalidate(volatile void *address, uint32_t length)
+{
+    uint32_t head = (uint32_t)address;
+    uint32_t end = head + length;
+    uint32_t tail = end & ~(MPU_CACHE_LINE_SIZE - 1);
+    
+    if ((length == 0) || (mpu_cache_dcache_enabled() == 0))
+    {
+        return;
+    }
+    
+    /* в */
+    if ((head & (MPU_CACHE_LINE_SIZE - 1)) != 0)
+    {
+        head &= ~(MPU_CACHE_LINE_SIZE - 1);
+        SCB_CleanInvalidateDCache_by_Addr((volatile void *)head, (int32_t)MPU_CACHE_LINE_SIZE);
+        head += MPU_CACHE_LINE_SIZE;
+    }
+    
+    /* βвΪͬһʱѴ */
+    if ((tail != end) && (tail >= head))
+    {
+        SCB_CleanInvalidateDCache_by_Addr((volatile void *)tail, (int32_t)MPU_CACHE_LINE_SIZE);
+    }
+    
+    if (tail > head)
+    {
+        SCB_InvalidateDCache_by_Addr((volatile void *)head, (int32_t)(tail - head));
+    }
+}
+
+/**
+ * @brief   дزЧD-Cache
+ * @note    CPUDMAдͬһʱãȳD-CacheСʱD-Cache
+ * @param   address: ׵ַ
+ * @param   length: 
+ * @retval  
+ */
+void mpu_cache_clean_invalidate(volatile void *address, uint32_t length)
+{
+    if ((length == 0) || (mpu_cache_dcache_enabled() == 0))
+    {
+        return;
+    }
+    
+    if (length > MPU_CACHE_DCACHE_SIZE)
+    {
+        SCB_CleanInvalidateDCache();
+    }
+    else
+    {
+        SCB_CleanInvalidateDCache_by_Addr(address, (int32_t)length);
+    }
+}
@@ -0,0 +1,81 @@
+/**
+ ****************************************************************************************************
+ * @file        mpu_cache.h
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       MPU洢L1 Cache
+ ****************************************************************************************************
+ * @attention
+ *
+ * mpu_cache_init()򣨱ŴȣʹI-CacheD-Cache:
+ *   0: 0x60000000~0xDFFFFFFF ֹʣCubeMXĬϵı򣬷ֹƲδʼⲿ洢
+ *   1: XSPI1ڴӳ䴰 0x90000000 32MBдͨ䣬ִֻУXIP볣
+ *   2: AXI SRAM 0x24000000 512KBдضд䣬ִ
+ *   3: AHB SRAM 0x30000000 32KBɻ棨DMA
+ *   4: noncacheable_bufferΣscatterļеRW_NONCACHEABLEBUFFER1KBɻ
+ *   5~15: mpu_cache_config()ãLTDC֡С2ʱȥĩβ
+ * ַʹĬϴ洢ӳ䣨ITCM/DTCMCacheSRAMдأΪ豸
+ *
+ * ɻеDMA:
+ *   CPUдDMAȡǰͣmpu_cache_clean()
+ *   DMAдCPUȡǰգmpu_cache_invalidate()
+ *   ׵ַ볤ӦCacheж루MPU_CACHE_ALIGNEDβдЧ
+ *   ͬһеᶪʧDMAдݿܱCPUдصľݸ
+ * άCacheСMPU_CACHE_NONCACHEABLEnoncacheable_buffer
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __MPU_CACHE_H
+#define __MPU_CACHE_H
+
+#include "main.h"
+
+/* L1 Cache */
+#define MPU_CACHE_LINE_SIZE         (32UL)
+#define MPU_CACHE_DCACHE_SIZE       (0x00008000UL)  /* ˳ʱдأȰַи */
+
+/* 洢 */
+#define MPU_CACHE_XSPI1_BASE        (0x90000000UL)
+#define MPU_CACHE_XSPI1_SIZE        (0x02000000UL)  /* ˫W25Q128 */
+#define MPU_CACHE_AXI_SRAM_BASE     (0x24000000UL)
+#define MPU_CACHE_AXI_SRAM_SIZE     (0x00080000UL)  /* 456KBСΪ2 */
+#define MPU_CACHE_AHB_SRAM_BASE     (0x30000000UL)
+#define MPU_CACHE_AHB_SRAM_SIZE     (0x00008000UL)
+#define MPU_CACHE_NONCACHEABLE_SIZE (0x00000400UL)  /* scatterļRW_NONCACHEABLEBUFFERһ */
+
+/* MPUŶ */
+#define MPU_CACHE_REGION_BACKGROUND     MPU_REGION_NUMBER0
+#define MPU_CACHE_REGION_XSPI1          MPU_REGION_NUMBER1
+#define MPU_CACHE_REGION_AXI_SRAM       MPU_REGION_NUMBER2
+#define MPU_CACHE_REGION_AHB_SRAM       MPU_REGION_NUMBER3
+#define MPU_CACHE_REGION_NONCACHEABLE   MPU_REGION_NUMBER4
+#define MPU_CACHE_REGION_USER           MPU_REGION_NUMBER5  /* õĵһ */
+
+/* ־ */
+#define MPU_CACHE_FLAG_EXEC         (1U << 0)       /* ȡָ */
+#define MPU_CACHE_FLAG_READONLY     (1U << 1)       /* ֻ */
+
+/* Զ */
+#define MPU_CACHE_ALIGNED           __attribute__((aligned(32)))
+#define MPU_CACHE_NONCACHEABLE      __attribute__((section("noncacheable_buffer")))
+
+/* 洢Զ */
+typedef enum {
+    MPU_Cache_No_Access = 0,    /* ֹ */
+    MPU_Cache_Device,           /* 豸ɹ */
+    MPU_Cache_Non_Cacheable,    /* ͨ洢ɻ */
+    MPU_Cache_Write_Through,    /* ͨ洢дͨ */
+    MPU_Cache_Write_Back,       /* ͨ洢дضд */
+    MPU_Cache_Dummy,
+} mpu_cache_attr_t;
+
+/*  */
+void mpu_cache_init(void);                                                          /* MPUʹL1 Cache */
+uint8_t mpu_cache_config(uint8_t number, uint32_t base, uint32_t size, mpu_cache_attr_t attr, uint8_t flags);  /* һMPU */
+uint32_t mpu_cache_region_size(uint32_t length);                                    /* ȡָMPUС */
+void mpu_cache_clean(const volatile void *address, uint32_t length);                /* дD-CacheDMAȡǰ */
+void mpu_cache_invalidate(volatile void *address, uint32_t length);                 /* ЧD-CacheDMAд */
+void mpu_cache_clean_invalidate(volatile void *address, uint32_t length);           /* дزЧD-Cache */
+
+#endif /* __MPU_CACHE_H */
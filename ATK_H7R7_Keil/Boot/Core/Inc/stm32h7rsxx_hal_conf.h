@@ -42,11 +42,11 @@
 /* #define HAL_CRC_MODULE_ENABLED   */
 /* #define HAL_CRYP_MODULE_ENABLED   */
 /* #define HAL_DCMIPP_MODULE_ENABLED   */
-/* #define HAL_DMA2D_MODULE_ENABLED   */
+#define HAL_DMA2D_MODULE_ENABLED
 /* #define HAL_DTS_MODULE_ENABLED   */
 /* #define HAL_ETH_MODULE_ENABLED   */
 /* #define HAL_FDCAN_MODULE_ENABLED   */
-/* #define HAL_GFXMMU_MODULE_ENABLED   */
+#define HAL_GFXMMU_MODULE_ENABLED
 /* #define HAL_GFXTIM_MODULE_ENABLED   */
 /* #define HAL_GPU2D_MODULE_ENABLED   */
 /* #define HAL_HASH_MODULE_ENABLED   */
@@ -26,6 +26,10 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "norflash_w25q128.h"
+#include "mpu_cache.h"
+#include "ltdc_fb.h"
+#include "gfx_dma2d.h"
+#include "gfxmmu_fb.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -35,6 +39,26 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+/* 1: ԲδڣGFXMMUֻΪɼطBSP/gfxmmu_fb.h0: δڣ֡ */
+#ifndef LCD_USE_GFXMMU
+#define LCD_USE_GFXMMU      (0)
+#endif
+
+#if (LCD_USE_GFXMMU != 0)
+#define LCD_WIDTH           GFXMMU_FB_WIDTH
+#define LCD_HEIGHT          GFXMMU_FB_HEIGHT
+#else
+#define LCD_WIDTH           LTDC_FB_WIDTH
+#define LCD_HEIGHT          LTDC_FB_HEIGHT
+#if ((LTDC_FB_WIDTH * LTDC_FB_HEIGHT * 2 * LTDC_FB_NUM) > LTDC_FB_RAM_SIZE)
+#error "LTDC_FB_WIDTH x LTDC_FB_HEIGHT RGB565 buffers do not fit in LTDC_FB_RAM_SIZE"
+#endif
+#endif
+
+#define LCD_COLOR_BACK      GFX_ARGB(255, 0, 0, 128)
+#define LCD_COLOR_BAR       GFX_ARGB(255, 255, 255, 255)
+#define LCD_BAR_WIDTH       (16U)         /* ȣأ */
+#define LCD_LED_FRAMES      (18U)         /* 60HzʱԼ300msתһLED */
 
 /* USER CODE END PD */
 
@@ -53,6 +77,8 @@
 void SystemClock_Config(void);
 static void MPU_Config(void);
 /* USER CODE BEGIN PFP */
+static void lcd_init(void);
+static uint8_t lcd_draw_frame(uint8_t *back, uint32_t frame);
 
 /* USER CODE END PFP */
 
@@ -73,7 +99,8 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
-
+	uint32_t frame = 0;
+	uint8_t *back;
   /* USER CODE END 1 */
 
   /* MPU Configuration--------------------------------------------------------*/
@@ -117,6 +144,7 @@ int main(void)
 //	LL_mDelay(100);
 //	if(norflash_read(flashsize - TEXT_SIZE, data, TEXT_SIZE)!=0) printf_tx1("norflash_read Err\n");
 //	printf_tx1("The Data Readed Is:%s\n",(char *)data);
+	lcd_init();
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -126,9 +154,29 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
-		LL_GPIO_TogglePin(LED0_GPIO_Port, LED0_Pin);
-		LL_GPIO_TogglePin(LED1_GPIO_Port, LED1_Pin);
-		LL_mDelay(300);
+		/* DMA2Dں󻺳һ֡ɺһδֱʱҳȴҳɺ󻺳ſٴλ */
+		back = ltdc_fb_get_back();
+		if (back != NULL)
+		{
+			if (lcd_draw_frame(back, frame) != 0)
+			{
+				printf_tx1("lcd_draw_frame Err\n");
+			}
+			else if (ltdc_fb_flip() != 0)
+			{
+				printf_tx1("ltdc_fb_flip Err\n");
+			}
+		}
+		if (ltdc_fb_wait(100) != 0)
+		{
+			printf_tx1("ltdc_fb_wait timeout\n");
+		}
+		frame++;
+		if ((frame % LCD_LED_FRAMES) == 0)
+		{
+			LL_GPIO_TogglePin(LED0_GPIO_Port, LED0_Pin);
+			LL_GPIO_TogglePin(LED1_GPIO_Port, LED1_Pin);
+		}
   }
   /* USER CODE END 3 */
 }
@@ -201,36 +249,77 @@ void SystemClock_Config(void)
 }
 
 /* USER CODE BEGIN 4 */
+/**
+  * @brief  Ѳ1СΪLCD_WIDTH x LCD_HEIGHTУAXI SRAMгʼ˫֡GFXMMUԣDMA2D
+  * @retval None
+  */
+static void lcd_init(void)
+{
+	uint32_t active_w = hltdc.Init.AccumulatedActiveW - hltdc.Init.AccumulatedHBP;
+	uint32_t active_h = hltdc.Init.AccumulatedActiveH - hltdc.Init.AccumulatedVBP;
+	uint8_t res;
+
+	if ((HAL_LTDC_SetWindowSize(&hltdc, LCD_WIDTH, LCD_HEIGHT, 0) != HAL_OK) ||
+	    (HAL_LTDC_SetWindowPosition(&hltdc, (active_w - LCD_WIDTH) / 2, (active_h - LCD_HEIGHT) / 2, 0) != HAL_OK))
+	{
+		printf_tx1("LTDC window Err\n");
+		Error_Handler();
+	}
 
-/* USER CODE END 4 */
+#if (LCD_USE_GFXMMU != 0)
+	/* ֻռԲڵĿ飬СʵʴڵRAM */
+	res = gfxmmu_fb_init(GFXMMU_FB_RADIUS, 0, LTDC_FB_BASE, LTDC_FB_RAM_SIZE);
+#else
+	res = ltdc_fb_init(LTDC_FB_BASE, LTDC_FB_RAM_SIZE);
+#endif
+	if (res != 0)
+	{
+		printf_tx1("frame buffer init Err\n");
+		Error_Handler();
+	}
 
- /* MPU Configuration */
+	if (gfx_dma2d_init() != 0)
+	{
+		printf_tx1("gfx_dma2d_init Err\n");
+		Error_Handler();
+	}
+}
 
-static void MPU_Config(void)
+/**
+  * @brief  DMA2Dں󻺳һ֡֡ƵȴDMA2Dɺ󷵻
+  * @param  back: 󻺳
+  * @param  frame: ֡
+  * @retval 0: ; 1: ύʧܻDMA2Dʱ
+  */
+static uint8_t lcd_draw_frame(uint8_t *back, uint32_t frame)
 {
-  MPU_Region_InitTypeDef MPU_InitStruct = {0};
+	gfx_surface_t surface = {0};
+	int32_t bar;
+
+	surface.data = back;
+	surface.pitch = ltdc_fb_get_pitch();
+	surface.width = (uint16_t)ltdc_fb_get_width();
+	surface.height = (uint16_t)ltdc_fb_get_height();
+	surface.format = GFX_FORMAT_RGB565;
+	bar = (int32_t)(frame % (surface.width - LCD_BAR_WIDTH + 1));
+
+	/* ڶִУҳǰȴDMA2Dд */
+	if ((gfx_dma2d_fill(&surface, 0, 0, surface.width, surface.height, LCD_COLOR_BACK) != 0) ||
+	    (gfx_dma2d_fill(&surface, bar, 0, LCD_BAR_WIDTH, surface.height, LCD_COLOR_BAR) != 0))
+	{
+		return 1;
+	}
 
-  /* Disables the MPU */
-  HAL_MPU_Disable();
+	return gfx_dma2d_wait(100);
+}
+/* USER CODE END 4 */
 
-  /** Initializes and configures the Region and the memory to be protected
-  */
-  MPU_InitStruct.Enable = MPU_REGION_ENABLE;
-  MPU_InitStruct.Number = MPU_REGION_NUMBER0;
-  MPU_InitStruct.BaseAddress = 0x0;
-  MPU_InitStruct.Size = MPU_REGION_SIZE_4GB;
-  MPU_InitStruct.SubRegionDisable = 0x87;
-  MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL0;
-  MPU_InitStruct.AccessPermission = MPU_REGION_NO_ACCESS;
-  MPU_InitStruct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
-  MPU_InitStruct.IsShareable = MPU_ACCESS_SHAREABLE;
-  MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
-  MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
-
-  HAL_MPU_ConfigRegion(&MPU_InitStruct);
-  /* Enables the MPU */
-  HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+ /* MPU Configuration */
 
+static void MPU_Config(void)
+{
+  /* XSPI1AXI SRAMAHB SRAMnoncacheable_bufferԣʹI-CacheD-CacheBSP/mpu_cache.h */
+  mpu_cache_init();
 }
 
 /**
@@ -0,0 +1,664 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_cmd_test.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       ʸͼб׼
+ ****************************************************************************************************
+ * @attention
+ *
+ * ԣļ飨Բرߵĸʡ˵㡢żġ
+ * ȱ任90תıȡü
+ * Ⱦɳgolden CRC32ȽϣդȫΪ㣬Ŀgfx_cmd_render()ĽӦλͬ
+ * ޸Ĺդ-uӡµCRC-wPPMͼĿӼٸgolden
+ * ׼CPUȾʱ䣻ĿDMA2Dֵʱgfx_cmd_exec_time()
+ *
+ * ÷: gfx_cmd_test [-b] [-u] [-w]
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfx_cmd.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* ߴ綨 */
+#define SCENE_WIDTH             (240)
+#define SCENE_HEIGHT            (160)
+
+/* С壨֣ */
+#define CMD_BUFFER_SIZE         (2048)
+
+/* ׼ */
+#define BENCH_MIN_TIME          (0.2)
+
+/*  */
+typedef struct {
+    const char *name;
+    uint8_t format;
+    void (*build)(gfx_cmd_list_t *list);
+    uint32_t crc;
+} scene_t;
+
+static uint32_t cmd_buffer[CMD_BUFFER_SIZE];
+static uint32_t scene_data[SCENE_WIDTH * SCENE_HEIGHT];
+static uint32_t texture_data[32 * 32];
+static const gfx_surface_t texture = {texture_data, 32 * 4, 32, 32, GFX_FORMAT_ARGB8888, NULL, 0};
+
+/**
+ * @brief   ɫˢ
+ * @param   color: ɫARGB8888
+ * @retval  ˢ
+ */
+static gfx_paint_t paint_solid(uint32_t color)
+{
+    gfx_paint_t paint = {GFX_PAINT_SOLID, color, 0, 0, 0, 0, 0};
+
+    return paint;
+}
+
+/**
+ * @brief   仭ˢ
+ * @param   type: ˢ
+ * @param   color0, color1: ɫ
+ * @param   x0, y0, x1, y1: βأ
+ * @retval  ˢ
+ */
+static gfx_paint_t paint_gradient(uint8_t type, uint32_t color0, uint32_t color1, double x0, double y0, double x1, double y1)
+{
+    gfx_paint_t paint = {type, color0, color1, (int32_t)lround(x0 * 16), (int32_t)lround(y0 * 16), (int32_t)lround(x1 * 16),
+                         (int32_t)lround(y1 * 16)};
+
+    return paint;
+}
+
+/**
+ * @brief   Բ4αߣ
+ * @param   list: б
+ * @param   cx, cy, r: Բ뾶أ
+ * @retval  
+ */
+static void path_circle(gfx_cmd_list_t *list, double cx, double cy, double r)
+{
+    int32_t x = (int32_t)lround(cx * 16);
+    int32_t y = (int32_t)lround(cy * 16);
+    int32_t rr = (int32_t)lround(r * 16);
+    int32_t k = (int32_t)lround(r * 16 * 0.5522847);
+
+    gfx_cmd_move_to(list, x + rr, y);
+    gfx_cmd_cubic_to(list, x + rr, y + k, x + k, y + rr, x, y + rr);
+    gfx_cmd_cubic_to(list, x - k, y + rr, x - rr, y + k, x - rr, y);
+    gfx_cmd_cubic_to(list, x - rr, y - k, x - k, y - rr, x, y - rr);
+    gfx_cmd_cubic_to(list, x + k, y - rr, x + rr, y - k, x + rr, y);
+    gfx_cmd_close(list);
+}
+
+/**
+ * @brief   ǣһʻεĻΪ2
+ * @param   list: б
+ * @param   cx, cy, r: Բ뾶أ
+ * @retval  
+ */
+static void path_star(gfx_cmd_list_t *list, double cx, double cy, double r)
+{
+    double angle;
+    uint32_t i;
+
+    for (i = 0; i < 5; i++)
+    {
+        angle = -M_PI / 2 + i * 4 * M_PI / 5;
+        if (i == 0)
+        {
+            gfx_cmd_move_to(list, (int32_t)lround((cx + r * cos(angle)) * 16), (int32_t)lround((cy + r * sin(angle)) * 16));
+        }
+        else
+        {
+            gfx_cmd_line_to(list, (int32_t)lround((cx + r * cos(angle)) * 16), (int32_t)lround((cy + r * sin(angle)) * 16));
+        }
+    }
+    gfx_cmd_close(list);
+}
+
+/**
+ * @brief   ԲǾ
+ */
+static void scene_round_rect(gfx_cmd_list_t *list)
+{
+    gfx_paint_t paint = paint_solid(0xFF202830);
+
+    gfx_cmd_rect(list, 0, 0, SCENE_WIDTH, SCENE_HEIGHT, &paint);
+    paint = paint_solid(0xFF3070C0);
+    gfx_cmd_round_rect(list, GFX_CMD_FIXED(10), GFX_CMD_FIXED(10), GFX_CMD_FIXED(120), GFX_CMD_FIXED(60), GFX_CMD_FIXED(12), &paint);
+    paint = paint_solid(0xC0F0A020);
+    gfx_cmd_round_rect(list, 1203, 377, 1650, 1100, 300, &paint);
+    paint = paint_solid(0x80FFFFFF);
+    gfx_cmd_round_rect(list, GFX_CMD_FIXED(20), GFX_CMD_FIXED(100), GFX_CMD_FIXED(200), GFX_CMD_FIXED(40), GFX_CMD_FIXED(100), &paint);
+    paint = paint_solid(0xFF40D060);
+    gfx_cmd_round_rect(list, 136, 1208, 520, 200, 40, &paint);
+}
+
+/**
+ * @brief   Բ뾶򽥱
+ */
+static void scene_circle(gfx_cmd_list_t *list)
+{
+    gfx_paint_t paint = paint_solid(0xFF000000);
+
+    gfx_cmd_rect(list, 0, 0, SCENE_WIDTH, SCENE_HEIGHT, &paint);
+    paint = paint_gradient(GFX_PAINT_RADIAL, 0xFFFFFFFF, 0xFF2040A0, 70, 70, 60, 0);
+    gfx_cmd_path_begin(list, GFX_FILL_NONZERO, &paint);
+    path_circle(list, 80, 80, 60);
+    gfx_cmd_path_end(list);
+    paint = paint_gradient(GFX_PAINT_RADIAL, 0xFFFF4000, 0x00FF4000, 180.25, 60.5, 40, 0);
+    gfx_cmd_path_begin(list, GFX_FILL_NONZERO, &paint);
+    path_circle(list, 180.25, 60.5, 40);
+    gfx_cmd_path_end(list);
+    paint = paint_solid(0xFFE0E0E0);
+    gfx_cmd_path_begin(list, GFX_FILL_NONZERO, &paint);
+    path_circle(list, 200.5, 135.3, 1.7);
+    gfx_cmd_path_end(list);
+}
+
+/**
+ * @brief   ǣż
+ */
+static void scene_star(gfx_cmd_list_t *list)
+{
+    gfx_paint_t paint = paint_solid(0xFFFFFFFF);
+
+    gfx_cmd_rect(list, 0, 0, SCENE_WIDTH, SCENE_HEIGHT, &paint);
+    paint = paint_solid(0xFFD02020);
+    gfx_cmd_path_begin(list, GFX_FILL_NONZERO, &paint);
+    path_star(list, 60, 80, 55);
+    gfx_cmd_path_end(list);
+    gfx_cmd_path_begin(list, GFX_FILL_EVENODD, &paint);
+    path_star(list, 180, 80, 55);
+    gfx_cmd_path_end(list);
+}
+
+/**
+ * @brief   Խ
+ */
+static void scene_gradient(gfx_cmd_list_t *list)
+{
+    gfx_paint_t paint = paint_gradient(GFX_PAINT_LINEAR, 0xFF000000, 0xFFFFFFFF, 0.5, 0, 239.5, 0);
+
+    gfx_cmd_rect(list, 0, 0, SCENE_WIDTH, 40, &paint);
+    paint = paint_gradient(GFX_PAINT_LINEAR, 0xFFFF0000, 0xFF0000FF, 0, 40, 240, 160);
+    gfx_cmd_rect(list, 0, 40, SCENE_WIDTH, 120, &paint);
+    paint = paint_gradient(GFX_PAINT_LINEAR, 0xE0FFFF00, 0x2000FFFF, 20, 0, 220, 0);
+    gfx_cmd_path_begin(list, GFX_FILL_NONZERO, &paint);
+    gfx_cmd_move_to(list, GFX_CMD_FIXED(20), GFX_CMD_FIXED(150));
+    gfx_cmd_quad_to(list, GFX_CMD_FIXED(120), GFX_CMD_FIXED(-40), GFX_CMD_FIXED(220), GFX_CMD_FIXED(150));
+    gfx_cmd_quad_to(list, GFX_CMD_FIXED(120), GFX_CMD_FIXED(60), GFX_CMD_FIXED(20), GFX_CMD_FIXED(150));
+    gfx_cmd_path_end(list);
+}
+
+/**
+ * @brief   ıΣתš˫ԡ͸
+ */
+static void scene_quad(gfx_cmd_list_t *list)
+{
+    gfx_paint_t paint = paint_solid(0xFF406040);
+    int32_t matrix[6];
+
+    gfx_cmd_rect(list, 0, 0, SCENE_WIDTH, SCENE_HEIGHT, &paint);
+    gfx_cmd_matrix(matrix, 0, GFX_CMD_ONE, GFX_CMD_FIXED(4), GFX_CMD_FIXED(4), 0, 0);
+    gfx_cmd_quad(list, &texture, matrix, 0xFF, GFX_FILTER_NEAREST);
+    gfx_cmd_matrix(matrix, 4096 / 12, GFX_CMD_ONE * 3 / 2, GFX_CMD_FIXED(90), GFX_CMD_FIXED(80), GFX_CMD_FIXED(16), GFX_CMD_FIXED(16));
+    gfx_cmd_quad(list, &texture, matrix, 0xFF, GFX_FILTER_BILINEAR);
+    gfx_cmd_matrix(matrix, -700, GFX_CMD_ONE * 5 / 2, GFX_CMD_FIXED(180), GFX_CMD_FIXED(90), GFX_CMD_FIXED(16), GFX_CMD_FIXED(16));
+    gfx_cmd_quad(list, &texture, matrix, 0xA0, GFX_FILTER_NEAREST);
+    gfx_cmd_matrix(matrix, 100, GFX_CMD_ONE / 3, 3000, 2200, 0, 0);
+    gfx_cmd_quad(list, &texture, matrix, 0xFF, GFX_FILTER_BILINEAR);
+}
+
+/**
+ * @brief   ü
+ */
+static void scene_clip(gfx_cmd_list_t *list)
+{
+    gfx_paint_t paint = paint_solid(0xFF101010);
+
+    gfx_cmd_rect(list, 0, 0, SCENE_WIDTH, SCENE_HEIGHT, &paint);
+    gfx_cmd_clip(list, 30, 20, 100, 90);
+    paint = paint_gradient(GFX_PAINT_RADIAL, 0xFFFFFF00, 0xFF800080, 120, 80, 100, 0);
+    gfx_cmd_path_begin(list, GFX_FILL_NONZERO, &paint);
+    path_circle(list, 120, 80, 100);
+    gfx_cmd_path_end(list);
+    gfx_cmd_clip(list, 150, -10, 500, 500);
+    paint = paint_solid(0xC000C0FF);
+    gfx_cmd_round_rect(list, GFX_CMD_FIXED(100), GFX_CMD_FIXED(30), GFX_CMD_FIXED(200), GFX_CMD_FIXED(100), GFX_CMD_FIXED(30), &paint);
+}
+
+static scene_t scenes[] = {
+    {"round_rect",  GFX_FORMAT_RGB565,      scene_round_rect,   0xF120E1A3},
+    {"circle",      GFX_FORMAT_ARGB8888,    scene_circle,       0x69756874},
+    {"star",        GFX_FORMAT_RGB565,      scene_star,         0xB51D2EB4},
+    {"gradient",    GFX_FORMAT_ARGB8888,    scene_gradient,     0xA010C878},
+    {"quad",        GFX_FORMAT_RGB565,      scene_quad,         0x7B4B82EB},
+    {"clip",        GFX_FORMAT_ARGB8888,    scene_clip,         0x452DD9D2},
+};
+
+/**
+ * @brief   CRC32IEEE 802.3
+ * @param   data: 
+ * @param   size: ֽ
+ * @retval  CRC
+ */
+static uint32_t test_crc32(const void *data, uint32_t size)
+{
+    const uint8_t *p = data;
+    uint32_t crc = 0xFFFFFFFF;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < size; i++)
+    {
+        crc ^= p[i];
+        for (j = 0; j < 8; j++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+/**
+ * @brief   ʼ
+ * @param   surface: ͼ
+ * @param   format: ظʽ
+ * @param   width, height: 
+ * @retval  
+ */
+static void test_surface(gfx_surface_t *surface, uint8_t format, uint16_t width, uint16_t height)
+{
+    surface->data = scene_data;
+    surface->pitch = width * ((format == GFX_FORMAT_RGB565) ? 2 : 4);
+    surface->width = width;
+    surface->height = height;
+    surface->format = format;
+    surface->clut = NULL;
+    surface->color = 0;
+    memset(scene_data, 0, sizeof(scene_data));
+}
+
+/**
+ * @brief   ȡأARGB8888
+ * @param   surface: ͼ
+ * @param   x, y: 
+ * @retval  ɫ
+ */
+static uint32_t test_pixel(const gfx_surface_t *surface, int32_t x, int32_t y)
+{
+    const uint8_t *line = (const uint8_t *)surface->data + y * surface->pitch;
+
+    if (surface->format == GFX_FORMAT_RGB565)
+    {
+        return gfx_soft_from_rgb565(((const uint16_t *)line)[x]);
+    }
+
+    return ((const uint32_t *)line)[x];
+}
+
+/**
+ * @brief   PPMͼ
+ * @param   surface: ͼ
+ * @param   name: ļչ
+ * @retval  
+ */
+static void test_write_ppm(const gfx_surface_t *surface, const char *name)
+{
+    char path[64];
+    uint32_t pixel;
+    FILE *file;
+    int32_t x;
+    int32_t y;
+
+    snprintf(path, sizeof(path), "%s.ppm", name);
+    file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return;
+    }
+
+    fprintf(file, "P6\n%u %u\n255\n", surface->width, surface->height);
+    for (y = 0; y < surface->height; y++)
+    {
+        for (x = 0; x < surface->width; x++)
+        {
+            pixel = test_pixel(surface, x, y);
+            fputc((pixel >> 16) & 0xFF, file);
+            fputc((pixel >> 8) & 0xFF, file);
+            fputc(pixel & 0xFF, file);
+        }
+    }
+    fclose(file);
+}
+
+/**
+ * @brief   ɲ̸ӽ䣬Ͻǰ͸
+ * @param   
+ * @retval  
+ */
+static void test_texture(void)
+{
+    uint32_t alpha;
+    uint32_t x;
+    uint32_t y;
+
+    for (y = 0; y < 32; y++)
+    {
+        for (x = 0; x < 32; x++)
+        {
+            alpha = ((x < 8) && (y < 8)) ? 0x60 : 0xFF;
+            texture_data[y * 32 + x] = ((((x / 4) + (y / 4)) & 1) != 0) ? GFX_ARGB(alpha, x * 8, y * 8, 0xC0)
+                                                                     : GFX_ARGB(alpha, 0xF0, 0xF0, (x + y) * 4);
+        }
+    }
+}
+
+/**
+ * @brief   飺
+ * @param   
+ * @retval  ʧ
+ */
+static int test_analytic(void)
+{
+    gfx_cmd_list_t list;
+    gfx_surface_t dst;
+    gfx_paint_t paint;
+    uint32_t small_buffer[24];
+    int32_t matrix[6];
+    double sum;
+    double area;
+    uint32_t pixel;
+    uint32_t used;
+    int32_t x;
+    int32_t y;
+    int failures = 0;
+    int failed;
+
+    gfx_cmd_init(&list, cmd_buffer, CMD_BUFFER_SIZE);
+
+    /* Բ֮С0.5% */
+    test_surface(&dst, GFX_FORMAT_ARGB8888, SCENE_WIDTH, SCENE_HEIGHT);
+    paint = paint_solid(0xFFFFFFFF);
+    gfx_cmd_path_begin(&list, GFX_FILL_NONZERO, &paint);
+    path_circle(&list, 100.3, 80.6, 55.5);
+    gfx_cmd_path_end(&list);
+    gfx_cmd_render(&list, &dst);
+    sum = 0;
+    for (y = 0; y < SCENE_HEIGHT; y++)
+    {
+        for (x = 0; x < SCENE_WIDTH; x++)
+        {
+            sum += (test_pixel(&dst, x, y) >> 24) / 255.0;
+        }
+    }
+    area = M_PI * 55.5 * 55.5;
+    failed = fabs(sum - area) > (area * 0.005);
+    printf("circle area: %.1f / %.1f (%+.3f%%) %s\n", sum, area, (sum - area) * 100 / area, failed ? "FAIL" : "ok");
+    failures += failed;
+
+    /* رߣ1281ڲ255ⲿ0 */
+    test_surface(&dst, GFX_FORMAT_ARGB8888, SCENE_WIDTH, SCENE_HEIGHT);
+    gfx_cmd_reset(&list);
+    gfx_cmd_path_begin(&list, GFX_FILL_NONZERO, &paint);
+    gfx_cmd_move_to(&list, 168, GFX_CMD_FIXED(10));
+    gfx_cmd_line_to(&list, 328, GFX_CMD_FIXED(10));
+    gfx_cmd_line_to(&list, 328, GFX_CMD_FIXED(20));
+    gfx_cmd_line_to(&list, 168, GFX_CMD_FIXED(20));
+    gfx_cmd_path_end(&list);
+    gfx_cmd_render(&list, &dst);
+    failed = (abs((int32_t)(test_pixel(&dst, 10, 15) >> 24) - 128) > 1) || (abs((int32_t)(test_pixel(&dst, 20, 15) >> 24) - 128) > 1) ||
+             ((test_pixel(&dst, 15, 15) >> 24) != 0xFF) || (test_pixel(&dst, 9, 15) != 0) || (test_pixel(&dst, 21, 15) != 0) ||
+             ((test_pixel(&dst, 15, 10) >> 24) != 0xFF) || (test_pixel(&dst, 15, 9) != 0) || (test_pixel(&dst, 15, 20) != 0);
+    printf("half pixel edge: %u, %u %s\n", test_pixel(&dst, 10, 15) >> 24, test_pixel(&dst, 20, 15) >> 24, failed ? "FAIL" : "ok");
+    failures += failed;
+
+    /* Խ䣺ڶ˵ϵصڶ˵ɫ */
+    test_surface(&dst, GFX_FORMAT_ARGB8888, SCENE_WIDTH, SCENE_HEIGHT);
+    gfx_cmd_reset(&list);
+    paint = paint_gradient(GFX_PAINT_LINEAR, 0xFF10E040, 0x80F02000, 20.5, 0, 219.5, 0);
+    gfx_cmd_rect(&list, 0, 0, SCENE_WIDTH, 4, &paint);
+    gfx_cmd_render(&list, &dst);
+    failed = (test_pixel(&dst, 0, 0) != 0xFF10E040) || (test_pixel(&dst, 20, 1) != 0xFF10E040) ||
+             (test_pixel(&dst, 219, 2) != 0x80F02000) || (test_pixel(&dst, 239, 3) != 0x80F02000);
+    printf("linear gradient: %08X %08X %08X %s\n", test_pixel(&dst, 20, 0), test_pixel(&dst, 119, 0), test_pixel(&dst, 219, 0),
+           failed ? "FAIL" : "ok");
+    failures += failed;
+
+    /* ǣη䣬ż */
+    test_surface(&dst, GFX_FORMAT_RGB565, SCENE_WIDTH, SCENE_HEIGHT);
+    gfx_cmd_reset(&list);
+    scene_star(&list);
+    gfx_cmd_render(&list, &dst);
+    failed = ((test_pixel(&dst, 60, 80) & 0xFFFFFF) != 0xD62021) || ((test_pixel(&dst, 180, 80) & 0xFFFFFF) != 0xFFFFFF) ||
+             ((test_pixel(&dst, 60, 35) & 0xFFFFFF) != 0xD62021) || ((test_pixel(&dst, 180, 35) & 0xFFFFFF) != 0xD62021);
+    printf("star fill rules: %s\n", failed ? "FAIL" : "ok");
+    failures += failed;
+
+    /* ıΣƽԭȣֹ˷ʽ90תΪת */
+    test_surface(&dst, GFX_FORMAT_ARGB8888, SCENE_WIDTH, SCENE_HEIGHT);
+    gfx_cmd_reset(&list);
+    gfx_cmd_matrix(matrix, 0, GFX_CMD_ONE, GFX_CMD_FIXED(10), GFX_CMD_FIXED(20), 0, 0);
+    gfx_cmd_quad(&list, &texture, matrix, 0xFF, GFX_FILTER_NEAREST);
+    gfx_cmd_matrix(matrix, 0, GFX_CMD_ONE, GFX_CMD_FIXED(50), GFX_CMD_FIXED(20), 0, 0);
+    gfx_cmd_quad(&list, &texture, matrix, 0xFF, GFX_FILTER_BILINEAR);
+    gfx_cmd_matrix(matrix, 1024, GFX_CMD_ONE, GFX_CMD_FIXED(140), GFX_CMD_FIXED(20), 0, 0);
+    gfx_cmd_quad(&list, &texture, matrix, 0xFF, GFX_FILTER_NEAREST);
+    gfx_cmd_render(&list, &dst);
+    failed = 0;
+    for (y = 0; y < 32; y++)
+    {
+        for (x = 0; x < 32; x++)
+        {
+            /* ͸ػϵ͸ɫ */
+            pixel = gfx_soft_blend(texture_data[y * 32 + x], 0);
+            failed |= (test_pixel(&dst, 10 + x, 20 + y) != pixel) || (test_pixel(&dst, 50 + x, 20 + y) != pixel);
+            /* ˳ʱ90: Ļ(140 - 1 - v, 20 + u) */
+            failed |= (test_pixel(&dst, 139 - y, 20 + x) != pixel);
+        }
+    }
+    failed |= (test_pixel(&dst, 9, 20) != 0) || (test_pixel(&dst, 42, 20) != 0) || (test_pixel(&dst, 82, 20) != 0) ||
+              (test_pixel(&dst, 107, 20) != 0) || (test_pixel(&dst, 140, 20) != 0) || (test_pixel(&dst, 80, 52) != 0);
+    printf("texture quad exact: %s\n", failed ? "FAIL" : "ok");
+    failures += failed;
+
+    /* üüز */
+    test_surface(&dst, GFX_FORMAT_ARGB8888, SCENE_WIDTH, SCENE_HEIGHT);
+    gfx_cmd_reset(&list);
+    paint = paint_solid(0xFFFFFFFF);
+    gfx_cmd_clip(&list, 30, 20, 100, 90);
+    gfx_cmd_rect(&list, 0, 0, SCENE_WIDTH, SCENE_HEIGHT, &paint);
+    gfx_cmd_path_begin(&list, GFX_FILL_NONZERO, &paint);
+    path_circle(&list, 120, 80, 100);
+    gfx_cmd_path_end(&list);
+    gfx_cmd_render(&list, &dst);
+    failed = 0;
+    for (y = 0; y < SCENE_HEIGHT; y++)
+    {
+        for (x = 0; x < SCENE_WIDTH; x++)
+        {
+            failed |= (test_pixel(&dst, x, y) != (((x >= 30) && (x < 130) && (y >= 20) && (y < 110)) ? 0xFFFFFFFF : 0));
+        }
+    }
+    printf("clip: %s\n", failed ? "FAIL" : "ok");
+    failures += failed;
+
+    /* 㣺δɵ·֮ǰ */
+    gfx_cmd_init(&list, small_buffer, sizeof(small_buffer) / sizeof(small_buffer[0]));
+    failed = gfx_cmd_rect(&list, 0, 0, 10, 10, &paint);
+    used = list.used;
+    failed |= gfx_cmd_path_begin(&list, GFX_FILL_NONZERO, &paint);
+    failed |= gfx_cmd_line_to(&list, 0, 0);
+    failed |= (gfx_cmd_move_to(&list, 0, 0) == 0) || (list.used != used) || (list.count != 1) || (list.error == 0);
+    failed |= (gfx_cmd_path_end(&list) == 0) || (gfx_cmd_rect(&list, 0, 0, 1, 1, &paint) == 0);
+    gfx_cmd_reset(&list);
+    failed |= (gfx_cmd_rect(&list, 0, 0, 70000, 1, &paint) == 0) || (list.error == 0);
+    gfx_cmd_reset(&list);
+    memset(matrix, 0, sizeof(matrix));
+    failed |= (gfx_cmd_quad(&list, &texture, matrix, 0xFF, GFX_FILTER_NEAREST) == 0);
+    printf("list errors: %s\n", failed ? "FAIL" : "ok");
+    failures += failed;
+
+    return failures;
+}
+
+/**
+ * @brief   Ⱦ
+ * @param   scene: 
+ * @param   list: б
+ * @param   dst: Ŀ
+ * @retval  
+ */
+static void test_scene_render(const scene_t *scene, gfx_cmd_list_t *list, gfx_surface_t *dst)
+{
+    gfx_cmd_init(list, cmd_buffer, CMD_BUFFER_SIZE);
+    scene->build(list);
+    test_surface(dst, scene->format, SCENE_WIDTH, SCENE_HEIGHT);
+    gfx_cmd_render(list, dst);
+}
+
+/**
+ * @brief   飺golden CRC
+ * @param   update: 1: ӡµgolden
+ * @param   write: 1: PPMͼ
+ * @retval  ʧ
+ */
+static int test_scenes(int update, int write)
+{
+    gfx_cmd_list_t list;
+    gfx_surface_t dst;
+    uint32_t crc;
+    uint32_t i;
+    int failures = 0;
+
+    for (i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++)
+    {
+        test_scene_render(&scenes[i], &list, &dst);
+        crc = test_crc32(scene_data, dst.pitch * dst.height);
+
+        if (write != 0)
+        {
+            test_write_ppm(&dst, scenes[i].name);
+        }
+        if (update != 0)
+        {
+            printf("    {\"%s\", ..., 0x%08X},\n", scenes[i].name, crc);
+            continue;
+        }
+
+        printf("scene %-12s %3u cmds %5u words crc %08X %s\n", scenes[i].name, list.count, list.used, crc,
+               ((crc == scenes[i].crc) && (list.error == 0)) ? "ok" : "FAIL");
+        failures += (crc != scenes[i].crc) || (list.error != 0);
+    }
+
+    return failures;
+}
+
+/**
+ * @brief   ȡǰʱ
+ * @param   
+ * @retval  
+ */
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief   CPUȾʱ
+ * @param   
+ * @retval  
+ */
+static void bench(void)
+{
+    gfx_cmd_list_t list;
+    gfx_surface_t dst;
+    double start;
+    double elapsed;
+    uint32_t count;
+    uint32_t i;
+
+    printf("%-12s %10s %12s\n", "scene", "ms/frame", "Mpix/s");
+    for (i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++)
+    {
+        test_scene_render(&scenes[i], &list, &dst);
+        count = 0;
+        start = bench_now();
+        do
+        {
+            gfx_cmd_render(&list, &dst);
+            count++;
+            elapsed = bench_now() - start;
+        } while (elapsed < BENCH_MIN_TIME);
+
+        printf("%-12s %10.3f %12.1f\n", scenes[i].name, elapsed * 1e3 / count, (double)SCENE_WIDTH * SCENE_HEIGHT * count / elapsed / 1e6);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int run_bench = 0;
+    int update = 0;
+    int write = 0;
+    int failures;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "buw")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+            {
+                run_bench = 1;
+                break;
+            }
+            case 'u':
+            {
+                update = 1;
+                break;
+            }
+            case 'w':
+            {
+                write = 1;
+                break;
+            }
+            default:
+            {
+                fprintf(stderr, "usage: %s [-b] [-u] [-w]\n", argv[0]);
+                return 2;
+            }
+        }
+    }
+
+    test_texture();
+
+    if (run_bench != 0)
+    {
+        bench();
+        return 0;
+    }
+
+    if (update != 0)
+    {
+        return test_scenes(1, write);
+    }
+
+    failures = test_analytic();
+    failures += test_scenes(0, write);
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,312 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_dirty_replay.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       θ¼¼ط
+ ****************************************************************************************************
+ * @attention
+ *
+ * ȼϲüƵļ̶֡طŽ¼¼tracesĿ¼µ.traceļ
+ * ÿ֡Ѽ¼еľμgfx_dirtygfx_dirty_frame()ľģǰ󻺳ϸơػ桢ҳ
+ * ÿرݰ汾ţҳǰ볡ȫһ£󱨸ֽػȽʡĴ
+ *
+ * ¼ʽÿһ#ͷΪעͣ:
+ *   screen <> <> <ÿֽ>    һ
+ *   frame                               ʼһ֡rectڸ֡
+ *   rect <x> <y> <> <>              仯
+ *   idle <֡>                         ûб仯֡
+ *
+ * ÷: gfx_dirty_replay trace...
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfx_dirty.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ģ֡ */
+static uint32_t *replay_scene = NULL;       /* ÿصݰ汾 */
+static uint32_t *replay_buffer[2] = {NULL}; /* ǰ󻺳ÿصݰ汾 */
+static uint32_t replay_front = 0;
+static uint32_t replay_width = 0;
+static uint32_t replay_height = 0;
+
+/**
+ * @brief   ģĻ֮临ƾ
+ * @param   dst, src: 
+ * @param   rect: 
+ * @retval  
+ */
+static void replay_copy(uint32_t *dst, const uint32_t *src, const gfx_rect_t *rect)
+{
+    int32_t y;
+
+    for (y = rect->y; y < (rect->y + rect->height); y++)
+    {
+        memcpy(&dst[y * replay_width + rect->x], &src[y * replay_width + rect->x], rect->width * sizeof(uint32_t));
+    }
+}
+
+/**
+ * @brief   ³һݰ汾
+ * @param   x, y, width, height: 򣨿ɳĻ
+ * @param   version: 汾
+ * @retval  
+ */
+static void replay_touch(int32_t x, int32_t y, int32_t width, int32_t height, uint32_t version)
+{
+    int32_t i;
+    int32_t j;
+
+    for (j = (y < 0) ? 0 : y; (j < (y + height)) && (j < (int32_t)replay_height); j++)
+    {
+        for (i = (x < 0) ? 0 : x; (i < (x + width)) && (i < (int32_t)replay_width); i++)
+        {
+            replay_scene[j * replay_width + i] = version;
+        }
+    }
+}
+
+/**
+ * @brief   ϳһ֡ǰ
+ * @param   dirty: θٽṹָ
+ * @retval  0: һ; 1: ǰ볡һ
+ */
+static int replay_frame(gfx_dirty_t *dirty)
+{
+    gfx_rect_t copy[GFX_DIRTY_RECT_NUM];
+    gfx_rect_t render[GFX_DIRTY_RECT_NUM];
+    uint32_t copy_num;
+    uint32_t render_num;
+    uint32_t *back = replay_buffer[replay_front ^ 1];
+    uint32_t i;
+
+    gfx_dirty_frame(dirty, copy, &copy_num, render, &render_num);
+    if (render_num != 0)
+    {
+        for (i = 0; i < copy_num; i++)
+        {
+            replay_copy(back, replay_buffer[replay_front], &copy[i]);
+        }
+        for (i = 0; i < render_num; i++)
+        {
+            replay_copy(back, replay_scene, &render[i]);
+        }
+        replay_front ^= 1;
+    }
+
+    return memcmp(replay_buffer[replay_front], replay_scene, replay_width * replay_height * sizeof(uint32_t)) != 0;
+}
+
+/**
+ * @brief   طһ¼¼
+ * @param   path: ¼ļ·
+ * @param   total: ۼͳ
+ * @retval  ʧ
+ */
+static int replay_trace(const char *path, gfx_dirty_stats_t *total)
+{
+    FILE *file = fopen(path, "r");
+    gfx_dirty_t dirty;
+    char line[128];
+    const char *name;
+    uint32_t pixel_size = 0;
+    uint32_t version = 1;
+    uint32_t lineno = 0;
+    uint32_t in_frame = 0;
+    int32_t x;
+    int32_t y;
+    int32_t w;
+    int32_t h;
+    int count;
+    int failures = 0;
+
+    if (file == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+
+    while ((failures == 0) && (fgets(line, sizeof(line), file) != NULL))
+    {
+        lineno++;
+        if ((line[0] == '#') || (line[0] == '\n'))
+        {
+            continue;
+        }
+
+        if (sscanf(line, "screen %d %d %u", &w, &h, &pixel_size) == 3)
+        {
+            replay_width = (uint32_t)w;
+            replay_height = (uint32_t)h;
+            replay_scene = calloc(replay_width * replay_height, sizeof(uint32_t));
+            replay_buffer[0] = calloc(replay_width * replay_height, sizeof(uint32_t));
+            replay_buffer[1] = calloc(replay_width * replay_height, sizeof(uint32_t));
+            replay_front = 0;
+            gfx_dirty_init(&dirty, (uint16_t)w, (uint16_t)h, (uint8_t)pixel_size);
+
+            /* ȶ״̬ʼʾ볡һ£ûй */
+            replay_touch(0, 0, w, h, version);
+            memcpy(replay_buffer[0], replay_scene, replay_width * replay_height * sizeof(uint32_t));
+            memcpy(replay_buffer[1], replay_scene, replay_width * replay_height * sizeof(uint32_t));
+            continue;
+        }
+        if (replay_scene == NULL)
+        {
+            fprintf(stderr, "%s:%u: screen line expected\n", path, (unsigned int)lineno);
+            failures++;
+            break;
+        }
+
+        if (strncmp(line, "frame", 5) == 0)
+        {
+            if (in_frame != 0)
+            {
+                failures += replay_frame(&dirty);
+            }
+            in_frame = 1;
+            version++;
+        }
+        else if (sscanf(line, "rect %d %d %d %d", &x, &y, &w, &h) == 4)
+        {
+            replay_touch(x, y, w, h, version);
+            gfx_dirty_add(&dirty, x, y, w, h);
+        }
+        else if (sscanf(line, "idle %d", &count) == 1)
+        {
+            if (in_frame != 0)
+            {
+                failures += replay_frame(&dirty);
+                in_frame = 0;
+            }
+            while ((count-- > 0) && (failures == 0))
+            {
+                failures += replay_frame(&dirty);
+            }
+        }
+        else
+        {
+            fprintf(stderr, "%s:%u: bad line: %s", path, (unsigned int)lineno, line);
+            failures++;
+        }
+    }
+    if ((in_frame != 0) && (failures == 0))
+    {
+        failures += replay_frame(&dirty);
+    }
+    fclose(file);
+
+    if (replay_scene != NULL)
+    {
+        name = strrchr(path, '/');
+        name = (name != NULL) ? name + 1 : path;
+        printf("%-20s %6u %5u %5u %9.1f %9.1f %9.1f %7.1f%%%s\n", name, (unsigned int)dirty.stats.frames,
+               (unsigned int)dirty.stats.idle_frames, (unsigned int)dirty.stats.full_frames,
+               (double)(dirty.stats.render_bytes + dirty.stats.copy_bytes) / dirty.stats.frames / 1024,
+               dirty.stats.max_bytes / 1024.0, (double)dirty.stats.full_bytes / dirty.stats.frames / 1024,
+               100.0 - 100.0 * (dirty.stats.render_bytes + dirty.stats.copy_bytes) / dirty.stats.full_bytes,
+               (failures != 0) ? "  FAIL (front buffer differs from scene)" : "");
+
+        total->frames += dirty.stats.frames;
+        total->render_bytes += dirty.stats.render_bytes;
+        total->copy_bytes += dirty.stats.copy_bytes;
+        total->full_bytes += dirty.stats.full_bytes;
+        free(replay_scene);
+        free(replay_buffer[0]);
+        free(replay_buffer[1]);
+        replay_scene = NULL;
+    }
+
+    return failures;
+}
+
+/**
+ * @brief   ϲü
+ * @param   
+ * @retval  ʧ
+ */
+static int test_cases(void)
+{
+    gfx_dirty_t dirty;
+    gfx_rect_t copy[GFX_DIRTY_RECT_NUM];
+    gfx_rect_t render[GFX_DIRTY_RECT_NUM];
+    uint32_t copy_num;
+    uint32_t render_num;
+    uint32_t bytes;
+    int32_t i;
+    int failures = 0;
+
+    gfx_dirty_init(&dirty, 800, 480, 2);
+
+    /* üȫĻııض */
+    gfx_dirty_add(&dirty, -50, -50, 40, 40);
+    gfx_dirty_add(&dirty, 800, 0, 10, 10);
+    gfx_dirty_add(&dirty, 790, 470, 100, 100);
+    failures += (dirty.count != 1) || (dirty.rects[0].x != 790) || (dirty.rects[0].width != 10) || (dirty.rects[0].height != 10);
+
+    /* ľβӣڵľκϲԶľα */
+    gfx_dirty_add(&dirty, 792, 472, 4, 4);
+    gfx_dirty_add(&dirty, 0, 0, 100, 20);
+    gfx_dirty_add(&dirty, 100, 0, 100, 20);
+    failures += (dirty.count != 2) || (gfx_dirty_area(&dirty) != (100 + 200 * 20));
+
+    /* һ֡ûйֻػ */
+    bytes = gfx_dirty_frame(&dirty, copy, &copy_num, render, &render_num);
+    failures += (copy_num != 0) || (render_num != 2) || (bytes != (4100 * 2));
+
+    /* ڶ֡һ֡򱻸ƣ֡ȫǵĲ */
+    gfx_dirty_add(&dirty, 0, 0, 300, 30);
+    bytes = gfx_dirty_frame(&dirty, copy, &copy_num, render, &render_num);
+    failures += (copy_num != 1) || (copy[0].x != 790) || (render_num != 1) || (bytes != ((100 * 2 + 9000) * 2));
+
+    /* ûб仯֡ */
+    bytes = gfx_dirty_frame(&dirty, copy, &copy_num, render, &render_num);
+    failures += (bytes != 0) || (render_num != 0) || (dirty.stats.idle_frames != 1);
+
+    /* ﵽʱϲʧ */
+    for (i = 0; i < (GFX_DIRTY_RECT_NUM + 8); i++)
+    {
+        gfx_dirty_add(&dirty, (i % 6) * 130, (i / 6) * 100, 10, 10);
+    }
+    failures += (dirty.count > GFX_DIRTY_RECT_NUM) || (gfx_dirty_area(&dirty) < ((GFX_DIRTY_RECT_NUM + 8) * 100));
+
+    /* ֵʱػ */
+    gfx_dirty_frame(&dirty, copy, &copy_num, render, &render_num);
+    gfx_dirty_add(&dirty, 0, 0, 800, 200);
+    gfx_dirty_add(&dirty, 0, 240, 800, 200);
+    gfx_dirty_frame(&dirty, copy, &copy_num, render, &render_num);
+    failures += (render_num != 1) || (render[0].width != 800) || (render[0].height != 480) || (copy_num != 0);
+
+    printf("dirty rect cases: %s\n", (failures == 0) ? "ok" : "FAIL");
+
+    return failures;
+}
+
+int main(int argc, char *argv[])
+{
+    gfx_dirty_stats_t total = {0};
+    int failures;
+    int i;
+
+    failures = test_cases();
+
+    printf("\n%-20s %6s %5s %5s %9s %9s %9s %8s\n", "trace", "frames", "idle", "full", "KB/frame", "max KB", "full KB", "saved");
+    for (i = 1; i < argc; i++)
+    {
+        failures += replay_trace(argv[i], &total);
+    }
+    if (total.frames != 0)
+    {
+        printf("%-20s %6u %23.1f %9s %9.1f %7.1f%%\n", "total", (unsigned int)total.frames,
+               (double)(total.render_bytes + total.copy_bytes) / total.frames / 1024, "",
+               (double)total.full_bytes / total.frames / 1024,
+               100.0 - 100.0 * (total.render_bytes + total.copy_bytes) / total.full_bytes);
+    }
+
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,610 @@
+/**
+ ****************************************************************************************************
+ * @file        gfx_test.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       2Dͼοʵ׼
+ ****************************************************************************************************
+ * @attention
+ *
+ * ԣȼֵ//ϲʽߴ硢гȡԽalpha
+ * gfx_soft_execute()Ľ뱾ļждģͣ㡢вüֽڱȽϣ
+ * ĿͼоβֽҲܱд
+ * ׼800x480CPUٶȣ·ؼԱȣDMA2DٶĿgfx_dma2d_test()
+ *
+ * ÷: gfx_test [-b] [-n ] [-s ]
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfx_soft.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Բ */
+#define TEST_MAX_WIDTH          (96)
+#define TEST_MAX_HEIGHT         (64)
+#define TEST_MAX_PAD            (12)
+#define TEST_BUFFER_SIZE        ((TEST_MAX_WIDTH * 4 + TEST_MAX_PAD) * TEST_MAX_HEIGHT)
+
+/* ׼ */
+#define BENCH_WIDTH             (800)
+#define BENCH_HEIGHT            (480)
+#define BENCH_MIN_TIME          (0.2)
+
+static uint32_t test_seed = 1;
+
+/**
+ * @brief   α
+ * @param   range: Χ
+ * @retval  0 ~ range-1
+ */
+static uint32_t test_random(uint32_t range)
+{
+    test_seed = test_seed * 1103515245UL + 12345UL;
+
+    return (test_seed >> 8) % range;
+}
+
+/**
+ * @brief   ģͣȡһزչΪ8λARGB
+ * @note    A4صalphaδɫalpha
+ * @param   surface: ͼ
+ * @param   x, y: 
+ * @param   argb: a, r, g, b
+ * @retval  
+ */
+static void model_read(const gfx_surface_t *surface, int32_t x, int32_t y, double argb[4])
+{
+    const uint8_t *line = (const uint8_t *)surface->data + y * surface->pitch;
+    uint32_t pixel;
+    uint32_t value;
+
+    switch (surface->format)
+    {
+        case GFX_FORMAT_RGB565:
+        {
+            value = line[x * 2] | (line[x * 2 + 1] << 8);
+            /* λƵλDMA2Dչʽ6λɫround(g * 255 / 63)ȫͬ */
+            argb[0] = 255;
+            argb[1] = (((value >> 11) & 0x1F) << 3) | ((value >> 13) & 0x07);
+            argb[2] = (((value >> 5) & 0x3F) << 2) | ((value >> 9) & 0x03);
+            argb[3] = ((value & 0x1F) << 3) | ((value >> 2) & 0x07);
+            return;
+        }
+        case GFX_FORMAT_A4:
+        {
+            value = (x & 1) ? (line[x / 2] >> 4) : (line[x / 2] & 0x0F);
+            argb[0] = value * 17;
+            argb[1] = (surface->color >> 16) & 0xFF;
+            argb[2] = (surface->color >> 8) & 0xFF;
+            argb[3] = surface->color & 0xFF;
+            return;
+        }
+        case GFX_FORMAT_L8:
+        {
+            pixel = surface->clut[line[x]];
+            break;
+        }
+        default:
+        {
+            pixel = line[x * 4] | (line[x * 4 + 1] << 8) | (line[x * 4 + 2] << 16) | ((uint32_t)line[x * 4 + 3] << 24);
+            break;
+        }
+    }
+
+    argb[0] = pixel >> 24;
+    argb[1] = (pixel >> 16) & 0xFF;
+    argb[2] = (pixel >> 8) & 0xFF;
+    argb[3] = pixel & 0xFF;
+}
+
+/**
+ * @brief   ģͣдһ
+ * @param   surface: ͼ棨ARGB8888RGB565
+ * @param   x, y: 
+ * @param   argb: a, r, g, b0~255
+ * @retval  
+ */
+static void model_write(const gfx_surface_t *surface, int32_t x, int32_t y, const double argb[4])
+{
+    uint8_t *line = (uint8_t *)surface->data + y * surface->pitch;
+    uint32_t value;
+
+    if (surface->format == GFX_FORMAT_RGB565)
+    {
+        value = (((uint32_t)argb[1] >> 3) << 11) | (((uint32_t)argb[2] >> 2) << 5) | ((uint32_t)argb[3] >> 3);
+        line[x * 2] = (uint8_t)value;
+        line[x * 2 + 1] = (uint8_t)(value >> 8);
+    }
+    else
+    {
+        line[x * 4] = (uint8_t)argb[3];
+        line[x * 4 + 1] = (uint8_t)argb[2];
+        line[x * 4 + 2] = (uint8_t)argb[1];
+        line[x * 4 + 3] = (uint8_t)argb[0];
+    }
+}
+
+/**
+ * @brief   ģִͣһ
+ * @note    ĿжǷľҶӦԴشڣʹgfx_op_xxx()Ĳü
+ * @param   type: 
+ * @param   dst: Ŀ
+ * @param   x, y, width, height: Ŀ
+ * @param   src: Դ棨ʱΪNULL
+ * @param   sx, sy: ԴϽ
+ * @param   alpha: Դalpha
+ * @param   color: ɫ
+ * @retval  
+ */
+static void model_execute(uint8_t type, const gfx_surface_t *dst, int32_t x, int32_t y, int32_t width, int32_t height,
+                          const gfx_surface_t *src, int32_t sx, int32_t sy, uint8_t alpha, uint32_t color)
+{
+    double f[4];
+    double b[4];
+    double out[4];
+    double mult;
+    double factor = alpha;
+    int32_t dx;
+    int32_t dy;
+    int32_t px;
+    int32_t py;
+    int i;
+
+    /* A4ɫalphaalphaϲΪһDMA2DֻһalphaĴ */
+    if ((src != NULL) && (src->format == GFX_FORMAT_A4))
+    {
+        factor = floor(alpha * (double)(src->color >> 24) / 255.0 + 0.5);
+    }
+
+    for (dy = 0; dy < dst->height; dy++)
+    {
+        for (dx = 0; dx < dst->width; dx++)
+        {
+            if ((dx < x) || (dx >= (x + width)) || (dy < y) || (dy >= (y + height)))
+            {
+                continue;
+            }
+
+            if (type == GFX_OP_FILL)
+            {
+                out[0] = color >> 24;
+                out[1] = (color >> 16) & 0xFF;
+                out[2] = (color >> 8) & 0xFF;
+                out[3] = color & 0xFF;
+                model_write(dst, dx, dy, out);
+                continue;
+            }
+
+            px = sx + (dx - x);
+            py = sy + (dy - y);
+            if ((px < 0) || (py < 0) || (px >= src->width) || (py >= src->height))
+            {
+                continue;
+            }
+
+            model_read(src, px, py, f);
+            f[0] = floor(f[0] * factor / 255.0 + 0.5);
+            if (type == GFX_OP_COPY)
+            {
+                model_write(dst, dx, dy, f);
+                continue;
+            }
+
+            model_read(dst, dx, dy, b);
+            mult = floor(f[0] * b[0] / 255.0 + 0.5);
+            out[0] = f[0] + b[0] - mult;
+            for (i = 1; i < 4; i++)
+            {
+                out[i] = (out[0] == 0) ? 0 : floor((f[i] * f[0] + b[i] * (b[0] - mult)) / out[0] + 0.5);
+            }
+            if (f[0] == 255)
+            {
+                memcpy(out, f, sizeof(out));
+            }
+            else if (f[0] == 0)
+            {
+                memcpy(out, b, sizeof(out));
+            }
+            model_write(dst, dx, dy, out);
+        }
+    }
+}
+
+/**
+ * @brief   ֵ
+ * @param   
+ * @retval  ʧ
+ */
+static int test_golden(void)
+{
+    uint32_t argb[4];
+    uint16_t rgb565[4];
+    uint8_t a4[2] = {0x8F, 0x00};
+    uint8_t l8[2] = {3, 0};
+    uint32_t clut[256] = {0};
+    gfx_surface_t dst_argb = {argb, sizeof(argb), 4, 1, GFX_FORMAT_ARGB8888, NULL, 0};
+    gfx_surface_t dst_rgb565 = {rgb565, sizeof(rgb565), 4, 1, GFX_FORMAT_RGB565, NULL, 0};
+    gfx_surface_t src_argb = {argb, sizeof(argb), 4, 1, GFX_FORMAT_ARGB8888, NULL, 0};
+    gfx_surface_t src_rgb565 = {rgb565, sizeof(rgb565), 4, 1, GFX_FORMAT_RGB565, NULL, 0};
+    gfx_surface_t src_a4 = {a4, sizeof(a4), 4, 1, GFX_FORMAT_A4, NULL, 0xFF00FF00};
+    gfx_surface_t src_l8 = {l8, sizeof(l8), 2, 1, GFX_FORMAT_L8, clut, 0};
+    gfx_op_t op;
+    uint32_t out[4];
+    int failures = 0;
+
+    /* RGB565 -> ARGB8888Ƹλ */
+    rgb565[0] = 0xF800;
+    rgb565[1] = 0x07E0;
+    rgb565[2] = 0x001F;
+    rgb565[3] = 0x8410;
+    dst_argb.data = out;
+    gfx_op_copy(&op, &dst_argb, 0, 0, &src_rgb565, 0, 0, 4, 1);
+    gfx_soft_execute(&op);
+    failures += (out[0] != 0xFFFF0000) || (out[1] != 0xFF00FF00) || (out[2] != 0xFF0000FF) || (out[3] != 0xFF848284);
+
+    /* ARGB8888 -> RGB565ض */
+    argb[0] = 0xFF123456;
+    gfx_op_copy(&op, &dst_rgb565, 1, 0, &src_argb, 0, 0, 1, 1);
+    gfx_soft_execute(&op);
+    failures += (rgb565[1] != 0x11AA);
+
+    /* 50%ɫϵRGB565ɫ */
+    argb[0] = 0x80FFFFFF;
+    rgb565[0] = 0x0000;
+    gfx_op_blend(&op, &dst_rgb565, 0, 0, &src_argb, 0, 0, 1, 1, 0xFF);
+    gfx_soft_execute(&op);
+    failures += (rgb565[0] != 0x8410);
+
+    /* ͸ɫϵ͸ɫARGB8888Ŀ꣩ */
+    out[0] = 0x800000FF;
+    argb[0] = 0x80FF0000;
+    gfx_op_blend(&op, &dst_argb, 0, 0, &src_argb, 0, 0, 1, 1, 0xFF);
+    gfx_soft_execute(&op);
+    failures += (out[0] != 0xC0AA0055);
+
+    /* A44λΪһأalphaչΪa * 17 */
+    gfx_op_copy(&op, &dst_argb, 0, 0, &src_a4, 0, 0, 2, 1);
+    gfx_soft_execute(&op);
+    failures += (out[0] != 0xFF00FF00) || (out[1] != 0x8800FF00);
+
+    /* L8ɫ */
+    clut[3] = 0x40102030;
+    gfx_op_copy(&op, &dst_argb, 2, 0, &src_l8, 0, 0, 1, 1);
+    gfx_soft_execute(&op);
+    failures += (out[2] != 0x40102030);
+
+    /* RGB565alpha */
+    gfx_op_fill(&op, &dst_rgb565, 0, 0, 4, 1, 0x00FFFFFF);
+    gfx_soft_execute(&op);
+    failures += (rgb565[3] != 0xFFFF);
+
+    printf("golden pixels: %s\n", (failures == 0) ? "ok" : "FAIL");
+
+    return failures;
+}
+
+/**
+ * @brief   
+ * @param   surface: ͼ
+ * @param   data: ݻTEST_BUFFER_SIZEֽڣ
+ * @param   format: ظʽ
+ * @param   clut: L8ɫ
+ * @retval  
+ */
+static void test_surface(gfx_surface_t *surface, uint8_t *data, uint8_t format, const uint32_t *clut)
+{
+    uint32_t bits = gfx_format_bits(format);
+    uint32_t i;
+
+    surface->data = data;
+    surface->format = format;
+    surface->width = (uint16_t)(1 + test_random(TEST_MAX_WIDTH));
+    surface->height = (uint16_t)(1 + test_random(TEST_MAX_HEIGHT));
+    surface->pitch = (surface->width * bits + 7) / 8 + test_random(TEST_MAX_PAD / 4 + 1) * 4;
+    surface->clut = clut;
+    surface->color = (test_random(4) == 0) ? 0xFF000000 | test_random(0x01000000) : (test_random(256) << 24) | test_random(0x01000000);
+    for (i = 0; i < TEST_BUFFER_SIZE; i++)
+    {
+        data[i] = (uint8_t)test_random(256);
+    }
+}
+
+/**
+ * @brief   ȶ
+ * @param   iterations: 
+ * @retval  ʧ
+ */
+static int test_random_ops(uint32_t iterations)
+{
+    static const uint8_t src_formats[4] = {GFX_FORMAT_ARGB8888, GFX_FORMAT_RGB565, GFX_FORMAT_L8, GFX_FORMAT_A4};
+    static uint8_t src_data[TEST_BUFFER_SIZE];
+    static uint8_t dst_data[TEST_BUFFER_SIZE];
+    static uint8_t expect_data[TEST_BUFFER_SIZE];
+    static uint32_t clut[256];
+    gfx_surface_t src;
+    gfx_surface_t dst;
+    gfx_surface_t expect;
+    gfx_op_t op;
+    uint32_t iteration;
+    uint32_t executed = 0;
+    uint32_t clipped = 0;
+    uint32_t rejected = 0;
+    uint32_t color;
+    uint32_t i;
+    int32_t x;
+    int32_t y;
+    int32_t sx;
+    int32_t sy;
+    int32_t width;
+    int32_t height;
+    uint8_t type;
+    uint8_t alpha;
+    uint8_t res;
+    int failures = 0;
+
+    for (iteration = 0; (iteration < iterations) && (failures == 0); iteration++)
+    {
+        for (i = 0; i < 256; i++)
+        {
+            clut[i] = ((uint32_t)test_random(0x10000) << 16) | test_random(0x10000);
+        }
+        test_surface(&src, src_data, src_formats[test_random(4)], clut);
+        test_surface(&dst, dst_data, (test_random(2) == 0) ? GFX_FORMAT_ARGB8888 : GFX_FORMAT_RGB565, NULL);
+        expect = dst;
+        expect.data = expect_data;
+        memcpy(expect_data, dst_data, sizeof(expect_data));
+
+        type = (uint8_t)test_random(3);
+        /* ΪԽ߽磬Ըǲü */
+        x = (int32_t)test_random(dst.width + 16) - 8;
+        y = (int32_t)test_random(dst.height + 16) - 8;
+        sx = (int32_t)test_random(src.width + 16) - 8;
+        sy = (int32_t)test_random(src.height + 16) - 8;
+        width = (int32_t)test_random(dst.width + 8);
+        height = (int32_t)test_random(dst.height + 8);
+        alpha = (test_random(3) == 0) ? 0xFF : (uint8_t)test_random(256);
+        color = ((uint32_t)test_random(0x10000) << 16) | test_random(0x10000);
+
+        /* A4ԴֻܴżؿʼΪż */
+        if (src.format == GFX_FORMAT_A4)
+        {
+            x &= ~1;
+            sx &= ~1;
+            width &= ~1;
+        }
+
+        if (type == GFX_OP_FILL)
+        {
+            res = gfx_op_fill(&op, &dst, x, y, width, height, color);
+        }
+        else if (type == GFX_OP_COPY)
+        {
+            res = gfx_op_copy(&op, &dst, x, y, &src, sx, sy, width, height);
+            alpha = 0xFF;
+        }
+        else
+        {
+            res = gfx_op_blend(&op, &dst, x, y, &src, sx, sy, width, height, alpha);
+        }
+
+        if (res == 1)
+        {
+            rejected++;
+            continue;
+        }
+        if (res == 0)
+        {
+            gfx_soft_execute(&op);
+            executed++;
+        }
+        else
+        {
+            clipped++;
+        }
+        model_execute(type, &expect, x, y, width, height, &src, sx, sy, alpha, color);
+
+        if (memcmp(dst_data, expect_data, sizeof(dst_data)) != 0)
+        {
+            for (i = 0; (i < sizeof(dst_data)) && (dst_data[i] == expect_data[i]); i++)
+            {
+            }
+            printf("iteration %u: type %u src %u dst %u alpha %u rect (%d,%d %dx%d) src (%d,%d): byte %u is %02X, expect %02X\n",
+                   (unsigned int)iteration, type, src.format, dst.format, alpha, (int)x, (int)y, (int)width, (int)height, (int)sx,
+                   (int)sy, (unsigned int)i, dst_data[i], expect_data[i]);
+            failures++;
+        }
+    }
+
+    printf("random ops: %u executed, %u clipped away, %u rejected: %s\n", (unsigned int)executed, (unsigned int)clipped,
+           (unsigned int)rejected, (failures == 0) ? "ok" : "FAIL");
+
+    return failures;
+}
+
+/**
+ * @brief   ȡǰʱ
+ * @param   
+ * @retval  
+ */
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief   ִв߿·
+ * @param   op: ṹָ
+ * @retval  
+ */
+static void bench_per_pixel(const gfx_op_t *op)
+{
+    uint32_t pixel;
+    uint32_t x;
+    uint32_t y;
+
+    for (y = 0; y < op->height; y++)
+    {
+        for (x = 0; x < op->width; x++)
+        {
+            pixel = gfx_soft_pixel(op, x, y);
+            if (op->dst_format == GFX_FORMAT_RGB565)
+            {
+                ((uint16_t *)(op->dst + y * op->dst_pitch))[x] = GFX_RGB565((pixel >> 16) & 0xFF, (pixel >> 8) & 0xFF, pixel & 0xFF);
+            }
+            else
+            {
+                ((uint32_t *)(op->dst + y * op->dst_pitch))[x] = pixel;
+            }
+        }
+    }
+}
+
+/**
+ * @brief   һٶ
+ * @param   op: ṹָ
+ * @param   execute: ִк
+ * @retval  ÿ
+ */
+static double bench_run(const gfx_op_t *op, void (*execute)(const gfx_op_t *op))
+{
+    double start = bench_now();
+    double elapsed;
+    uint32_t count = 0;
+
+    do
+    {
+        execute(op);
+        count++;
+        elapsed = bench_now() - start;
+    } while (elapsed < BENCH_MIN_TIME);
+
+    return (double)op->width * op->height * count / elapsed / 1e6;
+}
+
+/**
+ * @brief   800x480CPUٶ
+ * @param   
+ * @retval  
+ */
+static void bench(void)
+{
+    static uint32_t argb_data[BENCH_WIDTH * BENCH_HEIGHT];
+    static uint32_t argb_dst[BENCH_WIDTH * BENCH_HEIGHT];
+    static uint16_t rgb565_data[BENCH_WIDTH * BENCH_HEIGHT];
+    static uint16_t rgb565_dst[BENCH_WIDTH * BENCH_HEIGHT];
+    static uint8_t l8_data[BENCH_WIDTH * BENCH_HEIGHT];
+    static uint8_t a4_data[BENCH_WIDTH * BENCH_HEIGHT / 2];
+    static uint32_t clut[256];
+    gfx_surface_t argb = {argb_data, BENCH_WIDTH * 4, BENCH_WIDTH, BENCH_HEIGHT, GFX_FORMAT_ARGB8888, NULL, 0};
+    gfx_surface_t argb_out = {argb_dst, BENCH_WIDTH * 4, BENCH_WIDTH, BENCH_HEIGHT, GFX_FORMAT_ARGB8888, NULL, 0};
+    gfx_surface_t rgb565 = {rgb565_data, BENCH_WIDTH * 2, BENCH_WIDTH, BENCH_HEIGHT, GFX_FORMAT_RGB565, NULL, 0};
+    gfx_surface_t rgb565_out = {rgb565_dst, BENCH_WIDTH * 2, BENCH_WIDTH, BENCH_HEIGHT, GFX_FORMAT_RGB565, NULL, 0};
+    gfx_surface_t l8 = {l8_data, BENCH_WIDTH, BENCH_WIDTH, BENCH_HEIGHT, GFX_FORMAT_L8, clut, 0};
+    gfx_surface_t a4 = {a4_data, BENCH_WIDTH / 2, BENCH_WIDTH, BENCH_HEIGHT, GFX_FORMAT_A4, NULL, 0xFFFFFFFF};
+    struct {
+        const char *name;
+        gfx_op_t op;
+    } cases[9];
+    double fast;
+    double slow;
+    uint32_t i;
+
+    for (i = 0; i < BENCH_WIDTH * BENCH_HEIGHT; i++)
+    {
+        argb_data[i] = (test_random(4) == 0) ? 0 : ((test_random(256) << 24) | test_random(0x01000000));
+        rgb565_data[i] = (uint16_t)test_random(0x10000);
+        l8_data[i] = (uint8_t)test_random(256);
+    }
+    for (i = 0; i < sizeof(a4_data); i++)
+    {
+        a4_data[i] = (uint8_t)test_random(256);
+    }
+    for (i = 0; i < 256; i++)
+    {
+        clut[i] = 0xFF000000 | test_random(0x01000000);
+    }
+
+    cases[0].name = "fill_rgb565";
+    gfx_op_fill(&cases[0].op, &rgb565_out, 0, 0, BENCH_WIDTH, BENCH_HEIGHT, 0xFF336699);
+    cases[1].name = "fill_argb8888";
+    gfx_op_fill(&cases[1].op, &argb_out, 0, 0, BENCH_WIDTH, BENCH_HEIGHT, 0x80336699);
+    cases[2].name = "copy_rgb565";
+    gfx_op_copy(&cases[2].op, &rgb565_out, 0, 0, &rgb565, 0, 0, BENCH_WIDTH, BENCH_HEIGHT);
+    cases[3].name = "argb8888_to_rgb565";
+    gfx_op_copy(&cases[3].op, &rgb565_out, 0, 0, &argb, 0, 0, BENCH_WIDTH, BENCH_HEIGHT);
+    cases[4].name = "rgb565_to_argb8888";
+    gfx_op_copy(&cases[4].op, &argb_out, 0, 0, &rgb565, 0, 0, BENCH_WIDTH, BENCH_HEIGHT);
+    cases[5].name = "l8_to_rgb565";
+    gfx_op_copy(&cases[5].op, &rgb565_out, 0, 0, &l8, 0, 0, BENCH_WIDTH, BENCH_HEIGHT);
+    cases[6].name = "blend_argb8888_rgb565";
+    gfx_op_blend(&cases[6].op, &rgb565_out, 0, 0, &argb, 0, 0, BENCH_WIDTH, BENCH_HEIGHT, 0xFF);
+    cases[7].name = "blend_argb8888_a128";
+    gfx_op_blend(&cases[7].op, &rgb565_out, 0, 0, &argb, 0, 0, BENCH_WIDTH, BENCH_HEIGHT, 0x80);
+    cases[8].name = "blend_a4_rgb565";
+    gfx_op_blend(&cases[8].op, &rgb565_out, 0, 0, &a4, 0, 0, BENCH_WIDTH, BENCH_HEIGHT, 0xFF);
+
+    printf("%-24s %12s %12s %8s\n", "op (800x480)", "fast Mpix/s", "pixel Mpix/s", "speedup");
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        fast = bench_run(&cases[i].op, gfx_soft_execute);
+        slow = bench_run(&cases[i].op, bench_per_pixel);
+        printf("%-24s %12.1f %12.1f %7.2fx\n", cases[i].name, fast, slow, fast / slow);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = 20000;
+    int run_bench = 0;
+    int failures;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "bn:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+            {
+                run_bench = 1;
+                break;
+            }
+            case 'n':
+            {
+                iterations = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            }
+            case 's':
+            {
+                test_seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            }
+            default:
+            {
+                fprintf(stderr, "usage: %s [-b] [-n iterations] [-s seed]\n", argv[0]);
+                return 2;
+            }
+        }
+    }
+
+    if (run_bench != 0)
+    {
+        bench();
+        return 0;
+    }
+
+    failures = test_golden();
+    failures += test_random_ops(iterations);
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,470 @@
+/**
+ ****************************************************************************************************
+ * @file        gfxmmu_model.c
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       GFXMMUַ֡תģڴԤ
+ ****************************************************************************************************
+ * @attention
+ *
+ * ʾ״gfxmmu_lut.cɲұ밴GFXMMU_FB_LUT_LINESֶֶͬηΧ
+ * ֽģ⻺1024x4096ֽڣĵַת:
+ *   ״ÿصÿֽڶӳ䣨ʱalphaֽڳ⣩״ֻڲֿɼĿ
+ *   ֽڲӳ䵽ͬһֽڣӳֽռgfxmmu_lut_size()ֻ䣩
+ *   ɼ뼸μһ£Բصؿɼزɼ
+ *   ʱԽ8MB߽
+ * Ȼ󰴻ͼķʽг4096дÿزأɼضдֵʱalphaΪDARɼDVR
+ * ӡڴԤÿֽ֡ĽʡܷAXI SRAM֡LTDCɨ
+ *
+ * ÷: gfxmmu_model
+ *
+ ****************************************************************************************************
+ */
+
+#include "gfxmmu_lut.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* gfxmmu_fb.hͬĲ */
+#define MODEL_LUT_LINES         (32U)           /* GFXMMU_FB_LUT_LINES */
+#define MODEL_DEFAULT_VALUE     (0x00000000UL)  /* GFXMMU_FB_DEFAULT_VALUE */
+#define MODEL_DEFAULT_ALPHA     (0xFFU)         /* GFXMMU_FB_DEFAULT_ALPHA */
+#define MODEL_BUFFER_NUM        (2U)            /* LTDC_FB_NUM */
+
+/* 洢 */
+#define MODEL_FB_BASE           (0x24040000UL)  /* LTDC_FB_BASE */
+#define MODEL_FB_RAM_SIZE       (0x31C00UL)     /* LTDC_FB_RAM_SIZE */
+
+/* ˢʶ壨LTDCɨ */
+#define MODEL_REFRESH_HZ        (60U)
+
+/* ʾ״ */
+typedef struct {
+    const char *name;
+    gfxmmu_lut_config_t cfg;
+} shape_t;
+
+static const shape_t shapes[] = {
+    {"256x192 RGB565",          {256, 192, 2, 0, 0}},
+    {"240x240 RGB565",          {240, 240, 2, 0, 0}},
+    {"240x240 RGB565 round",    {240, 240, 2, 0, 120}},
+    {"800x480 RGB565",          {800, 480, 2, 0, 0}},
+    {"800x480 RGB565 r=40",     {800, 480, 2, 0, 40}},
+    {"800x480 ARGB8888",        {800, 480, 4, 0, 0}},
+    {"800x480 ARGB8888 packed", {800, 480, 4, 1, 0}},
+    {"480x480 RGB565 round",    {480, 480, 2, 0, 240}},
+    {"480x480 ARGB8888 round",  {480, 480, 4, 0, 240}},
+    {"480x480 packed round",    {480, 480, 4, 1, 240}},
+    {"466x466 packed round",    {466, 466, 4, 1, 233}},
+    {"320x320 RGB565 round",    {320, 320, 2, 0, 160}},
+    {"390x450 RGB565 r=95",     {390, 450, 2, 0, 95}},
+    {"1024x600 ARGB8888 packed", {1024, 600, 4, 1, 0}},
+    {"2048x64 RGB565 stadium",  {2048, 64, 2, 0, 1000}},
+};
+
+/* ģGFXMMU */
+static uint32_t model_lut[2 * GFXMMU_LUT_LINE_NUM];
+static uint8_t model_packing = 0;
+static uint8_t *model_memory = NULL;        /*  */
+static uint32_t *model_owner = NULL;        /* ÿֽڶӦƫ + 1 */
+
+/**
+ * @brief   ģһֽд
+ * @param   offset: ƫ
+ * @param   value: дֵ
+ * @retval  
+ */
+static void model_write(uint32_t offset, uint8_t value)
+{
+    uint32_t physical;
+
+    if (gfxmmu_lut_translate(model_lut, model_packing, offset, &physical) == GFXMMU_LUT_MAPPED)
+    {
+        model_memory[physical] = value;
+    }
+}
+
+/**
+ * @brief   ģһֽڶȡ
+ * @param   offset: ƫ
+ * @retval  ֵ
+ */
+static uint8_t model_read(uint32_t offset)
+{
+    uint32_t physical;
+
+    switch (gfxmmu_lut_translate(model_lut, model_packing, offset, &physical))
+    {
+        case GFXMMU_LUT_MAPPED:
+        {
+            return model_memory[physical];
+        }
+        case GFXMMU_LUT_PACKED:
+        {
+            return MODEL_DEFAULT_ALPHA;
+        }
+        default:
+        {
+            return (uint8_t)(MODEL_DEFAULT_VALUE >> ((offset % 4) * 8));
+        }
+    }
+}
+
+/**
+ * @brief   ֵ
+ * @param   x, y: 
+ * @retval  ֵ
+ */
+static uint32_t model_pixel(uint32_t x, uint32_t y)
+{
+    uint32_t value = x * 2654435761UL ^ (y + 1) * 40503UL;
+
+    return value ^ (value >> 15);
+}
+
+/**
+ * @brief   μǷ״ص
+ * @param   cfg: ʾ״
+ * @param   x, y: 
+ * @retval  1: ص; 0: ص
+ */
+static int model_inside(const gfxmmu_lut_config_t *cfg, uint32_t x, uint32_t y)
+{
+    double radius = cfg->radius;
+    double cx;
+    double cy;
+    double dx;
+    double dy;
+
+    if (radius > cfg->width / 2)
+    {
+        radius = cfg->width / 2;
+    }
+    if (radius > cfg->height / 2)
+    {
+        radius = cfg->height / 2;
+    }
+
+    /* طԲԲĵԲڣԲܣص */
+    cx = (x < radius) ? radius : ((x + 1 > cfg->width - radius) ? (cfg->width - radius) : -1);
+    cy = (y < radius) ? radius : ((y + 1 > cfg->height - radius) ? (cfg->height - radius) : -1);
+    if ((cx < 0) || (cy < 0))
+    {
+        return 1;
+    }
+    dx = (cx <= x) ? (x - cx) : ((cx >= x + 1) ? (cx - x - 1) : 0);
+    dy = (cy <= y) ? (y - cy) : ((cy >= y + 1) ? (cy - y - 1) : 0);
+
+    return (dx * dx + dy * dy) < (radius * radius);
+}
+
+/**
+ * @brief   ұ
+ * @param   cfg: ʾ״
+ * @retval  
+ */
+static int model_check_lut(const gfxmmu_lut_config_t *cfg)
+{
+    static uint32_t chunked[2 * GFXMMU_LUT_LINE_NUM];
+    uint32_t line;
+    uint32_t first;
+    uint32_t last;
+    uint32_t x0;
+    uint32_t x1;
+    int32_t offset;
+    int errors = 0;
+
+    if (gfxmmu_lut_build(cfg, 0, GFXMMU_LUT_LINE_NUM, model_lut) != 0)
+    {
+        printf("  build failed\n");
+        return 1;
+    }
+
+    for (line = 0; line < GFXMMU_LUT_LINE_NUM; line += MODEL_LUT_LINES)
+    {
+        errors += gfxmmu_lut_build(cfg, line, MODEL_LUT_LINES, &chunked[2 * line]) != 0;
+    }
+    if ((errors != 0) || (memcmp(chunked, model_lut, sizeof(model_lut)) != 0))
+    {
+        printf("  chunked build differs\n");
+        errors++;
+    }
+
+    for (line = 0; line < GFXMMU_LUT_LINE_NUM; line++)
+    {
+        gfxmmu_lut_span(cfg, line, &x0, &x1);
+        if ((model_lut[2 * line] & GFXMMU_LUT_EN) == 0)
+        {
+            if ((line < cfg->height) || (model_lut[2 * line] != 0) || (model_lut[2 * line + 1] != 0))
+            {
+                printf("  line %u: wrongly disabled\n", line);
+                errors++;
+            }
+            continue;
+        }
+
+        first = (model_lut[2 * line] >> GFXMMU_LUT_FVB_POS) & 0xFF;
+        last = (model_lut[2 * line] >> GFXMMU_LUT_LVB_POS) & 0xFF;
+        offset = (int32_t)(model_lut[2 * line + 1] & GFXMMU_LUT_LO_MASK);
+        if (offset > GFXMMU_LUT_LO_MAX)
+        {
+            offset -= (int32_t)GFXMMU_LUT_LO_MASK + 1;
+        }
+        if ((line >= cfg->height) || (first > last) || ((model_lut[2 * line] & ~0x00FFFF01UL) != 0) ||
+            ((model_lut[2 * line + 1] & ~GFXMMU_LUT_LO_MASK) != 0) || (offset < GFXMMU_LUT_LO_MIN) || (offset > GFXMMU_LUT_LO_MAX) ||
+            (first != x0 * cfg->pixel_size / GFXMMU_LUT_VIRTUAL_BLOCK) || (last != (x1 * cfg->pixel_size - 1) / GFXMMU_LUT_VIRTUAL_BLOCK))
+        {
+            printf("  line %u: bad entry %08X %08X\n", line, model_lut[2 * line], model_lut[2 * line + 1]);
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+/**
+ * @brief   ɼ뼸μһ
+ * @param   cfg: ʾ״
+ * @retval  
+ */
+static int model_check_shape(const gfxmmu_lut_config_t *cfg)
+{
+    uint32_t x;
+    uint32_t y;
+    uint32_t x0;
+    uint32_t x1;
+    int errors = 0;
+
+    for (y = 0; y < cfg->height; y++)
+    {
+        gfxmmu_lut_span(cfg, y, &x0, &x1);
+        for (x = 0; x < cfg->width; x++)
+        {
+            if (((x >= x0) && (x < x1)) != model_inside(cfg, x, y))
+            {
+                if (errors < 4)
+                {
+                    printf("  pixel (%u, %u): span [%u, %u) disagrees with geometry\n", x, y, x0, x1);
+                }
+                errors++;
+            }
+        }
+    }
+
+    return errors;
+}
+
+/**
+ * @brief   ֽڼַת
+ * @param   cfg: ʾ״
+ * @param   size: С
+ * @retval  
+ */
+static int model_check_translate(const gfxmmu_lut_config_t *cfg, uint32_t size)
+{
+    uint32_t offset;
+    uint32_t physical;
+    uint32_t mapped = 0;
+    uint32_t x;
+    uint32_t y;
+    uint32_t x0;
+    uint32_t x1;
+    uint8_t res;
+    int visible;
+    int errors = 0;
+
+    memset(model_owner, 0, size * sizeof(uint32_t));
+
+    for (offset = 0; offset < GFXMMU_LUT_VIRTUAL_SIZE; offset++)
+    {
+        y = offset / GFXMMU_LUT_VIRTUAL_PITCH;
+        x = (offset % GFXMMU_LUT_VIRTUAL_PITCH) / cfg->pixel_size;
+        gfxmmu_lut_span(cfg, y, &x0, &x1);
+        visible = (x >= x0) && (x < x1);
+
+        res = gfxmmu_lut_translate(model_lut, model_packing, offset, &physical);
+        if (res == GFXMMU_LUT_MAPPED)
+        {
+            if ((physical >= size) || (model_owner[physical] != 0))
+            {
+                if (errors < 4)
+                {
+                    printf("  offset %06X -> %06X: %s\n", offset, physical, (physical >= size) ? "out of buffer" : "aliased");
+                }
+                errors++;
+                continue;
+            }
+            model_owner[physical] = offset + 1;
+            mapped++;
+        }
+        else if (visible && ((res == GFXMMU_LUT_UNMAPPED) || ((offset % 4) != 3)))
+        {
+            if (errors < 4)
+            {
+                printf("  offset %06X (pixel %u, %u): not mapped\n", offset, x, y);
+            }
+            errors++;
+        }
+    }
+
+    /* ӳֽռֻ */
+    if ((mapped > size) || ((size - mapped) >= GFXMMU_LUT_PHYSICAL_ALIGN))
+    {
+        printf("  %u bytes mapped, buffer is %u bytes\n", mapped, size);
+        errors++;
+    }
+
+    return errors;
+}
+
+/**
+ * @brief   ͼķʽд벢ÿ
+ * @param   cfg: ʾ״
+ * @retval  
+ */
+static int model_check_pixels(const gfxmmu_lut_config_t *cfg)
+{
+    uint32_t pixel_size = cfg->pixel_size;
+    uint32_t expect;
+    uint32_t value;
+    uint32_t x;
+    uint32_t y;
+    uint32_t x0;
+    uint32_t x1;
+    uint32_t i;
+    uint32_t physical;
+    int errors = 0;
+
+    /* ڣ״أд뱻ԻڲֿɼĿУ */
+    for (y = 0; y < cfg->height; y++)
+    {
+        for (x = 0; x < cfg->width; x++)
+        {
+            value = model_pixel(x, y);
+            for (i = 0; i < pixel_size; i++)
+            {
+                model_write(y * GFXMMU_LUT_VIRTUAL_PITCH + x * pixel_size + i, (uint8_t)(value >> (i * 8)));
+            }
+        }
+    }
+
+    for (y = 0; y < GFXMMU_LUT_LINE_NUM; y++)
+    {
+        gfxmmu_lut_span(cfg, y, &x0, &x1);
+        for (x = 0; x < GFXMMU_LUT_VIRTUAL_PITCH / pixel_size; x++)
+        {
+            if ((x >= x0) && (x < x1))
+            {
+                expect = model_pixel(x, y);
+                if (model_packing != 0)
+                {
+                    expect = (expect & 0x00FFFFFF) | ((uint32_t)MODEL_DEFAULT_ALPHA << 24);
+                }
+            }
+            else if (gfxmmu_lut_translate(model_lut, model_packing, y * GFXMMU_LUT_VIRTUAL_PITCH + x * pixel_size, &physical) != GFXMMU_LUT_UNMAPPED)
+            {
+                continue;       /* ɼɼͬ飬ݲȷ */
+            }
+            else
+            {
+                expect = MODEL_DEFAULT_VALUE;
+            }
+
+            value = 0;
+            for (i = 0; i < pixel_size; i++)
+            {
+                value |= (uint32_t)model_read(y * GFXMMU_LUT_VIRTUAL_PITCH + x * pixel_size + i) << (i * 8);
+            }
+            if (pixel_size == 2)
+            {
+                expect &= 0xFFFF;
+            }
+
+            if (value != expect)
+            {
+                if (errors < 4)
+                {
+                    printf("  pixel (%u, %u): read %08X, expected %08X\n", x, y, value, expect);
+                }
+                errors++;
+            }
+        }
+    }
+
+    return errors;
+}
+
+/**
+ * @brief   һʾ״ӡڴԤ
+ * @param   shape: ʾ״
+ * @retval  
+ */
+static int model_shape(const shape_t *shape)
+{
+    const gfxmmu_lut_config_t *cfg = &shape->cfg;
+    uint32_t linear = (uint32_t)cfg->width * cfg->height * cfg->pixel_size;
+    uint32_t size = gfxmmu_lut_size(cfg);
+    uint32_t index;
+    uint32_t start;
+    int errors = 0;
+
+    if (size == 0)
+    {
+        printf("%-26s invalid shape\n", shape->name);
+        return 1;
+    }
+
+    model_packing = cfg->packing;
+    model_memory = malloc(size);
+    model_owner = malloc(size * sizeof(uint32_t));
+    if ((model_memory == NULL) || (model_owner == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(2);
+    }
+    memset(model_memory, 0xA5, size);
+
+    errors += model_check_lut(cfg);
+    errors += model_check_shape(cfg);
+    errors += model_check_translate(cfg, size);
+    errors += model_check_pixels(cfg);
+
+    /* ֡׵ַ */
+    for (index = 0; index < MODEL_BUFFER_NUM; index++)
+    {
+        start = MODEL_FB_BASE + index * size;
+        if ((start / GFXMMU_LUT_WINDOW_SIZE) != ((start + size - 1) / GFXMMU_LUT_WINDOW_SIZE))
+        {
+            printf("  buffer %u crosses an 8MB boundary\n", index);
+            errors++;
+        }
+    }
+
+    printf("%-26s %9u %9u %5.1f%% %9u %-4s %7.1f  %s\n", shape->name, linear, size, (linear - (double)size) * 100 / linear,
+           size * MODEL_BUFFER_NUM, (size * MODEL_BUFFER_NUM <= MODEL_FB_RAM_SIZE) ? "yes" : "no",
+           (double)size * MODEL_REFRESH_HZ / 1e6, (errors == 0) ? "ok" : "FAIL");
+
+    free(model_memory);
+    free(model_owner);
+
+    return errors;
+}
+
+int main(void)
+{
+    uint32_t i;
+    int failures = 0;
+
+    printf("%-26s %9s %9s %6s %9s %-4s %7s\n", "shape", "linear", "gfxmmu", "saved", "2 bufs", "AXI", "MB/s");
+    for (i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++)
+    {
+        failures += model_shape(&shapes[i]) != 0;
+    }
+    printf("linear/gfxmmu: bytes per buffer; AXI: both buffers fit LTDC_FB_RAM_SIZE (%lu bytes); MB/s: LTDC scan-out at %u Hz\n",
+           MODEL_FB_RAM_SIZE, MODEL_REFRESH_HZ);
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+
+    return (failures == 0) ? 0 : 1;
+}
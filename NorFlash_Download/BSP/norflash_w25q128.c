@@ -44,6 +44,9 @@
 #define W25Q128_SECTOR_SIZE                     (0x00001000UL)
 #define W25Q128_PAGE_SIZE                       (0x00000100UL)
 
+/* W25Q128ģʽλ壨M5-4Ϊ10bʱģʽ */
+#define W25Q128_CONTINUOUS_READ_DISABLE         (0xFFUL)
+
 /* W25Q128ֵ */
 #define W25Q128_EMPTY_VALUE                     ((uint8_t)0xFF)
 
@@ -830,11 +833,15 @@ static uint8_t w25q128_dual_read(XSPI_HandleTypeDef *hxspi, uint32_t address, ui
     xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_4_LINES;
     xspi_regular_cmd_struct.AddressWidth = HAL_XSPI_ADDRESS_24_BITS;
     xspi_regular_cmd_struct.AddressDTRMode = HAL_XSPI_ADDRESS_DTR_DISABLE;
-    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    /* M7-0ʽΪ0xFFģʽ */
+    xspi_regular_cmd_struct.AlternateBytes = W25Q128_CONTINUOUS_READ_DISABLE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_4_LINES;
+    xspi_regular_cmd_struct.AlternateBytesWidth = HAL_XSPI_ALT_BYTES_8_BITS;
+    xspi_regular_cmd_struct.AlternateBytesDTRMode = HAL_XSPI_ALT_BYTES_DTR_DISABLE;
     xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_4_LINES;
     xspi_regular_cmd_struct.DataLength = length;
     xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
-    xspi_regular_cmd_struct.DummyCycles = 6;
+    xspi_regular_cmd_struct.DummyCycles = 4;
     xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
     if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
     {
@@ -919,10 +926,14 @@ static uint8_t w25q128_dual_memory_mapped(XSPI_HandleTypeDef *hxspi)
     xspi_regular_cmd_struct.AddressMode = HAL_XSPI_ADDRESS_4_LINES;
     xspi_regular_cmd_struct.AddressWidth = HAL_XSPI_ADDRESS_24_BITS;
     xspi_regular_cmd_struct.AddressDTRMode = HAL_XSPI_ADDRESS_DTR_DISABLE;
-    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    /* M7-0ʽΪ0xFFģʽAbort˳ڴӳ */
+    xspi_regular_cmd_struct.AlternateBytes = W25Q128_CONTINUOUS_READ_DISABLE;
+    xspi_regular_cmd_struct.AlternateBytesMode = HAL_XSPI_ALT_BYTES_4_LINES;
+    xspi_regular_cmd_struct.AlternateBytesWidth = HAL_XSPI_ALT_BYTES_8_BITS;
+    xspi_regular_cmd_struct.AlternateBytesDTRMode = HAL_XSPI_ALT_BYTES_DTR_DISABLE;
     xspi_regular_cmd_struct.DataMode = HAL_XSPI_DATA_4_LINES;
     xspi_regular_cmd_struct.DataDTRMode = HAL_XSPI_DATA_DTR_DISABLE;
-    xspi_regular_cmd_struct.DummyCycles = 6;
+    xspi_regular_cmd_struct.DummyCycles = 4;
     xspi_regular_cmd_struct.DQSMode = HAL_XSPI_DQS_DISABLE;
     if (HAL_XSPI_Command(hxspi, &xspi_regular_cmd_struct, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
     {
@@ -1439,6 +1450,29 @@ uint8_t norflash_memory_mapped(void)
     return 1;
 }
 
+/**
+ * @brief   ˳NOR Flashڴӳ
+ * @param   
+ * @retval  ˳ڴӳ
+ * @arg     0: ˳ڴӳɹ
+ * @arg     1: ˳ڴӳʧ
+ */
+uint8_t norflash_memory_mapped_exit(void)
+{
+    if (xspi1_handle.State != HAL_XSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return 0;
+    }
+    
+    /* ֹڴӳ䣬XSPIصģʽM7-0Ϊ0xFFģʽֱӽָ */
+    if (HAL_XSPI_Abort(&xspi1_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief   ȡNOR Flashֵ
  * @param   
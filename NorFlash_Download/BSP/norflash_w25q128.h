@@ -80,6 +80,7 @@ uint8_t norflash_erase_sector(uint32_t address);
 uint8_t norflash_program_page(uint32_t address, uint8_t *data, uint32_t length);    /* 页编程NOR Flash */
 uint8_t norflash_read(uint32_t address, uint8_t *data, uint32_t length);            /* 读NOR Flash */
 uint8_t norflash_memory_mapped(void);                                               /* 开启NOR Flash内存映射 */
+uint8_t norflash_memory_mapped_exit(void);                                          /* 退出NOR Flash内存映射 */
 uint8_t norflash_get_empty_value(void);                                             /* 获取NOR Flash擦后数据值 */
 uint32_t norflash_get_chip_size(void);                                              /* 获取NOR Flash片大小 */
 uint32_t norflash_get_block_size(void);                                             /* 获取NOR Flash块大小 */
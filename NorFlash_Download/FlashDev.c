@@ -31,14 +31,14 @@ struct FlashDevice const FlashDevice  =  {
    EXTSPI,                     // Device Type
    0x90000000,                 // Device Start Address
    32 * 1024 * 1024,           // 2*16MB
-   4 * 1024,                       // Programming Page Size
+   4 * 1024,                   // Programming Page Size (split into 512B dual pages)
    0,                          // Reserved, must be 0
    0xFF,                       // Initial Content of Erased Memory
-   1000,                        // Program Page Timeout 100 mSec
+   1000,                       // Program Page Timeout 1000 mSec
    3000,                       // Erase Sector Timeout 3000 mSec
 
 // Specify Size and Address of Sectors
-   0x010000, 0x000000,         // Sector Size  8kB (8 Sectors)
+   0x020000, 0x000000,         // Sector Size 128kB (256 Sectors, 64kB block erase per W25Q128)
 
    SECTOR_END
 };
@@ -21,13 +21,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
- 
+
 #include "FlashOS.h"        // FlashOS Structures
 #include "norflash_w25q128.h"
-#include "bsp.h" 
-#include "usart.h" 
+#include "bsp.h"
+#include "usart.h"
 
-/* 
+/*
    Mandatory Flash Programming Functions (Called by FlashOS):
                 int Init        (unsigned long adr,   // Initialize Flash
                                  unsigned long clk,
@@ -52,6 +52,56 @@
        - if EraseChip is not provided than EraseSector for all sectors is called
 */
 
+#define VERIFY_BLOCK_SIZE   0x1000            // Verify compares CRCs per 4kB block
+
+/*
+ *  Clocks, MPU and NOR Flash are set up by the first Init only,
+ *  the state survives UnInit as long as the algorithm stays loaded
+ */
+static unsigned char FlashReady = 0;
+
+
+/*
+ *  Switch NOR Flash between indirect mode (erase, program)
+ *  and memory-mapped mode (blank check, verify)
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+static int FlashIndirect (void) {
+
+  if (norflash_memory_mapped_exit() != 0) return (1);
+  return (0);
+}
+
+static int FlashMapped (void) {
+
+  if (norflash_memory_mapped() != 0) return (1);
+  return (0);
+}
+
+
+/*
+ *  CRC32 of a buffer using the CRC unit (default polynomial 0x04C11DB7)
+ *    Parameter:      buf:  Data (any alignment)
+ *                    sz:   Size in bytes
+ *    Return Value:   CRC
+ */
+
+static unsigned long FlashCRC (const unsigned char *buf, unsigned long sz) {
+
+  CRC->CR = CRC_CR_RESET;
+  while (sz >= 4) {
+    CRC->DR = __UNALIGNED_UINT32_READ(buf);
+    buf += 4;
+    sz  -= 4;
+  }
+  while (sz != 0) {
+    *(__IO unsigned char *)&CRC->DR = *buf++;
+    sz--;
+  }
+  return (CRC->DR);
+}
+
 
 /*
  *  Initialize Flash Programming Functions
@@ -63,15 +113,24 @@
 
 int Init (unsigned long adr, unsigned long clk, unsigned long fnc) {
 
-  /* Add your Code */
-	SystemInit();
-	MPU_Config();
-	HAL_Init();
-	if(SystemClock_Config()!=0) 	printf_tx1("SystemClock_Config err\n");return 1;
-	norflash_init();
-	printf_tx1("ok\n");
-	norflash_memory_mapped();
-  return (0);                                  // Finished without Errors
+  if (FlashReady == 0) {
+    SystemInit();
+    MPU_Config();
+    HAL_Init();
+    if (SystemClock_Config() != 0) {
+      printf_tx1("SystemClock_Config err\n");
+      return (1);
+    }
+    if (norflash_init() != NORFlash_W25Q128_Dual) {
+      printf_tx1("norflash_init err\n");
+      return (1);
+    }
+    __HAL_RCC_CRC_CLK_ENABLE();
+    FlashReady = 1;
+  }
+
+  if (fnc == 3) return (FlashMapped());
+  return (FlashIndirect());
 }
 
 
@@ -83,8 +142,8 @@ int Init (unsigned long adr, unsigned long clk, unsigned long fnc) {
 
 int UnInit (unsigned long fnc) {
 
-  /* Add your Code */
-  return (0);                                  // Finished without Errors
+  /* Leave the window readable for the debugger */
+  return (FlashMapped());
 }
 
 
@@ -94,10 +153,9 @@ int UnInit (unsigned long fnc) {
  */
 
 int EraseChip (void) {
-	norflash_init();
-if(norflash_erase_chip()!=0) return 1;
-  /* Add your Code */
-	printf_tx1("EraseChip ok\n");
+
+  if (FlashIndirect() != 0) return (1);
+  if (norflash_erase_chip() != 0) return (1);
   return (0);                                  // Finished without Errors
 }
 
@@ -109,14 +167,45 @@ if(norflash_erase_chip()!=0) return 1;
  */
 
 int EraseSector (unsigned long adr) {
-	norflash_init();
-    adr -= QSPI_FLASH_MEM_ADDR;
-	if(norflash_erase_sector(adr)!=0) return 1;
-  /* Add your Code */
+
+  /* A 128kB sector is one 64kB block erase on each W25Q128 */
+  if (FlashIndirect() != 0) return (1);
+  if (norflash_erase_block(adr - QSPI_FLASH_MEM_ADDR) != 0) return (1);
   return (0);                                  // Finished without Errors
 }
 
 
+/*
+ *  Blank Check Checks if Memory is Blank
+ *    Parameter:      adr:  Block Start Address
+ *                    sz:   Block Size (in bytes)
+ *                    pat:  Block Pattern
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int BlankCheck (unsigned long adr, unsigned long sz, unsigned char pat) {
+
+  unsigned long  word = pat * 0x01010101UL;
+  unsigned long  i;
+  int            res  = 0;
+
+  if (FlashMapped() != 0) return (1);
+
+  for (i = 0; i < (sz & ~3UL); i += 4) {
+    if (*(__IO unsigned long *)(adr + i) != word) {
+      res = 1;                                 // Not blank, FlashOS erases it
+      break;
+    }
+  }
+  for (; (res == 0) && (i < sz); i++) {
+    if (*(__IO unsigned char *)(adr + i) != pat) res = 1;
+  }
+
+  if (FlashIndirect() != 0) return (1);
+  return (res);
+}
+
+
 /*
  *  Program Page in Flash Memory
  *    Parameter:      adr:  Page Start Address
@@ -127,8 +216,66 @@ int EraseSector (unsigned long adr) {
 
 int ProgramPage (unsigned long adr, unsigned long sz, unsigned char *buf) {
 
-  /* Add your Code */
-	adr -= QSPI_FLASH_MEM_ADDR;
-	if(norflash_program_page(adr,buf,sz)!=0) return 1;
+  unsigned long  page = norflash_get_page_size();
+  unsigned long  n;
+  unsigned char  pad[2];
+
+  if (FlashIndirect() != 0) return (1);
+
+  adr -= QSPI_FLASH_MEM_ADDR;
+  while (sz != 0) {
+    /* Split into 512 byte dual pages, a page program must not wrap */
+    n = page - (adr & (page - 1));
+    if (n > sz) n = sz;
+
+    /* Both dies are written together, so the length must be even */
+    if ((n & 1) != 0) {
+      if (n > 1) {
+        if (norflash_program_page(adr, buf, n - 1) != 0) return (1);
+      }
+      pad[0] = buf[n - 1];
+      pad[1] = 0xFF;
+      if (norflash_program_page(adr + n - 1, pad, 2) != 0) return (1);
+    } else {
+      if (norflash_program_page(adr, buf, n) != 0) return (1);
+    }
+
+    adr += n;
+    buf += n;
+    sz  -= n;
+  }
   return (0);                                  // Finished without Errors
 }
+
+
+/*
+ *  Verify Flash Contents
+ *    Parameter:      adr:  Start Address
+ *                    sz:   Size (in bytes)
+ *                    buf:  Data
+ *    Return Value:   (adr+sz) - OK, Failed Address
+ */
+
+unsigned long Verify (unsigned long adr, unsigned long sz, unsigned char *buf) {
+
+  unsigned long  n;
+  unsigned long  i;
+
+  if (FlashMapped() != 0) return (adr);
+
+  while (sz != 0) {
+    n = (sz > VERIFY_BLOCK_SIZE) ? VERIFY_BLOCK_SIZE : sz;
+
+    /* Locate the first differing byte only in a failing block */
+    if (FlashCRC((const unsigned char *)adr, n) != FlashCRC(buf, n)) {
+      for (i = 0; i < n; i++) {
+        if (*(__IO unsigned char *)(adr + i) != buf[i]) return (adr + i);
+      }
+    }
+
+    adr += n;
+    buf += n;
+    sz  -= n;
+  }
+  return (adr);
+}